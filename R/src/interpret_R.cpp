@@ -746,9 +746,11 @@ SEXP CreateBooster_R(
       acTermDimensions,
       aiTermFeatures,
       cInnerBags,
-      EBM_FALSE,
+      CreateBoosterFlags_Default,
       "log_loss",
       nullptr,
+      0,
+      nullptr,
       &boosterHandle
    );
    if(Error_None != err || nullptr == boosterHandle) {
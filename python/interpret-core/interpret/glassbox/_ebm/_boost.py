@@ -33,6 +33,7 @@ def boost(
     is_private,
     objective,
     experimental_params=None,
+    n_threads=None,
 ):
     try:
         episode_index = 0
@@ -46,7 +47,39 @@ def boost(
             is_private,
             objective,
             experimental_params,
+            n_threads=n_threads,
         ) as booster:
+            if not noise_scale:
+                # without differential privacy noise we never need to touch the
+                # term updates, so run the whole schedule natively
+                _log.info("Start boosting")
+                n_rounds, min_metric = booster.boost_rounds(
+                    rng,
+                    boost_flags=boost_flags,
+                    learning_rate=learning_rate,
+                    min_samples_leaf=min_samples_leaf,
+                    max_leaves=max_leaves,
+                    greediness=greediness,
+                    smoothing_rounds=smoothing_rounds,
+                    max_rounds=max_rounds,
+                    early_stopping_rounds=early_stopping_rounds,
+                    early_stopping_tolerance=early_stopping_tolerance,
+                )
+                # match the loop below, which reports the index of the last round
+                episode_index = max(n_rounds - 1, 0)
+                _log.info(
+                    "End boosting, Best Metric: {0}, Num Rounds: {1}".format(
+                        min_metric, episode_index
+                    )
+                )
+
+                if early_stopping_rounds > 0:
+                    model_update = booster.get_best_model()
+                else:
+                    model_update = booster.get_current_model()
+
+                return None, model_update, episode_index, rng
+
             # the first round is alwasy cyclic since we need to get the initial gains
             greedy_portion = 0.0
 
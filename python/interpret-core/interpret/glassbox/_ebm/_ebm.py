@@ -312,6 +312,7 @@ class EBMModel(BaseEstimator):
         objective=None,
         # Overall
         n_jobs=-2,
+        n_boost_threads=None,
         random_state=42,
         # Differential Privacy
         epsilon=1,
@@ -353,6 +354,8 @@ class EBMModel(BaseEstimator):
         self.objective = objective
 
         self.n_jobs = n_jobs
+        if not is_private(self):
+            self.n_boost_threads = n_boost_threads
         self.random_state = random_state
 
         if is_private(self):
@@ -478,6 +481,19 @@ class EBMModel(BaseEstimator):
                 _log.error(msg)
                 raise ValueError(msg)
 
+            if self.n_boost_threads is not None:
+                if (
+                    not isinstance(self.n_boost_threads, int)
+                    and not self.n_boost_threads.is_integer()
+                ):
+                    msg = "n_boost_threads must be an integer or None"
+                    _log.error(msg)
+                    raise ValueError(msg)
+                elif self.n_boost_threads < 1:
+                    msg = "n_boost_threads must be a positive integer or None"
+                    _log.error(msg)
+                    raise ValueError(msg)
+
             if (
                 not isinstance(self.early_stopping_rounds, int)
                 and not self.early_stopping_rounds.is_integer()
@@ -785,6 +801,7 @@ class EBMModel(BaseEstimator):
                 Native.BoostFlags_GradientSums | Native.BoostFlags_RandomSplits
             )
             inner_bags = 0
+            n_boost_threads = None
             greediness = 0.0
             smoothing_rounds = 0
             early_stopping_rounds = 0
@@ -796,6 +813,9 @@ class EBMModel(BaseEstimator):
             bin_data_weights = None
             boost_flags = Native.BoostFlags_Default
             inner_bags = self.inner_bags
+            n_boost_threads = (
+                None if self.n_boost_threads is None else int(self.n_boost_threads)
+            )
             greediness = self.greediness
             smoothing_rounds = self.smoothing_rounds
             early_stopping_rounds = self.early_stopping_rounds
@@ -883,6 +903,7 @@ class EBMModel(BaseEstimator):
                         is_differential_privacy,
                         objective,
                         None,
+                        n_boost_threads,
                     )
                 )
 
@@ -1100,6 +1121,7 @@ class EBMModel(BaseEstimator):
                             is_differential_privacy,
                             objective,
                             None,
+                            n_boost_threads,
                         )
                     )
 
@@ -1341,6 +1363,9 @@ class EBMModel(BaseEstimator):
             if hasattr(self, "n_jobs"):
                 params["n_jobs"] = self.n_jobs
 
+            if hasattr(self, "n_boost_threads"):
+                params["n_boost_threads"] = self.n_boost_threads
+
             if hasattr(self, "random_state"):
                 params["random_state"] = self.random_state
 
@@ -2186,6 +2211,12 @@ class ExplainableBoostingClassifier(EBMModel, ClassifierMixin, ExplainerMixin):
     n_jobs : int, default=-2
         Number of jobs to run in parallel. Negative integers are interpreted as following joblib's formula
         (n_cpus + 1 + n_jobs), just like scikit-learn. Eg: -2 means using all threads except 1.
+    n_boost_threads : int or None, default=None
+        Number of native threads each outer bag uses to boost its inner bags and split its histograms.
+        None uses the LIBEBM_THREADS environment variable, or 1 thread if it is not set. With 1 thread
+        the models are unchanged from earlier versions. With 2 or more threads the inner bags draw from
+        their own random generators, so random splits can differ from 1 thread but do not depend on the
+        thread count.
     random_state : int or None, default=42
         Random state. None uses device_random and generates non-repeatable sequences.
 
@@ -2312,6 +2343,7 @@ class ExplainableBoostingClassifier(EBMModel, ClassifierMixin, ExplainerMixin):
         objective: str = "log_loss",
         # Overall
         n_jobs: Optional[int] = -2,
+        n_boost_threads: Optional[int] = None,
         random_state: Optional[int] = 42,
     ):
         super(ExplainableBoostingClassifier, self).__init__(
@@ -2334,6 +2366,7 @@ class ExplainableBoostingClassifier(EBMModel, ClassifierMixin, ExplainerMixin):
             max_leaves=max_leaves,
             objective=objective,
             n_jobs=n_jobs,
+            n_boost_threads=n_boost_threads,
             random_state=random_state,
         )
 
@@ -2553,6 +2586,12 @@ class ExplainableBoostingRegressor(EBMModel, RegressorMixin, ExplainerMixin):
     n_jobs : int, default=-2
         Number of jobs to run in parallel. Negative integers are interpreted as following joblib's formula
         (n_cpus + 1 + n_jobs), just like scikit-learn. Eg: -2 means using all threads except 1.
+    n_boost_threads : int or None, default=None
+        Number of native threads each outer bag uses to boost its inner bags and split its histograms.
+        None uses the LIBEBM_THREADS environment variable, or 1 thread if it is not set. With 1 thread
+        the models are unchanged from earlier versions. With 2 or more threads the inner bags draw from
+        their own random generators, so random splits can differ from 1 thread but do not depend on the
+        thread count.
     random_state : int or None, default=42
         Random state. None uses device_random and generates non-repeatable sequences.
 
@@ -2678,6 +2717,7 @@ class ExplainableBoostingRegressor(EBMModel, RegressorMixin, ExplainerMixin):
         objective: str = "rmse",
         # Overall
         n_jobs: Optional[int] = -2,
+        n_boost_threads: Optional[int] = None,
         random_state: Optional[int] = 42,
     ):
         super(ExplainableBoostingRegressor, self).__init__(
@@ -2700,6 +2740,7 @@ class ExplainableBoostingRegressor(EBMModel, RegressorMixin, ExplainerMixin):
             max_leaves=max_leaves,
             objective=objective,
             n_jobs=n_jobs,
+            n_boost_threads=n_boost_threads,
             random_state=random_state,
         )
 
@@ -22,6 +22,11 @@ class Native:
     BoostFlags_GradientSums = 0x00000004
     BoostFlags_RandomSplits = 0x00000008
 
+    # CreateBoosterFlags
+    CreateBoosterFlags_Default = 0x00000000
+    CreateBoosterFlags_DifferentialPrivacy = 0x00000001
+    CreateBoosterFlags_InnerBagsSubsample = 0x00000002
+
     # InteractionFlags
     InteractionFlags_Default = 0x00000000
     InteractionFlags_Pure = 0x00000001
@@ -92,6 +97,8 @@ class Native:
             return Exception(f"User native parameter value error in {native_function}")
         elif error_code == -5:
             return Exception(f"Thread start failed in {native_function}")
+        elif error_code == -6:
+            return Exception(f"File I/O error in {native_function}")
         elif error_code == -10:
             return Exception(f"Objective constructor exception in {native_function}")
         elif error_code == -11:
@@ -118,6 +125,24 @@ class Native:
             )
         elif error_code == -21:
             return Exception("Illegal value in y for the objective")
+        elif error_code == -22:
+            return Exception(f"Metric constructor exception in {native_function}")
+        elif error_code == -23:
+            return Exception("Metric parameter unknown")
+        elif error_code == -24:
+            return Exception("Metric parameter value malformed")
+        elif error_code == -25:
+            return Exception("Metric parameter value out of range")
+        elif error_code == -26:
+            return Exception("Metric parameter mismatch")
+        elif error_code == -27:
+            return Exception("Unrecognized metric type")
+        elif error_code == -28:
+            return Exception("Illegal metric registration name")
+        elif error_code == -29:
+            return Exception("Illegal metric parameter name")
+        elif error_code == -30:
+            return Exception("Duplicate metric parameter name")
         else:
             return Exception(
                 f"Unrecognized native return code {error_code} in {native_function}"
@@ -510,6 +535,41 @@ class Native:
 
         return class_counts
 
+    def write_dataset(self, dataset, filename):
+        return_code = self._unsafe.WriteDataSetShared(
+            dataset.nbytes,
+            Native._make_pointer(dataset, np.ubyte),
+            os.fsencode(filename),
+        )
+        if return_code:  # pragma: no cover
+            raise Native._get_native_exception(return_code, "WriteDataSetShared")
+
+    def open_dataset(self, filename):
+        n_bytes = ct.c_int64(0)
+        dataset_ptr = ct.c_void_p(None)
+
+        return_code = self._unsafe.OpenDataSetShared(
+            os.fsencode(filename),
+            ct.byref(n_bytes),
+            ct.byref(dataset_ptr),
+        )
+        if return_code:  # pragma: no cover
+            raise Native._get_native_exception(return_code, "OpenDataSetShared")
+
+        # view the mapped file without copying it. The pages are read-only
+        dataset = np.ctypeslib.as_array(
+            (ct.c_ubyte * n_bytes.value).from_address(dataset_ptr.value)
+        )
+        dataset.flags.writeable = False
+        return dataset
+
+    def close_dataset(self, dataset):
+        # dataset must have come from open_dataset, and it cannot be used afterwards
+        self._unsafe.CloseDataSetShared(
+            dataset.nbytes,
+            Native._make_pointer(dataset, np.ubyte),
+        )
+
     def sample_without_replacement(
         self, rng, count_training_samples, count_validation_samples
     ):
@@ -951,6 +1011,34 @@ class Native:
         ]
         self._unsafe.CheckDataSet.restype = ct.c_int32
 
+        self._unsafe.WriteDataSetShared.argtypes = [
+            # int64_t countBytesAllocated
+            ct.c_int64,
+            # void * dataSet
+            ct.c_void_p,
+            # char * filename
+            ct.c_char_p,
+        ]
+        self._unsafe.WriteDataSetShared.restype = ct.c_int32
+
+        self._unsafe.OpenDataSetShared.argtypes = [
+            # char * filename
+            ct.c_char_p,
+            # int64_t * countBytesOut
+            ct.POINTER(ct.c_int64),
+            # void ** dataSetOut
+            ct.POINTER(ct.c_void_p),
+        ]
+        self._unsafe.OpenDataSetShared.restype = ct.c_int32
+
+        self._unsafe.CloseDataSetShared.argtypes = [
+            # int64_t countBytes
+            ct.c_int64,
+            # void * dataSet
+            ct.c_void_p,
+        ]
+        self._unsafe.CloseDataSetShared.restype = None
+
         self._unsafe.ExtractDataSetHeader.argtypes = [
             # void * dataSet
             ct.c_void_p,
@@ -1054,10 +1142,14 @@ class Native:
             ct.c_void_p,
             # int64_t countInnerBags
             ct.c_int64,
-            # int32_t isDifferentiallyPrivate
+            # int32_t flags
             ct.c_int32,
             # char * objective
             ct.c_char_p,
+            # char * metric
+            ct.c_char_p,
+            # int64_t countThreads
+            ct.c_int64,
             # double * experimentalParams
             ct.c_void_p,
             # BoosterHandle * boosterHandleOut
@@ -1065,6 +1157,40 @@ class Native:
         ]
         self._unsafe.CreateBooster.restype = ct.c_int32
 
+        self._unsafe.CreateBoosterBags.argtypes = [
+            # void * rng
+            ct.c_void_p,
+            # void * dataSet
+            ct.c_void_p,
+            # int64_t countBags
+            ct.c_int64,
+            # int8_t * bags
+            ct.c_void_p,
+            # double * initScores
+            ct.c_void_p,
+            # int64_t countTerms
+            ct.c_int64,
+            # int64_t * dimensionCounts
+            ct.c_void_p,
+            # int64_t * featureIndexes
+            ct.c_void_p,
+            # int64_t countInnerBags
+            ct.c_int64,
+            # int32_t flags
+            ct.c_int32,
+            # char * objective
+            ct.c_char_p,
+            # char * metric
+            ct.c_char_p,
+            # int64_t countThreads
+            ct.c_int64,
+            # double * experimentalParams
+            ct.c_void_p,
+            # BoosterHandle * boosterHandlesOut
+            ct.c_void_p,
+        ]
+        self._unsafe.CreateBoosterBags.restype = ct.c_int32
+
         self._unsafe.FreeBooster.argtypes = [
             # void * boosterHandle
             ct.c_void_p
@@ -1129,6 +1255,94 @@ class Native:
         ]
         self._unsafe.ApplyTermUpdate.restype = ct.c_int32
 
+        self._unsafe.SetValidationMetricInterval.argtypes = [
+            # void * boosterHandle
+            ct.c_void_p,
+            # int64_t countUpdates
+            ct.c_int64,
+        ]
+        self._unsafe.SetValidationMetricInterval.restype = ct.c_int32
+
+        self._unsafe.SetNextTerm.argtypes = [
+            # void * boosterHandle
+            ct.c_void_p,
+            # int64_t indexTerm
+            ct.c_int64,
+        ]
+        self._unsafe.SetNextTerm.restype = ct.c_int32
+
+        self._unsafe.GetValidationMetrics.argtypes = [
+            # void * boosterHandle
+            ct.c_void_p,
+            # int64_t countMetrics
+            ct.c_int64,
+            # double * metricsOut
+            ct.c_void_p,
+        ]
+        self._unsafe.GetValidationMetrics.restype = ct.c_int32
+
+        self._unsafe.BoostRounds.argtypes = [
+            # void * rng
+            ct.c_void_p,
+            # void * boosterHandle
+            ct.c_void_p,
+            # BoostFlags flags
+            ct.c_int32,
+            # double learningRate
+            ct.c_double,
+            # int64_t minSamplesLeaf
+            ct.c_int64,
+            # int64_t * leavesMax
+            ct.c_void_p,
+            # double greediness
+            ct.c_double,
+            # int64_t smoothingRounds
+            ct.c_int64,
+            # int64_t maxRounds
+            ct.c_int64,
+            # int64_t earlyStoppingRounds
+            ct.c_int64,
+            # double earlyStoppingTolerance
+            ct.c_double,
+            # int64_t * countRoundsOut
+            ct.POINTER(ct.c_int64),
+            # double * bestMetricOut
+            ct.POINTER(ct.c_double),
+        ]
+        self._unsafe.BoostRounds.restype = ct.c_int32
+
+        self._unsafe.BoostRoundsBags.argtypes = [
+            # int64_t countBoosters
+            ct.c_int64,
+            # void * rngs
+            ct.c_void_p,
+            # BoosterHandle * boosterHandles
+            ct.c_void_p,
+            # BoostFlags flags
+            ct.c_int32,
+            # double learningRate
+            ct.c_double,
+            # int64_t minSamplesLeaf
+            ct.c_int64,
+            # int64_t * leavesMax
+            ct.c_void_p,
+            # double greediness
+            ct.c_double,
+            # int64_t smoothingRounds
+            ct.c_int64,
+            # int64_t maxRounds
+            ct.c_int64,
+            # int64_t earlyStoppingRounds
+            ct.c_int64,
+            # double earlyStoppingTolerance
+            ct.c_double,
+            # int64_t * countRoundsOut
+            ct.c_void_p,
+            # double * bestMetricOut
+            ct.c_void_p,
+        ]
+        self._unsafe.BoostRoundsBags.restype = ct.c_int32
+
         self._unsafe.GetBestTermScores.argtypes = [
             # void * boosterHandle
             ct.c_void_p,
@@ -1191,6 +1405,74 @@ class Native:
         ]
         self._unsafe.CalcInteractionStrength.restype = ct.c_int32
 
+        self._unsafe.CalcInteractionStrengths.argtypes = [
+            # void * interactionHandle
+            ct.c_void_p,
+            # int64_t countPairs
+            ct.c_int64,
+            # int64_t * pairFeatureIndexes
+            ct.c_void_p,
+            # InteractionFlags flags
+            ct.c_int32,
+            # int64_t maxCardinality
+            ct.c_int64,
+            # int64_t minSamplesLeaf
+            ct.c_int64,
+            # double * avgInteractionStrengthsOut
+            ct.c_void_p,
+        ]
+        self._unsafe.CalcInteractionStrengths.restype = ct.c_int32
+
+        self._unsafe.CreateCompiledModel.argtypes = [
+            # int64_t countColumns
+            ct.c_int64,
+            # int64_t countBinnings
+            ct.c_int64,
+            # int64_t * binningColumns
+            ct.c_void_p,
+            # int64_t * binningCountBins
+            ct.c_void_p,
+            # int64_t * binningCountCuts
+            ct.c_void_p,
+            # double * cuts
+            ct.c_void_p,
+            # int64_t countScores
+            ct.c_int64,
+            # double * intercept
+            ct.c_void_p,
+            # int64_t countTerms
+            ct.c_int64,
+            # int64_t * dimensionCounts
+            ct.c_void_p,
+            # int64_t * binningIndexes
+            ct.c_void_p,
+            # double * termScores
+            ct.c_void_p,
+            # CompiledModelHandle * compiledModelHandleOut
+            ct.POINTER(ct.c_void_p),
+        ]
+        self._unsafe.CreateCompiledModel.restype = ct.c_int32
+
+        self._unsafe.FreeCompiledModel.argtypes = [
+            # void * compiledModelHandle
+            ct.c_void_p
+        ]
+        self._unsafe.FreeCompiledModel.restype = None
+
+        self._unsafe.PredictScores.argtypes = [
+            # void * compiledModelHandle
+            ct.c_void_p,
+            # int64_t countSamples
+            ct.c_int64,
+            # double * featureVals
+            ct.c_void_p,
+            # int32_t isFortranOrdered
+            ct.c_int32,
+            # double * scoresOut
+            ct.c_void_p,
+        ]
+        self._unsafe.PredictScores.restype = ct.c_int32
+
 
 class Booster(AbstractContextManager):
     """Lightweight wrapper for EBM C boosting code."""
@@ -1206,11 +1488,15 @@ class Booster(AbstractContextManager):
         is_private,
         objective,
         experimental_params,
+        metric=None,
+        inner_bags_subsample=False,
+        n_threads=None,
     ):
         """Initializes internal wrapper for EBM C code.
 
         Args:
-            dataset: binned data in a compressed native form
+            dataset: binned data in a compressed native form, or the filename
+                of one written by Native.write_dataset
             bag: definition of what data is included. 1 = training, -1 = validation, 0 = not included
             init_scores: predictions from a prior predictor
                 that this class will boost on top of.  For regression
@@ -1220,6 +1506,10 @@ class Booster(AbstractContextManager):
             n_inner_bags: number of inner bags.
             rng: native random number generator
             experimental_params: unused data that can be passed into the native layer for debugging
+            metric: optional comma separated validation metrics. The first one is used for early stopping
+            inner_bags_subsample: subsample each inner bag without replacement instead of bootstrapping it
+            n_threads: native threads used to boost the inner bags and split the histograms.
+                None uses the LIBEBM_THREADS environment variable, or 1 thread if it is not set
         """
 
         self.dataset = dataset
@@ -1231,6 +1521,9 @@ class Booster(AbstractContextManager):
         self.is_private = is_private
         self.objective = objective
         self.experimental_params = experimental_params
+        self.metric = metric
+        self.inner_bags_subsample = inner_bags_subsample
+        self.n_threads = n_threads
 
         # start off with an invalid _term_idx
         self._term_idx = -1
@@ -1238,6 +1531,22 @@ class Booster(AbstractContextManager):
     def __enter__(self):
         _log.info("Booster allocation start")
 
+        native = Native.get_native_singleton()
+        if isinstance(self.dataset, str):
+            # a file from Native.write_dataset. Processes that map the same file share one
+            # read-only copy, and CreateBooster does not reference the dataset after it returns
+            dataset = native.open_dataset(self.dataset)
+            try:
+                self._create(native, dataset)
+            finally:
+                native.close_dataset(dataset)
+        else:
+            self._create(native, self.dataset)
+
+        _log.info("Booster allocation end")
+        return self
+
+    def _create(self, native, dataset):
         if self.objective is None or self.objective.isspace():
             msg = "objective must be specified"
             _log.error(msg)
@@ -1250,10 +1559,8 @@ class Booster(AbstractContextManager):
             feature_indexes.extend(feature_idxs)
         feature_indexes = np.array(feature_indexes, ct.c_int64)
 
-        native = Native.get_native_singleton()
-
         n_samples, n_features, n_weights, n_targets = native.extract_dataset_header(
-            self.dataset
+            dataset
         )
 
         if n_weights != 0 and n_weights != 1:  # pragma: no cover
@@ -1262,14 +1569,14 @@ class Booster(AbstractContextManager):
         if n_targets != 1:  # pragma: no cover
             raise ValueError("n_targets must be 1")
 
-        class_counts = native.extract_target_classes(self.dataset, n_targets)
+        class_counts = native.extract_target_classes(dataset, n_targets)
         n_class_scores = sum(
             (Native.get_count_scores_c(n_classes) for n_classes in class_counts)
         )
 
         self._term_shapes = None
         if 0 < n_class_scores:
-            bin_counts = native.extract_bin_counts(self.dataset, n_features)
+            bin_counts = native.extract_bin_counts(dataset, n_features)
             self._term_shapes = []
             for feature_idxs in self.term_features:
                 dimensions = [bin_counts[feature_idx] for feature_idx in feature_idxs]
@@ -1297,11 +1604,17 @@ class Booster(AbstractContextManager):
             ):  # pragma: no cover
                 raise ValueError(f"init_scores should have {n_class_scores} scores")
 
+        flags = Native.CreateBoosterFlags_Default
+        if self.is_private:
+            flags |= Native.CreateBoosterFlags_DifferentialPrivacy
+        if self.inner_bags_subsample:
+            flags |= Native.CreateBoosterFlags_InnerBagsSubsample
+
         # Allocate external resources
         booster_handle = ct.c_void_p(0)
         return_code = native._unsafe.CreateBooster(
             Native._make_pointer(self.rng, np.ubyte, is_null_allowed=True),
-            Native._make_pointer(self.dataset, np.ubyte),
+            Native._make_pointer(dataset, np.ubyte),
             Native._make_pointer(self.bag, np.int8, 1, True),
             Native._make_pointer(
                 self.init_scores, np.float64, 2 if 1 < n_class_scores else 1, True
@@ -1310,8 +1623,10 @@ class Booster(AbstractContextManager):
             Native._make_pointer(dimension_counts, np.int64),
             Native._make_pointer(feature_indexes, np.int64),
             self.n_inner_bags,
-            self.is_private,
+            flags,
             self.objective.encode("ascii"),
+            None if self.metric is None else self.metric.encode("ascii"),
+            0 if self.n_threads is None else self.n_threads,
             Native._make_pointer(self.experimental_params, np.float64, 1, True),
             ct.byref(booster_handle),
         )
@@ -1320,9 +1635,6 @@ class Booster(AbstractContextManager):
 
         self._booster_handle = booster_handle.value
 
-        _log.info("Booster allocation end")
-        return self
-
     def __exit__(self, *args):
         self.close()
 
@@ -1414,6 +1726,95 @@ class Booster(AbstractContextManager):
         # _log.debug("Boosting step end")
         return avg_validation_metric.value
 
+    def boost_rounds(
+        self,
+        rng,
+        boost_flags,
+        learning_rate,
+        min_samples_leaf,
+        max_leaves,
+        greediness,
+        smoothing_rounds,
+        max_rounds,
+        early_stopping_rounds,
+        early_stopping_tolerance,
+    ):
+        """Runs the cyclic/greedy boosting schedule natively.
+
+        Args:
+            boost_flags: C interface options
+            learning_rate: Learning rate as a float.
+            min_samples_leaf: Min observations required to split.
+            max_leaves: Max leaf nodes on feature step.
+            greediness: Fraction of greedy rounds per cyclic round.
+            smoothing_rounds: Number of initial rounds with random splits.
+            max_rounds: Maximum number of rounds.
+            early_stopping_rounds: Rounds without improvement before stopping.
+            early_stopping_tolerance: Minimum improvement to reset early stopping.
+
+        Returns:
+            Tuple of the number of rounds run and the best validation metric.
+        """
+
+        self._term_idx = -1
+
+        native = Native.get_native_singleton()
+
+        n_rounds = ct.c_int64(0)
+        best_metric = ct.c_double(np.inf)
+        n_dimensions_max = max((len(x) for x in self.term_features), default=0)
+        max_leaves_arr = np.full(
+            max(n_dimensions_max, 1), max_leaves, dtype=ct.c_int64, order="C"
+        )
+
+        return_code = native._unsafe.BoostRounds(
+            Native._make_pointer(rng, np.ubyte, is_null_allowed=True),
+            self._booster_handle,
+            boost_flags,
+            learning_rate,
+            min_samples_leaf,
+            Native._make_pointer(max_leaves_arr, np.int64),
+            greediness,
+            smoothing_rounds,
+            max_rounds,
+            early_stopping_rounds,
+            early_stopping_tolerance,
+            ct.byref(n_rounds),
+            ct.byref(best_metric),
+        )
+        if return_code:  # pragma: no cover
+            raise Native._get_native_exception(return_code, "BoostRounds")
+
+        return n_rounds.value, best_metric.value
+
+    def set_validation_metric_interval(self, n_updates):
+        return_code = Native.get_native_singleton()._unsafe.SetValidationMetricInterval(
+            self._booster_handle, n_updates
+        )
+        if return_code:  # pragma: no cover
+            raise Native._get_native_exception(
+                return_code, "SetValidationMetricInterval"
+            )
+
+    def set_next_term(self, term_idx):
+        return_code = Native.get_native_singleton()._unsafe.SetNextTerm(
+            self._booster_handle, term_idx
+        )
+        if return_code:  # pragma: no cover
+            raise Native._get_native_exception(return_code, "SetNextTerm")
+
+    def get_validation_metrics(self, n_metrics):
+        metrics = np.empty(n_metrics, np.float64)
+        return_code = Native.get_native_singleton()._unsafe.GetValidationMetrics(
+            self._booster_handle,
+            n_metrics,
+            Native._make_pointer(metrics, np.float64, 1, True),
+        )
+        if return_code:  # pragma: no cover
+            raise Native._get_native_exception(return_code, "GetValidationMetrics")
+
+        return metrics
+
     def get_best_model(self):
         model = []
         for term_idx in range(len(self.term_features)):
@@ -1603,7 +2004,8 @@ class InteractionDetector(AbstractContextManager):
         """Initializes internal wrapper for EBM C code.
 
         Args:
-            dataset: binned data in a compressed native form
+            dataset: binned data in a compressed native form, or the filename
+                of one written by Native.write_dataset
             bag: definition of what data is included. 1 = training, -1 = validation, 0 = not included
             init_scores: predictions from a prior predictor
                 that this class will boost on top of.  For regression
@@ -1623,15 +2025,30 @@ class InteractionDetector(AbstractContextManager):
     def __enter__(self):
         _log.info("Allocation interaction start")
 
+        native = Native.get_native_singleton()
+        if isinstance(self.dataset, str):
+            # a file from Native.write_dataset. Processes that map the same file share one
+            # read-only copy, and CreateInteractionDetector does not reference the dataset
+            # after it returns
+            dataset = native.open_dataset(self.dataset)
+            try:
+                self._create(native, dataset)
+            finally:
+                native.close_dataset(dataset)
+        else:
+            self._create(native, self.dataset)
+
+        _log.info("Allocation interaction end")
+        return self
+
+    def _create(self, native, dataset):
         if self.objective is None or self.objective.isspace():
             msg = "objective must be specified"
             _log.error(msg)
             raise Exception(msg)
 
-        native = Native.get_native_singleton()
-
         n_samples, n_features, n_weights, n_targets = native.extract_dataset_header(
-            self.dataset
+            dataset
         )
 
         if n_weights != 0 and n_weights != 1:  # pragma: no cover
@@ -1640,7 +2057,7 @@ class InteractionDetector(AbstractContextManager):
         if n_targets != 1:  # pragma: no cover
             raise ValueError("n_targets must be 1")
 
-        class_counts = native.extract_target_classes(self.dataset, n_targets)
+        class_counts = native.extract_target_classes(dataset, n_targets)
         n_class_scores = sum(
             (Native.get_count_scores_c(n_classes) for n_classes in class_counts)
         )
@@ -1665,7 +2082,7 @@ class InteractionDetector(AbstractContextManager):
         # Allocate external resources
         interaction_handle = ct.c_void_p(0)
         return_code = native._unsafe.CreateInteractionDetector(
-            Native._make_pointer(self.dataset, np.ubyte),
+            Native._make_pointer(dataset, np.ubyte),
             Native._make_pointer(self.bag, np.int8, 1, True),
             Native._make_pointer(
                 self.init_scores, np.float64, 2 if 1 < n_class_scores else 1, True
@@ -1680,9 +2097,6 @@ class InteractionDetector(AbstractContextManager):
 
         self._interaction_handle = interaction_handle.value
 
-        _log.info("Allocation interaction end")
-        return self
-
     def __exit__(self, *args):
         self.close()
 
@@ -1723,3 +2137,156 @@ class InteractionDetector(AbstractContextManager):
 
         _log.info("Fast interaction strength end")
         return strength.value
+
+    def calc_interaction_strengths(
+        self, pairs, interaction_flags, max_cardinality, min_samples_leaf
+    ):
+        """Provides strength measurements for many feature pairs at once. Higher is better.
+
+        Pairs that share a feature are binned together in one pass over the data.
+        """
+        _log.info("Fast interaction strengths start")
+
+        native = Native.get_native_singleton()
+
+        pairs = np.array(pairs, np.int64).reshape(-1, 2)
+        strengths = np.zeros(pairs.shape[0], np.float64)
+        if pairs.shape[0] != 0:
+            return_code = native._unsafe.CalcInteractionStrengths(
+                self._interaction_handle,
+                pairs.shape[0],
+                Native._make_pointer(pairs, np.int64, 2),
+                interaction_flags,
+                max_cardinality,
+                min_samples_leaf,
+                Native._make_pointer(strengths, np.float64),
+            )
+            if return_code:  # pragma: no cover
+                raise Native._get_native_exception(
+                    return_code, "CalcInteractionStrengths"
+                )
+
+        _log.info("Fast interaction strengths end")
+        return strengths
+
+
+class CompiledModel(AbstractContextManager):
+    """Lightweight wrapper for the EBM C batched scoring code."""
+
+    def __init__(self, n_columns, binnings, intercept, term_binnings, term_scores):
+        """Initializes internal wrapper for EBM C code.
+
+        Args:
+            n_columns: number of columns in the X that will be scored
+            binnings: list of (column_index, n_bins, cuts) tuples.  cuts is None
+                for columns that already hold bin indexes (eg: categoricals)
+            intercept: array of n_scores intercepts
+            term_binnings: list holding the binning indexes of each term
+            term_scores: list holding the C ordered score tensor of each term
+
+        """
+
+        self.n_columns = n_columns
+        self.binnings = binnings
+        self.intercept = intercept
+        self.term_binnings = term_binnings
+        self.term_scores = term_scores
+
+    def __enter__(self):
+        _log.info("Allocation compiled model start")
+
+        native = Native.get_native_singleton()
+
+        intercept = np.ascontiguousarray(self.intercept, dtype=np.float64).reshape(-1)
+
+        binning_columns = np.array([b[0] for b in self.binnings], np.int64)
+        binning_bins = np.array([b[1] for b in self.binnings], np.int64)
+        binning_cuts = np.array(
+            [-1 if b[2] is None else len(b[2]) for b in self.binnings], np.int64
+        )
+        cuts = [b[2] for b in self.binnings if b[2] is not None and len(b[2]) != 0]
+        cuts = (
+            np.concatenate(cuts).astype(np.float64, copy=False)
+            if len(cuts) != 0
+            else np.empty(0, np.float64)
+        )
+
+        dimension_counts = np.array([len(t) for t in self.term_binnings], np.int64)
+        binning_indexes = np.array(
+            [i for t in self.term_binnings for i in t], np.int64
+        )
+        scores = [np.ravel(s, order="C") for s in self.term_scores]
+        term_scores = (
+            np.concatenate(scores).astype(np.float64, copy=False)
+            if len(scores) != 0
+            else np.empty(0, np.float64)
+        )
+
+        compiled_model_handle = ct.c_void_p(0)
+        return_code = native._unsafe.CreateCompiledModel(
+            self.n_columns,
+            len(binning_columns),
+            Native._make_pointer(binning_columns, np.int64),
+            Native._make_pointer(binning_bins, np.int64),
+            Native._make_pointer(binning_cuts, np.int64),
+            Native._make_pointer(cuts, np.float64),
+            len(intercept),
+            Native._make_pointer(intercept, np.float64),
+            len(dimension_counts),
+            Native._make_pointer(dimension_counts, np.int64),
+            Native._make_pointer(binning_indexes, np.int64),
+            Native._make_pointer(term_scores, np.float64),
+            ct.byref(compiled_model_handle),
+        )
+        if return_code:  # pragma: no cover
+            raise Native._get_native_exception(return_code, "CreateCompiledModel")
+
+        self._compiled_model_handle = compiled_model_handle.value
+        self._n_scores = len(intercept)
+
+        _log.info("Allocation compiled model end")
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def close(self):
+        """Deallocates C objects used for scoring."""
+        _log.info("Deallocation compiled model start")
+
+        compiled_model_handle = getattr(self, "_compiled_model_handle", None)
+        if compiled_model_handle:
+            native = Native.get_native_singleton()
+            self._compiled_model_handle = None
+            native._unsafe.FreeCompiledModel(compiled_model_handle)
+
+        _log.info("Deallocation compiled model end")
+
+    def predict_scores(self, X):
+        """Returns the summed scores of every term for each row of X."""
+
+        native = Native.get_native_singleton()
+
+        if X.dtype.type is not np.float64:
+            X = X.astype(np.float64)
+
+        is_fortran = not X.flags.c_contiguous and X.flags.f_contiguous
+        if is_fortran:
+            # the transpose of a Fortran ordered matrix is C ordered, which is what _make_pointer requires
+            X_native = X.T
+        else:
+            X_native = np.ascontiguousarray(X)
+
+        n_samples = X.shape[0]
+        scores = np.empty((n_samples, self._n_scores), np.float64, order="C")
+        return_code = native._unsafe.PredictScores(
+            self._compiled_model_handle,
+            n_samples,
+            Native._make_pointer(X_native, np.float64, 2),
+            1 if is_fortran else 0,
+            Native._make_pointer(scores, np.float64, 2),
+        )
+        if return_code:  # pragma: no cover
+            raise Native._get_native_exception(return_code, "PredictScores")
+
+        return scores if self._n_scores != 1 else scores.reshape(-1)
@@ -30,26 +30,45 @@ def rank_interactions(
 ):
     try:
         interaction_strengths = []
+
+        def add_item(item):
+            if n_output_interactions <= 0:
+                interaction_strengths.append(item)
+            else:
+                if len(interaction_strengths) == n_output_interactions:
+                    heapq.heappushpop(interaction_strengths, item)
+                else:
+                    heapq.heappush(interaction_strengths, item)
+
         with InteractionDetector(
             dataset, bag, init_scores, is_private, objective, experimental_params
         ) as interaction_detector:
+            # pairs are scored in one batched call, which bins pairs that share a
+            # feature together and spreads the work over threads
+            pairs = []
             for feature_idxs in iter_term_features:
                 if tuple(sorted(feature_idxs)) in exclude:
                     continue
+                if len(feature_idxs) == 2:
+                    pairs.append(feature_idxs)
+                    continue
                 strength = interaction_detector.calc_interaction_strength(
                     feature_idxs,
                     interaction_flags,
                     max_cardinality,
                     min_samples_leaf,
                 )
-                item = (strength, feature_idxs)
-                if n_output_interactions <= 0:
-                    interaction_strengths.append(item)
-                else:
-                    if len(interaction_strengths) == n_output_interactions:
-                        heapq.heappushpop(interaction_strengths, item)
-                    else:
-                        heapq.heappush(interaction_strengths, item)
+                add_item((strength, feature_idxs))
+
+            if len(pairs) != 0:
+                strengths = interaction_detector.calc_interaction_strengths(
+                    pairs,
+                    interaction_flags,
+                    max_cardinality,
+                    min_samples_leaf,
+                )
+                for strength, feature_idxs in zip(strengths, pairs):
+                    add_item((float(strength), feature_idxs))
 
         interaction_strengths.sort(reverse=True)
         return interaction_strengths
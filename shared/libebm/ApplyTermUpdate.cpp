@@ -13,8 +13,10 @@
 
 #include "Feature.hpp"
 #include "Term.hpp"
+#include "InnerBag.hpp"
 #include "Transpose.hpp"
 #include "Tensor.hpp"
+#include "Bin.hpp"
 #include "BoosterCore.hpp"
 #include "BoosterShell.hpp"
 
@@ -23,6 +25,211 @@ namespace DEFINED_ZONE_NAME {
 #error DEFINED_ZONE_NAME must be defined
 #endif // DEFINED_ZONE_NAME
 
+extern ErrorEbm BinSumsBoosting(BinSumsBoostingBridge * const pParams);
+extern size_t GetCountBinSumsBoostingShards(const size_t cShardsMax, const size_t cSamples);
+
+// the scores, gradients and hessians of one chunk should still be in the L2 cache when we sum them into the
+// next term's histogram
+static constexpr size_t k_cBytesFusedChunkMax = size_t { 128 } * size_t { 1024 };
+
+static size_t GetBitPackWordIndex(
+   const size_t cSamples,
+   const size_t cItemsPerBitPack,
+   const size_t cLanes,
+   const size_t iSample
+) {
+   // iSample must be 0 or the first sample of an interleaved block
+   if(size_t { 0 } == iSample) {
+      return size_t { 0 };
+   }
+   const size_t cDregs = GetCountBitPackDregs(cSamples, cItemsPerBitPack, cLanes);
+   EBM_ASSERT(cDregs <= iSample);
+   EBM_ASSERT(size_t { 0 } == (iSample - cDregs) % (cItemsPerBitPack * cLanes));
+   return GetCountBitPacksDregs(cDregs, cItemsPerBitPack) + (iSample - cDregs) / (cItemsPerBitPack * cLanes) * cLanes;
+}
+
+template<typename TScore>
+static void ApplySparseNonDefaults(
+   const SparseInputDataBoosting * const pSparse,
+   const size_t cScores,
+   const FloatScore * const aUpdateScores,
+   TScore * const aScores
+) {
+   // The training set has no packed copy of a sparse term, so the objective adds the default bin's update to
+   // every sample.  Beforehand we shift each non-default sample by the difference from its own bin's update.
+   // RMSE keeps no scores, only the residuals in the gradients, which move by the same amount.
+   const FloatScore * const aDefaultUpdateScores = &aUpdateScores[pSparse->m_iDefaultBin * cScores];
+
+   const SparseEntryBoosting * pNonDefault = ArrayToPointer(pSparse->m_nonDefaults);
+   const SparseEntryBoosting * const pNonDefaultsEnd = &pNonDefault[pSparse->m_cNonDefaults];
+   while(pNonDefaultsEnd != pNonDefault) {
+      const FloatScore * const aBinUpdateScores = &aUpdateScores[pNonDefault->m_iBin * cScores];
+      TScore * const aSampleScoresNonDefault = &aScores[pNonDefault->m_iSample * cScores];
+      size_t iScore = 0;
+      do {
+         aSampleScoresNonDefault[iScore] += static_cast<TScore>(aBinUpdateScores[iScore] - aDefaultUpdateScores[iScore]);
+         ++iScore;
+      } while(cScores != iScore);
+      ++pNonDefault;
+   }
+}
+
+static bool IsFusableNextTerm(BoosterShell * const pBoosterShell, const size_t iTermNext) {
+   // the fused histogram has to be exactly the one that GenerateTermUpdate would build, so we only handle
+   // the single histogram paths of BoostSingleDimensional and BoostMultiDimensional
+   if(BoosterShell::k_illegalTermIndex == iTermNext) {
+      return false;
+   }
+   BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
+   if(size_t { 1 } < pBoosterCore->GetCountInnerBags() || nullptr == pBoosterCore->GetInnerBags()) {
+      return false;
+   }
+   if(size_t { 1 } != GetCountBinSumsBoostingShards(
+      pBoosterShell->GetCountShards(), pBoosterCore->GetTrainingSet()->GetCountSamples())) {
+      // the sharded histogram adds the samples in a different order, so the results would not match
+      return false;
+   }
+   const Term * const pTermNext = pBoosterCore->GetTerms()[iTermNext];
+   if(size_t { 0 } == pTermNext->GetCountTensorBins()) {
+      return false;
+   }
+   const size_t cRealDimensions = pTermNext->GetCountRealDimensions();
+   if(size_t { 0 } == cRealDimensions || size_t { 2 } < cRealDimensions) {
+      return false;
+   }
+   return nullptr == pBoosterCore->GetTrainingSet()->GetSparseInputDataPointer(iTermNext);
+}
+
+static ErrorEbm ApplyUpdateFusedBinSums(
+   BoosterShell * const pBoosterShell,
+   const size_t iTermNext,
+   const ApplyUpdateBridge * const pData
+) {
+   // Applying the update rewrites every gradient, and the next GenerateTermUpdate reads them all again to build
+   // its histogram.  Doing both a chunk at a time consumes the gradients while they are still in the cache.
+   // The samples are added in the same order as BinSumsBoosting would add them, so the histogram is identical.
+
+   BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
+   const DataSetBoosting * const pTrainingSet = pBoosterCore->GetTrainingSet();
+   const Term * const pTermNext = pBoosterCore->GetTerms()[iTermNext];
+   const InnerBag * const pInnerBag = pBoosterCore->GetInnerBags()[0];
+
+   const bool bHessian = pBoosterCore->IsHessian();
+   const size_t cScores = pData->m_cScores;
+   const size_t cSamples = pData->m_cSamples;
+   const size_t cLanes = pTrainingSet->GetCountBitPackLanes();
+
+   const size_t cTensorBins = pTermNext->GetCountTensorBins();
+   EBM_ASSERT(!IsOverflowBinSize<FloatFast>(bHessian, cScores)); // we check in CreateBooster
+   const size_t cBytesPerFastBin = GetBinSize<FloatFast>(bHessian, cScores);
+   EBM_ASSERT(!IsMultiplyError(cBytesPerFastBin, cTensorBins));
+
+   BinBase * const aFastBins = pBoosterShell->GetBoostingFastBinsTemp();
+   EBM_ASSERT(nullptr != aFastBins);
+   aFastBins->ZeroMem(cBytesPerFastBin, cTensorBins);
+
+   const size_t cItemsPerBitPackCur = k_cItemsPerBitPackNone == pData->m_cPack ? size_t { 1 } : 
+      static_cast<size_t>(pData->m_cPack);
+   EBM_ASSERT(k_cItemsPerBitPackNone != pTermNext->GetTermBitPack());
+   const size_t cItemsPerBitPackNext = static_cast<size_t>(pTermNext->GetTermBitPack());
+
+   // Each term's dregs are at the start, so counting back from the end in whole blocks of both terms lands on a 
+   // block boundary in each.  The first chunk takes the remainder along with both terms' dregs.
+   const size_t cSamplesPerBlockCur = cItemsPerBitPackCur * cLanes;
+   const size_t cSamplesPerBlockNext = cItemsPerBitPackNext * cLanes;
+   size_t gcd = cSamplesPerBlockCur;
+   size_t other = cSamplesPerBlockNext;
+   while(size_t { 0 } != other) {
+      const size_t remainder = gcd % other;
+      gcd = other;
+      other = remainder;
+   }
+   const size_t cSamplesPerUnit = cSamplesPerBlockCur / gcd * cSamplesPerBlockNext;
+
+   const size_t cFloatsPerSample = cScores * (bHessian ? size_t { 3 } : size_t { 2 });
+   size_t cSamplesPerChunk = k_cBytesFusedChunkMax / (sizeof(FloatFast) * cFloatsPerSample) / cSamplesPerUnit * cSamplesPerUnit;
+   cSamplesPerChunk = size_t { 0 } == cSamplesPerChunk ? cSamplesPerUnit : cSamplesPerChunk;
+
+   const size_t cFloatsGradHessPerSample = bHessian ? cScores << 1 : cScores;
+   const size_t cBytesTargetsPerSample = pTrainingSet->GetCountBytesTargetsPerSample();
+
+   size_t iSampleStart = 0;
+   size_t iSampleEnd = cSamples % cSamplesPerChunk;
+   iSampleEnd = size_t { 0 } == iSampleEnd ? cSamplesPerChunk : iSampleEnd;
+   do {
+      const size_t cChunkSamples = iSampleEnd - iSampleStart;
+
+      ApplyUpdateBridge data = *pData;
+      data.m_cSamples = cChunkSamples;
+      if(k_cItemsPerBitPackNone != data.m_cPack) {
+         data.m_aPacked += GetBitPackWordIndex(cSamples, cItemsPerBitPackCur, cLanes, iSampleStart);
+      }
+      if(nullptr != data.m_aTargets) {
+         data.m_aTargets = static_cast<const unsigned char *>(data.m_aTargets) + cBytesTargetsPerSample * iSampleStart;
+      }
+      if(nullptr != data.m_aSampleScores) {
+         data.m_aSampleScores = static_cast<FloatScore *>(data.m_aSampleScores) + cScores * iSampleStart;
+      }
+      data.m_aGradientsAndHessians = static_cast<FloatFast *>(data.m_aGradientsAndHessians) + 
+         cFloatsGradHessPerSample * iSampleStart;
+      ErrorEbm error = pBoosterCore->ObjectiveApplyUpdate(&data);
+      if(Error_None != error) {
+         return error;
+      }
+
+      BinSumsBoostingBridge params;
+      params.m_bHessian = bHessian ? EBM_TRUE : EBM_FALSE;
+      params.m_cScores = cScores;
+      params.m_cPack = pTermNext->GetTermBitPack();
+      params.m_cBitPackLanes = cLanes;
+      params.m_cSamples = cChunkSamples;
+      params.m_aGradientsAndHessians = static_cast<const FloatFast *>(data.m_aGradientsAndHessians);
+      params.m_aWeights = pInnerBag->GetWeights();
+      if(nullptr != params.m_aWeights) {
+         params.m_aWeights += iSampleStart;
+      }
+      params.m_pCountOccurrences = pInnerBag->GetCountOccurrences();
+      if(nullptr != params.m_pCountOccurrences) {
+         params.m_pCountOccurrences += iSampleStart;
+      }
+      // the fused path only handles a single inner bag, which never shares the sample major arrays
+      EBM_ASSERT(size_t { 1 } == pInnerBag->GetStride());
+      params.m_cInnerBagsStride = size_t { 1 };
+      params.m_aSampleBits = pInnerBag->GetSampleBits();
+      params.m_iSampleBitFirst = iSampleStart;
+      params.m_aPacked = pTrainingSet->GetInputDataPointer(iTermNext) + 
+         GetBitPackWordIndex(cSamples, cItemsPerBitPackNext, cLanes, iSampleStart);
+      params.m_aFastBins = aFastBins;
+#ifndef NDEBUG
+      params.m_pDebugFastBinsEnd = IndexBin(aFastBins, cBytesPerFastBin * cTensorBins);
+      if(nullptr == params.m_aWeights && nullptr == params.m_aSampleBits) {
+         params.m_totalWeightDebug = static_cast<FloatFast>(cChunkSamples);
+      } else {
+         FloatFast weightTotalDebug = 0;
+         for(size_t iSample = 0; iSample < cChunkSamples; ++iSample) {
+            FloatFast weight = nullptr == params.m_aWeights ? FloatFast { 1 } : params.m_aWeights[iSample];
+            if(nullptr != params.m_aSampleBits) {
+               weight *= static_cast<FloatFast>(GetSampleBit(params.m_aSampleBits, iSampleStart + iSample));
+            }
+            weightTotalDebug += weight;
+         }
+         params.m_totalWeightDebug = weightTotalDebug;
+      }
+#endif // NDEBUG
+      error = BinSumsBoosting(&params);
+      if(Error_None != error) {
+         return error;
+      }
+
+      iSampleStart = iSampleEnd;
+      iSampleEnd += cSamplesPerChunk;
+   } while(cSamples != iSampleStart);
+
+   pBoosterShell->SetFusedBinsTermIndex(iTermNext);
+   pBoosterShell->SetFusedBinsGeneration(pBoosterCore->GetGradientGeneration());
+   return Error_None;
+}
+
 // we made this a global because if we had put this variable inside the BoosterCore object, then we would need to dereference that before 
 // getting the count.  By making this global we can send a log message incase a bad BoosterCore object is sent into us
 // we only decrease the count if the count is non-zero, so at worst if there is a race condition then we'll output this log message more 
@@ -115,7 +322,7 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION ApplyTermUpdate(
       return error;
    }
 
-   const FloatFast * const aUpdateScores = pBoosterShell->GetTermUpdate()->GetTensorScoresPointer();
+   const FloatScore * const aUpdateScores = pBoosterShell->GetTermUpdate()->GetTensorScoresPointer();
 
    // our caller can give us one of these bad types of inputs:
    //  1) NaN values
@@ -131,10 +338,16 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION ApplyTermUpdate(
    // This is an acceptable compromise.  We protect our term scores since the user might want to extract them AFTER we overlfow our measurment metric
    // so we don't want to overflow the values to NaN or +-infinity there, and it's very cheap for us to check for overflows when applying the term score updates
    pBoosterCore->GetCurrentModel()[iTerm]->AddExpandedWithBadValueProtection(aUpdateScores);
+   pBoosterCore->MarkTermDirty(iTerm);
+
+   // the gradients are about to change, so any histogram or total built from the old ones is stale, including
+   // those held by other shells on this BoosterCore
+   pBoosterShell->SetFusedBinsTermIndex(BoosterShell::k_illegalTermIndex);
+   pBoosterCore->NextGradientGeneration();
 
    if(0 != pBoosterCore->GetTrainingSet()->GetCountSamples()) {
       ApplyUpdateBridge data;
-      data.m_cScores = GetCountScores(pBoosterCore->GetCountClasses());
+      data.m_cScores = pBoosterCore->GetCountScores();
       data.m_cPack = pTerm->GetTermBitPack();
       data.m_bHessianNeeded = EBM_TRUE;
       data.m_bCalcMetric = false;
@@ -146,7 +359,30 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION ApplyTermUpdate(
       data.m_aWeights = nullptr;
       data.m_aSampleScores = pBoosterCore->GetTrainingSet()->GetSampleScores();
       data.m_aGradientsAndHessians = pBoosterCore->GetTrainingSet()->GetGradientsAndHessiansPointer();
-      error = pBoosterCore->ObjectiveApplyUpdate(&data);
+      const SparseInputDataBoosting * const pSparse = pBoosterCore->GetTrainingSet()->GetSparseInputDataPointer(iTerm);
+      if(nullptr != pSparse) {
+         FloatScore * const aSampleScores = pBoosterCore->GetTrainingSet()->GetSampleScores();
+         if(nullptr != aSampleScores) {
+            ApplySparseNonDefaults(pSparse, data.m_cScores, aUpdateScores, aSampleScores);
+         } else {
+            EBM_ASSERT(size_t { 1 } == data.m_cScores);
+            ApplySparseNonDefaults(
+               pSparse,
+               data.m_cScores,
+               aUpdateScores,
+               pBoosterCore->GetTrainingSet()->GetGradientsAndHessiansPointer()
+            );
+         }
+         data.m_cPack = k_cItemsPerBitPackNone;
+         data.m_aUpdateTensorScores = &aUpdateScores[pSparse->m_iDefaultBin * data.m_cScores];
+         EBM_ASSERT(nullptr == data.m_aPacked);
+      }
+      const size_t iTermNext = pBoosterShell->GetNextTermIndex();
+      if(IsFusableNextTerm(pBoosterShell, iTermNext)) {
+         error = ApplyUpdateFusedBinSums(pBoosterShell, iTermNext, &data);
+      } else {
+         error = pBoosterCore->ObjectiveApplyUpdate(&data);
+      }
       if(Error_None != error) {
          return error;
       }
@@ -165,17 +401,29 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION ApplyTermUpdate(
       // but it isn't guaranteed, so let's check for zero samples in the validation set this better way
       // https://stackoverflow.com/questions/31225264/what-is-the-result-of-comparing-a-number-with-nan
 
+      // on updates that skip the metric we only update the scores, which avoids the exp/log work of the metric
+      const bool bCalcMetric = pBoosterCore->AdvanceMetricSchedule();
+
+      // when the caller asked for metrics we only update the scores here and compute the metrics afterwards
+      const size_t cMetrics = pBoosterCore->GetCountMetrics();
+      const bool bObjectiveMetric = bCalcMetric && size_t { 0 } == cMetrics;
+
+      const double totalWeight = static_cast<double>(pBoosterCore->GetValidationWeightTotal());
+      EBM_ASSERT(!std::isnan(totalWeight));
+      EBM_ASSERT(!std::isinf(totalWeight));
+      EBM_ASSERT(0.0 < totalWeight);
+
       ApplyUpdateBridge data;
-      data.m_cScores = GetCountScores(pBoosterCore->GetCountClasses());
+      data.m_cScores = pBoosterCore->GetCountScores();
       data.m_cPack = pTerm->GetTermBitPack();
       data.m_bHessianNeeded = EBM_TRUE;
-      data.m_bCalcMetric = true;
+      data.m_bCalcMetric = bObjectiveMetric;
       data.m_aMulticlassMidwayTemp = pBoosterShell->GetMulticlassMidwayTemp();
       data.m_aUpdateTensorScores = aUpdateScores;
       data.m_cSamples = pBoosterCore->GetValidationSet()->GetCountSamples();
       data.m_aPacked = pBoosterCore->GetValidationSet()->GetInputDataPointer(iTerm);
       data.m_aTargets = pBoosterCore->GetValidationSet()->GetTargetDataPointer();
-      data.m_aWeights = pBoosterCore->GetValidationWeights();
+      data.m_aWeights = bObjectiveMetric ? pBoosterCore->GetValidationWeights() : nullptr;
       data.m_aSampleScores = pBoosterCore->GetValidationSet()->GetSampleScores();
       data.m_aGradientsAndHessians = pBoosterCore->GetValidationSet()->GetGradientsAndHessiansPointer();
       error = pBoosterCore->ObjectiveApplyUpdate(&data);
@@ -183,57 +431,64 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION ApplyTermUpdate(
          return error;
       }
 
-      validationMetricAvg = pBoosterCore->FinishMetric(data.m_metricOut);
-
-      if(EBM_FALSE != pBoosterCore->MaximizeMetric()) {
-         // make it so that we always return values such that the caller wants to minimize them. If the caller
-         // wants more information they can determine if they should negate the values we return them.
-         validationMetricAvg = -validationMetricAvg;
+      if(!bCalcMetric) {
+         validationMetricAvg = pBoosterCore->GetLastValidationMetric();
+      } else if(bObjectiveMetric) {
+         validationMetricAvg = pBoosterCore->FinishMetric(data.m_metricOut);
+
+         if(EBM_FALSE != pBoosterCore->MaximizeMetric()) {
+            // make it so that we always return values such that the caller wants to minimize them. If the caller
+            // wants more information they can determine if they should negate the values we return them.
+            validationMetricAvg = -validationMetricAvg;
+         }
+
+         EBM_ASSERT(!std::isnan(validationMetricAvg)); // NaNs can happen, but we should have cleaned them up
+
+         validationMetricAvg /= totalWeight; // if totalWeight < 1.0 then this can overflow to +inf
+      } else {
+         MetricBridge metricData;
+         metricData.m_cScores = data.m_cScores;
+         metricData.m_cSamples = data.m_cSamples;
+         // RMSE keeps only the residuals on the validation set and no scores
+         const bool bResiduals = nullptr == data.m_aSampleScores;
+         metricData.m_aSampleScores = data.m_aSampleScores;
+         metricData.m_aResiduals = bResiduals ? data.m_aGradientsAndHessians : nullptr;
+         metricData.m_aTargets = data.m_aTargets;
+         metricData.m_aWeights = pBoosterCore->GetValidationWeights();
+         metricData.m_totalWeight = totalWeight;
+
+         double * const aValidationMetrics = pBoosterCore->GetValidationMetrics();
+         EBM_ASSERT(nullptr != aValidationMetrics);
+         size_t iMetric = 0;
+         do {
+            error = pBoosterCore->CalcMetric(iMetric, &metricData);
+            if(Error_None != error) {
+               return error;
+            }
+            aValidationMetrics[iMetric] = metricData.m_metricOut;
+            ++iMetric;
+         } while(cMetrics != iMetric);
+
+         // metrics come back already averaged over the validation weights.  The first one drives early stopping
+         validationMetricAvg = aValidationMetrics[0];
+         if(EBM_FALSE != pBoosterCore->MetricMaximize(0)) {
+            validationMetricAvg = -validationMetricAvg;
+         }
       }
 
       EBM_ASSERT(!std::isnan(validationMetricAvg)); // NaNs can happen, but we should have cleaned them up
+      pBoosterCore->SetLastValidationMetric(validationMetricAvg);
 
-      const double totalWeight = static_cast<double>(pBoosterCore->GetValidationWeightTotal());
-      EBM_ASSERT(!std::isnan(totalWeight));
-      EBM_ASSERT(!std::isinf(totalWeight));
-      EBM_ASSERT(0.0 < totalWeight);
-      validationMetricAvg /= totalWeight; // if totalWeight < 1.0 then this can overflow to +inf
-
-      EBM_ASSERT(!std::isnan(validationMetricAvg)); // NaNs can happen, but we should have cleaned them up
-
-      if(LIKELY(validationMetricAvg < pBoosterCore->GetBestModelMetric())) {
+      // the terms updated since the last metric stay in the dirty list until a calculated metric improves
+      if(bCalcMetric && LIKELY(validationMetricAvg < pBoosterCore->GetBestModelMetric())) {
          // we keep on improving, so this is more likely than not, and we'll exit if it becomes negative a lot
          pBoosterCore->SetBestModelMetric(validationMetricAvg);
 
-         // TODO: We're doing a lot more work here than necessary.  Typically in the early phases we improve
-         // on each boosting step, and in that case we should only need to copy over the term's tensor that
-         // we just improved on since all the other ones are up to date.  Later though we'll get into a stage
-         // where some of the terms will improve on the metric but others won't. At that point if we see
-         // two terms not improve the stopping metric, then we see one that does, we'd need to copy over the
-         // last 3 terms to maintain consistency.  That requires that we keep track of the terms we boosted
-         // on since the last improvement.  This can get even more interesting if we do more than a full boosting
-         // round where a term might have been boosted on a few times.  In that case we only need to overwrite
-         // it once.  We can do this by keeping a set that holds the terms that have been bosted on since the last
-         // improvement and then we would overwrite only those whenever we see an improvement. Instead of a set though
-         // we could instead maintan a reversed linked list of terms that we've boosted on using a flat array
-         // with 1 pointer entry for each term.  If a term is already in the linked list there is no need to add it
-         // again.  This way we can avoid a sweep of the entire list of terms on each boosting round.
-
-         size_t iTermCopy = 0;
-         size_t iTermCopyEnd = pBoosterCore->GetCountTerms();
-         do {
-            if(nullptr != pBoosterCore->GetCurrentModel()[iTermCopy]) {
-               EBM_ASSERT(nullptr != pBoosterCore->GetBestModel()[iTermCopy]);
-               error = pBoosterCore->GetBestModel()[iTermCopy]->Copy(*pBoosterCore->GetCurrentModel()[iTermCopy]);
-               if(Error_None != error) {
-                  LOG_0(Trace_Verbose, "Exited ApplyTermUpdateInternal with memory allocation error in copy");
-                  return error;
-               }
-            } else {
-               EBM_ASSERT(nullptr == pBoosterCore->GetBestModel()[iTermCopy]);
-            }
-            ++iTermCopy;
-         } while(iTermCopy != iTermCopyEnd);
+         error = pBoosterCore->CopyDirtyTermsToBestModel();
+         if(Error_None != error) {
+            LOG_0(Trace_Verbose, "Exited ApplyTermUpdateInternal with memory allocation error in copy");
+            return error;
+         }
       }
    }
    
@@ -254,6 +509,130 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION ApplyTermUpdate(
    return Error_None;
 }
 
+EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION SetValidationMetricInterval(
+   BoosterHandle boosterHandle,
+   IntEbm countUpdates
+) {
+   LOG_N(
+      Trace_Info,
+      "Entered SetValidationMetricInterval: "
+      "boosterHandle=%p, "
+      "countUpdates=%" IntEbmPrintf
+      ,
+      static_cast<void *>(boosterHandle),
+      countUpdates
+   );
+
+   BoosterShell * const pBoosterShell = BoosterShell::GetBoosterShellFromHandle(boosterHandle);
+   if(nullptr == pBoosterShell) {
+      // already logged
+      return Error_IllegalParamVal;
+   }
+
+   if(countUpdates < IntEbm { 1 }) {
+      LOG_0(Trace_Error, "ERROR SetValidationMetricInterval countUpdates must be 1 or more");
+      return Error_IllegalParamVal;
+   }
+   if(IsConvertError<size_t>(countUpdates)) {
+      LOG_0(Trace_Error, "ERROR SetValidationMetricInterval IsConvertError<size_t>(countUpdates)");
+      return Error_IllegalParamVal;
+   }
+
+   pBoosterShell->GetBoosterCore()->SetUpdatesPerMetric(static_cast<size_t>(countUpdates));
+
+   LOG_0(Trace_Info, "Exited SetValidationMetricInterval");
+   return Error_None;
+}
+
+EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION SetNextTerm(
+   BoosterHandle boosterHandle,
+   IntEbm indexTerm
+) {
+   LOG_N(
+      Trace_Verbose,
+      "Entered SetNextTerm: "
+      "boosterHandle=%p, "
+      "indexTerm=%" IntEbmPrintf
+      ,
+      static_cast<void *>(boosterHandle),
+      indexTerm
+   );
+
+   BoosterShell * const pBoosterShell = BoosterShell::GetBoosterShellFromHandle(boosterHandle);
+   if(nullptr == pBoosterShell) {
+      // already logged
+      return Error_IllegalParamVal;
+   }
+
+   if(indexTerm < IntEbm { 0 }) {
+      pBoosterShell->SetNextTermIndex(BoosterShell::k_illegalTermIndex);
+      return Error_None;
+   }
+   if(IsConvertError<size_t>(indexTerm) || pBoosterShell->GetBoosterCore()->GetCountTerms() <= static_cast<size_t>(indexTerm)) {
+      pBoosterShell->SetNextTermIndex(BoosterShell::k_illegalTermIndex);
+      LOG_0(Trace_Error, "ERROR SetNextTerm indexTerm above the number of terms that we have");
+      return Error_IllegalParamVal;
+   }
+
+   pBoosterShell->SetNextTermIndex(static_cast<size_t>(indexTerm));
+   return Error_None;
+}
+
+static int g_cLogGetValidationMetrics = 10;
+
+EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION GetValidationMetrics(
+   BoosterHandle boosterHandle,
+   IntEbm countMetrics,
+   double * metricsOut
+) {
+   LOG_COUNTED_N(
+      &g_cLogGetValidationMetrics,
+      Trace_Info,
+      Trace_Verbose,
+      "GetValidationMetrics: "
+      "boosterHandle=%p, "
+      "countMetrics=%" IntEbmPrintf ", "
+      "metricsOut=%p"
+      ,
+      static_cast<void *>(boosterHandle),
+      countMetrics,
+      static_cast<void *>(metricsOut)
+   );
+
+   BoosterShell * const pBoosterShell = BoosterShell::GetBoosterShellFromHandle(boosterHandle);
+   if(nullptr == pBoosterShell) {
+      // already logged
+      return Error_IllegalParamVal;
+   }
+   BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
+   EBM_ASSERT(nullptr != pBoosterCore);
+
+   if(IsConvertError<size_t>(countMetrics)) {
+      LOG_0(Trace_Error, "ERROR GetValidationMetrics IsConvertError<size_t>(countMetrics)");
+      return Error_IllegalParamVal;
+   }
+   const size_t cMetrics = static_cast<size_t>(countMetrics);
+
+   // boosters with 0 or 1 classes or no validation samples do not calculate metrics, so the caller gets zeros
+   if(pBoosterCore->GetCountMetrics() != cMetrics && size_t { 0 } != pBoosterCore->GetCountMetrics()) {
+      LOG_0(Trace_Error, "ERROR GetValidationMetrics countMetrics does not match the number of metrics in CreateBooster");
+      return Error_IllegalParamVal;
+   }
+   if(size_t { 0 } == cMetrics) {
+      return Error_None;
+   }
+   if(nullptr == metricsOut) {
+      LOG_0(Trace_Error, "ERROR GetValidationMetrics metricsOut cannot be nullptr");
+      return Error_IllegalParamVal;
+   }
+
+   const double * const aValidationMetrics = pBoosterCore->GetValidationMetrics();
+   for(size_t iMetric = 0; iMetric < cMetrics; ++iMetric) {
+      metricsOut[iMetric] = nullptr == aValidationMetrics ? 0.0 : aValidationMetrics[iMetric];
+   }
+   return Error_None;
+}
+
 // we made this a global because if we had put this variable inside the BoosterCore object, then we would need to dereference that before 
 // getting the count.  By making this global we can send a log message incase a bad BoosterCore object is sent into us
 // we only decrease the count if the count is non-zero, so at worst if there is a race condition then we'll output this log message more 
@@ -445,8 +824,8 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION GetTermUpdate(
       return error;
    }
 
-   FloatFast * const aUpdateScores = pBoosterShell->GetTermUpdate()->GetTensorScoresPointer();
-   Transpose<true>(pTerm, GetCountScores(pBoosterCore->GetCountClasses()), updateScoresTensorOut, aUpdateScores);
+   FloatScore * const aUpdateScores = pBoosterShell->GetTermUpdate()->GetTensorScoresPointer();
+   Transpose<true>(pTerm, pBoosterCore->GetCountScores(), updateScoresTensorOut, aUpdateScores);
 
    return Error_None;
 }
@@ -537,10 +916,10 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION SetTermUpdate(
       return error;
    }
 
-   FloatFast * const aUpdateScores = pBoosterShell->GetTermUpdate()->GetTensorScoresPointer();
+   FloatScore * const aUpdateScores = pBoosterShell->GetTermUpdate()->GetTensorScoresPointer();
    // *updateScoresTensor is const, but Transpose can go either way.  When bCopyToIncrement is false like it
    // is below, then Transpose will treat updateScoresTensor as const
-   Transpose<false>(pTerm, GetCountScores(pBoosterCore->GetCountClasses()), const_cast<double *>(updateScoresTensor), aUpdateScores);
+   Transpose<false>(pTerm, pBoosterCore->GetCountScores(), const_cast<double *>(updateScoresTensor), aUpdateScores);
 
    pBoosterShell->SetTermIndex(iTerm);
 
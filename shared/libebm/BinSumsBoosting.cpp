@@ -5,6 +5,7 @@
 #include "precompiled_header_cpp.hpp"
 
 #include <stddef.h> // size_t, ptrdiff_t
+#include <string.h> // memcpy
 
 #include "logging.h" // EBM_ASSERT
 #include "zones.h"
@@ -17,14 +18,16 @@
 #include "Bin.hpp"
 #include "BoosterCore.hpp"
 #include "BoosterShell.hpp"
+#include "ThreadPool.hpp"
 
 namespace DEFINED_ZONE_NAME {
 #ifndef DEFINED_ZONE_NAME
 #error DEFINED_ZONE_NAME must be defined
 #endif // DEFINED_ZONE_NAME
 
-template<bool bHessian, size_t cCompilerScores, ptrdiff_t compilerBitPack, bool bWeight, bool bReplication>
+template<bool bHessian, size_t cCompilerScores, ptrdiff_t compilerBitPack, bool bWeight, bool bReplication, bool bSampleBits>
 INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsBoostingInternal(BinSumsBoostingBridge * const pParams) {
+   static_assert(!bReplication || !bSampleBits, "an inner bag either counts occurrences or has sample bits");
    static constexpr bool bCompilerZeroDimensional = k_cItemsPerBitPackNone == compilerBitPack;
    static constexpr size_t cArrayScores = GetArrayScores(cCompilerScores);
 
@@ -45,6 +48,9 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsBoostingInternal(BinSumsBoosting
    ptrdiff_t cShiftReset;
    size_t maskBits;
    const StorageDataType * pInputData;
+   size_t cLanes;
+   size_t cLanesCur;
+   const StorageDataType * pDregsEnd;
 
    Bin<FloatFast, bHessian, cArrayScores> * pBin;
 
@@ -65,14 +71,28 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsBoostingInternal(BinSumsBoosting
       EBM_ASSERT(1 <= cBitsPerItemMax);
       EBM_ASSERT(cBitsPerItemMax <= k_cBitsForStorageType);
 
-      cShift = static_cast<ptrdiff_t>((cSamples - 1) % cItemsPerBitPack * cBitsPerItemMax);
+      cLanes = pParams->m_cBitPackLanes;
+      EBM_ASSERT(1 <= cLanes);
+
+      // the dregs are read one bit pack at a time, and after them we read the blocks of cLanes interleaved bit packs
+      const size_t cDregs = GetCountBitPackDregs(cSamples, cItemsPerBitPack, cLanes);
       cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - 1) * cBitsPerItemMax);
+      cShift = cShiftReset;
+      cLanesCur = cLanes;
+      if(size_t { 0 } != cDregs) {
+         cShift = static_cast<ptrdiff_t>((cDregs - 1) % cItemsPerBitPack * cBitsPerItemMax);
+         cLanesCur = 1;
+      }
 
       maskBits = static_cast<size_t>(MakeLowMask<StorageDataType>(cBitsPerItemMax));
 
       pInputData = pParams->m_aPacked;
+      pDregsEnd = pInputData + GetCountBitPacksDregs(cDregs, cItemsPerBitPack);
    }
 
+   const size_t cInnerBagsStride = pParams->m_cInnerBagsStride;
+   EBM_ASSERT(1 <= cInnerBagsStride);
+
    const size_t * pCountOccurrences;
    if(bReplication) {
       pCountOccurrences = pParams->m_pCountOccurrences;
@@ -82,6 +102,13 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsBoostingInternal(BinSumsBoosting
    if(bWeight) {
       pWeight = pParams->m_aWeights;
    }
+
+   const uint64_t * aSampleBits;
+   size_t iSampleBit;
+   if(bSampleBits) {
+      aSampleBits = pParams->m_aSampleBits;
+      iSampleBit = pParams->m_iSampleBitFirst;
+   }
 #ifndef NDEBUG
    FloatFast weightTotalDebug = 0;
 #endif // NDEBUG
@@ -95,71 +122,86 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsBoostingInternal(BinSumsBoosting
       // stored in memory if shouldn't increase the time spent fetching it by 2 times, unless our bottleneck when threading is overwhelmingly memory pressure
       // related, and even then we could store the count for a single bit aleviating the memory pressure greatly, if we use the right sampling method 
 
-      // TODO : try using a sampling method with non-repeating samples, and put the count into a bit.  Then unwind that loop either at the byte level 
-      //   (8 times) or the uint64_t level.  This can be done without branching and doesn't require random number generators
+      // subsampled inner bags put the count into a bit, which we apply below by addition and multiplication
+      // instead of branching on it
 
-      // we store the already multiplied dimensional value in *pInputData
-      StorageDataType iTensorBinCombined;
-      if(!bCompilerZeroDimensional) {
-         // we store the already multiplied dimensional value in *pInputData
-         iTensorBinCombined = *pInputData;
-         ++pInputData;
-      }
       while(true) {
-         if(!bCompilerZeroDimensional) {
-            const size_t iTensorBin = static_cast<size_t>(iTensorBinCombined >> cShift) & maskBits;
-            pBin = IndexBin(aBins, cBytesPerBin * iTensorBin);
-            ASSERT_BIN_OK(cBytesPerBin, pBin, pParams->m_pDebugFastBinsEnd);
-         }
+         size_t iLane = 0;
+         do {
+            if(!bCompilerZeroDimensional) {
+               // we store the already multiplied dimensional value in *pInputData
+               const size_t iTensorBin = static_cast<size_t>(pInputData[iLane] >> cShift) & maskBits;
+               pBin = IndexBin(aBins, cBytesPerBin * iTensorBin);
+               ASSERT_BIN_OK(cBytesPerBin, pBin, pParams->m_pDebugFastBinsEnd);
+            }
 
-         if(bReplication) {
-            const size_t cOccurences = *pCountOccurrences;
-            pBin->SetCountSamples(pBin->GetCountSamples() + cOccurences);
-            ++pCountOccurrences;
-         } else {
-            pBin->SetCountSamples(pBin->GetCountSamples() + size_t { 1 });
-         }
+            size_t bInBag;
+            if(bSampleBits) {
+               bInBag = GetSampleBit(aSampleBits, iSampleBit);
+               ++iSampleBit;
+            }
 
-         FloatFast weight;
-         if(bWeight) {
-            weight = *pWeight;
-            pBin->SetWeight(pBin->GetWeight() + weight);
-            ++pWeight;
+            if(bReplication) {
+               const size_t cOccurences = *pCountOccurrences;
+               pBin->SetCountSamples(pBin->GetCountSamples() + cOccurences);
+               pCountOccurrences += cInnerBagsStride;
+            } else if(bSampleBits) {
+               pBin->SetCountSamples(pBin->GetCountSamples() + bInBag);
+            } else {
+               pBin->SetCountSamples(pBin->GetCountSamples() + size_t { 1 });
+            }
+
+            FloatFast weight;
+            if(bWeight || bSampleBits) {
+               if(bSampleBits) {
+                  weight = static_cast<FloatFast>(bInBag);
+                  if(bWeight) {
+                     weight *= *pWeight;
+                     pWeight += cInnerBagsStride;
+                  }
+               } else {
+                  weight = *pWeight;
+                  pWeight += cInnerBagsStride;
+               }
+               pBin->SetWeight(pBin->GetWeight() + weight);
 #ifndef NDEBUG
-            weightTotalDebug += weight;
+               weightTotalDebug += weight;
 #endif // NDEBUG
-         } else {
-            // TODO: In the future we'd like to eliminate this but we need the ability to change the Bin class
-            //       such that we can remove that field optionally
-            pBin->SetWeight(pBin->GetWeight() + FloatFast { 1 });
-         }
+            } else {
+               // TODO: In the future we'd like to eliminate this but we need the ability to change the Bin class
+               //       such that we can remove that field optionally
+               pBin->SetWeight(pBin->GetWeight() + FloatFast { 1 });
+            }
 
 #ifndef NDEBUG
-         FloatFast gradientTotalDebug = 0;
+            FloatFast gradientTotalDebug = 0;
 #endif // NDEBUG
 
-         auto * const aGradientPair = pBin->GetGradientPairs();
-         size_t iScore = 0;
-         do {
-            auto * const pGradientPair = &aGradientPair[iScore];
-            FloatFast gradient = bHessian ? pGradientAndHessian[iScore << 1] : pGradientAndHessian[iScore];
+            auto * const aGradientPair = pBin->GetGradientPairs();
+            size_t iScore = 0;
+            do {
+               auto * const pGradientPair = &aGradientPair[iScore];
+               FloatFast gradient = bHessian ? pGradientAndHessian[iScore << 1] : pGradientAndHessian[iScore];
 #ifndef NDEBUG
-            gradientTotalDebug += gradient;
+               gradientTotalDebug += gradient;
 #endif // NDEBUG
-            if(bWeight) {
-               gradient *= weight;
-            }
-            pGradientPair->m_sumGradients += gradient;
-            if(bHessian) {
-               FloatFast hessian = pGradientAndHessian[(iScore << 1) + 1];
-               if(bWeight) {
-                  hessian *= weight;
+               if(bWeight || bSampleBits) {
+                  gradient *= weight;
                }
-               pGradientPair->SetHess(pGradientPair->GetHess() + hessian);
-            }
-            ++iScore;
-         } while(cScores != iScore);
-         pGradientAndHessian += bHessian ? cScores << 1 : cScores;
+               pGradientPair->m_sumGradients += gradient;
+               if(bHessian) {
+                  FloatFast hessian = pGradientAndHessian[(iScore << 1) + 1];
+                  if(bWeight || bSampleBits) {
+                     hessian *= weight;
+                  }
+                  pGradientPair->SetHess(pGradientPair->GetHess() + hessian);
+               }
+               ++iScore;
+            } while(cScores != iScore);
+            pGradientAndHessian += bHessian ? cScores << 1 : cScores;
+
+            ++iLane;
+         } while(!bCompilerZeroDimensional && cLanesCur != iLane);
 
          if(bCompilerZeroDimensional) {
             if(pGradientsAndHessiansEnd == pGradientAndHessian) {
@@ -175,14 +217,19 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsBoostingInternal(BinSumsBoosting
       if(bCompilerZeroDimensional) {
          break;
       }
+      pInputData += cLanesCur;
+      if(pDregsEnd == pInputData) {
+         cLanesCur = cLanes;
+      }
       cShift = cShiftReset;
    } while(pGradientsAndHessiansEnd != pGradientAndHessian);
 
-   EBM_ASSERT(!bWeight || 0 < pParams->m_totalWeightDebug);
-   EBM_ASSERT(!bWeight || 0 < weightTotalDebug);
-   EBM_ASSERT(!bWeight || (weightTotalDebug * FloatFast { 0.999 } <= pParams->m_totalWeightDebug &&
+   // a shard of a subsampled inner bag can legitimately have no selected samples
+   EBM_ASSERT(!bWeight || bSampleBits || 0 < pParams->m_totalWeightDebug);
+   EBM_ASSERT(!bWeight || bSampleBits || 0 < weightTotalDebug);
+   EBM_ASSERT(!(bWeight || bSampleBits) || (weightTotalDebug * FloatFast { 0.999 } <= pParams->m_totalWeightDebug &&
       pParams->m_totalWeightDebug <= FloatFast { 1.001 } * weightTotalDebug));
-   EBM_ASSERT(bWeight || static_cast<FloatFast>(cSamples) == pParams->m_totalWeightDebug);
+   EBM_ASSERT(bWeight || bSampleBits || static_cast<FloatFast>(cSamples) == pParams->m_totalWeightDebug);
 
    return Error_None;
 }
@@ -190,15 +237,31 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsBoostingInternal(BinSumsBoosting
 
 template<bool bHessian, size_t cCompilerScores, ptrdiff_t compilerBitPack>
 INLINE_RELEASE_TEMPLATED static ErrorEbm FinalOptions(BinSumsBoostingBridge * const pParams) {
+   if(nullptr != pParams->m_aSampleBits) {
+      // subsampled inner bags have no occurrence counts, and their weights are the unmasked training weights
+      EBM_ASSERT(nullptr == pParams->m_pCountOccurrences);
+      static constexpr bool bReplication = false;
+      static constexpr bool bSampleBits = true;
+
+      if(nullptr != pParams->m_aWeights) {
+         static constexpr bool bWeight = true;
+         return BinSumsBoostingInternal<bHessian, cCompilerScores, compilerBitPack, bWeight, bReplication, bSampleBits>(pParams);
+      } else {
+         static constexpr bool bWeight = false;
+         return BinSumsBoostingInternal<bHessian, cCompilerScores, compilerBitPack, bWeight, bReplication, bSampleBits>(pParams);
+      }
+   }
+
+   static constexpr bool bSampleBits = false;
    if(nullptr != pParams->m_aWeights) {
       static constexpr bool bWeight = true;
 
       if(nullptr != pParams->m_pCountOccurrences) {
          static constexpr bool bReplication = true;
-         return BinSumsBoostingInternal<bHessian, cCompilerScores, compilerBitPack, bWeight, bReplication>(pParams);
+         return BinSumsBoostingInternal<bHessian, cCompilerScores, compilerBitPack, bWeight, bReplication, bSampleBits>(pParams);
       } else {
          static constexpr bool bReplication = false;
-         return BinSumsBoostingInternal<bHessian, cCompilerScores, compilerBitPack, bWeight, bReplication>(pParams);
+         return BinSumsBoostingInternal<bHessian, cCompilerScores, compilerBitPack, bWeight, bReplication, bSampleBits>(pParams);
       }
    } else {
       static constexpr bool bWeight = false;
@@ -207,7 +270,7 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm FinalOptions(BinSumsBoostingBridge * co
       EBM_ASSERT(nullptr == pParams->m_pCountOccurrences);
       static constexpr bool bReplication = false;
 
-      return BinSumsBoostingInternal<bHessian, cCompilerScores, compilerBitPack, bWeight, bReplication>(pParams);
+      return BinSumsBoostingInternal<bHessian, cCompilerScores, compilerBitPack, bWeight, bReplication, bSampleBits>(pParams);
    }
 }
 
@@ -268,4 +331,438 @@ extern ErrorEbm BinSumsBoosting(BinSumsBoostingBridge * const pParams) {
    return error;
 }
 
+template<bool bHessian, size_t cCompilerScores>
+INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsBoostingInnerBagsInternal(
+   BinSumsBoostingBridge * const pParams,
+   const size_t cInnerBags,
+   const size_t cBytesPerInnerBag
+) {
+   static constexpr size_t cArrayScores = GetArrayScores(cCompilerScores);
+
+   const size_t cScores = GET_COUNT_SCORES(cCompilerScores, pParams->m_cScores);
+
+   auto * const aBins = pParams->m_aFastBins->Specialize<FloatFast, bHessian, cArrayScores>();
+   EBM_ASSERT(nullptr != aBins);
+
+   const size_t cSamples = pParams->m_cSamples;
+   EBM_ASSERT(1 <= cSamples);
+
+   const FloatFast * pGradientAndHessian = pParams->m_aGradientsAndHessians;
+   const FloatFast * const pGradientsAndHessiansEnd = pGradientAndHessian + (bHessian ? 2 : 1) * cScores * cSamples;
+
+   EBM_ASSERT(!IsOverflowBinSize<FloatFast>(bHessian, cScores)); // we're accessing allocated memory
+   const size_t cBytesPerBin = GetBinSize<FloatFast>(bHessian, cScores);
+
+   EBM_ASSERT(k_cItemsPerBitPackNone != pParams->m_cPack);
+   const size_t cItemsPerBitPack = static_cast<size_t>(pParams->m_cPack);
+   EBM_ASSERT(1 <= cItemsPerBitPack);
+   EBM_ASSERT(cItemsPerBitPack <= k_cBitsForStorageType);
+
+   const size_t cBitsPerItemMax = GetCountBits<StorageDataType>(cItemsPerBitPack);
+   EBM_ASSERT(1 <= cBitsPerItemMax);
+   EBM_ASSERT(cBitsPerItemMax <= k_cBitsForStorageType);
+
+   const size_t cLanes = pParams->m_cBitPackLanes;
+   EBM_ASSERT(1 <= cLanes);
+
+   // same traversal as BinSumsBoostingInternal, so each inner bag's histogram is summed in the same order
+   const size_t cDregs = GetCountBitPackDregs(cSamples, cItemsPerBitPack, cLanes);
+   const ptrdiff_t cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - 1) * cBitsPerItemMax);
+   ptrdiff_t cShift = cShiftReset;
+   size_t cLanesCur = cLanes;
+   if(size_t { 0 } != cDregs) {
+      cShift = static_cast<ptrdiff_t>((cDregs - 1) % cItemsPerBitPack * cBitsPerItemMax);
+      cLanesCur = 1;
+   }
+
+   const size_t maskBits = static_cast<size_t>(MakeLowMask<StorageDataType>(cBitsPerItemMax));
+
+   const StorageDataType * pInputData = pParams->m_aPacked;
+   const StorageDataType * const pDregsEnd = pInputData + GetCountBitPacksDregs(cDregs, cItemsPerBitPack);
+
+   // both are sample major, and point to the first of our inner bags
+   const size_t cInnerBagsStride = pParams->m_cInnerBagsStride;
+   const size_t * pCountOccurrences = pParams->m_pCountOccurrences;
+   const FloatFast * pWeight = pParams->m_aWeights;
+   EBM_ASSERT(nullptr != pCountOccurrences);
+   EBM_ASSERT(nullptr != pWeight);
+
+   do {
+      while(true) {
+         size_t iLane = 0;
+         do {
+            // we store the already multiplied dimensional value in *pInputData
+            const size_t iTensorBin = static_cast<size_t>(pInputData[iLane] >> cShift) & maskBits;
+            auto * pBin = IndexBin(aBins, cBytesPerBin * iTensorBin);
+
+            // each gradient is loaded once and then scattered into the histogram of every inner bag
+            size_t iInnerBag = 0;
+            do {
+               ASSERT_BIN_OK(cBytesPerBin, pBin, IndexBin(pParams->m_pDebugFastBinsEnd, cBytesPerInnerBag * iInnerBag));
+
+               pBin->SetCountSamples(pBin->GetCountSamples() + pCountOccurrences[iInnerBag]);
+               const FloatFast weight = pWeight[iInnerBag];
+               pBin->SetWeight(pBin->GetWeight() + weight);
+
+               auto * const aGradientPair = pBin->GetGradientPairs();
+               size_t iScore = 0;
+               do {
+                  auto * const pGradientPair = &aGradientPair[iScore];
+                  FloatFast gradient = bHessian ? pGradientAndHessian[iScore << 1] : pGradientAndHessian[iScore];
+                  gradient *= weight;
+                  pGradientPair->m_sumGradients += gradient;
+                  if(bHessian) {
+                     FloatFast hessian = pGradientAndHessian[(iScore << 1) + 1];
+                     hessian *= weight;
+                     pGradientPair->SetHess(pGradientPair->GetHess() + hessian);
+                  }
+                  ++iScore;
+               } while(cScores != iScore);
+
+               pBin = IndexBin(pBin, cBytesPerInnerBag);
+               ++iInnerBag;
+            } while(cInnerBags != iInnerBag);
+
+            pCountOccurrences += cInnerBagsStride;
+            pWeight += cInnerBagsStride;
+            pGradientAndHessian += bHessian ? cScores << 1 : cScores;
+
+            ++iLane;
+         } while(cLanesCur != iLane);
+
+         cShift -= cBitsPerItemMax;
+         if(cShift < 0) {
+            break;
+         }
+      }
+      pInputData += cLanesCur;
+      if(pDregsEnd == pInputData) {
+         cLanesCur = cLanes;
+      }
+      cShift = cShiftReset;
+   } while(pGradientsAndHessiansEnd != pGradientAndHessian);
+
+   return Error_None;
+}
+
+extern ErrorEbm BinSumsBoostingInnerBags(
+   BinSumsBoostingBridge * const pParams,
+   const size_t cInnerBags,
+   const size_t cBytesPerInnerBag
+) {
+   // pParams->m_aFastBins holds cInnerBags histograms spaced cBytesPerInnerBag apart, and the sample major
+   // m_pCountOccurrences and m_aWeights hold m_cInnerBagsStride values per sample
+   LOG_0(Trace_Verbose, "Entered BinSumsBoostingInnerBags");
+
+   EBM_ASSERT(1 <= pParams->m_cScores);
+   EBM_ASSERT(1 <= cInnerBags);
+   EBM_ASSERT(cInnerBags <= pParams->m_cInnerBagsStride);
+
+   ErrorEbm error;
+   if(EBM_FALSE != pParams->m_bHessian) {
+      if(size_t { 1 } != pParams->m_cScores) {
+         error = BinSumsBoostingInnerBagsInternal<true, k_dynamicScores>(
+            pParams, cInnerBags, cBytesPerInnerBag);
+      } else {
+         error = BinSumsBoostingInnerBagsInternal<true, k_oneScore>(
+            pParams, cInnerBags, cBytesPerInnerBag);
+      }
+   } else {
+      if(size_t { 1 } != pParams->m_cScores) {
+         error = BinSumsBoostingInnerBagsInternal<false, k_dynamicScores>(
+            pParams, cInnerBags, cBytesPerInnerBag);
+      } else {
+         error = BinSumsBoostingInnerBagsInternal<false, k_oneScore>(
+            pParams, cInnerBags, cBytesPerInnerBag);
+      }
+   }
+
+   LOG_0(Trace_Verbose, "Exited BinSumsBoostingInnerBags");
+
+   return error;
+}
+
+// below this many samples per shard the cost of zeroing and reducing the extra histograms outweighs the gain
+static constexpr size_t k_cSamplesPerShardMin = size_t { 1 } << 14;
+
+extern size_t GetCountBinSumsBoostingShards(const size_t cShardsMax, const size_t cSamples) {
+   size_t cShards = cSamples / k_cSamplesPerShardMin;
+   cShards = cShardsMax < cShards ? cShardsMax : cShards;
+   return size_t { 0 } == cShards ? size_t { 1 } : cShards;
+}
+
+struct BinSumsBoostingShardContext final {
+   const BinSumsBoostingBridge * m_pParams;
+   BinBase * m_aShardFastBins;
+   size_t m_cBytesPerBin;
+   size_t m_cTensorBins;
+   size_t m_cShards;
+   size_t m_cItemsPerBitPack;
+   size_t m_cBitPackLanes;
+   ErrorEbm * m_aErrors;
+};
+
+template<bool bHessian>
+static void ReduceShardsTask(void * const pContextVoid, const size_t iTask) {
+   const BinSumsBoostingShardContext * const pContext = static_cast<const BinSumsBoostingShardContext *>(pContextVoid);
+
+   const size_t cScores = pContext->m_pParams->m_cScores;
+   const size_t cBytesPerBin = pContext->m_cBytesPerBin;
+   const size_t cTensorBins = pContext->m_cTensorBins;
+   const size_t cShards = pContext->m_cShards;
+
+   // each task owns a slice of the tensor bins and sums every shard into shard 0 in shard order
+   const size_t iBinStart = iTask * cTensorBins / cShards;
+   const size_t iBinEnd = (iTask + size_t { 1 }) * cTensorBins / cShards;
+   if(iBinStart == iBinEnd) {
+      return;
+   }
+
+   auto * const aBins = pContext->m_pParams->m_aFastBins->Specialize<FloatFast, bHessian>();
+   size_t iShard = 1;
+   do {
+      const BinBase * const aShardBinsBase = IndexBin(pContext->m_aShardFastBins, (iShard - size_t { 1 }) * cBytesPerBin * cTensorBins);
+      const auto * const aShardBins = aShardBinsBase->Specialize<FloatFast, bHessian>();
+      size_t iBin = iBinStart;
+      do {
+         IndexBin(aBins, cBytesPerBin * iBin)->Add(cScores, *IndexBin(aShardBins, cBytesPerBin * iBin));
+         ++iBin;
+      } while(iBinEnd != iBin);
+      ++iShard;
+   } while(cShards != iShard);
+}
+
+static void BinSumsShardTask(void * const pContextVoid, const size_t iTask) {
+   const BinSumsBoostingShardContext * const pContext = static_cast<const BinSumsBoostingShardContext *>(pContextVoid);
+   const BinSumsBoostingBridge * const pParams = pContext->m_pParams;
+
+   const size_t cSamples = pParams->m_cSamples;
+   const size_t cItemsPerBitPack = pContext->m_cItemsPerBitPack;
+   const size_t cLanes = pContext->m_cBitPackLanes;
+   const size_t cShards = pContext->m_cShards;
+
+   // The dregs are one unit and every block of interleaved bit packs is another, so splitting on unit
+   // boundaries keeps each shard in the exact layout that BinSumsBoostingInternal expects
+   const size_t cSamplesPerBlock = cItemsPerBitPack * cLanes;
+   const size_t cDregs = GetCountBitPackDregs(cSamples, cItemsPerBitPack, cLanes);
+   const size_t cDregsUnits = size_t { 0 } == cDregs ? size_t { 0 } : size_t { 1 };
+   const size_t cUnits = cDregsUnits + cSamples / cSamplesPerBlock;
+   const size_t iUnitStart = iTask * cUnits / cShards;
+   const size_t iUnitEnd = (iTask + size_t { 1 }) * cUnits / cShards;
+   EBM_ASSERT(iUnitStart < iUnitEnd);
+
+   const size_t iSampleStart = size_t { 0 } == iUnitStart ? size_t { 0 } :
+      cDregs + (iUnitStart - cDregsUnits) * cSamplesPerBlock;
+   const size_t iSampleEnd = cDregs + (iUnitEnd - cDregsUnits) * cSamplesPerBlock;
+   const size_t iWordStart = size_t { 0 } == iUnitStart ? size_t { 0 } :
+      GetCountBitPacksDregs(cDregs, cItemsPerBitPack) + (iUnitStart - cDregsUnits) * cLanes;
+
+   BinSumsBoostingBridge params = *pParams;
+   params.m_cSamples = iSampleEnd - iSampleStart;
+   params.m_aGradientsAndHessians += (EBM_FALSE != pParams->m_bHessian ? size_t { 2 } : size_t { 1 }) * pParams->m_cScores * iSampleStart;
+   if(nullptr != params.m_aWeights) {
+      params.m_aWeights += params.m_cInnerBagsStride * iSampleStart;
+   }
+   if(nullptr != params.m_pCountOccurrences) {
+      params.m_pCountOccurrences += params.m_cInnerBagsStride * iSampleStart;
+   }
+   params.m_iSampleBitFirst += iSampleStart;
+   if(k_cItemsPerBitPackNone != params.m_cPack) {
+      params.m_aPacked += iWordStart;
+   }
+
+   const size_t cBytesTensor = pContext->m_cBytesPerBin * pContext->m_cTensorBins;
+   if(size_t { 0 } != iTask) {
+      // shard 0 uses the caller's histogram which the caller has already zeroed
+      params.m_aFastBins = IndexBin(pContext->m_aShardFastBins, (iTask - size_t { 1 }) * cBytesTensor);
+      params.m_aFastBins->ZeroMem(pContext->m_cBytesPerBin, pContext->m_cTensorBins);
+   }
+
+#ifndef NDEBUG
+   params.m_pDebugFastBinsEnd = IndexBin(params.m_aFastBins, cBytesTensor);
+   if(nullptr == params.m_aWeights && nullptr == params.m_aSampleBits) {
+      params.m_totalWeightDebug = static_cast<FloatFast>(params.m_cSamples);
+   } else {
+      FloatFast weightTotalDebug = 0;
+      for(size_t iSample = 0; iSample < params.m_cSamples; ++iSample) {
+         FloatFast weight = nullptr == params.m_aWeights ? FloatFast { 1 } : 
+            params.m_aWeights[params.m_cInnerBagsStride * iSample];
+         if(nullptr != params.m_aSampleBits) {
+            weight *= static_cast<FloatFast>(GetSampleBit(params.m_aSampleBits, params.m_iSampleBitFirst + iSample));
+         }
+         weightTotalDebug += weight;
+      }
+      params.m_totalWeightDebug = weightTotalDebug;
+   }
+#endif // NDEBUG
+
+   pContext->m_aErrors[iTask] = BinSumsBoosting(&params);
+}
+
+extern ErrorEbm BinSumsBoostingSharded(
+   ThreadPool * const pThreadPool,
+   const size_t cShardsMax,
+   BinBase * const aShardFastBins,
+   const size_t cTensorBins,
+   BinSumsBoostingBridge * const pParams
+) {
+   EBM_ASSERT(nullptr != pThreadPool);
+   EBM_ASSERT(1 <= cShardsMax);
+   EBM_ASSERT(1 <= cTensorBins);
+   EBM_ASSERT(1 <= pParams->m_cSamples);
+
+   size_t cShards = GetCountBinSumsBoostingShards(cShardsMax, pParams->m_cSamples);
+   if(size_t { 1 } == cShards) {
+      return BinSumsBoosting(pParams);
+   }
+   EBM_ASSERT(nullptr != aShardFastBins);
+   EBM_ASSERT(cShards <= k_cThreadsMax);
+
+   LOG_0(Trace_Verbose, "Entered BinSumsBoostingSharded");
+
+   const bool bHessian = EBM_FALSE != pParams->m_bHessian;
+   EBM_ASSERT(!IsOverflowBinSize<FloatFast>(bHessian, pParams->m_cScores)); // we check in CreateBooster
+   const size_t cBytesPerBin = GetBinSize<FloatFast>(bHessian, pParams->m_cScores);
+
+   size_t cItemsPerBitPack = 1;
+   size_t cLanes = 1;
+   if(k_cItemsPerBitPackNone != pParams->m_cPack) {
+      cItemsPerBitPack = static_cast<size_t>(pParams->m_cPack);
+      cLanes = pParams->m_cBitPackLanes;
+   }
+   const size_t cDregs = GetCountBitPackDregs(pParams->m_cSamples, cItemsPerBitPack, cLanes);
+   const size_t cUnits = (size_t { 0 } == cDregs ? size_t { 0 } : size_t { 1 }) + 
+      pParams->m_cSamples / (cItemsPerBitPack * cLanes);
+   cShards = cUnits < cShards ? cUnits : cShards;
+
+   ErrorEbm aErrors[k_cThreadsMax];
+
+   BinSumsBoostingShardContext context;
+   context.m_pParams = pParams;
+   context.m_aShardFastBins = aShardFastBins;
+   context.m_cBytesPerBin = cBytesPerBin;
+   context.m_cTensorBins = cTensorBins;
+   context.m_cShards = cShards;
+   context.m_cItemsPerBitPack = cItemsPerBitPack;
+   context.m_cBitPackLanes = cLanes;
+   context.m_aErrors = aErrors;
+
+   pThreadPool->Run(cShards, BinSumsShardTask, &context);
+
+   size_t iShard = 0;
+   do {
+      if(Error_None != aErrors[iShard]) {
+         return aErrors[iShard];
+      }
+      ++iShard;
+   } while(cShards != iShard);
+
+   pThreadPool->Run(cShards, bHessian ? ReduceShardsTask<true> : ReduceShardsTask<false>, &context);
+
+   LOG_0(Trace_Verbose, "Exited BinSumsBoostingSharded");
+
+   return Error_None;
+}
+
+template<bool bHessian>
+static void MoveSparseNonDefaults(
+   const BinSumsBoostingBridge * const pParams,
+   const SparseInputDataBoosting * const pSparse,
+   const size_t cBytesPerBin
+) {
+   const size_t cScores = pParams->m_cScores;
+
+   auto * const aBins = pParams->m_aFastBins->Specialize<FloatFast, bHessian>();
+   auto * const pDefaultBin = IndexBin(aBins, cBytesPerBin * pSparse->m_iDefaultBin);
+   ASSERT_BIN_OK(cBytesPerBin, pDefaultBin, pParams->m_pDebugFastBinsEnd);
+   auto * const aDefaultGradientPairs = pDefaultBin->GetGradientPairs();
+
+   const FloatFast * const aGradientsAndHessians = pParams->m_aGradientsAndHessians;
+   const FloatFast * const aWeights = pParams->m_aWeights;
+   const size_t * const aCountOccurrences = pParams->m_pCountOccurrences;
+   const uint64_t * const aSampleBits = pParams->m_aSampleBits;
+
+   const SparseEntryBoosting * pNonDefault = ArrayToPointer(pSparse->m_nonDefaults);
+   const SparseEntryBoosting * const pNonDefaultsEnd = &pNonDefault[pSparse->m_cNonDefaults];
+   while(pNonDefaultsEnd != pNonDefault) {
+      const size_t iSample = pNonDefault->m_iSample;
+      EBM_ASSERT(iSample < pParams->m_cSamples);
+      EBM_ASSERT(pSparse->m_iDefaultBin != pNonDefault->m_iBin);
+
+      auto * const pBin = IndexBin(aBins, cBytesPerBin * pNonDefault->m_iBin);
+      ASSERT_BIN_OK(cBytesPerBin, pBin, pParams->m_pDebugFastBinsEnd);
+
+      const size_t iStrided = pParams->m_cInnerBagsStride * iSample;
+      size_t cOccurences = nullptr == aCountOccurrences ? size_t { 1 } : aCountOccurrences[iStrided];
+      FloatFast weight = nullptr == aWeights ? FloatFast { 1 } : aWeights[iStrided];
+      if(nullptr != aSampleBits) {
+         const size_t bInBag = GetSampleBit(aSampleBits, pParams->m_iSampleBitFirst + iSample);
+         cOccurences = bInBag;
+         weight *= static_cast<FloatFast>(bInBag);
+      }
+
+      pBin->SetCountSamples(pBin->GetCountSamples() + cOccurences);
+      EBM_ASSERT(cOccurences <= pDefaultBin->GetCountSamples());
+      pDefaultBin->SetCountSamples(pDefaultBin->GetCountSamples() - cOccurences);
+
+      pBin->SetWeight(pBin->GetWeight() + weight);
+      pDefaultBin->SetWeight(pDefaultBin->GetWeight() - weight);
+
+      auto * const aGradientPairs = pBin->GetGradientPairs();
+      const FloatFast * const pGradientAndHessian = 
+         &aGradientsAndHessians[(bHessian ? size_t { 2 } : size_t { 1 }) * cScores * iSample];
+      size_t iScore = 0;
+      do {
+         FloatFast gradient = bHessian ? pGradientAndHessian[iScore << 1] : pGradientAndHessian[iScore];
+         if(nullptr != aWeights || nullptr != aSampleBits) {
+            gradient *= weight;
+         }
+         aGradientPairs[iScore].m_sumGradients += gradient;
+         aDefaultGradientPairs[iScore].m_sumGradients -= gradient;
+         if(bHessian) {
+            FloatFast hessian = pGradientAndHessian[(iScore << 1) + 1];
+            if(nullptr != aWeights || nullptr != aSampleBits) {
+               hessian *= weight;
+            }
+            aGradientPairs[iScore].SetHess(aGradientPairs[iScore].GetHess() + hessian);
+            aDefaultGradientPairs[iScore].SetHess(aDefaultGradientPairs[iScore].GetHess() - hessian);
+         }
+         ++iScore;
+      } while(cScores != iScore);
+
+      ++pNonDefault;
+   }
+}
+
+extern void BinSumsBoostingSparse(
+   const BinBase * const pTotalBin,
+   const SparseInputDataBoosting * const pSparse,
+   BinSumsBoostingBridge * const pParams
+) {
+   EBM_ASSERT(nullptr != pTotalBin);
+   EBM_ASSERT(nullptr != pSparse);
+   EBM_ASSERT(1 <= pParams->m_cSamples);
+   EBM_ASSERT(pSparse->m_cNonDefaults <= pParams->m_cSamples);
+
+   LOG_0(Trace_Verbose, "Entered BinSumsBoostingSparse");
+
+   const bool bHessian = EBM_FALSE != pParams->m_bHessian;
+   EBM_ASSERT(!IsOverflowBinSize<FloatFast>(bHessian, pParams->m_cScores)); // we check in CreateBooster
+   const size_t cBytesPerBin = GetBinSize<FloatFast>(bHessian, pParams->m_cScores);
+
+   // Start the default bin from the inner bag's totals, then move the non-default samples out of it.  The
+   // default bin ends up holding the total minus the rest without visiting the default samples.
+   BinBase * const pDefaultBin = IndexBin(pParams->m_aFastBins, cBytesPerBin * pSparse->m_iDefaultBin);
+   ASSERT_BIN_OK(cBytesPerBin, pDefaultBin, pParams->m_pDebugFastBinsEnd);
+   memcpy(pDefaultBin, pTotalBin, cBytesPerBin);
+
+   if(bHessian) {
+      MoveSparseNonDefaults<true>(pParams, pSparse, cBytesPerBin);
+   } else {
+      MoveSparseNonDefaults<false>(pParams, pSparse, cBytesPerBin);
+   }
+
+   LOG_0(Trace_Verbose, "Exited BinSumsBoostingSparse");
+}
+
 } // DEFINED_ZONE_NAME
@@ -52,6 +52,65 @@ namespace DEFINED_ZONE_NAME {
 //  - allow the system to process all the data via CPU (which means it can be inside a single dataset) and compare this result to the result
 //    of using the SIMD code pipeline.  Maybe we can simulate all the same access 
 
+struct PackedFeatureReader {
+   // walks a feature's bit packs one sample at a time.  The dregs at the start are read one bit pack at a time and
+   // after them each block of m_cLanes interleaved bit packs is read one lane at a time for each shift
+   ptrdiff_t m_cShift;
+   size_t m_cBitsPerItemMax;
+   size_t m_maskBits;
+   const StorageDataType * m_pData;
+   size_t m_iLane;
+   size_t m_cLanesCur;
+   size_t m_cLanes;
+   const StorageDataType * m_pDregsEnd;
+   ptrdiff_t m_cShiftReset;
+
+   INLINE_ALWAYS void Initialize(
+      const StorageDataType * const pData,
+      const size_t cItemsPerBitPack,
+      const size_t cSamples,
+      const size_t cLanes
+   ) {
+      EBM_ASSERT(1 <= cItemsPerBitPack);
+      EBM_ASSERT(cItemsPerBitPack <= k_cBitsForStorageType);
+      EBM_ASSERT(1 <= cLanes);
+
+      const size_t cBitsPerItemMax = GetCountBits<StorageDataType>(cItemsPerBitPack);
+      EBM_ASSERT(1 <= cBitsPerItemMax);
+      EBM_ASSERT(cBitsPerItemMax <= k_cBitsForStorageType);
+
+      const size_t cDregs = GetCountBitPackDregs(cSamples, cItemsPerBitPack, cLanes);
+      const size_t cSamplesFirst = size_t { 0 } == cDregs ? cSamples : cDregs;
+
+      m_pData = pData;
+      m_pDregsEnd = pData + GetCountBitPacksDregs(cDregs, cItemsPerBitPack);
+      m_cLanes = cLanes;
+      m_cLanesCur = size_t { 0 } == cDregs ? cLanes : size_t { 1 };
+      // the first call to Next moves onto the first lane and the first shift
+      m_iLane = m_cLanesCur - size_t { 1 };
+      m_cBitsPerItemMax = cBitsPerItemMax;
+      m_cShift = static_cast<ptrdiff_t>(((cSamplesFirst - 1) % cItemsPerBitPack + 1) * cBitsPerItemMax);
+      m_cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - 1) * cBitsPerItemMax);
+      m_maskBits = static_cast<size_t>(MakeLowMask<StorageDataType>(cBitsPerItemMax));
+   }
+
+   INLINE_ALWAYS size_t Next() {
+      ++m_iLane;
+      if(m_cLanesCur == m_iLane) {
+         m_iLane = 0;
+         m_cShift -= m_cBitsPerItemMax;
+         if(m_cShift < ptrdiff_t { 0 }) {
+            m_pData += m_cLanesCur;
+            if(m_pDregsEnd == m_pData) {
+               m_cLanesCur = m_cLanes;
+            }
+            m_cShift = m_cShiftReset;
+         }
+      }
+      return static_cast<size_t>(m_pData[m_iLane] >> m_cShift) & m_maskBits;
+   }
+};
+
 template<bool bHessian, size_t cCompilerScores, size_t cCompilerDimensions, bool bWeight>
 INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsInteractionInternal(BinSumsInteractionBridge * const pParams) {
    static constexpr size_t cArrayScores = GetArrayScores(cCompilerScores);
@@ -68,13 +127,8 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsInteractionInternal(BinSumsInter
    const FloatFast * const pGradientsAndHessiansEnd = pGradientAndHessian + (bHessian ? 2 : 1) * cScores * cSamples;
 
    struct DimensionalData {
-      ptrdiff_t m_cShift;
-      size_t m_cBitsPerItemMax;
-      StorageDataType m_iTensorBinCombined;
-      size_t m_maskBits;
+      PackedFeatureReader m_reader;
       size_t m_cBins;
-      const StorageDataType * m_pData;
-      ptrdiff_t m_cShiftReset;
    };
 
    const size_t cRealDimensions = GET_COUNT_DIMENSIONS(cCompilerDimensions, pParams->m_cRuntimeRealDimensions);
@@ -88,24 +142,12 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsInteractionInternal(BinSumsInter
    do {
       DimensionalData * const pDimensionalData = &aDimensionalData[iDimensionInit];
 
-      const StorageDataType * const pData = pParams->m_aaPacked[iDimensionInit];
-      pDimensionalData->m_iTensorBinCombined = *pData;
-      pDimensionalData->m_pData = pData + 1;
-
-      const size_t cItemsPerBitPack = pParams->m_acItemsPerBitPack[iDimensionInit];
-      EBM_ASSERT(1 <= cItemsPerBitPack);
-      EBM_ASSERT(cItemsPerBitPack <= k_cBitsForStorageType);
-
-      const size_t cBitsPerItemMax = GetCountBits<StorageDataType>(cItemsPerBitPack);
-      EBM_ASSERT(1 <= cBitsPerItemMax);
-      EBM_ASSERT(cBitsPerItemMax <= k_cBitsForStorageType);
-      pDimensionalData->m_cBitsPerItemMax = cBitsPerItemMax;
-
-      pDimensionalData->m_cShift = static_cast<ptrdiff_t>(((cSamples - 1) % cItemsPerBitPack + 1) * cBitsPerItemMax);
-      pDimensionalData->m_cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - 1) * cBitsPerItemMax);
-
-      const size_t maskBits = static_cast<size_t>(MakeLowMask<StorageDataType>(cBitsPerItemMax));
-      pDimensionalData->m_maskBits = maskBits;
+      pDimensionalData->m_reader.Initialize(
+         pParams->m_aaPacked[iDimensionInit],
+         pParams->m_acItemsPerBitPack[iDimensionInit],
+         cSamples,
+         pParams->m_cBitPackLanes
+      );
 
       pDimensionalData->m_cBins = pParams->m_acBins[iDimensionInit];
 
@@ -126,7 +168,7 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsInteractionInternal(BinSumsInter
    FloatFast weightTotalDebug = 0;
 #endif // NDEBUG
 
-   while(true) {
+   do {
       size_t cTensorBytes = cBytesPerBin;
       // for SIMD we'll want scatter/gather semantics since each parallel unit must load from a different pointer: 
       // otherwise we'll need to execute the scatter/gather as separate instructions in a templated loop
@@ -144,20 +186,7 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsInteractionInternal(BinSumsInter
       {
          DimensionalData * const pDimensionalData = &aDimensionalDataShifted[-1];
 
-         pDimensionalData->m_cShift -= pDimensionalData->m_cBitsPerItemMax;
-         if(pDimensionalData->m_cShift < ptrdiff_t { 0 }) {
-            if(pGradientsAndHessiansEnd == pGradientAndHessian) {
-               // we only need to check this for the first dimension since all dimensions will reach
-               // this point simultaneously
-               goto done;
-            }
-            pDimensionalData->m_iTensorBinCombined = *pDimensionalData->m_pData;
-            pDimensionalData->m_pData = pDimensionalData->m_pData + 1;
-            pDimensionalData->m_cShift = pDimensionalData->m_cShiftReset;
-         }
-
-         const size_t iBin = static_cast<size_t>(
-            pDimensionalData->m_iTensorBinCombined >> pDimensionalData->m_cShift) & pDimensionalData->m_maskBits;
+         const size_t iBin = pDimensionalData->m_reader.Next();
 
          const size_t cBins = pDimensionalData->m_cBins;
          // earlier we return an interaction strength of 0.0 on any useless dimensions having 1 bin
@@ -173,15 +202,7 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsInteractionInternal(BinSumsInter
          do {
             DimensionalData * const pDimensionalData = &aDimensionalDataShifted[iDimension];
 
-            pDimensionalData->m_cShift -= pDimensionalData->m_cBitsPerItemMax;
-            if(pDimensionalData->m_cShift < ptrdiff_t { 0 }) {
-               pDimensionalData->m_iTensorBinCombined = *pDimensionalData->m_pData;
-               pDimensionalData->m_pData = pDimensionalData->m_pData + 1;
-               pDimensionalData->m_cShift = pDimensionalData->m_cShiftReset;
-            }
-
-            const size_t iBin = static_cast<size_t>(
-               pDimensionalData->m_iTensorBinCombined >> pDimensionalData->m_cShift) & pDimensionalData->m_maskBits;
+            const size_t iBin = pDimensionalData->m_reader.Next();
 
             const size_t cBins = pDimensionalData->m_cBins;
             // earlier we return an interaction strength of 0.0 on any useless dimensions having 1 bin
@@ -228,8 +249,7 @@ INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsInteractionInternal(BinSumsInter
          ++iScore;
       } while(cScores != iScore);
       pGradientAndHessian += bHessian ? cScores << 1 : cScores;
-   }
-done:;
+   } while(pGradientsAndHessiansEnd != pGradientAndHessian);
 
    EBM_ASSERT(!bWeight || 0 < pParams->m_totalWeightDebug);
    EBM_ASSERT(!bWeight || 0 < weightTotalDebug);
@@ -316,4 +336,126 @@ extern ErrorEbm BinSumsInteraction(BinSumsInteractionBridge * const pParams) {
    return error;
 }
 
+template<bool bHessian, size_t cCompilerScores, bool bWeight>
+INLINE_RELEASE_TEMPLATED static ErrorEbm BinSumsInteractionPairsInternal(BinSumsInteractionPairsBridge * const pParams) {
+   // Binning each pair separately reads the whole gradient array once per pair.  The pairs here all share
+   // their first feature, so we read the gradients, weights and shared feature once per sample and add the
+   // sample into every pair's tensor.
+
+   static constexpr size_t cArrayScores = GetArrayScores(cCompilerScores);
+
+   const size_t cScores = GET_COUNT_SCORES(cCompilerScores, pParams->m_cScores);
+
+   const size_t cSamples = pParams->m_cSamples;
+   EBM_ASSERT(1 <= cSamples);
+
+   const size_t cPairs = pParams->m_cPairs;
+   EBM_ASSERT(1 <= cPairs);
+   EBM_ASSERT(cPairs <= k_cPairsPerBinSumsPassMax);
+
+   EBM_ASSERT(!IsOverflowBinSize<FloatFast>(bHessian, cScores)); // we're accessing allocated memory
+   const size_t cBytesPerBin = GetBinSize<FloatFast>(bHessian, cScores);
+
+   // the shared feature is the first dimension, so every pair's tensor has the same row length
+   const size_t cSharedBins = pParams->m_acBins[0];
+   EBM_ASSERT(size_t { 2 } <= cSharedBins);
+   const size_t cBytesPerRow = cBytesPerBin * cSharedBins;
+
+   PackedFeatureReader aReaders[1 + k_cPairsPerBinSumsPassMax];
+   size_t iReader = 0;
+   do {
+      aReaders[iReader].Initialize(
+         pParams->m_aaPacked[iReader],
+         pParams->m_acItemsPerBitPack[iReader],
+         cSamples,
+         pParams->m_cBitPackLanes
+      );
+      ++iReader;
+   } while(size_t { 1 } + cPairs != iReader);
+
+   const FloatFast * pGradientAndHessian = pParams->m_aGradientsAndHessians;
+   const FloatFast * pWeight = pParams->m_aWeights;
+
+   size_t iSample = 0;
+   do {
+      const size_t iSharedBin = aReaders[0].Next();
+      EBM_ASSERT(iSharedBin < cSharedBins);
+      const size_t cSharedBytes = iSharedBin * cBytesPerBin;
+
+      FloatFast weight = FloatFast { 1 };
+      if(bWeight) {
+         weight = *pWeight;
+         ++pWeight;
+      }
+
+      size_t iPair = 0;
+      do {
+         const size_t iOtherBin = aReaders[1 + iPair].Next();
+         EBM_ASSERT(iOtherBin < pParams->m_acBins[1 + iPair]);
+
+         unsigned char * const pRawBin = reinterpret_cast<unsigned char *>(pParams->m_aaFastBins[iPair]) +
+            cSharedBytes + iOtherBin * cBytesPerRow;
+         auto * const pBin = reinterpret_cast<Bin<FloatFast, bHessian, cArrayScores> *>(pRawBin);
+         ASSERT_BIN_OK(cBytesPerBin, pBin, pParams->m_apDebugFastBinsEnd[iPair]);
+
+         pBin->SetCountSamples(pBin->GetCountSamples() + size_t { 1 });
+         pBin->SetWeight(pBin->GetWeight() + weight);
+
+         auto * const aGradientPair = pBin->GetGradientPairs();
+         size_t iScore = 0;
+         do {
+            auto * const pGradientPair = &aGradientPair[iScore];
+            // DO NOT MULTIPLY gradient BY WEIGHT. WE PRE-MULTIPLIED WHEN WE ALLOCATED pGradientAndHessian
+            pGradientPair->m_sumGradients += bHessian ? pGradientAndHessian[iScore << 1] : pGradientAndHessian[iScore];
+            if(bHessian) {
+               pGradientPair->SetHess(pGradientPair->GetHess() + pGradientAndHessian[(iScore << 1) + 1]);
+            }
+            ++iScore;
+         } while(cScores != iScore);
+
+         ++iPair;
+      } while(cPairs != iPair);
+
+      pGradientAndHessian += bHessian ? cScores << 1 : cScores;
+      ++iSample;
+   } while(cSamples != iSample);
+
+   return Error_None;
+}
+
+template<bool bHessian, size_t cCompilerScores>
+INLINE_RELEASE_TEMPLATED static ErrorEbm PairsWeightOptions(BinSumsInteractionPairsBridge * const pParams) {
+   if(nullptr != pParams->m_aWeights) {
+      return BinSumsInteractionPairsInternal<bHessian, cCompilerScores, true>(pParams);
+   } else {
+      return BinSumsInteractionPairsInternal<bHessian, cCompilerScores, false>(pParams);
+   }
+}
+
+extern ErrorEbm BinSumsInteractionPairs(BinSumsInteractionPairsBridge * const pParams) {
+   LOG_0(Trace_Verbose, "Entered BinSumsInteractionPairs");
+
+   ErrorEbm error;
+
+   // batched pair screening is bound by memory bandwidth, so we only specialize on the common single score case
+   EBM_ASSERT(1 <= pParams->m_cScores);
+   if(EBM_FALSE != pParams->m_bHessian) {
+      if(size_t { 1 } != pParams->m_cScores) {
+         error = PairsWeightOptions<true, k_dynamicScores>(pParams);
+      } else {
+         error = PairsWeightOptions<true, k_oneScore>(pParams);
+      }
+   } else {
+      if(size_t { 1 } != pParams->m_cScores) {
+         error = PairsWeightOptions<false, k_dynamicScores>(pParams);
+      } else {
+         error = PairsWeightOptions<false, k_oneScore>(pParams);
+      }
+   }
+
+   LOG_0(Trace_Verbose, "Exited BinSumsInteractionPairs");
+
+   return error;
+}
+
 } // DEFINED_ZONE_NAME
@@ -0,0 +1,382 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "precompiled_header_cpp.hpp"
+
+#include <stdlib.h> // malloc, free
+#include <stddef.h> // size_t, ptrdiff_t
+#include <limits> // numeric_limits
+#include <cmath> // std::isnan
+
+#include "libebm.h" // EBM_API_BODY
+#include "logging.h" // EBM_ASSERT
+#include "zones.h"
+
+#include "ebm_internal.hpp"
+
+#include "ThreadPool.hpp"
+#include "RandomDeterministic.hpp" // RandomDeterministic
+#include "BoosterCore.hpp"
+#include "BoosterShell.hpp"
+
+namespace DEFINED_ZONE_NAME {
+#ifndef DEFINED_ZONE_NAME
+#error DEFINED_ZONE_NAME must be defined
+#endif // DEFINED_ZONE_NAME
+
+// The greedy rounds always pop the term with the highest gain and then push that term back with its new gain, so
+// after the first cyclic round every term is in the queue exactly once.  That lets us keep one gain per term and
+// scan for the best instead of maintaining a heap.  Ties go to the lower term index, which is the same ordering
+// a min-heap on (-gain, iTerm) would give.
+static size_t PickGreedyTerm(const size_t cTerms, const double * const aGains) {
+   EBM_ASSERT(1 <= cTerms);
+   size_t iBest = 0;
+   double gainBest = aGains[0];
+   for(size_t iTerm = 1; iTerm < cTerms; ++iTerm) {
+      const double gain = aGains[iTerm];
+      if(gainBest < gain) {
+         gainBest = gain;
+         iBest = iTerm;
+      }
+   }
+   return iBest;
+}
+
+EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION BoostRounds(
+   void * rng,
+   BoosterHandle boosterHandle,
+   BoostFlags flags,
+   double learningRate,
+   IntEbm minSamplesLeaf,
+   const IntEbm * leavesMax,
+   double greediness,
+   IntEbm smoothingRounds,
+   IntEbm maxRounds,
+   IntEbm earlyStoppingRounds,
+   double earlyStoppingTolerance,
+   IntEbm * countRoundsOut,
+   double * bestMetricOut
+) {
+   LOG_N(
+      Trace_Info,
+      "Entered BoostRounds: "
+      "rng=%p, "
+      "boosterHandle=%p, "
+      "flags=0x%" UBoostFlagsPrintf ", "
+      "learningRate=%le, "
+      "minSamplesLeaf=%" IntEbmPrintf ", "
+      "leavesMax=%p, "
+      "greediness=%le, "
+      "smoothingRounds=%" IntEbmPrintf ", "
+      "maxRounds=%" IntEbmPrintf ", "
+      "earlyStoppingRounds=%" IntEbmPrintf ", "
+      "earlyStoppingTolerance=%le, "
+      "countRoundsOut=%p, "
+      "bestMetricOut=%p"
+      ,
+      rng,
+      static_cast<void *>(boosterHandle),
+      static_cast<UBoostFlags>(flags), // signed to unsigned conversion is defined behavior in C++
+      learningRate,
+      minSamplesLeaf,
+      static_cast<const void *>(leavesMax),
+      greediness,
+      smoothingRounds,
+      maxRounds,
+      earlyStoppingRounds,
+      earlyStoppingTolerance,
+      static_cast<void *>(countRoundsOut),
+      static_cast<void *>(bestMetricOut)
+   );
+
+   ErrorEbm error;
+
+   if(nullptr != countRoundsOut) {
+      *countRoundsOut = IntEbm { 0 };
+   }
+   if(nullptr != bestMetricOut) {
+      *bestMetricOut = std::numeric_limits<double>::infinity();
+   }
+
+   BoosterShell * const pBoosterShell = BoosterShell::GetBoosterShellFromHandle(boosterHandle);
+   if(nullptr == pBoosterShell) {
+      // already logged
+      return Error_IllegalParamVal;
+   }
+
+   if(std::isnan(greediness) || greediness < 0.0) {
+      LOG_0(Trace_Error, "ERROR BoostRounds greediness must be a non-negative number");
+      return Error_IllegalParamVal;
+   }
+
+   if(maxRounds < IntEbm { 0 }) {
+      LOG_0(Trace_Warning, "WARNING BoostRounds maxRounds is negative.  Doing zero rounds.");
+      maxRounds = IntEbm { 0 };
+   }
+
+   const size_t cTerms = pBoosterShell->GetBoosterCore()->GetCountTerms();
+
+   double * aGains = nullptr;
+   if(size_t { 0 } != cTerms) {
+      if(IsMultiplyError(sizeof(*aGains), cTerms)) {
+         LOG_0(Trace_Warning, "WARNING BoostRounds IsMultiplyError(sizeof(*aGains), cTerms)");
+         return Error_OutOfMemory;
+      }
+      aGains = static_cast<double *>(malloc(sizeof(*aGains) * cTerms));
+      if(nullptr == aGains) {
+         LOG_0(Trace_Warning, "WARNING BoostRounds nullptr == aGains");
+         return Error_OutOfMemory;
+      }
+   }
+
+   const size_t iTermNextCaller = pBoosterShell->GetNextTermIndex();
+
+   // the first round is always cyclic since we need the gains of every term before we can be greedy
+   double greedyPortion = 0.0;
+
+   double metricMin = std::numeric_limits<double>::infinity();
+   double metricBreakpoint = std::numeric_limits<double>::infinity();
+   IntEbm cNoChangeRunLength = 0;
+
+   IntEbm iRound = 0;
+   while(iRound < maxRounds) {
+      const bool bGreedy = 1.0 <= greedyPortion;
+
+      BoostFlags flagsLocal = flags;
+      if(IntEbm { 0 } < smoothingRounds) {
+         flagsLocal = static_cast<BoostFlags>(static_cast<UBoostFlags>(flagsLocal) |
+            static_cast<UBoostFlags>(BoostFlags_DisableNewtonGain) |
+            static_cast<UBoostFlags>(BoostFlags_DisableNewtonUpdate) |
+            static_cast<UBoostFlags>(BoostFlags_RandomSplits));
+      }
+
+      for(size_t iStep = 0; iStep < cTerms; ++iStep) {
+         const size_t iTerm = bGreedy ? PickGreedyTerm(cTerms, aGains) : iStep;
+
+         double gain;
+         error = GenerateTermUpdate(
+            rng,
+            boosterHandle,
+            static_cast<IntEbm>(iTerm),
+            flagsLocal,
+            learningRate,
+            minSamplesLeaf,
+            leavesMax,
+            &gain
+         );
+         if(Error_None != error) {
+            free(aGains);
+            return error;
+         }
+         aGains[iTerm] = gain;
+
+         if(cTerms - size_t { 1 } == iStep) {
+            // early stopping looks at the metric once per round, so it needs to be fresh at the round boundary
+            pBoosterShell->GetBoosterCore()->RequestValidationMetric();
+         }
+
+         // in cyclic rounds we know the next term, so ApplyTermUpdate can build its histogram while it refreshes
+         // the gradients.  Random splits go through BoostRandom, which always builds its own
+         const bool bPipeline = !bGreedy && iStep + size_t { 1 } < cTerms &&
+            0 == (static_cast<UBoostFlags>(flagsLocal) & static_cast<UBoostFlags>(BoostFlags_RandomSplits));
+         pBoosterShell->SetNextTermIndex(bPipeline ? iStep + size_t { 1 } : BoosterShell::k_illegalTermIndex);
+
+         double metric;
+         error = ApplyTermUpdate(boosterHandle, &metric);
+         pBoosterShell->SetNextTermIndex(iTermNextCaller);
+         if(Error_None != error) {
+            free(aGains);
+            return error;
+         }
+
+         if(metric < metricMin) {
+            metricMin = metric;
+         }
+      }
+
+      // these early stopping rules deliberately mirror the python boosting loop so that both give identical models
+      if(IntEbm { 0 } == cNoChangeRunLength) {
+         metricBreakpoint = metricMin;
+      }
+      if(metricMin + earlyStoppingTolerance < metricBreakpoint) {
+         cNoChangeRunLength = 0;
+      } else {
+         ++cNoChangeRunLength;
+      }
+
+      if(bGreedy) {
+         greedyPortion -= 1.0;
+      }
+
+      if(IntEbm { 0 } < smoothingRounds) {
+         // the cuts are random during smoothing, so the validation metric is too noisy to judge progress by
+         cNoChangeRunLength = 0;
+         --smoothingRounds;
+      } else {
+         // do not progress into greedy rounds until we are done with the smoothing rounds
+         greedyPortion += greediness;
+      }
+
+      ++iRound;
+
+      if(IntEbm { 0 } < earlyStoppingRounds && earlyStoppingRounds <= cNoChangeRunLength) {
+         break;
+      }
+   }
+
+   free(aGains);
+
+   if(nullptr != countRoundsOut) {
+      *countRoundsOut = iRound;
+   }
+   if(nullptr != bestMetricOut) {
+      *bestMetricOut = metricMin;
+   }
+
+   LOG_N(
+      Trace_Info,
+      "Exited BoostRounds: "
+      "countRounds=%" IntEbmPrintf ", "
+      "bestMetric=%le"
+      ,
+      iRound,
+      metricMin
+   );
+
+   return Error_None;
+}
+
+struct BoostRoundsBagsContext final {
+   unsigned char * m_rngs;
+   BoosterHandle * m_boosterHandles;
+   BoostFlags m_flags;
+   double m_learningRate;
+   IntEbm m_minSamplesLeaf;
+   const IntEbm * m_leavesMax;
+   double m_greediness;
+   IntEbm m_smoothingRounds;
+   IntEbm m_maxRounds;
+   IntEbm m_earlyStoppingRounds;
+   double m_earlyStoppingTolerance;
+   IntEbm * m_countRoundsOut;
+   double * m_bestMetricOut;
+   ErrorEbm * m_aErrors;
+};
+
+static void BoostRoundsBagsTask(void * const pContext, const size_t iTask) {
+   const BoostRoundsBagsContext * const pBags = static_cast<const BoostRoundsBagsContext *>(pContext);
+   // each booster has its own scores, gradients and scratch space, so they can be boosted concurrently
+   pBags->m_aErrors[iTask] = BoostRounds(
+      nullptr == pBags->m_rngs ? nullptr : &pBags->m_rngs[sizeof(RandomDeterministic) * iTask],
+      pBags->m_boosterHandles[iTask],
+      pBags->m_flags,
+      pBags->m_learningRate,
+      pBags->m_minSamplesLeaf,
+      pBags->m_leavesMax,
+      pBags->m_greediness,
+      pBags->m_smoothingRounds,
+      pBags->m_maxRounds,
+      pBags->m_earlyStoppingRounds,
+      pBags->m_earlyStoppingTolerance,
+      nullptr == pBags->m_countRoundsOut ? nullptr : &pBags->m_countRoundsOut[iTask],
+      nullptr == pBags->m_bestMetricOut ? nullptr : &pBags->m_bestMetricOut[iTask]
+   );
+}
+
+EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION BoostRoundsBags(
+   IntEbm countBoosters,
+   void * rngs,
+   BoosterHandle * boosterHandles,
+   BoostFlags flags,
+   double learningRate,
+   IntEbm minSamplesLeaf,
+   const IntEbm * leavesMax,
+   double greediness,
+   IntEbm smoothingRounds,
+   IntEbm maxRounds,
+   IntEbm earlyStoppingRounds,
+   double earlyStoppingTolerance,
+   IntEbm * countRoundsOut,
+   double * bestMetricOut
+) {
+   LOG_N(
+      Trace_Info,
+      "Entered BoostRoundsBags: "
+      "countBoosters=%" IntEbmPrintf ", "
+      "rngs=%p, "
+      "boosterHandles=%p"
+      ,
+      countBoosters,
+      rngs,
+      static_cast<void *>(boosterHandles)
+   );
+
+   if(countBoosters < IntEbm { 0 }) {
+      LOG_0(Trace_Error, "ERROR BoostRoundsBags countBoosters must be non-negative");
+      return Error_IllegalParamVal;
+   }
+   if(IsConvertError<size_t>(countBoosters)) {
+      LOG_0(Trace_Error, "ERROR BoostRoundsBags IsConvertError<size_t>(countBoosters)");
+      return Error_IllegalParamVal;
+   }
+   const size_t cBoosters = static_cast<size_t>(countBoosters);
+   if(size_t { 0 } == cBoosters) {
+      return Error_None;
+   }
+
+   if(nullptr == boosterHandles) {
+      LOG_0(Trace_Error, "ERROR BoostRoundsBags nullptr == boosterHandles");
+      return Error_IllegalParamVal;
+   }
+
+   if(IsMultiplyError(sizeof(ErrorEbm), cBoosters)) {
+      LOG_0(Trace_Warning, "WARNING BoostRoundsBags IsMultiplyError(sizeof(ErrorEbm), cBoosters)");
+      return Error_OutOfMemory;
+   }
+   ErrorEbm * const aErrors = static_cast<ErrorEbm *>(malloc(sizeof(ErrorEbm) * cBoosters));
+   if(nullptr == aErrors) {
+      LOG_0(Trace_Warning, "WARNING BoostRoundsBags nullptr == aErrors");
+      return Error_OutOfMemory;
+   }
+
+   BoostRoundsBagsContext context;
+   context.m_rngs = static_cast<unsigned char *>(rngs);
+   context.m_boosterHandles = boosterHandles;
+   context.m_flags = flags;
+   context.m_learningRate = learningRate;
+   context.m_minSamplesLeaf = minSamplesLeaf;
+   context.m_leavesMax = leavesMax;
+   context.m_greediness = greediness;
+   context.m_smoothingRounds = smoothingRounds;
+   context.m_maxRounds = maxRounds;
+   context.m_earlyStoppingRounds = earlyStoppingRounds;
+   context.m_earlyStoppingTolerance = earlyStoppingTolerance;
+   context.m_countRoundsOut = countRoundsOut;
+   context.m_bestMetricOut = bestMetricOut;
+   context.m_aErrors = aErrors;
+
+   ErrorEbm error;
+   {
+      // the boosters of CreateBoosterBags already split the requested threads between their own thread pools.
+      // A bad first handle is reported by its own task below, so boost serially in that case
+      BoosterShell * const pBoosterShellFirst = BoosterShell::GetBoosterShellFromHandle(boosterHandles[0]);
+      const size_t cThreadsRequested =
+            nullptr == pBoosterShellFirst ? size_t { 1 } : pBoosterShellFirst->GetBoosterCore()->GetThreadsRequested();
+      ThreadPool threadPool;
+      error = threadPool.Start(cBoosters < cThreadsRequested ? cBoosters : cThreadsRequested);
+      if(Error_None == error) {
+         threadPool.Run(cBoosters, BoostRoundsBagsTask, &context);
+      }
+   }
+
+   for(size_t iBooster = 0; Error_None == error && iBooster < cBoosters; ++iBooster) {
+      error = aErrors[iBooster];
+   }
+   free(aErrors);
+
+   LOG_0(Trace_Info, "Exited BoostRoundsBags");
+   return error;
+}
+
+} // DEFINED_ZONE_NAME
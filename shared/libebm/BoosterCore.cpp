@@ -6,6 +6,7 @@
 
 #include <stdlib.h> // free
 #include <stddef.h> // size_t, ptrdiff_t
+#include <string.h> // memset
 #include <limits> // numeric_limits
 #include <thread>
 
@@ -51,6 +52,8 @@ extern ErrorEbm ExtractWeights(
    FloatFast ** ppWeightsOut
 );
 
+extern BagEbm * MakeBagForAllInitScores(const size_t cSamples, const BagEbm * const aBag);
+
 void BoosterCore::DeleteTensors(const size_t cTerms, Tensor ** const apTensors) {
    LOG_0(Trace_Info, "Entered DeleteTensors");
 
@@ -137,6 +140,9 @@ BoosterCore::~BoosterCore() {
    m_validationSet.Destruct();
 
    InnerBag::FreeInnerBags(m_cInnerBags, m_apInnerBags);
+   free(m_aInnerBagsCountOccurrences);
+   free(m_aInnerBagsWeights);
+   free(m_aTrainingWeights);
    free(m_aValidationWeights);
 
    Term::FreeTerms(m_cTerms, m_apTerms);
@@ -145,8 +151,16 @@ BoosterCore::~BoosterCore() {
 
    DeleteTensors(m_cTerms, m_apCurrentTermTensors);
    DeleteTensors(m_cTerms, m_apBestTermTensors);
+   free(m_aiDirtyTermNext);
+
+   FreeObjectiveWrapperInternals(&m_objectiveCpu);
+   FreeObjectiveWrapperInternals(&m_objectiveSIMD);
 
-   FreeObjectiveWrapperInternals(&m_objective);
+   FreeMetrics(m_cMetrics, m_aMetrics);
+   free(m_aValidationMetrics);
+
+   // our training set no longer references the input data, so release it after destructing the training set
+   BoosterCore::Free(m_pBoosterCoreInputData);
 };
 
 void BoosterCore::Free(BoosterCore * const pBoosterCore) {
@@ -173,23 +187,22 @@ void BoosterCore::Free(BoosterCore * const pBoosterCore) {
    LOG_0(Trace_Info, "Exited BoosterCore::Free");
 }
 
-//static int g_TODO_removeThisThreadTest = 0;
-//void TODO_removeThisThreadTest() {
-//   g_TODO_removeThisThreadTest = 1;
-//}
-
 ErrorEbm BoosterCore::Create(
    void * const rng,
    const size_t cTerms,
    const size_t cInnerBags,
+   const size_t cThreadsRequested,
    const double * const experimentalParams,
    const IntEbm * const acTermDimensions,
    const IntEbm * const aiTermFeatures, 
    const unsigned char * const pDataSetShared,
    const BagEbm * const aBag,
    const double * const aInitScores,
-   const BoolEbm isDifferentiallyPrivate,
+   const CreateBoosterFlags flags,
    const char * const sObjective,
+   const char * const sMetric,
+   const size_t cBagsShared,
+   BoosterCore * const pBoosterCoreInputData,
    BoosterCore ** const ppBoosterCoreOut
 ) {
    // experimentalParams isn't used by default.  It's meant to provide an easy way for python or other higher
@@ -201,28 +214,10 @@ ErrorEbm BoosterCore::Create(
    EBM_ASSERT(nullptr != ppBoosterCoreOut);
    EBM_ASSERT(nullptr == *ppBoosterCoreOut);
    EBM_ASSERT(nullptr != pDataSetShared);
+   EBM_ASSERT(nullptr == pBoosterCoreInputData || size_t { 0 } != cBagsShared);
 
    ErrorEbm error;
 
-   //try {
-   //   // TODO: eliminate this code I added to test that threads are available on the majority of our systems
-   //   std::thread testThread(TODO_removeThisThreadTest);
-   //   testThread.join();
-   //   if(0 == g_TODO_removeThisThreadTest) {
-   //      LOG_0(Trace_Warning, "WARNING BoosterCore::Create thread not started");
-   //      return Error_UnexpectedInternal;
-   //   }
-   //} catch(const std::bad_alloc &) {
-   //   LOG_0(Trace_Warning, "WARNING BoosterCore::Create thread start out of memory");
-   //   return Error_OutOfMemory;
-   //} catch(...) {
-   //   // the C++ standard doesn't really seem to say what kind of exceptions we'd get for various errors, so
-   //   // about the best we can do is catch(...) since the exact exceptions seem to be implementation specific
-   //   LOG_0(Trace_Warning, "WARNING BoosterCore::Create thread start failed");
-   //   return Error_ThreadStartFailed;
-   //}
-   //LOG_0(Trace_Info, "INFO BoosterCore::Create thread started");
-
    BoosterCore * pBoosterCore;
    try {
       pBoosterCore = new BoosterCore();
@@ -261,8 +256,8 @@ ErrorEbm BoosterCore::Create(
       LOG_0(Trace_Warning, "WARNING BoosterCore::Create size_t { 1 } < cWeights");
       return Error_IllegalParamVal;
    }
-   if(size_t { 1 } != cTargets) {
-      LOG_0(Trace_Warning, "WARNING BoosterCore::Create 1 != cTargets");
+   if(size_t { 0 } == cTargets) {
+      LOG_0(Trace_Warning, "WARNING BoosterCore::Create 0 == cTargets");
       return Error_IllegalParamVal;
    }
 
@@ -274,6 +269,14 @@ ErrorEbm BoosterCore::Create(
       return error;
    }
 
+   // The boosters made by CreateBoosterBags train on every sample of the dataset so that their training sets are 
+   // identical and can share one copy of the bit packed input data and targets.  Their bag only selects which
+   // samples the inner bags draw from, and the init scores include a row for every sample.  The price is that each
+   // booster keeps scores and gradients for its validation samples too, and ApplyUpdate and BinSums walk over them
+   const bool bBagSelects = size_t { 0 } != cBagsShared;
+   EBM_ASSERT(!bBagSelects || nullptr != aBag);
+   const size_t cTrainingSetSamples = bBagSelects && size_t { 0 } != cTrainingSamples ? cSamples : cTrainingSamples;
+
    LOG_0(Trace_Info, "BoosterCore::Create starting feature processing");
    if(0 != cFeatures) {
       pBoosterCore->m_cFeatures = cFeatures;
@@ -309,7 +312,6 @@ ErrorEbm BoosterCore::Create(
             &defaultValSparse,
             &cNonDefaultsSparse
          );
-         EBM_ASSERT(!bSparse); // we do not handle yet
          if(IsConvertError<size_t>(countBins)) {
             LOG_0(Trace_Error, "ERROR BoosterCore::Create IsConvertError<size_t>(countBins)");
             return Error_IllegalParamVal;
@@ -482,8 +484,8 @@ ErrorEbm BoosterCore::Create(
                      // we only use AuxillaryBins for pairs.  We wouldn't use them for random pairs, but we
                      // don't know yet if the caller will set the random boosting flag on all pairs, so allocate it
 
-                     // we need to reserve 4 PAST the pointer we pass into SweepMultiDimensional!!!!.  We pass in index 20 at max, so we need 24
-                     static constexpr size_t cAuxillaryBinsForSplitting = 24;
+                     // we need to reserve 5 PAST the pointer we pass into SweepPair!!!!.  We pass in index 23 at max, so we need 28
+                     static constexpr size_t cAuxillaryBinsForSplitting = 28;
                      const size_t cAuxillaryBins = EbmMax(cAuxillaryBinsForBuildFastTotals, cAuxillaryBinsForSplitting);
                      pTerm->SetCountAuxillaryBins(cAuxillaryBins);
 
@@ -515,8 +517,8 @@ ErrorEbm BoosterCore::Create(
          error = ExtractWeights(
             pDataSetShared,
             BagEbm { 1 },
-            aBag, 
-            cTrainingSamples,
+            bBagSelects ? nullptr : aBag, 
+            cTrainingSetSamples,
             &aWeights
          );
          if(Error_None != error) {
@@ -525,19 +527,65 @@ ErrorEbm BoosterCore::Create(
          }
       }
       pBoosterCore->m_cInnerBags = cInnerBags;
+      const bool bSubsample = 0 != (CreateBoosterFlags_InnerBagsSubsample & flags) && size_t { 0 } != cInnerBags;
+      if(bSubsample && bBagSelects) {
+         // the sample bits only record whether a sample was subsampled, so the weights carry the bag's replication
+         if(nullptr == aWeights) {
+            if(IsMultiplyError(sizeof(FloatFast), cTrainingSetSamples)) {
+               LOG_0(Trace_Warning, "WARNING BoosterCore::Create IsMultiplyError(sizeof(FloatFast), cTrainingSetSamples)");
+               return Error_OutOfMemory;
+            }
+            aWeights = static_cast<FloatFast *>(malloc(sizeof(FloatFast) * cTrainingSetSamples));
+            if(nullptr == aWeights) {
+               LOG_0(Trace_Warning, "WARNING BoosterCore::Create nullptr == aWeights");
+               return Error_OutOfMemory;
+            }
+            for(size_t iSample = 0; iSample < cTrainingSetSamples; ++iSample) {
+               aWeights[iSample] = FloatFast { 1 };
+            }
+         }
+         for(size_t iSample = 0; iSample < cTrainingSetSamples; ++iSample) {
+            const BagEbm replication = aBag[iSample];
+            aWeights[iSample] = BagEbm { 0 } < replication ? 
+               aWeights[iSample] * static_cast<FloatFast>(replication) : FloatFast { 0 };
+         }
+      }
+      if(bSubsample) {
+         // subsampled inner bags keep a bit per sample and share the unmodified training weights
+         EBM_ASSERT(nullptr == pBoosterCore->m_aTrainingWeights);
+         pBoosterCore->m_aTrainingWeights = aWeights;
+      }
       // TODO: we could steal the aWeights in GenerateInnerBags for flat sampling sets
       error = InnerBag::GenerateInnerBags(
          rng,
-         cTrainingSamples,
+         cTrainingSetSamples,
          aWeights, 
+         bBagSelects ? aBag : nullptr,
          cInnerBags,
+         bSubsample,
          &pBoosterCore->m_apInnerBags
       );
-      free(aWeights);
+      if(!bSubsample) {
+         free(aWeights);
+      }
       if(UNLIKELY(Error_None != error)) {
          // already logged
          return error;
       }
+
+      if(!bSubsample && size_t { 1 } < cInnerBags) {
+         error = InnerBag::GenerateSampleMajor(
+            cTrainingSetSamples,
+            cInnerBags,
+            pBoosterCore->m_apInnerBags,
+            &pBoosterCore->m_aInnerBagsCountOccurrences,
+            &pBoosterCore->m_aInnerBagsWeights
+         );
+         if(UNLIKELY(Error_None != error)) {
+            // already logged
+            return error;
+         }
+      }
    }
 
    EBM_ASSERT(nullptr == pBoosterCore->m_aValidationWeights);
@@ -573,26 +621,53 @@ ErrorEbm BoosterCore::Create(
       LOG_0(Trace_Warning, "WARNING BoosterCore::Create cClasses cannot fit into ptrdiff_t");
       return Error_IllegalParamVal;
    }
+   // with multiple targets we boost them jointly as the tasks of a single multitask objective, which requires
+   // that they all be regression or all be classification with the same number of classes
+   for(size_t iTarget = 1; iTarget < cTargets; ++iTarget) {
+      ptrdiff_t cTaskClasses;
+      if(nullptr == GetDataSetSharedTarget(pDataSetShared, iTarget, &cTaskClasses)) {
+         LOG_0(Trace_Warning, "WARNING BoosterCore::Create cClasses cannot fit into ptrdiff_t");
+         return Error_IllegalParamVal;
+      }
+      if(cClasses != cTaskClasses) {
+         LOG_0(Trace_Error, "ERROR BoosterCore::Create all targets must have the same type and number of classes");
+         return Error_IllegalParamVal;
+      }
+   }
    pBoosterCore->m_cClasses = cClasses;
 
    // having 1 class means that all predictions are perfect. In the C interface we reduce this into having 0 scores, 
    // which means that we do not write anything to our upper level callers, and we don't need a bunch of things
    // since they have zero memory allocated to them. Having 0 classes means there are also 0 samples.
    if(ptrdiff_t { 0 } != cClasses && ptrdiff_t { 1 } != cClasses) {
-      const size_t cScores = GetCountScores(cClasses);
+      // the member GetCountScores hides the free function here
+      const size_t cTaskScores = DEFINED_ZONE_NAME::GetCountScores(cClasses);
+      if(IsMultiplyError(cTaskScores, cTargets)) {
+         LOG_0(Trace_Warning, "WARNING BoosterCore::Create IsMultiplyError(cTaskScores, cTargets)");
+         return Error_OutOfMemory;
+      }
+      const size_t cScores = cTaskScores * cTargets;
+      pBoosterCore->m_cScores = cScores;
 
       LOG_0(Trace_Info, "INFO BoosterCore::Create determining Objective");
       Config config;
-      config.cOutputs = cScores;
-      config.isDifferentiallyPrivate = EBM_FALSE != isDifferentiallyPrivate ? EBM_TRUE : EBM_FALSE;
-      error = GetObjective(&config, sObjective, &pBoosterCore->m_objective);
+      config.cOutputs = cTaskScores;
+      config.cTasks = cTargets;
+      config.isDifferentiallyPrivate = 0 != (CreateBoosterFlags_DifferentialPrivacy & flags) ? EBM_TRUE : EBM_FALSE;
+      config.link = Link_ERROR;
+      error = GetObjective(&config, sObjective, &pBoosterCore->m_objectiveCpu, &pBoosterCore->m_objectiveSIMD);
       if (Error_None != error) {
          // already logged
          return error;
       }
       LOG_0(Trace_Info, "INFO BoosterCore::Create Objective determined");
 
-      const OutputType outputType = GetOutputType(pBoosterCore->m_objective.m_linkFunction);
+      if(size_t { 1 } != cTargets && EBM_FALSE == pBoosterCore->m_objectiveCpu.m_bMultitask) {
+         LOG_0(Trace_Error, "ERROR BoosterCore::Create the objective does not support multiple targets");
+         return Error_ObjectiveParamMismatchWithConfig;
+      }
+
+      const OutputType outputType = GetOutputType(pBoosterCore->m_objectiveCpu.m_linkFunction);
       if(IsClassification(cClasses)) {
          if(outputType < OutputType_GeneralClassification) {
             LOG_0(Trace_Error, "ERROR BoosterCore::Create mismatch in objective class model type");
@@ -605,9 +680,42 @@ ErrorEbm BoosterCore::Create(
          }
       }
 
-      if(EBM_FALSE != pBoosterCore->CheckTargets(cSamples, aTargets)) {
-         LOG_0(Trace_Warning, "WARNING BoosterCore::Create invalid target value");
-         return Error_ObjectiveIllegalTarget;
+      LOG_0(Trace_Info, "INFO BoosterCore::Create determining Metrics");
+      config.link = pBoosterCore->m_objectiveCpu.m_linkFunction;
+      error = GetMetrics(&config, sMetric, &pBoosterCore->m_cMetrics, &pBoosterCore->m_aMetrics);
+      if(Error_None != error) {
+         // already logged
+         return error;
+      }
+      if(size_t { 0 } != pBoosterCore->m_cMetrics) {
+         if(IsMultiplyError(sizeof(double), pBoosterCore->m_cMetrics)) {
+            LOG_0(Trace_Warning, "WARNING BoosterCore::Create IsMultiplyError(sizeof(double), pBoosterCore->m_cMetrics)");
+            return Error_OutOfMemory;
+         }
+         double * const aValidationMetrics = static_cast<double *>(malloc(sizeof(double) * pBoosterCore->m_cMetrics));
+         if(nullptr == aValidationMetrics) {
+            LOG_0(Trace_Warning, "WARNING BoosterCore::Create nullptr == aValidationMetrics");
+            return Error_OutOfMemory;
+         }
+         memset(aValidationMetrics, 0, sizeof(double) * pBoosterCore->m_cMetrics);
+         pBoosterCore->m_aValidationMetrics = aValidationMetrics;
+
+         if(size_t { 1 } != cTargets) {
+            // the registered metrics score a single target
+            LOG_0(Trace_Error, "ERROR BoosterCore::Create metrics cannot be used with multiple targets");
+            return Error_MetricParamMismatchWithConfig;
+         }
+      }
+      LOG_0(Trace_Info, "INFO BoosterCore::Create Metrics determined");
+
+      for(size_t iTarget = 0; iTarget < cTargets; ++iTarget) {
+         ptrdiff_t cTaskClasses;
+         const void * const aTaskTargets = GetDataSetSharedTarget(pDataSetShared, iTarget, &cTaskClasses);
+         EBM_ASSERT(nullptr != aTaskTargets); // we checked every target above
+         if(EBM_FALSE != pBoosterCore->CheckTargets(cSamples, aTaskTargets)) {
+            LOG_0(Trace_Warning, "WARNING BoosterCore::Create invalid target value");
+            return Error_ObjectiveIllegalTarget;
+         }
       }
       LOG_0(Trace_Info, "INFO BoosterCore::Create Targets verified");
 
@@ -683,8 +791,30 @@ ErrorEbm BoosterCore::Create(
          if(Error_None != error) {
             return error;
          }
+
+         if(IsMultiplyError(sizeof(size_t), cTerms)) {
+            LOG_0(Trace_Warning, "WARNING BoosterCore::Create IsMultiplyError(sizeof(size_t), cTerms)");
+            return Error_OutOfMemory;
+         }
+         size_t * const aiDirtyTermNext = static_cast<size_t *>(malloc(sizeof(size_t) * cTerms));
+         if(nullptr == aiDirtyTermNext) {
+            LOG_0(Trace_Warning, "WARNING BoosterCore::Create nullptr == aiDirtyTermNext");
+            return Error_OutOfMemory;
+         }
+         for(size_t iTerm = 0; iTerm < cTerms; ++iTerm) {
+            aiDirtyTermNext[iTerm] = k_termClean;
+         }
+         pBoosterCore->m_aiDirtyTermNext = aiDirtyTermNext;
+         pBoosterCore->m_iDirtyTermFirst = cTerms;
       }
 
+      const DataSetBoosting * pDataSetInputData = nullptr;
+      if(nullptr != pBoosterCoreInputData && size_t { 0 } != cTrainingSetSamples) {
+         EBM_ASSERT(cSamples == pBoosterCoreInputData->m_trainingSet.GetCountSamples());
+         pBoosterCoreInputData->AddReferenceCount();
+         pBoosterCore->m_pBoosterCoreInputData = pBoosterCoreInputData;
+         pDataSetInputData = &pBoosterCoreInputData->m_trainingSet;
+      }
       error = pBoosterCore->m_trainingSet.Initialize(
          cScores,
          true,
@@ -694,47 +824,101 @@ ErrorEbm BoosterCore::Create(
          pDataSetShared,
          cSamples,
          BagEbm { 1 },
-         aBag,
+         bBagSelects ? nullptr : aBag,
          aInitScores,
-         cTrainingSamples,
+         cTrainingSetSamples,
          aiTermFeatures,
          cTerms,
-         pBoosterCore->m_apTerms
+         pBoosterCore->m_apTerms,
+         pBoosterCore->GetCountBitPackLanes(),
+         pDataSetInputData
       );
       if(Error_None != error) {
          return error;
       }
 
+      BagEbm * aBagValidation = nullptr;
+      if(bBagSelects && nullptr != aInitScores && size_t { 0 } != cValidationSamples) {
+         aBagValidation = MakeBagForAllInitScores(cSamples, aBag);
+         if(nullptr == aBagValidation) {
+            return Error_OutOfMemory;
+         }
+      }
+
+      // RMSE only keeps residuals, so metrics other than the objective's need the targets to recover the scores
       error = pBoosterCore->m_validationSet.Initialize(
          cScores,
          pBoosterCore->IsRmse(),
          false,
          !pBoosterCore->IsRmse(),
-         !pBoosterCore->IsRmse(),
+         !pBoosterCore->IsRmse() || size_t { 0 } != pBoosterCore->m_cMetrics,
          pDataSetShared,
          cSamples,
          BagEbm { -1 },
-         aBag,
+         nullptr == aBagValidation ? aBag : aBagValidation,
          aInitScores,
          cValidationSamples,
          aiTermFeatures,
          cTerms,
-         pBoosterCore->m_apTerms
+         pBoosterCore->m_apTerms,
+         pBoosterCore->GetCountBitPackLanes(),
+         nullptr
       );
+      free(aBagValidation);
       if(Error_None != error) {
          return error;
       }
    }
 
+   // with multiple inner bags we split the bags across threads, otherwise we shard each histogram's samples
+   EBM_ASSERT(size_t { 1 } <= cThreadsRequested);
+   pBoosterCore->m_cThreadsRequested = cThreadsRequested;
+   size_t cThreads = cThreadsRequested;
+   if(size_t { 1 } < cBagsShared) {
+      // BoostRoundsBags boosts the boosters of CreateBoosterBags in parallel, so they split the threads
+      cThreads = cThreads <= cBagsShared ? size_t { 1 } : cThreads / cBagsShared;
+   }
+   if(size_t { 1 } < cInnerBags) {
+      cThreads = cInnerBags < cThreads ? cInnerBags : cThreads;
+   }
+   error = pBoosterCore->m_threadPool.Start(cThreads);
+   if(Error_None != error) {
+      return error;
+   }
+
    LOG_0(Trace_Info, "Exited BoosterCore::Create");
    return Error_None;
 }
 
+ErrorEbm BoosterCore::CopyDirtyTermsToBestModel() {
+   // the current and best models only differ in the terms updated since the last copy, so copying just 
+   // those keeps each improvement proportional to the terms boosted instead of to the size of the whole model
+   EBM_ASSERT(nullptr != m_aiDirtyTermNext);
+
+   size_t iTerm = m_iDirtyTermFirst;
+   while(m_cTerms != iTerm) {
+      EBM_ASSERT(iTerm < m_cTerms);
+      EBM_ASSERT(nullptr != m_apCurrentTermTensors[iTerm]);
+      EBM_ASSERT(nullptr != m_apBestTermTensors[iTerm]);
+      const ErrorEbm error = m_apBestTermTensors[iTerm]->Copy(*m_apCurrentTermTensors[iTerm]);
+      if(Error_None != error) {
+         // leave the uncopied terms in the list so that the next improvement copies them
+         m_iDirtyTermFirst = iTerm;
+         return error;
+      }
+      const size_t iTermNext = m_aiDirtyTermNext[iTerm];
+      m_aiDirtyTermNext[iTerm] = k_termClean;
+      iTerm = iTermNext;
+   }
+   m_iDirtyTermFirst = m_cTerms;
+   return Error_None;
+}
+
 ErrorEbm BoosterCore::InitializeBoosterGradientsAndHessians(
    FloatFast * const aMulticlassMidwayTemp,
-   FloatFast * const aUpdateScores
+   FloatScore * const aUpdateScores
 ) {
-   const size_t cScores = GetCountScores(GetCountClasses());
+   const size_t cScores = GetCountScores();
 
 #ifndef NDEBUG
    // we should be initted to zero
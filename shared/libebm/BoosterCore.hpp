@@ -17,6 +17,7 @@
 
 #include "ebm_internal.hpp" // FloatBig
 #include "DataSetBoosting.hpp"
+#include "ThreadPool.hpp"
 
 namespace DEFINED_ZONE_NAME {
 #ifndef DEFINED_ZONE_NAME
@@ -39,6 +40,8 @@ class BoosterCore final {
    std::atomic_size_t m_REFERENCE_COUNT;
 
    ptrdiff_t m_cClasses;
+   // multitask boosters hold the scores of each task side by side, so this is a multiple of the per task scores
+   size_t m_cScores;
 
    size_t m_cFeatures;
    FeatureBoosting * m_aFeatures;
@@ -48,14 +51,38 @@ class BoosterCore final {
 
    size_t m_cInnerBags;
    InnerBag ** m_apInnerBags;
+   // with more than one inner bag we also keep their counts and weights sample major so that one pass over
+   // the training set can build the histograms of every inner bag
+   size_t * m_aInnerBagsCountOccurrences;
+   FloatFast * m_aInnerBagsWeights;
+   // only kept when the inner bags are subsampled, since they reference these weights instead of copying them
+   FloatFast * m_aTrainingWeights;
    FloatBig m_validationWeightTotal;
    FloatFast * m_aValidationWeights;
 
    Tensor ** m_apCurrentTermTensors;
    Tensor ** m_apBestTermTensors;
 
+   // The terms updated since the best model was last copied form a linked list threaded through this array, 
+   // which holds the index of the next term in the list.  Terms not in the list hold k_termClean.  The list
+   // ends with the index m_cTerms, and an empty list has m_iDirtyTermFirst == m_cTerms.
+   size_t * m_aiDirtyTermNext;
+   size_t m_iDirtyTermFirst;
+
    double m_bestModelMetric;
 
+   // the validation metric is calculated on the first update, then on every m_cUpdatesPerMetric-th update, and on
+   // the next update after RequestValidationMetric.  In between ApplyTermUpdate reports m_lastValidationMetric
+   size_t m_cUpdatesPerMetric;
+   size_t m_cUpdatesSinceMetric;
+   bool m_bMetricRequested;
+   double m_lastValidationMetric;
+
+   // bumped by every ApplyTermUpdate since it changes the training gradients.  The shells made by
+   // CreateBoosterView share our gradients, so each one compares this against the generation its cached
+   // totals were built from instead of tracking the validity itself
+   size_t m_iGradientGeneration;
+
    size_t m_cBytesFastBins;
    size_t m_cBytesBigBins;
 
@@ -65,7 +92,22 @@ class BoosterCore final {
    DataSetBoosting m_trainingSet;
    DataSetBoosting m_validationSet;
 
-   ObjectiveWrapper m_objective;
+   // the boosters made by CreateBoosterBags share the bit packed input data of the first one, which we hold a
+   // reference on so that it outlives our training set.  nullptr if we packed our own
+   BoosterCore * m_pBoosterCoreInputData;
+
+   ObjectiveWrapper m_objectiveCpu;
+   ObjectiveWrapper m_objectiveSIMD;
+
+   // optional metrics that replace the objective's metric on the validation set.  The first one is used
+   // for early stopping and picking the best model
+   size_t m_cMetrics;
+   MetricWrapper * m_aMetrics;
+   double * m_aValidationMetrics;
+
+   // the threads requested when we were created, before CreateBoosterBags split them between its boosters
+   size_t m_cThreadsRequested;
+   ThreadPool m_threadPool;
 
    static void DeleteTensors(const size_t cTerms, Tensor ** const apTensors);
 
@@ -81,25 +123,42 @@ class BoosterCore final {
    inline BoosterCore() noexcept :
       m_REFERENCE_COUNT(1), // we're not visible on any other thread yet, so no synchronization required
       m_cClasses(0),
+      m_cScores(0),
       m_cFeatures(0),
       m_aFeatures(nullptr),
       m_cTerms(0),
       m_apTerms(nullptr),
       m_cInnerBags(0),
       m_apInnerBags(nullptr),
+      m_aInnerBagsCountOccurrences(nullptr),
+      m_aInnerBagsWeights(nullptr),
+      m_aTrainingWeights(nullptr),
       m_validationWeightTotal(0),
       m_aValidationWeights(nullptr),
       m_apCurrentTermTensors(nullptr),
       m_apBestTermTensors(nullptr),
+      m_aiDirtyTermNext(nullptr),
+      m_iDirtyTermFirst(0),
       m_bestModelMetric(std::numeric_limits<double>::infinity()),
+      m_cUpdatesPerMetric(1),
+      m_cUpdatesSinceMetric(0),
+      m_bMetricRequested(true),
+      m_lastValidationMetric(std::numeric_limits<double>::infinity()),
+      m_iGradientGeneration(0),
       m_cBytesFastBins(0),
       m_cBytesBigBins(0),
       m_cBytesSplitPositions(0),
-      m_cBytesTreeNodes(0)
+      m_cBytesTreeNodes(0),
+      m_pBoosterCoreInputData(nullptr),
+      m_cMetrics(0),
+      m_aMetrics(nullptr),
+      m_aValidationMetrics(nullptr),
+      m_cThreadsRequested(1)
    {
       m_trainingSet.InitializeUnfailing();
       m_validationSet.InitializeUnfailing();
-      InitializeObjectiveWrapperUnfailing(&m_objective);
+      InitializeObjectiveWrapperUnfailing(&m_objectiveCpu);
+      InitializeObjectiveWrapperUnfailing(&m_objectiveSIMD);
    }
 
 public:
@@ -115,6 +174,10 @@ public:
       return m_cClasses;
    }
 
+   inline size_t GetCountScores() const {
+      return m_cScores;
+   }
+
    inline size_t GetCountBytesFastBins() const {
       return m_cBytesFastBins;
    }
@@ -147,6 +210,14 @@ public:
       return &m_validationSet;
    }
 
+   inline size_t GetThreadsRequested() const {
+      return m_cThreadsRequested;
+   }
+
+   inline ThreadPool * GetThreadPool() {
+      return &m_threadPool;
+   }
+
    inline size_t GetCountInnerBags() const {
       return m_cInnerBags;
    }
@@ -155,6 +226,16 @@ public:
       return m_apInnerBags;
    }
 
+   inline const size_t * GetInnerBagsCountOccurrences() const {
+      // nullptr unless we have more than one inner bag and they were not subsampled
+      return m_aInnerBagsCountOccurrences;
+   }
+
+   inline const FloatFast * GetInnerBagsWeights() const {
+      // nullptr unless we have more than one inner bag and they were not subsampled
+      return m_aInnerBagsWeights;
+   }
+
    inline FloatBig GetValidationWeightTotal() const {
       return m_validationWeightTotal;
    }
@@ -171,6 +252,19 @@ public:
       return m_apBestTermTensors;
    }
 
+   static constexpr size_t k_termClean = std::numeric_limits<size_t>::max();
+
+   inline void MarkTermDirty(const size_t iTerm) {
+      EBM_ASSERT(iTerm < m_cTerms);
+      EBM_ASSERT(nullptr != m_aiDirtyTermNext);
+      if(k_termClean == m_aiDirtyTermNext[iTerm]) {
+         m_aiDirtyTermNext[iTerm] = m_iDirtyTermFirst;
+         m_iDirtyTermFirst = iTerm;
+      }
+   }
+
+   ErrorEbm CopyDirtyTermsToBestModel();
+
    inline double GetBestModelMetric() const {
       return m_bestModelMetric;
    }
@@ -179,78 +273,149 @@ public:
       m_bestModelMetric = bestModelMetric;
    }
 
+   inline void SetUpdatesPerMetric(const size_t cUpdatesPerMetric) {
+      EBM_ASSERT(1 <= cUpdatesPerMetric);
+      m_cUpdatesPerMetric = cUpdatesPerMetric;
+      // restart the schedule from the next update so that we never report a metric older than the new interval
+      m_cUpdatesSinceMetric = 0;
+      m_bMetricRequested = true;
+   }
+
+   inline void RequestValidationMetric() {
+      m_bMetricRequested = true;
+   }
+
+   // called once per validation update and returns true if this update should calculate the metric
+   inline bool AdvanceMetricSchedule() {
+      ++m_cUpdatesSinceMetric;
+      if(m_bMetricRequested || m_cUpdatesPerMetric <= m_cUpdatesSinceMetric) {
+         m_cUpdatesSinceMetric = 0;
+         m_bMetricRequested = false;
+         return true;
+      }
+      return false;
+   }
+
+   inline double GetLastValidationMetric() const {
+      return m_lastValidationMetric;
+   }
+
+   inline void SetLastValidationMetric(const double lastValidationMetric) {
+      m_lastValidationMetric = lastValidationMetric;
+   }
+
+   inline size_t GetGradientGeneration() const {
+      return m_iGradientGeneration;
+   }
+
+   inline void NextGradientGeneration() {
+      // starts from zero and cannot realistically reach BoosterShell::k_illegalGradientGeneration
+      ++m_iGradientGeneration;
+   }
+
    static void Free(BoosterCore * const pBoosterCore);
 
    static ErrorEbm Create(
       void * const rng,
       const size_t cTerms,
       const size_t cInnerBags,
+      const size_t cThreadsRequested,
       const double * const experimentalParams,
       const IntEbm * const acTermDimensions,
       const IntEbm * const aiTermFeatures,
       const unsigned char * const pDataSetShared,
       const BagEbm * const aBag,
       const double * const aInitScores,
-      const BoolEbm isDifferentiallyPrivate,
+      const CreateBoosterFlags flags,
       const char * const sObjective,
+      const char * const sMetric,
+      const size_t cBagsShared,
+      BoosterCore * const pBoosterCoreInputData,
       BoosterCore ** const ppBoosterCoreOut
    );
 
    ErrorEbm InitializeBoosterGradientsAndHessians(
       FloatFast * const aMulticlassMidwayTemp,
-      FloatFast * const aUpdateScores
+      FloatScore * const aUpdateScores
    );
 
    inline ErrorEbm ObjectiveApplyUpdate(ApplyUpdateBridge * const pData) {
-      return (*m_objective.m_pApplyUpdateC)(&m_objective, pData);
+      // the SIMD zone objective, when we have one, can only be used for ApplyUpdate
+      const ObjectiveWrapper * const pObjective = nullptr != m_objectiveSIMD.m_pObjective ? &m_objectiveSIMD : &m_objectiveCpu;
+      return (*pObjective->m_pApplyUpdateC)(pObjective, pData);
+   }
+
+   inline size_t GetCountBitPackLanes() const noexcept {
+      // the bit packs are laid out for whichever objective runs ApplyUpdate
+      const ObjectiveWrapper * const pObjective = nullptr != m_objectiveSIMD.m_pObjective ? &m_objectiveSIMD : &m_objectiveCpu;
+      return pObjective->m_cBitPackLanes;
    }
 
    inline double FinishMetric(const double metricSum) {
-      return (*m_objective.m_pFinishMetricC)(&m_objective, metricSum);
+      return (*m_objectiveCpu.m_pFinishMetricC)(&m_objectiveCpu, metricSum);
    }
 
    inline BoolEbm CheckTargets(const size_t c, const void * const aTargets) const noexcept {
-      return (*m_objective.m_pCheckTargetsC)(&m_objective, c, aTargets);
+      return (*m_objectiveCpu.m_pCheckTargetsC)(&m_objectiveCpu, c, aTargets);
    }
 
    inline bool IsRmse() {
-      return EBM_FALSE != m_objective.m_bRmse;
+      return EBM_FALSE != m_objectiveCpu.m_bRmse;
    }
 
    inline bool IsHessian() {
-      return EBM_FALSE != m_objective.m_bObjectiveHasHessian;
+      return EBM_FALSE != m_objectiveCpu.m_bObjectiveHasHessian;
    }
 
    inline double LearningRateAdjustmentDifferentialPrivacy() const noexcept {
-      return m_objective.m_learningRateAdjustmentDifferentialPrivacy;
+      return m_objectiveCpu.m_learningRateAdjustmentDifferentialPrivacy;
    }
 
    inline double LearningRateAdjustmentGradientBoosting() const noexcept {
-      return m_objective.m_learningRateAdjustmentGradientBoosting;
+      return m_objectiveCpu.m_learningRateAdjustmentGradientBoosting;
    }
 
    inline double LearningRateAdjustmentHessianBoosting() const noexcept {
-      return m_objective.m_learningRateAdjustmentHessianBoosting;
+      return m_objectiveCpu.m_learningRateAdjustmentHessianBoosting;
    }
 
    inline double GainAdjustmentGradientBoosting() const noexcept {
-      return m_objective.m_gainAdjustmentGradientBoosting;
+      return m_objectiveCpu.m_gainAdjustmentGradientBoosting;
    }
 
    inline double GainAdjustmentHessianBoosting() const noexcept {
-      return m_objective.m_gainAdjustmentHessianBoosting;
+      return m_objectiveCpu.m_gainAdjustmentHessianBoosting;
    }
 
    inline double GradientConstant() {
-      return m_objective.m_gradientConstant;
+      return m_objectiveCpu.m_gradientConstant;
    }
 
    inline double HessianConstant() {
-      return m_objective.m_hessianConstant;
+      return m_objectiveCpu.m_hessianConstant;
    }
 
    inline BoolEbm MaximizeMetric() {
-      return m_objective.m_bMaximizeMetric;
+      return m_objectiveCpu.m_bMaximizeMetric;
+   }
+
+   inline size_t GetCountMetrics() const noexcept {
+      return m_cMetrics;
+   }
+
+   inline ErrorEbm CalcMetric(const size_t iMetric, MetricBridge * const pData) {
+      EBM_ASSERT(iMetric < m_cMetrics);
+      const MetricWrapper * const pMetric = &m_aMetrics[iMetric];
+      return (*pMetric->m_pCalcMetricC)(pMetric, pData);
+   }
+
+   inline BoolEbm MetricMaximize(const size_t iMetric) const noexcept {
+      EBM_ASSERT(iMetric < m_cMetrics);
+      return m_aMetrics[iMetric].m_bMaximizeMetric;
+   }
+
+   inline double * GetValidationMetrics() {
+      return m_aValidationMetrics;
    }
 };
 
@@ -10,10 +10,14 @@
 
 #include "RandomDeterministic.hpp" // RandomDeterministic
 
+#include "dataset_shared.hpp" // GetDataSetSharedHeader
+
 #include "Feature.hpp" // Feature
 #include "Term.hpp" // Term
 #include "Transpose.hpp"
 #include "Tensor.hpp" // Tensor
+#include "Bin.hpp" // GetBinSize
+#include "ThreadPool.hpp" // GetCountThreadsRequested
 
 #include "BoosterCore.hpp" // BoosterCore
 #include "BoosterShell.hpp"
@@ -25,6 +29,9 @@ namespace DEFINED_ZONE_NAME {
 
 struct BinBase;
 
+// the histograms of all the inner bags are summed in one pass over the samples when they fit within this budget
+static constexpr size_t k_cBytesInnerBagsFastBinsMax = size_t { 64 } * size_t { 1024 } * size_t { 1024 };
+
 extern void InitializeRmseGradientsAndHessians(
    const unsigned char * const pDataSetShared,
    const BagEbm direction,
@@ -35,17 +42,37 @@ extern void InitializeRmseGradientsAndHessians(
    const FloatFast * const aWeight
 );
 
+extern BagEbm * MakeBagForAllInitScores(const size_t cSamples, const BagEbm * const aBag);
+
+void BoosterShell::FreeScratchAllocations() {
+   Tensor::Free(m_pTermUpdate);
+   Tensor::Free(m_pInnerTermUpdate);
+   free(m_aBoostingFastBinsTemp);
+   free(m_aBoostingBigBins);
+   free(m_aMulticlassMidwayTemp);
+   free(m_aSplitPositionsTemp);
+   free(m_aTreeNodesTemp);
+
+   BoosterShell * pThreadShell = m_aThreadShells;
+   if(nullptr != pThreadShell) {
+      const BoosterShell * const pThreadShellsEnd = &pThreadShell[m_cThreadShells];
+      while(pThreadShellsEnd != pThreadShell) {
+         pThreadShell->FreeScratchAllocations();
+         ++pThreadShell;
+      }
+      free(m_aThreadShells);
+   }
+   free(m_aInnerBagRngs);
+   free(m_aShardFastBins);
+   free(m_aInnerBagsFastBins);
+   free(m_aSparseTotalBins);
+}
+
 void BoosterShell::Free(BoosterShell * const pBoosterShell) {
    LOG_0(Trace_Info, "Entered BoosterShell::Free");
 
    if(nullptr != pBoosterShell) {
-      Tensor::Free(pBoosterShell->m_pTermUpdate);
-      Tensor::Free(pBoosterShell->m_pInnerTermUpdate);
-      free(pBoosterShell->m_aBoostingFastBinsTemp);
-      free(pBoosterShell->m_aBoostingBigBins);
-      free(pBoosterShell->m_aMulticlassMidwayTemp);
-      free(pBoosterShell->m_aSplitPositionsTemp);
-      free(pBoosterShell->m_aTreeNodesTemp);
+      pBoosterShell->FreeScratchAllocations();
       BoosterCore::Free(pBoosterShell->m_pBoosterCore);
 
       // before we free our memory, indicate it was freed so if our higher level language attempts to use it we have
@@ -78,9 +105,98 @@ ErrorEbm BoosterShell::FillAllocations() {
 
    LOG_0(Trace_Info, "Entered BoosterShell::FillAllocations");
 
+   ErrorEbm error = FillScratchAllocations();
+   if(Error_None != error) {
+      return error;
+   }
+
+   const ptrdiff_t cClasses = m_pBoosterCore->GetCountClasses();
+   const size_t cInnerBags = m_pBoosterCore->GetCountInnerBags();
+   if(ptrdiff_t { 0 } != cClasses && ptrdiff_t { 1 } != cClasses && 
+      m_pBoosterCore->GetTrainingSet()->HasSparseInputData()) 
+   {
+      const size_t cScores = m_pBoosterCore->GetCountScores();
+      EBM_ASSERT(!IsOverflowBinSize<FloatFast>(m_pBoosterCore->IsHessian(), cScores)); // we check in CreateBooster
+      const size_t cBytesPerFastBin = GetBinSize<FloatFast>(m_pBoosterCore->IsHessian(), cScores);
+      const size_t cInnerBagsAfterZero = size_t { 0 } == cInnerBags ? size_t { 1 } : cInnerBags;
+      if(IsMultiplyError(cBytesPerFastBin, cInnerBagsAfterZero)) {
+         goto failed_allocation;
+      }
+      m_aSparseTotalBins = static_cast<BinBase *>(malloc(cBytesPerFastBin * cInnerBagsAfterZero));
+      if(nullptr == m_aSparseTotalBins) {
+         goto failed_allocation;
+      }
+   }
+
+   if(ptrdiff_t { 0 } != cClasses && ptrdiff_t { 1 } != cClasses && size_t { 1 } >= cInnerBags) {
+      const size_t cThreads = m_pBoosterCore->GetThreadPool()->GetCountThreads();
+      if(size_t { 1 } < cThreads && 0 != m_pBoosterCore->GetCountBytesFastBins()) {
+         const size_t cShardFastBins = cThreads - size_t { 1 };
+         if(IsMultiplyError(m_pBoosterCore->GetCountBytesFastBins(), cShardFastBins)) {
+            goto failed_allocation;
+         }
+         m_aShardFastBins = static_cast<BinBase *>(malloc(m_pBoosterCore->GetCountBytesFastBins() * cShardFastBins));
+         if(nullptr == m_aShardFastBins) {
+            goto failed_allocation;
+         }
+         m_cShardFastBins = cShardFastBins;
+      }
+   } else if(ptrdiff_t { 0 } != cClasses && ptrdiff_t { 1 } != cClasses) {
+      const size_t cBytesFastBins = m_pBoosterCore->GetCountBytesFastBins();
+      // subsampled inner bags have no sample major counts, so they are always summed separately
+      if(nullptr != m_pBoosterCore->GetInnerBagsCountOccurrences() &&
+         0 != cBytesFastBins && !IsMultiplyError(cBytesFastBins, cInnerBags) &&
+         cBytesFastBins * cInnerBags <= k_cBytesInnerBagsFastBinsMax) {
+         // if this fails we fall back to summing each inner bag separately
+         m_aInnerBagsFastBins = static_cast<BinBase *>(malloc(cBytesFastBins * cInnerBags));
+      }
+
+      size_t cThreads = m_pBoosterCore->GetThreadPool()->GetCountThreads();
+      cThreads = cInnerBags < cThreads ? cInnerBags : cThreads;
+      if(size_t { 1 } < cThreads) {
+         const size_t cThreadShells = cThreads - size_t { 1 };
+         if(IsMultiplyError(sizeof(BoosterShell), cThreadShells) ||
+            IsMultiplyError(sizeof(RandomDeterministic), cInnerBags)) {
+            goto failed_allocation;
+         }
+
+         m_aInnerBagRngs = static_cast<RandomDeterministic *>(malloc(sizeof(RandomDeterministic) * cInnerBags));
+         if(nullptr == m_aInnerBagRngs) {
+            goto failed_allocation;
+         }
+
+         m_aThreadShells = static_cast<BoosterShell *>(malloc(sizeof(BoosterShell) * cThreadShells));
+         if(nullptr == m_aThreadShells) {
+            goto failed_allocation;
+         }
+
+         do {
+            BoosterShell * const pThreadShell = &m_aThreadShells[m_cThreadShells];
+            pThreadShell->InitializeUnfailing(m_pBoosterCore);
+            // increment before filling so that FreeScratchAllocations cleans up a partial allocation
+            ++m_cThreadShells;
+            error = pThreadShell->FillScratchAllocations();
+            if(Error_None != error) {
+               return error;
+            }
+         } while(cThreadShells != m_cThreadShells);
+      }
+   }
+
+   LOG_0(Trace_Info, "Exited BoosterShell::FillAllocations");
+   return Error_None;
+
+failed_allocation:;
+   LOG_0(Trace_Warning, "WARNING Exited BoosterShell::FillAllocations with allocation failure");
+   return Error_OutOfMemory;
+}
+
+ErrorEbm BoosterShell::FillScratchAllocations() {
+   EBM_ASSERT(nullptr != m_pBoosterCore);
+
    const ptrdiff_t cClasses = m_pBoosterCore->GetCountClasses();
    if(ptrdiff_t { 0 } != cClasses && ptrdiff_t { 1 } != cClasses) {
-      const size_t cScores = GetCountScores(cClasses);
+      const size_t cScores = m_pBoosterCore->GetCountScores();
 
       m_pTermUpdate = Tensor::Allocate(k_cDimensionsMax, cScores);
       if(nullptr == m_pTermUpdate) {
@@ -131,70 +247,41 @@ ErrorEbm BoosterShell::FillAllocations() {
       }
    }
 
-   LOG_0(Trace_Info, "Exited BoosterShell::FillAllocations");
+   LOG_0(Trace_Verbose, "Exited BoosterShell::FillScratchAllocations");
    return Error_None;
 
 failed_allocation:;
-   LOG_0(Trace_Warning, "WARNING Exited BoosterShell::FillAllocations with allocation failure");
+   LOG_0(Trace_Warning, "WARNING Exited BoosterShell::FillScratchAllocations with allocation failure");
    return Error_OutOfMemory;
 }
 
-EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CreateBooster(
-   void * rng,
-   const void * dataSet,
-   const BagEbm * bag,
-   const double * initScores,
-   IntEbm countTerms,
-   const IntEbm * dimensionCounts,
-   const IntEbm * featureIndexes,
-   IntEbm countInnerBags,
-   BoolEbm isDifferentiallyPrivate,
-   const char * objective,
-   const double * experimentalParams,
-   BoosterHandle * boosterHandleOut
+static ErrorEbm CreateBoosterShell(
+   void * const rng,
+   const unsigned char * const pDataSetShared,
+   const BagEbm * const aBag,
+   const double * const aInitScores,
+   const IntEbm countTerms,
+   const IntEbm * const dimensionCounts,
+   const IntEbm * const featureIndexes,
+   const IntEbm countInnerBags,
+   const CreateBoosterFlags flags,
+   const char * const objective,
+   const char * const metric,
+   const IntEbm countThreads,
+   const double * const experimentalParams,
+   const size_t cSamples,
+   const size_t cBagsShared,
+   BoosterCore * const pBoosterCoreInputData,
+   BoosterShell ** const ppBoosterShellOut
 ) {
-   LOG_N(
-      Trace_Info,
-      "Entered CreateBooster: "
-      "rng=%p, "
-      "dataSet=%p, "
-      "bag=%p, "
-      "initScores=%p, "
-      "countTerms=%" IntEbmPrintf ", "
-      "dimensionCounts=%p, "
-      "featureIndexes=%p, "
-      "countInnerBags=%" IntEbmPrintf ", "
-      "isDifferentiallyPrivate=%s, "
-      "objective=%p, "
-      "experimentalParams=%p, "
-      "boosterHandleOut=%p"
-      ,
-      rng,
-      dataSet,
-      static_cast<const void *>(bag),
-      static_cast<const void *>(initScores),
-      countTerms,
-      static_cast<const void *>(dimensionCounts),
-      static_cast<const void *>(featureIndexes),
-      countInnerBags,
-      ObtainTruth(isDifferentiallyPrivate),
-      static_cast<const void *>(objective), // do not print the string for security reasons
-      static_cast<const void *>(experimentalParams),
-      static_cast<const void *>(boosterHandleOut)
-   );
-
-   ErrorEbm error;
+   // cBagsShared is zero for CreateBooster.  CreateBoosterBags passes the number of boosters it makes, and the bag 
+   // then selects samples from the training set instead of removing them, with init scores for every sample
 
-   if(nullptr == boosterHandleOut) {
-      LOG_0(Trace_Error, "ERROR CreateBooster nullptr == boosterHandleOut");
-      return Error_IllegalParamVal;
-   }
-   *boosterHandleOut = nullptr; // set this to nullptr as soon as possible so the caller doesn't attempt to free it
+   EBM_ASSERT(nullptr != pDataSetShared);
+   EBM_ASSERT(nullptr != ppBoosterShellOut);
+   EBM_ASSERT(nullptr == *ppBoosterShellOut);
 
-   if(nullptr == dataSet) {
-      LOG_0(Trace_Error, "ERROR CreateBooster nullptr == dataSet");
-      return Error_IllegalParamVal;
-   }
+   ErrorEbm error;
 
    if(IsConvertError<size_t>(countTerms)) {
       // the caller should not have been able to allocate memory for dimensionCounts if this wasn't fittable in size_t
@@ -218,6 +305,19 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CreateBooster(
    }
    const size_t cInnerBags = static_cast<size_t>(countInnerBags);
 
+   if(0 != (static_cast<UCreateBoosterFlags>(flags) & ~(
+      static_cast<UCreateBoosterFlags>(CreateBoosterFlags_DifferentialPrivacy) |
+      static_cast<UCreateBoosterFlags>(CreateBoosterFlags_InnerBagsSubsample)
+   ))) {
+      LOG_0(Trace_Error, "ERROR CreateBooster flags contains unknown flags. Ignoring extras.");
+   }
+
+   if(countThreads < IntEbm { 0 }) {
+      LOG_0(Trace_Error, "ERROR CreateBooster countThreads must be non-negative");
+      return Error_IllegalParamVal;
+   }
+   const size_t cThreadsRequested = GetCountThreadsRequested(countThreads);
+
    // TODO: since BoosterCore is a non-POD C++ class, we should probably move the call to new from inside
    //       BoosterCore::Create to here and wrap it with a try catch at this level and rely on standard C++ behavior
    BoosterCore * pBoosterCore = nullptr;
@@ -225,14 +325,18 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CreateBooster(
       rng,
       cTerms,
       cInnerBags,
+      cThreadsRequested,
       experimentalParams,
       dimensionCounts,
       featureIndexes,
-      static_cast<const unsigned char *>(dataSet),
-      bag,
-      initScores,
-      isDifferentiallyPrivate,
+      pDataSetShared,
+      aBag,
+      aInitScores,
+      flags,
       objective,
+      metric,
+      cBagsShared,
+      pBoosterCoreInputData,
       &pBoosterCore
    );
    if(UNLIKELY(Error_None != error)) {
@@ -270,10 +374,10 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CreateBooster(
          // check for 0 training samples
          if(!pBoosterCore->GetTrainingSet()->IsGradientsAndHessiansNull()) {
             InitializeRmseGradientsAndHessians(
-               static_cast<const unsigned char *>(dataSet),
+               pDataSetShared,
                BagEbm { 1 },
-               bag,
-               initScores,
+               size_t { 0 } != cBagsShared ? nullptr : aBag,
+               aInitScores,
                pBoosterCore->GetTrainingSet()->GetCountSamples(),
                pBoosterCore->GetTrainingSet()->GetGradientsAndHessiansPointer(),
                nullptr // for boosting do not pre-multiply the gradients by the weight
@@ -281,19 +385,119 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CreateBooster(
          }
          // check for 0 validation samples
          if(!pBoosterCore->GetValidationSet()->IsGradientsAndHessiansNull()) {
+            BagEbm * aBagValidation = nullptr;
+            if(size_t { 0 } != cBagsShared && nullptr != aInitScores) {
+               aBagValidation = MakeBagForAllInitScores(cSamples, aBag);
+               if(nullptr == aBagValidation) {
+                  BoosterShell::Free(pBoosterShell);
+                  return Error_OutOfMemory;
+               }
+            }
             InitializeRmseGradientsAndHessians(
-               static_cast<const unsigned char *>(dataSet),
+               pDataSetShared,
                BagEbm { -1 },
-               bag,
-               initScores,
+               nullptr == aBagValidation ? aBag : aBagValidation,
+               aInitScores,
                pBoosterCore->GetValidationSet()->GetCountSamples(),
                pBoosterCore->GetValidationSet()->GetGradientsAndHessiansPointer(),
                nullptr // for boosting do not pre-multiply the gradients by the weight
             );
+            free(aBagValidation);
          }
       }
    }
 
+   *ppBoosterShellOut = pBoosterShell;
+   return Error_None;
+}
+
+EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CreateBooster(
+   void * rng,
+   const void * dataSet,
+   const BagEbm * bag,
+   const double * initScores,
+   IntEbm countTerms,
+   const IntEbm * dimensionCounts,
+   const IntEbm * featureIndexes,
+   IntEbm countInnerBags,
+   CreateBoosterFlags flags,
+   const char * objective,
+   const char * metric,
+   IntEbm countThreads,
+   const double * experimentalParams,
+   BoosterHandle * boosterHandleOut
+) {
+   LOG_N(
+      Trace_Info,
+      "Entered CreateBooster: "
+      "rng=%p, "
+      "dataSet=%p, "
+      "bag=%p, "
+      "initScores=%p, "
+      "countTerms=%" IntEbmPrintf ", "
+      "dimensionCounts=%p, "
+      "featureIndexes=%p, "
+      "countInnerBags=%" IntEbmPrintf ", "
+      "flags=0x%" UCreateBoosterFlagsPrintf ", "
+      "objective=%p, "
+      "metric=%p, "
+      "countThreads=%" IntEbmPrintf ", "
+      "experimentalParams=%p, "
+      "boosterHandleOut=%p"
+      ,
+      rng,
+      dataSet,
+      static_cast<const void *>(bag),
+      static_cast<const void *>(initScores),
+      countTerms,
+      static_cast<const void *>(dimensionCounts),
+      static_cast<const void *>(featureIndexes),
+      countInnerBags,
+      static_cast<UCreateBoosterFlags>(flags), // signed to unsigned conversion is defined behavior in C++
+      static_cast<const void *>(objective), // do not print the string for security reasons
+      static_cast<const void *>(metric), // do not print the string for security reasons
+      countThreads,
+      static_cast<const void *>(experimentalParams),
+      static_cast<const void *>(boosterHandleOut)
+   );
+
+   ErrorEbm error;
+
+   if(nullptr == boosterHandleOut) {
+      LOG_0(Trace_Error, "ERROR CreateBooster nullptr == boosterHandleOut");
+      return Error_IllegalParamVal;
+   }
+   *boosterHandleOut = nullptr; // set this to nullptr as soon as possible so the caller doesn't attempt to free it
+
+   if(nullptr == dataSet) {
+      LOG_0(Trace_Error, "ERROR CreateBooster nullptr == dataSet");
+      return Error_IllegalParamVal;
+   }
+
+   BoosterShell * pBoosterShell = nullptr;
+   error = CreateBoosterShell(
+      rng,
+      static_cast<const unsigned char *>(dataSet),
+      bag,
+      initScores,
+      countTerms,
+      dimensionCounts,
+      featureIndexes,
+      countInnerBags,
+      flags,
+      objective,
+      metric,
+      countThreads,
+      experimentalParams,
+      size_t { 0 },
+      size_t { 0 },
+      nullptr,
+      &pBoosterShell
+   );
+   if(Error_None != error) {
+      return error;
+   }
+
    const BoosterHandle handle = pBoosterShell->GetHandle();
 
    LOG_N(Trace_Info, "Exited CreateBooster: *boosterHandleOut=%p", static_cast<void *>(handle));
@@ -302,6 +506,169 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CreateBooster(
    return Error_None;
 }
 
+EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CreateBoosterBags(
+   void * rng,
+   const void * dataSet,
+   IntEbm countBags,
+   const BagEbm * bags,
+   const double * initScores,
+   IntEbm countTerms,
+   const IntEbm * dimensionCounts,
+   const IntEbm * featureIndexes,
+   IntEbm countInnerBags,
+   CreateBoosterFlags flags,
+   const char * objective,
+   const char * metric,
+   IntEbm countThreads,
+   const double * experimentalParams,
+   BoosterHandle * boosterHandlesOut
+) {
+   LOG_N(
+      Trace_Info,
+      "Entered CreateBoosterBags: "
+      "rng=%p, "
+      "dataSet=%p, "
+      "countBags=%" IntEbmPrintf ", "
+      "bags=%p, "
+      "initScores=%p, "
+      "countTerms=%" IntEbmPrintf ", "
+      "dimensionCounts=%p, "
+      "featureIndexes=%p, "
+      "countInnerBags=%" IntEbmPrintf ", "
+      "flags=0x%" UCreateBoosterFlagsPrintf ", "
+      "objective=%p, "
+      "metric=%p, "
+      "countThreads=%" IntEbmPrintf ", "
+      "experimentalParams=%p, "
+      "boosterHandlesOut=%p"
+      ,
+      rng,
+      dataSet,
+      countBags,
+      static_cast<const void *>(bags),
+      static_cast<const void *>(initScores),
+      countTerms,
+      static_cast<const void *>(dimensionCounts),
+      static_cast<const void *>(featureIndexes),
+      countInnerBags,
+      static_cast<UCreateBoosterFlags>(flags), // signed to unsigned conversion is defined behavior in C++
+      static_cast<const void *>(objective), // do not print the string for security reasons
+      static_cast<const void *>(metric), // do not print the string for security reasons
+      countThreads,
+      static_cast<const void *>(experimentalParams),
+      static_cast<const void *>(boosterHandlesOut)
+   );
+
+   ErrorEbm error;
+
+   if(countBags < IntEbm { 0 }) {
+      LOG_0(Trace_Error, "ERROR CreateBoosterBags countBags must be non-negative");
+      return Error_IllegalParamVal;
+   }
+   if(IsConvertError<size_t>(countBags)) {
+      LOG_0(Trace_Error, "ERROR CreateBoosterBags IsConvertError<size_t>(countBags)");
+      return Error_IllegalParamVal;
+   }
+   const size_t cBags = static_cast<size_t>(countBags);
+   if(size_t { 0 } == cBags) {
+      LOG_0(Trace_Warning, "WARNING CreateBoosterBags zero bags");
+      return Error_None;
+   }
+
+   if(nullptr == boosterHandlesOut) {
+      LOG_0(Trace_Error, "ERROR CreateBoosterBags nullptr == boosterHandlesOut");
+      return Error_IllegalParamVal;
+   }
+   // set these to nullptr as soon as possible so the caller doesn't attempt to free them
+   for(size_t iBag = 0; iBag < cBags; ++iBag) {
+      boosterHandlesOut[iBag] = nullptr;
+   }
+
+   if(nullptr == dataSet) {
+      LOG_0(Trace_Error, "ERROR CreateBoosterBags nullptr == dataSet");
+      return Error_IllegalParamVal;
+   }
+   const unsigned char * const pDataSetShared = static_cast<const unsigned char *>(dataSet);
+
+   if(nullptr == bags) {
+      LOG_0(Trace_Error, "ERROR CreateBoosterBags nullptr == bags");
+      return Error_IllegalParamVal;
+   }
+
+   SharedStorageDataType countSamples;
+   size_t cFeatures;
+   size_t cWeights;
+   size_t cTargets;
+   error = GetDataSetSharedHeader(pDataSetShared, &countSamples, &cFeatures, &cWeights, &cTargets);
+   if(Error_None != error) {
+      // already logged
+      return error;
+   }
+   if(IsConvertError<size_t>(countSamples)) {
+      LOG_0(Trace_Error, "ERROR CreateBoosterBags IsConvertError<size_t>(countSamples)");
+      return Error_IllegalParamVal;
+   }
+   const size_t cSamples = static_cast<size_t>(countSamples);
+   if(IsMultiplyError(cSamples, cBags)) {
+      LOG_0(Trace_Error, "ERROR CreateBoosterBags IsMultiplyError(cSamples, cBags)");
+      return Error_IllegalParamVal;
+   }
+
+   // The first booster with training samples packs the input data of its training set, which holds every sample,
+   // and the boosters after it share that copy instead of packing their own
+   BoosterCore * pBoosterCoreInputData = nullptr;
+   size_t cInitScoresPerBag = 0;
+   for(size_t iBag = 0; iBag < cBags; ++iBag) {
+      BoosterShell * pBoosterShell = nullptr;
+      error = CreateBoosterShell(
+         rng,
+         pDataSetShared,
+         &bags[cSamples * iBag],
+         nullptr == initScores ? nullptr : &initScores[cInitScoresPerBag * iBag],
+         countTerms,
+         dimensionCounts,
+         featureIndexes,
+         countInnerBags,
+         flags,
+         objective,
+         metric,
+         countThreads,
+         experimentalParams,
+         cSamples,
+         cBags,
+         pBoosterCoreInputData,
+         &pBoosterShell
+      );
+      if(Error_None == error && size_t { 0 } == iBag) {
+         // every bag has the same number of scores, so the first booster tells us how far apart the init scores are
+         const size_t cScores = pBoosterShell->GetBoosterCore()->GetCountScores();
+         if(IsMultiplyError(cSamples, cScores, cBags)) {
+            LOG_0(Trace_Error, "ERROR CreateBoosterBags IsMultiplyError(cSamples, cScores, cBags)");
+            BoosterShell::Free(pBoosterShell);
+            error = Error_IllegalParamVal;
+         }
+         cInitScoresPerBag = cSamples * cScores;
+      }
+      if(Error_None != error) {
+         // give the caller all of the boosters or none of them
+         for(size_t iBagFree = 0; iBagFree < iBag; ++iBagFree) {
+            BoosterShell::Free(BoosterShell::GetBoosterShellFromHandle(boosterHandlesOut[iBagFree]));
+            boosterHandlesOut[iBagFree] = nullptr;
+         }
+         return error;
+      }
+
+      BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
+      if(nullptr == pBoosterCoreInputData && size_t { 0 } != pBoosterCore->GetTrainingSet()->GetCountSamples()) {
+         pBoosterCoreInputData = pBoosterCore;
+      }
+      boosterHandlesOut[iBag] = pBoosterShell->GetHandle();
+   }
+
+   LOG_0(Trace_Info, "Exited CreateBoosterBags");
+   return Error_None;
+}
+
 EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CreateBoosterView(
    BoosterHandle boosterHandle,
    BoosterHandle * boosterHandleViewOut
@@ -422,10 +789,10 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION GetBestTermScores(
    Tensor * const pTensor = pBoosterCore->GetBestModel()[iTerm];
    EBM_ASSERT(nullptr != pTensor);
    EBM_ASSERT(pTensor->GetExpanded()); // the tensor should have been expanded at startup
-   FloatFast * const aTermScores = pTensor->GetTensorScoresPointer();
+   FloatScore * const aTermScores = pTensor->GetTensorScoresPointer();
    EBM_ASSERT(nullptr != aTermScores);
 
-   Transpose<true>(pTerm, GetCountScores(pBoosterCore->GetCountClasses()), termScoresTensorOut, aTermScores);
+   Transpose<true>(pTerm, pBoosterCore->GetCountScores(), termScoresTensorOut, aTermScores);
 
    LOG_0(Trace_Info, "Exited GetBestTermScores");
    return Error_None;
@@ -502,10 +869,10 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION GetCurrentTermScores(
    Tensor * const pTensor = pBoosterCore->GetCurrentModel()[iTerm];
    EBM_ASSERT(nullptr != pTensor);
    EBM_ASSERT(pTensor->GetExpanded()); // the tensor should have been expanded at startup
-   FloatFast * const aTermScores = pTensor->GetTensorScoresPointer();
+   FloatScore * const aTermScores = pTensor->GetTensorScoresPointer();
    EBM_ASSERT(nullptr != aTermScores);
 
-   Transpose<true>(pTerm, GetCountScores(pBoosterCore->GetCountClasses()), termScoresTensorOut, aTermScores);
+   Transpose<true>(pTerm, pBoosterCore->GetCountScores(), termScoresTensorOut, aTermScores);
 
    LOG_0(Trace_Info, "Exited GetCurrentTermScores");
    return Error_None;
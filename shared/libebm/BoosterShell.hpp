@@ -18,6 +18,7 @@ namespace DEFINED_ZONE_NAME {
 #error DEFINED_ZONE_NAME must be defined
 #endif // DEFINED_ZONE_NAME
 
+class RandomDeterministic;
 class Tensor;
 
 struct BinBase;
@@ -37,6 +38,13 @@ class BoosterShell final {
    BoosterCore * m_pBoosterCore;
    size_t m_iTerm;
 
+   // the term that the caller told us its next GenerateTermUpdate will boost, and the term whose histogram
+   // ApplyTermUpdate has already summed into m_aBoostingFastBinsTemp while it refreshed the gradients.  The
+   // histogram is only usable while the BoosterCore gradients are still at m_iFusedBinsGeneration
+   size_t m_iTermNext;
+   size_t m_iTermFusedBins;
+   size_t m_iFusedBinsGeneration;
+
    Tensor * m_pTermUpdate;
    Tensor * m_pInnerTermUpdate;
 
@@ -50,6 +58,28 @@ class BoosterShell final {
    void * m_aTreeNodesTemp;
    void * m_aSplitPositionsTemp;
 
+   // scratch shells for the extra threads of the BoosterCore thread pool.  These share our BoosterCore pointer
+   // but do not hold a reference to it, and they never have thread shells of their own
+   size_t m_cThreadShells;
+   BoosterShell * m_aThreadShells;
+   RandomDeterministic * m_aInnerBagRngs;
+
+   // private histograms for the extra threads when a single histogram is built by sharding the samples.
+   // We only shard when the inner bags are not already spread across threads, so these never coexist
+   // with m_aThreadShells
+   size_t m_cShardFastBins;
+   BinBase * m_aShardFastBins;
+
+   // one histogram per inner bag, each GetCountBytesFastBins() long, so that a single pass over the samples
+   // can sum every inner bag.  nullptr with fewer than two inner bags or if they would take too much memory
+   BinBase * m_aInnerBagsFastBins;
+
+   // the gradient, hessian, weight and count totals of each inner bag, one fast bin per bag.  Sparse terms start
+   // their default bin from these.  The gradients only change in ApplyTermUpdate, so they are summed at most
+   // once per BoosterCore gradient generation.  nullptr if the training set has no sparse terms
+   BinBase * m_aSparseTotalBins;
+   size_t m_iSparseTotalBinsGeneration;
+
 #ifndef NDEBUG
    const BinBase * m_pDebugBigBinsEnd;
 #endif // NDEBUG
@@ -62,11 +92,15 @@ public:
    void operator delete (void *) = delete; // we only use malloc/free in this library
 
    static constexpr size_t k_illegalTermIndex = size_t { static_cast<size_t>(ptrdiff_t { -1 }) };
+   static constexpr size_t k_illegalGradientGeneration = size_t { static_cast<size_t>(ptrdiff_t { -1 }) };
 
    INLINE_ALWAYS void InitializeUnfailing(BoosterCore * const pBoosterCore) {
       m_handleVerification = k_handleVerificationOk;
       m_pBoosterCore = pBoosterCore;
       m_iTerm = k_illegalTermIndex;
+      m_iTermNext = k_illegalTermIndex;
+      m_iTermFusedBins = k_illegalTermIndex;
+      m_iFusedBinsGeneration = k_illegalGradientGeneration;
       m_pTermUpdate = nullptr;
       m_pInnerTermUpdate = nullptr;
       m_aBoostingFastBinsTemp = nullptr;
@@ -74,11 +108,21 @@ public:
       m_aMulticlassMidwayTemp = nullptr;
       m_aTreeNodesTemp = nullptr;
       m_aSplitPositionsTemp = nullptr;
+      m_cThreadShells = 0;
+      m_aThreadShells = nullptr;
+      m_aInnerBagRngs = nullptr;
+      m_cShardFastBins = 0;
+      m_aShardFastBins = nullptr;
+      m_aInnerBagsFastBins = nullptr;
+      m_aSparseTotalBins = nullptr;
+      m_iSparseTotalBinsGeneration = k_illegalGradientGeneration;
    }
 
    static void Free(BoosterShell * const pBoosterShell);
    static BoosterShell * Create(BoosterCore * const pBoosterCore);
    ErrorEbm FillAllocations();
+   ErrorEbm FillScratchAllocations();
+   void FreeScratchAllocations();
 
    INLINE_ALWAYS static BoosterShell * GetBoosterShellFromHandle(const BoosterHandle boosterHandle) {
       if(nullptr == boosterHandle) {
@@ -113,6 +157,30 @@ public:
       m_iTerm = iTerm;
    }
 
+   INLINE_ALWAYS size_t GetNextTermIndex() {
+      return m_iTermNext;
+   }
+
+   INLINE_ALWAYS void SetNextTermIndex(const size_t iTermNext) {
+      m_iTermNext = iTermNext;
+   }
+
+   INLINE_ALWAYS size_t GetFusedBinsTermIndex() {
+      return m_iTermFusedBins;
+   }
+
+   INLINE_ALWAYS void SetFusedBinsTermIndex(const size_t iTermFusedBins) {
+      m_iTermFusedBins = iTermFusedBins;
+   }
+
+   INLINE_ALWAYS size_t GetFusedBinsGeneration() {
+      return m_iFusedBinsGeneration;
+   }
+
+   INLINE_ALWAYS void SetFusedBinsGeneration(const size_t iFusedBinsGeneration) {
+      m_iFusedBinsGeneration = iFusedBinsGeneration;
+   }
+
    INLINE_ALWAYS Tensor * GetTermUpdate() {
       return m_pTermUpdate;
    }
@@ -135,6 +203,44 @@ public:
       return m_aMulticlassMidwayTemp;
    }
 
+   INLINE_ALWAYS size_t GetCountThreadShells() {
+      return m_cThreadShells;
+   }
+
+   INLINE_ALWAYS BoosterShell * GetThreadShells() {
+      return m_aThreadShells;
+   }
+
+   INLINE_ALWAYS RandomDeterministic * GetInnerBagRngs() {
+      // one per inner bag when we have thread shells, otherwise nullptr
+      return m_aInnerBagRngs;
+   }
+
+   INLINE_ALWAYS size_t GetCountShards() {
+      // our own fast bins are always shard 0
+      return m_cShardFastBins + size_t { 1 };
+   }
+
+   INLINE_ALWAYS BinBase * GetShardFastBins() {
+      return m_aShardFastBins;
+   }
+
+   INLINE_ALWAYS BinBase * GetInnerBagsFastBins() {
+      return m_aInnerBagsFastBins;
+   }
+
+   INLINE_ALWAYS BinBase * GetSparseTotalBins() {
+      return m_aSparseTotalBins;
+   }
+
+   INLINE_ALWAYS size_t GetSparseTotalBinsGeneration() {
+      return m_iSparseTotalBinsGeneration;
+   }
+
+   INLINE_ALWAYS void SetSparseTotalBinsGeneration(const size_t iSparseTotalBinsGeneration) {
+      m_iSparseTotalBinsGeneration = iSparseTotalBinsGeneration;
+   }
+
    template<bool bHessian, size_t cCompilerScores = 1>
    INLINE_ALWAYS TreeNode<bHessian, cCompilerScores> * GetTreeNodesTemp() {
       return static_cast<TreeNode<bHessian, cCompilerScores> *>(m_aTreeNodesTemp);
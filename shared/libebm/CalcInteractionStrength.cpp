@@ -6,7 +6,8 @@
 
 #include <stddef.h> // size_t, ptrdiff_t
 #include <limits> // numeric_limits
-#include <string.h> // memcpy
+#include <string.h> // memcpy, memset
+#include <algorithm> // std::stable_sort
 
 #include "libebm.h" // ErrorEbm
 #include "logging.h" // EBM_ASSERT
@@ -20,6 +21,7 @@
 #include "Bin.hpp" // GetBinSize
 #include "InteractionCore.hpp"
 #include "InteractionShell.hpp"
+#include "ThreadPool.hpp"
 
 namespace DEFINED_ZONE_NAME {
 #ifndef DEFINED_ZONE_NAME
@@ -27,6 +29,7 @@ namespace DEFINED_ZONE_NAME {
 #endif // DEFINED_ZONE_NAME
 
 extern ErrorEbm BinSumsInteraction(BinSumsInteractionBridge * const pBinSumsInteraction);
+extern ErrorEbm BinSumsInteractionPairs(BinSumsInteractionPairsBridge * const pParams);
 
 extern void TensorTotalsBuild(
    const bool bHessian,
@@ -55,6 +58,68 @@ extern double PartitionTwoDimensionalInteraction(
 #endif // NDEBUG
 );
 
+extern ErrorEbm PartitionMultiDimensionalInteraction(
+   InteractionCore * const pInteractionCore,
+   const size_t cRealDimensions,
+   const size_t * const acBins,
+   const InteractionFlags flags,
+   const size_t cSamplesLeafMin,
+   BinBase * aAuxiliaryBinsBase,
+   BinBase * const aBinsBase,
+   double * const pBestGain
+#ifndef NDEBUG
+   , const BinBase * const aDebugCopyBinsBase
+   , const BinBase * const pBinsEndDebug
+#endif // NDEBUG
+);
+
+static double FinishInteractionGain(
+   InteractionCore * const pInteractionCore,
+   const InteractionFlags flags,
+   double bestGain
+) {
+   // the partition functions are templated and created many times, so they leave the normalization to us
+
+   // if totalWeight < 1 then bestGain could overflow to +inf, so do the division first
+   const double totalWeight = static_cast<double>(pInteractionCore->GetDataSetInteraction()->GetWeightTotal());
+   EBM_ASSERT(0 < totalWeight); // if all are zeros we assume there are no weights and use the count
+   bestGain /= totalWeight;
+   if(0 != (static_cast<UInteractionFlags>(flags) & static_cast<UInteractionFlags>(InteractionFlags_EnableNewton))) {
+      bestGain /= pInteractionCore->HessianConstant();
+      bestGain *= pInteractionCore->GainAdjustmentHessianBoosting();
+   } else {
+      bestGain *= pInteractionCore->GainAdjustmentGradientBoosting();
+   }
+   const double gradientConstant = pInteractionCore->GradientConstant();
+   bestGain *= gradientConstant;
+   bestGain *= gradientConstant;
+
+   if(UNLIKELY(/* NaN */ !LIKELY(bestGain <= std::numeric_limits<double>::max()))) {
+      // We simplify our caller's handling by returning -lowest as our error indicator. -lowest will sort to being the
+      // least important item, which is good, but it also signals an overflow without the weirness of NaNs.
+      EBM_ASSERT(std::isnan(bestGain) || std::numeric_limits<double>::infinity() == bestGain);
+      bestGain = k_illegalGainDouble;
+   } else if(UNLIKELY(bestGain < 0)) {
+      // gain can't mathematically be legally negative, but it can be here in the following situations:
+      //   1) for impure interaction gain we subtract the parent partial gain, and there can be floating point
+      //      noise that makes this slightly negative
+      //   2) for impure interaction gain we subtract the parent partial gain, but if there were no legal cuts
+      //      then the partial gain before subtracting the parent partial gain was zero and we then get a 
+      //      substantially negative value.  In this case we should not have subtracted the parent partial gain
+      //      since we had never even calculated the orthant partial gains, but we handle this scenario 
+      //      here instead of inside the templated function.
+
+      EBM_ASSERT(!std::isnan(bestGain));
+      EBM_ASSERT(std::numeric_limits<double>::infinity() != bestGain);
+      bestGain = std::numeric_limits<double>::lowest() <= bestGain ? 0.0 : k_illegalGainDouble;
+   } else {
+      EBM_ASSERT(!std::isnan(bestGain));
+      EBM_ASSERT(!std::isinf(bestGain));
+   }
+
+   return bestGain;
+}
+
 // there is a race condition for decrementing this variable, but if a thread loses the 
 // race then it just doesn't get decremented as quickly, which we can live with
 static int g_cLogCalcInteractionStrength = 10;
@@ -264,6 +329,8 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CalcInteractionStrength(
       return Error_None;
    }
 
+   binSums.m_cBitPackLanes = pDataSet->GetCountBitPackLanes();
+
    const size_t cScores = GetCountScores(cClasses);
 
    EBM_ASSERT(!IsOverflowBinSize<FloatFast>(pInteractionCore->IsHessian(), cScores)); // checked in CreateInteractionDetector
@@ -302,7 +369,11 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CalcInteractionStrength(
       return error;
    }
 
-   static constexpr size_t cAuxillaryBinsForSplitting = 4;
+   // the sweep needs one auxiliary bin per orthant.  Every dimension has at least 2 bins, so 2^N cannot exceed
+   // cTensorBins, which we already know fits in memory
+   EBM_ASSERT(cDimensions < k_cBitsForSizeT);
+   const size_t cAuxillaryBinsForSplitting = size_t { 1 } << cDimensions;
+   EBM_ASSERT(cAuxillaryBinsForSplitting <= cTensorBins);
    const size_t cAuxillaryBins = EbmMax(cAuxillaryBinsForBuildFastTotals, cAuxillaryBinsForSplitting);
    
    if(IsAddError(cTensorBins, cAuxillaryBins)) {
@@ -328,9 +399,7 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CalcInteractionStrength(
    const auto * const pDebugBigBinsEnd = IndexBin(aBigBins, cBytesPerBigBin * cTotalBigBins);
 #endif // NDEBUG
 
-   // TODO: put this into it's own function that converts our fast floats to big floats
-   EBM_ASSERT(cBytesPerBigBin == cBytesPerFastBin);
-   memcpy(aBigBins, aFastBins, cBytesPerFastBin * cTensorBins);
+   ConvertFastBinsToBigBins(pInteractionCore->IsHessian(), cScores, aFastBins, aBigBins, cTensorBins);
 
 
 
@@ -368,60 +437,49 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CalcInteractionStrength(
 #endif // NDEBUG
    );
 
-   if(2 == cDimensions) {
+   if(2 <= cDimensions) {
       LOG_0(Trace_Verbose, "CalcInteractionStrength Starting bin sweep loop");
 
-      double bestGain = PartitionTwoDimensionalInteraction(
-         pInteractionCore,
-         cDimensions,
-         binSums.m_acBins,
-         flags,
-         cSamplesLeafMin,
-         aAuxiliaryBins,
-         aBigBins
+      double bestGain;
+      if(2 == cDimensions) {
+         bestGain = PartitionTwoDimensionalInteraction(
+            pInteractionCore,
+            cDimensions,
+            binSums.m_acBins,
+            flags,
+            cSamplesLeafMin,
+            aAuxiliaryBins,
+            aBigBins
 #ifndef NDEBUG
-         , aDebugCopyBins
-         , pDebugBigBinsEnd
+            , aDebugCopyBins
+            , pDebugBigBinsEnd
 #endif // NDEBUG
-      );
-
-      // if totalWeight < 1 then bestGain could overflow to +inf, so do the division first
-      const double totalWeight = static_cast<double>(pDataSet->GetWeightTotal());
-      EBM_ASSERT(0 < totalWeight); // if all are zeros we assume there are no weights and use the count
-      bestGain /= totalWeight;
-      if(0 != (static_cast<UInteractionFlags>(flags) & static_cast<UInteractionFlags>(InteractionFlags_EnableNewton))) {
-         bestGain /= pInteractionCore->HessianConstant();
-         bestGain *= pInteractionCore->GainAdjustmentHessianBoosting();
+         );
       } else {
-         bestGain *= pInteractionCore->GainAdjustmentGradientBoosting();
-      }
-      const double gradientConstant = pInteractionCore->GradientConstant();
-      bestGain *= gradientConstant;
-      bestGain *= gradientConstant;
-
-      if(UNLIKELY(/* NaN */ !LIKELY(bestGain <= std::numeric_limits<double>::max()))) {
-         // We simplify our caller's handling by returning -lowest as our error indicator. -lowest will sort to being the
-         // least important item, which is good, but it also signals an overflow without the weirness of NaNs.
-         EBM_ASSERT(std::isnan(bestGain) || std::numeric_limits<double>::infinity() == bestGain);
-         bestGain = k_illegalGainDouble;
-      } else if(UNLIKELY(bestGain < 0)) {
-         // gain can't mathematically be legally negative, but it can be here in the following situations:
-         //   1) for impure interaction gain we subtract the parent partial gain, and there can be floating point
-         //      noise that makes this slightly negative
-         //   2) for impure interaction gain we subtract the parent partial gain, but if there were no legal cuts
-         //      then the partial gain before subtracting the parent partial gain was zero and we then get a 
-         //      substantially negative value.  In this case we should not have subtracted the parent partial gain
-         //      since we had never even calculated the 4 quadrant partial gain, but we handle this scenario 
-         //      here instead of inside the templated function.
-
-         EBM_ASSERT(!std::isnan(bestGain));
-         EBM_ASSERT(std::numeric_limits<double>::infinity() != bestGain);
-         bestGain = std::numeric_limits<double>::lowest() <= bestGain ? 0.0 : k_illegalGainDouble;
-      } else {
-         EBM_ASSERT(!std::isnan(bestGain));
-         EBM_ASSERT(!std::isinf(bestGain));
+         error = PartitionMultiDimensionalInteraction(
+            pInteractionCore,
+            cDimensions,
+            binSums.m_acBins,
+            flags,
+            cSamplesLeafMin,
+            aAuxiliaryBins,
+            aBigBins,
+            &bestGain
+#ifndef NDEBUG
+            , aDebugCopyBins
+            , pDebugBigBinsEnd
+#endif // NDEBUG
+         );
+         if(Error_None != error) {
+#ifndef NDEBUG
+            free(aDebugCopyBins);
+#endif // NDEBUG
+            return error;
+         }
       }
 
+      bestGain = FinishInteractionGain(pInteractionCore, flags, bestGain);
+
       if(nullptr != avgInteractionStrengthOut) {
          *avgInteractionStrengthOut = bestGain;
       }
@@ -437,12 +495,10 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CalcInteractionStrength(
          bestGain
       );
    } else {
-      LOG_0(Trace_Warning, "WARNING CalcInteractionStrength We only support pairs for interaction detection currently");
+      LOG_0(Trace_Warning, "WARNING CalcInteractionStrength interaction detection requires at least 2 dimensions");
 
-      // TODO: handle interaction detection for higher dimensions
-
-      // for now, just return any interactions that have other than 2 dimensions as k_illegalGainDouble, 
-      // which means they won't be considered but indicates they were not handled
+      // a single feature has no interaction, so return k_illegalGainDouble, 
+      // which means it won't be considered but indicates it was not handled
    }
 
 #ifndef NDEBUG
@@ -452,4 +508,442 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CalcInteractionStrength(
    return Error_None;
 }
 
+struct PairWork {
+   size_t m_iPair;
+   size_t m_iFeatureShared;
+   size_t m_iFeatureOther;
+};
+
+struct CalcInteractionStrengthsContext {
+   InteractionCore * m_pInteractionCore;
+   InteractionFlags m_flags;
+   size_t m_cSamplesLeafMin;
+   const PairWork * m_aPairWork;
+   // task iTask bins the pairs from m_aiTaskStarts[iTask] to m_aiTaskStarts[iTask + 1], which share a feature
+   const size_t * m_aiTaskStarts;
+   double * m_aStrengthsOut;
+   ErrorEbm * m_aErrors;
+};
+
+static ErrorEbm CalcInteractionStrengthsGroup(
+   const CalcInteractionStrengthsContext * const pContext,
+   const PairWork * const aPairWork,
+   const size_t cPairs
+) {
+   EBM_ASSERT(1 <= cPairs);
+   EBM_ASSERT(cPairs <= k_cPairsPerBinSumsPassMax);
+
+   InteractionCore * const pInteractionCore = pContext->m_pInteractionCore;
+   const DataSetInteraction * const pDataSet = pInteractionCore->GetDataSetInteraction();
+   const FeatureInteraction * const aFeatures = pInteractionCore->GetFeatures();
+
+   const bool bHessian = pInteractionCore->IsHessian();
+   const size_t cScores = GetCountScores(pInteractionCore->GetCountClasses());
+   const size_t cBytesPerFastBin = GetBinSize<FloatFast>(bHessian, cScores);
+   const size_t cBytesPerBigBin = GetBinSize<FloatBig>(bHessian, cScores);
+
+   BinSumsInteractionPairsBridge binSums;
+   binSums.m_bHessian = bHessian ? EBM_TRUE : EBM_FALSE;
+   binSums.m_cScores = cScores;
+   binSums.m_cSamples = pDataSet->GetCountSamples();
+   binSums.m_aGradientsAndHessians = pDataSet->GetGradientsAndHessiansPointer();
+   binSums.m_aWeights = pDataSet->GetWeights();
+   binSums.m_cPairs = cPairs;
+   binSums.m_cBitPackLanes = pDataSet->GetCountBitPackLanes();
+
+   const size_t iFeatureShared = aPairWork[0].m_iFeatureShared;
+   const FeatureInteraction * const pFeatureShared = &aFeatures[iFeatureShared];
+   binSums.m_acBins[0] = pFeatureShared->GetCountBins();
+   binSums.m_acItemsPerBitPack[0] = static_cast<size_t>(pFeatureShared->GetFeatureBitPack());
+   binSums.m_aaPacked[0] = pDataSet->GetInputDataPointer(iFeatureShared);
+
+   // the caller checked that every pair's tensor, and the sum of all of them, fits in memory
+   size_t cFastBinsTotal = 0;
+   size_t cBigBinsMax = 0;
+   size_t iPair = 0;
+   do {
+      EBM_ASSERT(iFeatureShared == aPairWork[iPair].m_iFeatureShared);
+      const size_t iFeatureOther = aPairWork[iPair].m_iFeatureOther;
+      const FeatureInteraction * const pFeatureOther = &aFeatures[iFeatureOther];
+      binSums.m_acBins[1 + iPair] = pFeatureOther->GetCountBins();
+      binSums.m_acItemsPerBitPack[1 + iPair] = static_cast<size_t>(pFeatureOther->GetFeatureBitPack());
+      binSums.m_aaPacked[1 + iPair] = pDataSet->GetInputDataPointer(iFeatureOther);
+
+      const size_t cTensorBins = binSums.m_acBins[0] * binSums.m_acBins[1 + iPair];
+      cFastBinsTotal += cTensorBins;
+      // TensorTotalsBuild needs 1 + cBins0 auxiliary bins for pairs and the sweep needs 4
+      const size_t cAuxillaryBins = EbmMax(size_t { 1 } + binSums.m_acBins[0], size_t { 4 });
+      cBigBinsMax = EbmMax(cBigBinsMax, cTensorBins + cAuxillaryBins);
+      ++iPair;
+   } while(cPairs != iPair);
+
+   BinBase * const aFastBinsAll = static_cast<BinBase *>(malloc(cBytesPerFastBin * cFastBinsTotal));
+   if(nullptr == aFastBinsAll) {
+      LOG_0(Trace_Warning, "WARNING CalcInteractionStrengthsGroup nullptr == aFastBinsAll");
+      return Error_OutOfMemory;
+   }
+   BinBase * const aBigBins = static_cast<BinBase *>(malloc(cBytesPerBigBin * cBigBinsMax));
+   if(nullptr == aBigBins) {
+      LOG_0(Trace_Warning, "WARNING CalcInteractionStrengthsGroup nullptr == aBigBins");
+      free(aFastBinsAll);
+      return Error_OutOfMemory;
+   }
+   aFastBinsAll->ZeroMem(cBytesPerFastBin, cFastBinsTotal);
+
+   BinBase * aFastBinsNext = aFastBinsAll;
+   iPair = 0;
+   do {
+      const size_t cTensorBins = binSums.m_acBins[0] * binSums.m_acBins[1 + iPair];
+      binSums.m_aaFastBins[iPair] = aFastBinsNext;
+      aFastBinsNext = IndexBin(aFastBinsNext, cBytesPerFastBin * cTensorBins);
+#ifndef NDEBUG
+      binSums.m_apDebugFastBinsEnd[iPair] = aFastBinsNext;
+#endif // NDEBUG
+      ++iPair;
+   } while(cPairs != iPair);
+
+   ErrorEbm error = BinSumsInteractionPairs(&binSums);
+   if(Error_None != error) {
+      free(aBigBins);
+      free(aFastBinsAll);
+      return error;
+   }
+
+   iPair = 0;
+   do {
+      size_t acBins[2];
+      acBins[0] = binSums.m_acBins[0];
+      acBins[1] = binSums.m_acBins[1 + iPair];
+      const size_t cTensorBins = acBins[0] * acBins[1];
+      const size_t cAuxillaryBins = EbmMax(size_t { 1 } + acBins[0], size_t { 4 });
+
+#ifndef NDEBUG
+      const auto * const pDebugBigBinsEnd = IndexBin(aBigBins, cBytesPerBigBin * (cTensorBins + cAuxillaryBins));
+#endif // NDEBUG
+
+      ConvertFastBinsToBigBins(bHessian, cScores, binSums.m_aaFastBins[iPair], aBigBins, cTensorBins);
+
+#ifndef NDEBUG
+      // if we can't allocate the debug copy, don't fail.. just stop checking
+      BinBase * const aDebugCopyBins = static_cast<BinBase *>(malloc(cBytesPerBigBin * cTensorBins));
+      if(nullptr != aDebugCopyBins) {
+         memcpy(aDebugCopyBins, aBigBins, cBytesPerBigBin * cTensorBins);
+      }
+#endif // NDEBUG
+
+      BinBase * const aAuxiliaryBins = IndexBin(aBigBins, cBytesPerBigBin * cTensorBins);
+      aAuxiliaryBins->ZeroMem(cBytesPerBigBin, cAuxillaryBins);
+
+      TensorTotalsBuild(
+         bHessian,
+         cScores,
+         size_t { 2 },
+         acBins,
+         aAuxiliaryBins,
+         aBigBins
+#ifndef NDEBUG
+         , aDebugCopyBins
+         , pDebugBigBinsEnd
+#endif // NDEBUG
+      );
+
+      const double bestGain = PartitionTwoDimensionalInteraction(
+         pInteractionCore,
+         size_t { 2 },
+         acBins,
+         pContext->m_flags,
+         pContext->m_cSamplesLeafMin,
+         aAuxiliaryBins,
+         aBigBins
+#ifndef NDEBUG
+         , aDebugCopyBins
+         , pDebugBigBinsEnd
+#endif // NDEBUG
+      );
+
+#ifndef NDEBUG
+      free(aDebugCopyBins);
+#endif // NDEBUG
+
+      pContext->m_aStrengthsOut[aPairWork[iPair].m_iPair] = 
+         FinishInteractionGain(pInteractionCore, pContext->m_flags, bestGain);
+
+      ++iPair;
+   } while(cPairs != iPair);
+
+   free(aBigBins);
+   free(aFastBinsAll);
+   return Error_None;
+}
+
+static void CalcInteractionStrengthsTask(void * const pContextVoid, const size_t iTask) {
+   const CalcInteractionStrengthsContext * const pContext = 
+      static_cast<const CalcInteractionStrengthsContext *>(pContextVoid);
+   const size_t iStart = pContext->m_aiTaskStarts[iTask];
+   const size_t iEnd = pContext->m_aiTaskStarts[iTask + 1];
+   pContext->m_aErrors[iTask] = CalcInteractionStrengthsGroup(pContext, &pContext->m_aPairWork[iStart], iEnd - iStart);
+}
+
+EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CalcInteractionStrengths(
+   InteractionHandle interactionHandle,
+   IntEbm countPairs,
+   const IntEbm * pairFeatureIndexes,
+   InteractionFlags flags,
+   IntEbm maxCardinality,
+   IntEbm minSamplesLeaf,
+   double * avgInteractionStrengthsOut
+) {
+   LOG_N(
+      Trace_Info,
+      "Entered CalcInteractionStrengths: "
+      "interactionHandle=%p, "
+      "countPairs=%" IntEbmPrintf ", "
+      "pairFeatureIndexes=%p, "
+      "flags=0x%" UInteractionFlagsPrintf ", "
+      "maxCardinality=%" IntEbmPrintf ", "
+      "minSamplesLeaf=%" IntEbmPrintf ", "
+      "avgInteractionStrengthsOut=%p"
+      ,
+      static_cast<void *>(interactionHandle),
+      countPairs,
+      static_cast<const void *>(pairFeatureIndexes),
+      static_cast<UInteractionFlags>(flags), // signed to unsigned conversion is defined behavior in C++
+      maxCardinality,
+      minSamplesLeaf,
+      static_cast<void *>(avgInteractionStrengthsOut)
+   );
+
+   InteractionShell * const pInteractionShell = InteractionShell::GetInteractionShellFromHandle(interactionHandle);
+   if(nullptr == pInteractionShell) {
+      // already logged
+      return Error_IllegalParamVal;
+   }
+
+   if(0 != (static_cast<UInteractionFlags>(flags) & ~(
+      static_cast<UInteractionFlags>(InteractionFlags_Pure)
+   ))) {
+      LOG_0(Trace_Error, "ERROR CalcInteractionStrengths flags contains unknown flags. Ignoring extras.");
+   }
+
+   size_t cCardinalityMax = std::numeric_limits<size_t>::max(); // set off by default
+   if(IntEbm { 0 } <= maxCardinality) {
+      if(IntEbm { 0 } != maxCardinality) {
+         if(!IsConvertError<size_t>(maxCardinality)) {
+            cCardinalityMax = static_cast<size_t>(maxCardinality);
+         }
+      }
+   } else {
+      LOG_0(Trace_Warning, "WARNING CalcInteractionStrengths maxCardinality can't be less than 0. Turning off.");
+   }
+
+   size_t cSamplesLeafMin = size_t { 1 }; // this is the min value
+   if(IntEbm { 1 } <= minSamplesLeaf) {
+      cSamplesLeafMin = static_cast<size_t>(minSamplesLeaf);
+      if(IsConvertError<size_t>(minSamplesLeaf)) {
+         cSamplesLeafMin = std::numeric_limits<size_t>::max();
+      }
+   } else {
+      LOG_0(Trace_Warning, "WARNING CalcInteractionStrengths minSamplesLeaf can't be less than 1. Adjusting to 1.");
+   }
+
+   if(countPairs <= IntEbm { 0 }) {
+      if(IntEbm { 0 } == countPairs) {
+         LOG_0(Trace_Info, "INFO CalcInteractionStrengths empty pair list");
+         return Error_None;
+      }
+      LOG_0(Trace_Error, "ERROR CalcInteractionStrengths countPairs must be positive");
+      return Error_IllegalParamVal;
+   }
+   if(IsConvertError<size_t>(countPairs) || IsMultiplyError(size_t { 2 }, static_cast<size_t>(countPairs))) {
+      LOG_0(Trace_Warning, "WARNING CalcInteractionStrengths countPairs too large and would cause out of memory condition");
+      return Error_OutOfMemory;
+   }
+   const size_t cPairs = static_cast<size_t>(countPairs);
+   if(nullptr == pairFeatureIndexes) {
+      LOG_0(Trace_Error, "ERROR CalcInteractionStrengths pairFeatureIndexes cannot be nullptr if 0 < countPairs");
+      return Error_IllegalParamVal;
+   }
+   if(nullptr == avgInteractionStrengthsOut) {
+      LOG_0(Trace_Error, "ERROR CalcInteractionStrengths avgInteractionStrengthsOut cannot be nullptr if 0 < countPairs");
+      return Error_IllegalParamVal;
+   }
+
+   InteractionCore * const pInteractionCore = pInteractionShell->GetInteractionCore();
+   const FeatureInteraction * const aFeatures = pInteractionCore->GetFeatures();
+   const size_t cFeatures = pInteractionCore->GetCountFeatures();
+
+   size_t iPair = 0;
+   do {
+      const IntEbm indexFeature0 = pairFeatureIndexes[iPair << 1];
+      const IntEbm indexFeature1 = pairFeatureIndexes[(iPair << 1) + 1];
+      if(indexFeature0 < IntEbm { 0 } || indexFeature1 < IntEbm { 0 }) {
+         LOG_0(Trace_Error, "ERROR CalcInteractionStrengths pairFeatureIndexes value cannot be negative");
+         return Error_IllegalParamVal;
+      }
+      if(static_cast<IntEbm>(cFeatures) <= indexFeature0 || static_cast<IntEbm>(cFeatures) <= indexFeature1) {
+         LOG_0(Trace_Error, "ERROR CalcInteractionStrengths pairFeatureIndexes value must be less than the number of features");
+         return Error_IllegalParamVal;
+      }
+      avgInteractionStrengthsOut[iPair] = 0.0;
+      ++iPair;
+   } while(cPairs != iPair);
+
+   const ptrdiff_t cClasses = pInteractionCore->GetCountClasses();
+   if(ptrdiff_t { 0 } == cClasses || ptrdiff_t { 1 } == cClasses) {
+      LOG_0(Trace_Info, "INFO CalcInteractionStrengths target with 1 class perfectly predicts the target");
+      return Error_None;
+   }
+
+   const DataSetInteraction * const pDataSet = pInteractionCore->GetDataSetInteraction();
+   EBM_ASSERT(nullptr != pDataSet);
+   if(size_t { 0 } == pDataSet->GetCountSamples()) {
+      LOG_0(Trace_Info, "INFO CalcInteractionStrengths zero samples");
+      return Error_None;
+   }
+
+   const bool bHessian = pInteractionCore->IsHessian();
+   const size_t cScores = GetCountScores(cClasses);
+   const size_t cBytesPerFastBin = GetBinSize<FloatFast>(bHessian, cScores);
+   const size_t cBytesPerBigBin = GetBinSize<FloatBig>(bHessian, cScores);
+   const size_t cBytesPerBinMax = EbmMax(cBytesPerFastBin, cBytesPerBigBin);
+
+   // One pass over the gradients can bin every pair that shares a feature, so each pair is assigned to whichever
+   // of its features appears in the most pairs.  When screening all pairs, this groups them by their lower feature.
+   if(IsMultiplyError(sizeof(size_t), cFeatures) || IsMultiplyError(sizeof(PairWork), cPairs) ||
+      IsAddError(cPairs, size_t { 1 }) || IsMultiplyError(sizeof(size_t), cPairs + size_t { 1 })) 
+   {
+      LOG_0(Trace_Warning, "WARNING CalcInteractionStrengths IsMultiplyError(sizeof(PairWork), cPairs)");
+      return Error_OutOfMemory;
+   }
+   size_t * const acPairsPerFeature = static_cast<size_t *>(malloc(sizeof(size_t) * cFeatures));
+   if(nullptr == acPairsPerFeature) {
+      LOG_0(Trace_Warning, "WARNING CalcInteractionStrengths nullptr == acPairsPerFeature");
+      return Error_OutOfMemory;
+   }
+   memset(acPairsPerFeature, 0, sizeof(size_t) * cFeatures);
+
+   iPair = 0;
+   do {
+      const size_t iFeature0 = static_cast<size_t>(pairFeatureIndexes[iPair << 1]);
+      const size_t iFeature1 = static_cast<size_t>(pairFeatureIndexes[(iPair << 1) + 1]);
+      ++acPairsPerFeature[iFeature0];
+      if(iFeature0 != iFeature1) {
+         ++acPairsPerFeature[iFeature1];
+      }
+      ++iPair;
+   } while(cPairs != iPair);
+
+   PairWork * const aPairWork = static_cast<PairWork *>(malloc(sizeof(PairWork) * cPairs));
+   if(nullptr == aPairWork) {
+      LOG_0(Trace_Warning, "WARNING CalcInteractionStrengths nullptr == aPairWork");
+      free(acPairsPerFeature);
+      return Error_OutOfMemory;
+   }
+
+   // pairs with a useless feature or that exceed maxCardinality keep their strength of 0.0 and are not binned
+   size_t cPairWork = 0;
+   iPair = 0;
+   do {
+      size_t iFeature0 = static_cast<size_t>(pairFeatureIndexes[iPair << 1]);
+      size_t iFeature1 = static_cast<size_t>(pairFeatureIndexes[(iPair << 1) + 1]);
+      const size_t cBins0 = aFeatures[iFeature0].GetCountBins();
+      const size_t cBins1 = aFeatures[iFeature1].GetCountBins();
+      if(size_t { 1 } < cBins0 && size_t { 1 } < cBins1 && !IsMultiplyError(cBins0, cBins1) &&
+         cBins0 * cBins1 <= cCardinalityMax)
+      {
+         const size_t cTensorBins = cBins0 * cBins1;
+         // a group bins up to k_cPairsPerBinSumsPassMax of these tensors at once, plus the auxiliary bins
+         if(IsAddError(cTensorBins, cBins0, cBins1, size_t { 4 }) ||
+            IsMultiplyError(cBytesPerBinMax, cTensorBins + cBins0 + cBins1 + size_t { 4 }, k_cPairsPerBinSumsPassMax))
+         {
+            LOG_0(Trace_Warning, "WARNING CalcInteractionStrengths pair tensor too large");
+            free(aPairWork);
+            free(acPairsPerFeature);
+            return Error_OutOfMemory;
+         }
+         if(acPairsPerFeature[iFeature0] < acPairsPerFeature[iFeature1] ||
+            (acPairsPerFeature[iFeature0] == acPairsPerFeature[iFeature1] && iFeature1 < iFeature0))
+         {
+            const size_t iFeatureSwap = iFeature0;
+            iFeature0 = iFeature1;
+            iFeature1 = iFeatureSwap;
+         }
+         aPairWork[cPairWork].m_iPair = iPair;
+         aPairWork[cPairWork].m_iFeatureShared = iFeature0;
+         aPairWork[cPairWork].m_iFeatureOther = iFeature1;
+         ++cPairWork;
+      }
+      ++iPair;
+   } while(cPairs != iPair);
+   free(acPairsPerFeature);
+
+   if(size_t { 0 } == cPairWork) {
+      LOG_0(Trace_Info, "INFO CalcInteractionStrengths no pairs with useful features");
+      free(aPairWork);
+      return Error_None;
+   }
+
+   // stable sort keeps the pairs within each group in the order given, which keeps the results deterministic
+   std::stable_sort(aPairWork, aPairWork + cPairWork, [](const PairWork & lhs, const PairWork & rhs) {
+      return lhs.m_iFeatureShared < rhs.m_iFeatureShared;
+   });
+
+   size_t * const aiTaskStarts = static_cast<size_t *>(malloc(sizeof(size_t) * (cPairWork + size_t { 1 })));
+   if(nullptr == aiTaskStarts) {
+      LOG_0(Trace_Warning, "WARNING CalcInteractionStrengths nullptr == aiTaskStarts");
+      free(aPairWork);
+      return Error_OutOfMemory;
+   }
+   size_t cTasks = 0;
+   size_t iPairWork = 0;
+   do {
+      aiTaskStarts[cTasks] = iPairWork;
+      ++cTasks;
+      const size_t iFeatureShared = aPairWork[iPairWork].m_iFeatureShared;
+      size_t cGroup = 0;
+      do {
+         ++iPairWork;
+         ++cGroup;
+      } while(cPairWork != iPairWork && k_cPairsPerBinSumsPassMax != cGroup &&
+         iFeatureShared == aPairWork[iPairWork].m_iFeatureShared);
+   } while(cPairWork != iPairWork);
+   aiTaskStarts[cTasks] = cPairWork;
+
+   ErrorEbm * const aErrors = static_cast<ErrorEbm *>(malloc(sizeof(ErrorEbm) * cTasks));
+   if(nullptr == aErrors) {
+      LOG_0(Trace_Warning, "WARNING CalcInteractionStrengths nullptr == aErrors");
+      free(aiTaskStarts);
+      free(aPairWork);
+      return Error_OutOfMemory;
+   }
+
+   CalcInteractionStrengthsContext context;
+   context.m_pInteractionCore = pInteractionCore;
+   context.m_flags = flags;
+   context.m_cSamplesLeafMin = cSamplesLeafMin;
+   context.m_aPairWork = aPairWork;
+   context.m_aiTaskStarts = aiTaskStarts;
+   context.m_aStrengthsOut = avgInteractionStrengthsOut;
+   context.m_aErrors = aErrors;
+
+   pInteractionCore->GetThreadPool()->Run(cTasks, CalcInteractionStrengthsTask, &context);
+
+   ErrorEbm error = Error_None;
+   size_t iTask = 0;
+   do {
+      if(Error_None != aErrors[iTask]) {
+         error = aErrors[iTask];
+         break;
+      }
+      ++iTask;
+   } while(cTasks != iTask);
+
+   free(aErrors);
+   free(aiTaskStarts);
+   free(aPairWork);
+
+   LOG_0(Trace_Info, "Exited CalcInteractionStrengths");
+   return error;
+}
+
 } // DEFINED_ZONE_NAME
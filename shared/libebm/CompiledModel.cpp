@@ -0,0 +1,728 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "precompiled_header_cpp.hpp"
+
+#include <stdlib.h> // malloc, free
+#include <stddef.h> // size_t, ptrdiff_t
+#include <string.h> // memcpy
+#include <limits> // numeric_limits
+#include <cmath> // std::isnan
+
+#include "libebm.h" // EBM_API_BODY
+#include "logging.h" // EBM_ASSERT
+#include "common_c.h" // UNPREDICTABLE
+#include "zones.h"
+
+#include "common_cpp.hpp" // IsConvertError
+#include "ebm_internal.hpp" // IsMultiplyError
+
+#include "CompiledModel.hpp"
+
+namespace DEFINED_ZONE_NAME {
+#ifndef DEFINED_ZONE_NAME
+#error DEFINED_ZONE_NAME must be defined
+#endif // DEFINED_ZONE_NAME
+
+CompiledModel::~CompiledModel() {
+   free(m_aBinnings);
+   free(m_aCuts);
+   free(m_aTerms);
+   free(m_aTermBinnings);
+   free(m_aTermStrides);
+   free(m_aTermScores);
+   free(m_aIntercept);
+}
+
+void CompiledModel::Free(CompiledModel * const pCompiledModel) {
+   LOG_0(Trace_Info, "Entered CompiledModel::Free");
+   if(nullptr != pCompiledModel) {
+      // simple check to make use after free errors less likely
+      pCompiledModel->m_handleVerification = k_handleVerificationFreed;
+      delete pCompiledModel;
+   }
+   LOG_0(Trace_Info, "Exited CompiledModel::Free");
+}
+
+ErrorEbm CompiledModel::Create(
+   const size_t cColumns,
+   const size_t cBinnings,
+   const IntEbm * const aBinningColumns,
+   const IntEbm * const aBinningCountBins,
+   const IntEbm * const aBinningCountCuts,
+   const double * const aCuts,
+   const size_t cScores,
+   const double * const aIntercept,
+   const size_t cTerms,
+   const IntEbm * const aTermDimensionCounts,
+   const IntEbm * const aTermBinningIndexes,
+   const double * const aTermScores,
+   CompiledModel ** const ppCompiledModelOut
+) {
+   LOG_0(Trace_Info, "Entered CompiledModel::Create");
+
+   EBM_ASSERT(nullptr != ppCompiledModelOut);
+   EBM_ASSERT(nullptr == *ppCompiledModelOut);
+   EBM_ASSERT(size_t { 1 } <= cScores);
+
+   ErrorEbm error;
+
+   CompiledModel * pCompiledModel;
+   try {
+      pCompiledModel = new CompiledModel();
+   } catch(const std::bad_alloc &) {
+      LOG_0(Trace_Warning, "WARNING CompiledModel::Create Out of memory allocating CompiledModel");
+      return Error_OutOfMemory;
+   } catch(...) {
+      LOG_0(Trace_Warning, "WARNING CompiledModel::Create Unknown error");
+      return Error_UnexpectedInternal;
+   }
+   if(nullptr == pCompiledModel) {
+      // this should be impossible since bad_alloc should have been thrown, but let's be untrusting
+      LOG_0(Trace_Warning, "WARNING CompiledModel::Create nullptr == pCompiledModel");
+      return Error_OutOfMemory;
+   }
+   // give ownership of our object back to the caller, even if there is a failure
+   *ppCompiledModelOut = pCompiledModel;
+
+   pCompiledModel->m_cColumns = cColumns;
+   pCompiledModel->m_cScores = cScores;
+
+   pCompiledModel->m_aIntercept = static_cast<double *>(malloc(sizeof(double) * cScores));
+   if(nullptr == pCompiledModel->m_aIntercept) {
+      LOG_0(Trace_Warning, "WARNING CompiledModel::Create nullptr == m_aIntercept");
+      return Error_OutOfMemory;
+   }
+   for(size_t iScore = 0; iScore < cScores; ++iScore) {
+      pCompiledModel->m_aIntercept[iScore] = nullptr == aIntercept ? 0.0 : aIntercept[iScore];
+   }
+
+   size_t cCutsTotal = 0;
+   if(size_t { 0 } != cBinnings) {
+      if(nullptr == aBinningColumns || nullptr == aBinningCountBins || nullptr == aBinningCountCuts) {
+         LOG_0(Trace_Error, "ERROR CompiledModel::Create binning arrays cannot be null if 0 < countBinnings");
+         return Error_IllegalParamVal;
+      }
+      if(IsMultiplyError(sizeof(CompiledBinning), cBinnings)) {
+         LOG_0(Trace_Warning, "WARNING CompiledModel::Create IsMultiplyError(sizeof(CompiledBinning), cBinnings)");
+         return Error_OutOfMemory;
+      }
+      CompiledBinning * const aBinnings = static_cast<CompiledBinning *>(malloc(sizeof(CompiledBinning) * cBinnings));
+      if(nullptr == aBinnings) {
+         LOG_0(Trace_Warning, "WARNING CompiledModel::Create nullptr == aBinnings");
+         return Error_OutOfMemory;
+      }
+      pCompiledModel->m_aBinnings = aBinnings;
+      pCompiledModel->m_cBinnings = cBinnings;
+
+      for(size_t iBinning = 0; iBinning < cBinnings; ++iBinning) {
+         CompiledBinning * const pBinning = &aBinnings[iBinning];
+
+         const IntEbm indexColumn = aBinningColumns[iBinning];
+         if(indexColumn < IntEbm { 0 } || IsConvertError<size_t>(indexColumn) ||
+            cColumns <= static_cast<size_t>(indexColumn))
+         {
+            LOG_0(Trace_Error, "ERROR CompiledModel::Create binningColumns value out of range");
+            return Error_IllegalParamVal;
+         }
+         pBinning->m_iColumn = static_cast<size_t>(indexColumn);
+
+         const IntEbm countBins = aBinningCountBins[iBinning];
+         if(countBins <= IntEbm { 0 } || IsConvertError<size_t>(countBins)) {
+            LOG_0(Trace_Error, "ERROR CompiledModel::Create binningCountBins must be positive");
+            return Error_IllegalParamVal;
+         }
+         pBinning->m_cBins = static_cast<size_t>(countBins);
+
+         const IntEbm countCuts = aBinningCountCuts[iBinning];
+         if(countCuts < IntEbm { 0 }) {
+            pBinning->m_bPreBinned = true;
+            pBinning->m_cCuts = 0;
+         } else {
+            if(IsConvertError<size_t>(countCuts)) {
+               LOG_0(Trace_Error, "ERROR CompiledModel::Create IsConvertError<size_t>(countCuts)");
+               return Error_IllegalParamVal;
+            }
+            const size_t cCuts = static_cast<size_t>(countCuts);
+            // bin 0 is missing, and the bins from 1 to cCuts + 1 are the normal ones.  Any extra bins (typically
+            // the unknown bin) are allowed but never selected for continuous features
+            if(pBinning->m_cBins - size_t { 1 } <= cCuts) {
+               LOG_0(Trace_Error, "ERROR CompiledModel::Create binningCountBins must be at least binningCountCuts + 2");
+               return Error_IllegalParamVal;
+            }
+            pBinning->m_bPreBinned = false;
+            pBinning->m_cCuts = cCuts;
+            if(IsAddError(cCutsTotal, cCuts)) {
+               LOG_0(Trace_Warning, "WARNING CompiledModel::Create IsAddError(cCutsTotal, cCuts)");
+               return Error_OutOfMemory;
+            }
+            cCutsTotal += cCuts;
+         }
+         pBinning->m_aCuts = nullptr;
+      }
+
+      if(size_t { 0 } != cCutsTotal) {
+         if(nullptr == aCuts) {
+            LOG_0(Trace_Error, "ERROR CompiledModel::Create cuts cannot be null if there are cuts");
+            return Error_IllegalParamVal;
+         }
+         if(IsMultiplyError(sizeof(double), cCutsTotal)) {
+            LOG_0(Trace_Warning, "WARNING CompiledModel::Create IsMultiplyError(sizeof(double), cCutsTotal)");
+            return Error_OutOfMemory;
+         }
+         double * const aCutsCopy = static_cast<double *>(malloc(sizeof(double) * cCutsTotal));
+         if(nullptr == aCutsCopy) {
+            LOG_0(Trace_Warning, "WARNING CompiledModel::Create nullptr == aCutsCopy");
+            return Error_OutOfMemory;
+         }
+         pCompiledModel->m_aCuts = aCutsCopy;
+         memcpy(aCutsCopy, aCuts, sizeof(double) * cCutsTotal);
+
+         double * pCuts = aCutsCopy;
+         for(size_t iBinning = 0; iBinning < cBinnings; ++iBinning) {
+            CompiledBinning * const pBinning = &aBinnings[iBinning];
+            const size_t cCuts = pBinning->m_cCuts;
+            for(size_t iCut = 0; iCut < cCuts; ++iCut) {
+               // NaN fails both comparisons, so this also rejects NaN cuts
+               if(!(-std::numeric_limits<double>::infinity() < pCuts[iCut] &&
+                  pCuts[iCut] < std::numeric_limits<double>::infinity()))
+               {
+                  LOG_0(Trace_Error, "ERROR CompiledModel::Create cuts must be finite numbers");
+                  return Error_IllegalParamVal;
+               }
+               if(size_t { 0 } != iCut && !(pCuts[iCut - 1] < pCuts[iCut])) {
+                  LOG_0(Trace_Error, "ERROR CompiledModel::Create cuts must be strictly increasing within a binning");
+                  return Error_IllegalParamVal;
+               }
+            }
+            pBinning->m_aCuts = pCuts;
+            pCuts += cCuts;
+         }
+      }
+   }
+
+   if(size_t { 0 } != cTerms) {
+      if(nullptr == aTermDimensionCounts) {
+         LOG_0(Trace_Error, "ERROR CompiledModel::Create dimensionCounts cannot be null if 0 < countTerms");
+         return Error_IllegalParamVal;
+      }
+      if(IsMultiplyError(sizeof(CompiledTerm), cTerms)) {
+         LOG_0(Trace_Warning, "WARNING CompiledModel::Create IsMultiplyError(sizeof(CompiledTerm), cTerms)");
+         return Error_OutOfMemory;
+      }
+      CompiledTerm * const aTerms = static_cast<CompiledTerm *>(malloc(sizeof(CompiledTerm) * cTerms));
+      if(nullptr == aTerms) {
+         LOG_0(Trace_Warning, "WARNING CompiledModel::Create nullptr == aTerms");
+         return Error_OutOfMemory;
+      }
+      pCompiledModel->m_aTerms = aTerms;
+      pCompiledModel->m_cTerms = cTerms;
+
+      size_t cDimensionsTotal = 0;
+      for(size_t iTerm = 0; iTerm < cTerms; ++iTerm) {
+         const IntEbm countDimensions = aTermDimensionCounts[iTerm];
+         if(countDimensions < IntEbm { 0 } || IsConvertError<size_t>(countDimensions)) {
+            LOG_0(Trace_Error, "ERROR CompiledModel::Create dimensionCounts value cannot be negative");
+            return Error_IllegalParamVal;
+         }
+         const size_t cDimensions = static_cast<size_t>(countDimensions);
+         aTerms[iTerm].m_cDimensions = cDimensions;
+         aTerms[iTerm].m_iDimensionFirst = cDimensionsTotal;
+         aTerms[iTerm].m_aScores = nullptr;
+         if(IsAddError(cDimensionsTotal, cDimensions)) {
+            LOG_0(Trace_Error, "ERROR CompiledModel::Create IsAddError(cDimensionsTotal, cDimensions)");
+            return Error_IllegalParamVal;
+         }
+         cDimensionsTotal += cDimensions;
+      }
+
+      if(size_t { 0 } != cDimensionsTotal) {
+         if(nullptr == aTermBinningIndexes) {
+            LOG_0(Trace_Error, "ERROR CompiledModel::Create binningIndexes cannot be null if terms have dimensions");
+            return Error_IllegalParamVal;
+         }
+         if(IsMultiplyError(sizeof(size_t), cDimensionsTotal)) {
+            LOG_0(Trace_Warning, "WARNING CompiledModel::Create IsMultiplyError(sizeof(size_t), cDimensionsTotal)");
+            return Error_OutOfMemory;
+         }
+         size_t * const aTermBinnings = static_cast<size_t *>(malloc(sizeof(size_t) * cDimensionsTotal));
+         if(nullptr == aTermBinnings) {
+            LOG_0(Trace_Warning, "WARNING CompiledModel::Create nullptr == aTermBinnings");
+            return Error_OutOfMemory;
+         }
+         pCompiledModel->m_aTermBinnings = aTermBinnings;
+
+         size_t * const aTermStrides = static_cast<size_t *>(malloc(sizeof(size_t) * cDimensionsTotal));
+         if(nullptr == aTermStrides) {
+            LOG_0(Trace_Warning, "WARNING CompiledModel::Create nullptr == aTermStrides");
+            return Error_OutOfMemory;
+         }
+         pCompiledModel->m_aTermStrides = aTermStrides;
+      }
+
+      // the tensors are C ordered with the scores last, so the final dimension has a stride of cScores
+      size_t cScoresTotal = 0;
+      for(size_t iTerm = 0; iTerm < cTerms; ++iTerm) {
+         const CompiledTerm * const pTerm = &aTerms[iTerm];
+         size_t cTensorScores = cScores;
+         size_t iDimension = pTerm->m_cDimensions;
+         while(size_t { 0 } != iDimension) {
+            --iDimension;
+            const size_t iDimensionGlobal = pTerm->m_iDimensionFirst + iDimension;
+            const IntEbm indexBinning = aTermBinningIndexes[iDimensionGlobal];
+            if(indexBinning < IntEbm { 0 } || IsConvertError<size_t>(indexBinning) ||
+               cBinnings <= static_cast<size_t>(indexBinning))
+            {
+               LOG_0(Trace_Error, "ERROR CompiledModel::Create binningIndexes value out of range");
+               return Error_IllegalParamVal;
+            }
+            const size_t iBinning = static_cast<size_t>(indexBinning);
+            pCompiledModel->m_aTermBinnings[iDimensionGlobal] = iBinning;
+            pCompiledModel->m_aTermStrides[iDimensionGlobal] = cTensorScores;
+
+            const size_t cBins = pCompiledModel->m_aBinnings[iBinning].m_cBins;
+            if(IsMultiplyError(cTensorScores, cBins)) {
+               LOG_0(Trace_Warning, "WARNING CompiledModel::Create IsMultiplyError(cTensorScores, cBins)");
+               return Error_OutOfMemory;
+            }
+            cTensorScores *= cBins;
+         }
+         if(IsAddError(cScoresTotal, cTensorScores)) {
+            LOG_0(Trace_Warning, "WARNING CompiledModel::Create IsAddError(cScoresTotal, cTensorScores)");
+            return Error_OutOfMemory;
+         }
+         cScoresTotal += cTensorScores;
+      }
+
+      if(nullptr == aTermScores) {
+         LOG_0(Trace_Error, "ERROR CompiledModel::Create termScores cannot be null if 0 < countTerms");
+         return Error_IllegalParamVal;
+      }
+      if(IsMultiplyError(sizeof(double), cScoresTotal)) {
+         LOG_0(Trace_Warning, "WARNING CompiledModel::Create IsMultiplyError(sizeof(double), cScoresTotal)");
+         return Error_OutOfMemory;
+      }
+      double * const aTermScoresCopy = static_cast<double *>(malloc(sizeof(double) * cScoresTotal));
+      if(nullptr == aTermScoresCopy) {
+         LOG_0(Trace_Warning, "WARNING CompiledModel::Create nullptr == aTermScoresCopy");
+         return Error_OutOfMemory;
+      }
+      pCompiledModel->m_aTermScores = aTermScoresCopy;
+      memcpy(aTermScoresCopy, aTermScores, sizeof(double) * cScoresTotal);
+
+      const double * pScores = aTermScoresCopy;
+      for(size_t iTerm = 0; iTerm < cTerms; ++iTerm) {
+         CompiledTerm * const pTerm = &aTerms[iTerm];
+         pTerm->m_aScores = pScores;
+         size_t cTensorScores = cScores;
+         for(size_t iDimension = 0; iDimension < pTerm->m_cDimensions; ++iDimension) {
+            const size_t iBinning = pCompiledModel->m_aTermBinnings[pTerm->m_iDimensionFirst + iDimension];
+            cTensorScores *= pCompiledModel->m_aBinnings[iBinning].m_cBins;
+         }
+         pScores += cTensorScores;
+      }
+   }
+
+   error = pCompiledModel->m_threadPool.Start(GetCountThreadsRequested());
+   if(Error_None != error) {
+      return error;
+   }
+
+   LOG_0(Trace_Info, "Exited CompiledModel::Create");
+   return Error_None;
+}
+
+struct PredictTaskContext final {
+   const CompiledModel * m_pCompiledModel;
+   size_t m_cSamples;
+   const double * m_aX;
+   bool m_bFortranOrdered;
+   double * m_aScoresOut;
+   size_t m_cBlocks;
+   size_t m_cTasks;
+   // per task scratch: the transposed stripe (C ordered input only) followed by the bin indexes of every binning
+   size_t m_cScratchBytesPerTask;
+   unsigned char * m_aScratch;
+};
+
+static size_t BinContinuous(const double val, const size_t cCuts, const double * const aCuts) {
+   // NaN fails every comparison, so it would land in bin 1 without this check
+   if(UNPREDICTABLE(std::isnan(val))) {
+      return size_t { 0 };
+   }
+   // count the cuts that are lower or equal to val.  The loop is branchless so that the unpredictable
+   // comparisons turn into conditional moves
+   const double * pLow = aCuts;
+   size_t cRemaining = cCuts;
+   while(size_t { 0 } != cRemaining) {
+      const size_t cHalf = cRemaining >> 1;
+      const bool bAbove = pLow[cHalf] <= val;
+      pLow = UNPREDICTABLE(bAbove) ? pLow + cHalf + size_t { 1 } : pLow;
+      cRemaining = UNPREDICTABLE(bAbove) ? cRemaining - cHalf - size_t { 1 } : cHalf;
+   }
+   return static_cast<size_t>(pLow - aCuts) + size_t { 1 };
+}
+
+static size_t BinPreBinned(const double val, const size_t cBins) {
+   if(UNPREDICTABLE(std::isnan(val))) {
+      return size_t { 0 };
+   }
+   // anything that is not an index we know about (negative, fractional, or too large) goes to the last bin,
+   // which is where the unknown category lives
+   if(val < 0.0 || static_cast<double>(cBins) <= val) {
+      return cBins - size_t { 1 };
+   }
+   const size_t iBin = static_cast<size_t>(val);
+   return static_cast<double>(iBin) == val ? iBin : cBins - size_t { 1 };
+}
+
+void CompiledModel::PredictTask(void * const pContextVoid, const size_t iTask) {
+   const PredictTaskContext * const pContext = static_cast<const PredictTaskContext *>(pContextVoid);
+   const CompiledModel * const pCompiledModel = pContext->m_pCompiledModel;
+
+   const size_t cColumns = pCompiledModel->m_cColumns;
+   const size_t cScores = pCompiledModel->m_cScores;
+   const size_t cBinnings = pCompiledModel->m_cBinnings;
+   const size_t cTerms = pCompiledModel->m_cTerms;
+   const size_t cSamples = pContext->m_cSamples;
+   const double * const aX = pContext->m_aX;
+   const bool bFortranOrdered = pContext->m_bFortranOrdered;
+
+   unsigned char * const pScratch = pContext->m_aScratch + pContext->m_cScratchBytesPerTask * iTask;
+   size_t * const aBins = reinterpret_cast<size_t *>(pScratch);
+   double * const aTransposed = reinterpret_cast<double *>(pScratch + sizeof(size_t) * k_cSamplesPerStripe * cBinnings);
+
+   // split the blocks into contiguous ranges so that each task writes to its own region of the output
+   const size_t iBlockStart = pContext->m_cBlocks * iTask / pContext->m_cTasks;
+   const size_t iBlockEnd = pContext->m_cBlocks * (iTask + size_t { 1 }) / pContext->m_cTasks;
+
+   for(size_t iBlock = iBlockStart; iBlock < iBlockEnd; ++iBlock) {
+      const size_t iSampleStart = iBlock * k_cSamplesPerStripe;
+      const size_t cStripe =
+         k_cSamplesPerStripe < cSamples - iSampleStart ? k_cSamplesPerStripe : cSamples - iSampleStart;
+
+      if(!bFortranOrdered) {
+         // striped partial transpose.  We read the C ordered rows sequentially and write into one stream per column
+         const double * pRow = aX + iSampleStart * cColumns;
+         for(size_t iSample = 0; iSample < cStripe; ++iSample) {
+            double * pTransposed = aTransposed + iSample;
+            const double * const pRowEnd = pRow + cColumns;
+            while(pRowEnd != pRow) {
+               *pTransposed = *pRow;
+               pTransposed += k_cSamplesPerStripe;
+               ++pRow;
+            }
+         }
+      }
+
+      for(size_t iBinning = 0; iBinning < cBinnings; ++iBinning) {
+         const CompiledBinning * const pBinning = &pCompiledModel->m_aBinnings[iBinning];
+         const double * const aVals = bFortranOrdered ?
+            aX + pBinning->m_iColumn * cSamples + iSampleStart :
+            aTransposed + pBinning->m_iColumn * k_cSamplesPerStripe;
+         size_t * const aBinsStripe = aBins + iBinning * k_cSamplesPerStripe;
+
+         if(pBinning->m_bPreBinned) {
+            const size_t cBins = pBinning->m_cBins;
+            for(size_t iSample = 0; iSample < cStripe; ++iSample) {
+               aBinsStripe[iSample] = BinPreBinned(aVals[iSample], cBins);
+            }
+         } else {
+            const size_t cCuts = pBinning->m_cCuts;
+            const double * const aCuts = pBinning->m_aCuts;
+            for(size_t iSample = 0; iSample < cStripe; ++iSample) {
+               aBinsStripe[iSample] = BinContinuous(aVals[iSample], cCuts, aCuts);
+            }
+         }
+      }
+
+      double * const aScoresStripe = pContext->m_aScoresOut + iSampleStart * cScores;
+      for(size_t iSample = 0; iSample < cStripe; ++iSample) {
+         for(size_t iScore = 0; iScore < cScores; ++iScore) {
+            aScoresStripe[iSample * cScores + iScore] = pCompiledModel->m_aIntercept[iScore];
+         }
+      }
+
+      // process one term at a time across the whole stripe so that the term's tensor stays in L1 cache
+      for(size_t iTerm = 0; iTerm < cTerms; ++iTerm) {
+         const CompiledTerm * const pTerm = &pCompiledModel->m_aTerms[iTerm];
+         const size_t cDimensions = pTerm->m_cDimensions;
+         const size_t * const aTermBinnings = pCompiledModel->m_aTermBinnings + pTerm->m_iDimensionFirst;
+         const size_t * const aTermStrides = pCompiledModel->m_aTermStrides + pTerm->m_iDimensionFirst;
+         const double * const aTensor = pTerm->m_aScores;
+
+         if(size_t { 1 } == cScores && size_t { 1 } == cDimensions) {
+            // mains on a single score are the overwhelmingly common case, so special case them
+            const size_t * const aBinsStripe = aBins + aTermBinnings[0] * k_cSamplesPerStripe;
+            for(size_t iSample = 0; iSample < cStripe; ++iSample) {
+               aScoresStripe[iSample] += aTensor[aBinsStripe[iSample]];
+            }
+            continue;
+         }
+
+         for(size_t iSample = 0; iSample < cStripe; ++iSample) {
+            size_t iTensor = 0;
+            for(size_t iDimension = 0; iDimension < cDimensions; ++iDimension) {
+               iTensor += aBins[aTermBinnings[iDimension] * k_cSamplesPerStripe + iSample] * aTermStrides[iDimension];
+            }
+            const double * const pTensorScores = aTensor + iTensor;
+            double * const pSampleScores = aScoresStripe + iSample * cScores;
+            for(size_t iScore = 0; iScore < cScores; ++iScore) {
+               pSampleScores[iScore] += pTensorScores[iScore];
+            }
+         }
+      }
+   }
+}
+
+ErrorEbm CompiledModel::Predict(
+   const size_t cSamples,
+   const double * const aX,
+   const bool bFortranOrdered,
+   double * const aScoresOut
+) {
+   EBM_ASSERT(size_t { 0 } != cSamples);
+   EBM_ASSERT(nullptr != aX || size_t { 0 } == m_cColumns);
+   EBM_ASSERT(nullptr != aScoresOut);
+
+   const size_t cBlocks = (cSamples - size_t { 1 }) / k_cSamplesPerStripe + size_t { 1 };
+   const size_t cThreads = m_threadPool.GetCountThreads();
+   const size_t cTasks = cBlocks < cThreads ? cBlocks : cThreads;
+
+   // the scratch space is allocated per call instead of being held by the model so that several threads can
+   // call PredictScores on the same handle without coordinating
+   const size_t cTransposedColumns = bFortranOrdered ? size_t { 0 } : m_cColumns;
+   if(IsMultiplyError(sizeof(size_t), k_cSamplesPerStripe, m_cBinnings) ||
+      IsMultiplyError(sizeof(double), k_cSamplesPerStripe, cTransposedColumns))
+   {
+      LOG_0(Trace_Warning, "WARNING CompiledModel::Predict IsMultiplyError scratch");
+      return Error_OutOfMemory;
+   }
+   const size_t cBinsBytes = sizeof(size_t) * k_cSamplesPerStripe * m_cBinnings;
+   const size_t cTransposedBytes = sizeof(double) * k_cSamplesPerStripe * cTransposedColumns;
+   if(IsAddError(cBinsBytes, cTransposedBytes)) {
+      LOG_0(Trace_Warning, "WARNING CompiledModel::Predict IsAddError(cBinsBytes, cTransposedBytes)");
+      return Error_OutOfMemory;
+   }
+   const size_t cScratchBytesPerTask = cBinsBytes + cTransposedBytes;
+   if(IsMultiplyError(cScratchBytesPerTask, cTasks)) {
+      LOG_0(Trace_Warning, "WARNING CompiledModel::Predict IsMultiplyError(cScratchBytesPerTask, cTasks)");
+      return Error_OutOfMemory;
+   }
+
+   unsigned char * aScratch = nullptr;
+   if(size_t { 0 } != cScratchBytesPerTask) {
+      aScratch = static_cast<unsigned char *>(malloc(cScratchBytesPerTask * cTasks));
+      if(nullptr == aScratch) {
+         LOG_0(Trace_Warning, "WARNING CompiledModel::Predict nullptr == aScratch");
+         return Error_OutOfMemory;
+      }
+   }
+
+   PredictTaskContext context;
+   context.m_pCompiledModel = this;
+   context.m_cSamples = cSamples;
+   context.m_aX = aX;
+   context.m_bFortranOrdered = bFortranOrdered;
+   context.m_aScoresOut = aScoresOut;
+   context.m_cBlocks = cBlocks;
+   context.m_cTasks = cTasks;
+   context.m_cScratchBytesPerTask = cScratchBytesPerTask;
+   context.m_aScratch = aScratch;
+
+   m_threadPool.Run(cTasks, PredictTask, &context);
+
+   free(aScratch);
+   return Error_None;
+}
+
+EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CreateCompiledModel(
+   IntEbm countColumns,
+   IntEbm countBinnings,
+   const IntEbm * binningColumns,
+   const IntEbm * binningCountBins,
+   const IntEbm * binningCountCuts,
+   const double * cuts,
+   IntEbm countScores,
+   const double * intercept,
+   IntEbm countTerms,
+   const IntEbm * dimensionCounts,
+   const IntEbm * binningIndexes,
+   const double * termScores,
+   CompiledModelHandle * compiledModelHandleOut
+) {
+   LOG_N(
+      Trace_Info,
+      "Entered CreateCompiledModel: "
+      "countColumns=%" IntEbmPrintf ", "
+      "countBinnings=%" IntEbmPrintf ", "
+      "binningColumns=%p, "
+      "binningCountBins=%p, "
+      "binningCountCuts=%p, "
+      "cuts=%p, "
+      "countScores=%" IntEbmPrintf ", "
+      "intercept=%p, "
+      "countTerms=%" IntEbmPrintf ", "
+      "dimensionCounts=%p, "
+      "binningIndexes=%p, "
+      "termScores=%p, "
+      "compiledModelHandleOut=%p"
+      ,
+      countColumns,
+      countBinnings,
+      static_cast<const void *>(binningColumns),
+      static_cast<const void *>(binningCountBins),
+      static_cast<const void *>(binningCountCuts),
+      static_cast<const void *>(cuts),
+      countScores,
+      static_cast<const void *>(intercept),
+      countTerms,
+      static_cast<const void *>(dimensionCounts),
+      static_cast<const void *>(binningIndexes),
+      static_cast<const void *>(termScores),
+      static_cast<const void *>(compiledModelHandleOut)
+   );
+
+   ErrorEbm error;
+
+   if(nullptr == compiledModelHandleOut) {
+      LOG_0(Trace_Error, "ERROR CreateCompiledModel nullptr == compiledModelHandleOut");
+      return Error_IllegalParamVal;
+   }
+   *compiledModelHandleOut = nullptr; // set this to nullptr as soon as possible so the caller doesn't attempt to free it
+
+   if(countColumns < IntEbm { 0 } || IsConvertError<size_t>(countColumns)) {
+      LOG_0(Trace_Error, "ERROR CreateCompiledModel countColumns must be a non-negative number");
+      return Error_IllegalParamVal;
+   }
+   if(countBinnings < IntEbm { 0 } || IsConvertError<size_t>(countBinnings)) {
+      LOG_0(Trace_Error, "ERROR CreateCompiledModel countBinnings must be a non-negative number");
+      return Error_IllegalParamVal;
+   }
+   if(countScores <= IntEbm { 0 } || IsConvertError<size_t>(countScores)) {
+      LOG_0(Trace_Error, "ERROR CreateCompiledModel countScores must be a positive number");
+      return Error_IllegalParamVal;
+   }
+   if(countTerms < IntEbm { 0 } || IsConvertError<size_t>(countTerms)) {
+      LOG_0(Trace_Error, "ERROR CreateCompiledModel countTerms must be a non-negative number");
+      return Error_IllegalParamVal;
+   }
+
+   CompiledModel * pCompiledModel = nullptr;
+   error = CompiledModel::Create(
+      static_cast<size_t>(countColumns),
+      static_cast<size_t>(countBinnings),
+      binningColumns,
+      binningCountBins,
+      binningCountCuts,
+      cuts,
+      static_cast<size_t>(countScores),
+      intercept,
+      static_cast<size_t>(countTerms),
+      dimensionCounts,
+      binningIndexes,
+      termScores,
+      &pCompiledModel
+   );
+   if(Error_None != error) {
+      CompiledModel::Free(pCompiledModel);
+      return error;
+   }
+
+   const CompiledModelHandle handle = pCompiledModel->GetHandle();
+
+   LOG_N(Trace_Info, "Exited CreateCompiledModel: *compiledModelHandleOut=%p", static_cast<void *>(handle));
+
+   *compiledModelHandleOut = handle;
+   return Error_None;
+}
+
+EBM_API_BODY void EBM_CALLING_CONVENTION FreeCompiledModel(
+   CompiledModelHandle compiledModelHandle
+) {
+   LOG_N(Trace_Info, "Entered FreeCompiledModel: compiledModelHandle=%p", static_cast<void *>(compiledModelHandle));
+
+   CompiledModel * const pCompiledModel = CompiledModel::GetCompiledModelFromHandle(compiledModelHandle);
+   // if the conversion above doesn't work, it'll return null, and our free will not in fact free any memory,
+   // but it will not crash. We'll leak memory, but at least we'll log that.
+
+   // it's legal to call free on nullptr, just like for free().  This is checked inside CompiledModel::Free()
+   CompiledModel::Free(pCompiledModel);
+
+   LOG_0(Trace_Info, "Exited FreeCompiledModel");
+}
+
+// don't bother using a lock here.  We don't care if an extra log message is written out due to thread parallism
+static int g_cLogEnterPredictScores = 25;
+static int g_cLogExitPredictScores = 25;
+
+EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION PredictScores(
+   CompiledModelHandle compiledModelHandle,
+   IntEbm countSamples,
+   const double * featureVals,
+   BoolEbm isFortranOrdered,
+   double * scoresOut
+) {
+   LOG_COUNTED_N(
+      &g_cLogEnterPredictScores,
+      Trace_Info,
+      Trace_Verbose,
+      "Entered PredictScores: "
+      "compiledModelHandle=%p, "
+      "countSamples=%" IntEbmPrintf ", "
+      "featureVals=%p, "
+      "isFortranOrdered=%s, "
+      "scoresOut=%p"
+      ,
+      static_cast<void *>(compiledModelHandle),
+      countSamples,
+      static_cast<const void *>(featureVals),
+      ObtainTruth(isFortranOrdered),
+      static_cast<void *>(scoresOut)
+   );
+
+   CompiledModel * const pCompiledModel = CompiledModel::GetCompiledModelFromHandle(compiledModelHandle);
+   if(nullptr == pCompiledModel) {
+      // already logged
+      return Error_IllegalParamVal;
+   }
+
+   if(EBM_FALSE != isFortranOrdered && EBM_TRUE != isFortranOrdered) {
+      LOG_0(Trace_Error, "ERROR PredictScores isFortranOrdered is not EBM_FALSE or EBM_TRUE");
+      return Error_IllegalParamVal;
+   }
+
+   if(countSamples <= IntEbm { 0 }) {
+      if(IntEbm { 0 } != countSamples) {
+         LOG_0(Trace_Error, "ERROR PredictScores countSamples cannot be negative");
+         return Error_IllegalParamVal;
+      }
+      return Error_None;
+   }
+   if(IsConvertError<size_t>(countSamples)) {
+      // the caller should not have been able to allocate memory for featureVals if this wasn't fittable in size_t
+      LOG_0(Trace_Error, "ERROR PredictScores IsConvertError<size_t>(countSamples)");
+      return Error_IllegalParamVal;
+   }
+   const size_t cSamples = static_cast<size_t>(countSamples);
+
+   if(nullptr == featureVals && size_t { 0 } != pCompiledModel->GetCountColumns()) {
+      LOG_0(Trace_Error, "ERROR PredictScores featureVals cannot be null");
+      return Error_IllegalParamVal;
+   }
+   if(nullptr == scoresOut) {
+      LOG_0(Trace_Error, "ERROR PredictScores scoresOut cannot be null");
+      return Error_IllegalParamVal;
+   }
+
+   const ErrorEbm error = pCompiledModel->Predict(cSamples, featureVals, EBM_FALSE != isFortranOrdered, scoresOut);
+   if(Error_None != error) {
+      return error;
+   }
+
+   LOG_COUNTED_0(&g_cLogExitPredictScores, Trace_Info, Trace_Verbose, "Exited PredictScores");
+   return Error_None;
+}
+
+} // DEFINED_ZONE_NAME
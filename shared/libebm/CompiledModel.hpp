@@ -0,0 +1,136 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef COMPILED_MODEL_HPP
+#define COMPILED_MODEL_HPP
+
+#include <stddef.h> // size_t, ptrdiff_t
+
+#include "libebm.h" // ErrorEbm
+#include "logging.h" // EBM_ASSERT
+#include "zones.h"
+
+#include "ThreadPool.hpp"
+
+namespace DEFINED_ZONE_NAME {
+#ifndef DEFINED_ZONE_NAME
+#error DEFINED_ZONE_NAME must be defined
+#endif // DEFINED_ZONE_NAME
+
+struct CompiledBinning final {
+   size_t m_iColumn;
+   size_t m_cBins;
+   // columns that are already binned (categoricals) have no cuts and are passed through with bounds checks
+   bool m_bPreBinned;
+   size_t m_cCuts;
+   const double * m_aCuts;
+};
+
+struct CompiledTerm final {
+   size_t m_cDimensions;
+   // index into m_aTermBinnings and m_aTermStrides where this term's dimensions begin
+   size_t m_iDimensionFirst;
+   const double * m_aScores;
+};
+
+class CompiledModel final {
+   static constexpr size_t k_handleVerificationOk = 27431; // random 15 bit number
+   static constexpr size_t k_handleVerificationFreed = 9604; // random 15 bit number
+   size_t m_handleVerification; // this needs to be at the top and make it pointer sized to keep best alignment
+
+   size_t m_cColumns;
+   size_t m_cScores;
+
+   size_t m_cBinnings;
+   CompiledBinning * m_aBinnings;
+   double * m_aCuts;
+
+   size_t m_cTerms;
+   CompiledTerm * m_aTerms;
+   size_t * m_aTermBinnings;
+   size_t * m_aTermStrides;
+   double * m_aTermScores;
+
+   double * m_aIntercept;
+
+   ThreadPool m_threadPool;
+
+   inline CompiledModel() noexcept :
+      m_handleVerification(k_handleVerificationOk),
+      m_cColumns(0),
+      m_cScores(0),
+      m_cBinnings(0),
+      m_aBinnings(nullptr),
+      m_aCuts(nullptr),
+      m_cTerms(0),
+      m_aTerms(nullptr),
+      m_aTermBinnings(nullptr),
+      m_aTermStrides(nullptr),
+      m_aTermScores(nullptr),
+      m_aIntercept(nullptr) {
+   }
+
+   ~CompiledModel();
+
+   static void PredictTask(void * const pContextVoid, const size_t iTask);
+
+public:
+
+   // samples are processed in stripes of this many.  64 doubles per column was the fastest partial
+   // transpose in the measurements recorded at the top of Discretize.cpp
+   static constexpr size_t k_cSamplesPerStripe = 64;
+
+   static void Free(CompiledModel * const pCompiledModel);
+
+   static ErrorEbm Create(
+      const size_t cColumns,
+      const size_t cBinnings,
+      const IntEbm * const aBinningColumns,
+      const IntEbm * const aBinningCountBins,
+      const IntEbm * const aBinningCountCuts,
+      const double * const aCuts,
+      const size_t cScores,
+      const double * const aIntercept,
+      const size_t cTerms,
+      const IntEbm * const aTermDimensionCounts,
+      const IntEbm * const aTermBinningIndexes,
+      const double * const aTermScores,
+      CompiledModel ** const ppCompiledModelOut
+   );
+
+   ErrorEbm Predict(
+      const size_t cSamples,
+      const double * const aX,
+      const bool bFortranOrdered,
+      double * const aScoresOut
+   );
+
+   inline size_t GetCountColumns() const noexcept {
+      return m_cColumns;
+   }
+
+   inline static CompiledModel * GetCompiledModelFromHandle(const CompiledModelHandle compiledModelHandle) {
+      if(nullptr == compiledModelHandle) {
+         LOG_0(Trace_Error, "ERROR GetCompiledModelFromHandle null compiledModelHandle");
+         return nullptr;
+      }
+      CompiledModel * const pCompiledModel = reinterpret_cast<CompiledModel *>(compiledModelHandle);
+      if(k_handleVerificationOk == pCompiledModel->m_handleVerification) {
+         return pCompiledModel;
+      }
+      if(k_handleVerificationFreed == pCompiledModel->m_handleVerification) {
+         LOG_0(Trace_Error, "ERROR GetCompiledModelFromHandle attempt to use freed CompiledModelHandle");
+      } else {
+         LOG_0(Trace_Error, "ERROR GetCompiledModelFromHandle attempt to use invalid CompiledModelHandle");
+      }
+      return nullptr;
+   }
+   inline CompiledModelHandle GetHandle() {
+      return reinterpret_cast<CompiledModelHandle>(this);
+   }
+};
+
+} // DEFINED_ZONE_NAME
+
+#endif // COMPILED_MODEL_HPP
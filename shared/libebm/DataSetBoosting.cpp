@@ -6,7 +6,7 @@
 
 #include <stdlib.h> // free
 #include <stddef.h> // size_t, ptrdiff_t
-#include <string.h> // memcpy
+#include <string.h> // memcpy, memset
 
 #include "common_cpp.hpp" // INLINE_RELEASE_UNTEMPLATED
 
@@ -43,7 +43,7 @@ INLINE_RELEASE_UNTEMPLATED static FloatFast * ConstructGradientsAndHessians(cons
 WARNING_PUSH
 // NOTE: This warning seems to be flagged by the DEBUG 32 bit build
 WARNING_BUFFER_OVERRUN
-INLINE_RELEASE_UNTEMPLATED static FloatFast * ConstructSampleScores(
+INLINE_RELEASE_UNTEMPLATED static FloatScore * ConstructSampleScores(
    const size_t cScores,
    const BagEbm direction,
    const BagEbm * const aBag,
@@ -57,27 +57,27 @@ INLINE_RELEASE_UNTEMPLATED static FloatFast * ConstructSampleScores(
    EBM_ASSERT(nullptr != aBag || BagEbm { 1 } == direction);  // if aBag is nullptr then we have no validation samples
    EBM_ASSERT(1 <= cSetSamples);
 
-   if(IsMultiplyError(sizeof(FloatFast), cScores, cSetSamples)) {
-      LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructSampleScores IsMultiplyError(sizeof(FloatFast), cScores, cSetSamples)");
+   if(IsMultiplyError(sizeof(FloatScore), cScores, cSetSamples)) {
+      LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructSampleScores IsMultiplyError(sizeof(FloatScore), cScores, cSetSamples)");
       return nullptr;
    }
    const size_t cElements = cScores * cSetSamples;
 
-   FloatFast * const aSampleScores = static_cast<FloatFast *>(malloc(sizeof(FloatFast) * cElements));
+   FloatScore * const aSampleScores = static_cast<FloatScore *>(malloc(sizeof(FloatScore) * cElements));
    if(nullptr == aSampleScores) {
       LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructSampleScores nullptr == aSampleScores");
       return nullptr;
    }
 
    if(nullptr == aInitScores) {
-      static_assert(std::numeric_limits<FloatFast>::is_iec559, "IEEE 754 guarantees zeros means a zero float");
-      memset(aSampleScores, 0, sizeof(FloatFast) * cElements);
+      static_assert(std::numeric_limits<FloatScore>::is_iec559, "IEEE 754 guarantees zeros means a zero float");
+      memset(aSampleScores, 0, sizeof(FloatScore) * cElements);
    } else {
       const size_t cBytesPerItem = sizeof(*aSampleScores) * cScores;
 
       const BagEbm * pSampleReplication = aBag;
-      FloatFast * pSampleScore = aSampleScores;
-      const FloatFast * const pSampleScoresEnd = &aSampleScores[cElements];
+      FloatScore * pSampleScore = aSampleScores;
+      const FloatScore * const pSampleScoresEnd = &aSampleScores[cElements];
       const double * pInitScore = aInitScores;
       const bool isLoopTraining = BagEbm { 0 } < direction;
       do {
@@ -116,7 +116,8 @@ INLINE_RELEASE_UNTEMPLATED static void * ConstructTargetData(
    const unsigned char * const pDataSetShared,
    const BagEbm direction,
    const BagEbm * const aBag,
-   const size_t cSetSamples
+   const size_t cSetSamples,
+   size_t * const pcBytesTargetsPerSample
 ) {
    LOG_0(Trace_Info, "Entered DataSetBoosting::ConstructTargetData");
 
@@ -124,117 +125,154 @@ INLINE_RELEASE_UNTEMPLATED static void * ConstructTargetData(
    EBM_ASSERT(BagEbm { -1 } == direction || BagEbm { 1 } == direction);
    EBM_ASSERT(1 <= cSetSamples);
 
+   SharedStorageDataType countSamplesUnused;
+   size_t cFeaturesUnused;
+   size_t cWeightsUnused;
+   size_t cTargets;
+   const ErrorEbm error = GetDataSetSharedHeader(pDataSetShared, &countSamplesUnused, &cFeaturesUnused, &cWeightsUnused, &cTargets);
+   EBM_ASSERT(Error_None == error); // we previously called GetDataSetSharedHeader and got back a non-error result
+   UNUSED(error);
+   EBM_ASSERT(1 <= cTargets);
+
    ptrdiff_t cClasses;
-   const void * const aTargets = GetDataSetSharedTarget(pDataSetShared, 0, &cClasses);
+   const void * aTargets = GetDataSetSharedTarget(pDataSetShared, 0, &cClasses);
    EBM_ASSERT(nullptr != aTargets); // we previously called GetDataSetSharedTarget and got back non-null result
 
-   const BagEbm * pSampleReplication = aBag;
    const bool isLoopTraining = BagEbm { 0 } < direction;
    EBM_ASSERT(nullptr != aBag || isLoopTraining); // if aBag is nullptr then we have no validation samples
 
+   // multitask targets are interleaved so that each sample's targets are adjacent, like the sample scores
    if(IsClassification(cClasses)) {
       const size_t countClasses = static_cast<size_t>(cClasses);
 
-      if(IsMultiplyError(sizeof(StorageDataType), cSetSamples)) {
-         LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructTargetData IsMultiplyError(sizeof(StorageDataType), cSetSamples)");
+      if(IsMultiplyError(sizeof(StorageDataType), cSetSamples, cTargets)) {
+         LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructTargetData IsMultiplyError(sizeof(StorageDataType), cSetSamples, cTargets)");
          return nullptr;
       }
-      StorageDataType * const aTargetData = static_cast<StorageDataType *>(malloc(sizeof(StorageDataType) * cSetSamples));
+      StorageDataType * const aTargetData = static_cast<StorageDataType *>(malloc(sizeof(StorageDataType) * cSetSamples * cTargets));
       if(nullptr == aTargetData) {
          LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructTargetData nullptr == aTargetData");
          return nullptr;
       }
+      *pcBytesTargetsPerSample = sizeof(StorageDataType) * cTargets;
 
-      const SharedStorageDataType * pTargetFrom = static_cast<const SharedStorageDataType *>(aTargets);
-      StorageDataType * pTargetTo = aTargetData;
-      StorageDataType * pTargetToEnd = aTargetData + cSetSamples;
+      size_t iTarget = 0;
       do {
-         BagEbm replication = 1;
-         if(nullptr != pSampleReplication) {
-            bool isItemTraining;
-            do {
-               do {
-                  replication = *pSampleReplication;
-                  ++pSampleReplication;
-                  ++pTargetFrom;
-               } while(BagEbm { 0 } == replication);
-               isItemTraining = BagEbm { 0 } < replication;
-            } while(isLoopTraining != isItemTraining);
-            --pTargetFrom;
-         }
-         const SharedStorageDataType data = *pTargetFrom;
-         ++pTargetFrom;
-         EBM_ASSERT(!IsConvertError<size_t>(data));
-         if(IsConvertError<StorageDataType>(data)) {
-            // this shouldn't be possible since we previously checked that we could convert our target,
-            // so if this is failing then we'll be larger than the maximum number of classes
-            LOG_0(Trace_Error, "ERROR DataSetBoosting::ConstructTargetData data target too big to reference memory");
-            free(aTargetData);
-            return nullptr;
-         }
-         const StorageDataType iData = static_cast<StorageDataType>(data);
-         if(countClasses <= static_cast<size_t>(iData)) {
-            LOG_0(Trace_Error, "ERROR DataSetBoosting::ConstructTargetData target value larger than number of classes");
-            free(aTargetData);
-            return nullptr;
+         if(size_t { 0 } != iTarget) {
+            ptrdiff_t cTaskClasses;
+            aTargets = GetDataSetSharedTarget(pDataSetShared, iTarget, &cTaskClasses);
+            EBM_ASSERT(nullptr != aTargets);
+            EBM_ASSERT(cClasses == cTaskClasses); // BoosterCore::Create checked this
          }
+
+         const BagEbm * pSampleReplication = aBag;
+         const SharedStorageDataType * pTargetFrom = static_cast<const SharedStorageDataType *>(aTargets);
+         StorageDataType * pTargetTo = aTargetData + iTarget;
+         const StorageDataType * const pTargetToEnd = pTargetTo + cSetSamples * cTargets;
          do {
-            EBM_ASSERT(pTargetTo < aTargetData + cSetSamples);
-            *pTargetTo = iData;
-            ++pTargetTo;
-            replication -= direction;
-         } while(BagEbm { 0 } != replication);
-      } while(pTargetToEnd != pTargetTo);
+            BagEbm replication = 1;
+            if(nullptr != pSampleReplication) {
+               bool isItemTraining;
+               do {
+                  do {
+                     replication = *pSampleReplication;
+                     ++pSampleReplication;
+                     ++pTargetFrom;
+                  } while(BagEbm { 0 } == replication);
+                  isItemTraining = BagEbm { 0 } < replication;
+               } while(isLoopTraining != isItemTraining);
+               --pTargetFrom;
+            }
+            const SharedStorageDataType data = *pTargetFrom;
+            ++pTargetFrom;
+            EBM_ASSERT(!IsConvertError<size_t>(data));
+            if(IsConvertError<StorageDataType>(data)) {
+               // this shouldn't be possible since we previously checked that we could convert our target,
+               // so if this is failing then we'll be larger than the maximum number of classes
+               LOG_0(Trace_Error, "ERROR DataSetBoosting::ConstructTargetData data target too big to reference memory");
+               free(aTargetData);
+               return nullptr;
+            }
+            const StorageDataType iData = static_cast<StorageDataType>(data);
+            if(countClasses <= static_cast<size_t>(iData)) {
+               LOG_0(Trace_Error, "ERROR DataSetBoosting::ConstructTargetData target value larger than number of classes");
+               free(aTargetData);
+               return nullptr;
+            }
+            do {
+               EBM_ASSERT(pTargetTo < aTargetData + cSetSamples * cTargets);
+               *pTargetTo = iData;
+               pTargetTo += cTargets;
+               replication -= direction;
+            } while(BagEbm { 0 } != replication);
+         } while(pTargetToEnd != pTargetTo);
+
+         ++iTarget;
+      } while(cTargets != iTarget);
 
       LOG_0(Trace_Info, "Exited DataSetBoosting::ConstructTargetData");
       return aTargetData;
    } else {
-      if(IsMultiplyError(sizeof(FloatFast), cSetSamples)) {
-         LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructTargetData IsMultiplyError(sizeof(FloatFast), cSetSamples)");
+      if(IsMultiplyError(sizeof(FloatFast), cSetSamples, cTargets)) {
+         LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructTargetData IsMultiplyError(sizeof(FloatFast), cSetSamples, cTargets)");
          return nullptr;
       }
-      FloatFast * const aTargetData = static_cast<FloatFast *>(malloc(sizeof(FloatFast) * cSetSamples));
+      FloatFast * const aTargetData = static_cast<FloatFast *>(malloc(sizeof(FloatFast) * cSetSamples * cTargets));
       if(nullptr == aTargetData) {
          LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructTargetData nullptr == aTargetData");
          return nullptr;
       }
+      *pcBytesTargetsPerSample = sizeof(FloatFast) * cTargets;
 
-      const FloatFast * pTargetFrom = static_cast<const FloatFast *>(aTargets);
-      FloatFast * pTargetTo = aTargetData;
-      FloatFast * pTargetToEnd = aTargetData + cSetSamples;
+      size_t iTarget = 0;
       do {
-         BagEbm replication = 1;
-         if(nullptr != pSampleReplication) {
-            bool isItemTraining;
-            do {
-               do {
-                  replication = *pSampleReplication;
-                  ++pSampleReplication;
-                  ++pTargetFrom;
-               } while(BagEbm { 0 } == replication);
-               isItemTraining = BagEbm { 0 } < replication;
-            } while(isLoopTraining != isItemTraining);
-            --pTargetFrom;
+         if(size_t { 0 } != iTarget) {
+            ptrdiff_t cTaskClasses;
+            aTargets = GetDataSetSharedTarget(pDataSetShared, iTarget, &cTaskClasses);
+            EBM_ASSERT(nullptr != aTargets);
+            EBM_ASSERT(cClasses == cTaskClasses); // BoosterCore::Create checked this
          }
-         const FloatFast data = *pTargetFrom;
-         ++pTargetFrom;
 
-         // TODO : our caller should handle NaN *pTargetFrom values, which means that the target is missing, which means we should delete that sample 
-         //   from the input data
+         const BagEbm * pSampleReplication = aBag;
+         const FloatFast * pTargetFrom = static_cast<const FloatFast *>(aTargets);
+         FloatFast * pTargetTo = aTargetData + iTarget;
+         const FloatFast * const pTargetToEnd = pTargetTo + cSetSamples * cTargets;
+         do {
+            BagEbm replication = 1;
+            if(nullptr != pSampleReplication) {
+               bool isItemTraining;
+               do {
+                  do {
+                     replication = *pSampleReplication;
+                     ++pSampleReplication;
+                     ++pTargetFrom;
+                  } while(BagEbm { 0 } == replication);
+                  isItemTraining = BagEbm { 0 } < replication;
+               } while(isLoopTraining != isItemTraining);
+               --pTargetFrom;
+            }
+            const FloatFast data = *pTargetFrom;
+            ++pTargetFrom;
 
-         // if data is NaN, we pass this along and NaN propagation will ensure that we stop boosting immediately.
-         // There is no need to check it here since we already have graceful detection later for other reasons.
+            // TODO : our caller should handle NaN *pTargetFrom values, which means that the target is missing, which means we should delete that sample 
+            //   from the input data
 
-         // TODO: NaN target values essentially mean missing, so we should be filtering those samples out, but our caller should do that so 
-         //   that we don't need to do the work here per outer bag.  Our job in C++ is just not to crash or return inexplicable values.
+            // if data is NaN, we pass this along and NaN propagation will ensure that we stop boosting immediately.
+            // There is no need to check it here since we already have graceful detection later for other reasons.
 
-         do {
-            EBM_ASSERT(pTargetTo < aTargetData + cSetSamples);
-            *pTargetTo = data;
-            ++pTargetTo;
-            replication -= direction;
-         } while(BagEbm { 0 } != replication);
-      } while(pTargetToEnd != pTargetTo);
+            // TODO: NaN target values essentially mean missing, so we should be filtering those samples out, but our caller should do that so 
+            //   that we don't need to do the work here per outer bag.  Our job in C++ is just not to crash or return inexplicable values.
+
+            do {
+               EBM_ASSERT(pTargetTo < aTargetData + cSetSamples * cTargets);
+               *pTargetTo = data;
+               pTargetTo += cTargets;
+               replication -= direction;
+            } while(BagEbm { 0 } != replication);
+         } while(pTargetToEnd != pTargetTo);
+
+         ++iTarget;
+      } while(cTargets != iTarget);
 
       LOG_0(Trace_Info, "Exited DataSetBoosting::ConstructTargetData");
       return aTargetData;
@@ -273,7 +311,9 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
    const size_t cSetSamples,
    const IntEbm * const aiTermFeatures,
    const size_t cTerms,
-   const Term * const * const apTerms
+   const Term * const * const apTerms,
+   const size_t cBitPackLanes,
+   const SparseInputDataBoosting * const * const aaSparseInputData
 ) {
    LOG_0(Trace_Info, "Entered DataSetBoosting::ConstructInputData");
 
@@ -303,7 +343,10 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
    do {
       const Term * const pTerm = *ppTerm;
       EBM_ASSERT(nullptr != pTerm);
-      if(0 == pTerm->GetCountRealDimensions()) {
+      // terms kept in the sparse form have no packed copy since they are boosted and applied from the sparse list
+      if(0 == pTerm->GetCountRealDimensions() || 
+         (nullptr != aaSparseInputData && nullptr != aaSparseInputData[ppTerm - apTerms])) 
+      {
          piTermFeatures += pTerm->GetCountDimensions();
          *paInputDataTo = nullptr; // free will skip over these later
          ++paInputDataTo;
@@ -340,6 +383,10 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
 
          InputDataPointerAndCountBins dimensionInfo[k_cDimensionsMax];
          InputDataPointerAndCountBins * pDimensionInfoInit = &dimensionInfo[0];
+
+         // sparse features are expanded temporarily since the packed term data needs every sample anyways
+         SharedStorageDataType * aaExpanded[k_cDimensionsMax];
+         size_t cExpanded = 0;
          do {
             const FeatureBoosting * const pFeature = pTermFeature->m_pFeature;
             const size_t cBins = pFeature->GetCountBins();
@@ -370,7 +417,27 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
                EBM_ASSERT(nullptr != pInputDataFrom);
                EBM_ASSERT(!IsConvertError<size_t>(cBinsUnused)); // since we previously extracted cBins and checked
                EBM_ASSERT(static_cast<size_t>(cBinsUnused) == cBins);
-               EBM_ASSERT(!bSparse); // we don't support sparse yet
+
+               if(bSparse) {
+                  SharedStorageDataType * const aExpanded = ExpandSparseFeature(
+                     cSharedSamples,
+                     cBins,
+                     defaultValSparse,
+                     cNonDefaultsSparse,
+                     static_cast<const SparseFeatureDataSetSharedEntry *>(pInputDataFrom)
+                  );
+                  if(nullptr == aExpanded) {
+                     LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructInputData nullptr == aExpanded");
+                     while(size_t { 0 } != cExpanded) {
+                        --cExpanded;
+                        free(aaExpanded[cExpanded]);
+                     }
+                     goto free_all;
+                  }
+                  aaExpanded[cExpanded] = aExpanded;
+                  ++cExpanded;
+                  pInputDataFrom = aExpanded;
+               }
 
                pDimensionInfoInit->m_pInputData = static_cast<const SharedStorageDataType *>(pInputDataFrom);
                pDimensionInfoInit->m_cBins = cBins;
@@ -417,90 +484,111 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
          BagEbm replication = 0;
          StorageDataType iTensor;
 
-         ptrdiff_t cShiftTo = static_cast<ptrdiff_t>((cSetSamples - 1) % cItemsPerBitPackTo * cBitsPerItemMaxTo);
+         // the dregs are stored sequentially, and after them each block of cBitPackLanes bit packs is interleaved
+         const size_t cDregs = GetCountBitPackDregs(cSetSamples, cItemsPerBitPackTo, cBitPackLanes);
+         const StorageDataType * const pDregsEndTo = pInputDataTo + GetCountBitPacksDregs(cDregs, cItemsPerBitPackTo);
+
          const ptrdiff_t cShiftResetTo = static_cast<ptrdiff_t>((cItemsPerBitPackTo - 1) * cBitsPerItemMaxTo);
+         ptrdiff_t cShiftTo = cShiftResetTo;
+         size_t cLanesTo = cBitPackLanes;
+         if(size_t { 0 } != cDregs) {
+            cShiftTo = static_cast<ptrdiff_t>((cDregs - 1) % cItemsPerBitPackTo * cBitsPerItemMaxTo);
+            cLanesTo = 1;
+         }
 
          do {
-            StorageDataType bits = 0;
+            EBM_ASSERT(cLanesTo <= static_cast<size_t>(pInputDataToEnd - pInputDataTo));
+            memset(pInputDataTo, 0, sizeof(*pInputDataTo) * cLanesTo);
             do {
-               if(BagEbm { 0 } == replication) {
-                  replication = 1;
-                  if(nullptr != pSampleReplication) {
-                     const BagEbm * pSampleReplicationOriginal = pSampleReplication;
-                     bool isItemTraining;
-                     do {
-                        do {
-                           replication = *pSampleReplication;
-                           ++pSampleReplication;
-                        } while(BagEbm { 0 } == replication);
-                        isItemTraining = BagEbm { 0 } < replication;
-                     } while(isLoopTraining != isItemTraining);
-                     const size_t cAdvances = pSampleReplication - pSampleReplicationOriginal - 1;
-                     if(0 != cAdvances) {
-                        InputDataPointerAndCountBins * pDimensionInfo = &dimensionInfo[0];
+               size_t iLane = 0;
+               do {
+                  if(BagEbm { 0 } == replication) {
+                     replication = 1;
+                     if(nullptr != pSampleReplication) {
+                        const BagEbm * pSampleReplicationOriginal = pSampleReplication;
+                        bool isItemTraining;
                         do {
-                           size_t cCompleteAdvanced = cAdvances / pDimensionInfo->m_cItemsPerBitPackFrom;
-                           pDimensionInfo->m_iShiftFrom -= static_cast<ptrdiff_t>(cAdvances % pDimensionInfo->m_cItemsPerBitPackFrom);
-                           if(pDimensionInfo->m_iShiftFrom < ptrdiff_t { 0 }) {
-                              ++cCompleteAdvanced;
-                              pDimensionInfo->m_iShiftFrom += pDimensionInfo->m_cItemsPerBitPackFrom;
-                           }
-                           pDimensionInfo->m_pInputData += cCompleteAdvanced;
-
-                           ++pDimensionInfo;
-                        } while(pDimensionInfoInit != pDimensionInfo);
+                           do {
+                              replication = *pSampleReplication;
+                              ++pSampleReplication;
+                           } while(BagEbm { 0 } == replication);
+                           isItemTraining = BagEbm { 0 } < replication;
+                        } while(isLoopTraining != isItemTraining);
+                        const size_t cAdvances = pSampleReplication - pSampleReplicationOriginal - 1;
+                        if(0 != cAdvances) {
+                           InputDataPointerAndCountBins * pDimensionInfo = &dimensionInfo[0];
+                           do {
+                              size_t cCompleteAdvanced = cAdvances / pDimensionInfo->m_cItemsPerBitPackFrom;
+                              pDimensionInfo->m_iShiftFrom -= static_cast<ptrdiff_t>(cAdvances % pDimensionInfo->m_cItemsPerBitPackFrom);
+                              if(pDimensionInfo->m_iShiftFrom < ptrdiff_t { 0 }) {
+                                 ++cCompleteAdvanced;
+                                 pDimensionInfo->m_iShiftFrom += pDimensionInfo->m_cItemsPerBitPackFrom;
+                              }
+                              pDimensionInfo->m_pInputData += cCompleteAdvanced;
+
+                              ++pDimensionInfo;
+                           } while(pDimensionInfoInit != pDimensionInfo);
+                        }
                      }
-                  }
 
-                  size_t tensorIndex = 0;
-                  size_t tensorMultiple = 1;
-                  InputDataPointerAndCountBins * pDimensionInfo = &dimensionInfo[0];
-                  do {
-                     const SharedStorageDataType indexDataCombined = *pDimensionInfo->m_pInputData;
-                     EBM_ASSERT(pDimensionInfo->m_iShiftFrom * pDimensionInfo->m_cBitsPerItemMaxFrom < k_cBitsForSharedStorageType);
-                     const size_t iData = static_cast<size_t>(indexDataCombined >> 
-                        (pDimensionInfo->m_iShiftFrom * pDimensionInfo->m_cBitsPerItemMaxFrom)) & 
-                        pDimensionInfo->m_maskBitsFrom;
-
-                     // we check our dataSet when we get the header, and cBins has been checked to fit into size_t
-                     EBM_ASSERT(iData < pDimensionInfo->m_cBins);
-
-                     pDimensionInfo->m_iShiftFrom -= 1;
-                     if(pDimensionInfo->m_iShiftFrom < ptrdiff_t { 0 }) {
-                        pDimensionInfo->m_pInputData += 1;
-                        pDimensionInfo->m_iShiftFrom += pDimensionInfo->m_cItemsPerBitPackFrom;
-                     }
-
-                     // we check for overflows during Term construction, but let's check here again
-                     EBM_ASSERT(!IsMultiplyError(tensorMultiple, pDimensionInfo->m_cBins));
-
-                     // this can't overflow if the multiplication below doesn't overflow, and we checked for that above
-                     tensorIndex += tensorMultiple * iData;
-                     tensorMultiple *= pDimensionInfo->m_cBins;
-
-                     ++pDimensionInfo;
-                  } while(pDimensionInfoInit != pDimensionInfo);
-
-                  // during term construction we check that the maximum tensor index fits into StorageDataType
-                  EBM_ASSERT(!IsConvertError<StorageDataType>(tensorIndex));
-                  iTensor = static_cast<StorageDataType>(tensorIndex);
-               }
+                     size_t tensorIndex = 0;
+                     size_t tensorMultiple = 1;
+                     InputDataPointerAndCountBins * pDimensionInfo = &dimensionInfo[0];
+                     do {
+                        const SharedStorageDataType indexDataCombined = *pDimensionInfo->m_pInputData;
+                        EBM_ASSERT(pDimensionInfo->m_iShiftFrom * pDimensionInfo->m_cBitsPerItemMaxFrom < k_cBitsForSharedStorageType);
+                        const size_t iData = static_cast<size_t>(indexDataCombined >> 
+                           (pDimensionInfo->m_iShiftFrom * pDimensionInfo->m_cBitsPerItemMaxFrom)) & 
+                           pDimensionInfo->m_maskBitsFrom;
+
+                        // we check our dataSet when we get the header, and cBins has been checked to fit into size_t
+                        EBM_ASSERT(iData < pDimensionInfo->m_cBins);
+
+                        pDimensionInfo->m_iShiftFrom -= 1;
+                        if(pDimensionInfo->m_iShiftFrom < ptrdiff_t { 0 }) {
+                           pDimensionInfo->m_pInputData += 1;
+                           pDimensionInfo->m_iShiftFrom += pDimensionInfo->m_cItemsPerBitPackFrom;
+                        }
+
+                        // we check for overflows during Term construction, but let's check here again
+                        EBM_ASSERT(!IsMultiplyError(tensorMultiple, pDimensionInfo->m_cBins));
+
+                        // this can't overflow if the multiplication below doesn't overflow, and we checked for that above
+                        tensorIndex += tensorMultiple * iData;
+                        tensorMultiple *= pDimensionInfo->m_cBins;
+
+                        ++pDimensionInfo;
+                     } while(pDimensionInfoInit != pDimensionInfo);
+
+                     // during term construction we check that the maximum tensor index fits into StorageDataType
+                     EBM_ASSERT(!IsConvertError<StorageDataType>(tensorIndex));
+                     iTensor = static_cast<StorageDataType>(tensorIndex);
+                  }
 
-               EBM_ASSERT(0 != replication);
-               EBM_ASSERT(0 < replication && 0 < direction || replication < 0 && direction < 0);
-               replication -= direction;
+                  EBM_ASSERT(0 != replication);
+                  EBM_ASSERT(0 < replication && 0 < direction || replication < 0 && direction < 0);
+                  replication -= direction;
 
-               EBM_ASSERT(0 <= cShiftTo);
-               EBM_ASSERT(static_cast<size_t>(cShiftTo) < k_cBitsForStorageType);
-               // the tensor index needs to fit in memory, but concivably StorageDataType does not
-               bits |= iTensor << cShiftTo;
+                  EBM_ASSERT(0 <= cShiftTo);
+                  EBM_ASSERT(static_cast<size_t>(cShiftTo) < k_cBitsForStorageType);
+                  // the tensor index needs to fit in memory, but concivably StorageDataType does not
+                  pInputDataTo[iLane] |= iTensor << cShiftTo;
+                  ++iLane;
+               } while(cLanesTo != iLane);
                cShiftTo -= cBitsPerItemMaxTo;
             } while(ptrdiff_t { 0 } <= cShiftTo);
             cShiftTo = cShiftResetTo;
-            *pInputDataTo = bits;
-            ++pInputDataTo;
+            pInputDataTo += cLanesTo;
+            if(pDregsEndTo == pInputDataTo) {
+               cLanesTo = cBitPackLanes;
+            }
          } while(pInputDataToEnd != pInputDataTo);
          EBM_ASSERT(0 == replication);
+
+         while(size_t { 0 } != cExpanded) {
+            --cExpanded;
+            free(aaExpanded[cExpanded]);
+         }
       }
       ++ppTerm;
    } while(ppTermsEnd != ppTerm);
@@ -518,6 +606,167 @@ free_all:
 }
 WARNING_POP
 
+INLINE_RELEASE_UNTEMPLATED static SparseInputDataBoosting ** ConstructSparseInputData(
+   const unsigned char * const pDataSetShared,
+   const size_t cSharedSamples,
+   const BagEbm * const aBag,
+   const size_t cSetSamples,
+   const IntEbm * const aiTermFeatures,
+   const size_t cTerms,
+   const Term * const * const apTerms
+) {
+   LOG_0(Trace_Info, "Entered DataSetBoosting::ConstructSparseInputData");
+
+   UNUSED(cSharedSamples); // only used in asserts
+   UNUSED(cSetSamples); // only used in asserts
+
+   EBM_ASSERT(nullptr != pDataSetShared);
+   EBM_ASSERT(1 <= cSetSamples);
+   EBM_ASSERT(1 <= cTerms);
+   EBM_ASSERT(nullptr != apTerms);
+
+   if(IsMultiplyError(sizeof(SparseInputDataBoosting *), cTerms)) {
+      LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructSparseInputData IsMultiplyError(sizeof(SparseInputDataBoosting *), cTerms)");
+      return nullptr;
+   }
+   SparseInputDataBoosting ** const aaSparseInputData = 
+      static_cast<SparseInputDataBoosting **>(malloc(sizeof(SparseInputDataBoosting *) * cTerms));
+   if(nullptr == aaSparseInputData) {
+      LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructSparseInputData nullptr == aaSparseInputData");
+      return nullptr;
+   }
+
+   const IntEbm * piTermFeatures = aiTermFeatures;
+
+   size_t iTerm = 0;
+   do {
+      aaSparseInputData[iTerm] = nullptr;
+
+      const Term * const pTerm = apTerms[iTerm];
+      EBM_ASSERT(nullptr != pTerm);
+
+      const IntEbm * const piTermFeaturesEnd = piTermFeatures + pTerm->GetCountDimensions();
+      if(size_t { 1 } == pTerm->GetCountRealDimensions()) {
+         // find the one feature with more than 1 bin.  The others do not affect the tensor index
+         const TermFeature * pTermFeature = pTerm->GetTermFeatures();
+         while(pTermFeature->m_pFeature->GetCountBins() <= size_t { 1 }) {
+            ++piTermFeatures;
+            ++pTermFeature;
+         }
+         const IntEbm indexFeature = *piTermFeatures;
+         EBM_ASSERT(!IsConvertError<size_t>(indexFeature)); // we converted it previously
+         const size_t iFeature = static_cast<size_t>(indexFeature);
+
+         bool bMissing;
+         bool bUnknown;
+         bool bNominal;
+         bool bSparse;
+         SharedStorageDataType cBinsUnused;
+         SharedStorageDataType defaultValSparse;
+         size_t cNonDefaultsSparse;
+         const void * pInputDataFrom = GetDataSetSharedFeature(
+            pDataSetShared,
+            iFeature,
+            &bMissing,
+            &bUnknown,
+            &bNominal,
+            &bSparse,
+            &cBinsUnused,
+            &defaultValSparse,
+            &cNonDefaultsSparse
+         );
+         EBM_ASSERT(nullptr != pInputDataFrom);
+
+         if(bSparse) {
+            const SparseFeatureDataSetSharedEntry * const aNonDefaultsFrom = 
+               static_cast<const SparseFeatureDataSetSharedEntry *>(pInputDataFrom);
+            const SparseFeatureDataSetSharedEntry * const pNonDefaultsFromEnd = &aNonDefaultsFrom[cNonDefaultsSparse];
+
+            // bagged samples can be replicated, so count how many entries the training set will need
+            size_t cNonDefaultsTo = 0;
+            const SparseFeatureDataSetSharedEntry * pNonDefaultFrom = aNonDefaultsFrom;
+            while(pNonDefaultsFromEnd != pNonDefaultFrom) {
+               const BagEbm replication = nullptr == aBag ? BagEbm { 1 } : aBag[pNonDefaultFrom->m_iSample];
+               if(BagEbm { 0 } < replication) {
+                  cNonDefaultsTo += static_cast<size_t>(replication);
+               }
+               ++pNonDefaultFrom;
+            }
+            EBM_ASSERT(cNonDefaultsTo <= cSetSamples);
+
+            const size_t cBytesSparseHeader = offsetof(SparseInputDataBoosting, m_nonDefaults);
+            if(IsMultiplyError(sizeof(SparseEntryBoosting), cNonDefaultsTo) ||
+               IsAddError(cBytesSparseHeader, sizeof(SparseEntryBoosting) * cNonDefaultsTo)) 
+            {
+               LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructSparseInputData IsMultiplyError(sizeof(SparseEntryBoosting), cNonDefaultsTo)");
+               goto free_all;
+            }
+            SparseInputDataBoosting * const pSparse = static_cast<SparseInputDataBoosting *>(
+               malloc(cBytesSparseHeader + sizeof(SparseEntryBoosting) * cNonDefaultsTo));
+            if(nullptr == pSparse) {
+               LOG_0(Trace_Warning, "WARNING DataSetBoosting::ConstructSparseInputData nullptr == pSparse");
+               goto free_all;
+            }
+            aaSparseInputData[iTerm] = pSparse;
+
+            pSparse->m_iDefaultBin = static_cast<size_t>(defaultValSparse);
+            pSparse->m_cNonDefaults = cNonDefaultsTo;
+
+            // walk the bag in the same order as ConstructInputData to translate shared sample indexes into
+            // training set sample indexes
+            SparseEntryBoosting * pNonDefaultTo = ArrayToPointer(pSparse->m_nonDefaults);
+            pNonDefaultFrom = aNonDefaultsFrom;
+            size_t iSampleTo = 0;
+            size_t iSampleFrom = 0;
+            while(pNonDefaultsFromEnd != pNonDefaultFrom) {
+               const size_t iSampleNonDefault = static_cast<size_t>(pNonDefaultFrom->m_iSample);
+               EBM_ASSERT(iSampleNonDefault < cSharedSamples);
+               if(nullptr == aBag) {
+                  iSampleTo = iSampleNonDefault;
+               } else {
+                  while(iSampleNonDefault != iSampleFrom) {
+                     const BagEbm replication = aBag[iSampleFrom];
+                     if(BagEbm { 0 } < replication) {
+                        iSampleTo += static_cast<size_t>(replication);
+                     }
+                     ++iSampleFrom;
+                  }
+               }
+               const BagEbm replication = nullptr == aBag ? BagEbm { 1 } : aBag[iSampleNonDefault];
+               if(BagEbm { 0 } < replication) {
+                  const size_t iBin = static_cast<size_t>(pNonDefaultFrom->m_nonDefaultVal);
+                  BagEbm iReplication = 0;
+                  do {
+                     EBM_ASSERT(iSampleTo < cSetSamples);
+                     pNonDefaultTo->m_iSample = iSampleTo;
+                     pNonDefaultTo->m_iBin = iBin;
+                     ++pNonDefaultTo;
+                     ++iSampleTo;
+                     ++iReplication;
+                  } while(replication != iReplication);
+               }
+               iSampleFrom = iSampleNonDefault + size_t { 1 };
+               ++pNonDefaultFrom;
+            }
+            EBM_ASSERT(&ArrayToPointer(pSparse->m_nonDefaults)[cNonDefaultsTo] == pNonDefaultTo);
+         }
+      }
+      piTermFeatures = piTermFeaturesEnd;
+      ++iTerm;
+   } while(cTerms != iTerm);
+
+   LOG_0(Trace_Info, "Exited DataSetBoosting::ConstructSparseInputData");
+   return aaSparseInputData;
+
+free_all:
+   while(size_t { 0 } != iTerm) {
+      --iTerm;
+      free(aaSparseInputData[iTerm]);
+   }
+   free(aaSparseInputData);
+   return nullptr;
+}
+
 ErrorEbm DataSetBoosting::Initialize(
    const size_t cScores,
    const bool bAllocateGradients,
@@ -532,15 +781,21 @@ ErrorEbm DataSetBoosting::Initialize(
    const size_t cSetSamples,
    const IntEbm * const aiTermFeatures,
    const size_t cTerms,
-   const Term * const * const apTerms
+   const Term * const * const apTerms,
+   const size_t cBitPackLanes,
+   const DataSetBoosting * const pDataSetInputData
 ) {
    EBM_ASSERT(nullptr != pDataSetShared);
    EBM_ASSERT(BagEbm { -1 } == direction || BagEbm { 1 } == direction);
+   // only training sets that hold every sample of the dataset are identical, so only they can be shared
+   EBM_ASSERT(nullptr == pDataSetInputData || (BagEbm { 1 } == direction && nullptr == aBag));
+   EBM_ASSERT(1 <= cBitPackLanes);
 
    EBM_ASSERT(nullptr == m_aGradientsAndHessians);
    EBM_ASSERT(nullptr == m_aSampleScores);
    EBM_ASSERT(nullptr == m_aTargetData);
    EBM_ASSERT(nullptr == m_aaInputData);
+   EBM_ASSERT(nullptr == m_aaSparseInputData);
 
    LOG_0(Trace_Info, "Entered DataSetBoosting::Initialize");
 
@@ -556,7 +811,7 @@ ErrorEbm DataSetBoosting::Initialize(
          EBM_ASSERT(!bAllocateHessians);
       }
       if(bAllocateSampleScores) {
-         FloatFast * const aSampleScores = ConstructSampleScores(
+         FloatScore * const aSampleScores = ConstructSampleScores(
             cScores, 
             direction, 
             aBag, 
@@ -569,12 +824,20 @@ ErrorEbm DataSetBoosting::Initialize(
          }
          m_aSampleScores = aSampleScores;
       }
-      if(bAllocateTargetData) {
+      if(bAllocateTargetData && nullptr != pDataSetInputData) {
+         // the targets of a training set that holds every sample are the same for every booster too
+         EBM_ASSERT(cSetSamples == pDataSetInputData->m_cSamples);
+         EBM_ASSERT(nullptr != pDataSetInputData->m_aTargetData);
+         m_aTargetData = pDataSetInputData->m_aTargetData;
+         m_cBytesTargetsPerSample = pDataSetInputData->m_cBytesTargetsPerSample;
+         m_bSharedInputData = true;
+      } else if(bAllocateTargetData) {
          void * const aTargetData = ConstructTargetData(
             pDataSetShared,
             direction,
             aBag,
-            cSetSamples
+            cSetSamples,
+            &m_cBytesTargetsPerSample
          );
          if(nullptr == aTargetData) {
             LOG_0(Trace_Warning, "WARNING Exited DataSetBoosting::Initialize nullptr == aTargetData");
@@ -582,7 +845,47 @@ ErrorEbm DataSetBoosting::Initialize(
          }
          m_aTargetData = aTargetData;
       }
-      if(0 != cTerms) {
+      if(0 != cTerms && nullptr != pDataSetInputData) {
+         EBM_ASSERT(cSetSamples == pDataSetInputData->m_cSamples);
+         EBM_ASSERT(cTerms == pDataSetInputData->m_cTerms);
+         EBM_ASSERT(cBitPackLanes == pDataSetInputData->m_cBitPackLanes);
+         EBM_ASSERT(nullptr != pDataSetInputData->m_aaInputData);
+         m_aaInputData = pDataSetInputData->m_aaInputData;
+         m_aaSparseInputData = pDataSetInputData->m_aaSparseInputData;
+         m_bSharedInputData = true;
+         m_cTerms = cTerms;
+         m_cBitPackLanes = cBitPackLanes;
+      } else if(0 != cTerms) {
+         m_cTerms = cTerms; // only needed if nullptr != m_aaInputData or nullptr != m_aaSparseInputData
+         m_cBitPackLanes = cBitPackLanes;
+
+         if(BagEbm { 1 } == direction) {
+            // only the training set calculates bin sums, so the validation set does not need the sparse form
+            SparseInputDataBoosting ** const aaSparseInputData = ConstructSparseInputData(
+               pDataSetShared,
+               cSharedSamples,
+               aBag,
+               cSetSamples,
+               aiTermFeatures,
+               cTerms,
+               apTerms
+            );
+            if(nullptr == aaSparseInputData) {
+               LOG_0(Trace_Warning, "WARNING Exited DataSetBoosting::Initialize nullptr == aaSparseInputData");
+               return Error_OutOfMemory;
+            }
+            size_t iTerm = 0;
+            while(cTerms != iTerm && nullptr == aaSparseInputData[iTerm]) {
+               ++iTerm;
+            }
+            if(cTerms == iTerm) {
+               // keep nullptr when no term is sparse so that the booster can skip the sparse bookkeeping
+               free(aaSparseInputData);
+            } else {
+               m_aaSparseInputData = aaSparseInputData;
+            }
+         }
+
          StorageDataType ** const aaInputData = ConstructInputData(
             pDataSetShared,
             cSharedSamples,
@@ -591,14 +894,15 @@ ErrorEbm DataSetBoosting::Initialize(
             cSetSamples,
             aiTermFeatures,
             cTerms,
-            apTerms
+            apTerms,
+            cBitPackLanes,
+            m_aaSparseInputData
          );
          if(nullptr == aaInputData) {
             LOG_0(Trace_Warning, "WARNING Exited DataSetBoosting::Initialize nullptr == aaInputData");
             return Error_OutOfMemory;
          }
          m_aaInputData = aaInputData;
-         m_cTerms = cTerms; // only needed if nullptr != m_aaInputData
       }
       m_cSamples = cSetSamples;
    }
@@ -613,6 +917,13 @@ void DataSetBoosting::Destruct() {
 
    free(m_aGradientsAndHessians);
    free(m_aSampleScores);
+
+   if(m_bSharedInputData) {
+      // the BoosterCore that packed the input data and the targets frees them
+      LOG_0(Trace_Info, "Exited DataSetBoosting::Destruct");
+      return;
+   }
+
    free(m_aTargetData);
 
    if(nullptr != m_aaInputData) {
@@ -626,6 +937,17 @@ void DataSetBoosting::Destruct() {
       free(m_aaInputData);
    }
 
+   if(nullptr != m_aaSparseInputData) {
+      EBM_ASSERT(1 <= m_cTerms);
+      SparseInputDataBoosting ** paSparseInputData = m_aaSparseInputData;
+      const SparseInputDataBoosting * const * const paSparseInputDataEnd = m_aaSparseInputData + m_cTerms;
+      do {
+         free(*paSparseInputData);
+         ++paSparseInputData;
+      } while(paSparseInputDataEnd != paSparseInputData);
+      free(m_aaSparseInputData);
+   }
+
    LOG_0(Trace_Info, "Exited DataSetBoosting::Destruct");
 }
 
@@ -10,7 +10,7 @@
 
 #include "libebm.h" // ErrorEbm
 #include "logging.h" // EBM_ASSERT
-#include "common_c.h" // FloatFast
+#include "common_c.h" // FloatFast, FloatScore
 #include "bridge_c.h" // StorageDataType
 #include "zones.h"
 
@@ -21,13 +21,43 @@ namespace DEFINED_ZONE_NAME {
 
 class Term;
 
+struct SparseEntryBoosting final {
+   size_t m_iSample;
+   size_t m_iBin;
+};
+static_assert(std::is_standard_layout<SparseEntryBoosting>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<SparseEntryBoosting>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+
+// Main terms on features that the shared dataset stores sparsely keep a list of the non-default samples in the
+// order of the training set so that BinSumsBoostingSparse can skip over the default bin.  The training set keeps
+// no packed copy of these terms, so ApplyTermUpdate works from this list too
+struct SparseInputDataBoosting final {
+   size_t m_iDefaultBin;
+   size_t m_cNonDefaults;
+
+   // IMPORTANT: m_nonDefaults must be in the last position for the struct hack and this must be standard layout
+   SparseEntryBoosting m_nonDefaults[1];
+};
+static_assert(std::is_standard_layout<SparseInputDataBoosting>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<SparseInputDataBoosting>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+
 class DataSetBoosting final {
    FloatFast * m_aGradientsAndHessians;
-   FloatFast * m_aSampleScores;
+   FloatScore * m_aSampleScores;
    void * m_aTargetData;
+   size_t m_cBytesTargetsPerSample;
    StorageDataType * * m_aaInputData;
+   SparseInputDataBoosting * * m_aaSparseInputData;
+   // the boosters made by CreateBoosterBags borrow the input data and targets of the first booster instead of
+   // building their own
+   bool m_bSharedInputData;
    size_t m_cSamples;
    size_t m_cTerms;
+   size_t m_cBitPackLanes;
 
 public:
 
@@ -40,9 +70,13 @@ public:
       m_aGradientsAndHessians = nullptr;
       m_aSampleScores = nullptr;
       m_aTargetData = nullptr;
+      m_cBytesTargetsPerSample = 0;
       m_aaInputData = nullptr;
+      m_aaSparseInputData = nullptr;
+      m_bSharedInputData = false;
       m_cSamples = 0;
       m_cTerms = 0;
+      m_cBitPackLanes = 1;
    }
 
    void Destruct();
@@ -61,7 +95,9 @@ public:
       const size_t cSetSamples,
       const IntEbm * const aiTermFeatures,
       const size_t cTerms,
-      const Term * const * const apTerms
+      const Term * const * const apTerms,
+      const size_t cBitPackLanes,
+      const DataSetBoosting * const pDataSetInputData
    );
 
    inline bool IsGradientsAndHessiansNull() {
@@ -75,20 +111,36 @@ public:
    inline const FloatFast * GetGradientsAndHessiansPointer() const {
       return m_aGradientsAndHessians;
    }
-   inline FloatFast * GetSampleScores() {
+   inline FloatScore * GetSampleScores() {
       return m_aSampleScores;
    }
    inline const void * GetTargetDataPointer() const {
       return m_aTargetData;
    }
+   inline size_t GetCountBytesTargetsPerSample() const {
+      // classification targets are StorageDataType and regression targets are FloatFast, one per task
+      return m_cBytesTargetsPerSample;
+   }
    inline const StorageDataType * GetInputDataPointer(const size_t iTerm) const {
       EBM_ASSERT(iTerm < m_cTerms);
       EBM_ASSERT(nullptr != m_aaInputData);
+      // nullptr for terms that have a sparse form
       return m_aaInputData[iTerm];
    }
+   inline bool HasSparseInputData() const {
+      return nullptr != m_aaSparseInputData;
+   }
+   inline const SparseInputDataBoosting * GetSparseInputDataPointer(const size_t iTerm) const {
+      EBM_ASSERT(iTerm < m_cTerms);
+      // only the training set keeps the sparse form, and only for terms with a single sparse feature
+      return nullptr == m_aaSparseInputData ? nullptr : m_aaSparseInputData[iTerm];
+   }
    inline size_t GetCountSamples() const {
       return m_cSamples;
    }
+   inline size_t GetCountBitPackLanes() const {
+      return m_cBitPackLanes;
+   }
 };
 static_assert(std::is_standard_layout<DataSetBoosting>::value,
    "We use the struct hack in several places, so disallow non-standard_layout types in general");
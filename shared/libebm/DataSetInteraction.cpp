@@ -6,6 +6,7 @@
 
 #include <stdlib.h> // free
 #include <stddef.h> // size_t, ptrdiff_t
+#include <string.h> // memset
 
 #include "common_cpp.hpp" // INLINE_RELEASE_UNTEMPLATED
 
@@ -67,7 +68,8 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
    const size_t cSharedSamples,
    const BagEbm * const aBag,
    const size_t cSetSamples,
-   const size_t cFeatures
+   const size_t cFeatures,
+   const size_t cBitPackLanes
 ) {
    LOG_0(Trace_Info, "Entered DataSetInteraction::ConstructInputData");
 
@@ -107,11 +109,28 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
          &cNonDefaultsSparse
       );
       EBM_ASSERT(nullptr != aInputDataFrom);
-      EBM_ASSERT(!bSparse); // we don't support sparse yet
 
       EBM_ASSERT(!IsConvertError<size_t>(countBins)); // checked in a previous call to GetDataSetSharedFeature
       const size_t cBins = static_cast<size_t>(countBins);
 
+      // interactions are always 2 or more dimensions, and we do not want to template BinSumsInteraction on which
+      // dimensions are sparse, so we expand sparse features into the dense layout that we build from below
+      SharedStorageDataType * aExpanded = nullptr;
+      if(bSparse && size_t { 1 } < cBins) {
+         aExpanded = ExpandSparseFeature(
+            cSharedSamples,
+            cBins,
+            defaultValSparse,
+            cNonDefaultsSparse,
+            static_cast<const SparseFeatureDataSetSharedEntry *>(aInputDataFrom)
+         );
+         if(nullptr == aExpanded) {
+            LOG_0(Trace_Warning, "WARNING DataSetInteraction::ConstructInputData nullptr == aExpanded");
+            goto free_all;
+         }
+         aInputDataFrom = aExpanded;
+      }
+
       if(cBins <= size_t { 1 }) {
          // we don't need any bits to store 1 bin since it's always going to be the only bin available, and also 
          // we return 0.0 on interactions whenever we find a feature with 1 bin before further processing
@@ -121,6 +140,7 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
             // if we check this here, we can be guaranteed that any inputData will convert to StorageDataType
             // since the shared datastructure would not allow data items equal or greater than cBins
             LOG_0(Trace_Error, "ERROR DataSetInteraction::ConstructInputData IsConvertError<StorageDataType>(cBins - 1)");
+            free(aExpanded);
             goto free_all;
          }
 
@@ -159,11 +179,13 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
 
          if(IsMultiplyError(sizeof(StorageDataType), cDataUnitsTo)) {
             LOG_0(Trace_Warning, "WARNING DataSetInteraction::ConstructInputData IsMultiplyError(sizeof(StorageDataType), cDataUnitsTo)");
+            free(aExpanded);
             goto free_all;
          }
          StorageDataType * pInputDataTo = static_cast<StorageDataType *>(malloc(sizeof(StorageDataType) * cDataUnitsTo));
          if(nullptr == pInputDataTo) {
             LOG_0(Trace_Warning, "WARNING DataSetInteraction::ConstructInputData nullptr == pInputDataTo");
+            free(aExpanded);
             goto free_all;
          }
          *paInputDataTo = pInputDataTo;
@@ -178,56 +200,73 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
 
          ptrdiff_t iShiftFrom = static_cast<ptrdiff_t>((cSharedSamples - 1) % cItemsPerBitPackFrom);
 
-         ptrdiff_t cShiftTo = static_cast<ptrdiff_t>((cSetSamples - 1) % cItemsPerBitPackTo * cBitsPerItemMaxTo);
+         // the dregs are stored sequentially, and after them each block of cBitPackLanes bit packs is interleaved
+         const size_t cDregs = GetCountBitPackDregs(cSetSamples, cItemsPerBitPackTo, cBitPackLanes);
+         const StorageDataType * const pDregsEndTo = pInputDataTo + GetCountBitPacksDregs(cDregs, cItemsPerBitPackTo);
+
          const ptrdiff_t cShiftResetTo = static_cast<ptrdiff_t>((cItemsPerBitPackTo - 1) * cBitsPerItemMaxTo);
+         ptrdiff_t cShiftTo = cShiftResetTo;
+         size_t cLanesTo = cBitPackLanes;
+         if(size_t { 0 } != cDregs) {
+            cShiftTo = static_cast<ptrdiff_t>((cDregs - 1) % cItemsPerBitPackTo * cBitsPerItemMaxTo);
+            cLanesTo = 1;
+         }
          do {
-            StorageDataType bits = 0;
+            EBM_ASSERT(cLanesTo <= static_cast<size_t>(pInputDataToEnd - pInputDataTo));
+            memset(pInputDataTo, 0, sizeof(*pInputDataTo) * cLanesTo);
             do {
-               if(BagEbm { 0 } == replication) {
-                  replication = 1;
-                  if(nullptr != pSampleReplication) {
-                     const BagEbm * pSampleReplicationOriginal = pSampleReplication;
-                     do {
-                        replication = *pSampleReplication;
-                        ++pSampleReplication;
-                     } while(replication <= BagEbm { 0 });
-                     const size_t cAdvances = pSampleReplication - pSampleReplicationOriginal - 1;
-
-                     size_t cCompleteAdvanced = cAdvances / cItemsPerBitPackFrom;
-                     iShiftFrom -= static_cast<ptrdiff_t>(cAdvances % cItemsPerBitPackFrom);
+               size_t iLane = 0;
+               do {
+                  if(BagEbm { 0 } == replication) {
+                     replication = 1;
+                     if(nullptr != pSampleReplication) {
+                        const BagEbm * pSampleReplicationOriginal = pSampleReplication;
+                        do {
+                           replication = *pSampleReplication;
+                           ++pSampleReplication;
+                        } while(replication <= BagEbm { 0 });
+                        const size_t cAdvances = pSampleReplication - pSampleReplicationOriginal - 1;
+
+                        size_t cCompleteAdvanced = cAdvances / cItemsPerBitPackFrom;
+                        iShiftFrom -= static_cast<ptrdiff_t>(cAdvances % cItemsPerBitPackFrom);
+                        if(iShiftFrom < ptrdiff_t { 0 }) {
+                           ++cCompleteAdvanced;
+                           iShiftFrom += cItemsPerBitPackFrom;
+                        }
+                        pInputDataFrom += cCompleteAdvanced;
+                     }
+                     EBM_ASSERT(0 <= iShiftFrom);
+                     EBM_ASSERT(static_cast<size_t>(iShiftFrom * cBitsPerItemMaxFrom) < k_cBitsForSharedStorageType);
+
+                     SharedStorageDataType dataFrom = *pInputDataFrom;
+                     inputData = static_cast<StorageDataType>(dataFrom >> (iShiftFrom * cBitsPerItemMaxFrom)) & maskBitsFrom;
+                     EBM_ASSERT(static_cast<size_t>(inputData) < cBins);
+                     --iShiftFrom;
                      if(iShiftFrom < ptrdiff_t { 0 }) {
-                        ++cCompleteAdvanced;
+                        ++pInputDataFrom;
                         iShiftFrom += cItemsPerBitPackFrom;
                      }
-                     pInputDataFrom += cCompleteAdvanced;
-                  }
-                  EBM_ASSERT(0 <= iShiftFrom);
-                  EBM_ASSERT(static_cast<size_t>(iShiftFrom * cBitsPerItemMaxFrom) < k_cBitsForSharedStorageType);
-
-                  SharedStorageDataType dataFrom = *pInputDataFrom;
-                  inputData = static_cast<StorageDataType>(dataFrom >> (iShiftFrom * cBitsPerItemMaxFrom)) & maskBitsFrom;
-                  EBM_ASSERT(static_cast<size_t>(inputData) < cBins);
-                  --iShiftFrom;
-                  if(iShiftFrom < ptrdiff_t { 0 }) {
-                     ++pInputDataFrom;
-                     iShiftFrom += cItemsPerBitPackFrom;
                   }
-               }
 
-               EBM_ASSERT(1 <= replication);
-               --replication;
+                  EBM_ASSERT(1 <= replication);
+                  --replication;
 
-               EBM_ASSERT(0 <= cShiftTo);
-               EBM_ASSERT(static_cast<size_t>(cShiftTo) < k_cBitsForStorageType);
-               bits |= inputData << cShiftTo;
+                  EBM_ASSERT(0 <= cShiftTo);
+                  EBM_ASSERT(static_cast<size_t>(cShiftTo) < k_cBitsForStorageType);
+                  pInputDataTo[iLane] |= inputData << cShiftTo;
+                  ++iLane;
+               } while(cLanesTo != iLane);
                cShiftTo -= cBitsPerItemMaxTo;
             } while(ptrdiff_t { 0 } <= cShiftTo);
             cShiftTo = cShiftResetTo;
-            *pInputDataTo = bits;
-            ++pInputDataTo;
+            pInputDataTo += cLanesTo;
+            if(pDregsEndTo == pInputDataTo) {
+               cLanesTo = cBitPackLanes;
+            }
          } while(pInputDataToEnd != pInputDataTo);
          EBM_ASSERT(0 == replication);
       }
+      free(aExpanded);
       ++paInputDataTo;
       ++iFeature;
    } while(cFeatures != iFeature);
@@ -272,9 +311,11 @@ ErrorEbm DataSetInteraction::Initialize(
    const BagEbm * const aBag,
    const size_t cSetSamples,
    const size_t cWeights,
-   const size_t cFeatures
+   const size_t cFeatures,
+   const size_t cBitPackLanes
 ) {
    EBM_ASSERT(nullptr != pDataSetShared);
+   EBM_ASSERT(1 <= cBitPackLanes);
 
    EBM_ASSERT(nullptr == m_aGradientsAndHessians); // we expect to start with zeroed values
    EBM_ASSERT(nullptr == m_aaInputData); // we expect to start with zeroed values
@@ -331,13 +372,15 @@ ErrorEbm DataSetInteraction::Initialize(
             cSharedSamples,
             aBag,
             cSetSamples,
-            cFeatures
+            cFeatures,
+            cBitPackLanes
          );
          if(nullptr == aaInputData) {
             return Error_OutOfMemory;
          }
          m_aaInputData = aaInputData;
          m_cFeatures = cFeatures; // only needed if nullptr != m_aaInputData
+         m_cBitPackLanes = cBitPackLanes;
       }
       m_cSamples = cSetSamples;
    }
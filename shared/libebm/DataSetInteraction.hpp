@@ -27,6 +27,7 @@ class DataSetInteraction final {
    StorageDataType * * m_aaInputData;
    size_t m_cSamples;
    size_t m_cFeatures;
+   size_t m_cBitPackLanes;
 
    FloatFast * m_aWeights;
    FloatBig m_weightTotal;
@@ -45,6 +46,7 @@ public:
       m_aaInputData = nullptr;
       m_cSamples = 0;
       m_cFeatures = 0;
+      m_cBitPackLanes = 1;
       m_aWeights = nullptr;
       m_weightTotal = 0;
    }
@@ -57,7 +59,8 @@ public:
       const BagEbm * const aBag,
       const size_t cSetSamples,
       const size_t cWeights,
-      const size_t cFeatures
+      const size_t cFeatures,
+      const size_t cBitPackLanes
    );
 
    INLINE_ALWAYS const FloatFast * GetWeights() const {
@@ -88,6 +91,9 @@ public:
    INLINE_ALWAYS size_t GetCountSamples() const {
       return m_cSamples;
    }
+   INLINE_ALWAYS size_t GetCountBitPackLanes() const {
+      return m_cBitPackLanes;
+   }
 };
 static_assert(std::is_standard_layout<DataSetInteraction>::value,
    "We use the struct hack in several places, so disallow non-standard_layout types in general");
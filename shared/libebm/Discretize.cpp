@@ -7,6 +7,7 @@
 // TODO: use noexcept throughout our codebase (exception extern "C" functions) !  The compiler can optimize functions better if it knows there are no exceptions
 // TODO: review all the C++ library calls, including things like std::abs and verify that none of them throw exceptions, otherwise use the C versions that provide this guarantee
 
+#include <stdlib.h> // malloc, free
 #include <stddef.h> // size_t, ptrdiff_t
 #include <limits> // std::numeric_limits
 #include <string.h> // memcpy
@@ -17,6 +18,9 @@
 #include "zones.h"
 
 #include "common_cpp.hpp" // IsConvertError
+#include "bridge_c.h" // DiscretizeCompareCount_*
+
+#include "compute_accessors.hpp" // GetComputeZone
 
 // TODO: check this file for how we handle subnormal numbers!  It's tricky if we get them
 
@@ -215,6 +219,33 @@ EBM_API_BODY IntEbm EBM_CALLING_CONVENTION DiscretizeOneSample(
    return static_cast<IntEbm>(middle);
 }
 
+// the SIMD zones need at least a few full packs before the call into the zone pays for itself
+static constexpr size_t k_cDiscretizeCompareCountSamplesMin = 16;
+
+// Writes the cuts in sorted order into the implicit binary tree aTree[1...cNodes] where the children of node k
+// are 2k and 2k+1 (the Eytzinger layout).  The top levels of the tree share cache lines, so the first several
+// steps of every search hit memory that is already in L1 even when the full cut array is much larger.
+static void EytzingerFill(
+   double * const aTree,
+   const size_t iNode,
+   const size_t cNodes,
+   const double ** const ppCut,
+   const double * const pCutsEnd
+) {
+   if(cNodes < iNode) {
+      return;
+   }
+   EytzingerFill(aTree, iNode * size_t { 2 }, cNodes, ppCut, pCutsEnd);
+   if(pCutsEnd != *ppCut) {
+      aTree[iNode] = **ppCut;
+      ++*ppCut;
+   } else {
+      // NaN never compares as lower or equal, so the padding behaves like +infinity in the search
+      aTree[iNode] = std::numeric_limits<double>::quiet_NaN();
+   }
+   EytzingerFill(aTree, iNode * size_t { 2 } + size_t { 1 }, cNodes, ppCut, pCutsEnd);
+}
+
 // don't bother using a lock here.  We don't care if an extra log message is written out due to thread parallism
 static int g_cLogEnterDiscretize = 25;
 static int g_cLogExitDiscretize = 25;
@@ -291,7 +322,23 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION Discretize(
    );
 
    ErrorEbm error;
-   
+
+   if(PREDICTABLE(IntEbm { 1 } == countSamples)) {
+      // getting one sample at a time is common when callers discretize row by row.  Copying the cuts or 
+      // calling into a SIMD zone would cost more than the search itself, so go straight to the scalar search.
+      // Anything illegal drops through to the full checks below so that it gets logged.
+      if(LIKELY(nullptr != featureVals && nullptr != binIndexesOut && IntEbm { 0 } <= countCuts &&
+         !IsConvertError<size_t>(countCuts) && !IsMultiplyError(sizeof(*cutsLowerBoundInclusive), static_cast<size_t>(countCuts)) &&
+         (IntEbm { 0 } == countCuts || nullptr != cutsLowerBoundInclusive)))
+      {
+         const double val = *featureVals;
+         *binIndexesOut = IntEbm { 0 } == countCuts ? (UNPREDICTABLE(std::isnan(val)) ? IntEbm { 0 } : IntEbm { 1 }) :
+            DiscretizeOneSample(val, countCuts, cutsLowerBoundInclusive);
+         error = Error_None;
+         goto exit_with_log;
+      }
+   }
+
    if(UNLIKELY(countSamples <= IntEbm { 0 })) {
       if(UNLIKELY(countSamples < IntEbm { 0 })) {
          LOG_0(Trace_Error, "ERROR Discretize countSamples cannot be negative");
@@ -387,6 +434,31 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION Discretize(
       }
 # endif // NDEBUG
 
+#if defined(BRIDGE_AVX2_64) || defined(BRIDGE_AVX512F_64)
+      if(PREDICTABLE(countCuts <= IntEbm { k_cDiscretizeCompareCountCutsMax }) && 
+         k_cDiscretizeCompareCountSamplesMin <= cSamples) 
+      {
+         const int zone = GetComputeZone();
+#ifdef BRIDGE_AVX512F_64
+         if(k_zoneAvx512f == zone) {
+            DiscretizeCompareCount_Avx512f_64(
+               cSamples, featureVals, static_cast<size_t>(countCuts), cutsLowerBoundInclusive, binIndexesOut);
+            error = Error_None;
+            goto exit_with_log;
+         }
+#endif // BRIDGE_AVX512F_64
+#ifdef BRIDGE_AVX2_64
+         if(k_zoneAvx2 == zone) {
+            DiscretizeCompareCount_Avx2_64(
+               cSamples, featureVals, static_cast<size_t>(countCuts), cutsLowerBoundInclusive, binIndexesOut);
+            error = Error_None;
+            goto exit_with_log;
+         }
+#endif // BRIDGE_AVX2_64
+         UNUSED(zone);
+      }
+#endif // BRIDGE_AVX2_64 || BRIDGE_AVX512F_64
+
       if(PREDICTABLE(IntEbm { 1 } == countCuts)) {
          const double cut0 = cutsLowerBoundInclusive[0];
          do {
@@ -947,6 +1019,54 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION Discretize(
       EBM_ASSERT(cCuts < std::numeric_limits<size_t>::max());
       EBM_ASSERT(size_t { 1 } <= cCuts);
       EBM_ASSERT(cCuts <= size_t { std::numeric_limits<ptrdiff_t>::max() });
+
+      if(cCuts <= cSamples) {
+         // building the tree touches every cut once, so only do it when there are enough samples to amortize that
+         size_t cLevels = 0;
+         size_t cNodes = 0;
+         while(cNodes < cCuts) {
+            cNodes = cNodes * size_t { 2 } + size_t { 1 };
+            ++cLevels;
+         }
+         // we checked above that sizeof(double) * cCuts fits, so cNodes + 1 <= 2 * cCuts cannot overflow either
+         EBM_ASSERT(cCuts <= cNodes);
+         const size_t cTreeBytes = sizeof(double) * (cNodes + size_t { 1 });
+         double * const aTree = IsMultiplyError(sizeof(double), cNodes + size_t { 1 }) ? 
+            nullptr : static_cast<double *>(malloc(cTreeBytes));
+         if(nullptr != aTree) {
+            const double * pCut = cutsLowerBoundInclusive;
+            EytzingerFill(aTree, size_t { 1 }, cNodes, &pCut, cutsLowerBoundInclusive + cCuts);
+            EBM_ASSERT(cutsLowerBoundInclusive + cCuts == pCut);
+
+            // the tree is perfect, so every search takes exactly cLevels steps and the leaf we fall out on,
+            // less the number of internal nodes, is the number of cuts that are lower or equal to val
+            const size_t iLeafFirst = cNodes + size_t { 1 };
+            do {
+               const double val = *pVal;
+               size_t iNode = 1;
+               size_t iLevel = cLevels;
+               do {
+                  iNode = iNode * size_t { 2 } + (UNPREDICTABLE(aTree[iNode] <= val) ? size_t { 1 } : size_t { 0 });
+                  --iLevel;
+               } while(LIKELY(size_t { 0 } != iLevel));
+               EBM_ASSERT(iLeafFirst <= iNode && iNode - iLeafFirst <= cCuts);
+               const size_t iBin = UNPREDICTABLE(std::isnan(val)) ? size_t { 0 } : iNode - iLeafFirst + size_t { 1 };
+
+               EBM_ASSERT(static_cast<IntEbm>(iBin) == DiscretizeOneSample(val, countCuts, cutsLowerBoundInclusive));
+
+               *piBin = static_cast<IntEbm>(iBin);
+               ++piBin;
+               ++pVal;
+            } while(LIKELY(pValsEnd != pVal));
+
+            free(aTree);
+            error = Error_None;
+            goto exit_with_log;
+         }
+         // if we could not allocate the tree, fall back to searching the caller's array directly
+         LOG_0(Trace_Warning, "WARNING Discretize could not allocate the search tree");
+      }
+
       const ptrdiff_t highStart = static_cast<ptrdiff_t>(cCuts) - ptrdiff_t { 1 };
 
       // if we're going to runroll our first loop, then we need to ensure that there's a next loop after the first
@@ -32,7 +32,25 @@ namespace DEFINED_ZONE_NAME {
 #error DEFINED_ZONE_NAME must be defined
 #endif // DEFINED_ZONE_NAME
 
-extern ErrorEbm BinSumsBoosting(BinSumsBoostingBridge * const pParams);
+extern ErrorEbm BinSumsBoostingSharded(
+   ThreadPool * const pThreadPool,
+   const size_t cShardsMax,
+   BinBase * const aShardFastBins,
+   const size_t cTensorBins,
+   BinSumsBoostingBridge * const pParams
+);
+
+extern ErrorEbm BinSumsBoostingInnerBags(
+   BinSumsBoostingBridge * const pParams,
+   const size_t cInnerBags,
+   const size_t cBytesPerInnerBag
+);
+
+extern void BinSumsBoostingSparse(
+   const BinBase * const pTotalBin,
+   const SparseInputDataBoosting * const pSparse,
+   BinSumsBoostingBridge * const pParams
+);
 
 extern void TensorTotalsBuild(
    const bool bHessian,
@@ -90,7 +108,7 @@ static ErrorEbm BoostZeroDimensional(
    ErrorEbm error;
 
    BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
-   const size_t cScores = GetCountScores(pBoosterCore->GetCountClasses());
+   const size_t cScores = pBoosterCore->GetCountScores();
 
    EBM_ASSERT(!IsOverflowBinSize<FloatFast>(pBoosterCore->IsHessian(), cScores)); // we check in CreateBooster
    const size_t cBytesPerFastBin = GetBinSize<FloatFast>(pBoosterCore->IsHessian(), cScores);
@@ -104,16 +122,26 @@ static ErrorEbm BoostZeroDimensional(
    params.m_bHessian = pBoosterCore->IsHessian() ? EBM_TRUE : EBM_FALSE;
    params.m_cScores = cScores;
    params.m_cPack = k_cItemsPerBitPackNone;
+   params.m_cBitPackLanes = 1;
    params.m_cSamples = pBoosterCore->GetTrainingSet()->GetCountSamples();
    params.m_aGradientsAndHessians = pBoosterCore->GetTrainingSet()->GetGradientsAndHessiansPointer();
    params.m_aWeights = pInnerBag->GetWeights();
    params.m_pCountOccurrences = pInnerBag->GetCountOccurrences();
+   params.m_cInnerBagsStride = pInnerBag->GetStride();
+   params.m_aSampleBits = pInnerBag->GetSampleBits();
+   params.m_iSampleBitFirst = 0;
    params.m_aFastBins = pBoosterShell->GetBoostingFastBinsTemp();
 #ifndef NDEBUG
    params.m_pDebugFastBinsEnd = IndexBin(pFastBin, cBytesPerFastBin);
    params.m_totalWeightDebug = pInnerBag->GetWeightTotal();
 #endif // NDEBUG
-   error = BinSumsBoosting(&params);
+   error = BinSumsBoostingSharded(
+      pBoosterCore->GetThreadPool(),
+      pBoosterShell->GetCountShards(),
+      pBoosterShell->GetShardFastBins(),
+      size_t { 1 },
+      &params
+   );
    if(Error_None != error) {
       return error;
    }
@@ -127,24 +155,21 @@ static ErrorEbm BoostZeroDimensional(
    pBoosterShell->SetDebugBigBinsEnd(IndexBin(pBigBin, cBytesPerBigBin));
 #endif // NDEBUG
 
-   // TODO: put this into it's own function that converts our fast floats to big floats
-   static_assert(sizeof(FloatBig) == sizeof(FloatFast), "float mismatch");
-   EBM_ASSERT(cBytesPerFastBin == cBytesPerBigBin); // until we switch fast to float datatypes
-   memcpy(pBigBin, pFastBin, cBytesPerFastBin);
+   ConvertFastBinsToBigBins(pBoosterCore->IsHessian(), cScores, pFastBin, pBigBin, size_t { 1 });
 
 
    // TODO: we can exit here back to python to allow caller modification to our histograms
 
 
    Tensor * const pInnerTermUpdate = pBoosterShell->GetInnerTermUpdate();
-   FloatFast * aUpdateScores = pInnerTermUpdate->GetTensorScoresPointer();
+   FloatScore * aUpdateScores = pInnerTermUpdate->GetTensorScoresPointer();
    if(pBoosterCore->IsHessian()) {
       const auto * const pBin = pBigBin->Specialize<FloatBig, true>();
       const auto * const aGradientPairs = pBin->GetGradientPairs();
       if(0 != (BoostFlags_GradientSums & flags)) {
          for(size_t iScore = 0; iScore < cScores; ++iScore) {
             const FloatBig updateScore = EbmStats::ComputeSinglePartitionUpdateGradientSum(aGradientPairs[iScore].m_sumGradients);
-            aUpdateScores[iScore] = SafeConvertFloat<FloatFast>(updateScore);
+            aUpdateScores[iScore] = SafeConvertFloat<FloatScore>(updateScore);
          }
       } else {
          for(size_t iScore = 0; iScore < cScores; ++iScore) {
@@ -152,7 +177,7 @@ static ErrorEbm BoostZeroDimensional(
                aGradientPairs[iScore].m_sumGradients,
                aGradientPairs[iScore].GetHess()
             );
-            aUpdateScores[iScore] = SafeConvertFloat<FloatFast>(updateScore);
+            aUpdateScores[iScore] = SafeConvertFloat<FloatScore>(updateScore);
          }
       }
    } else {
@@ -160,13 +185,13 @@ static ErrorEbm BoostZeroDimensional(
       const auto * const aGradientPairs = pBin->GetGradientPairs();
       if(0 != (BoostFlags_GradientSums & flags)) {
          const FloatBig updateScore = EbmStats::ComputeSinglePartitionUpdateGradientSum(aGradientPairs[0].m_sumGradients);
-         aUpdateScores[0] = SafeConvertFloat<FloatFast>(updateScore);
+         aUpdateScores[0] = SafeConvertFloat<FloatScore>(updateScore);
       } else {
          const FloatBig updateScore = EbmStats::ComputeSinglePartitionUpdate(
             aGradientPairs[0].m_sumGradients,
             pBin->GetWeight()
          );
-         aUpdateScores[0] = SafeConvertFloat<FloatFast>(updateScore);
+         aUpdateScores[0] = SafeConvertFloat<FloatScore>(updateScore);
       }
    }
 
@@ -184,6 +209,8 @@ static ErrorEbm BoostSingleDimensional(
    const size_t iDimension,
    const size_t cSamplesLeafMin,
    const IntEbm countLeavesMax,
+   BinBase * const aFastBinsSummed,
+   const BinBase * const pSparseTotalBin,
    double * const pTotalGain
 ) {
    ErrorEbm error;
@@ -205,34 +232,53 @@ static ErrorEbm BoostSingleDimensional(
    EBM_ASSERT(cBins == pBoosterCore->GetTerms()[iTerm]->GetCountTensorBins());
    EBM_ASSERT(0 == pBoosterCore->GetTerms()[iTerm]->GetCountAuxillaryBins());
 
-   const size_t cScores = GetCountScores(pBoosterCore->GetCountClasses());
+   const size_t cScores = pBoosterCore->GetCountScores();
 
    EBM_ASSERT(!IsOverflowBinSize<FloatFast>(pBoosterCore->IsHessian(), cScores)); // we check in CreateBooster
    const size_t cBytesPerFastBin = GetBinSize<FloatFast>(pBoosterCore->IsHessian(), cScores);
    EBM_ASSERT(!IsMultiplyError(cBytesPerFastBin, cBins));
 
-   BinBase * const aFastBins = pBoosterShell->GetBoostingFastBinsTemp();
-   EBM_ASSERT(nullptr != aFastBins);
-
-   aFastBins->ZeroMem(cBytesPerFastBin, cBins);
-
-   BinSumsBoostingBridge params;
-   params.m_bHessian = pBoosterCore->IsHessian() ? EBM_TRUE : EBM_FALSE;
-   params.m_cScores = cScores;
-   params.m_cPack = pBoosterCore->GetTerms()[iTerm]->GetTermBitPack();
-   params.m_cSamples = pBoosterCore->GetTrainingSet()->GetCountSamples();
-   params.m_aGradientsAndHessians = pBoosterCore->GetTrainingSet()->GetGradientsAndHessiansPointer();
-   params.m_aWeights = pInnerBag->GetWeights();
-   params.m_pCountOccurrences = pInnerBag->GetCountOccurrences();
-   params.m_aPacked = pBoosterCore->GetTrainingSet()->GetInputDataPointer(iTerm);
-   params.m_aFastBins = pBoosterShell->GetBoostingFastBinsTemp();
+   // ApplyTermUpdate may have already built this histogram while it refreshed the gradients, or we may have
+   // summed it along with the histograms of the other inner bags
+   BinBase * aFastBins = aFastBinsSummed;
+   if(nullptr == aFastBins) {
+      aFastBins = pBoosterShell->GetBoostingFastBinsTemp();
+      EBM_ASSERT(nullptr != aFastBins);
+      aFastBins->ZeroMem(cBytesPerFastBin, cBins);
+
+      BinSumsBoostingBridge params;
+      params.m_bHessian = pBoosterCore->IsHessian() ? EBM_TRUE : EBM_FALSE;
+      params.m_cScores = cScores;
+      params.m_cPack = pBoosterCore->GetTerms()[iTerm]->GetTermBitPack();
+      params.m_cSamples = pBoosterCore->GetTrainingSet()->GetCountSamples();
+      params.m_aGradientsAndHessians = pBoosterCore->GetTrainingSet()->GetGradientsAndHessiansPointer();
+      params.m_aWeights = pInnerBag->GetWeights();
+      params.m_pCountOccurrences = pInnerBag->GetCountOccurrences();
+      params.m_cInnerBagsStride = pInnerBag->GetStride();
+      params.m_aSampleBits = pInnerBag->GetSampleBits();
+      params.m_iSampleBitFirst = 0;
+      params.m_aPacked = pBoosterCore->GetTrainingSet()->GetInputDataPointer(iTerm);
+      params.m_cBitPackLanes = pBoosterCore->GetTrainingSet()->GetCountBitPackLanes();
+      params.m_aFastBins = aFastBins;
 #ifndef NDEBUG
-   params.m_pDebugFastBinsEnd = IndexBin(aFastBins, cBytesPerFastBin * cBins);
-   params.m_totalWeightDebug = pInnerBag->GetWeightTotal();
+      params.m_pDebugFastBinsEnd = IndexBin(aFastBins, cBytesPerFastBin * cBins);
+      params.m_totalWeightDebug = pInnerBag->GetWeightTotal();
 #endif // NDEBUG
-   error = BinSumsBoosting(&params);
-   if(Error_None != error) {
-      return error;
+      const SparseInputDataBoosting * const pSparse = pBoosterCore->GetTrainingSet()->GetSparseInputDataPointer(iTerm);
+      if(nullptr != pSparse) {
+         BinSumsBoostingSparse(pSparseTotalBin, pSparse, &params);
+      } else {
+         error = BinSumsBoostingSharded(
+            pBoosterCore->GetThreadPool(),
+            pBoosterShell->GetCountShards(),
+            pBoosterShell->GetShardFastBins(),
+            cBins,
+            &params
+         );
+         if(Error_None != error) {
+            return error;
+         }
+      }
    }
 
    BinBase * const aBigBins = pBoosterShell->GetBoostingBigBins();
@@ -245,16 +291,13 @@ static ErrorEbm BoostSingleDimensional(
    pBoosterShell->SetDebugBigBinsEnd(IndexBin(aBigBins, cBytesPerBigBin * cBins));
 #endif // NDEBUG
 
-   // TODO: put this into it's own function that converts our fast floats to big floats
-   static_assert(sizeof(FloatBig) == sizeof(FloatFast), "float mismatch");
-   EBM_ASSERT(cBytesPerFastBin == cBytesPerBigBin); // until we switch fast to float datatypes
-   memcpy(aBigBins, aFastBins, cBytesPerFastBin * cBins);
+   ConvertFastBinsToBigBins(pBoosterCore->IsHessian(), cScores, aFastBins, aBigBins, cBins);
 
 
    // TODO: we can exit here back to python to allow caller modification to our histograms
 
 
-   EBM_ASSERT(1 <= pBoosterCore->GetTrainingSet()->GetCountSamples());
+   EBM_ASSERT(1 <= pInnerBag->GetCountSamples());
 
    error = PartitionOneDimensionalBoosting(
       pRng,
@@ -263,7 +306,7 @@ static ErrorEbm BoostSingleDimensional(
       iDimension,
       cSamplesLeafMin,
       cSplitsMax,
-      pBoosterCore->GetTrainingSet()->GetCountSamples(),
+      pInnerBag->GetCountSamples(),
       pInnerBag->GetWeightTotal(),
       pTotalGain
    );
@@ -280,6 +323,7 @@ static ErrorEbm BoostMultiDimensional(
    const size_t iTerm,
    const InnerBag * const pInnerBag,
    const size_t cSamplesLeafMin,
+   BinBase * const aFastBinsSummed,
    double * const pTotalGain
 ) {
    LOG_0(Trace_Verbose, "Entered BoostMultiDimensional");
@@ -312,34 +356,48 @@ static ErrorEbm BoostMultiDimensional(
       ++pTermFeature;
    } while(pTermFeaturesEnd != pTermFeature);
 
-   const size_t cScores = GetCountScores(pBoosterCore->GetCountClasses());
+   const size_t cScores = pBoosterCore->GetCountScores();
 
    EBM_ASSERT(!IsOverflowBinSize<FloatFast>(pBoosterCore->IsHessian(), cScores)); // we check in CreateBooster 
    const size_t cBytesPerFastBin = GetBinSize<FloatFast>(pBoosterCore->IsHessian(), cScores);
    EBM_ASSERT(!IsMultiplyError(cBytesPerFastBin, cTensorBins));
 
-   BinBase * const aFastBins = pBoosterShell->GetBoostingFastBinsTemp();
-   EBM_ASSERT(nullptr != aFastBins);
-   
-   aFastBins->ZeroMem(cBytesPerFastBin, cTensorBins);
-
-   BinSumsBoostingBridge params;
-   params.m_bHessian = pBoosterCore->IsHessian() ? EBM_TRUE : EBM_FALSE;
-   params.m_cScores = cScores;
-   params.m_cPack = pBoosterCore->GetTerms()[iTerm]->GetTermBitPack();
-   params.m_cSamples = pBoosterCore->GetTrainingSet()->GetCountSamples();
-   params.m_aGradientsAndHessians = pBoosterCore->GetTrainingSet()->GetGradientsAndHessiansPointer();
-   params.m_aWeights = pInnerBag->GetWeights();
-   params.m_pCountOccurrences = pInnerBag->GetCountOccurrences();
-   params.m_aPacked = pBoosterCore->GetTrainingSet()->GetInputDataPointer(iTerm);
-   params.m_aFastBins = pBoosterShell->GetBoostingFastBinsTemp();
+   // ApplyTermUpdate may have already built this histogram while it refreshed the gradients, or we may have
+   // summed it along with the histograms of the other inner bags
+   BinBase * aFastBins = aFastBinsSummed;
+   if(nullptr == aFastBins) {
+      aFastBins = pBoosterShell->GetBoostingFastBinsTemp();
+      EBM_ASSERT(nullptr != aFastBins);
+      aFastBins->ZeroMem(cBytesPerFastBin, cTensorBins);
+
+      BinSumsBoostingBridge params;
+      params.m_bHessian = pBoosterCore->IsHessian() ? EBM_TRUE : EBM_FALSE;
+      params.m_cScores = cScores;
+      params.m_cPack = pBoosterCore->GetTerms()[iTerm]->GetTermBitPack();
+      params.m_cSamples = pBoosterCore->GetTrainingSet()->GetCountSamples();
+      params.m_aGradientsAndHessians = pBoosterCore->GetTrainingSet()->GetGradientsAndHessiansPointer();
+      params.m_aWeights = pInnerBag->GetWeights();
+      params.m_pCountOccurrences = pInnerBag->GetCountOccurrences();
+      params.m_cInnerBagsStride = pInnerBag->GetStride();
+      params.m_aSampleBits = pInnerBag->GetSampleBits();
+      params.m_iSampleBitFirst = 0;
+      params.m_aPacked = pBoosterCore->GetTrainingSet()->GetInputDataPointer(iTerm);
+      params.m_cBitPackLanes = pBoosterCore->GetTrainingSet()->GetCountBitPackLanes();
+      params.m_aFastBins = aFastBins;
 #ifndef NDEBUG
-   params.m_pDebugFastBinsEnd = IndexBin(aFastBins, cBytesPerFastBin * cTensorBins);
-   params.m_totalWeightDebug = pInnerBag->GetWeightTotal();
+      params.m_pDebugFastBinsEnd = IndexBin(aFastBins, cBytesPerFastBin * cTensorBins);
+      params.m_totalWeightDebug = pInnerBag->GetWeightTotal();
 #endif // NDEBUG
-   error = BinSumsBoosting(&params);
-   if(Error_None != error) {
-      return error;
+      error = BinSumsBoostingSharded(
+         pBoosterCore->GetThreadPool(),
+         pBoosterShell->GetCountShards(),
+         pBoosterShell->GetShardFastBins(),
+         cTensorBins,
+         &params
+      );
+      if(Error_None != error) {
+         return error;
+      }
    }
 
    const size_t cAuxillaryBins = pTerm->GetCountAuxillaryBins();
@@ -359,9 +417,7 @@ static ErrorEbm BoostMultiDimensional(
    pBoosterShell->SetDebugBigBinsEnd(pDebugBigBinsEnd);
 #endif // NDEBUG
 
-   // TODO: put this into it's own function that converts our fast floats to big floats
-   static_assert(sizeof(FloatBig) == sizeof(FloatFast), "float mismatch");
-   memcpy(aBigBins, aFastBins, cBytesPerFastBin * cTensorBins);
+   ConvertFastBinsToBigBins(pBoosterCore->IsHessian(), cScores, aFastBins, aBigBins, cTensorBins);
 
 
 
@@ -548,6 +604,7 @@ static ErrorEbm BoostRandom(
    const InnerBag * const pInnerBag,
    const BoostFlags flags,
    const IntEbm * const aLeavesMax,
+   const BinBase * const pSparseTotalBin,
    double * const pTotalGain
 ) {
    // THIS RANDOM SPLIT FUNCTION IS PRIMARILY USED FOR DIFFERENTIAL PRIVACY EBMs
@@ -563,7 +620,7 @@ static ErrorEbm BoostRandom(
    const size_t cTotalBins = pTerm->GetCountTensorBins();
    EBM_ASSERT(1 <= cTotalBins);
 
-   const size_t cScores = GetCountScores(pBoosterCore->GetCountClasses());
+   const size_t cScores = pBoosterCore->GetCountScores();
 
    EBM_ASSERT(!IsOverflowBinSize<FloatFast>(pBoosterCore->IsHessian(), cScores)); // we check in CreateBooster 
    const size_t cBytesPerFastBin = GetBinSize<FloatFast>(pBoosterCore->IsHessian(), cScores);
@@ -582,15 +639,30 @@ static ErrorEbm BoostRandom(
    params.m_aGradientsAndHessians = pBoosterCore->GetTrainingSet()->GetGradientsAndHessiansPointer();
    params.m_aWeights = pInnerBag->GetWeights();
    params.m_pCountOccurrences = pInnerBag->GetCountOccurrences();
+   params.m_cInnerBagsStride = pInnerBag->GetStride();
+   params.m_aSampleBits = pInnerBag->GetSampleBits();
+   params.m_iSampleBitFirst = 0;
    params.m_aPacked = pBoosterCore->GetTrainingSet()->GetInputDataPointer(iTerm);
+   params.m_cBitPackLanes = pBoosterCore->GetTrainingSet()->GetCountBitPackLanes();
    params.m_aFastBins = pBoosterShell->GetBoostingFastBinsTemp();
 #ifndef NDEBUG
    params.m_pDebugFastBinsEnd = IndexBin(aFastBins, cBytesPerFastBin * cTotalBins);
    params.m_totalWeightDebug = pInnerBag->GetWeightTotal();
 #endif // NDEBUG
-   error = BinSumsBoosting(&params);
-   if(Error_None != error) {
-      return error;
+   const SparseInputDataBoosting * const pSparse = pBoosterCore->GetTrainingSet()->GetSparseInputDataPointer(iTerm);
+   if(nullptr != pSparse) {
+      BinSumsBoostingSparse(pSparseTotalBin, pSparse, &params);
+   } else {
+      error = BinSumsBoostingSharded(
+         pBoosterCore->GetThreadPool(),
+         pBoosterShell->GetCountShards(),
+         pBoosterShell->GetShardFastBins(),
+         cTotalBins,
+         &params
+      );
+      if(Error_None != error) {
+         return error;
+      }
    }
 
    BinBase * const aBigBins = pBoosterShell->GetBoostingBigBins();
@@ -603,10 +675,7 @@ static ErrorEbm BoostRandom(
    pBoosterShell->SetDebugBigBinsEnd(IndexBin(aBigBins, cBytesPerBigBin * cTotalBins));
 #endif // NDEBUG
 
-   // TODO: put this into it's own function that converts our fast floats to big floats
-   static_assert(sizeof(FloatBig) == sizeof(FloatFast), "float mismatch");
-   EBM_ASSERT(cBytesPerFastBin == cBytesPerBigBin); // until we switch fast to float datatypes
-   memcpy(aBigBins, aFastBins, cBytesPerFastBin * cTotalBins);
+   ConvertFastBinsToBigBins(pBoosterCore->IsHessian(), cScores, aFastBins, aBigBins, cTotalBins);
 
 
    // TODO: we can exit here back to python to allow caller modification to our histograms
@@ -632,6 +701,308 @@ static ErrorEbm BoostRandom(
    return Error_None;
 }
 
+struct BoostInnerBagParams final {
+   size_t m_iTerm;
+   BoostFlags m_flags;
+   const IntEbm * m_leavesMax;
+   IntEbm m_lastDimensionLeavesMax;
+   size_t m_cSignificantBinCount;
+   size_t m_iDimensionImportant;
+   size_t m_cSamplesLeafMin;
+   size_t m_cRealDimensions;
+   double m_gainMultiple;
+   bool m_bFusedBins;
+   // when not nullptr, BinSumsInnerBags has summed the histogram of each inner bag into this array
+   BinBase * m_aInnerBagsFastBins;
+   // when not nullptr, the term is sparse and this holds the totals of each inner bag
+   const BinBase * m_aSparseTotalBins;
+};
+
+// sums the histograms of the inner bags from iInnerBagStart up to iInnerBagEnd into
+// pParams->m_aInnerBagsFastBins, reading each sample's gradients and bin index once for all of them
+static ErrorEbm BinSumsInnerBags(
+   BoosterShell * const pBoosterShell,
+   const BoostInnerBagParams * const pParams,
+   const size_t iInnerBagStart,
+   const size_t iInnerBagEnd
+) {
+   EBM_ASSERT(iInnerBagStart < iInnerBagEnd);
+
+   BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
+   const Term * const pTerm = pBoosterCore->GetTerms()[pParams->m_iTerm];
+   const size_t cTensorBins = pTerm->GetCountTensorBins();
+   EBM_ASSERT(1 <= cTensorBins);
+
+   const size_t cScores = pBoosterCore->GetCountScores();
+   EBM_ASSERT(!IsOverflowBinSize<FloatFast>(pBoosterCore->IsHessian(), cScores)); // we check in CreateBooster
+   const size_t cBytesPerFastBin = GetBinSize<FloatFast>(pBoosterCore->IsHessian(), cScores);
+
+   const size_t cBytesPerInnerBag = pBoosterCore->GetCountBytesFastBins();
+   EBM_ASSERT(cBytesPerFastBin * cTensorBins <= cBytesPerInnerBag);
+
+   BinBase * const aFastBins = IndexBin(pParams->m_aInnerBagsFastBins, cBytesPerInnerBag * iInnerBagStart);
+   size_t iInnerBag = iInnerBagStart;
+   do {
+      IndexBin(pParams->m_aInnerBagsFastBins, cBytesPerInnerBag * iInnerBag)->ZeroMem(cBytesPerFastBin, cTensorBins);
+      ++iInnerBag;
+   } while(iInnerBagEnd != iInnerBag);
+
+   const size_t cInnerBags = pBoosterCore->GetCountInnerBags();
+   const DataSetBoosting * const pTrainingSet = pBoosterCore->GetTrainingSet();
+
+   BinSumsBoostingBridge params;
+   params.m_bHessian = pBoosterCore->IsHessian() ? EBM_TRUE : EBM_FALSE;
+   params.m_cScores = cScores;
+   params.m_cPack = pTerm->GetTermBitPack();
+   params.m_cSamples = pTrainingSet->GetCountSamples();
+   params.m_aGradientsAndHessians = pTrainingSet->GetGradientsAndHessiansPointer();
+   params.m_aWeights = pBoosterCore->GetInnerBagsWeights() + iInnerBagStart;
+   params.m_pCountOccurrences = pBoosterCore->GetInnerBagsCountOccurrences() + iInnerBagStart;
+   params.m_cInnerBagsStride = cInnerBags;
+   params.m_aSampleBits = nullptr;
+   params.m_iSampleBitFirst = 0;
+   params.m_aPacked = pTrainingSet->GetInputDataPointer(pParams->m_iTerm);
+   params.m_cBitPackLanes = pTrainingSet->GetCountBitPackLanes();
+   params.m_aFastBins = aFastBins;
+#ifndef NDEBUG
+   params.m_pDebugFastBinsEnd = IndexBin(aFastBins, cBytesPerFastBin * cTensorBins);
+   params.m_totalWeightDebug = 0;
+#endif // NDEBUG
+
+   return BinSumsBoostingInnerBags(&params, iInnerBagEnd - iInnerBagStart, cBytesPerInnerBag);
+}
+
+// sums the gradients, hessians, weights and counts of every sample into one total bin per inner bag.  The default
+// bin of a sparse term is whatever its non-default bins leave of these totals, and since the gradients only change
+// in ApplyTermUpdate, every sparse term boosted before the next update shares them
+static ErrorEbm SumSparseTotalBins(BoosterShell * const pBoosterShell, const size_t cInnerBagsAfterZero) {
+   LOG_0(Trace_Verbose, "Entered SumSparseTotalBins");
+
+   BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
+   const DataSetBoosting * const pTrainingSet = pBoosterCore->GetTrainingSet();
+
+   const size_t cScores = pBoosterCore->GetCountScores();
+   EBM_ASSERT(!IsOverflowBinSize<FloatFast>(pBoosterCore->IsHessian(), cScores)); // we check in CreateBooster
+   const size_t cBytesPerFastBin = GetBinSize<FloatFast>(pBoosterCore->IsHessian(), cScores);
+
+   BinBase * const aSparseTotalBins = pBoosterShell->GetSparseTotalBins();
+   EBM_ASSERT(nullptr != aSparseTotalBins);
+   aSparseTotalBins->ZeroMem(cBytesPerFastBin, cInnerBagsAfterZero);
+
+   size_t iInnerBag = 0;
+   do {
+      const InnerBag * const pInnerBag = pBoosterCore->GetInnerBags()[iInnerBag];
+
+      BinSumsBoostingBridge params;
+      params.m_bHessian = pBoosterCore->IsHessian() ? EBM_TRUE : EBM_FALSE;
+      params.m_cScores = cScores;
+      params.m_cPack = k_cItemsPerBitPackNone;
+      params.m_cSamples = pTrainingSet->GetCountSamples();
+      params.m_aGradientsAndHessians = pTrainingSet->GetGradientsAndHessiansPointer();
+      params.m_aWeights = pInnerBag->GetWeights();
+      params.m_pCountOccurrences = pInnerBag->GetCountOccurrences();
+      params.m_cInnerBagsStride = pInnerBag->GetStride();
+      params.m_aSampleBits = pInnerBag->GetSampleBits();
+      params.m_iSampleBitFirst = 0;
+      params.m_aPacked = nullptr;
+      params.m_cBitPackLanes = pTrainingSet->GetCountBitPackLanes();
+      params.m_aFastBins = IndexBin(aSparseTotalBins, cBytesPerFastBin * iInnerBag);
+#ifndef NDEBUG
+      params.m_pDebugFastBinsEnd = IndexBin(params.m_aFastBins, cBytesPerFastBin);
+      params.m_totalWeightDebug = pInnerBag->GetWeightTotal();
+#endif // NDEBUG
+      const ErrorEbm error = BinSumsBoostingSharded(
+         pBoosterCore->GetThreadPool(),
+         pBoosterShell->GetCountShards(),
+         pBoosterShell->GetShardFastBins(),
+         size_t { 1 },
+         &params
+      );
+      if(Error_None != error) {
+         return error;
+      }
+      ++iInnerBag;
+   } while(cInnerBagsAfterZero != iInnerBag);
+
+   pBoosterShell->SetSparseTotalBinsGeneration(pBoosterCore->GetGradientGeneration());
+
+   LOG_0(Trace_Verbose, "Exited SumSparseTotalBins");
+   return Error_None;
+}
+
+// boosts a single inner bag into pBoosterShell->GetInnerTermUpdate(), adds that into 
+// pBoosterShell->GetTermUpdate(), and adds the normalized gain to *pGainAvg
+static ErrorEbm BoostInnerBag(
+   RandomDeterministic * const pRng,
+   BoosterShell * const pBoosterShell,
+   const size_t iInnerBag,
+   const BoostInnerBagParams * const pParams,
+   double * const pGainAvg
+) {
+   ErrorEbm error;
+
+   const InnerBag * const pInnerBag = pBoosterShell->GetBoosterCore()->GetInnerBags()[iInnerBag];
+
+   BinBase * aFastBinsSummed = nullptr;
+   if(pParams->m_bFusedBins) {
+      aFastBinsSummed = pBoosterShell->GetBoostingFastBinsTemp();
+   } else if(nullptr != pParams->m_aInnerBagsFastBins) {
+      aFastBinsSummed = IndexBin(
+         pParams->m_aInnerBagsFastBins, pBoosterShell->GetBoosterCore()->GetCountBytesFastBins() * iInnerBag);
+   }
+
+   const BinBase * pSparseTotalBin = nullptr;
+   if(nullptr != pParams->m_aSparseTotalBins) {
+      const size_t cScores = pBoosterShell->GetBoosterCore()->GetCountScores();
+      const bool bHessian = pBoosterShell->GetBoosterCore()->IsHessian();
+      EBM_ASSERT(!IsOverflowBinSize<FloatFast>(bHessian, cScores)); // we check in CreateBooster
+      pSparseTotalBin = IndexBin(pParams->m_aSparseTotalBins, GetBinSize<FloatFast>(bHessian, cScores) * iInnerBag);
+   }
+
+   const BoostFlags flags = pParams->m_flags;
+   if(UNLIKELY(IntEbm { 0 } == pParams->m_lastDimensionLeavesMax)) {
+      LOG_0(Trace_Warning, "WARNING GenerateTermUpdate boosting zero dimensional");
+      error = BoostZeroDimensional(pBoosterShell, pInnerBag, flags);
+      if(Error_None != error) {
+         return error;
+      }
+   } else {
+      double gain;
+      if(0 != (BoostFlags_RandomSplits & flags) || 2 < pParams->m_cRealDimensions) {
+         if(size_t { 1 } != pParams->m_cSamplesLeafMin) {
+            LOG_0(Trace_Warning,
+               "WARNING GenerateTermUpdate cSamplesLeafMin is ignored when doing random splitting"
+            );
+         }
+         // THIS RANDOM SPLIT OPTION IS PRIMARILY USED FOR DIFFERENTIAL PRIVACY EBMs
+
+         error = BoostRandom(
+            pRng,
+            pBoosterShell,
+            pParams->m_iTerm,
+            pInnerBag,
+            flags,
+            pParams->m_leavesMax,
+            pSparseTotalBin,
+            &gain
+         );
+         if(Error_None != error) {
+            return error;
+         }
+      } else if(1 == pParams->m_cRealDimensions) {
+         EBM_ASSERT(nullptr != pParams->m_leavesMax); // otherwise we'd use BoostZeroDimensional above
+         EBM_ASSERT(IntEbm { 2 } <= pParams->m_lastDimensionLeavesMax); // otherwise we'd use BoostZeroDimensional above
+         EBM_ASSERT(size_t { 2 } <= pParams->m_cSignificantBinCount); // otherwise we'd use BoostZeroDimensional above
+
+         error = BoostSingleDimensional(
+            pRng,
+            pBoosterShell,
+            pParams->m_iTerm,
+            pParams->m_cSignificantBinCount,
+            pInnerBag,
+            pParams->m_iDimensionImportant,
+            pParams->m_cSamplesLeafMin,
+            pParams->m_lastDimensionLeavesMax,
+            aFastBinsSummed,
+            pSparseTotalBin,
+            &gain
+         );
+         if(Error_None != error) {
+            return error;
+         }
+      } else {
+         error = BoostMultiDimensional(
+            pBoosterShell,
+            pParams->m_iTerm,
+            pInnerBag,
+            pParams->m_cSamplesLeafMin,
+            aFastBinsSummed,
+            &gain
+         );
+         if(Error_None != error) {
+            return error;
+         }
+      }
+
+      // gain should be +inf if there was an overflow in our callees
+      EBM_ASSERT(!std::isnan(gain));
+      EBM_ASSERT(0 <= gain);
+
+      const double weightTotal = static_cast<double>(pInnerBag->GetWeightTotal());
+      EBM_ASSERT(0 < weightTotal); // if all are zeros we assume there are no weights and use the count
+
+      // this could re-promote gain to be +inf again if weightTotal < 1.0
+      // do the sample count inversion here in case adding all the avgeraged gains pushes us into +inf
+      gain = gain / weightTotal * pParams->m_gainMultiple;
+      *pGainAvg += gain;
+      EBM_ASSERT(!std::isnan(*pGainAvg));
+      EBM_ASSERT(0 <= *pGainAvg);
+   }
+
+   return pBoosterShell->GetTermUpdate()->Add(*pBoosterShell->GetInnerTermUpdate());
+}
+
+struct BoostInnerBagsTaskContext final {
+   BoosterShell * m_pBoosterShell;
+   const BoostInnerBagParams * m_pParams;
+   size_t m_cInnerBags;
+   size_t m_cTasks;
+   size_t m_cDimensions;
+   ErrorEbm * m_aErrors;
+   double * m_aGains;
+};
+
+// each task boosts a contiguous block of inner bags.  Task 0 accumulates directly into the caller's shell and
+// the other tasks accumulate into their own thread shell, which the caller then merges in task order
+static void BoostInnerBagsTask(void * const pContextVoid, const size_t iTask) {
+   const BoostInnerBagsTaskContext * const pContext = static_cast<const BoostInnerBagsTaskContext *>(pContextVoid);
+   EBM_ASSERT(iTask < pContext->m_cTasks);
+
+   BoosterShell * pBoosterShell = pContext->m_pBoosterShell;
+   RandomDeterministic * const aInnerBagRngs = pBoosterShell->GetInnerBagRngs();
+   if(size_t { 0 } != iTask) {
+      pBoosterShell = &pBoosterShell->GetThreadShells()[iTask - 1];
+      pBoosterShell->GetTermUpdate()->SetCountDimensions(pContext->m_cDimensions);
+      pBoosterShell->GetTermUpdate()->Reset();
+   }
+   pBoosterShell->GetInnerTermUpdate()->SetCountDimensions(pContext->m_cDimensions);
+   pBoosterShell->GetInnerTermUpdate()->Reset();
+
+   const size_t cInnerBags = pContext->m_cInnerBags;
+   const size_t cTasks = pContext->m_cTasks;
+   const size_t iInnerBagStart = iTask * cInnerBags / cTasks;
+   const size_t iInnerBagEnd = (iTask + size_t { 1 }) * cInnerBags / cTasks;
+   EBM_ASSERT(iInnerBagStart < iInnerBagEnd);
+
+   ErrorEbm error = Error_None;
+   double gainAvg = 0.0;
+   if(nullptr != pContext->m_pParams->m_aInnerBagsFastBins) {
+      error = BinSumsInnerBags(pBoosterShell, pContext->m_pParams, iInnerBagStart, iInnerBagEnd);
+      if(Error_None != error) {
+         pContext->m_aErrors[iTask] = error;
+         pContext->m_aGains[iTask] = gainAvg;
+         return;
+      }
+   }
+   size_t iInnerBag = iInnerBagStart;
+   do {
+      error = BoostInnerBag(
+         &aInnerBagRngs[iInnerBag],
+         pBoosterShell,
+         iInnerBag,
+         pContext->m_pParams,
+         &gainAvg
+      );
+      if(Error_None != error) {
+         break;
+      }
+      ++iInnerBag;
+   } while(iInnerBagEnd != iInnerBag);
+
+   pContext->m_aErrors[iTask] = error;
+   pContext->m_aGains[iTask] = gainAvg;
+}
+
 // we made this a global because if we had put this variable inside the BoosterCore object, then we would need to dereference that before getting 
 // the count.  By making this global we can send a log message incase a bad BoosterCore object is sent into us we only decrease the count if the 
 // count is non-zero, so at worst if there is a race condition then we'll output this log message more times than desired, but we can live with that
@@ -705,6 +1076,12 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION GenerateTermUpdate(
    EBM_ASSERT(nullptr != pBoosterCore->GetTerms());
    Term * const pTerm = pBoosterCore->GetTerms()[iTerm];
 
+   // a histogram that ApplyTermUpdate built for this term.  Boosting any term overwrites the fast bins, so it
+   // can only be used once, and an update through another view of our BoosterCore makes it stale
+   const bool bFusedBins = iTerm == pBoosterShell->GetFusedBinsTermIndex() &&
+      pBoosterCore->GetGradientGeneration() == pBoosterShell->GetFusedBinsGeneration();
+   pBoosterShell->SetFusedBinsTermIndex(BoosterShell::k_illegalTermIndex);
+
    LOG_COUNTED_0(
       pTerm->GetPointerCountLogEnterGenerateTermUpdateMessages(),
       Trace_Info,
@@ -888,93 +1265,103 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION GenerateTermUpdate(
       // are going to remain having 0 splits.
       pBoosterShell->GetInnerTermUpdate()->Reset();
 
+      BoostInnerBagParams params;
+      params.m_iTerm = iTerm;
+      params.m_flags = flags;
+      params.m_leavesMax = leavesMax;
+      params.m_lastDimensionLeavesMax = lastDimensionLeavesMax;
+      params.m_cSignificantBinCount = cSignificantBinCount;
+      params.m_iDimensionImportant = iDimensionImportant;
+      params.m_cSamplesLeafMin = cSamplesLeafMin;
+      params.m_cRealDimensions = cRealDimensions;
+      params.m_gainMultiple = gainMultiple;
+      params.m_bFusedBins = bFusedBins && size_t { 1 } == cInnerBagsAfterZero;
+      params.m_aInnerBagsFastBins = nullptr;
+      if(size_t { 1 } < cInnerBagsAfterZero && IntEbm { 0 } != lastDimensionLeavesMax &&
+         0 == (BoostFlags_RandomSplits & flags) && cRealDimensions <= size_t { 2 } &&
+         nullptr == pBoosterCore->GetTrainingSet()->GetSparseInputDataPointer(iTerm)) {
+         // BoostSingleDimensional and BoostMultiDimensional can start from histograms summed for all the inner
+         // bags in one pass.  This is nullptr if we could not afford the memory
+         params.m_aInnerBagsFastBins = pBoosterShell->GetInnerBagsFastBins();
+      }
+      params.m_aSparseTotalBins = nullptr;
+      if(IntEbm { 0 } != lastDimensionLeavesMax &&
+         nullptr != pBoosterCore->GetTrainingSet()->GetSparseInputDataPointer(iTerm)) {
+         if(pBoosterCore->GetGradientGeneration() != pBoosterShell->GetSparseTotalBinsGeneration()) {
+            error = SumSparseTotalBins(pBoosterShell, cInnerBagsAfterZero);
+            if(Error_None != error) {
+               return error;
+            }
+         }
+         params.m_aSparseTotalBins = pBoosterShell->GetSparseTotalBins();
+      }
+
       EBM_ASSERT(1 <= cInnerBagsAfterZero);
-      const InnerBag * const * const ppInnerBagsEnd = &ppInnerBag[cInnerBagsAfterZero];
-      do {
-         const InnerBag * const pInnerBag = *ppInnerBag;
-         if(UNLIKELY(IntEbm { 0 } == lastDimensionLeavesMax)) {
-            LOG_0(Trace_Warning, "WARNING GenerateTermUpdate boosting zero dimensional");
-            error = BoostZeroDimensional(pBoosterShell, pInnerBag, flags);
+      if(nullptr == pBoosterShell->GetThreadShells()) {
+         if(nullptr != params.m_aInnerBagsFastBins) {
+            error = BinSumsInnerBags(pBoosterShell, &params, 0, cInnerBagsAfterZero);
             if(Error_None != error) {
                return error;
             }
-         } else {
-            double gain;
-            if(0 != (BoostFlags_RandomSplits & flags) || 2 < cRealDimensions) {
-               if(size_t { 1 } != cSamplesLeafMin) {
-                  LOG_0(Trace_Warning,
-                     "WARNING GenerateTermUpdate cSamplesLeafMin is ignored when doing random splitting"
-                  );
-               }
-               // THIS RANDOM SPLIT OPTION IS PRIMARILY USED FOR DIFFERENTIAL PRIVACY EBMs
-
-               error = BoostRandom(
-                  pRng,
-                  pBoosterShell,
-                  iTerm,
-                  pInnerBag,
-                  flags,
-                  leavesMax,
-                  &gain
-               );
-               if(Error_None != error) {
-                  return error;
-               }
-            } else if(1 == cRealDimensions) {
-               EBM_ASSERT(nullptr != leavesMax); // otherwise we'd use BoostZeroDimensional above
-               EBM_ASSERT(IntEbm { 2 } <= lastDimensionLeavesMax); // otherwise we'd use BoostZeroDimensional above
-               EBM_ASSERT(size_t { 2 } <= cSignificantBinCount); // otherwise we'd use BoostZeroDimensional above
-
-               error = BoostSingleDimensional(
-                  pRng,
-                  pBoosterShell,
-                  iTerm,
-                  cSignificantBinCount,
-                  pInnerBag,
-                  iDimensionImportant,
-                  cSamplesLeafMin,
-                  lastDimensionLeavesMax,
-                  &gain
-               );
-               if(Error_None != error) {
-                  return error;
-               }
-            } else {
-               error = BoostMultiDimensional(
-                  pBoosterShell,
-                  iTerm,
-                  pInnerBag,
-                  cSamplesLeafMin,
-                  &gain
+         }
+         // a single thread draws from the caller's generator in bag order like it always has, so the models made
+         // without threads do not change.  The threaded path below cannot reproduce this order since each bag
+         // draws a data dependent number of values
+         size_t iInnerBag = 0;
+         do {
+            error = BoostInnerBag(pRng, pBoosterShell, iInnerBag, &params, &gainAvg);
+            if(Error_None != error) {
+               return error;
+            }
+            ++iInnerBag;
+         } while(cInnerBagsAfterZero != iInnerBag);
+      } else {
+         EBM_ASSERT(nullptr != pBoosterShell->GetInnerBagRngs());
+         const size_t cTasks = pBoosterShell->GetCountThreadShells() + size_t { 1 };
+         EBM_ASSERT(cTasks <= cInnerBagsAfterZero);
+         EBM_ASSERT(cTasks <= k_cThreadsMax);
+
+         // give each inner bag its own generator, seeded in bag order, so that the splits chosen do not
+         // depend on which thread happens to process which bag
+         RandomDeterministic * pInnerBagRng = pBoosterShell->GetInnerBagRngs();
+         const RandomDeterministic * const pInnerBagRngsEnd = &pInnerBagRng[cInnerBagsAfterZero];
+         do {
+            pInnerBagRng->Initialize(pRng->Next(std::numeric_limits<uint64_t>::max()));
+            ++pInnerBagRng;
+         } while(pInnerBagRngsEnd != pInnerBagRng);
+
+         ErrorEbm aErrors[k_cThreadsMax];
+         double aGains[k_cThreadsMax];
+
+         BoostInnerBagsTaskContext context;
+         context.m_pBoosterShell = pBoosterShell;
+         context.m_pParams = &params;
+         context.m_cInnerBags = cInnerBagsAfterZero;
+         context.m_cTasks = cTasks;
+         context.m_cDimensions = cDimensions;
+         context.m_aErrors = aErrors;
+         context.m_aGains = aGains;
+
+         pBoosterCore->GetThreadPool()->Run(cTasks, BoostInnerBagsTask, &context);
+
+         // combine in task order so that the result is deterministic for any given number of threads
+         size_t iTask = 0;
+         do {
+            if(Error_None != aErrors[iTask]) {
+               return aErrors[iTask];
+            }
+            if(size_t { 0 } != iTask) {
+               error = pBoosterShell->GetTermUpdate()->Add(
+                  *pBoosterShell->GetThreadShells()[iTask - 1].GetTermUpdate()
                );
                if(Error_None != error) {
                   return error;
                }
             }
-
-            // gain should be +inf if there was an overflow in our callees
-            EBM_ASSERT(!std::isnan(gain));
-            EBM_ASSERT(0 <= gain);
-
-            const double weightTotal = static_cast<double>(pInnerBag->GetWeightTotal());
-            EBM_ASSERT(0 < weightTotal); // if all are zeros we assume there are no weights and use the count
-
-            // this could re-promote gain to be +inf again if weightTotal < 1.0
-            // do the sample count inversion here in case adding all the avgeraged gains pushes us into +inf
-            gain = gain / weightTotal * gainMultiple;
-            gainAvg += gain;
-            EBM_ASSERT(!std::isnan(gainAvg));
-            EBM_ASSERT(0 <= gainAvg);
-         }
-
-         // TODO : when we thread this code, let's have each thread take a lock and update the combined line segment.  They'll each do it while the 
-         // others are working, so there should be no blocking and our final result won't require adding by the main thread
-         error = pBoosterShell->GetTermUpdate()->Add(*pBoosterShell->GetInnerTermUpdate());
-         if(Error_None != error) {
-            return error;
-         }
-         ++ppInnerBag;
-      } while(ppInnerBagsEnd != ppInnerBag);
+            gainAvg += aGains[iTask];
+            ++iTask;
+         } while(cTasks != iTask);
+      }
 
       // gainAvg is +inf on overflow. It cannot be NaN, but check for that anyways since it's free
       EBM_ASSERT(!std::isnan(gainAvg));
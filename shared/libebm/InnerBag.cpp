@@ -24,6 +24,7 @@ ErrorEbm InnerBag::GenerateSingleInnerBag(
    void * const rng,
    const size_t cSamples,
    const FloatFast * const aWeights,
+   const BagEbm * const aBag,
    InnerBag ** const ppOut
 ) {
    LOG_0(Trace_Verbose, "Entered InnerBag::GenerateSingleInnerBag");
@@ -88,12 +89,46 @@ ErrorEbm InnerBag::GenerateSingleInnerBag(
       cpuRng.Initialize(*pRng); // move the RNG from memory into CPU registers
    }
 
-   size_t iSample = 0;
+   size_t cDraws = cSamples;
+   size_t * aiSelected = nullptr;
+   if(nullptr != aBag) {
+      // list each selected sample once per replication so that we draw from the same samples, in the same 
+      // order, as a booster whose training set holds only the samples selected by aBag
+      cDraws = 0;
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         if(BagEbm { 0 } < aBag[iSample]) {
+            cDraws += static_cast<size_t>(aBag[iSample]);
+         }
+      }
+      EBM_ASSERT(1 <= cDraws); // we would not be called without training samples
+      if(IsMultiplyError(sizeof(size_t), cDraws)) {
+         LOG_0(Trace_Warning, "WARNING InnerBag::GenerateSingleInnerBag IsMultiplyError(sizeof(size_t), cDraws)");
+         return Error_OutOfMemory;
+      }
+      aiSelected = static_cast<size_t *>(malloc(sizeof(size_t) * cDraws));
+      if(nullptr == aiSelected) {
+         LOG_0(Trace_Warning, "WARNING InnerBag::GenerateSingleInnerBag nullptr == aiSelected");
+         return Error_OutOfMemory;
+      }
+      size_t * piSelected = aiSelected;
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         for(BagEbm replication = aBag[iSample]; BagEbm { 0 } < replication; --replication) {
+            *piSelected = iSample;
+            ++piSelected;
+         }
+      }
+      EBM_ASSERT(aiSelected + cDraws == piSelected);
+   }
+
+   size_t iDraw = 0;
    do {
-      const size_t iCountOccurrences = cpuRng.NextFast(cSamples);
+      const size_t iRandom = cpuRng.NextFast(cDraws);
+      const size_t iCountOccurrences = nullptr == aiSelected ? iRandom : aiSelected[iRandom];
       ++aCountOccurrences[iCountOccurrences];
-      ++iSample;
-   } while(cSamples != iSample);
+      ++iDraw;
+   } while(cDraws != iDraw);
+
+   free(aiSelected);
 
    if(nullptr != rng) {
       RandomDeterministic * pRng = reinterpret_cast<RandomDeterministic *>(rng);
@@ -110,7 +145,7 @@ ErrorEbm InnerBag::GenerateSingleInnerBag(
          ++pWeightsInternal;
          ++pCountOccurrences;
       } while(pCountOccurrencesEnd != pCountOccurrences);
-      total = static_cast<FloatBig>(cSamples);
+      total = static_cast<FloatBig>(cDraws);
 #ifndef NDEBUG
       const FloatBig debugTotal = AddPositiveFloatsSafeBig(cSamples, aWeightsInternal);
       EBM_ASSERT(debugTotal * 0.999 <= total && total <= 1.0001 * debugTotal);
@@ -133,15 +168,137 @@ ErrorEbm InnerBag::GenerateSingleInnerBag(
    // to zero though so check it after checking for negative
    EBM_ASSERT(0 != total);
 
+   pRet->m_cSamples = cDraws;
    pRet->m_weightTotal = total;
 
    LOG_0(Trace_Verbose, "Exited InnerBag::GenerateSingleInnerBag");
    return Error_None;
 }
 
+// 1 - 1/e is the expected fraction of distinct samples in a bootstrap sample, so subsampled inner bags
+// hold about as many distinct samples as the inner bags that are sampled with replacement
+static constexpr double k_innerBagSubsample = 0.6321205588285577;
+
+ErrorEbm InnerBag::GenerateSubsampleInnerBag(
+   void * const rng,
+   const size_t cSamples,
+   const FloatFast * const aWeights,
+   const BagEbm * const aBag,
+   InnerBag ** const ppOut
+) {
+   LOG_0(Trace_Verbose, "Entered InnerBag::GenerateSubsampleInnerBag");
+
+   EBM_ASSERT(nullptr != ppOut);
+   EBM_ASSERT(nullptr == *ppOut);
+
+   InnerBag * pRet = static_cast<InnerBag *>(malloc(sizeof(InnerBag)));
+   if(nullptr == pRet) {
+      LOG_0(Trace_Warning, "WARNING InnerBag::GenerateSubsampleInnerBag nullptr == pRet");
+      return Error_OutOfMemory;
+   }
+   pRet->InitializeUnfailing();
+   *ppOut = pRet;
+
+   EBM_ASSERT(1 <= cSamples); // if there were no samples, we wouldn't be called
+
+   const size_t cWords = (cSamples + (k_cSamplesPerSampleBitsWord - size_t { 1 })) / k_cSamplesPerSampleBitsWord;
+   if(IsMultiplyError(sizeof(uint64_t), cWords)) {
+      LOG_0(Trace_Warning, "WARNING InnerBag::GenerateSubsampleInnerBag IsMultiplyError(sizeof(uint64_t), cWords)");
+      return Error_OutOfMemory;
+   }
+   const size_t cBytesSampleBits = sizeof(uint64_t) * cWords;
+   uint64_t * const aSampleBits = static_cast<uint64_t *>(malloc(cBytesSampleBits));
+   if(nullptr == aSampleBits) {
+      LOG_0(Trace_Warning, "WARNING InnerBag::GenerateSubsampleInnerBag nullptr == aSampleBits");
+      return Error_OutOfMemory;
+   }
+   pRet->m_aSampleBits = aSampleBits;
+
+   // we do not own the weights.  They are shared by all the subsampled inner bags
+   pRet->m_aWeights = const_cast<FloatFast *>(aWeights);
+
+   memset(aSampleBits, 0, cBytesSampleBits);
+
+   // with aBag we subsample the distinct samples that it selects, and the weights hold their replication
+   size_t cCandidates = cSamples;
+   if(nullptr != aBag) {
+      cCandidates = 0;
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         cCandidates += BagEbm { 0 } < aBag[iSample] ? size_t { 1 } : size_t { 0 };
+      }
+      EBM_ASSERT(1 <= cCandidates); // we would not be called without training samples
+   }
+
+   size_t cSelectedRemaining = static_cast<size_t>(static_cast<double>(cCandidates) * k_innerBagSubsample);
+   cSelectedRemaining = size_t { 0 } == cSelectedRemaining ? size_t { 1 } : cSelectedRemaining;
+   EBM_ASSERT(cSelectedRemaining <= cCandidates);
+   pRet->m_cSamples = cSelectedRemaining;
+
+   // the compiler understands the internal state of this RNG and can locate its internal state into CPU registers
+   RandomDeterministic cpuRng;
+   if(nullptr == rng) {
+      // Inner bags are not used when building a differentially private model, so
+      // we can use low-quality non-determinism.  Generate a non-deterministic seed
+      uint64_t seed;
+      try {
+         RandomNondeterministic<uint64_t> randomGenerator;
+         seed = randomGenerator.Next(std::numeric_limits<uint64_t>::max());
+      } catch(const std::bad_alloc &) {
+         LOG_0(Trace_Warning, "WARNING InnerBag::GenerateSubsampleInnerBag Out of memory in std::random_device");
+         return Error_OutOfMemory;
+      } catch(...) {
+         LOG_0(Trace_Warning, "WARNING InnerBag::GenerateSubsampleInnerBag Unknown error in std::random_device");
+         return Error_UnexpectedInternal;
+      }
+      cpuRng.Initialize(seed);
+   } else {
+      const RandomDeterministic * const pRng = reinterpret_cast<RandomDeterministic *>(rng);
+      cpuRng.Initialize(*pRng); // move the RNG from memory into CPU registers
+   }
+
+   // select each sample with probability cSelectedRemaining / cSamplesRemaining, which picks exactly
+   // cSelectedRemaining samples with all subsets equally likely
+   size_t cSamplesRemaining = cCandidates;
+   size_t iSample = 0;
+   do {
+      if(nullptr == aBag || BagEbm { 0 } < aBag[iSample]) {
+         const size_t iRandom = cpuRng.NextFast(cSamplesRemaining);
+         const size_t bSelected = UNPREDICTABLE(iRandom < cSelectedRemaining) ? size_t { 1 } : size_t { 0 };
+         cSelectedRemaining -= bSelected;
+         aSampleBits[iSample / k_cSamplesPerSampleBitsWord] |=
+            static_cast<uint64_t>(bSelected) << (iSample % k_cSamplesPerSampleBitsWord);
+         --cSamplesRemaining;
+      }
+      ++iSample;
+   } while(cSamples != iSample);
+   EBM_ASSERT(size_t { 0 } == cSelectedRemaining);
+
+   if(nullptr != rng) {
+      RandomDeterministic * pRng = reinterpret_cast<RandomDeterministic *>(rng);
+      pRng->Initialize(cpuRng); // move the RNG from memory into CPU registers
+   }
+
+   FloatBig total = 0;
+   iSample = 0;
+   do {
+      const FloatBig weight = nullptr == aWeights ? FloatBig { 1 } : static_cast<FloatBig>(aWeights[iSample]);
+      total += weight * static_cast<FloatBig>(GetSampleBit(aSampleBits, iSample));
+      ++iSample;
+   } while(cSamples != iSample);
+   if(std::isnan(total) || std::isinf(total) || total <= 0) {
+      LOG_0(Trace_Warning, "WARNING InnerBag::GenerateSubsampleInnerBag std::isnan(total) || std::isinf(total) || total <= 0");
+      return Error_UserParamVal;
+   }
+   pRet->m_weightTotal = total;
+
+   LOG_0(Trace_Verbose, "Exited InnerBag::GenerateSubsampleInnerBag");
+   return Error_None;
+}
+
 InnerBag * InnerBag::GenerateFlatInnerBag(
    const size_t cSamples,
-   const FloatFast * const aWeights
+   const FloatFast * const aWeights,
+   const BagEbm * const aBag
 ) {
    LOG_0(Trace_Info, "Entered InnerBag::GenerateFlatInnerBag");
 
@@ -154,8 +311,85 @@ InnerBag * InnerBag::GenerateFlatInnerBag(
    }
    pRet->InitializeUnfailing();
 
+   pRet->m_cSamples = cSamples;
    pRet->m_weightTotal = static_cast<FloatBig>(cSamples);
-   if(nullptr != aWeights) {
+   bool bSelectsOnce = nullptr != aBag && nullptr == aWeights;
+   for(size_t iSample = 0; bSelectsOnce && iSample < cSamples; ++iSample) {
+      bSelectsOnce = aBag[iSample] <= BagEbm { 1 };
+   }
+   if(bSelectsOnce) {
+      // Outer bags are usually drawn without replacement, so one bit per sample is enough to select them.  This
+      // keeps the flat bag of each booster from CreateBoosterBags far smaller than its per sample arrays
+      const size_t cWords = (cSamples + (k_cSamplesPerSampleBitsWord - size_t { 1 })) / k_cSamplesPerSampleBitsWord;
+      if(IsMultiplyError(sizeof(uint64_t), cWords)) {
+         pRet->Free();
+         LOG_0(Trace_Warning, "WARNING InnerBag::GenerateFlatInnerBag IsMultiplyError(sizeof(uint64_t), cWords)");
+         return nullptr;
+      }
+      uint64_t * const aSampleBits = static_cast<uint64_t *>(malloc(sizeof(uint64_t) * cWords));
+      if(nullptr == aSampleBits) {
+         pRet->Free();
+         LOG_0(Trace_Warning, "WARNING InnerBag::GenerateFlatInnerBag nullptr == aSampleBits");
+         return nullptr;
+      }
+      pRet->m_aSampleBits = aSampleBits;
+      memset(aSampleBits, 0, sizeof(uint64_t) * cWords);
+
+      size_t cSelected = 0;
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         const size_t bSelected = BagEbm { 0 } < aBag[iSample] ? size_t { 1 } : size_t { 0 };
+         aSampleBits[iSample / k_cSamplesPerSampleBitsWord] |=
+            static_cast<uint64_t>(bSelected) << (iSample % k_cSamplesPerSampleBitsWord);
+         cSelected += bSelected;
+      }
+      EBM_ASSERT(1 <= cSelected); // we would not be called without training samples
+      pRet->m_cSamples = cSelected;
+      pRet->m_weightTotal = static_cast<FloatBig>(cSelected);
+   } else if(nullptr != aBag) {
+      // the flat bag holds the samples that aBag selects, and each is counted as many times as it was selected
+      if(IsMultiplyError(sizeof(size_t), cSamples) || IsMultiplyError(sizeof(FloatFast), cSamples)) {
+         pRet->Free();
+         LOG_0(Trace_Warning, "WARNING InnerBag::GenerateFlatInnerBag IsMultiplyError(sizeof(size_t), cSamples)");
+         return nullptr;
+      }
+      size_t * const aCountOccurrences = static_cast<size_t *>(malloc(sizeof(size_t) * cSamples));
+      if(nullptr == aCountOccurrences) {
+         pRet->Free();
+         LOG_0(Trace_Warning, "WARNING InnerBag::GenerateFlatInnerBag nullptr == aCountOccurrences");
+         return nullptr;
+      }
+      pRet->m_aCountOccurrences = aCountOccurrences;
+
+      FloatFast * const aWeightsInternal = static_cast<FloatFast *>(malloc(sizeof(FloatFast) * cSamples));
+      if(nullptr == aWeightsInternal) {
+         pRet->Free();
+         LOG_0(Trace_Warning, "WARNING InnerBag::GenerateFlatInnerBag nullptr == aWeightsInternal");
+         return nullptr;
+      }
+      pRet->m_aWeights = aWeightsInternal;
+
+      size_t cSelected = 0;
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         const size_t cOccurrences = BagEbm { 0 } < aBag[iSample] ? static_cast<size_t>(aBag[iSample]) : size_t { 0 };
+         aCountOccurrences[iSample] = cOccurrences;
+         const FloatFast weight = nullptr == aWeights ? FloatFast { 1 } : aWeights[iSample];
+         aWeightsInternal[iSample] = weight * static_cast<FloatFast>(cOccurrences);
+         cSelected += cOccurrences;
+      }
+      EBM_ASSERT(1 <= cSelected); // we would not be called without training samples
+      pRet->m_cSamples = cSelected;
+      pRet->m_weightTotal = static_cast<FloatBig>(cSelected);
+
+      if(nullptr != aWeights) {
+         const FloatBig total = AddPositiveFloatsSafeBig(cSamples, aWeightsInternal);
+         if(std::isnan(total) || std::isinf(total) || total <= 0) {
+            pRet->Free();
+            LOG_0(Trace_Warning, "WARNING InnerBag::GenerateFlatInnerBag std::isnan(total) || std::isinf(total) || total <= 0");
+            return nullptr;
+         }
+         pRet->m_weightTotal = total;
+      }
+   } else if(nullptr != aWeights) {
       if(IsMultiplyError(sizeof(FloatFast), cSamples)) {
          pRet->Free();
          LOG_0(Trace_Warning, "WARNING InnerBag::GenerateFlatInnerBag IsMultiplyError(sizeof(FloatFast), cSamples)");
@@ -187,14 +421,23 @@ InnerBag * InnerBag::GenerateFlatInnerBag(
 }
 
 void InnerBag::Free() {
-   free(m_aCountOccurrences);
-   free(m_aWeights);
+   if(size_t { 1 } == m_cStride) {
+      // otherwise the counts and weights are in the sample major arrays of the BoosterCore
+      free(m_aCountOccurrences);
+      if(nullptr == m_aSampleBits) {
+         // subsampled inner bags share the weights of the BoosterCore
+         free(m_aWeights);
+      }
+   }
+   free(m_aSampleBits);
    free(this);
 }
 
 void InnerBag::InitializeUnfailing() {
    m_aCountOccurrences = nullptr;
    m_aWeights = nullptr;
+   m_cStride = 1;
+   m_aSampleBits = nullptr;
 }
 
 void InnerBag::FreeInnerBags(const size_t cInnerBags, InnerBag ** const apInnerBags) {
@@ -218,7 +461,9 @@ ErrorEbm InnerBag::GenerateInnerBags(
    void * const rng,
    const size_t cSamples,
    const FloatFast * const aWeights,
+   const BagEbm * const aBag,
    const size_t cInnerBags,
+   const bool bSubsample,
    InnerBag *** const papOut
 ) {
    LOG_0(Trace_Info, "Entered InnerBag::GenerateInnerBags");
@@ -249,7 +494,7 @@ ErrorEbm InnerBag::GenerateInnerBags(
 
    if(size_t { 0 } == cInnerBags) {
       // zero is a special value that really means allocate one set that contains all samples.
-      InnerBag * const pSingleInnerBag = GenerateFlatInnerBag(cSamples, aWeights);
+      InnerBag * const pSingleInnerBag = GenerateFlatInnerBag(cSamples, aWeights, aBag);
       if(UNLIKELY(nullptr == pSingleInnerBag)) {
          LOG_0(Trace_Warning, "WARNING InnerBag::GenerateInnerBags nullptr == pSingleInnerBag");
          return Error_OutOfMemory;
@@ -258,7 +503,8 @@ ErrorEbm InnerBag::GenerateInnerBags(
    } else {
       InnerBag ** ppInnerBag = apInnerBags;
       do {
-         const ErrorEbm error = GenerateSingleInnerBag(rng, cSamples, aWeights, ppInnerBag);
+         const ErrorEbm error = bSubsample ? GenerateSubsampleInnerBag(rng, cSamples, aWeights, aBag, ppInnerBag) :
+            GenerateSingleInnerBag(rng, cSamples, aWeights, aBag, ppInnerBag);
          if(UNLIKELY(Error_None != error)) {
             return error;
          }
@@ -269,4 +515,72 @@ ErrorEbm InnerBag::GenerateInnerBags(
    return Error_None;
 }
 
+ErrorEbm InnerBag::GenerateSampleMajor(
+   const size_t cSamples,
+   const size_t cInnerBags,
+   InnerBag * const * const apInnerBags,
+   size_t ** const paCountOccurrencesOut,
+   FloatFast ** const paWeightsOut
+) {
+   LOG_0(Trace_Info, "Entered InnerBag::GenerateSampleMajor");
+
+   EBM_ASSERT(1 <= cSamples);
+   EBM_ASSERT(2 <= cInnerBags);
+   EBM_ASSERT(nullptr != apInnerBags);
+   EBM_ASSERT(nullptr != paCountOccurrencesOut);
+   EBM_ASSERT(nullptr == *paCountOccurrencesOut);
+   EBM_ASSERT(nullptr != paWeightsOut);
+   EBM_ASSERT(nullptr == *paWeightsOut);
+
+   if(IsMultiplyError(sizeof(size_t), cSamples, cInnerBags)) {
+      LOG_0(Trace_Warning, "WARNING InnerBag::GenerateSampleMajor IsMultiplyError(sizeof(size_t), cSamples, cInnerBags)");
+      return Error_OutOfMemory;
+   }
+   size_t * const aCountOccurrences = static_cast<size_t *>(malloc(sizeof(size_t) * cSamples * cInnerBags));
+   if(nullptr == aCountOccurrences) {
+      LOG_0(Trace_Warning, "WARNING InnerBag::GenerateSampleMajor nullptr == aCountOccurrences");
+      return Error_OutOfMemory;
+   }
+   *paCountOccurrencesOut = aCountOccurrences;
+
+   if(IsMultiplyError(sizeof(FloatFast), cSamples, cInnerBags)) {
+      LOG_0(Trace_Warning, "WARNING InnerBag::GenerateSampleMajor IsMultiplyError(sizeof(FloatFast), cSamples, cInnerBags)");
+      return Error_OutOfMemory;
+   }
+   FloatFast * const aWeights = static_cast<FloatFast *>(malloc(sizeof(FloatFast) * cSamples * cInnerBags));
+   if(nullptr == aWeights) {
+      LOG_0(Trace_Warning, "WARNING InnerBag::GenerateSampleMajor nullptr == aWeights");
+      return Error_OutOfMemory;
+   }
+   *paWeightsOut = aWeights;
+
+   size_t iInnerBag = 0;
+   do {
+      InnerBag * const pInnerBag = apInnerBags[iInnerBag];
+      EBM_ASSERT(nullptr != pInnerBag);
+      EBM_ASSERT(nullptr != pInnerBag->m_aCountOccurrences);
+      EBM_ASSERT(nullptr != pInnerBag->m_aWeights);
+      EBM_ASSERT(nullptr == pInnerBag->m_aSampleBits);
+      EBM_ASSERT(size_t { 1 } == pInnerBag->m_cStride);
+
+      size_t iSample = 0;
+      do {
+         aCountOccurrences[iSample * cInnerBags + iInnerBag] = pInnerBag->m_aCountOccurrences[iSample];
+         aWeights[iSample * cInnerBags + iInnerBag] = pInnerBag->m_aWeights[iSample];
+         ++iSample;
+      } while(cSamples != iSample);
+
+      free(pInnerBag->m_aCountOccurrences);
+      free(pInnerBag->m_aWeights);
+      pInnerBag->m_aCountOccurrences = &aCountOccurrences[iInnerBag];
+      pInnerBag->m_aWeights = &aWeights[iInnerBag];
+      pInnerBag->m_cStride = cInnerBags;
+
+      ++iInnerBag;
+   } while(cInnerBags != iInnerBag);
+
+   LOG_0(Trace_Info, "Exited InnerBag::GenerateSampleMajor");
+   return Error_None;
+}
+
 } // DEFINED_ZONE_NAME
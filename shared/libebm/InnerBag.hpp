@@ -6,7 +6,9 @@
 #define INNER_BAG_HPP
 
 #include <stddef.h> // size_t, ptrdiff_t
+#include <stdint.h> // uint64_t
 
+#include "libebm.h" // BagEbm
 #include "common_c.h" // FloatFast
 #include "zones.h"
 
@@ -17,6 +19,13 @@ namespace DEFINED_ZONE_NAME {
 
 class RandomDeterministic;
 
+static constexpr size_t k_cSamplesPerSampleBitsWord = size_t { 64 };
+
+INLINE_ALWAYS static size_t GetSampleBit(const uint64_t * const aSampleBits, const size_t iSample) {
+   return static_cast<size_t>(aSampleBits[iSample / k_cSamplesPerSampleBitsWord] >>
+      (iSample % k_cSamplesPerSampleBitsWord)) & size_t { 1 };
+}
+
 class InnerBag final {
    // Sampling with replacement is the more theoretically correct method of sampling, but it has the drawback that 
    // we need to keep a count of the number of times each sample is selected in the dataset.  
@@ -27,6 +36,18 @@ class InnerBag final {
    // the raw data in both formats since it is never converted anyways, but this count is!
    size_t * m_aCountOccurrences;
    FloatFast * m_aWeights;
+   // the distance between the values of consecutive samples in m_aCountOccurrences and m_aWeights.  It is 1 when
+   // we own them.  When there are several inner bags they all point into the sample major arrays that the
+   // BoosterCore owns, so the stride is then the number of inner bags
+   size_t m_cStride;
+
+   // When subsampling without replacement, or when an unweighted flat bag selects each sample at most once, we
+   // keep one bit per sample instead of the counts above.  The weights are then the unmasked training set weights,
+   // which the BoosterCore owns, or nullptr if there are none
+   uint64_t * m_aSampleBits;
+
+   // the number of samples in the bag, counting each repeated selection
+   size_t m_cSamples;
    FloatBig m_weightTotal;
 
    // we take owernship of the aWeights array
@@ -35,11 +56,20 @@ class InnerBag final {
       void * const rng,
       const size_t cSamples,
       const FloatFast * const aWeights,
+      const BagEbm * const aBag,
+      InnerBag ** const ppOut
+   );
+   static ErrorEbm GenerateSubsampleInnerBag(
+      void * const rng,
+      const size_t cSamples,
+      const FloatFast * const aWeights,
+      const BagEbm * const aBag,
       InnerBag ** const ppOut
    );
    static InnerBag * GenerateFlatInnerBag(
       const size_t cSamples,
-      const FloatFast * const aWeights
+      const FloatFast * const aWeights,
+      const BagEbm * const aBag
    );
    void Free();
    void InitializeUnfailing();
@@ -57,18 +87,43 @@ public:
    const FloatFast * GetWeights() const {
       return m_aWeights;
    }
+   size_t GetStride() const {
+      return m_cStride;
+   }
+   const uint64_t * GetSampleBits() const {
+      return m_aSampleBits;
+   }
+   size_t GetCountSamples() const {
+      return m_cSamples;
+   }
    FloatBig GetWeightTotal() const {
       return m_weightTotal;
    }
 
+   // aBag is nullptr unless the training set holds every sample of the dataset, as it does for the boosters made
+   // by CreateBoosterBags.  The inner bags then only draw from the samples with positive values in aBag, which 
+   // count as that many samples, and give every other sample a count and weight of zero
    static ErrorEbm GenerateInnerBags(
       void * const rng,
       const size_t cSamples,
       const FloatFast * const aWeights,
+      const BagEbm * const aBag,
       const size_t cInnerBags,
+      const bool bSubsample,
       InnerBag *** const papOut
    );
    static void FreeInnerBags(const size_t cInnerBags, InnerBag ** const apInnerBags);
+
+   // moves the occurrence counts and weights of all the inner bags into sample major arrays, so that a
+   // single pass over the samples can find each sample's value for every inner bag next to each other.  Each
+   // inner bag frees its own arrays and reads its values from the sample major arrays with a stride instead
+   static ErrorEbm GenerateSampleMajor(
+      const size_t cSamples,
+      const size_t cInnerBags,
+      InnerBag * const * const apInnerBags,
+      size_t ** const paCountOccurrencesOut,
+      FloatFast ** const paWeightsOut
+   );
 };
 static_assert(std::is_standard_layout<InnerBag>::value,
    "We use the struct hack in several places, so disallow non-standard_layout types in general");
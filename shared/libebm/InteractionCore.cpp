@@ -164,7 +164,6 @@ ErrorEbm InteractionCore::Create(
             &defaultValSparse,
             &cNonDefaultsSparse
          );
-         EBM_ASSERT(!bSparse); // not handled yet
 
          if(IsConvertError<size_t>(countBins)) {
             LOG_0(Trace_Error, "ERROR InteractionCore::Allocate IsConvertError<size_t>(countBins)");
@@ -213,15 +212,17 @@ ErrorEbm InteractionCore::Create(
       LOG_0(Trace_Info, "INFO InteractionCore::Create determining Objective");
       Config config;
       config.cOutputs = cScores;
+      config.cTasks = 1;
       config.isDifferentiallyPrivate = EBM_FALSE != isDifferentiallyPrivate ? EBM_TRUE : EBM_FALSE;
-      error = GetObjective(&config, sObjective, &pInteractionCore->m_objective);
+      config.link = Link_ERROR;
+      error = GetObjective(&config, sObjective, &pInteractionCore->m_objectiveCpu, &pInteractionCore->m_objectiveSIMD);
       if(Error_None != error) {
          // already logged
          return error;
       }
       LOG_0(Trace_Info, "INFO InteractionCore::Create Objective determined");
 
-      const OutputType outputType = GetOutputType(pInteractionCore->m_objective.m_linkFunction);
+      const OutputType outputType = GetOutputType(pInteractionCore->m_objectiveCpu.m_linkFunction);
       if(IsClassification(cClasses)) {
          if(outputType < OutputType_GeneralClassification) {
             LOG_0(Trace_Error, "ERROR InteractionCore::Create mismatch in objective class model type");
@@ -255,13 +256,19 @@ ErrorEbm InteractionCore::Create(
          aBag,
          cTrainingSamples,
          cWeights,
-         cFeatures
+         cFeatures,
+         pInteractionCore->GetCountBitPackLanes()
       );
       if(Error_None != error) {
          return error;
       }
    }
 
+   error = pInteractionCore->m_threadPool.Start(GetCountThreadsRequested());
+   if(Error_None != error) {
+      return error;
+   }
+
    LOG_0(Trace_Info, "Exited InteractionCore::Allocate");
    return Error_None;
 }
@@ -287,21 +294,22 @@ ErrorEbm InteractionCore::InitializeInteractionGradientsAndHessians(
       EBM_ASSERT(1 != cClasses); // no gradients if 1 == cClasses
       const size_t cScores = GetCountScores(cClasses);
 
-      if(IsMultiplyError(sizeof(FloatFast), cScores, cSetSamples)) {
-         LOG_0(Trace_Warning, "WARNING InteractionCore::InitializeInteractionGradientsAndHessians IsMultiplyError(sizeof(FloatFast), cScores, cSetSamples)");
+      if(IsMultiplyError(sizeof(FloatScore), cScores, cSetSamples)) {
+         LOG_0(Trace_Warning, "WARNING InteractionCore::InitializeInteractionGradientsAndHessians IsMultiplyError(sizeof(FloatScore), cScores, cSetSamples)");
          return Error_OutOfMemory;
       }
       const size_t cBytesScores = sizeof(FloatFast) * cScores;
-      const size_t cBytesAllScores = cBytesScores * cSetSamples;
+      const size_t cBytesTensorScores = sizeof(FloatScore) * cScores;
+      const size_t cBytesAllScores = cBytesTensorScores * cSetSamples;
 
-      FloatFast * pSampleScoreTo = static_cast<FloatFast *>(malloc(cBytesAllScores));
+      FloatScore * pSampleScoreTo = static_cast<FloatScore *>(malloc(cBytesAllScores));
       if(UNLIKELY(nullptr == pSampleScoreTo)) {
          LOG_0(Trace_Warning, "WARNING InteractionCore::InitializeInteractionGradientsAndHessians nullptr == pSampleScoreTo");
          return Error_OutOfMemory;
       }
       data.m_aSampleScores = pSampleScoreTo;
 
-      FloatFast * const aUpdateScores = static_cast<FloatFast *>(malloc(cBytesScores));
+      FloatScore * const aUpdateScores = static_cast<FloatScore *>(malloc(cBytesTensorScores));
       if(UNLIKELY(nullptr == aUpdateScores)) {
          LOG_0(Trace_Warning, "WARNING InteractionCore::InitializeInteractionGradientsAndHessians nullptr == aUpdateScores");
          error = Error_OutOfMemory;
@@ -309,7 +317,7 @@ ErrorEbm InteractionCore::InitializeInteractionGradientsAndHessians(
       }
       data.m_aUpdateTensorScores = aUpdateScores;
 
-      memset(aUpdateScores, 0, cBytesScores);
+      memset(aUpdateScores, 0, cBytesTensorScores);
 
       data.m_aMulticlassMidwayTemp = nullptr;
       if(IsClassification(cClasses)) {
@@ -377,11 +385,11 @@ ErrorEbm InteractionCore::InitializeInteractionGradientsAndHessians(
                ++pTargetTo;
 
                const double * pInitScoreFromLoop = pInitScoreFromOld;
-               const double * pSampleScoreToEnd = pSampleScoreTo + cScores;
+               const FloatScore * const pSampleScoreToEnd = pSampleScoreTo + cScores;
                do {
-                  FloatFast initScore = 0;
+                  FloatScore initScore = 0;
                   if(nullptr != pInitScoreFromLoop) {
-                     initScore = SafeConvertFloat<FloatFast>(*pInitScoreFromLoop);
+                     initScore = SafeConvertFloat<FloatScore>(*pInitScoreFromLoop);
                      ++pInitScoreFromLoop;
                   }
                   *pSampleScoreTo = initScore;
@@ -439,11 +447,11 @@ ErrorEbm InteractionCore::InitializeInteractionGradientsAndHessians(
                ++pTargetTo;
 
                const double * pInitScoreFromLoop = pInitScoreFromOld;
-               const double * pSampleScoreToEnd = pSampleScoreTo + cScores;
+               const FloatScore * const pSampleScoreToEnd = pSampleScoreTo + cScores;
                do {
-                  FloatFast initScore = 0;
+                  FloatScore initScore = 0;
                   if(nullptr != pInitScoreFromLoop) {
-                     initScore = SafeConvertFloat<FloatFast>(*pInitScoreFromLoop);
+                     initScore = SafeConvertFloat<FloatScore>(*pInitScoreFromLoop);
                      ++pInitScoreFromLoop;
                   }
                   *pSampleScoreTo = initScore;
@@ -14,6 +14,7 @@
 #include "zones.h"
 
 #include "DataSetInteraction.hpp"
+#include "ThreadPool.hpp"
 
 namespace DEFINED_ZONE_NAME {
 #ifndef DEFINED_ZONE_NAME
@@ -38,14 +39,18 @@ class InteractionCore final {
 
    DataSetInteraction m_dataFrame;
 
-   ObjectiveWrapper m_objective;
+   ObjectiveWrapper m_objectiveCpu;
+   ObjectiveWrapper m_objectiveSIMD;
+
+   ThreadPool m_threadPool;
 
    inline ~InteractionCore() {
       // this only gets called after our reference count has been decremented to zero
 
       m_dataFrame.Destruct();
       free(m_aFeatures);
-      FreeObjectiveWrapperInternals(&m_objective);
+      FreeObjectiveWrapperInternals(&m_objectiveCpu);
+      FreeObjectiveWrapperInternals(&m_objectiveSIMD);
    };
 
    inline InteractionCore() noexcept :
@@ -55,7 +60,8 @@ class InteractionCore final {
       m_aFeatures(nullptr)
    {
       m_dataFrame.InitializeUnfailing();
-      InitializeObjectiveWrapperUnfailing(&m_objective);
+      InitializeObjectiveWrapperUnfailing(&m_objectiveCpu);
+      InitializeObjectiveWrapperUnfailing(&m_objectiveSIMD);
    }
 
 public:
@@ -86,6 +92,10 @@ public:
       return m_cFeatures;
    }
 
+   inline ThreadPool * GetThreadPool() {
+      return &m_threadPool;
+   }
+
    static void Free(InteractionCore * const pInteractionCore);
    static ErrorEbm Create(
       const unsigned char * const pDataSetShared,
@@ -103,35 +113,42 @@ public:
    );
 
    inline ErrorEbm ObjectiveApplyUpdate(ApplyUpdateBridge * const pData) {
-      return (*m_objective.m_pApplyUpdateC)(&m_objective, pData);
+      // the SIMD zone objective, when we have one, can only be used for ApplyUpdate
+      const ObjectiveWrapper * const pObjective = nullptr != m_objectiveSIMD.m_pObjective ? &m_objectiveSIMD : &m_objectiveCpu;
+      return (*pObjective->m_pApplyUpdateC)(pObjective, pData);
+   }
+
+   inline size_t GetCountBitPackLanes() const noexcept {
+      // only BinSumsInteraction reads our bit packs, so we interleave them across the SIMD zone's lanes
+      return nullptr != m_objectiveSIMD.m_pObjective ? m_objectiveSIMD.m_cSIMDPack : size_t { 1 };
    }
 
    inline BoolEbm CheckTargets(const size_t c, const void * const aTargets) const noexcept {
-      return (*m_objective.m_pCheckTargetsC)(&m_objective, c, aTargets);
+      return (*m_objectiveCpu.m_pCheckTargetsC)(&m_objectiveCpu, c, aTargets);
    }
 
    inline bool IsRmse() {
-      return EBM_FALSE != m_objective.m_bRmse;
+      return EBM_FALSE != m_objectiveCpu.m_bRmse;
    }
 
    inline bool IsHessian() {
-      return EBM_FALSE != m_objective.m_bObjectiveHasHessian;
+      return EBM_FALSE != m_objectiveCpu.m_bObjectiveHasHessian;
    }
 
    inline double GainAdjustmentGradientBoosting() const noexcept {
-      return m_objective.m_gainAdjustmentGradientBoosting;
+      return m_objectiveCpu.m_gainAdjustmentGradientBoosting;
    }
 
    inline double GainAdjustmentHessianBoosting() const noexcept {
-      return m_objective.m_gainAdjustmentHessianBoosting;
+      return m_objectiveCpu.m_gainAdjustmentHessianBoosting;
    }
 
    inline double GradientConstant() {
-      return m_objective.m_gradientConstant;
+      return m_objectiveCpu.m_gradientConstant;
    }
 
    inline double HessianConstant() {
-      return m_objective.m_hessianConstant;
+      return m_objectiveCpu.m_hessianConstant;
    }
 };
 
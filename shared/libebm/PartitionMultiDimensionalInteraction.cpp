@@ -0,0 +1,411 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "precompiled_header_cpp.hpp"
+
+#include <stddef.h> // size_t, ptrdiff_t
+#include <stdlib.h> // malloc, free
+#include <cmath> // std::abs
+#include <limits> // std::numeric_limits
+
+#include "logging.h"
+#include "common_c.h" // LIKELY
+#include "zones.h"
+
+#include "ebm_stats.hpp"
+#include "GradientPair.hpp"
+#include "Bin.hpp"
+#include "TensorTotalsSum.hpp"
+#include "InteractionCore.hpp"
+
+namespace DEFINED_ZONE_NAME {
+#ifndef DEFINED_ZONE_NAME
+#error DEFINED_ZONE_NAME must be defined
+#endif // DEFINED_ZONE_NAME
+
+// Every cut combination sums 2^N orthants and each orthant sum visits up to 2^N totals bins, so a sweep costs
+// 4^N bin visits per cut combination.  When the full sweep would exceed this budget we consider fewer evenly
+// spaced cuts in the dimensions with the most cuts until it fits.
+static constexpr size_t k_cInteractionSweepBinVisitsMax = size_t { 1 } << 24;
+
+// purification of the 2^N orthant updates is iterative for 3 or more dimensions
+static constexpr size_t k_cPurifyIterationsMax = 64;
+static constexpr FloatBig k_purifyTolerance = FloatBig { 1e-12 };
+
+static void PurifyOrthants(
+   const size_t cRealDimensions,
+   const size_t cOrthants,
+   const FloatBig * const aWeights,
+   FloatBig * const aUpdates
+) {
+   // Remove the weighted mean along each line of orthants that differ in only one dimension.  Whatever is
+   // removed is a function of the other dimensions, so it belongs to a lower order term.  Repeating this over
+   // all the dimensions converges to updates whose weighted sums along every dimension are zero, which is the
+   // purified interaction.  For 2 dimensions this matches the closed form in PartitionTwoDimensionalInteraction.
+
+   EBM_ASSERT(2 <= cRealDimensions);
+   EBM_ASSERT((size_t { 1 } << cRealDimensions) == cOrthants);
+
+   FloatBig updateMax = 0;
+   for(size_t iOrthant = 0; iOrthant < cOrthants; ++iOrthant) {
+      updateMax = EbmMax(updateMax, std::abs(aUpdates[iOrthant]));
+   }
+   const FloatBig tolerance = updateMax * k_purifyTolerance;
+
+   size_t iIteration = 0;
+   do {
+      FloatBig changeMax = 0;
+      size_t iDimension = 0;
+      do {
+         const size_t bitDimension = size_t { 1 } << iDimension;
+         for(size_t iLow = 0; iLow < cOrthants; ++iLow) {
+            if(0 == (bitDimension & iLow)) {
+               const size_t iHigh = iLow | bitDimension;
+               const FloatBig weightLow = aWeights[iLow];
+               const FloatBig weightHigh = aWeights[iHigh];
+               // the caller filters out orthants with zero weight
+               EBM_ASSERT(0 < weightLow + weightHigh);
+               const FloatBig mean = (aUpdates[iLow] * weightLow + aUpdates[iHigh] * weightHigh) / (weightLow + weightHigh);
+               aUpdates[iLow] -= mean;
+               aUpdates[iHigh] -= mean;
+               changeMax = EbmMax(changeMax, std::abs(mean));
+            }
+         }
+         ++iDimension;
+      } while(cRealDimensions != iDimension);
+      if(changeMax <= tolerance) {
+         break;
+      }
+      ++iIteration;
+   } while(k_cPurifyIterationsMax != iIteration);
+}
+
+template<bool bHessian, size_t cCompilerScores>
+class PartitionMultiDimensionalInteractionInternal final {
+public:
+
+   PartitionMultiDimensionalInteractionInternal() = delete; // this is a static class.  Do not construct
+
+   INLINE_RELEASE_UNTEMPLATED static ErrorEbm Func(
+      InteractionCore * const pInteractionCore,
+      const size_t cRealDimensions,
+      const size_t * const acBins,
+      const InteractionFlags flags,
+      const size_t cSamplesLeafMin,
+      BinBase * const aAuxiliaryBinsBase,
+      BinBase * const aBinsBase,
+      double * const pBestGain
+#ifndef NDEBUG
+      , const BinBase * const aDebugCopyBinsBase
+      , const BinBase * const pBinsEndDebug
+#endif // NDEBUG
+   ) {
+      auto * const aAuxiliaryBins = aAuxiliaryBinsBase->Specialize<FloatBig, bHessian, GetArrayScores(cCompilerScores)>();
+      auto * const aBins = aBinsBase->Specialize<FloatBig, bHessian, GetArrayScores(cCompilerScores)>();
+
+#ifndef NDEBUG
+      auto * const aDebugCopyBins = aDebugCopyBinsBase->Specialize<FloatBig, bHessian, GetArrayScores(cCompilerScores)>();
+#endif // NDEBUG
+
+      const size_t cScores = GET_COUNT_SCORES(cCompilerScores, GetCountScores(pInteractionCore->GetCountClasses()));
+      const size_t cBytesPerBin = GetBinSize<FloatBig>(bHessian, cScores);
+
+      EBM_ASSERT(2 <= cRealDimensions);
+      EBM_ASSERT(cRealDimensions <= k_cDimensionsMax);
+      EBM_ASSERT(0 < cSamplesLeafMin);
+
+      // the caller allocated at least one auxiliary bin per orthant, and that many tensor bins, so this fits
+      const size_t cOrthants = size_t { 1 } << cRealDimensions;
+
+      const bool bPure = 0 != (InteractionFlags_Pure & flags);
+      FloatBig * aPurifyMem = nullptr;
+      if(bPure) {
+         if(IsMultiplyError(sizeof(FloatBig) * 2, cOrthants)) {
+            LOG_0(Trace_Warning, "WARNING PartitionMultiDimensionalInteractionInternal IsMultiplyError(sizeof(FloatBig) * 2, cOrthants)");
+            return Error_OutOfMemory;
+         }
+         aPurifyMem = static_cast<FloatBig *>(malloc(sizeof(FloatBig) * 2 * cOrthants));
+         if(nullptr == aPurifyMem) {
+            LOG_0(Trace_Warning, "WARNING PartitionMultiDimensionalInteractionInternal nullptr == aPurifyMem");
+            return Error_OutOfMemory;
+         }
+      }
+      FloatBig * const aPurifyWeights = aPurifyMem;
+      FloatBig * const aPurifyUpdates = nullptr == aPurifyMem ? nullptr : &aPurifyMem[cOrthants];
+
+      // how many cut combinations fit in the budget.  4^N can exceed the budget by itself, in which case we
+      // still evaluate one cut per dimension
+      const size_t cShift = cRealDimensions << 1;
+      size_t cCombinationsMax = 1;
+      if(cShift < k_cBitsForSizeT) {
+         cCombinationsMax = EbmMax(size_t { 1 }, k_cInteractionSweepBinVisitsMax >> cShift);
+      }
+
+      TensorSumDimension aDimensions[k_cDimensionsMax];
+      size_t acCandidates[k_cDimensionsMax];
+      size_t aiCandidates[k_cDimensionsMax];
+      size_t iDimension = 0;
+      do {
+         const size_t cBins = acBins[iDimension];
+         EBM_ASSERT(2 <= cBins); // 1 cBins in any dimension returns an interaction score of 0
+         aDimensions[iDimension].m_cBins = cBins;
+         acCandidates[iDimension] = cBins - 1;
+         aiCandidates[iDimension] = 0;
+         ++iDimension;
+      } while(cRealDimensions != iDimension);
+
+      while(true) {
+         size_t cCombinations = 1;
+         size_t iDimensionLargest = 0;
+         iDimension = 0;
+         do {
+            const size_t cCandidates = acCandidates[iDimension];
+            if(acCandidates[iDimensionLargest] < cCandidates) {
+               iDimensionLargest = iDimension;
+            }
+            cCombinations = IsMultiplyError(cCombinations, cCandidates) ?
+               std::numeric_limits<size_t>::max() : cCombinations * cCandidates;
+            ++iDimension;
+         } while(cRealDimensions != iDimension);
+         if(cCombinations <= cCombinationsMax) {
+            break;
+         }
+         // cCombinations is more than 1, so the largest dimension has at least 2 candidates
+         EBM_ASSERT(2 <= acCandidates[iDimensionLargest]);
+         acCandidates[iDimensionLargest] = (acCandidates[iDimensionLargest] + 1) >> 1;
+      }
+
+#ifndef NDEBUG
+      bool bAnySplits = false;
+#endif // NDEBUG
+
+      // if a negative value were to occur, then it would be due to numeric instability, so clip it to zero here
+      FloatBig bestGain = 0;
+
+      bool bMoreCombinations;
+      do {
+         iDimension = 0;
+         do {
+            // spread the candidate cuts evenly over the legal cut points.  When every cut point is a candidate
+            // this maps each candidate to its own cut point
+            const size_t cCuts = aDimensions[iDimension].m_cBins - 1;
+            const size_t cCandidates = acCandidates[iDimension];
+            aDimensions[iDimension].m_iPoint = (aiCandidates[iDimension] * 2 + 1) * cCuts / (cCandidates * 2);
+            EBM_ASSERT(aDimensions[iDimension].m_iPoint < cCuts);
+            ++iDimension;
+         } while(cRealDimensions != iDimension);
+
+         bool bLegal = true;
+         size_t iOrthant = 0;
+         do {
+            auto * const pOrthant = IndexBin(aAuxiliaryBins, cBytesPerBin * iOrthant);
+            ASSERT_BIN_OK(cBytesPerBin, pOrthant, pBinsEndDebug);
+            TensorTotalsSum<bHessian, cCompilerScores, k_dynamicDimensions>(
+               cScores,
+               cRealDimensions,
+               aDimensions,
+               iOrthant,
+               aBins,
+               *pOrthant,
+               pOrthant->GetGradientPairs()
+#ifndef NDEBUG
+               , aDebugCopyBins
+               , pBinsEndDebug
+#endif // NDEBUG
+            );
+            if(UNLIKELY(pOrthant->GetCountSamples() < cSamplesLeafMin)) {
+               bLegal = false;
+               break;
+            }
+            ++iOrthant;
+         } while(cOrthants != iOrthant);
+
+         if(LIKELY(bLegal)) {
+#ifndef NDEBUG
+            bAnySplits = true;
+#endif // NDEBUG
+            FloatBig gain = 0;
+
+            for(size_t iScore = 0; iScore < cScores; ++iScore) {
+               static constexpr bool bUseLogitBoost = k_bUseLogitboost && bHessian;
+
+               if(bPure) {
+                  bool bZeroWeight = false;
+                  iOrthant = 0;
+                  do {
+                     const auto * const pOrthant = IndexBin(aAuxiliaryBins, cBytesPerBin * iOrthant);
+                     const auto * const aGradientPairs = pOrthant->GetGradientPairs();
+                     const FloatBig d = bUseLogitBoost ? aGradientPairs[iScore].GetHess() : pOrthant->GetWeight();
+                     // if any of the denominators (weights) are zero then the purified gain will be zero
+                     if(0 == d) {
+                        bZeroWeight = true;
+                        break;
+                     }
+                     aPurifyWeights[iOrthant] = d;
+                     aPurifyUpdates[iOrthant] = aGradientPairs[iScore].m_sumGradients / d;
+                     ++iOrthant;
+                  } while(cOrthants != iOrthant);
+
+                  if(!bZeroWeight) {
+                     PurifyOrthants(cRealDimensions, cOrthants, aPurifyWeights, aPurifyUpdates);
+                     iOrthant = 0;
+                     do {
+                        gain += EbmStats::CalcPartialGainFromUpdate(aPurifyUpdates[iOrthant], aPurifyWeights[iOrthant]);
+                        ++iOrthant;
+                     } while(cOrthants != iOrthant);
+                  }
+               } else {
+                  iOrthant = 0;
+                  do {
+                     const auto * const pOrthant = IndexBin(aAuxiliaryBins, cBytesPerBin * iOrthant);
+                     const auto * const aGradientPairs = pOrthant->GetGradientPairs();
+                     gain += EbmStats::CalcPartialGain(
+                        aGradientPairs[iScore].m_sumGradients,
+                        bUseLogitBoost ? aGradientPairs[iScore].GetHess() : pOrthant->GetWeight()
+                     );
+                     ++iOrthant;
+                  } while(cOrthants != iOrthant);
+               }
+            }
+            EBM_ASSERT(std::isnan(gain) || 0 <= gain); // sumations of positive numbers should be positive
+
+            // flip the comparison so that NaN values propagate into bestGain
+            if(UNLIKELY(/* NaN */ !LIKELY(gain <= bestGain))) {
+               bestGain = gain;
+            } else {
+               EBM_ASSERT(!std::isnan(gain));
+            }
+         }
+
+         // advance to the next cut combination like an odometer
+         bMoreCombinations = false;
+         iDimension = 0;
+         do {
+            ++aiCandidates[iDimension];
+            if(acCandidates[iDimension] != aiCandidates[iDimension]) {
+               bMoreCombinations = true;
+               break;
+            }
+            aiCandidates[iDimension] = 0;
+            ++iDimension;
+         } while(cRealDimensions != iDimension);
+      } while(bMoreCombinations);
+
+      free(aPurifyMem);
+
+      // we start from zero, so bestGain can't be negative here
+      EBM_ASSERT(std::isnan(bestGain) || 0 <= bestGain);
+
+      if(!bPure) {
+         // as in PartitionTwoDimensionalInteraction, all the cut combinations share the parent partial gain, so
+         // subtract it once here.  The bin before the aAuxiliaryBins is the last summation bin of aBinsBase,
+         // which contains the totals of all bins
+         const auto * const pTotal = NegativeIndexBin(aAuxiliaryBins, cBytesPerBin);
+         const FloatBig weightAll = pTotal->GetWeight();
+         const auto * const aGradientPairs = pTotal->GetGradientPairs();
+         for(size_t iScore = 0; iScore < cScores; ++iScore) {
+            static constexpr bool bUseLogitBoost = k_bUseLogitboost && bHessian;
+            bestGain -= EbmStats::CalcPartialGain(
+               aGradientPairs[iScore].m_sumGradients,
+               bUseLogitBoost ? aGradientPairs[iScore].GetHess() : weightAll
+            );
+         }
+
+         EBM_ASSERT(std::isnan(bestGain) ||
+            -std::numeric_limits<FloatBig>::infinity() == bestGain ||
+            k_epsilonNegativeGainAllowed <= bestGain || !bAnySplits);
+      }
+
+      // we clean up bestGain in the caller, since this function is templated and created many times
+      *pBestGain = static_cast<double>(bestGain);
+      return Error_None;
+   }
+};
+
+extern ErrorEbm PartitionMultiDimensionalInteraction(
+   InteractionCore * const pInteractionCore,
+   const size_t cRealDimensions,
+   const size_t * const acBins,
+   const InteractionFlags flags,
+   const size_t cSamplesLeafMin,
+   BinBase * aAuxiliaryBinsBase,
+   BinBase * const aBinsBase,
+   double * const pBestGain
+#ifndef NDEBUG
+   , const BinBase * const aDebugCopyBinsBase
+   , const BinBase * const pBinsEndDebug
+#endif // NDEBUG
+) {
+   const size_t cRuntimeScores = GetCountScores(pInteractionCore->GetCountClasses());
+
+   // higher order interactions are screened far less often than pairs, so we only specialize on a single score
+   EBM_ASSERT(1 <= cRuntimeScores);
+   if(pInteractionCore->IsHessian()) {
+      if(size_t { 1 } != cRuntimeScores) {
+         return PartitionMultiDimensionalInteractionInternal<true, k_dynamicScores>::Func(
+            pInteractionCore,
+            cRealDimensions,
+            acBins,
+            flags,
+            cSamplesLeafMin,
+            aAuxiliaryBinsBase,
+            aBinsBase,
+            pBestGain
+#ifndef NDEBUG
+            , aDebugCopyBinsBase
+            , pBinsEndDebug
+#endif // NDEBUG
+         );
+      } else {
+         return PartitionMultiDimensionalInteractionInternal<true, k_oneScore>::Func(
+            pInteractionCore,
+            cRealDimensions,
+            acBins,
+            flags,
+            cSamplesLeafMin,
+            aAuxiliaryBinsBase,
+            aBinsBase,
+            pBestGain
+#ifndef NDEBUG
+            , aDebugCopyBinsBase
+            , pBinsEndDebug
+#endif // NDEBUG
+         );
+      }
+   } else {
+      if(size_t { 1 } != cRuntimeScores) {
+         return PartitionMultiDimensionalInteractionInternal<false, k_dynamicScores>::Func(
+            pInteractionCore,
+            cRealDimensions,
+            acBins,
+            flags,
+            cSamplesLeafMin,
+            aAuxiliaryBinsBase,
+            aBinsBase,
+            pBestGain
+#ifndef NDEBUG
+            , aDebugCopyBinsBase
+            , pBinsEndDebug
+#endif // NDEBUG
+         );
+      } else {
+         return PartitionMultiDimensionalInteractionInternal<false, k_oneScore>::Func(
+            pInteractionCore,
+            cRealDimensions,
+            acBins,
+            flags,
+            cSamplesLeafMin,
+            aAuxiliaryBinsBase,
+            aBinsBase,
+            pBestGain
+#ifndef NDEBUG
+            , aDebugCopyBinsBase
+            , pBinsEndDebug
+#endif // NDEBUG
+         );
+      }
+   }
+}
+
+} // DEFINED_ZONE_NAME
@@ -44,7 +44,7 @@ INLINE_RELEASE_TEMPLATED static void SumAllBins(
    pBinOut->SetWeight(weightTotal);
 
    BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
-   const size_t cScores = GET_COUNT_SCORES(cCompilerScores, GetCountScores(pBoosterCore->GetCountClasses()));
+   const size_t cScores = GET_COUNT_SCORES(cCompilerScores, pBoosterCore->GetCountScores());
 
    // if we know how many scores there are, use the memory on the stack where the compiler can optimize access
    GradientPair<FloatBig, bHessian> aSumGradientPairsLocal[GetArrayScores(cCompilerScores)];
@@ -125,7 +125,7 @@ static ErrorEbm Flatten(
    }
 
    const BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
-   const size_t cScores = GetCountScores(pBoosterCore->GetCountClasses());
+   const size_t cScores = pBoosterCore->GetCountScores();
 
    EBM_ASSERT(!IsMultiplyError(cScores, cSlices));
    error = pInnerTermUpdate->EnsureTensorScoreCapacity(cScores * cSlices);
@@ -135,7 +135,7 @@ static ErrorEbm Flatten(
    }
 
    ActiveDataType * pSplit = pInnerTermUpdate->GetSplitPointer(iDimension);
-   FloatFast * pUpdateScore = pInnerTermUpdate->GetTensorScoresPointer();
+   FloatScore * pUpdateScore = pInnerTermUpdate->GetTensorScoresPointer();
 
    EBM_ASSERT(!IsOverflowBinSize<FloatBig>(bHessian, cScores)); // we're accessing allocated memory
    const size_t cBytesPerBin = GetBinSize<FloatBig>(bHessian, cScores);
@@ -193,7 +193,7 @@ static ErrorEbm Flatten(
                   aGradientPair[iScore].m_sumGradients, pTreeNode->GetWeight());
             }
 
-            *pUpdateScore = SafeConvertFloat<FloatFast>(updateScore);
+            *pUpdateScore = SafeConvertFloat<FloatScore>(updateScore);
             ++pUpdateScore;
 
             ++iScore;
@@ -269,7 +269,7 @@ static int FindBestSplitGain(
    }
 
    BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
-   const size_t cScores = GET_COUNT_SCORES(cCompilerScores, GetCountScores(pBoosterCore->GetCountClasses()));
+   const size_t cScores = GET_COUNT_SCORES(cCompilerScores, pBoosterCore->GetCountScores());
 
    auto * const pLeftChild = GetLeftNode(pTreeNodeScratchSpace);
 #ifndef NDEBUG
@@ -555,7 +555,7 @@ public:
       EBM_ASSERT(nullptr != pTotalGain);
 
       BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
-      const size_t cScores = GET_COUNT_SCORES(cCompilerScores, GetCountScores(pBoosterCore->GetCountClasses()));
+      const size_t cScores = GET_COUNT_SCORES(cCompilerScores, pBoosterCore->GetCountScores());
 
       EBM_ASSERT(!IsOverflowBinSize<FloatBig>(bHessian, cScores)); // we're accessing allocated memory
       const size_t cBytesPerBin = GetBinSize<FloatBig>(bHessian, cScores);
@@ -727,7 +727,7 @@ extern ErrorEbm PartitionOneDimensionalBoosting(
    ErrorEbm error;
 
    BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
-   const size_t cRuntimeScores = GetCountScores(pBoosterCore->GetCountClasses());
+   const size_t cRuntimeScores = pBoosterCore->GetCountScores();
 
    EBM_ASSERT(1 <= cRuntimeScores);
    if(pBoosterCore->IsHessian()) {
@@ -54,7 +54,7 @@ public:
       ErrorEbm error;
       BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
 
-      const size_t cScores = GET_COUNT_SCORES(cCompilerScores, GetCountScores(pBoosterCore->GetCountClasses()));
+      const size_t cScores = GET_COUNT_SCORES(cCompilerScores, pBoosterCore->GetCountScores());
       EBM_ASSERT(!IsOverflowBinSize<FloatBig>(bHessian, cScores)); // we're accessing allocated memory
       const size_t cBytesPerBin = GetBinSize<FloatBig>(bHessian, cScores);
 
@@ -511,7 +511,7 @@ public:
          } while(PREDICTABLE(pStateInit != pState));
       }
 
-      FloatFast * pUpdateScore = pInnerTermUpdate->GetTensorScoresPointer();
+      FloatScore * pUpdateScore = pInnerTermUpdate->GetTensorScoresPointer();
       auto * pCollapsedBin2 = aCollapsedBins;
 
       if(0 != (BoostFlags_GradientSums & flags)) {
@@ -520,7 +520,7 @@ public:
 
             for(size_t iScore = 0; iScore < cScores; ++iScore) {
                FloatBig updateScore = EbmStats::ComputeSinglePartitionUpdateGradientSum(pGradientPair[iScore].m_sumGradients);
-               *pUpdateScore = SafeConvertFloat<FloatFast>(updateScore);
+               *pUpdateScore = SafeConvertFloat<FloatScore>(updateScore);
                ++pUpdateScore;
             }
             pCollapsedBin2 = IndexBin(pCollapsedBin2, cBytesPerBin);
@@ -554,7 +554,7 @@ public:
                         pCollapsedBin2->GetWeight()
                      );
                   }
-                  *pUpdateScore = SafeConvertFloat<FloatFast>(updateScore);
+                  *pUpdateScore = SafeConvertFloat<FloatScore>(updateScore);
                   ++pUpdateScore;
                }
             }
@@ -583,7 +583,7 @@ public:
       double * const pTotalGain
    ) {
       BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
-      if(cPossibleScores == GetCountScores(pBoosterCore->GetCountClasses())) {
+      if(cPossibleScores == pBoosterCore->GetCountScores()) {
          return PartitionRandomBoostingInternal<bHessian, cPossibleScores>::Func(
             pRng,
             pBoosterShell,
@@ -639,7 +639,7 @@ extern ErrorEbm PartitionRandomBoosting(
    double * const pTotalGain
 ) {
    BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
-   const size_t cRuntimeScores = GetCountScores(pBoosterCore->GetCountClasses());
+   const size_t cRuntimeScores = pBoosterCore->GetCountScores();
 
    EBM_ASSERT(1 <= cRuntimeScores);
    if(pBoosterCore->IsHessian()) {
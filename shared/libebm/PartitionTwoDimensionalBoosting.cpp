@@ -18,7 +18,6 @@
 #include "Tensor.hpp"
 #include "GradientPair.hpp"
 #include "Bin.hpp"
-#include "TensorTotalsSum.hpp"
 #include "BoosterCore.hpp"
 #include "BoosterShell.hpp"
 
@@ -27,46 +26,32 @@ namespace DEFINED_ZONE_NAME {
 #error DEFINED_ZONE_NAME must be defined
 #endif // DEFINED_ZONE_NAME
 
-template<bool bHessian, size_t cCompilerScores, size_t cCompilerDimensions>
-static FloatBig SweepMultiDimensional(
+template<bool bHessian, size_t cCompilerScores>
+static FloatBig SweepPair(
    const size_t cRuntimeScores,
-   const size_t cRuntimeRealDimensions,
-   const size_t * const aiPoint,
-   const size_t * const acBins,
-   const size_t directionVectorLow,
-   const size_t iDimensionSweep,
-   const Bin<FloatBig, bHessian, GetArrayScores(cCompilerScores)> * const aBins,
+   const Bin<FloatBig, bHessian, GetArrayScores(cCompilerScores)> * const pStripFirst,
+   const Bin<FloatBig, bHessian, GetArrayScores(cCompilerScores)> * const pSubtractFirst,
+   const size_t cBytesStride,
+   const size_t cSweepBins,
    const size_t cSamplesLeafMin,
    Bin<FloatBig, bHessian, GetArrayScores(cCompilerScores)> * const pBinBestAndTemp,
    size_t * const piBestSplit
 #ifndef NDEBUG
-   , const Bin<FloatBig, bHessian, GetArrayScores(cCompilerScores)> * const aDebugCopyBins
    , const BinBase * const pBinsEndDebug
 #endif // NDEBUG
 ) {
+   // The bins hold the totals from TensorTotalsBuild, so the cell at index i of the strip is the total of everything
+   // at or below i along the sweep dimension on the low side of the other dimension's cut.  When we're on the high
+   // side of the other dimension's cut, pSubtractFirst points to the strip at that cut, and we subtract it.  This gives
+   // us the low side of every candidate cut with one or two bin reads instead of a TensorTotalsSum corner lookup, and
+   // the high side is the strip total minus the low side.
+
    const size_t cScores = GET_COUNT_SCORES(cCompilerScores, cRuntimeScores);
    EBM_ASSERT(!IsOverflowBinSize<FloatBig>(bHessian, cScores)); // we're accessing allocated memory
    const size_t cBytesPerBin = GetBinSize<FloatBig>(bHessian, cScores);
 
-   const size_t cRealDimensions = GET_COUNT_DIMENSIONS(cCompilerDimensions, cRuntimeRealDimensions);
-   EBM_ASSERT(1 <= cRealDimensions); // for interactions, we just return 0 for interactions with zero features
-   EBM_ASSERT(iDimensionSweep < cRealDimensions);
-   EBM_ASSERT(0 == (directionVectorLow & (size_t { 1 } << iDimensionSweep)));
-
-   TensorSumDimension aDimensions[k_dynamicDimensions == cCompilerDimensions ? k_cDimensionsMax : cCompilerDimensions];
-   size_t iDimensionInit = 0;
-   do {
-      // move data to a local variable that the compiler can reason about and then eliminate by moving to CPU registers
-
-      aDimensions[iDimensionInit].m_iPoint = aiPoint[iDimensionInit];
-      aDimensions[iDimensionInit].m_cBins = acBins[iDimensionInit];
-
-      ++iDimensionInit;
-   } while(cRealDimensions != iDimensionInit);
-
-   const size_t directionVectorHigh = directionVectorLow | size_t { 1 } << iDimensionSweep;
-   const size_t cSweepCuts = aDimensions[iDimensionSweep].m_cBins - 1;
-   EBM_ASSERT(1 <= cSweepCuts); // dimensions with 1 bin are removed earlier
+   EBM_ASSERT(2 <= cSweepBins); // dimensions with 1 bin are removed earlier
+   const size_t cSweepCuts = cSweepBins - 1;
 
    size_t iBestSplit = 0;
 
@@ -74,97 +59,112 @@ static FloatBig SweepMultiDimensional(
    ASSERT_BIN_OK(cBytesPerBin, p_DO_NOT_USE_DIRECTLY_Low, pBinsEndDebug);
    auto * const p_DO_NOT_USE_DIRECTLY_High = IndexBin(pBinBestAndTemp, cBytesPerBin * 3);
    ASSERT_BIN_OK(cBytesPerBin, p_DO_NOT_USE_DIRECTLY_High, pBinsEndDebug);
+   auto * const p_DO_NOT_USE_DIRECTLY_Total = IndexBin(pBinBestAndTemp, cBytesPerBin * 4);
+   ASSERT_BIN_OK(cBytesPerBin, p_DO_NOT_USE_DIRECTLY_Total, pBinsEndDebug);
 
    Bin<FloatBig, bHessian, GetArrayScores(cCompilerScores)> binLow;
    Bin<FloatBig, bHessian, GetArrayScores(cCompilerScores)> binHigh;
+   Bin<FloatBig, bHessian, GetArrayScores(cCompilerScores)> binTotal;
 
    // if we know how many scores there are, use the memory on the stack where the compiler can optimize access
    static constexpr bool bUseStackMemory = k_dynamicScores != cCompilerScores;
    auto * const aGradientPairsLow = bUseStackMemory ? binLow.GetGradientPairs() : p_DO_NOT_USE_DIRECTLY_Low->GetGradientPairs();
    auto * const aGradientPairsHigh = bUseStackMemory ? binHigh.GetGradientPairs() : p_DO_NOT_USE_DIRECTLY_High->GetGradientPairs();
+   auto * const aGradientPairsTotal = bUseStackMemory ? binTotal.GetGradientPairs() : p_DO_NOT_USE_DIRECTLY_Total->GetGradientPairs();
+
+   const auto * const pStripLast = IndexBin(pStripFirst, cBytesStride * cSweepCuts);
+   ASSERT_BIN_OK(cBytesPerBin, pStripLast, pBinsEndDebug);
+   binTotal.Copy(cScores, *pStripLast, pStripLast->GetGradientPairs(), aGradientPairsTotal);
+   if(nullptr != pSubtractFirst) {
+      const auto * const pSubtractLast = IndexBin(pSubtractFirst, cBytesStride * cSweepCuts);
+      ASSERT_BIN_OK(cBytesPerBin, pSubtractLast, pBinsEndDebug);
+      binTotal.Subtract(cScores, *pSubtractLast, pSubtractLast->GetGradientPairs(), aGradientPairsTotal);
+   }
+   const size_t cSamplesTotal = binTotal.GetCountSamples();
 
    EBM_ASSERT(0 < cSamplesLeafMin);
 
    FloatBig bestGain = k_illegalGainFloat;
+   size_t cSamplesLowPrev = 0;
+   const auto * pStrip = pStripFirst;
+   const auto * pSubtract = pSubtractFirst;
    size_t iBin = 0;
    do {
-      aDimensions[iDimensionSweep].m_iPoint = iBin;
-      EBM_ASSERT(2 == cRealDimensions); // our TensorTotalsSum needs to be templated as dynamic if we want to have something other than 2 dimensions
-      TensorTotalsSum<bHessian, cCompilerScores, cCompilerDimensions>(
-         cRuntimeScores,
-         cRealDimensions,
-         aDimensions,
-         directionVectorLow,
-         aBins,
-         binLow,
-         aGradientPairsLow
-#ifndef NDEBUG
-         , aDebugCopyBins
-         , pBinsEndDebug
-#endif // NDEBUG
-      );
-      if(LIKELY(cSamplesLeafMin <= binLow.GetCountSamples())) {
-         EBM_ASSERT(2 == cRealDimensions); // our TensorTotalsSum needs to be templated as dynamic if we want to have something other than 2 dimensions
-         TensorTotalsSum<bHessian, cCompilerScores, cCompilerDimensions>(
-            cRuntimeScores,
-            cRealDimensions,
-            aDimensions,
-            directionVectorHigh,
-            aBins,
-            binHigh,
-            aGradientPairsHigh
-#ifndef NDEBUG
-            , aDebugCopyBins
-            , pBinsEndDebug
-#endif // NDEBUG
-         );
-         if(LIKELY(cSamplesLeafMin <= binHigh.GetCountSamples())) {
-            FloatBig gain = 0;
-            EBM_ASSERT(0 < binLow.GetCountSamples());
-            EBM_ASSERT(0 < binHigh.GetCountSamples());
-
-            EBM_ASSERT(1 <= cScores);
-            size_t iScore = 0;
-            do {
-               // TODO : we can make this faster by doing the division in CalcPartialGain after we add all the numerators 
-               // (but only do this after we've determined the best node splitting score for classification, and the NewtonRaphsonStep for gain
+      ASSERT_BIN_OK(cBytesPerBin, pStrip, pBinsEndDebug);
+      size_t cSamplesLow = pStrip->GetCountSamples();
+      if(nullptr != pSubtract) {
+         ASSERT_BIN_OK(cBytesPerBin, pSubtract, pBinsEndDebug);
+         EBM_ASSERT(pSubtract->GetCountSamples() <= cSamplesLow);
+         cSamplesLow -= pSubtract->GetCountSamples();
+      }
+      EBM_ASSERT(cSamplesLow <= cSamplesTotal);
+      if(UNLIKELY(cSamplesTotal - cSamplesLow < cSamplesLeafMin)) {
+         // the high side only loses samples as the cut moves up, so no later cut can be legal either
+         break;
+      }
 
-               static constexpr bool bUseLogitBoost = k_bUseLogitboost && bHessian;
-               
-               const FloatBig gain1 = EbmStats::CalcPartialGain(
-                  aGradientPairsLow[iScore].m_sumGradients, bUseLogitBoost ? aGradientPairsLow[iScore].GetHess() : binLow.GetWeight());
-               EBM_ASSERT(std::isnan(gain1) || 0 <= gain1);
-               gain += gain1;
-               
-               const FloatBig gain2 = EbmStats::CalcPartialGain(
-                  aGradientPairsHigh[iScore].m_sumGradients, bUseLogitBoost ? aGradientPairsHigh[iScore].GetHess() : binHigh.GetWeight());
-               EBM_ASSERT(std::isnan(gain2) || 0 <= gain2);
-               gain += gain2;
+      // if the low side has the same number of samples as the previous cut, then the slice between them is empty
+      // and both cuts partition the samples identically.  The previous cut already has the same gain, and since
+      // ties keep the first cut we would not pick this one.
+      if(LIKELY(cSamplesLeafMin <= cSamplesLow) && cSamplesLowPrev != cSamplesLow) {
+         binLow.Copy(cScores, *pStrip, pStrip->GetGradientPairs(), aGradientPairsLow);
+         if(nullptr != pSubtract) {
+            binLow.Subtract(cScores, *pSubtract, pSubtract->GetGradientPairs(), aGradientPairsLow);
+         }
+         binHigh.Copy(cScores, binTotal, aGradientPairsTotal, aGradientPairsHigh);
+         binHigh.Subtract(cScores, binLow, aGradientPairsLow, aGradientPairsHigh);
+
+         FloatBig gain = 0;
+         EBM_ASSERT(0 < binLow.GetCountSamples());
+         EBM_ASSERT(0 < binHigh.GetCountSamples());
+
+         EBM_ASSERT(1 <= cScores);
+         size_t iScore = 0;
+         do {
+            // TODO : we can make this faster by doing the division in CalcPartialGain after we add all the numerators 
+            // (but only do this after we've determined the best node splitting score for classification, and the NewtonRaphsonStep for gain
+
+            static constexpr bool bUseLogitBoost = k_bUseLogitboost && bHessian;
+            
+            const FloatBig gain1 = EbmStats::CalcPartialGain(
+               aGradientPairsLow[iScore].m_sumGradients, bUseLogitBoost ? aGradientPairsLow[iScore].GetHess() : binLow.GetWeight());
+            EBM_ASSERT(std::isnan(gain1) || 0 <= gain1);
+            gain += gain1;
+            
+            const FloatBig gain2 = EbmStats::CalcPartialGain(
+               aGradientPairsHigh[iScore].m_sumGradients, bUseLogitBoost ? aGradientPairsHigh[iScore].GetHess() : binHigh.GetWeight());
+            EBM_ASSERT(std::isnan(gain2) || 0 <= gain2);
+            gain += gain2;
 
-               ++iScore;
-            } while(cScores != iScore);
-            EBM_ASSERT(std::isnan(gain) || 0 <= gain); // sumation of positive numbers should be positive
+            ++iScore;
+         } while(cScores != iScore);
+         EBM_ASSERT(std::isnan(gain) || 0 <= gain); // sumation of positive numbers should be positive
 
-            if(UNLIKELY(/* NaN */ !LIKELY(gain <= bestGain))) {
-               // propagate NaNs
+         if(UNLIKELY(/* NaN */ !LIKELY(gain <= bestGain))) {
+            // propagate NaNs
 
-               bestGain = gain;
-               iBestSplit = iBin;
+            bestGain = gain;
+            iBestSplit = iBin;
 
-               auto * const pTotalsLowOut = IndexBin(pBinBestAndTemp, cBytesPerBin * 0);
-               ASSERT_BIN_OK(cBytesPerBin, pTotalsLowOut, pBinsEndDebug);
+            auto * const pTotalsLowOut = IndexBin(pBinBestAndTemp, cBytesPerBin * 0);
+            ASSERT_BIN_OK(cBytesPerBin, pTotalsLowOut, pBinsEndDebug);
 
-               pTotalsLowOut->Copy(cScores, binLow, aGradientPairsLow);
+            pTotalsLowOut->Copy(cScores, binLow, aGradientPairsLow);
 
-               auto * const pTotalsHighOut = IndexBin(pBinBestAndTemp, cBytesPerBin * 1);
-               ASSERT_BIN_OK(cBytesPerBin, pTotalsHighOut, pBinsEndDebug);
+            auto * const pTotalsHighOut = IndexBin(pBinBestAndTemp, cBytesPerBin * 1);
+            ASSERT_BIN_OK(cBytesPerBin, pTotalsHighOut, pBinsEndDebug);
 
-               pTotalsHighOut->Copy(cScores, binHigh, aGradientPairsHigh);
-            } else {
-               EBM_ASSERT(!std::isnan(gain));
-            }
+            pTotalsHighOut->Copy(cScores, binHigh, aGradientPairsHigh);
+         } else {
+            EBM_ASSERT(!std::isnan(gain));
          }
       }
+      cSamplesLowPrev = cSamplesLow;
+
+      pStrip = IndexBin(pStrip, cBytesStride);
+      if(nullptr != pSubtract) {
+         pSubtract = IndexBin(pSubtract, cBytesStride);
+      }
       ++iBin;
    } while(cSweepCuts != iBin);
    *piBestSplit = iBestSplit;
@@ -192,32 +192,22 @@ public:
       , const BinBase * const aDebugCopyBinsBase
 #endif // NDEBUG
    ) {
-      static constexpr size_t cCompilerDimensions = 2;
-
       ErrorEbm error;
       BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
 
       auto * const aBins = pBoosterShell->GetBoostingBigBins()->Specialize<FloatBig, bHessian, GetArrayScores(cCompilerScores)>();
       Tensor * const pInnerTermUpdate = pBoosterShell->GetInnerTermUpdate();
 
-      const size_t cRuntimeScores = GetCountScores(pBoosterCore->GetCountClasses());
+      const size_t cRuntimeScores = pBoosterCore->GetCountScores();
       const size_t cScores = GET_COUNT_SCORES(cCompilerScores, cRuntimeScores);
       const size_t cBytesPerBin = GetBinSize<FloatBig>(bHessian, cScores);
 
       auto * const aAuxiliaryBins = aAuxiliaryBinsBase->Specialize<FloatBig, bHessian, GetArrayScores(cCompilerScores)>();
 
 #ifndef NDEBUG
-      const auto * const aDebugCopyBins = aDebugCopyBinsBase->Specialize<FloatBig, bHessian, GetArrayScores(cCompilerScores)>();
+      UNUSED(aDebugCopyBinsBase);
 #endif // NDEBUG
 
-      size_t aiStart[k_cDimensionsMax];
-      // technically this assignment to zero might not be needed, but if we left it uninitialized, then we would later
-      // be copying an unitialized memory location into another unitialized memory location which the static clang 
-      // analysis does not like and which seems might be problematic in some compilers even though not technically
-      // undefined behavior according to the standard
-      // https://stackoverflow.com/questions/11962457/why-is-using-an-uninitialized-variable-undefined-behavior
-      aiStart[1] = 0;
-
       EBM_ASSERT(2 == pTerm->GetCountRealDimensions());
       EBM_ASSERT(2 <= pTerm->GetCountDimensions());
       size_t iDimensionLoop = 0;
@@ -246,6 +236,12 @@ public:
       } while(pTermFeaturesEnd != pTermFeature);
       EBM_ASSERT(2 <= cBinsDimension1);
       EBM_ASSERT(2 <= cBinsDimension2);
+      EBM_ASSERT(acBins[0] == cBinsDimension1);
+      EBM_ASSERT(acBins[1] == cBinsDimension2);
+      UNUSED(acBins);
+
+      // the first dimension is contiguous in aBins, and the second dimension steps over whole rows
+      const size_t cBytesPerRow = cBytesPerBin * cBinsDimension1;
 
       FloatBig bestGain = k_illegalGainFloat;
 
@@ -263,23 +259,21 @@ public:
       LOG_0(Trace_Verbose, "PartitionTwoDimensionalBoostingInternal Starting FIRST bin sweep loop");
       size_t iBin1 = 0;
       do {
-         aiStart[0] = iBin1;
+         // the column at iBin1 holds the totals of the low side of the first dimension cut
+         const auto * const pColumnCut = IndexBin(aBins, cBytesPerBin * iBin1);
          size_t splitSecond1LowBest;
          auto * pTotals2LowLowBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 4);
          auto * pTotals2LowHighBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 5);
-         const FloatBig gain1 = SweepMultiDimensional<bHessian, cCompilerScores, cCompilerDimensions>(
+         const FloatBig gain1 = SweepPair<bHessian, cCompilerScores>(
             cRuntimeScores,
-            pTerm->GetCountRealDimensions(),
-            aiStart,
-            acBins,
-            0x0,
-            1,
-            aBins,
+            pColumnCut,
+            nullptr,
+            cBytesPerRow,
+            cBinsDimension2,
             cSamplesLeafMin,
             pTotals2LowLowBest,
             &splitSecond1LowBest
 #ifndef NDEBUG
-            , aDebugCopyBins
             , pBoosterShell->GetDebugBigBinsEnd()
 #endif // NDEBUG
          );
@@ -288,21 +282,18 @@ public:
             EBM_ASSERT(std::isnan(gain1) || 0 <= gain1);
 
             size_t splitSecond1HighBest;
-            auto * pTotals2HighLowBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 8);
-            auto * pTotals2HighHighBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 9);
-            const FloatBig gain2 = SweepMultiDimensional<bHessian, cCompilerScores, cCompilerDimensions>(
+            auto * pTotals2HighLowBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 9);
+            auto * pTotals2HighHighBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 10);
+            const FloatBig gain2 = SweepPair<bHessian, cCompilerScores>(
                cRuntimeScores,
-               pTerm->GetCountRealDimensions(),
-               aiStart,
-               acBins,
-               0x1,
-               1,
-               aBins,
+               IndexBin(aBins, cBytesPerBin * (cBinsDimension1 - 1)),
+               pColumnCut,
+               cBytesPerRow,
+               cBinsDimension2,
                cSamplesLeafMin,
                pTotals2HighLowBest,
                &splitSecond1HighBest
 #ifndef NDEBUG
-               , aDebugCopyBins
                , pBoosterShell->GetDebugBigBinsEnd()
 #endif // NDEBUG
             );
@@ -346,31 +337,29 @@ public:
       size_t splitFirst2LowBest;
       size_t splitFirst2HighBest;
 
-      auto * pTotals2LowLowBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 12);
-      auto * pTotals2LowHighBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 13);
-      auto * pTotals2HighLowBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 14);
-      auto * pTotals2HighHighBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 15);
+      auto * pTotals2LowLowBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 14);
+      auto * pTotals2LowHighBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 15);
+      auto * pTotals2HighLowBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 16);
+      auto * pTotals2HighHighBest = IndexBin(aAuxiliaryBins, cBytesPerBin * 17);
 
       LOG_0(Trace_Verbose, "PartitionTwoDimensionalBoostingInternal Starting SECOND bin sweep loop");
       size_t iBin2 = 0;
       do {
-         aiStart[1] = iBin2;
+         // the row at iBin2 holds the totals of the low side of the second dimension cut
+         const auto * const pRowCut = IndexBin(aBins, cBytesPerRow * iBin2);
          size_t splitSecond2LowBest;
-         auto * pTotals1LowLowBestInner = IndexBin(aAuxiliaryBins, cBytesPerBin * 16);
-         auto * pTotals1LowHighBestInner = IndexBin(aAuxiliaryBins, cBytesPerBin * 17);
-         const FloatBig gain1 = SweepMultiDimensional<bHessian, cCompilerScores, cCompilerDimensions>(
+         auto * pTotals1LowLowBestInner = IndexBin(aAuxiliaryBins, cBytesPerBin * 18);
+         auto * pTotals1LowHighBestInner = IndexBin(aAuxiliaryBins, cBytesPerBin * 19);
+         const FloatBig gain1 = SweepPair<bHessian, cCompilerScores>(
             cRuntimeScores,
-            pTerm->GetCountRealDimensions(),
-            aiStart,
-            acBins,
-            0x0,
-            0,
-            aBins,
+            pRowCut,
+            nullptr,
+            cBytesPerBin,
+            cBinsDimension1,
             cSamplesLeafMin,
             pTotals1LowLowBestInner,
             &splitSecond2LowBest
 #ifndef NDEBUG
-            , aDebugCopyBins
             , pBoosterShell->GetDebugBigBinsEnd()
 #endif // NDEBUG
          );
@@ -379,21 +368,18 @@ public:
             EBM_ASSERT(std::isnan(gain1) || 0 <= gain1);
 
             size_t splitSecond2HighBest;
-            auto * pTotals1HighLowBestInner = IndexBin(aAuxiliaryBins, cBytesPerBin * 20);
-            auto * pTotals1HighHighBestInner = IndexBin(aAuxiliaryBins, cBytesPerBin * 21);
-            const FloatBig gain2 = SweepMultiDimensional<bHessian, cCompilerScores, cCompilerDimensions>(
+            auto * pTotals1HighLowBestInner = IndexBin(aAuxiliaryBins, cBytesPerBin * 23);
+            auto * pTotals1HighHighBestInner = IndexBin(aAuxiliaryBins, cBytesPerBin * 24);
+            const FloatBig gain2 = SweepPair<bHessian, cCompilerScores>(
                cRuntimeScores,
-               pTerm->GetCountRealDimensions(),
-               aiStart,
-               acBins,
-               0x2,
-               0,
-               aBins,
+               IndexBin(aBins, cBytesPerRow * (cBinsDimension2 - 1)),
+               pRowCut,
+               cBytesPerBin,
+               cBinsDimension1,
                cSamplesLeafMin,
                pTotals1HighLowBestInner,
                &splitSecond2HighBest
 #ifndef NDEBUG
-               , aDebugCopyBins
                , pBoosterShell->GetDebugBigBinsEnd()
 #endif // NDEBUG
             );
@@ -581,26 +567,26 @@ public:
                            );
                         }
 
-                        FloatFast * const aUpdateScores = pInnerTermUpdate->GetTensorScoresPointer();
+                        FloatScore * const aUpdateScores = pInnerTermUpdate->GetTensorScoresPointer();
                         if(splitFirst2LowBest < splitFirst2HighBest) {
-                           aUpdateScores[0 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowLow);
-                           aUpdateScores[1 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowHigh);
-                           aUpdateScores[2 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowHigh);
-                           aUpdateScores[3 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighLow);
-                           aUpdateScores[4 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighLow);
-                           aUpdateScores[5 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighHigh);
+                           aUpdateScores[0 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowLow);
+                           aUpdateScores[1 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowHigh);
+                           aUpdateScores[2 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowHigh);
+                           aUpdateScores[3 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighLow);
+                           aUpdateScores[4 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighLow);
+                           aUpdateScores[5 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighHigh);
                         } else if(splitFirst2HighBest < splitFirst2LowBest) {
-                           aUpdateScores[0 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowLow);
-                           aUpdateScores[1 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowLow);
-                           aUpdateScores[2 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowHigh);
-                           aUpdateScores[3 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighLow);
-                           aUpdateScores[4 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighHigh);
-                           aUpdateScores[5 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighHigh);
+                           aUpdateScores[0 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowLow);
+                           aUpdateScores[1 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowLow);
+                           aUpdateScores[2 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowHigh);
+                           aUpdateScores[3 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighLow);
+                           aUpdateScores[4 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighHigh);
+                           aUpdateScores[5 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighHigh);
                         } else {
-                           aUpdateScores[0 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowLow);
-                           aUpdateScores[1 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowHigh);
-                           aUpdateScores[2 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighLow);
-                           aUpdateScores[3 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighHigh);
+                           aUpdateScores[0 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowLow);
+                           aUpdateScores[1 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowHigh);
+                           aUpdateScores[2 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighLow);
+                           aUpdateScores[3 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighHigh);
                         }
                      }
                   } else {
@@ -705,26 +691,26 @@ public:
                               pTotals1HighHighBest->GetWeight()
                            );
                         }
-                        FloatFast * const aUpdateScores = pInnerTermUpdate->GetTensorScoresPointer();
+                        FloatScore * const aUpdateScores = pInnerTermUpdate->GetTensorScoresPointer();
                         if(splitFirst1LowBest < splitFirst1HighBest) {
-                           aUpdateScores[0 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowLow);
-                           aUpdateScores[1 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighLow);
-                           aUpdateScores[2 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowHigh);
-                           aUpdateScores[3 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighLow);
-                           aUpdateScores[4 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowHigh);
-                           aUpdateScores[5 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighHigh);
+                           aUpdateScores[0 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowLow);
+                           aUpdateScores[1 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighLow);
+                           aUpdateScores[2 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowHigh);
+                           aUpdateScores[3 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighLow);
+                           aUpdateScores[4 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowHigh);
+                           aUpdateScores[5 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighHigh);
                         } else if(splitFirst1HighBest < splitFirst1LowBest) {
-                           aUpdateScores[0 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowLow);
-                           aUpdateScores[1 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighLow);
-                           aUpdateScores[2 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowLow);
-                           aUpdateScores[3 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighHigh);
-                           aUpdateScores[4 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowHigh);
-                           aUpdateScores[5 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighHigh);
+                           aUpdateScores[0 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowLow);
+                           aUpdateScores[1 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighLow);
+                           aUpdateScores[2 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowLow);
+                           aUpdateScores[3 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighHigh);
+                           aUpdateScores[4 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowHigh);
+                           aUpdateScores[5 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighHigh);
                         } else {
-                           aUpdateScores[0 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowLow);
-                           aUpdateScores[1 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighLow);
-                           aUpdateScores[2 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionLowHigh);
-                           aUpdateScores[3 * cScores + iScore] = SafeConvertFloat<FloatFast>(predictionHighHigh);
+                           aUpdateScores[0 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowLow);
+                           aUpdateScores[1 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighLow);
+                           aUpdateScores[2 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionLowHigh);
+                           aUpdateScores[3 * cScores + iScore] = SafeConvertFloat<FloatScore>(predictionHighHigh);
                         }
                      }
                   }
@@ -772,8 +758,8 @@ public:
             );
          }
 
-         FloatFast * const aUpdateScores = pInnerTermUpdate->GetTensorScoresPointer();
-         aUpdateScores[iScore] = SafeConvertFloat<FloatFast>(update);
+         FloatScore * const aUpdateScores = pInnerTermUpdate->GetTensorScoresPointer();
+         aUpdateScores[iScore] = SafeConvertFloat<FloatScore>(update);
       }
       return Error_None;
    }
@@ -798,7 +784,7 @@ public:
 #endif // NDEBUG
    ) {
       BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
-      if(cPossibleScores == GetCountScores(pBoosterCore->GetCountClasses())) {
+      if(cPossibleScores == pBoosterCore->GetCountScores()) {
          return PartitionTwoDimensionalBoostingInternal<bHessian, cPossibleScores>::Func(
             pBoosterShell,
             pTerm,
@@ -869,7 +855,7 @@ extern ErrorEbm PartitionTwoDimensionalBoosting(
 #endif // NDEBUG
 ) {
    BoosterCore * const pBoosterCore = pBoosterShell->GetBoosterCore();
-   const size_t cRuntimeScores = GetCountScores(pBoosterCore->GetCountClasses());
+   const size_t cRuntimeScores = pBoosterCore->GetCountScores();
 
    EBM_ASSERT(1 <= cRuntimeScores);
    if(pBoosterCore->IsHessian()) {
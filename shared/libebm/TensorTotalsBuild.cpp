@@ -140,8 +140,8 @@ namespace DEFINED_ZONE_NAME {
 //- have a look at our final dimensionality.Is the totals calculation the bottleneck, or the point to corner totals function ?
 //- I think I understand the costs of all implementations of point to corner computation, so don't implement the (1,1,...,1,1) to point algorithm yet.. try implementing the more optimized totals calculation (with more memory).  After we have the optimized totals calculation, then try to re-do the splitting code to do splitting at the same time as totals calculation.  If that isn't better than our existing stuff, then optimzie the point to corner calculation code
 //- implement a function that calcualtes the total of any volume using just the(0, 0, ..., 0, 0) totals ..as a debugging function.We might use this for trying out more complicated splits where we allow 2 splits on some axies
-// TODO: build a pair and triple specific version of this function.  For pairs we can get ride of the pPrevious and just use the actual cell at (-1,-1) from our current cell, and we can use two loops with everything in memory [look at code above from before we incoporated the previous totals].  Triples would also benefit from pulling things out since we have low iterations of the inner loop and we can access indicies directly without additional add/subtract/bit operations.  Beyond triples, the combinatorial choices start to explode, so we should probably use this general N-dimensional code.
-// TODO: after we build pair and triple specific versions of this function, we don't need to have a compiler cCompilerDimensions, since the compiler won't really be able to simpify the loops that are exploding in dimensionality
+// Pairs and triples use TensorTotalsBuildLowDimensions below.  Beyond triples the separable passes cost
+// more than this single pass with its side planes, so we use this general N-dimensional code there.
 // TODO: sort our N-dimensional groups at initialization so that the longest dimension is first!  That way we can more efficiently walk through contiguous memory better in this function!  After we determine the splits, we can undo the re-ordering for splitting the tensor, which has just a few cells, so will be efficient
 template<bool bHessian, size_t cCompilerScores, size_t cCompilerDimensions>
 class TensorTotalsBuildInternal final {
@@ -339,6 +339,146 @@ public:
    }
 };
 
+// pairs and triples are built with one pass per dimension instead of the general code above
+static constexpr size_t k_cTensorTotalsBuildLowDimensionsMax = 3;
+
+template<bool bHessian, size_t cCompilerScores, size_t cCompilerDimensions>
+class TensorTotalsBuildLowDimensions final {
+public:
+
+   TensorTotalsBuildLowDimensions() = delete; // this is a static class.  Do not construct
+
+   static void Func(
+      const size_t cRuntimeScores,
+      const size_t cRuntimeRealDimensions,
+      const size_t * const acBins,
+      BinBase * aAuxiliaryBinsBase,
+      BinBase * const aBinsBase
+#ifndef NDEBUG
+      , BinBase * const aDebugCopyBinsBase
+      , const BinBase * const pBinsEndDebug
+#endif // NDEBUG
+   ) {
+      // The totals are separable, so we accumulate along one dimension at a time.  The pass along dimension 0
+      // carries a running sum down each row.  The pass along any other dimension adds the bins one stride back,
+      // which for every block of that dimension is a single contiguous run of independent adds that does not
+      // restart at the row boundaries.  Every pass walks memory in order regardless of which dimension is the
+      // longest, so we do not need to reorder the dimensions, and no auxiliary memory is needed.
+
+      static_assert(2 <= cCompilerDimensions, "only use this for pairs and above");
+      static_assert(cCompilerDimensions <= k_cTensorTotalsBuildLowDimensionsMax, "use the general code above for more dimensions");
+
+      static constexpr size_t cArrayScores = GetArrayScores(cCompilerScores);
+
+      LOG_0(Trace_Verbose, "Entered BuildFastTotals low dimensions");
+
+      UNUSED(cRuntimeRealDimensions);
+      EBM_ASSERT(cCompilerDimensions == cRuntimeRealDimensions);
+      UNUSED(aAuxiliaryBinsBase);
+
+      auto * const aBins = aBinsBase->Specialize<FloatBig, bHessian, cArrayScores>();
+
+      const size_t cScores = GET_COUNT_SCORES(cCompilerScores, cRuntimeScores);
+      EBM_ASSERT(!IsOverflowBinSize<FloatBig>(bHessian, cScores)); // we're accessing allocated memory
+      const size_t cBytesPerBin = GetBinSize<FloatBig>(bHessian, cScores);
+
+      size_t cTensorBins = 1;
+      size_t iDimension = 0;
+      do {
+         // cBins can only be 0 if there are zero training and zero validation samples
+         // we don't boost or allow interaction updates if there are zero training samples
+         EBM_ASSERT(2 <= acBins[iDimension]);
+         cTensorBins *= acBins[iDimension];
+         ++iDimension;
+      } while(cCompilerDimensions != iDimension);
+      const auto * const pBinsEnd = IndexBin(aBins, cBytesPerBin * cTensorBins);
+      EBM_ASSERT(pBinsEnd <= pBinsEndDebug);
+
+      {
+         const size_t cBytesPerRow = cBytesPerBin * acBins[0];
+         auto * pRowStart = aBins;
+         do {
+            ASSERT_BIN_OK(cBytesPerBin, pRowStart, pBinsEndDebug);
+            auto * pPrev = pRowStart;
+            auto * pBin = IndexBin(pRowStart, cBytesPerBin);
+            pRowStart = IndexBin(pRowStart, cBytesPerRow);
+            do {
+               pBin->Add(cScores, *pPrev);
+               pPrev = pBin;
+               pBin = IndexBin(pBin, cBytesPerBin);
+            } while(pRowStart != pBin);
+         } while(pBinsEnd != pRowStart);
+      }
+
+      size_t cBytesStride = cBytesPerBin * acBins[0];
+      iDimension = 1;
+      do {
+         const size_t cBytesPerBlock = cBytesStride * acBins[iDimension];
+         auto * pBlockStart = aBins;
+         do {
+            ASSERT_BIN_OK(cBytesPerBin, pBlockStart, pBinsEndDebug);
+            auto * pBin = IndexBin(pBlockStart, cBytesStride);
+            pBlockStart = IndexBin(pBlockStart, cBytesPerBlock);
+            do {
+               pBin->Add(cScores, *NegativeIndexBin(pBin, cBytesStride));
+               pBin = IndexBin(pBin, cBytesPerBin);
+            } while(pBlockStart != pBin);
+         } while(pBinsEnd != pBlockStart);
+         cBytesStride = cBytesPerBlock;
+         ++iDimension;
+      } while(cCompilerDimensions != iDimension);
+
+#ifndef NDEBUG
+      UNUSED(aDebugCopyBinsBase);
+#ifdef CHECK_TENSORS
+      auto * const pDebugBin = static_cast<Bin<FloatBig, bHessian, cArrayScores> *>(malloc(cBytesPerBin));
+      auto * aDebugCopyBins = aDebugCopyBinsBase->Specialize<FloatBig, bHessian, cArrayScores>();
+      if(nullptr != aDebugCopyBins && nullptr != pDebugBin) {
+         size_t aiStart[k_cDimensionsMax];
+         size_t aiLast[k_cDimensionsMax];
+         for(size_t iDebugDimension = 0; iDebugDimension < cCompilerDimensions; ++iDebugDimension) {
+            aiStart[iDebugDimension] = 0;
+            aiLast[iDebugDimension] = 0;
+         }
+         const auto * pBin = aBins;
+         while(true) {
+            TensorTotalsSumDebugSlow<bHessian>(
+               cScores,
+               cCompilerDimensions,
+               aiStart,
+               aiLast,
+               acBins,
+               aDebugCopyBins->Downgrade(),
+               *pDebugBin->Downgrade()
+            );
+            EBM_ASSERT(pDebugBin->GetCountSamples() == pBin->GetCountSamples());
+            pBin = IndexBin(pBin, cBytesPerBin);
+
+            size_t iDebugDimension = 0;
+            while(true) {
+               ++aiLast[iDebugDimension];
+               if(acBins[iDebugDimension] != aiLast[iDebugDimension]) {
+                  break;
+               }
+               aiLast[iDebugDimension] = 0;
+               ++iDebugDimension;
+               if(cCompilerDimensions == iDebugDimension) {
+                  break;
+               }
+            }
+            if(cCompilerDimensions == iDebugDimension) {
+               break;
+            }
+         }
+      }
+      free(pDebugBin);
+#endif // CHECK_TENSORS
+#endif // NDEBUG
+
+      LOG_0(Trace_Verbose, "Exited BuildFastTotals low dimensions");
+   }
+};
+
 template<bool bHessian, size_t cCompilerScores, size_t cCompilerDimensionsPossible>
 class TensorTotalsBuildDimensions final {
 public:
@@ -362,17 +502,31 @@ public:
       EBM_ASSERT(1 <= cRealDimensions);
       EBM_ASSERT(cRealDimensions <= k_cDimensionsMax);
       if(cCompilerDimensionsPossible == cRealDimensions) {
-         TensorTotalsBuildInternal<bHessian, cCompilerScores, cCompilerDimensionsPossible>::Func(
-            cRuntimeScores,
-            cRealDimensions,
-            acBins,
-            aAuxiliaryBinsBase,
-            aBinsBase
+         if(cCompilerDimensionsPossible <= k_cTensorTotalsBuildLowDimensionsMax) {
+            TensorTotalsBuildLowDimensions<bHessian, cCompilerScores, EbmMin(cCompilerDimensionsPossible, k_cTensorTotalsBuildLowDimensionsMax)>::Func(
+               cRuntimeScores,
+               cRealDimensions,
+               acBins,
+               aAuxiliaryBinsBase,
+               aBinsBase
 #ifndef NDEBUG
-            , aDebugCopyBinsBase
-            , pBinsEndDebug
+               , aDebugCopyBinsBase
+               , pBinsEndDebug
 #endif // NDEBUG
-         );
+            );
+         } else {
+            TensorTotalsBuildInternal<bHessian, cCompilerScores, cCompilerDimensionsPossible>::Func(
+               cRuntimeScores,
+               cRealDimensions,
+               acBins,
+               aAuxiliaryBinsBase,
+               aBinsBase
+#ifndef NDEBUG
+               , aDebugCopyBinsBase
+               , pBinsEndDebug
+#endif // NDEBUG
+            );
+         }
       } else {
          TensorTotalsBuildDimensions<bHessian, cCompilerScores, cCompilerDimensionsPossible + 1>::Func(
             cRuntimeScores,
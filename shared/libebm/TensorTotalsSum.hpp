@@ -12,6 +12,8 @@
 
 #include "bridge_cpp.hpp" // GetArrayScores
 
+#include "ebm_internal.hpp" // k_dynamicDimensions
+
 #include "GradientPair.hpp"
 #include "Bin.hpp"
 
@@ -440,7 +442,7 @@ INLINE_ALWAYS static void TensorTotalsSum(
 #endif // NDEBUG
       );
    } else {
-      EBM_ASSERT(2 != cRuntimeRealDimensions && 3 != cRuntimeRealDimensions);
+      EBM_ASSERT(k_dynamicDimensions == cCompilerDimensions || (2 != cRuntimeRealDimensions && 3 != cRuntimeRealDimensions));
       TensorTotalsSumMulti<bHessian, cCompilerScores>(
          cRuntimeScores,
          cRuntimeRealDimensions,
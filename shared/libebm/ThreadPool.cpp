@@ -0,0 +1,191 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "precompiled_header_cpp.hpp"
+
+#include <stdlib.h> // getenv
+
+#include "logging.h" // EBM_ASSERT
+#include "common_c.h" // WARNING_DISABLE_DEPRECATED_FUNCTION, IsStringEqualsCaseInsensitive
+#include "common_cpp.hpp" // IsConvertError
+
+#include "ThreadPool.hpp"
+
+namespace DEFINED_ZONE_NAME {
+#ifndef DEFINED_ZONE_NAME
+#error DEFINED_ZONE_NAME must be defined
+#endif // DEFINED_ZONE_NAME
+
+extern size_t GetCountThreadsRequested() {
+   WARNING_PUSH
+   WARNING_DISABLE_DEPRECATED_FUNCTION
+   const char * sThreads = getenv("LIBEBM_THREADS");
+   WARNING_POP
+
+   if(nullptr == sThreads) {
+      return size_t { 1 };
+   }
+
+   sThreads = SkipWhitespace(sThreads);
+   if(nullptr != IsStringEqualsCaseInsensitive(sThreads, "auto")) {
+      // hardware_concurrency is allowed to return 0 if it does not know
+      const unsigned int cHardwareThreads = std::thread::hardware_concurrency();
+      const size_t cThreads = size_t { 0 } == cHardwareThreads ? size_t { 1 } : static_cast<size_t>(cHardwareThreads);
+      LOG_N(Trace_Info, "INFO GetCountThreadsRequested LIBEBM_THREADS=auto resolved to %" IntEbmPrintf, static_cast<IntEbm>(cThreads));
+      return k_cThreadsMax < cThreads ? k_cThreadsMax : cThreads;
+   }
+
+   size_t cThreads = 0;
+   const char * pDigit = sThreads;
+   while('0' <= *pDigit && *pDigit <= '9') {
+      cThreads = cThreads * size_t { 10 } + static_cast<size_t>(*pDigit - '0');
+      if(k_cThreadsMax < cThreads) {
+         LOG_N(Trace_Warning, "WARNING GetCountThreadsRequested LIBEBM_THREADS capped at %" IntEbmPrintf, static_cast<IntEbm>(k_cThreadsMax));
+         return k_cThreadsMax;
+      }
+      ++pDigit;
+   }
+   if(sThreads == pDigit || '\0' != *SkipWhitespace(pDigit) || size_t { 0 } == cThreads) {
+      LOG_0(Trace_Warning, "WARNING GetCountThreadsRequested LIBEBM_THREADS is not a positive integer or \"auto\"");
+      return size_t { 1 };
+   }
+   return cThreads;
+}
+
+extern size_t GetCountThreadsRequested(const IntEbm countThreads) {
+   EBM_ASSERT(IntEbm { 0 } <= countThreads);
+   if(IntEbm { 0 } == countThreads) {
+      return GetCountThreadsRequested();
+   }
+   if(IsConvertError<size_t>(countThreads) || k_cThreadsMax < static_cast<size_t>(countThreads)) {
+      LOG_N(Trace_Warning, "WARNING GetCountThreadsRequested countThreads capped at %" IntEbmPrintf, static_cast<IntEbm>(k_cThreadsMax));
+      return k_cThreadsMax;
+   }
+   return static_cast<size_t>(countThreads);
+}
+
+ThreadPool::ThreadPool() noexcept :
+   m_task(nullptr),
+   m_pContext(nullptr),
+   m_cTasks(0),
+   m_iTaskNext(0),
+   m_cTasksUnfinished(0),
+   m_bStop(false) {
+}
+
+ThreadPool::~ThreadPool() {
+   Stop();
+}
+
+void ThreadPool::Stop() {
+   if(m_workers.empty()) {
+      return;
+   }
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_bStop = true;
+   }
+   m_conditionWork.notify_all();
+   for(std::thread & worker : m_workers) {
+      if(worker.joinable()) {
+         worker.join();
+      }
+   }
+   m_workers.clear();
+   m_bStop = false;
+}
+
+void ThreadPool::WorkerLoop() {
+   std::unique_lock<std::mutex> lock(m_mutex);
+   while(true) {
+      m_conditionWork.wait(lock, [this] { return m_bStop || m_iTaskNext < m_cTasks; });
+      if(m_bStop) {
+         return;
+      }
+      const size_t iTask = m_iTaskNext;
+      ++m_iTaskNext;
+      const ThreadPoolTask task = m_task;
+      void * const pContext = m_pContext;
+
+      lock.unlock();
+      (*task)(pContext, iTask);
+      lock.lock();
+
+      EBM_ASSERT(size_t { 1 } <= m_cTasksUnfinished);
+      --m_cTasksUnfinished;
+      if(size_t { 0 } == m_cTasksUnfinished) {
+         m_conditionDone.notify_all();
+      }
+   }
+}
+
+ErrorEbm ThreadPool::Start(const size_t cThreads) {
+   LOG_N(Trace_Info, "Entered ThreadPool::Start: cThreads=%" IntEbmPrintf, static_cast<IntEbm>(cThreads));
+
+   EBM_ASSERT(m_workers.empty());
+   if(cThreads <= size_t { 1 }) {
+      return Error_None;
+   }
+
+   try {
+      m_workers.reserve(cThreads - size_t { 1 });
+      for(size_t iWorker = 1; iWorker < cThreads; ++iWorker) {
+         m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+      }
+   } catch(const std::bad_alloc &) {
+      LOG_0(Trace_Warning, "WARNING ThreadPool::Start Out of memory");
+      Stop();
+      return Error_OutOfMemory;
+   } catch(...) {
+      // the C++ standard leaves the exceptions from starting a thread implementation specific
+      LOG_0(Trace_Warning, "WARNING ThreadPool::Start thread start failed");
+      Stop();
+      return Error_ThreadStartFailed;
+   }
+
+   LOG_0(Trace_Info, "Exited ThreadPool::Start");
+   return Error_None;
+}
+
+void ThreadPool::Run(const size_t cTasks, const ThreadPoolTask task, void * const pContext) {
+   EBM_ASSERT(nullptr != task);
+
+   if(m_workers.empty() || cTasks <= size_t { 1 }) {
+      for(size_t iTask = 0; iTask < cTasks; ++iTask) {
+         (*task)(pContext, iTask);
+      }
+      return;
+   }
+
+   std::lock_guard<std::mutex> lockRun(m_mutexRun);
+   std::unique_lock<std::mutex> lock(m_mutex);
+
+   m_task = task;
+   m_pContext = pContext;
+   m_cTasks = cTasks;
+   m_iTaskNext = 0;
+   m_cTasksUnfinished = cTasks;
+   m_conditionWork.notify_all();
+
+   // the calling thread takes tasks too instead of sitting idle
+   while(m_iTaskNext < m_cTasks) {
+      const size_t iTask = m_iTaskNext;
+      ++m_iTaskNext;
+
+      lock.unlock();
+      (*task)(pContext, iTask);
+      lock.lock();
+
+      EBM_ASSERT(size_t { 1 } <= m_cTasksUnfinished);
+      --m_cTasksUnfinished;
+   }
+   m_conditionDone.wait(lock, [this] { return size_t { 0 } == m_cTasksUnfinished; });
+
+   m_task = nullptr;
+   m_pContext = nullptr;
+   m_cTasks = 0;
+   m_iTaskNext = 0;
+}
+
+} // DEFINED_ZONE_NAME
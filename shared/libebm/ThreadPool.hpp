@@ -0,0 +1,77 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <stddef.h> // size_t, ptrdiff_t
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "libebm.h" // ErrorEbm
+#include "zones.h"
+
+namespace DEFINED_ZONE_NAME {
+#ifndef DEFINED_ZONE_NAME
+#error DEFINED_ZONE_NAME must be defined
+#endif // DEFINED_ZONE_NAME
+
+// anything above this is almost certainly a typo, and each thread costs scratch memory
+static constexpr size_t k_cThreadsMax = 256;
+
+// tasks are plain C style callbacks so that nothing allocates or throws once the pool is running
+typedef void (* ThreadPoolTask)(void * const pContext, const size_t iTask);
+
+// returns the number of threads requested through the LIBEBM_THREADS environment variable, or 1 if unset
+extern size_t GetCountThreadsRequested();
+
+// returns countThreads capped at k_cThreadsMax, or GetCountThreadsRequested() if countThreads is 0.  The caller
+// rejects negative values
+extern size_t GetCountThreadsRequested(const IntEbm countThreads);
+
+class ThreadPool final {
+   // the calling thread always participates in Run, so we hold one less worker than the thread count
+   std::vector<std::thread> m_workers;
+
+   // serializes callers from different BoosterShell views that share one BoosterCore
+   std::mutex m_mutexRun;
+
+   std::mutex m_mutex;
+   std::condition_variable m_conditionWork;
+   std::condition_variable m_conditionDone;
+
+   ThreadPoolTask m_task;
+   void * m_pContext;
+   size_t m_cTasks;
+   size_t m_iTaskNext;
+   size_t m_cTasksUnfinished;
+   bool m_bStop;
+
+   void WorkerLoop();
+   void Stop();
+
+public:
+
+   ThreadPool() noexcept;
+   ~ThreadPool();
+
+   ThreadPool(const ThreadPool &) = delete;
+   ThreadPool & operator=(const ThreadPool &) = delete;
+
+   ErrorEbm Start(const size_t cThreads);
+
+   inline size_t GetCountThreads() const noexcept {
+      return m_workers.size() + size_t { 1 };
+   }
+
+   // runs task(pContext, iTask) for every iTask in [0, cTasks) and returns after all of them have finished.
+   // Which thread executes which task is not deterministic, so tasks should only depend on their index.
+   void Run(const size_t cTasks, const ThreadPoolTask task, void * const pContext);
+};
+
+} // DEFINED_ZONE_NAME
+
+#endif // THREAD_POOL_HPP
@@ -5,7 +5,10 @@
 #ifndef BRIDGE_C_H
 #define BRIDGE_C_H
 
-#include <stdlib.h> // free
+#include <stdlib.h> // free, posix_memalign
+#ifdef _MSC_VER
+#include <malloc.h> // _aligned_malloc, _aligned_free
+#endif // _MSC_VER
 
 #include "libebm.h" // ErrorEbm, BoolEbm, etc..
 
@@ -77,6 +80,13 @@ struct ObjectiveWrapper {
    double m_hessianConstant;
    BoolEbm m_bObjectiveHasHessian;
    BoolEbm m_bRmse;
+   // multitask objectives handle every target of the dataset jointly, and single task objectives handle only one
+   BoolEbm m_bMultitask;
+
+   // the number of samples processed per SIMD operation in the zone that created this objective (1 for scalar zones)
+   size_t m_cSIMDPack;
+   // the number of lanes that this objective's ApplyUpdate expects the bit packs to be interleaved across
+   size_t m_cBitPackLanes;
 
    // these are C++ function pointer definitions that exist per-zone, and must remain hidden in the C interface
    void * m_pFunctionPointersCpp;
@@ -87,15 +97,86 @@ inline static void InitializeObjectiveWrapperUnfailing(ObjectiveWrapper * const
    pObjectiveWrapper->m_pFunctionPointersCpp = NULL;
 }
 
+// SIMD zones put vector registers inside their *Objective classes, and those need more alignment than malloc
+// guarantees.  The objective memory is freed in the main zone, so allocation and free both live here in the bridge.
+#define k_cObjectiveAlignment 64
+
+inline static void * AlignedAlloc(const size_t cBytes) {
+#ifdef _MSC_VER
+   return _aligned_malloc(cBytes, k_cObjectiveAlignment);
+#else // _MSC_VER
+   void * pMemory;
+   if(0 != posix_memalign(&pMemory, k_cObjectiveAlignment, cBytes)) {
+      return NULL;
+   }
+   return pMemory;
+#endif // _MSC_VER
+}
+
+inline static void AlignedFree(void * const pMemory) {
+#ifdef _MSC_VER
+   _aligned_free(pMemory);
+#else // _MSC_VER
+   free(pMemory);
+#endif // _MSC_VER
+}
+
 inline static void FreeObjectiveWrapperInternals(ObjectiveWrapper * const pObjectiveWrapper) {
-   free(pObjectiveWrapper->m_pObjective);
+   AlignedFree(pObjectiveWrapper->m_pObjective);
    free(pObjectiveWrapper->m_pFunctionPointersCpp);
 }
 
+struct MetricBridge {
+   size_t m_cScores;
+   size_t m_cSamples;
+
+   // RMSE objectives only keep the residuals (score - target), so exactly one of these is non-null
+   const void * m_aSampleScores;
+   const void * m_aResiduals;
+
+   const void * m_aTargets;
+   const void * m_aWeights;
+   double m_totalWeight;
+
+   double m_metricOut;
+};
+
+struct MetricWrapper;
+
+typedef ErrorEbm (* CALC_METRIC_C)(const MetricWrapper * const pMetricWrapper, MetricBridge * const pData);
+
+struct MetricWrapper {
+   CALC_METRIC_C m_pCalcMetricC;
+   // everything below here the C++ *Metric specific class needs to fill out
+
+   // void for the same reason as ObjectiveWrapper::m_pObjective
+   void * m_pMetric;
+
+   BoolEbm m_bMaximizeMetric;
+
+   // these are C++ function pointer definitions that exist per-zone, and must remain hidden in the C interface
+   void * m_pFunctionPointersCpp;
+};
+
+inline static void InitializeMetricWrapperUnfailing(MetricWrapper * const pMetricWrapper) {
+   pMetricWrapper->m_pMetric = NULL;
+   pMetricWrapper->m_pFunctionPointersCpp = NULL;
+}
+
+inline static void FreeMetricWrapperInternals(MetricWrapper * const pMetricWrapper) {
+   AlignedFree(pMetricWrapper->m_pMetric);
+   free(pMetricWrapper->m_pFunctionPointersCpp);
+}
+
 struct Config {
    // don't use m_ notation here, mostly to make it cleaner for people writing *Objective classes
+   // cOutputs is the number of scores per task.  Multitask models have cTasks * cOutputs scores in total
    size_t cOutputs;
+   size_t cTasks;
    BoolEbm isDifferentiallyPrivate;
+   // the link function of the objective.  Metrics are created after the objective, so this is Link_ERROR when
+   // creating objectives and the objective's link function when creating metrics
+   LinkEbm link;
 };
 
 INTERNAL_IMPORT_EXPORT_INCLUDE ErrorEbm CreateObjective_Cpu_64(
@@ -105,6 +186,20 @@ INTERNAL_IMPORT_EXPORT_INCLUDE ErrorEbm CreateObjective_Cpu_64(
    ObjectiveWrapper * const pObjectiveWrapperOut
 );
 
+INTERNAL_IMPORT_EXPORT_INCLUDE ErrorEbm CreateObjective_Avx2_64(
+   const Config * const pConfig,
+   const char * const sObjective,
+   const char * const sObjectiveEnd,
+   ObjectiveWrapper * const pObjectiveWrapperOut
+);
+
+INTERNAL_IMPORT_EXPORT_INCLUDE ErrorEbm CreateObjective_Avx512f_64(
+   const Config * const pConfig,
+   const char * const sObjective,
+   const char * const sObjectiveEnd,
+   ObjectiveWrapper * const pObjectiveWrapperOut
+);
+
 INTERNAL_IMPORT_EXPORT_INCLUDE ErrorEbm CreateObjective_Cuda_32(
    const Config * const pConfig,
    const char * const sObjective,
@@ -112,11 +207,45 @@ INTERNAL_IMPORT_EXPORT_INCLUDE ErrorEbm CreateObjective_Cuda_32(
    ObjectiveWrapper * const pObjectiveWrapperOut
 );
 
+// Discretize hands cut arrays up to this length to the SIMD zones, which count the cuts below each sample
+// instead of searching for them
+#define k_cDiscretizeCompareCountCutsMax 14
+
+INTERNAL_IMPORT_EXPORT_INCLUDE void DiscretizeCompareCount_Avx2_64(
+   const size_t cSamples,
+   const double * const aFeatureVals,
+   const size_t cCuts,
+   const double * const aCuts,
+   IntEbm * const aBinIndexesOut
+);
+
+INTERNAL_IMPORT_EXPORT_INCLUDE void DiscretizeCompareCount_Avx512f_64(
+   const size_t cSamples,
+   const double * const aFeatureVals,
+   const size_t cCuts,
+   const double * const aCuts,
+   IntEbm * const aBinIndexesOut
+);
+
 INTERNAL_IMPORT_EXPORT_INCLUDE ErrorEbm CreateMetric_Cpu_64(
    const Config * const pConfig,
    const char * const sMetric,
-   const char * const sMetricEnd
-   //   MetricWrapper * const pMetricWrapperOut,
+   const char * const sMetricEnd,
+   MetricWrapper * const pMetricWrapperOut
+);
+
+INTERNAL_IMPORT_EXPORT_INCLUDE ErrorEbm CreateMetric_Avx2_64(
+   const Config * const pConfig,
+   const char * const sMetric,
+   const char * const sMetricEnd,
+   MetricWrapper * const pMetricWrapperOut
+);
+
+INTERNAL_IMPORT_EXPORT_INCLUDE ErrorEbm CreateMetric_Avx512f_64(
+   const Config * const pConfig,
+   const char * const sMetric,
+   const char * const sMetricEnd,
+   MetricWrapper * const pMetricWrapperOut
 );
 
 #ifdef __cplusplus
@@ -11,6 +11,8 @@ extern "C" {
 
 #if defined(ZONE_cpu)
 #define DEFINED_ZONE_NAME      NAMESPACE_CPU
+#elif defined(ZONE_avx2)
+#define DEFINED_ZONE_NAME      NAMESPACE_AVX2
 #elif defined(ZONE_avx512)
 #define DEFINED_ZONE_NAME      NAMESPACE_AVX512
 #elif defined(ZONE_cuda)
@@ -357,6 +357,55 @@ inline static size_t CountBins(
    return cBytesDiff / cBytesPerBin;
 }
 
+template<bool bHessian>
+inline static void ConvertBins(
+   const size_t cScores,
+   const BinBase * const aFastBins,
+   BinBase * const aBigBins,
+   const size_t cBins
+) {
+   EBM_ASSERT(1 <= cScores);
+
+   const size_t cBytesPerFastBin = GetBinSize<FloatFast>(bHessian, cScores);
+   const size_t cBytesPerBigBin = GetBinSize<FloatBig>(bHessian, cScores);
+
+   const auto * pFastBin = aFastBins->Specialize<FloatFast, bHessian>();
+   auto * pBigBin = aBigBins->Specialize<FloatBig, bHessian>();
+   for(size_t iBin = 0; iBin < cBins; ++iBin) {
+      pBigBin->SetCountSamples(pFastBin->GetCountSamples());
+      pBigBin->SetWeight(static_cast<FloatBig>(pFastBin->GetWeight()));
+
+      const auto * const aFastGradientPairs = pFastBin->GetGradientPairs();
+      auto * const aBigGradientPairs = pBigBin->GetGradientPairs();
+      for(size_t iScore = 0; iScore < cScores; ++iScore) {
+         aBigGradientPairs[iScore].m_sumGradients = static_cast<FloatBig>(aFastGradientPairs[iScore].m_sumGradients);
+         if(bHessian) {
+            aBigGradientPairs[iScore].SetHess(static_cast<FloatBig>(aFastGradientPairs[iScore].GetHess()));
+         }
+      }
+
+      pFastBin = IndexBin(pFastBin, cBytesPerFastBin);
+      pBigBin = IndexBin(pBigBin, cBytesPerBigBin);
+   }
+}
+
+// BinSums accumulates into FloatFast bins and everything after it works on FloatBig bins
+inline static void ConvertFastBinsToBigBins(
+   const bool bHessian,
+   const size_t cScores,
+   const BinBase * const aFastBins,
+   BinBase * const aBigBins,
+   const size_t cBins
+) {
+   if(std::is_same<FloatFast, FloatBig>::value) {
+      memcpy(aBigBins, aFastBins, GetBinSize<FloatFast>(bHessian, cScores) * cBins);
+   } else if(bHessian) {
+      ConvertBins<true>(cScores, aFastBins, aBigBins, cBins);
+   } else {
+      ConvertBins<false>(cScores, aFastBins, aBigBins, cBins);
+   }
+}
+
 
 // keep this as a MACRO so that we don't materialize any of the parameters on non-debug builds
 #define ASSERT_BIN_OK(MACRO_cBytesPerBin, MACRO_pBin, MACRO_pBinsEnd) \
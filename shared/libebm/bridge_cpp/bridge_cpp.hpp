@@ -104,6 +104,23 @@ inline constexpr static T MakeLowMask(const size_t cBits) noexcept {
    return (~T { 0 }) >> (CountBitsRequiredPositiveMax<T>() - cBits);
 }
 
+// The bit packs can be interleaved so that SIMD lanes read consecutive bit packs alongside consecutive samples.
+// With cLanes lanes the first "dregs" samples, which is the remainder after dividing the samples into blocks of
+// cLanes * cItemsPerBitPack, are stored sequentially with the first bit pack partly filled.  After them come the
+// blocks of cLanes bit packs.  Bit pack iLane of a block holds samples iLane, iLane + cLanes, iLane + 2 * cLanes...
+// of that block, and like the sequential layout the earlier samples are in the higher bits.  With 1 lane this is
+// exactly the sequential layout.
+inline constexpr static size_t GetCountBitPackDregs(
+   const size_t cSamples, 
+   const size_t cItemsPerBitPack, 
+   const size_t cLanes
+) noexcept {
+   return cSamples % (cItemsPerBitPack * cLanes);
+}
+inline constexpr static size_t GetCountBitPacksDregs(const size_t cDregs, const size_t cItemsPerBitPack) noexcept {
+   return (cDregs + cItemsPerBitPack - size_t { 1 }) / cItemsPerBitPack;
+}
+
 static constexpr ptrdiff_t k_cItemsPerBitPackNone = ptrdiff_t { -1 }; // this is for when there is only 1 bin
 // TODO : remove the 2 suffixes from these, and verify these are being used!!  AND at the same time verify that we like the sign of anything that uses these constants size_t vs ptrdiff_t
 static constexpr ptrdiff_t k_cItemsPerBitPackDynamic = ptrdiff_t { 0 };
@@ -142,11 +159,19 @@ struct BinSumsBoostingBridge {
    size_t m_cScores;
 
    ptrdiff_t m_cPack;
+   size_t m_cBitPackLanes;
 
    size_t m_cSamples;
    const FloatFast * m_aGradientsAndHessians;
    const FloatFast * m_aWeights;
    const size_t * m_pCountOccurrences;
+   // m_aWeights and m_pCountOccurrences hold this many values per sample.  This is more than 1 when they
+   // point into sample major arrays that interleave the values of all the inner bags
+   size_t m_cInnerBagsStride;
+   // subsampled inner bags mark each selected sample with a bit instead of using m_pCountOccurrences.  The
+   // bit for sample iSample of this call is at index m_iSampleBitFirst + iSample
+   const uint64_t * m_aSampleBits;
+   size_t m_iSampleBitFirst;
    const StorageDataType * m_aPacked;
 
    BinBase * m_aFastBins;
@@ -168,6 +193,7 @@ struct BinSumsInteractionBridge {
    size_t m_cRuntimeRealDimensions;
    size_t m_acBins[k_cDimensionsMax];
    size_t m_acItemsPerBitPack[k_cDimensionsMax];
+   size_t m_cBitPackLanes;
    const StorageDataType * m_aaPacked[k_cDimensionsMax];
 
    BinBase * m_aFastBins;
@@ -178,6 +204,32 @@ struct BinSumsInteractionBridge {
 #endif // NDEBUG
 };
 
+// the number of pairs that one pass over the gradients can bin at once when the pairs share a feature
+static constexpr size_t k_cPairsPerBinSumsPassMax = 16;
+
+struct BinSumsInteractionPairsBridge {
+   BoolEbm m_bHessian;
+   size_t m_cScores;
+
+   size_t m_cSamples;
+   const FloatFast * m_aGradientsAndHessians;
+   const FloatFast * m_aWeights;
+
+   // index 0 is the feature that all the pairs share, and index 1 + iPair is the other feature of each pair.
+   // The shared feature is the first dimension of every pair's tensor
+   size_t m_cPairs;
+   size_t m_acBins[1 + k_cPairsPerBinSumsPassMax];
+   size_t m_acItemsPerBitPack[1 + k_cPairsPerBinSumsPassMax];
+   size_t m_cBitPackLanes;
+   const StorageDataType * m_aaPacked[1 + k_cPairsPerBinSumsPassMax];
+
+   BinBase * m_aaFastBins[k_cPairsPerBinSumsPassMax];
+
+#ifndef NDEBUG
+   const BinBase * m_apDebugFastBinsEnd[k_cPairsPerBinSumsPassMax];
+#endif // NDEBUG
+};
+
 } // DEFINED_ZONE_NAME
 
 #endif // BRIDGE_CPP_HPP
\ No newline at end of file
@@ -34,6 +34,7 @@ extern "C" {
 #define WARNING_DISABLE_USING_UNINITIALIZED_MEMORY
 #define WARNING_BUFFER_OVERRUN
 #define WARNING_REDUNDANT_CODE
+#define WARNING_DISABLE_DEPRECATED_FUNCTION
 #define ATTRIBUTE_WARNING_DISABLE_UNINITIALIZED_MEMBER
 
 #if __has_feature(attribute_analyzer_noreturn)
@@ -52,6 +53,7 @@ extern "C" {
 #define WARNING_DISABLE_USING_UNINITIALIZED_MEMORY
 #define WARNING_BUFFER_OVERRUN
 #define WARNING_REDUNDANT_CODE
+#define WARNING_DISABLE_DEPRECATED_FUNCTION
 #define ATTRIBUTE_WARNING_DISABLE_UNINITIALIZED_MEMBER
 
 #define ANALYZER_NORETURN
@@ -72,6 +74,7 @@ extern "C" {
 #define WARNING_DISABLE_USING_UNINITIALIZED_MEMORY
 #define WARNING_BUFFER_OVERRUN
 #define WARNING_REDUNDANT_CODE
+#define WARNING_DISABLE_DEPRECATED_FUNCTION
 #define ATTRIBUTE_WARNING_DISABLE_UNINITIALIZED_MEMBER
 
 #define ANALYZER_NORETURN
@@ -86,6 +89,7 @@ extern "C" {
 #define WARNING_DISABLE_USING_UNINITIALIZED_MEMORY __pragma(warning(disable: 6001))
 #define WARNING_BUFFER_OVERRUN __pragma(warning(disable: 6386))
 #define WARNING_REDUNDANT_CODE __pragma(warning(disable: 6287))
+#define WARNING_DISABLE_DEPRECATED_FUNCTION __pragma(warning(disable: 4996))
 #define ATTRIBUTE_WARNING_DISABLE_UNINITIALIZED_MEMBER [[gsl::suppress(type.6)]]
 
 #define ANALYZER_NORETURN
@@ -165,8 +169,18 @@ INLINE_ALWAYS static char * strcpy_NO_WARNINGS(char * const dest, const char * c
 #define FAST_LOG
 
 typedef double FloatBig;
-// TODO: someday flip FloatFast to float32
+// FloatFast is the type of the per-sample arrays (gradients, hessians, targets, weights) and of the bins that
+// BinSums fills directly from them.  Those arrays are streamed once per boosting step, so building with
+// FLOAT_FAST_32 halves the memory bandwidth of BinSums and the RAM needed per sample.  The SIMD zones keep
+// computing in double and convert on load and store.  FloatBig bins stay double.
+#ifdef FLOAT_FAST_32
+typedef float FloatFast;
+#else // FLOAT_FAST_32
 typedef double FloatFast;
+#endif // FLOAT_FAST_32
+// FloatScore is the type of the sample scores and the term tensors.  They accumulate many small updates over the
+// boosting rounds, which float32 would round away, so they stay double even when FloatFast is float.
+typedef double FloatScore;
 
 static const char k_registrationSeparator = ',';
 
@@ -0,0 +1,110 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "precompiled_header_cpp.hpp"
+
+#include <stddef.h> // size_t, ptrdiff_t
+#include <memory> // shared_ptr, unique_ptr
+#include <vector>
+
+#include "zoned_bridge_c_functions.h"
+#include "registration_exceptions.hpp"
+#include "Registration.hpp"
+#include "Metric.hpp"
+
+namespace DEFINED_ZONE_NAME {
+#ifndef DEFINED_ZONE_NAME
+#error DEFINED_ZONE_NAME must be defined
+#endif // DEFINED_ZONE_NAME
+
+ErrorEbm Metric::CreateMetric(
+   const REGISTER_METRICS_FUNCTION registerMetricsFunction,
+   const Config * const pConfig,
+   const char * const sMetric,
+   const char * const sMetricEnd,
+   MetricWrapper * const pMetricWrapperOut
+) noexcept {
+   EBM_ASSERT(nullptr != registerMetricsFunction);
+   EBM_ASSERT(nullptr != pConfig);
+   EBM_ASSERT(1 <= pConfig->cOutputs);
+   EBM_ASSERT(1 <= pConfig->cTasks);
+   EBM_ASSERT(EBM_FALSE == pConfig->isDifferentiallyPrivate || EBM_TRUE == pConfig->isDifferentiallyPrivate);
+   EBM_ASSERT(nullptr != sMetric);
+   EBM_ASSERT(nullptr != sMetricEnd);
+   EBM_ASSERT(sMetric < sMetricEnd); // empty string not allowed
+   EBM_ASSERT('\0' != *sMetric);
+   EBM_ASSERT(!(0x20 == *sMetric || (0x9 <= *sMetric && *sMetric <= 0xd)));
+   EBM_ASSERT('\0' == *sMetricEnd || k_registrationSeparator == *sMetricEnd);
+   EBM_ASSERT(nullptr != pMetricWrapperOut);
+   EBM_ASSERT(nullptr == pMetricWrapperOut->m_pMetric);
+   EBM_ASSERT(nullptr == pMetricWrapperOut->m_pFunctionPointersCpp);
+
+   LOG_0(Trace_Info, "Entered Metric::CreateMetric");
+
+   void * const pFunctionPointersCpp = malloc(sizeof(MetricFunctionPointersCpp));
+   ErrorEbm error = Error_OutOfMemory;
+   if(nullptr != pFunctionPointersCpp) {
+      pMetricWrapperOut->m_pFunctionPointersCpp = pFunctionPointersCpp;
+      try {
+         const std::vector<std::shared_ptr<const Registration>> registrations = (*registerMetricsFunction)();
+         const bool bFailed = Registration::CreateRegistrable(pConfig, sMetric, sMetricEnd, pMetricWrapperOut, registrations);
+         if(!bFailed) {
+            EBM_ASSERT(nullptr != pMetricWrapperOut->m_pMetric);
+            pMetricWrapperOut->m_pCalcMetricC = MAKE_ZONED_C_FUNCTION_NAME(CalcMetric);
+
+            LOG_0(Trace_Info, "Exited Metric::CreateMetric");
+            return Error_None;
+         }
+         EBM_ASSERT(nullptr == pMetricWrapperOut->m_pMetric);
+         LOG_0(Trace_Info, "Exited Metric::CreateMetric unknown metric");
+         error = Error_MetricUnknown;
+      } catch(const ParamValMalformedException &) {
+         EBM_ASSERT(nullptr == pMetricWrapperOut->m_pMetric);
+         LOG_0(Trace_Warning, "WARNING Metric::CreateMetric ParamValMalformedException");
+         error = Error_MetricParamValMalformed;
+      } catch(const ParamUnknownException &) {
+         EBM_ASSERT(nullptr == pMetricWrapperOut->m_pMetric);
+         LOG_0(Trace_Warning, "WARNING Metric::CreateMetric ParamUnknownException");
+         error = Error_MetricParamUnknown;
+      } catch(const RegistrationConstructorException &) {
+         EBM_ASSERT(nullptr == pMetricWrapperOut->m_pMetric);
+         LOG_0(Trace_Warning, "WARNING Metric::CreateMetric RegistrationConstructorException");
+         error = Error_MetricConstructorException;
+      } catch(const ParamValOutOfRangeException &) {
+         EBM_ASSERT(nullptr == pMetricWrapperOut->m_pMetric);
+         LOG_0(Trace_Warning, "WARNING Metric::CreateMetric ParamValOutOfRangeException");
+         error = Error_MetricParamValOutOfRange;
+      } catch(const ParamMismatchWithConfigException &) {
+         EBM_ASSERT(nullptr == pMetricWrapperOut->m_pMetric);
+         LOG_0(Trace_Warning, "WARNING Metric::CreateMetric ParamMismatchWithConfigException");
+         error = Error_MetricParamMismatchWithConfig;
+      } catch(const IllegalRegistrationNameException &) {
+         EBM_ASSERT(nullptr == pMetricWrapperOut->m_pMetric);
+         LOG_0(Trace_Warning, "WARNING Metric::CreateMetric IllegalRegistrationNameException");
+         error = Error_MetricIllegalRegistrationName;
+      } catch(const IllegalParamNameException &) {
+         EBM_ASSERT(nullptr == pMetricWrapperOut->m_pMetric);
+         LOG_0(Trace_Warning, "WARNING Metric::CreateMetric IllegalParamNameException");
+         error = Error_MetricIllegalParamName;
+      } catch(const DuplicateParamNameException &) {
+         EBM_ASSERT(nullptr == pMetricWrapperOut->m_pMetric);
+         LOG_0(Trace_Warning, "WARNING Metric::CreateMetric DuplicateParamNameException");
+         error = Error_MetricDuplicateParamName;
+      } catch(const std::bad_alloc &) {
+         LOG_0(Trace_Warning, "WARNING Metric::CreateMetric Out of Memory");
+         error = Error_OutOfMemory;
+      } catch(...) {
+         LOG_0(Trace_Warning, "WARNING Metric::CreateMetric internal error, unknown exception");
+         error = Error_UnexpectedInternal;
+      }
+      AlignedFree(pMetricWrapperOut->m_pMetric); // this is legal if pMetricWrapper->m_pMetric is nullptr
+      pMetricWrapperOut->m_pMetric = nullptr;
+
+      free(pMetricWrapperOut->m_pFunctionPointersCpp); // this is legal if pMetricWrapper->m_pFunctionPointersCpp is nullptr
+      pMetricWrapperOut->m_pFunctionPointersCpp = nullptr;
+   }
+   return error;
+}
+
+} // DEFINED_ZONE_NAME
@@ -0,0 +1,269 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+// !!! NOTE: To add a new metric in C++, follow the steps listed at the top of the "metric_registrations.hpp" file !!!
+
+#ifndef METRIC_HPP
+#define METRIC_HPP
+
+#include <stdlib.h> // malloc, free
+#include <stddef.h> // size_t, ptrdiff_t
+#include <cmath> // std::sqrt, std::isnan
+#include <algorithm> // std::sort
+#include <memory> // shared_ptr, unique_ptr
+#include <type_traits> // std::conditional, std::is_same
+
+#include "libebm.h" // ErrorEbm
+#include "logging.h" // EBM_ASSERT
+#include "common_c.h" // INLINE_ALWAYS
+#include "bridge_c.h" // MetricBridge
+#include "zones.h"
+
+#include "bridge_cpp.hpp" // StorageDataType
+#include "zoned_bridge_cpp_functions.hpp" // MetricFunctionPointersCpp
+#include "compute.hpp" // GPU_DEVICE
+#include "Registrable.hpp"
+
+namespace DEFINED_ZONE_NAME {
+#ifndef DEFINED_ZONE_NAME
+#error DEFINED_ZONE_NAME must be defined
+#endif // DEFINED_ZONE_NAME
+
+class Registration;
+typedef const std::vector<std::shared_ptr<const Registration>> (* REGISTER_METRICS_FUNCTION)();
+
+struct BinaryMetric;
+struct MulticlassMetric;
+struct RegressionMetric;
+
+struct Metric : public Registrable {
+private:
+
+   template<typename TMetric>
+   constexpr static bool IsEdgeMetric() {
+      return
+         std::is_base_of<BinaryMetric, TMetric>::value ||
+         std::is_base_of<MulticlassMetric, TMetric>::value ||
+         std::is_base_of<RegressionMetric, TMetric>::value;
+   }
+
+   template<typename TFloat, typename TTarget, typename std::enable_if<std::is_same<TTarget, FloatFast>::value, void>::type * = nullptr>
+   GPU_DEVICE INLINE_ALWAYS static TFloat LoadTargets(const TTarget * const aTargets) noexcept {
+      TFloat target;
+      target.LoadUnaligned(aTargets);
+      return target;
+   }
+
+   template<typename TFloat, typename TTarget, typename std::enable_if<!std::is_same<TTarget, FloatFast>::value, void>::type * = nullptr>
+   GPU_DEVICE INLINE_ALWAYS static TFloat LoadTargets(const TTarget * const aTargets) noexcept {
+      // classification targets are stored as integers, so convert them through an aligned temporary
+      alignas(alignof(TFloat)) typename TFloat::T targets[TFloat::cPack];
+      for(int i = 0; i < TFloat::cPack; ++i) {
+         targets[i] = static_cast<typename TFloat::T>(aTargets[i]);
+      }
+      TFloat target;
+      target.LoadAligned(targets);
+      return target;
+   }
+
+protected:
+
+   // Metrics that are a weighted sum over the samples implement CalcMetric(score, target) and
+   // FinishMetric(metricSum, totalWeight), and this function does the summing.  Full packs are loaded straight
+   // from the sample arrays.  The final partial pack is staged through temporaries that are padded with copies of
+   // the first real sample in that pack, and the results in the padding lanes are masked out of the sum.
+   template<typename TMetric, typename TFloat, bool bResidual, bool bWeight>
+   GPU_DEVICE void ChildCalcMetric(MetricBridge * const pData) const {
+      const TMetric * const pMetric = static_cast<const TMetric *>(this);
+
+      static constexpr bool bClassification = OutputType_GeneralClassification == TMetric::k_outputType;
+      static constexpr size_t cSIMDPack = static_cast<size_t>(TFloat::cPack);
+
+      static_assert(!bResidual || !bClassification, "only regression keeps residuals instead of scores");
+
+      // classification targets are stored as integers, regression targets as floats
+      typedef typename std::conditional<bClassification, StorageDataType, FloatFast>::type TTarget;
+      // residuals are the gradients, which are FloatFast, while the sample scores are kept as FloatScore
+      typedef typename std::conditional<bResidual, FloatFast, FloatScore>::type TScore;
+
+      const size_t cSamples = pData->m_cSamples;
+      EBM_ASSERT(1 <= cSamples);
+
+      const TScore * const aScores =
+         reinterpret_cast<const TScore *>(bResidual ? pData->m_aResiduals : pData->m_aSampleScores);
+      const TTarget * const aTargets = reinterpret_cast<const TTarget *>(pData->m_aTargets);
+      const FloatFast * const aWeights = reinterpret_cast<const FloatFast *>(pData->m_aWeights);
+
+      TFloat metricSum = 0.0;
+      size_t iSample = 0;
+      while(iSample + cSIMDPack <= cSamples) {
+         TFloat score;
+         score.LoadUnaligned(&aScores[iSample]);
+
+         const TFloat target = LoadTargets<TFloat>(&aTargets[iSample]);
+         if(bResidual) {
+            score += target;
+         }
+
+         TFloat metric = pMetric->CalcMetric(score, target);
+         if(bWeight) {
+            TFloat weight;
+            weight.LoadUnaligned(&aWeights[iSample]);
+            metric *= weight;
+         }
+         metricSum += metric;
+
+         iSample += cSIMDPack;
+      }
+
+      if(iSample != cSamples) {
+         const size_t cLanes = cSamples - iSample;
+
+         alignas(alignof(TFloat)) typename TFloat::T scores[cSIMDPack];
+         alignas(alignof(TFloat)) typename TFloat::T targets[cSIMDPack];
+         alignas(alignof(TFloat)) typename TFloat::T weights[cSIMDPack];
+         alignas(alignof(TFloat)) typename TFloat::T laneMasks[cSIMDPack];
+         for(size_t i = 0; i < cSIMDPack; ++i) {
+            const size_t iLane = iSample + (i < cLanes ? i : size_t { 0 });
+            scores[i] = static_cast<typename TFloat::T>(aScores[iLane]);
+            targets[i] = static_cast<typename TFloat::T>(aTargets[iLane]);
+            if(bWeight) {
+               weights[i] = static_cast<typename TFloat::T>(aWeights[iLane]);
+            }
+            laneMasks[i] = i < cLanes ? typename TFloat::T { 1 } : typename TFloat::T { 0 };
+         }
+
+         TFloat score;
+         score.LoadAligned(scores);
+         TFloat target;
+         target.LoadAligned(targets);
+         if(bResidual) {
+            score += target;
+         }
+
+         TFloat metric = pMetric->CalcMetric(score, target);
+         if(bWeight) {
+            TFloat weight;
+            weight.LoadAligned(weights);
+            metric *= weight;
+         }
+
+         TFloat laneMask;
+         laneMask.LoadAligned(laneMasks);
+         metricSum += IfGreater(laneMask, 0.0, metric, 0.0);
+      }
+
+      pData->m_metricOut = pMetric->FinishMetric(static_cast<double>(Sum(metricSum)), pData->m_totalWeight);
+   }
+
+   template<typename TMetric, typename TFloat, bool bResidual>
+   INLINE_RELEASE_TEMPLATED ErrorEbm WeightCalcMetric(MetricBridge * const pData) const {
+      if(nullptr != pData->m_aWeights) {
+         ChildCalcMetric<TMetric, TFloat, bResidual, true>(pData);
+      } else {
+         ChildCalcMetric<TMetric, TFloat, bResidual, false>(pData);
+      }
+      return Error_None;
+   }
+
+   template<typename TMetric, typename TFloat, typename std::enable_if<TMetric::k_outputType == OutputType_Regression, void>::type * = nullptr>
+   INLINE_RELEASE_TEMPLATED ErrorEbm TypeCalcMetric(MetricBridge * const pData) const {
+      if(nullptr != pData->m_aResiduals) {
+         EBM_ASSERT(nullptr == pData->m_aSampleScores);
+         return WeightCalcMetric<TMetric, TFloat, true>(pData);
+      } else {
+         EBM_ASSERT(nullptr != pData->m_aSampleScores);
+         return WeightCalcMetric<TMetric, TFloat, false>(pData);
+      }
+   }
+   template<typename TMetric, typename TFloat, typename std::enable_if<TMetric::k_outputType != OutputType_Regression, void>::type * = nullptr>
+   INLINE_RELEASE_TEMPLATED ErrorEbm TypeCalcMetric(MetricBridge * const pData) const {
+      EBM_ASSERT(nullptr == pData->m_aResiduals);
+      EBM_ASSERT(nullptr != pData->m_aSampleScores);
+      return WeightCalcMetric<TMetric, TFloat, false>(pData);
+   }
+
+   template<typename TMetric, typename TFloat>
+   INLINE_RELEASE_TEMPLATED ErrorEbm ParentCalcMetric(MetricBridge * const pData) const {
+      static_assert(IsEdgeMetric<TMetric>(), "TMetric must inherit from one of the children of the Metric class");
+      EBM_ASSERT(nullptr != pData);
+      EBM_ASSERT(1 <= pData->m_cSamples);
+      EBM_ASSERT(nullptr != pData->m_aTargets);
+      return TypeCalcMetric<TMetric, TFloat>(pData);
+   }
+
+   template<typename TMetric, typename TFloat>
+   INLINE_RELEASE_TEMPLATED void FillMetricWrapper(void * const pWrapperOut) noexcept {
+      EBM_ASSERT(nullptr != pWrapperOut);
+      MetricWrapper * const pMetricWrapperOut = static_cast<MetricWrapper *>(pWrapperOut);
+      MetricFunctionPointersCpp * const pFunctionPointers =
+         static_cast<MetricFunctionPointersCpp *>(pMetricWrapperOut->m_pFunctionPointersCpp);
+      EBM_ASSERT(nullptr != pFunctionPointers);
+
+      pFunctionPointers->m_pCalcMetricCpp = &TMetric::StaticCalcMetric;
+
+      const auto bMaximizeMetric = TMetric::k_bMaximizeMetric;
+      static_assert(std::is_same<decltype(bMaximizeMetric), const BoolEbm>::value, "TMetric::k_bMaximizeMetric should be a BoolEbm");
+      pMetricWrapperOut->m_bMaximizeMetric = bMaximizeMetric;
+
+      pMetricWrapperOut->m_pMetric = this;
+   }
+
+   Metric() = default;
+   ~Metric() = default;
+
+public:
+
+   static ErrorEbm CreateMetric(
+      const REGISTER_METRICS_FUNCTION registerMetricsFunction,
+      const Config * const pConfig,
+      const char * const sMetric,
+      const char * const sMetricEnd,
+      MetricWrapper * const pMetricWrapperOut
+   ) noexcept;
+};
+static_assert(std::is_standard_layout<Metric>::value && std::is_trivially_copyable<Metric>::value,
+   "This allows offsetof, memcpy, memset, inter-language, GPU and cross-machine use where needed");
+
+struct BinaryMetric : public Metric {
+protected:
+   BinaryMetric() = default;
+   ~BinaryMetric() = default;
+public:
+   static constexpr OutputType k_outputType = OutputType_GeneralClassification;
+};
+
+struct MulticlassMetric : public Metric {
+protected:
+   MulticlassMetric() = default;
+   ~MulticlassMetric() = default;
+public:
+   static constexpr OutputType k_outputType = OutputType_GeneralClassification;
+};
+
+struct RegressionMetric : public Metric {
+protected:
+   RegressionMetric() = default;
+   ~RegressionMetric() = default;
+public:
+   static constexpr OutputType k_outputType = OutputType_Regression;
+};
+
+
+#define METRIC_BOILERPLATE(__EBM_TYPE, __MAXIMIZE_METRIC) \
+   public: \
+      static constexpr BoolEbm k_bMaximizeMetric = (__MAXIMIZE_METRIC); \
+      static ErrorEbm StaticCalcMetric(const Metric * const pThis, MetricBridge * const pData) { \
+         return (static_cast<const __EBM_TYPE<TFloat> *>(pThis))->template ParentCalcMetric<const __EBM_TYPE<TFloat>, TFloat>(pData); \
+      } \
+      void FillWrapper(void * const pWrapperOut) noexcept { \
+         static_assert( \
+            std::is_same<__EBM_TYPE<TFloat>, typename std::remove_pointer<decltype(this)>::type>::value, \
+            "*Metric types mismatch"); \
+         FillMetricWrapper<typename std::remove_pointer<decltype(this)>::type, TFloat>(pWrapperOut); \
+      }
+
+} // DEFINED_ZONE_NAME
+
+#endif // METRIC_HPP
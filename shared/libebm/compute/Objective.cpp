@@ -28,6 +28,7 @@ ErrorEbm Objective::CreateObjective(
    EBM_ASSERT(nullptr != registerObjectivesFunction);
    EBM_ASSERT(nullptr != pConfig);
    EBM_ASSERT(1 <= pConfig->cOutputs);
+   EBM_ASSERT(1 <= pConfig->cTasks);
    EBM_ASSERT(EBM_FALSE == pConfig->isDifferentiallyPrivate || EBM_TRUE == pConfig->isDifferentiallyPrivate);
    EBM_ASSERT(nullptr != sObjective);
    EBM_ASSERT(nullptr != sObjectiveEnd);
@@ -112,7 +113,7 @@ ErrorEbm Objective::CreateObjective(
          LOG_0(Trace_Warning, "WARNING Objective::CreateObjective internal error, unknown exception");
          error = Error_UnexpectedInternal;
       }
-      free(pObjectiveWrapperOut->m_pObjective); // this is legal if pObjectiveWrapper->m_pObjective is nullptr
+      AlignedFree(pObjectiveWrapperOut->m_pObjective); // this is legal if pObjectiveWrapper->m_pObjective is nullptr
       pObjectiveWrapperOut->m_pObjective = nullptr;
 
       free(pObjectiveWrapperOut->m_pFunctionPointersCpp); // this is legal if pObjectiveWrapper->m_pFunctionPointersCpp is nullptr
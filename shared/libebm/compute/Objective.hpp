@@ -18,6 +18,7 @@
 #include "bridge_cpp.hpp" // IsRegressionOutput, etc.
 #include "zoned_bridge_cpp_functions.hpp" // FunctionPointersCpp
 #include "compute.hpp" // GPU_GLOBAL
+#include "Registrable.hpp"
 
 struct ApplyUpdateBridge;
 
@@ -73,6 +74,227 @@ GPU_DEVICE inline GradientHessian<TFloat> MakeGradientHessian(const double gradi
 }
 
 
+template<typename TFloat, typename TEnable = void>
+struct SimdBitPackReader final {
+   // Walks the bit packs one sample at a time and loads the update scores of cPack consecutive samples through a
+   // temporary.  Used by zones without 64 bit gathers.  The bit packs are interleaved across cPack lanes after the
+   // dregs (see GetCountBitPackDregs), and the dregs are stored sequentially.
+
+   static constexpr size_t k_cSIMDPack = static_cast<size_t>(TFloat::cPack);
+
+   inline void Init(const StorageDataType * const aPacked, const size_t cSamples, const size_t cItemsPerBitPack) noexcept {
+      const size_t cDregs = GetCountBitPackDregs(cSamples, cItemsPerBitPack, k_cSIMDPack);
+      const size_t cSamplesFirst = size_t { 0 } == cDregs ? cSamples : cDregs;
+
+      m_cBitsPerItemMax = GetCountBits<StorageDataType>(cItemsPerBitPack);
+      m_cShift = static_cast<ptrdiff_t>(((cSamplesFirst - 1) % cItemsPerBitPack + 1) * m_cBitsPerItemMax);
+      m_cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - 1) * m_cBitsPerItemMax);
+      m_maskBits = static_cast<size_t>(MakeLowMask<StorageDataType>(m_cBitsPerItemMax));
+
+      m_pInputData = aPacked;
+      m_pDregsEnd = aPacked + GetCountBitPacksDregs(cDregs, cItemsPerBitPack);
+      m_cLanesCur = size_t { 0 } == cDregs ? k_cSIMDPack : size_t { 1 };
+      // the first call to NextBin moves onto the first lane and the first shift
+      m_iLane = m_cLanesCur - size_t { 1 };
+   }
+
+   GPU_DEVICE INLINE_ALWAYS size_t CountLanes(const size_t cLanes) const noexcept {
+      // we unpack one sample at a time, so a pack can straddle the dregs and the interleaved blocks
+      return cLanes;
+   }
+
+   GPU_DEVICE INLINE_ALWAYS size_t NextBin() noexcept {
+      ++m_iLane;
+      if(m_cLanesCur == m_iLane) {
+         m_iLane = 0;
+         m_cShift -= m_cBitsPerItemMax;
+         if(m_cShift < ptrdiff_t { 0 }) {
+            m_pInputData += m_cLanesCur;
+            if(m_pDregsEnd == m_pInputData) {
+               m_cLanesCur = k_cSIMDPack;
+            }
+            m_cShift = m_cShiftReset;
+         }
+      }
+      // we store the already multiplied dimensional value in the bit packs
+      return static_cast<size_t>(m_pInputData[m_iLane] >> m_cShift) & m_maskBits;
+   }
+
+   GPU_DEVICE INLINE_ALWAYS void NextBins(size_t * const aiTensorBins, const size_t cLanes) noexcept {
+      EBM_ASSERT(1 <= cLanes);
+      EBM_ASSERT(cLanes <= k_cSIMDPack);
+      // the first lane is always filled, which lets the compiler see that aiTensorBins[0] is initialized
+      aiTensorBins[0] = NextBin();
+      for(size_t i = 1; i < cLanes; ++i) {
+         aiTensorBins[i] = NextBin();
+      }
+   }
+
+   GPU_DEVICE INLINE_ALWAYS TFloat Next(const FloatScore * const aUpdateTensorScores, const size_t cLanes) noexcept {
+      EBM_ASSERT(1 <= cLanes);
+      EBM_ASSERT(cLanes <= k_cSIMDPack);
+      alignas(alignof(TFloat)) typename TFloat::T updateScores[k_cSIMDPack];
+      updateScores[0] = static_cast<typename TFloat::T>(aUpdateTensorScores[NextBin()]);
+      for(size_t i = 1; i < k_cSIMDPack; ++i) {
+         // padding lanes duplicate the first lane and their results are discarded by the caller
+         updateScores[i] = i < cLanes ? static_cast<typename TFloat::T>(aUpdateTensorScores[NextBin()]) : updateScores[0];
+      }
+      TFloat updateScore;
+      updateScore.LoadAligned(updateScores);
+      return updateScore;
+   }
+
+private:
+   size_t m_cBitsPerItemMax;
+   ptrdiff_t m_cShift;
+   ptrdiff_t m_cShiftReset;
+   size_t m_maskBits;
+   const StorageDataType * m_pInputData;
+   const StorageDataType * m_pDregsEnd;
+   size_t m_iLane;
+   size_t m_cLanesCur;
+};
+
+template<typename TFloat>
+struct SimdBitPackReader<TFloat, typename std::enable_if<TFloat::bGather>::type> final {
+   // After the dregs the bit packs are interleaved across our lanes (see GetCountBitPackDregs), so each pack of
+   // samples is one unaligned load of cPack consecutive bit packs, a shift and mask that is the same for every
+   // lane, and a gather of the update scores.  The update tensor is small enough to stay in L1 while we stream
+   // through the samples.
+   //
+   // The dregs are stored sequentially.  For them each lane tracks the index of the bit pack that holds its sample
+   // and the shift within it, and the bit packs are fetched with a gather.
+
+   typedef typename TFloat::TInt TInt;
+   typedef typename TInt::T TIntT;
+   static_assert(sizeof(TIntT) == sizeof(StorageDataType), "the bit packs are loaded as TInt lanes");
+
+   static constexpr size_t k_cSIMDPack = static_cast<size_t>(TFloat::cPack);
+
+   inline void Init(const StorageDataType * const aPacked, const size_t cSamples, const size_t cItemsPerBitPack) noexcept {
+      const size_t cBitsPerItemMax = GetCountBits<StorageDataType>(cItemsPerBitPack);
+
+      const size_t cDregs = GetCountBitPackDregs(cSamples, cItemsPerBitPack, k_cSIMDPack);
+      m_cDregsRemaining = cDregs;
+
+      m_aPacked = reinterpret_cast<const TIntT *>(aPacked);
+      m_pBlock = m_aPacked + GetCountBitPacksDregs(cDregs, cItemsPerBitPack);
+      m_maskBits = static_cast<TIntT>(MakeLowMask<StorageDataType>(cBitsPerItemMax));
+
+      m_cBitsPerItemMax = static_cast<ptrdiff_t>(cBitsPerItemMax);
+      m_cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - 1) * cBitsPerItemMax);
+      m_cShift = m_cShiftReset;
+
+      if(size_t { 0 } != cDregs) {
+         // the first bit pack of the dregs is only partly filled, and within each bit pack the earlier samples are 
+         // in the higher bits
+         alignas(alignof(TFloat)) TIntT aWords[k_cSIMDPack];
+         alignas(alignof(TFloat)) TIntT aShifts[k_cSIMDPack];
+         const size_t iFirstOffset = cItemsPerBitPack - 1 - (cDregs - 1) % cItemsPerBitPack;
+         for(size_t i = 0; i < k_cSIMDPack; ++i) {
+            const size_t iOffset = iFirstOffset + i;
+            aWords[i] = static_cast<TIntT>(iOffset / cItemsPerBitPack);
+            aShifts[i] = static_cast<TIntT>((cItemsPerBitPack - 1 - iOffset % cItemsPerBitPack) * cBitsPerItemMax);
+         }
+         m_iWord.LoadAligned(aWords);
+         m_shift.LoadAligned(aShifts);
+
+         // each pack of samples moves every lane forward by cPack items.  A lane whose shift would drop below
+         // zero moves into the next bit pack and its shift wraps around to the top
+         m_wordStep = static_cast<TIntT>(k_cSIMDPack / cItemsPerBitPack);
+         m_shiftStep = static_cast<TIntT>(k_cSIMDPack % cItemsPerBitPack * cBitsPerItemMax);
+         m_shiftWrap = static_cast<TIntT>(cItemsPerBitPack * cBitsPerItemMax);
+      } else {
+         // without dregs the per-lane positions are never used
+         m_iWord = TInt(0);
+         m_shift = TInt(0);
+         m_wordStep = TInt(0);
+         m_shiftStep = TInt(0);
+         m_shiftWrap = TInt(0);
+      }
+   }
+
+   GPU_DEVICE INLINE_ALWAYS size_t CountLanes(const size_t cLanes) const noexcept {
+      // a pack cannot straddle the dregs and the interleaved blocks since they are read differently
+      return size_t { 0 } != m_cDregsRemaining && m_cDregsRemaining < cLanes ? m_cDregsRemaining : cLanes;
+   }
+
+   GPU_DEVICE INLINE_ALWAYS void NextBins(size_t * const aiTensorBins, const size_t cLanes) noexcept {
+      alignas(alignof(TFloat)) TIntT aBins[k_cSIMDPack];
+      NextTensorBins(cLanes).SaveAligned(aBins);
+      aiTensorBins[0] = static_cast<size_t>(aBins[0]);
+      for(size_t i = 1; i < cLanes; ++i) {
+         aiTensorBins[i] = static_cast<size_t>(aBins[i]);
+      }
+   }
+
+   GPU_DEVICE INLINE_ALWAYS TFloat Next(const FloatScore * const aUpdateTensorScores, const size_t cLanes) noexcept {
+      TFloat updateScore;
+      updateScore.LoadIndexed(aUpdateTensorScores, NextTensorBins(cLanes));
+      return updateScore;
+   }
+
+private:
+
+   GPU_DEVICE INLINE_ALWAYS TInt NextTensorBins(const size_t cLanes) noexcept {
+      // we store the already multiplied dimensional value in the bit packs
+      if(size_t { 0 } == m_cDregsRemaining) {
+         EBM_ASSERT(k_cSIMDPack == cLanes);
+
+         TInt iTensorBinCombined;
+         iTensorBinCombined.LoadUnaligned(m_pBlock);
+         const TInt iTensorBin = (iTensorBinCombined >> TInt(static_cast<TIntT>(m_cShift))) & m_maskBits;
+
+         m_cShift -= m_cBitsPerItemMax;
+         if(m_cShift < ptrdiff_t { 0 }) {
+            m_cShift = m_cShiftReset;
+            m_pBlock += k_cSIMDPack;
+         }
+         return iTensorBin;
+      }
+
+      EBM_ASSERT(cLanes <= m_cDregsRemaining);
+      m_cDregsRemaining -= cLanes;
+
+      if(k_cSIMDPack != cLanes) {
+         // padding lanes duplicate the first lane so that we do not gather past the end of the dregs.  This is
+         // the last pack of the dregs, so we do not need to keep the positions of the lanes afterwards
+         alignas(alignof(TFloat)) TIntT aWords[k_cSIMDPack];
+         alignas(alignof(TFloat)) TIntT aShifts[k_cSIMDPack];
+         m_iWord.SaveAligned(aWords);
+         m_shift.SaveAligned(aShifts);
+         for(size_t i = cLanes; i < k_cSIMDPack; ++i) {
+            aWords[i] = aWords[0];
+            aShifts[i] = aShifts[0];
+         }
+         m_iWord.LoadAligned(aWords);
+         m_shift.LoadAligned(aShifts);
+      }
+
+      TInt iTensorBinCombined;
+      iTensorBinCombined.LoadIndexed(m_aPacked, m_iWord);
+      const TInt iTensorBin = (iTensorBinCombined >> m_shift) & m_maskBits;
+
+      m_iWord = m_iWord + m_wordStep + IfLess(m_shift, m_shiftStep, TInt(1), TInt(0));
+      m_shift = m_shift - m_shiftStep + IfLess(m_shift, m_shiftStep, m_shiftWrap, TInt(0));
+
+      return iTensorBin;
+   }
+
+   const TIntT * m_aPacked;
+   const TIntT * m_pBlock;
+   size_t m_cDregsRemaining;
+   ptrdiff_t m_cShift;
+   ptrdiff_t m_cShiftReset;
+   ptrdiff_t m_cBitsPerItemMax;
+   TInt m_maskBits;
+   TInt m_iWord;
+   TInt m_shift;
+   TInt m_wordStep;
+   TInt m_shiftStep;
+   TInt m_shiftWrap;
+};
+
 template<typename TObjective, size_t cCompilerScores, ptrdiff_t cCompilerPack, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight>
 GPU_GLOBAL static void RemoteApplyUpdate(const Objective * const pObjective, ApplyUpdateBridge * const pData) {
    const TObjective * const pObjectiveSpecific = static_cast<const TObjective *>(pObjective);
@@ -80,13 +302,6 @@ GPU_GLOBAL static void RemoteApplyUpdate(const Objective * const pObjective, App
 }
 
 
-struct Registrable {
-   // TODO: move this into its own file once we create Metric classes that are also Registrable
-protected:
-   Registrable() = default;
-   ~Registrable() = default;
-};
-
 struct Objective : public Registrable {
 private:
 
@@ -247,9 +462,9 @@ private:
          } else {
             static constexpr bool bCalcMetric = false;
 
-            // currently this branch is not taken, but if would be if we wanted to allow in the future
-            // non-metric calculating validation for boosting.  For instance if we wanted to substitute an alternate
-            // metric or if for performance reasons we only want to calculate the metric every N rounds of boosting
+            // validation updates take this branch when the caller substitutes registered metrics for the 
+            // objective's metric, which are then calculated separately from the updated scores, and on the
+            // updates that SetValidationMetricInterval skips
 
             EBM_ASSERT(nullptr == pData->m_aWeights);
             static constexpr bool bWeight = false; // if we are not calculating the metric or updating gradients then we never need the weights
@@ -292,8 +507,8 @@ private:
 protected:
 
    template<typename TObjective, typename TFloat, bool bHessian, bool bWeight, typename std::enable_if<bHessian, void>::type * = nullptr>
-   GPU_DEVICE INLINE_ALWAYS typename TFloat::T * HandleGradHess(
-      typename TFloat::T * const pGradientAndHessian,
+   GPU_DEVICE INLINE_ALWAYS FloatFast * HandleGradHess(
+      FloatFast * const pGradientAndHessian,
       const TFloat sampleScore,
       const TFloat target,
       const TFloat weight
@@ -311,13 +526,21 @@ protected:
          gradient *= weight;
          hessian *= weight;
       }
-      gradient.SaveAligned(pGradientAndHessian);
-      hessian.SaveAligned(pGradientAndHessian + TFloat::cPack);
+      // BinSums expects the gradient and hessian of each sample to be adjacent, so interleave the SIMD lanes.
+      // The temporaries also convert to FloatFast, which can be narrower than TFloat::T
+      alignas(alignof(TFloat)) typename TFloat::T gradients[TFloat::cPack];
+      alignas(alignof(TFloat)) typename TFloat::T hessians[TFloat::cPack];
+      gradient.SaveAligned(gradients);
+      hessian.SaveAligned(hessians);
+      for(int i = 0; i < TFloat::cPack; ++i) {
+         pGradientAndHessian[i + i] = static_cast<FloatFast>(gradients[i]);
+         pGradientAndHessian[i + i + 1] = static_cast<FloatFast>(hessians[i]);
+      }
       return pGradientAndHessian + (TFloat::cPack + TFloat::cPack);
    }
    template<typename TObjective, typename TFloat, bool bHessian, bool bWeight, typename std::enable_if<!bHessian, void>::type * = nullptr>
-   GPU_DEVICE INLINE_ALWAYS typename TFloat::T * HandleGradHess(
-      typename TFloat::T * const pGradientAndHessian, 
+   GPU_DEVICE INLINE_ALWAYS FloatFast * HandleGradHess(
+      FloatFast * const pGradientAndHessian, 
       const TFloat sampleScore, 
       const TFloat target,
       const TFloat weight
@@ -332,11 +555,16 @@ protected:
          // weight array or not.
          gradient *= weight;
       }
-      gradient.SaveAligned(pGradientAndHessian);
+      // our gradient array is not guaranteed to have SIMD alignment and FloatFast can be narrower than TFloat::T
+      alignas(alignof(TFloat)) typename TFloat::T gradients[TFloat::cPack];
+      gradient.SaveAligned(gradients);
+      for(int i = 0; i < TFloat::cPack; ++i) {
+         pGradientAndHessian[i] = static_cast<FloatFast>(gradients[i]);
+      }
       return pGradientAndHessian + TFloat::cPack;
    }
 
-   template<typename TObjective, typename TFloat, size_t cCompilerScores, ptrdiff_t cCompilerPack, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight>
+   template<typename TObjective, typename TFloat, size_t cCompilerScores, ptrdiff_t cCompilerPack, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight, typename std::enable_if<1 == TFloat::cPack, void>::type * = nullptr>
    GPU_DEVICE void ChildApplyUpdate(ApplyUpdateBridge * const pData) const {
       const TObjective * const pObjective = static_cast<const TObjective *>(this);
 
@@ -344,12 +572,12 @@ protected:
       static constexpr bool bCompilerZeroDimensional = k_cItemsPerBitPackNone == cCompilerPack;
       static constexpr bool bGetTarget = bCalcMetric || bKeepGradHess;
 
-      const typename TFloat::T * const aUpdateTensorScores = reinterpret_cast<const typename TFloat::T *>(pData->m_aUpdateTensorScores);
+      const FloatScore * const aUpdateTensorScores = reinterpret_cast<const FloatScore *>(pData->m_aUpdateTensorScores);
 
       const size_t cSamples = pData->m_cSamples;
 
-      typename TFloat::T * pSampleScore = reinterpret_cast<typename TFloat::T *>(pData->m_aSampleScores);
-      const typename TFloat::T * const pSampleScoresEnd = pSampleScore + cSamples;
+      FloatScore * pSampleScore = reinterpret_cast<FloatScore *>(pData->m_aSampleScores);
+      const FloatScore * const pSampleScoresEnd = pSampleScore + cSamples;
 
       size_t cBitsPerItemMax;
       ptrdiff_t cShift;
@@ -361,7 +589,7 @@ protected:
       TFloat updateScore;
 
       if(bCompilerZeroDimensional) {
-         const typename TFloat::T singleScore = aUpdateTensorScores[0];
+         const typename TFloat::T singleScore = static_cast<typename TFloat::T>(aUpdateTensorScores[0]);
          for(int i = 0; i < TFloat::cPack; ++i) {
             updateScores[i] = singleScore;
          }
@@ -381,19 +609,19 @@ protected:
          pInputData = pData->m_aPacked;
       }
 
-      const typename TFloat::T * pTargetData;
+      const FloatFast * pTargetData;
       if(bGetTarget) {
-         pTargetData = reinterpret_cast<const typename TFloat::T *>(pData->m_aTargets);
+         pTargetData = reinterpret_cast<const FloatFast *>(pData->m_aTargets);
       }
 
-      typename TFloat::T * pGradientAndHessian;
+      FloatFast * pGradientAndHessian;
       if(bKeepGradHess) {
-         pGradientAndHessian = reinterpret_cast<typename TFloat::T *>(pData->m_aGradientsAndHessians);
+         pGradientAndHessian = reinterpret_cast<FloatFast *>(pData->m_aGradientsAndHessians);
       }
 
-      const typename TFloat::T * pWeight;
+      const FloatFast * pWeight;
       if(bWeight) {
-         pWeight = reinterpret_cast<const typename TFloat::T *>(pData->m_aWeights);
+         pWeight = reinterpret_cast<const FloatFast *>(pData->m_aWeights);
       }
 
       TFloat metricSum;
@@ -414,7 +642,7 @@ protected:
                // in later versions of SIMD there are scatter/gather intrinsics that do this in one operation
                for(int i = 0; i < TFloat::cPack; ++i) {
                   const size_t iTensorBin = static_cast<size_t>(iTensorBinCombined[i] >> cShift) & maskBits;
-                  updateScores[i] = aUpdateTensorScores[iTensorBin];
+                  updateScores[i] = static_cast<typename TFloat::T>(aUpdateTensorScores[iTensorBin]);
                }
                updateScore.LoadAligned(updateScores);
             }
@@ -471,6 +699,170 @@ protected:
       }
    }
 
+   template<typename TObjective, typename TFloat, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight>
+   GPU_DEVICE INLINE_ALWAYS TFloat ApplyUpdatePack(
+      const TFloat & updateScore,
+      FloatScore * const pSampleScore,
+      const TFloat & target,
+      const FloatFast * const pWeight,
+      FloatFast * const pGradientAndHessian
+   ) const noexcept {
+      const TObjective * const pObjective = static_cast<const TObjective *>(this);
+
+      TFloat sampleScore;
+      sampleScore.LoadUnaligned(pSampleScore);
+      sampleScore += updateScore;
+      sampleScore.SaveUnaligned(pSampleScore);
+
+      TFloat weight;
+      if(bWeight) {
+         weight.LoadUnaligned(pWeight);
+      }
+
+      if(bKeepGradHess) {
+         HandleGradHess<TObjective, TFloat, bHessian, bWeight>(pGradientAndHessian, sampleScore, target, weight);
+      }
+
+      TFloat metric = 0.0;
+      if(bCalcMetric) {
+         metric = pObjective->CalcMetric(sampleScore, target);
+         if(bWeight) {
+            metric *= weight;
+         }
+      }
+      return metric;
+   }
+
+   template<typename TObjective, typename TFloat, size_t cCompilerScores, ptrdiff_t cCompilerPack, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight, typename std::enable_if<1 != TFloat::cPack, void>::type * = nullptr>
+   GPU_DEVICE void ChildApplyUpdate(ApplyUpdateBridge * const pData) const {
+      // SIMD version.  Our bit packs are interleaved across the SIMD lanes after the dregs, so SimdBitPackReader
+      // unpacks the tensor indexes of a whole pack and fetches its update scores.  The sample count does not need
+      // to be a multiple of the SIMD width.  Partial packs are staged through temporaries that are padded with
+      // copies of the first lane, and the results in the padding lanes are discarded.
+
+      static_assert(k_oneScore == cCompilerScores, "We special case the classifiers so do not need to handle them");
+      static constexpr bool bCompilerZeroDimensional = k_cItemsPerBitPackNone == cCompilerPack;
+      static constexpr bool bGetTarget = bCalcMetric || bKeepGradHess;
+      static constexpr bool bClassification = OutputType_GeneralClassification == TObjective::k_outputType;
+      static constexpr size_t cSIMDPack = static_cast<size_t>(TFloat::cPack);
+      static constexpr size_t cGradHessPerSample = bHessian ? size_t { 2 } : size_t { 1 };
+
+      // classification targets are stored as integers, regression targets as floats
+      typedef typename std::conditional<bClassification, StorageDataType, FloatFast>::type TTarget;
+
+      const FloatScore * const aUpdateTensorScores = reinterpret_cast<const FloatScore *>(pData->m_aUpdateTensorScores);
+
+      const size_t cSamples = pData->m_cSamples;
+      EBM_ASSERT(1 <= cSamples);
+
+      FloatScore * pSampleScore = reinterpret_cast<FloatScore *>(pData->m_aSampleScores);
+      const FloatScore * const pSampleScoresEnd = pSampleScore + cSamples;
+
+      SimdBitPackReader<TFloat> reader;
+      TFloat updateScore;
+
+      if(bCompilerZeroDimensional) {
+         updateScore = aUpdateTensorScores[0];
+      } else {
+         const ptrdiff_t cPack = GET_ITEMS_PER_BIT_PACK(cCompilerPack, pData->m_cPack);
+         reader.Init(pData->m_aPacked, cSamples, static_cast<size_t>(cPack));
+      }
+
+      const TTarget * pTargetData;
+      if(bGetTarget) {
+         pTargetData = reinterpret_cast<const TTarget *>(pData->m_aTargets);
+      }
+
+      FloatFast * pGradientAndHessian;
+      if(bKeepGradHess) {
+         pGradientAndHessian = reinterpret_cast<FloatFast *>(pData->m_aGradientsAndHessians);
+      }
+
+      const FloatFast * pWeight;
+      if(bWeight) {
+         pWeight = reinterpret_cast<const FloatFast *>(pData->m_aWeights);
+      }
+
+      TFloat metricSum;
+      if(bCalcMetric) {
+         metricSum = 0.0;
+      }
+      do {
+         size_t cLanes = static_cast<size_t>(pSampleScoresEnd - pSampleScore);
+         cLanes = cSIMDPack < cLanes ? cSIMDPack : cLanes;
+
+         if(!bCompilerZeroDimensional) {
+            cLanes = reader.CountLanes(cLanes);
+            updateScore = reader.Next(aUpdateTensorScores, cLanes);
+         }
+
+         TFloat target;
+         if(bGetTarget) {
+            if(!bClassification && cSIMDPack == cLanes) {
+               target.LoadUnaligned(reinterpret_cast<const FloatFast *>(pTargetData));
+            } else {
+               alignas(alignof(TFloat)) typename TFloat::T targets[cSIMDPack];
+               for(size_t i = 0; i < cSIMDPack; ++i) {
+                  targets[i] = static_cast<typename TFloat::T>(pTargetData[i < cLanes ? i : 0]);
+               }
+               target.LoadAligned(targets);
+            }
+            pTargetData += cLanes;
+         }
+
+         if(cSIMDPack == cLanes) {
+            const TFloat metric = ApplyUpdatePack<TObjective, TFloat, bHessian, bKeepGradHess, bCalcMetric, bWeight>(
+               updateScore, pSampleScore, target, pWeight, pGradientAndHessian);
+            if(bCalcMetric) {
+               metricSum += metric;
+            }
+            if(bKeepGradHess) {
+               pGradientAndHessian += cSIMDPack * cGradHessPerSample;
+            }
+         } else {
+            FloatScore sampleScores[cSIMDPack];
+            FloatFast weights[cSIMDPack];
+            FloatFast gradientsAndHessians[cSIMDPack * cGradHessPerSample];
+            alignas(alignof(TFloat)) typename TFloat::T laneMasks[cSIMDPack];
+            for(size_t i = 0; i < cSIMDPack; ++i) {
+               const size_t iLane = i < cLanes ? i : 0;
+               sampleScores[i] = pSampleScore[iLane];
+               if(bWeight) {
+                  weights[i] = pWeight[iLane];
+               }
+               laneMasks[i] = i < cLanes ? typename TFloat::T { 1 } : typename TFloat::T { 0 };
+            }
+
+            const TFloat metric = ApplyUpdatePack<TObjective, TFloat, bHessian, bKeepGradHess, bCalcMetric, bWeight>(
+               updateScore, sampleScores, target, weights, gradientsAndHessians);
+
+            for(size_t i = 0; i < cLanes; ++i) {
+               pSampleScore[i] = sampleScores[i];
+            }
+            if(bKeepGradHess) {
+               for(size_t i = 0; i < cLanes * cGradHessPerSample; ++i) {
+                  pGradientAndHessian[i] = gradientsAndHessians[i];
+               }
+               pGradientAndHessian += cLanes * cGradHessPerSample;
+            }
+            if(bCalcMetric) {
+               TFloat laneMask;
+               laneMask.LoadAligned(laneMasks);
+               metricSum += IfGreater(laneMask, 0.0, metric, 0.0);
+            }
+         }
+
+         pSampleScore += cLanes;
+         if(bWeight) {
+            pWeight += cLanes;
+         }
+      } while(pSampleScoresEnd != pSampleScore);
+
+      if(bCalcMetric) {
+         pData->m_metricOut = static_cast<double>(Sum(metricSum));
+      }
+   }
+
 
    template<typename TObjective, typename TFloat>
    INLINE_RELEASE_TEMPLATED ErrorEbm ParentApplyUpdate(ApplyUpdateBridge * const pData) const {
@@ -578,6 +970,14 @@ protected:
 
       pObjectiveWrapperOut->m_bObjectiveHasHessian = HasHessian<TObjective>() ? EBM_TRUE : EBM_FALSE;
       pObjectiveWrapperOut->m_bRmse = TObjective::k_bRmse ? EBM_TRUE : EBM_FALSE;
+      pObjectiveWrapperOut->m_bMultitask = std::is_base_of<MultitaskObjective, TObjective>::value ? EBM_TRUE : EBM_FALSE;
+
+      pObjectiveWrapperOut->m_cSIMDPack = static_cast<size_t>(TFloat::cPack);
+      // the RMSE and multitask objectives have hand written scalar ApplyUpdate functions that walk the bit packs
+      // sequentially, so they keep the sequential layout even within SIMD zones
+      pObjectiveWrapperOut->m_cBitPackLanes = 
+         TObjective::k_bRmse || std::is_base_of<MultitaskObjective, TObjective>::value ? 
+         size_t { 1 } : static_cast<size_t>(TFloat::cPack);
 
       pObjectiveWrapperOut->m_pObjective = this;
 
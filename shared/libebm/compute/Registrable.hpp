@@ -0,0 +1,24 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef REGISTRABLE_HPP
+#define REGISTRABLE_HPP
+
+#include "zones.h"
+
+namespace DEFINED_ZONE_NAME {
+#ifndef DEFINED_ZONE_NAME
+#error DEFINED_ZONE_NAME must be defined
+#endif // DEFINED_ZONE_NAME
+
+// Objective and Metric classes both derive from this so that the Registration system can create either of them
+struct Registrable {
+protected:
+   Registrable() = default;
+   ~Registrable() = default;
+};
+
+} // DEFINED_ZONE_NAME
+
+#endif // REGISTRABLE_HPP
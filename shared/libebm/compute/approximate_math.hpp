@@ -559,7 +559,7 @@ GPU_DEVICE INLINE_ALWAYS static T ExpApproxBest(T val) {
    return val;
 }
 
-template<bool bNegateInput = false, typename T>
+template<bool bNegateInput = false, typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
 GPU_DEVICE INLINE_ALWAYS static T ExpForBinaryClassification(const T val) {
 #ifdef FAST_EXP
    // the optimal addExpSchraudolphTerm would be different between binary 
@@ -575,7 +575,7 @@ GPU_DEVICE INLINE_ALWAYS static T ExpForBinaryClassification(const T val) {
 #endif // FAST_EXP
 }
 
-template<bool bNegateInput = false, typename T>
+template<bool bNegateInput = false, typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
 GPU_DEVICE INLINE_ALWAYS static T ExpForMulticlass(const T val) {
 #ifdef FAST_EXP
    // the optimal addExpSchraudolphTerm would be different between binary
@@ -593,6 +593,27 @@ GPU_DEVICE INLINE_ALWAYS static T ExpForMulticlass(const T val) {
 }
 
 
+// The SIMD float types provide ApproxExp, which matches ExpApproxSchraudolph lane for lane, so these versions
+// give every zone the same results as the scalar functions above without leaving the SIMD registers
+
+template<bool bNegateInput = false, typename TFloat, typename std::enable_if<std::is_class<TFloat>::value, int>::type = 0>
+GPU_DEVICE INLINE_ALWAYS static TFloat ExpForBinaryClassification(const TFloat & val) {
+#ifdef FAST_EXP
+   return ApproxExp(bNegateInput ? -val : val, k_expTermZeroMeanErrorForSoftmaxWithZeroedLogit);
+#else // FAST_EXP
+   return Exp(bNegateInput ? -val : val);
+#endif // FAST_EXP
+}
+
+template<bool bNegateInput = false, typename TFloat, typename std::enable_if<std::is_class<TFloat>::value, int>::type = 0>
+GPU_DEVICE INLINE_ALWAYS static TFloat ExpForMulticlass(const TFloat & val) {
+#ifdef FAST_EXP
+   return ApproxExp(bNegateInput ? -val : val, k_expTermZeroMeanErrorForSoftmaxWithZeroedLogit);
+#else // FAST_EXP
+   return Exp(bNegateInput ? -val : val);
+#endif // FAST_EXP
+}
+
 
 
 ///////////////////////////////////////////// LOG SECTION
@@ -728,7 +749,7 @@ GPU_DEVICE INLINE_ALWAYS static T LogApproxSchraudolph(T val, const float addLog
    return val;
 }
 
-template<bool bNegateOutput = false, typename T>
+template<bool bNegateOutput = false, typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
 GPU_DEVICE INLINE_ALWAYS static T LogForLogLoss(const T val) {
 
    // the log function is only used to calculate the log loss on the valididation set only in our codebase
@@ -763,6 +784,18 @@ GPU_DEVICE INLINE_ALWAYS static T LogForLogLoss(const T val) {
 #endif // FAST_LOG
 }
 
+// the SIMD float types provide ApproxLog, which matches LogApproxSchraudolph lane for lane.  Negating the output
+// afterwards is exact, so this is identical to the scalar bNegateOutput form
+template<bool bNegateOutput = false, typename TFloat, typename std::enable_if<std::is_class<TFloat>::value, int>::type = 0>
+GPU_DEVICE INLINE_ALWAYS static TFloat LogForLogLoss(const TFloat & val) {
+#ifdef FAST_LOG
+   const TFloat ret = ApproxLog(val, k_logTermLowerBoundInputCloseToOne);
+#else // FAST_LOG
+   const TFloat ret = Log(val);
+#endif // FAST_LOG
+   return bNegateOutput ? -ret : ret;
+}
+
 } // DEFINED_ZONE_NAME
 
 #endif // APPROXIMATE_MATH_HPP
\ No newline at end of file
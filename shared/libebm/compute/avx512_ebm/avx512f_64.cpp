@@ -0,0 +1,391 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "precompiled_header_cpp.hpp"
+
+#if (defined(__clang__) || defined(__GNUC__) || defined(__SUNPRO_CC)) && defined(__x86_64__) || defined(_MSC_VER) && defined(_M_X64)
+
+#include <cmath>
+#include <type_traits>
+#include <immintrin.h> // SIMD.  Do not include in precompiled_header_cpp.hpp!
+
+#include "libebm.h"
+#include "logging.h"
+#include "common_c.h"
+#include "bridge_c.h"
+#include "zones.h"
+
+#include "common_cpp.hpp"
+#include "bridge_cpp.hpp"
+
+#include "Registration.hpp"
+#include "Objective.hpp"
+#include "Metric.hpp"
+
+#include "approximate_math.hpp"
+#include "compute_stats.hpp"
+#include "discretize_compare_count.hpp"
+
+namespace DEFINED_ZONE_NAME {
+#ifndef DEFINED_ZONE_NAME
+#error DEFINED_ZONE_NAME must be defined
+#endif // DEFINED_ZONE_NAME
+
+struct Avx512f_64_Int final {
+   friend struct Avx512f_64_Float;
+
+   static constexpr int cPack = 8;
+   using T = uint64_t;
+
+   WARNING_PUSH
+   ATTRIBUTE_WARNING_DISABLE_UNINITIALIZED_MEMBER
+   inline Avx512f_64_Int() noexcept {
+   }
+   WARNING_POP
+
+   inline Avx512f_64_Int(const T val) noexcept : m_data(_mm512_set1_epi64(static_cast<long long>(val))) {
+   }
+
+   inline void LoadAligned(const T * const a) noexcept {
+      // WARNING: 'a' must be aligned memory with:    alignas(64) T a[cPack];
+      m_data = _mm512_load_si512(a);
+   }
+
+   inline void LoadUnaligned(const T * const a) noexcept {
+      m_data = _mm512_loadu_si512(a);
+   }
+
+   inline void SaveAligned(T * const a) const noexcept {
+      // WARNING: 'a' must be aligned memory with:    alignas(64) T a[cPack];
+      _mm512_store_si512(a, m_data);
+   }
+
+   inline void LoadIndexed(const T * const a, const Avx512f_64_Int & indexes) noexcept {
+      // one gather instruction loads a[indexes[i]] into each lane.  The masked form with a zeroed source avoids the 
+      // undefined register that the unmasked intrinsic starts from, which gcc warns about as uninitialized
+      m_data = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), static_cast<__mmask8>(0xFF), indexes.m_data, a, sizeof(T));
+   }
+
+   inline Avx512f_64_Int operator+ (const Avx512f_64_Int & other) const noexcept {
+      return Avx512f_64_Int(_mm512_add_epi64(m_data, other.m_data));
+   }
+
+   inline Avx512f_64_Int operator- (const Avx512f_64_Int & other) const noexcept {
+      return Avx512f_64_Int(_mm512_sub_epi64(m_data, other.m_data));
+   }
+
+   inline Avx512f_64_Int operator& (const Avx512f_64_Int & other) const noexcept {
+      return Avx512f_64_Int(_mm512_and_si512(m_data, other.m_data));
+   }
+
+   inline Avx512f_64_Int operator>> (const Avx512f_64_Int & shifts) const noexcept {
+      // each lane is shifted by its own amount
+      return Avx512f_64_Int(_mm512_maskz_srlv_epi64(static_cast<__mmask8>(0xFF), m_data, shifts.m_data));
+   }
+
+   friend inline Avx512f_64_Int IfLess(const Avx512f_64_Int & cmp1, const Avx512f_64_Int & cmp2, const Avx512f_64_Int & trueVal, const Avx512f_64_Int & falseVal) noexcept {
+      const __mmask8 mask = _mm512_cmplt_epu64_mask(cmp1.m_data, cmp2.m_data);
+      return Avx512f_64_Int(_mm512_mask_blend_epi64(mask, falseVal.m_data, trueVal.m_data));
+   }
+
+private:
+
+   inline Avx512f_64_Int(const __m512i & data) noexcept : m_data(data) {
+   }
+
+   __m512i m_data;
+};
+static_assert(std::is_standard_layout<Avx512f_64_Int>::value && std::is_trivially_copyable<Avx512f_64_Int>::value,
+   "This allows offsetof, memcpy, memset, inter-language, GPU and cross-machine use where needed");
+
+struct Avx512f_64_Float final {
+   static constexpr bool bCpu = false;
+   static constexpr bool bGather = true;
+   static constexpr int cPack = 8;
+   using T = double;
+   using TInt = Avx512f_64_Int;
+
+   WARNING_PUSH
+   ATTRIBUTE_WARNING_DISABLE_UNINITIALIZED_MEMBER
+   inline Avx512f_64_Float() noexcept {
+   }
+   WARNING_POP
+
+   Avx512f_64_Float(const Avx512f_64_Float & other) noexcept = default; // preserve POD status
+   Avx512f_64_Float & operator=(const Avx512f_64_Float &) noexcept = default; // preserve POD status
+
+   inline Avx512f_64_Float(const double val) noexcept : m_data { _mm512_set1_pd(static_cast<T>(val)) } {
+   }
+   inline Avx512f_64_Float(const float val) noexcept : m_data { _mm512_set1_pd(static_cast<T>(val)) } {
+   }
+   inline Avx512f_64_Float(const int val) noexcept : m_data { _mm512_set1_pd(static_cast<T>(val)) } {
+   }
+
+   inline Avx512f_64_Float & operator= (const double val) noexcept {
+      m_data = _mm512_set1_pd(static_cast<T>(val));
+      return *this;
+   }
+   inline Avx512f_64_Float & operator= (const float val) noexcept {
+      m_data = _mm512_set1_pd(static_cast<T>(val));
+      return *this;
+   }
+   inline Avx512f_64_Float & operator= (const int val) noexcept {
+      m_data = _mm512_set1_pd(static_cast<T>(val));
+      return *this;
+   }
+
+
+   inline Avx512f_64_Float operator+() const noexcept {
+      return *this;
+   }
+
+   inline Avx512f_64_Float operator-() const noexcept {
+      // _mm512_xor_pd requires AVX512DQ, so flip the sign bit with an integer xor which only needs AVX512F
+      return Avx512f_64_Float(_mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(m_data), _mm512_castpd_si512(_mm512_set1_pd(-0.0)))));
+   }
+
+
+   inline Avx512f_64_Float operator+ (const Avx512f_64_Float & other) const noexcept {
+      return Avx512f_64_Float(_mm512_add_pd(m_data, other.m_data));
+   }
+
+   inline Avx512f_64_Float operator- (const Avx512f_64_Float & other) const noexcept {
+      return Avx512f_64_Float(_mm512_sub_pd(m_data, other.m_data));
+   }
+
+   inline Avx512f_64_Float operator* (const Avx512f_64_Float & other) const noexcept {
+      return Avx512f_64_Float(_mm512_mul_pd(m_data, other.m_data));
+   }
+
+   inline Avx512f_64_Float operator/ (const Avx512f_64_Float & other) const noexcept {
+      return Avx512f_64_Float(_mm512_div_pd(m_data, other.m_data));
+   }
+
+   inline Avx512f_64_Float & operator+= (const Avx512f_64_Float & other) noexcept {
+      *this = (*this) + other;
+      return *this;
+   }
+
+   inline Avx512f_64_Float & operator-= (const Avx512f_64_Float & other) noexcept {
+      *this = (*this) - other;
+      return *this;
+   }
+
+   inline Avx512f_64_Float & operator*= (const Avx512f_64_Float & other) noexcept {
+      *this = (*this) * other;
+      return *this;
+   }
+
+   inline Avx512f_64_Float & operator/= (const Avx512f_64_Float & other) noexcept {
+      *this = (*this) / other;
+      return *this;
+   }
+
+
+   friend inline Avx512f_64_Float operator+ (const double val, const Avx512f_64_Float & other) noexcept {
+      return Avx512f_64_Float(val) + other;
+   }
+
+   friend inline Avx512f_64_Float operator- (const double val, const Avx512f_64_Float & other) noexcept {
+      return Avx512f_64_Float(val) - other;
+   }
+
+   friend inline Avx512f_64_Float operator* (const double val, const Avx512f_64_Float & other) noexcept {
+      return Avx512f_64_Float(val) * other;
+   }
+
+   friend inline Avx512f_64_Float operator/ (const double val, const Avx512f_64_Float & other) noexcept {
+      return Avx512f_64_Float(val) / other;
+   }
+
+   inline void LoadAligned(const T * const a) noexcept {
+      // WARNING: 'a' must be aligned memory with:    alignas(64) T a[cPack];
+      m_data = _mm512_load_pd(a);
+   }
+
+   inline void SaveAligned(T * const a) const noexcept {
+      // WARNING: 'a' must be aligned memory with:    alignas(64) T a[cPack];
+      _mm512_store_pd(a, m_data);
+   }
+
+   inline void LoadUnaligned(const T * const a) noexcept {
+      m_data = _mm512_loadu_pd(a);
+   }
+
+   inline void SaveUnaligned(T * const a) const noexcept {
+      _mm512_storeu_pd(a, m_data);
+   }
+
+   // FLOAT_FAST_32 builds store the gradients, hessians, targets and weights as float32 but we still compute in double.  The unmasked
+   // conversions pass an undefined register to the builtin, which g++ flags as maybe-uninitialized
+   inline void LoadUnaligned(const float * const a) noexcept {
+      m_data = _mm512_maskz_cvtps_pd(static_cast<__mmask8>(0xFF), _mm256_loadu_ps(a));
+   }
+
+   inline void SaveUnaligned(float * const a) const noexcept {
+      _mm256_storeu_ps(a, _mm512_maskz_cvtpd_ps(static_cast<__mmask8>(0xFF), m_data));
+   }
+
+   inline void LoadIndexed(const T * const a, const TInt & indexes) noexcept {
+      // one gather instruction loads a[indexes[i]] into each lane
+      m_data = _mm512_mask_i64gather_pd(_mm512_setzero_pd(), static_cast<__mmask8>(0xFF), indexes.m_data, a, sizeof(T));
+   }
+
+   inline void LoadIndexed(const float * const a, const TInt & indexes) noexcept {
+      m_data = _mm512_maskz_cvtps_pd(
+         static_cast<__mmask8>(0xFF),
+         _mm512_mask_i64gather_ps(_mm256_setzero_ps(), static_cast<__mmask8>(0xFF), indexes.m_data, a, sizeof(float))
+      );
+   }
+
+   template<typename TFunc>
+   friend inline Avx512f_64_Float ApplyFunction(const Avx512f_64_Float & val, const TFunc & func) noexcept {
+      alignas(64) T aTemp[cPack];
+      val.SaveAligned(aTemp);
+
+      for(int i = 0; i < cPack; ++i) {
+         aTemp[i] = func(aTemp[i]);
+      }
+
+      Avx512f_64_Float result;
+      result.LoadAligned(aTemp);
+      return result;
+   }
+
+   friend inline Avx512f_64_Float IfGreater(const Avx512f_64_Float & cmp1, const Avx512f_64_Float & cmp2, const Avx512f_64_Float & trueVal, const Avx512f_64_Float & falseVal) noexcept {
+      const __mmask8 mask = _mm512_cmp_pd_mask(cmp1.m_data, cmp2.m_data, _CMP_GT_OQ);
+      return Avx512f_64_Float(_mm512_mask_blend_pd(mask, falseVal.m_data, trueVal.m_data));
+   }
+
+   friend inline Avx512f_64_Float IfLess(const Avx512f_64_Float & cmp1, const Avx512f_64_Float & cmp2, const Avx512f_64_Float & trueVal, const Avx512f_64_Float & falseVal) noexcept {
+      const __mmask8 mask = _mm512_cmp_pd_mask(cmp1.m_data, cmp2.m_data, _CMP_LT_OQ);
+      return Avx512f_64_Float(_mm512_mask_blend_pd(mask, falseVal.m_data, trueVal.m_data));
+   }
+
+   friend inline Avx512f_64_Float Sqrt(const Avx512f_64_Float & val) noexcept {
+      // _mm512_sqrt_pd passes an undefined source vector internally which trips -Wmaybe-uninitialized on GCC
+      return Avx512f_64_Float(_mm512_mask_sqrt_pd(val.m_data, static_cast<__mmask8>(0xFF), val.m_data));
+   }
+
+   friend inline Avx512f_64_Float Exp(const Avx512f_64_Float & val) noexcept {
+      // the exact functions call the standard library for each lane so that models built with them are identical
+      // to the cpu zone on every host.  ApproxExp and ApproxLog below are the ones computed in the vector registers
+      return ApplyFunction(val, [](T x) { return std::exp(x); });
+   }
+
+   friend inline Avx512f_64_Float Log(const Avx512f_64_Float & val) noexcept {
+      return ApplyFunction(val, [](T x) { return std::log(x); });
+   }
+
+   friend inline Avx512f_64_Float ApproxExp(const Avx512f_64_Float & val, const int32_t addExpSchraudolphTerm) noexcept {
+      // lane for lane identical to ExpApproxSchraudolph<false, true, true, true, false>.  The conversions round
+      // the same way as the scalar casts, and the out of range lanes are replaced afterwards
+      static constexpr __mmask8 k_all = static_cast<__mmask8>(0xFF);
+
+      const __m256 valFloat = _mm512_maskz_cvtpd_ps(k_all, val.m_data);
+      const __m256i retInt = _mm256_add_epi32(
+         _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_set1_ps(k_expMultiple), valFloat)), _mm256_set1_epi32(addExpSchraudolphTerm));
+      __m512d ret = _mm512_maskz_cvtps_pd(k_all, _mm256_castsi256_ps(retInt));
+
+      ret = _mm512_mask_mov_pd(ret,
+         _mm512_cmp_pd_mask(val.m_data, _mm512_set1_pd(static_cast<T>(k_expUnderflowPoint)), _CMP_LT_OQ), _mm512_setzero_pd());
+      ret = _mm512_mask_mov_pd(ret,
+         _mm512_cmp_pd_mask(_mm512_set1_pd(static_cast<T>(k_expOverflowPoint)), val.m_data, _CMP_LT_OQ), _mm512_set1_pd(std::numeric_limits<T>::infinity()));
+      ret = _mm512_mask_mov_pd(ret, _mm512_cmp_pd_mask(val.m_data, val.m_data, _CMP_UNORD_Q), val.m_data);
+      return Avx512f_64_Float(ret);
+   }
+
+   friend inline Avx512f_64_Float ApproxLog(const Avx512f_64_Float & val, const float addLogSchraudolphTerm) noexcept {
+      // lane for lane identical to LogApproxSchraudolph<false, true, false, false, false>
+      static constexpr __mmask8 k_all = static_cast<__mmask8>(0xFF);
+
+      const __m256 valFloat = _mm512_maskz_cvtpd_ps(k_all, val.m_data);
+      const __m256 retFloat = _mm256_add_ps(
+         _mm256_mul_ps(_mm256_set1_ps(k_logMultiple), _mm256_cvtepi32_ps(_mm256_castps_si256(valFloat))), _mm256_set1_ps(addLogSchraudolphTerm));
+      __m512d ret = _mm512_maskz_cvtps_pd(k_all, retFloat);
+
+      ret = _mm512_mask_mov_pd(ret,
+         _mm512_cmp_pd_mask(_mm512_set1_pd(static_cast<T>(std::numeric_limits<float>::max())), val.m_data, _CMP_LT_OQ), _mm512_set1_pd(std::numeric_limits<T>::infinity()));
+      ret = _mm512_mask_mov_pd(ret, _mm512_cmp_pd_mask(val.m_data, val.m_data, _CMP_UNORD_Q), val.m_data);
+      return Avx512f_64_Float(ret);
+   }
+
+   friend inline T Sum(const Avx512f_64_Float & val) noexcept {
+      // sum the lanes in order so that the result is deterministic and does not depend on the compiler
+      alignas(64) T aTemp[cPack];
+      val.SaveAligned(aTemp);
+
+      T sum = 0.0;
+      for(int i = 0; i < cPack; ++i) {
+         sum += aTemp[i];
+      }
+      return sum;
+   }
+
+   template<typename TObjective, size_t cCompilerScores, ptrdiff_t cCompilerPack, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight>
+   INLINE_RELEASE_TEMPLATED static ErrorEbm OperatorApplyUpdate(const Objective * const pObjective, ApplyUpdateBridge * const pData) noexcept {
+      // this allows us to switch execution onto GPU, FPGA, or other local computation
+      RemoteApplyUpdate<TObjective, cCompilerScores, cCompilerPack, bHessian, bKeepGradHess, bCalcMetric, bWeight>(pObjective, pData);
+      return Error_None;
+   }
+
+private:
+
+   inline Avx512f_64_Float(const __m512d & data) noexcept : m_data(data) {
+   }
+
+   __m512d m_data;
+};
+static_assert(std::is_standard_layout<Avx512f_64_Float>::value && std::is_trivially_copyable<Avx512f_64_Float>::value,
+   "This allows offsetof, memcpy, memset, inter-language, GPU and cross-machine use where needed");
+
+// FIRST, define the RegisterObjective function that we'll be calling from our registrations.  This is a static
+// function, so we can have duplicate named functions in other files and they'll refer to different functions
+template<template <typename> class TRegistrable, typename... Args>
+INLINE_ALWAYS static std::shared_ptr<const Registration> RegisterObjective(const char * const sRegistrationName, const Args...args) {
+   return Register<TRegistrable, Avx512f_64_Float>(sRegistrationName, args...);
+}
+
+// now include all our special objective registrations which will use the RegisterObjective function we defined above!
+#include "objective_registrations.hpp"
+
+INTERNAL_IMPORT_EXPORT_BODY ErrorEbm CreateObjective_Avx512f_64(
+   const Config * const pConfig,
+   const char * const sObjective,
+   const char * const sObjectiveEnd,
+   ObjectiveWrapper * const pObjectiveWrapperOut
+) {
+   return Objective::CreateObjective(&RegisterObjectives, pConfig, sObjective, sObjectiveEnd, pObjectiveWrapperOut);
+}
+
+// the RegisterMetric function works the same way for the metric registrations included below
+template<template <typename> class TRegistrable, typename... Args>
+INLINE_ALWAYS static std::shared_ptr<const Registration> RegisterMetric(const char * const sRegistrationName, const Args...args) {
+   return Register<TRegistrable, Avx512f_64_Float>(sRegistrationName, args...);
+}
+
+#include "metric_registrations.hpp"
+
+INTERNAL_IMPORT_EXPORT_BODY ErrorEbm CreateMetric_Avx512f_64(
+   const Config * const pConfig,
+   const char * const sMetric,
+   const char * const sMetricEnd,
+   MetricWrapper * const pMetricWrapperOut
+) {
+   return Metric::CreateMetric(&RegisterMetrics, pConfig, sMetric, sMetricEnd, pMetricWrapperOut);
+}
+
+INTERNAL_IMPORT_EXPORT_BODY void DiscretizeCompareCount_Avx512f_64(
+   const size_t cSamples,
+   const double * const aFeatureVals,
+   const size_t cCuts,
+   const double * const aCuts,
+   IntEbm * const aBinIndexesOut
+) {
+   DiscretizeCompareCount<Avx512f_64_Float>(cSamples, aFeatureVals, cCuts, aCuts, aBinIndexesOut);
+}
+
+} // DEFINED_ZONE_NAME
+
+#endif // architecture x64
@@ -18,6 +18,7 @@
 
 #include "Registration.hpp"
 #include "Objective.hpp"
+#include "Metric.hpp"
 
 #include "approximate_math.hpp"
 #include "compute_stats.hpp"
@@ -43,6 +44,7 @@ static_assert(std::is_standard_layout<Cpu_64_Int>::value && std::is_trivially_co
 
 struct Cpu_64_Float final {
    static constexpr bool bCpu = true;
+   static constexpr bool bGather = false;
    static constexpr int cPack = 1;
    using T = double;
    using TInt = Cpu_64_Int;
@@ -147,6 +149,31 @@ struct Cpu_64_Float final {
       *a = m_data;
    }
 
+   inline void LoadUnaligned(const T * const a) noexcept {
+      m_data = *a;
+   }
+
+   inline void SaveUnaligned(T * const a) const noexcept {
+      *a = m_data;
+   }
+
+   // FLOAT_FAST_32 builds store the gradients, hessians, targets and weights as float32 but we still compute in double
+   inline void LoadAligned(const float * const a) noexcept {
+      m_data = static_cast<T>(*a);
+   }
+
+   inline void SaveAligned(float * const a) const noexcept {
+      *a = static_cast<float>(m_data);
+   }
+
+   inline void LoadUnaligned(const float * const a) noexcept {
+      m_data = static_cast<T>(*a);
+   }
+
+   inline void SaveUnaligned(float * const a) const noexcept {
+      *a = static_cast<float>(m_data);
+   }
+
    template<typename TFunc>
    friend inline Cpu_64_Float ApplyFunction(const Cpu_64_Float & val, const TFunc & func) noexcept {
       // this function is more useful for a SIMD operator where it applies func() to all packed items
@@ -173,6 +200,14 @@ struct Cpu_64_Float final {
       return Cpu_64_Float(std::log(val.m_data));
    }
 
+   friend inline Cpu_64_Float ApproxExp(const Cpu_64_Float & val, const int32_t addExpSchraudolphTerm) noexcept {
+      return Cpu_64_Float(ExpApproxSchraudolph<false, true, true, true, false, T>(val.m_data, addExpSchraudolphTerm));
+   }
+
+   friend inline Cpu_64_Float ApproxLog(const Cpu_64_Float & val, const float addLogSchraudolphTerm) noexcept {
+      return Cpu_64_Float(LogApproxSchraudolph<false, true, false, false, false, T>(val.m_data, addLogSchraudolphTerm));
+   }
+
    friend inline T Sum(const Cpu_64_Float & val) noexcept {
       return val.m_data;
    }
@@ -211,17 +246,21 @@ INTERNAL_IMPORT_EXPORT_BODY ErrorEbm CreateObjective_Cpu_64(
    return Objective::CreateObjective(&RegisterObjectives, pConfig, sObjective, sObjectiveEnd, pObjectiveWrapperOut);
 }
 
+// the RegisterMetric function works the same way for the metric registrations included below
+template<template <typename> class TRegistrable, typename... Args>
+INLINE_ALWAYS static std::shared_ptr<const Registration> RegisterMetric(const char * const sRegistrationName, const Args...args) {
+   return Register<TRegistrable, Cpu_64_Float>(sRegistrationName, args...);
+}
+
+#include "metric_registrations.hpp"
+
 INTERNAL_IMPORT_EXPORT_BODY ErrorEbm CreateMetric_Cpu_64(
    const Config * const pConfig,
    const char * const sMetric,
-   const char * const sMetricEnd
-//   MetricWrapper * const pMetricWrapperOut,
+   const char * const sMetricEnd,
+   MetricWrapper * const pMetricWrapperOut
 ) {
-   UNUSED(pConfig);
-   UNUSED(sMetric);
-   UNUSED(sMetricEnd);
-
-   return Error_UnexpectedInternal;
+   return Metric::CreateMetric(&RegisterMetrics, pConfig, sMetric, sMetricEnd, pMetricWrapperOut);
 }
 
 
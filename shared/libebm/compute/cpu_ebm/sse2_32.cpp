@@ -46,6 +46,7 @@ static_assert(std::is_standard_layout<Sse_32_Int>::value && std::is_trivially_co
 
 struct Sse_32_Float final {
    static constexpr bool bCpu = false;
+   static constexpr bool bGather = false;
    static constexpr int cPack = 4;
    using T = float;
    using TInt = Sse_32_Int;
@@ -152,6 +153,24 @@ struct Sse_32_Float final {
       _mm_store_ps(a, m_data);
    }
 
+   inline void LoadUnaligned(const T * const a) noexcept {
+      m_data = _mm_loadu_ps(a);
+   }
+
+   inline void SaveUnaligned(T * const a) const noexcept {
+      _mm_storeu_ps(a, m_data);
+   }
+
+   // the sample scores are always double, and the other sample arrays are too unless FLOAT_FAST_32 is defined
+   inline void LoadUnaligned(const double * const a) noexcept {
+      m_data = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(a)), _mm_cvtpd_ps(_mm_loadu_pd(a + 2)));
+   }
+
+   inline void SaveUnaligned(double * const a) const noexcept {
+      _mm_storeu_pd(a, _mm_cvtps_pd(m_data));
+      _mm_storeu_pd(a + 2, _mm_cvtps_pd(_mm_movehl_ps(m_data, m_data)));
+   }
+
    template<typename TFunc>
    friend inline Sse_32_Float ApplyFunction(const Sse_32_Float & val, const TFunc & func) noexcept {
       alignas(16) T aTemp[cPack];
@@ -182,7 +201,7 @@ struct Sse_32_Float final {
 
    friend inline Sse_32_Float Sqrt(const Sse_32_Float & val) noexcept {
       // TODO: make a fast approximation of this
-      return Sse_32_Float(_mm_sqrt_ss(val.m_data));
+      return Sse_32_Float(_mm_sqrt_ps(val.m_data));
    }
 
    friend inline Sse_32_Float Exp(const Sse_32_Float & val) noexcept {
@@ -195,6 +214,18 @@ struct Sse_32_Float final {
       return ApplyFunction(val, [](T x) { return std::log(x); });
    }
 
+   friend inline Sse_32_Float ApproxExp(const Sse_32_Float & val, const int32_t addExpSchraudolphTerm) noexcept {
+      return ApplyFunction(val, [addExpSchraudolphTerm](T x) {
+         return ExpApproxSchraudolph<false, true, true, true, false, T>(x, addExpSchraudolphTerm);
+      });
+   }
+
+   friend inline Sse_32_Float ApproxLog(const Sse_32_Float & val, const float addLogSchraudolphTerm) noexcept {
+      return ApplyFunction(val, [addLogSchraudolphTerm](T x) {
+         return LogApproxSchraudolph<false, true, false, false, false, T>(x, addLogSchraudolphTerm);
+      });
+   }
+
    friend inline T Sum(const Sse_32_Float & val) noexcept {
       // TODO: this could be written to be more efficient
 
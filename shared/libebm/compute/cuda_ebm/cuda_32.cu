@@ -54,6 +54,7 @@ struct Cuda_32_Float final {
    // https://docs.nvidia.com/cuda/cuda-math-api/group__CUDA__MATH__DOUBLE.html#group__CUDA__MATH__DOUBLE
 
    static constexpr bool bCpu = false;
+   static constexpr bool bGather = false;
    static constexpr int cPack = 1;
    using T = float;
    using TInt = Cuda_32_Int;
@@ -158,6 +159,15 @@ struct Cuda_32_Float final {
       *a = m_data;
    }
 
+   // the sample arrays are stored as FloatFast, which is double unless FLOAT_FAST_32 is defined
+   GPU_BOTH inline void LoadAligned(const double * const a) noexcept {
+      m_data = static_cast<T>(*a);
+   }
+
+   GPU_BOTH inline void SaveAligned(double * const a) const noexcept {
+      *a = static_cast<double>(m_data);
+   }
+
    template<typename TFunc>
    GPU_BOTH friend inline Cuda_32_Float ApplyFunction(const Cuda_32_Float & val, const TFunc & func) noexcept {
       // this function is more useful for a SIMD operator where it applies func() to all packed items
@@ -184,6 +194,14 @@ struct Cuda_32_Float final {
       return Cuda_32_Float(logf(val.m_data));
    }
 
+   GPU_BOTH friend inline Cuda_32_Float ApproxExp(const Cuda_32_Float & val, const int32_t addExpSchraudolphTerm) noexcept {
+      return Cuda_32_Float(ExpApproxSchraudolph<false, true, true, true, false, T>(val.m_data, addExpSchraudolphTerm));
+   }
+
+   GPU_BOTH friend inline Cuda_32_Float ApproxLog(const Cuda_32_Float & val, const float addLogSchraudolphTerm) noexcept {
+      return Cuda_32_Float(LogApproxSchraudolph<false, true, false, false, false, T>(val.m_data, addLogSchraudolphTerm));
+   }
+
    GPU_BOTH friend inline T Sum(const Cuda_32_Float & val) noexcept {
       return val.m_data;
    }
@@ -0,0 +1,86 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef DISCRETIZE_COMPARE_COUNT_HPP
+#define DISCRETIZE_COMPARE_COUNT_HPP
+
+#include <stddef.h> // size_t, ptrdiff_t
+#include <cmath> // std::isnan
+
+#include "libebm.h" // IntEbm
+#include "logging.h" // EBM_ASSERT
+#include "common_c.h" // UNPREDICTABLE
+#include "bridge_c.h" // k_cDiscretizeCompareCountCutsMax
+#include "zones.h"
+
+#include "common_cpp.hpp" // INLINE_RELEASE_TEMPLATED
+
+namespace DEFINED_ZONE_NAME {
+#ifndef DEFINED_ZONE_NAME
+#error DEFINED_ZONE_NAME must be defined
+#endif // DEFINED_ZONE_NAME
+
+// For small numbers of cuts it is cheaper to compare each sample against every cut and count the cuts that are
+// lower or equal than to do a binary search, since the comparisons are independent of each other and we can
+// process TFloat::cPack samples per comparison.  The result matches numpy.digitize with the missing bin at 0.
+template<typename TFloat>
+INLINE_RELEASE_TEMPLATED static void DiscretizeCompareCount(
+   const size_t cSamples,
+   const double * const aFeatureVals,
+   const size_t cCuts,
+   const double * const aCuts,
+   IntEbm * const aBinIndexesOut
+) noexcept {
+   EBM_ASSERT(size_t { 1 } <= cCuts);
+   EBM_ASSERT(cCuts <= k_cDiscretizeCompareCountCutsMax);
+   EBM_ASSERT(nullptr != aFeatureVals);
+   EBM_ASSERT(nullptr != aCuts);
+   EBM_ASSERT(nullptr != aBinIndexesOut);
+
+   static constexpr size_t cPack = static_cast<size_t>(TFloat::cPack);
+
+   // broadcast the cuts once so that the inner loop is only comparisons and adds
+   TFloat aCutsBroadcast[k_cDiscretizeCompareCountCutsMax];
+   for(size_t iCut = 0; iCut < cCuts; ++iCut) {
+      aCutsBroadcast[iCut] = aCuts[iCut];
+   }
+
+   const TFloat zero = 0.0;
+   const TFloat one = 1.0;
+
+   alignas(64) double aCounts[cPack];
+
+   size_t iSample = 0;
+   while(iSample + cPack <= cSamples) {
+      TFloat val;
+      val.LoadUnaligned(&aFeatureVals[iSample]);
+
+      // !(val < cut) is true for cut <= val, and also for NaN which we fix up below when converting to integers
+      TFloat count = one;
+      for(size_t iCut = 0; iCut < cCuts; ++iCut) {
+         count += IfLess(val, aCutsBroadcast[iCut], zero, one);
+      }
+      count.SaveAligned(aCounts);
+
+      for(size_t iLane = 0; iLane < cPack; ++iLane) {
+         const IntEbm iBin = static_cast<IntEbm>(aCounts[iLane]);
+         aBinIndexesOut[iSample + iLane] = UNPREDICTABLE(std::isnan(aFeatureVals[iSample + iLane])) ? IntEbm { 0 } : iBin;
+      }
+      iSample += cPack;
+   }
+
+   while(iSample < cSamples) {
+      const double val = aFeatureVals[iSample];
+      IntEbm iBin = 1;
+      for(size_t iCut = 0; iCut < cCuts; ++iCut) {
+         iBin += UNPREDICTABLE(aCuts[iCut] <= val) ? IntEbm { 1 } : IntEbm { 0 };
+      }
+      aBinIndexesOut[iSample] = UNPREDICTABLE(std::isnan(val)) ? IntEbm { 0 } : iBin;
+      ++iSample;
+   }
+}
+
+} // DEFINED_ZONE_NAME
+
+#endif // DISCRETIZE_COMPARE_COUNT_HPP
@@ -0,0 +1,175 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+// !! To add a new metric in C++ follow the steps at the top of the "metric_registrations.hpp" file !!
+
+// Do not use this file as a reference for other metrics. AUC depends on the ordering of all the samples, so it
+// does not go through the per-sample CalcMetric interface.
+
+template<typename TFloat>
+struct AucBinaryMetric final : public BinaryMetric {
+private:
+
+   struct AucItem {
+      double m_score;
+      double m_weightPositive;
+      double m_weightNegative;
+   };
+
+   static inline double GetScore(const FloatScore * const aScores, const size_t iSample) noexcept {
+      // NaN scores would break the sort ordering, so treat them as the least confident prediction possible
+      const double score = static_cast<double>(aScores[iSample]);
+      return std::isnan(score) ? -std::numeric_limits<double>::infinity() : score;
+   }
+
+   static inline size_t GetBucket(const double score, const double scoreMin, const double scale, const size_t cBuckets) noexcept {
+      // +-infinity scores and every score when the range overflows (scale == 0) land in the end buckets
+      if(score <= scoreMin) {
+         return 0;
+      }
+      // +infinity times a zero scale is NaN, which fails every comparison, so test for being inside the range
+      const double bucket = (score - scoreMin) * scale;
+      if(!(bucket < static_cast<double>(cBuckets - 1))) {
+         return cBuckets - 1;
+      }
+      return static_cast<size_t>(bucket);
+   }
+
+public:
+   static constexpr BoolEbm k_bMaximizeMetric = MAXIMIZE_METRIC;
+   static ErrorEbm StaticCalcMetric(const Metric * const pThis, MetricBridge * const pData) {
+      return (static_cast<const AucBinaryMetric<TFloat> *>(pThis))->CalcAuc(pData);
+   }
+   void FillWrapper(void * const pWrapperOut) noexcept {
+      FillMetricWrapper<AucBinaryMetric, TFloat>(pWrapperOut);
+   }
+
+   inline AucBinaryMetric(const Config & config) {
+      if(1 != config.cOutputs || !IsClassificationOutput(config.link)) {
+         throw ParamMismatchWithConfigException();
+      }
+   }
+
+   ErrorEbm CalcAuc(MetricBridge * const pData) const {
+      // Sorting the validation set on every boosting step is the expensive part of AUC.  The scores are spread
+      // over one bucket per sample between the lowest and highest score, scattered with a counting sort, and
+      // only the samples that share a bucket get compared.  Well spread scores make this linear time.  The
+      // result is exact since ties are still found within each bucket.
+
+      EBM_ASSERT(nullptr != pData);
+      EBM_ASSERT(1 == pData->m_cScores);
+      EBM_ASSERT(1 <= pData->m_cSamples);
+      EBM_ASSERT(nullptr != pData->m_aSampleScores);
+      EBM_ASSERT(nullptr == pData->m_aResiduals);
+      EBM_ASSERT(nullptr != pData->m_aTargets);
+
+      const size_t cSamples = pData->m_cSamples;
+      const FloatScore * const aScores = reinterpret_cast<const FloatScore *>(pData->m_aSampleScores);
+      const StorageDataType * const aTargets = reinterpret_cast<const StorageDataType *>(pData->m_aTargets);
+      const FloatFast * const aWeights = reinterpret_cast<const FloatFast *>(pData->m_aWeights);
+
+      double scoreMin = std::numeric_limits<double>::infinity();
+      double scoreMax = -std::numeric_limits<double>::infinity();
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         const double score = GetScore(aScores, iSample);
+         if(-std::numeric_limits<double>::infinity() < score && score < scoreMin) {
+            scoreMin = score;
+         }
+         if(score < std::numeric_limits<double>::infinity() && scoreMax < score) {
+            scoreMax = score;
+         }
+      }
+
+      const size_t cBuckets = cSamples;
+      // if there are no finite scores or they overflow the range then everything goes into one bucket and is sorted
+      const double scale = scoreMin < scoreMax ? static_cast<double>(cBuckets) / (scoreMax - scoreMin) : 0.0;
+
+      if(IsMultiplyError(sizeof(AucItem), cSamples) || IsAddError(cBuckets, size_t { 1 }) ||
+         IsMultiplyError(sizeof(size_t), cBuckets + size_t { 1 }))
+      {
+         LOG_0(Trace_Warning, "WARNING AucBinaryMetric::CalcAuc IsMultiplyError(sizeof(AucItem), cSamples)");
+         return Error_OutOfMemory;
+      }
+      AucItem * const aItems = static_cast<AucItem *>(malloc(sizeof(AucItem) * cSamples));
+      if(nullptr == aItems) {
+         LOG_0(Trace_Warning, "WARNING AucBinaryMetric::CalcAuc nullptr == aItems");
+         return Error_OutOfMemory;
+      }
+      size_t * const aBucketStarts = static_cast<size_t *>(malloc(sizeof(size_t) * (cBuckets + size_t { 1 })));
+      if(nullptr == aBucketStarts) {
+         LOG_0(Trace_Warning, "WARNING AucBinaryMetric::CalcAuc nullptr == aBucketStarts");
+         free(aItems);
+         return Error_OutOfMemory;
+      }
+
+      memset(aBucketStarts, 0, sizeof(size_t) * (cBuckets + size_t { 1 }));
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         const size_t iBucket = GetBucket(GetScore(aScores, iSample), scoreMin, scale, cBuckets);
+         ++aBucketStarts[iBucket + 1];
+      }
+      for(size_t iBucket = 0; iBucket < cBuckets; ++iBucket) {
+         aBucketStarts[iBucket + 1] += aBucketStarts[iBucket];
+      }
+
+      double totalPositive = 0.0;
+      double totalNegative = 0.0;
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         const double score = GetScore(aScores, iSample);
+         const size_t iBucket = GetBucket(score, scoreMin, scale, cBuckets);
+         // aBucketStarts[iBucket] is advanced while scattering, so afterwards it holds the start of the next bucket
+         AucItem * const pItem = &aItems[aBucketStarts[iBucket]];
+         ++aBucketStarts[iBucket];
+
+         const double weight = nullptr == aWeights ? 1.0 : static_cast<double>(aWeights[iSample]);
+         pItem->m_score = score;
+         if(StorageDataType { 0 } != aTargets[iSample]) {
+            pItem->m_weightPositive = weight;
+            pItem->m_weightNegative = 0.0;
+            totalPositive += weight;
+         } else {
+            pItem->m_weightPositive = 0.0;
+            pItem->m_weightNegative = weight;
+            totalNegative += weight;
+         }
+      }
+
+      size_t iBucketStart = 0;
+      for(size_t iBucket = 0; iBucket < cBuckets; ++iBucket) {
+         const size_t iBucketEnd = aBucketStarts[iBucket];
+         if(size_t { 2 } <= iBucketEnd - iBucketStart) {
+            std::sort(&aItems[iBucketStart], &aItems[iBucketEnd], [](const AucItem & lhs, const AucItem & rhs) {
+               return lhs.m_score < rhs.m_score;
+            });
+         }
+         iBucketStart = iBucketEnd;
+      }
+      EBM_ASSERT(cSamples == iBucketStart);
+
+      // every positive gets full credit for the negatives scored below it and half credit for tied negatives
+      double sumNegativeBelow = 0.0;
+      double sumCredit = 0.0;
+      size_t iItem = 0;
+      do {
+         const double score = aItems[iItem].m_score;
+         double tiedPositive = 0.0;
+         double tiedNegative = 0.0;
+         do {
+            tiedPositive += aItems[iItem].m_weightPositive;
+            tiedNegative += aItems[iItem].m_weightNegative;
+            ++iItem;
+         } while(iItem != cSamples && score == aItems[iItem].m_score);
+
+         sumCredit += tiedPositive * (sumNegativeBelow + 0.5 * tiedNegative);
+         sumNegativeBelow += tiedNegative;
+      } while(iItem != cSamples);
+
+      free(aBucketStarts);
+      free(aItems);
+
+      // AUC is undefined with only one class present, so return the AUC of an uninformative model
+      const double denominator = totalPositive * totalNegative;
+      pData->m_metricOut = 0.0 < denominator ? sumCredit / denominator : 0.5;
+      return Error_None;
+   }
+};
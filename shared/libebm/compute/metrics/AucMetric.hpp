@@ -1,5 +0,0 @@
-// Copyright (c) 2023 The InterpretML Contributors
-// Licensed under the MIT license.
-// Author: Paul Koch <code@koch.ninja>
-
-// mirror the format of the Objective classes here
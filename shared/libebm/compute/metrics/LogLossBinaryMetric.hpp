@@ -0,0 +1,30 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+// !! To add a new metric in C++ follow the steps at the top of the "metric_registrations.hpp" file !!
+
+template<typename TFloat>
+struct LogLossBinaryMetric final : public BinaryMetric {
+   METRIC_BOILERPLATE(LogLossBinaryMetric, MINIMIZE_METRIC)
+
+   inline LogLossBinaryMetric(const Config & config) {
+      if(1 != config.cOutputs) {
+         // we share the tag "log_loss" with multiclass classification
+         throw SkipRegistrationException();
+      }
+      if(Link_logit != config.link) {
+         throw ParamMismatchWithConfigException();
+      }
+   }
+
+   GPU_DEVICE inline TFloat CalcMetric(const TFloat score, const TFloat target) const noexcept {
+      // identical to LogLossBinaryObjective::CalcMetric so that the default metric and this one agree exactly
+      const TFloat exponent = IfLess(target, 0.5, score, -score);
+      return LogForLogLoss<false>(1.0 + ExpForBinaryClassification<false>(exponent));
+   }
+
+   inline double FinishMetric(const double metricSum, const double totalWeight) const noexcept {
+      return metricSum / totalWeight;
+   }
+};
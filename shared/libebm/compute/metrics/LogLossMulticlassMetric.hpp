@@ -0,0 +1,74 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+// !! To add a new metric in C++ follow the steps at the top of the "metric_registrations.hpp" file !!
+
+// Do not use this file as a reference for other metrics. Multiclass log loss needs all the scores of a sample
+// together, so it does not go through the per-sample CalcMetric interface.
+
+template<typename TFloat>
+struct LogLossMulticlassMetric final : public MulticlassMetric {
+public:
+   static constexpr BoolEbm k_bMaximizeMetric = MINIMIZE_METRIC;
+   static ErrorEbm StaticCalcMetric(const Metric * const pThis, MetricBridge * const pData) {
+      return (static_cast<const LogLossMulticlassMetric<TFloat> *>(pThis))->CalcLogLoss(pData);
+   }
+   void FillWrapper(void * const pWrapperOut) noexcept {
+      FillMetricWrapper<LogLossMulticlassMetric, TFloat>(pWrapperOut);
+   }
+
+   inline LogLossMulticlassMetric(const Config & config) {
+      if(1 == config.cOutputs) {
+         // we share the tag "log_loss" with binary classification
+         throw SkipRegistrationException();
+      }
+      if(config.cOutputs <= 0 || Link_logit != config.link) {
+         throw ParamMismatchWithConfigException();
+      }
+   }
+
+   ErrorEbm CalcLogLoss(MetricBridge * const pData) const {
+      EBM_ASSERT(nullptr != pData);
+      EBM_ASSERT(2 <= pData->m_cScores);
+      EBM_ASSERT(1 <= pData->m_cSamples);
+      EBM_ASSERT(nullptr != pData->m_aSampleScores);
+      EBM_ASSERT(nullptr == pData->m_aResiduals);
+      EBM_ASSERT(nullptr != pData->m_aTargets);
+
+      const size_t cScores = pData->m_cScores;
+
+      // the same exp and log approximations as LogLossMulticlassObjective so that the default metric and 
+      // this one agree exactly
+      const FloatScore * pSampleScore = reinterpret_cast<const FloatScore *>(pData->m_aSampleScores);
+      const StorageDataType * pTargetData = reinterpret_cast<const StorageDataType *>(pData->m_aTargets);
+      const StorageDataType * const pTargetsEnd = pTargetData + pData->m_cSamples;
+      const FloatFast * pWeight = reinterpret_cast<const FloatFast *>(pData->m_aWeights);
+
+      FloatFast sumLogLoss = 0;
+      do {
+         FloatFast sumExp = 0;
+         size_t iScore = 0;
+         do {
+            sumExp += static_cast<FloatFast>(ExpForMulticlass<false>(pSampleScore[iScore]));
+            ++iScore;
+         } while(cScores != iScore);
+
+         const size_t targetData = static_cast<size_t>(*pTargetData);
+         ++pTargetData;
+         EBM_ASSERT(targetData < cScores);
+         const FloatFast itemExp = static_cast<FloatFast>(ExpForMulticlass<false>(pSampleScore[targetData]));
+         pSampleScore += cScores;
+
+         FloatFast sampleLogLoss = EbmStats::ComputeSingleSampleLogLossMulticlass(sumExp, itemExp);
+         if(nullptr != pWeight) {
+            sampleLogLoss *= *pWeight;
+            ++pWeight;
+         }
+         sumLogLoss += sampleLogLoss;
+      } while(pTargetsEnd != pTargetData);
+
+      pData->m_metricOut = static_cast<double>(sumLogLoss) / pData->m_totalWeight;
+      return Error_None;
+   }
+};
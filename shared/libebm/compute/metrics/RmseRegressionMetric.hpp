@@ -0,0 +1,36 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+// !! To add a new metric in C++ follow the steps at the top of the "metric_registrations.hpp" file !!
+
+template<typename TFloat>
+struct RmseRegressionMetric final : public RegressionMetric {
+   METRIC_BOILERPLATE(RmseRegressionMetric, MINIMIZE_METRIC)
+
+   // the scores are in link space, so objectives with a log link need to be exponentiated before comparing
+   bool m_bLogLink;
+
+   inline RmseRegressionMetric(const Config & config) {
+      if(1 != config.cOutputs) {
+         throw ParamMismatchWithConfigException();
+      }
+      if(Link_identity == config.link) {
+         m_bLogLink = false;
+      } else if(Link_log == config.link) {
+         m_bLogLink = true;
+      } else {
+         throw ParamMismatchWithConfigException();
+      }
+   }
+
+   GPU_DEVICE inline TFloat CalcMetric(const TFloat score, const TFloat target) const noexcept {
+      const TFloat prediction = m_bLogLink ? Exp(score) : score;
+      const TFloat error = prediction - target;
+      return error * error;
+   }
+
+   inline double FinishMetric(const double metricSum, const double totalWeight) const noexcept {
+      return std::sqrt(metricSum / totalWeight);
+   }
+};
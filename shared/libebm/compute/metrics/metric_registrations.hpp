@@ -0,0 +1,41 @@
+// Copyright (c) 2023 The InterpretML Contributors
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifdef METRIC_REGISTRATIONS_HPP
+#error metric_registrations.hpp is very special and should only be included once in a translation unit (*.cpp file).
+#endif
+#define METRIC_REGISTRATIONS_HPP
+
+// Steps for adding a new metric in C++:
+//   1) Copy one of the existing "*Metric.hpp" include files into a newly renamed "*Metric.hpp" file
+//      (for metrics that sum a value per sample, we recommend starting from RmseRegressionMetric.hpp).
+//   2) Change the name of the class and the constructor name to fit the new metric.
+//   3) Update the parameters to the METRIC_BOILERPLATE macro for the new metric.
+//   4) Modify the new "*Metric.hpp" file to calculate the per-sample metric and the final metric.
+//   5) Add [#include "*Metric.hpp"] to the list of other include files right below this guide.
+//   6) Add the new Metric type to the list of metric registrations in the RegisterMetrics() function below.
+//   7) Modify the RegisterMetric<...>("metric_name", ...) entry to have the new metric name
+//      and the list of optional public parameters needed for the new Metric class.
+//   8) Update/verify that the constructor arguments on the new Metric class match the parameters in the 
+//      metric registration below.
+//   9) Recompile the C++ with either build.sh or build.bat depending on the operating system.
+
+// Add new "*Metric.hpp" include files here:
+#include "RmseRegressionMetric.hpp"
+#include "MaeRegressionMetric.hpp"
+#include "LogLossBinaryMetric.hpp"
+#include "LogLossMulticlassMetric.hpp"
+#include "AucBinaryMetric.hpp"
+
+// Add new *Metric type registrations to this list:
+static const std::vector<std::shared_ptr<const Registration>> RegisterMetrics() {
+   // IMPORTANT: the parameter types listed here must match the parameters types in the Metric class constructor
+   return {
+      RegisterMetric<RmseRegressionMetric>("rmse"),
+      RegisterMetric<MaeRegressionMetric>("mae"),
+      RegisterMetric<LogLossBinaryMetric>("log_loss"),
+      RegisterMetric<LogLossMulticlassMetric>("log_loss"),
+      RegisterMetric<AucBinaryMetric>("auc"),
+   };
+}
@@ -6,10 +6,9 @@
 
 // TFloat could be double, float, or some SIMD intrinsic type
 template <typename TFloat>
-struct CrossEntropyMulticlassMultitaskObjective : public MulticlassMultitaskObjective {
+struct CrossEntropyMulticlassMultitaskObjective final : public MulticlassMultitaskObjective {
 
    // This is the most general format that I could envision we'd handle as a non-custom objective.
-   // It's not clear that we can really handle it nicely, but I'm leaving a placeholder here to think about it.  
    // An example of this might include a prediction problem having 2 targets, with the first target having 3 classes
    // and the second target having 4 classes.  In a higher level language this might be represented as two separate
    // models, or a single model that contains two targets.  We'd want to expose this externally as two tensors that
@@ -33,6 +32,9 @@ struct CrossEntropyMulticlassMultitaskObjective : public MulticlassMultitaskObje
    // and 4 classes, so our count of scores will be 7, but we'll want to pass through either 0 or 1 for the count
    // of scores that we pass to the templated TObjective functions since we don't want to use the templated hard-coded
    // compiler optimized count of outputs
+   //
+   // For now we only accept targets that all have the same number of classes.  Each target then owns a block of
+   // m_cClasses scores within the cell and we do the softmax per block.  The jagged case above is future work.
 
    // There's an even more general case of multi-task learning with the targets being a mix of 
    // regression, binary classification, and multiclass, but that would obviously require a custom objective.
@@ -43,4 +45,269 @@ struct CrossEntropyMulticlassMultitaskObjective : public MulticlassMultitaskObje
    // counts of scores, unlike this more general case that needs to be special cased since the last
    // array is a jagged one with different inner array sizes.
 
+   OBJECTIVE_CONSTANTS_BOILERPLATE(CrossEntropyMulticlassMultitaskObjective, MINIMIZE_METRIC, Link_logit)
+
+   size_t m_cClasses;
+   size_t m_cTasks;
+
+   inline CrossEntropyMulticlassMultitaskObjective(const Config & config) {
+      if(1 == config.cTasks || 1 == config.cOutputs) {
+         // we share the tag "log_loss" with the single task and binary multitask objectives
+         throw SkipRegistrationException();
+      }
+
+      if(config.cOutputs <= 0) {
+         throw ParamMismatchWithConfigException();
+      }
+
+      if(config.isDifferentiallyPrivate) {
+         throw NonPrivateRegistrationException();
+      }
+
+      m_cClasses = config.cOutputs;
+      m_cTasks = config.cTasks;
+   }
+
+   inline double LinkParam() const noexcept {
+      return std::numeric_limits<double>::quiet_NaN();
+   }
+
+   inline double LearningRateAdjustmentDifferentialPrivacy() const noexcept {
+      return 1.0; // typically leave this at 1.0 (unmodified)
+   }
+
+   inline double LearningRateAdjustmentGradientBoosting() const noexcept {
+      return 1.0; // typically leave this at 1.0 (unmodified)
+   }
+
+   inline double LearningRateAdjustmentHessianBoosting() const noexcept {
+      return 1.0; // typically leave this at 1.0 (unmodified)
+   }
+
+   inline double GainAdjustmentGradientBoosting() const noexcept {
+      return 1.0; // typically leave this at 1.0 (unmodified)
+   }
+
+   inline double GainAdjustmentHessianBoosting() const noexcept {
+      return 1.0; // typically leave this at 1.0 (unmodified)
+   }
+
+   inline double GradientConstant() const noexcept {
+      return 1.0;
+   }
+
+   inline double HessianConstant() const noexcept {
+      return 1.0;
+   }
+
+   inline double FinishMetric(const double metricSum) const noexcept {
+      // report the average log loss of the tasks so that it is comparable to the single task metric
+      return metricSum / static_cast<double>(m_cTasks);
+   }
+
+   GPU_DEVICE inline TFloat CalcMetric(const TFloat score, const TFloat target) const noexcept {
+      // This function is here to signal the CrossEntropyMulticlassMultitaskObjective class abilities, but it will not be called
+      UNUSED(score);
+      UNUSED(target);
+      return 0.0;
+   }
+
+   GPU_DEVICE inline TFloat CalcGradient(const TFloat score, const TFloat target) const noexcept {
+      // This function is here to signal the CrossEntropyMulticlassMultitaskObjective class abilities, but it will not be called
+      UNUSED(score);
+      UNUSED(target);
+      return 0.0;
+   }
+
+   GPU_DEVICE inline GradientHessian<TFloat> CalcGradientHessian(const TFloat score, const TFloat target) const noexcept {
+      // This function is here to signal the CrossEntropyMulticlassMultitaskObjective class abilities, but it will not be called
+      UNUSED(score);
+      UNUSED(target);
+      return GradientHessian<TFloat>(0.0, 0.0);
+   }
+
+   template<size_t cCompilerScores, ptrdiff_t cCompilerPack, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight>
+   GPU_DEVICE void InjectedApplyUpdate(ApplyUpdateBridge * const pData) const {
+      static_assert(k_dynamicScores == cCompilerScores, "MulticlassMultitaskObjective always uses the dynamic count of scores");
+
+      static constexpr bool bCompilerZeroDimensional = k_cItemsPerBitPackNone == cCompilerPack;
+      static constexpr bool bGetExp = bCalcMetric || bKeepGradHess;
+      static constexpr bool bGetTarget = bCalcMetric || bKeepGradHess;
+
+      FloatFast * aExps;
+      if(bGetExp) {
+         aExps = reinterpret_cast<FloatFast *>(pData->m_aMulticlassMidwayTemp);
+      }
+
+      const size_t cClasses = m_cClasses;
+      const size_t cTasks = m_cTasks;
+      const size_t cScores = pData->m_cScores;
+      EBM_ASSERT(cScores == cClasses * cTasks);
+
+      const FloatScore * const aUpdateTensorScores = reinterpret_cast<const FloatScore *>(pData->m_aUpdateTensorScores);
+
+      const size_t cSamples = pData->m_cSamples;
+
+      FloatScore * pSampleScore = reinterpret_cast<FloatScore *>(pData->m_aSampleScores);
+      const FloatScore * const pSampleScoresEnd = pSampleScore + cSamples * cScores;
+
+      size_t cBitsPerItemMax;
+      ptrdiff_t cShift;
+      ptrdiff_t cShiftReset;
+      size_t maskBits;
+      const StorageDataType * pInputData;
+
+      const FloatScore * aBinScores;
+
+      if(bCompilerZeroDimensional) {
+         aBinScores = aUpdateTensorScores;
+      } else {
+         const ptrdiff_t cPack = GET_ITEMS_PER_BIT_PACK(cCompilerPack, pData->m_cPack);
+
+         const size_t cItemsPerBitPack = static_cast<size_t>(cPack);
+
+         cBitsPerItemMax = GetCountBits<StorageDataType>(cItemsPerBitPack);
+
+         cShift = static_cast<ptrdiff_t>((cSamples - 1) % cItemsPerBitPack * cBitsPerItemMax);
+         cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - 1) * cBitsPerItemMax);
+
+         maskBits = static_cast<size_t>(MakeLowMask<StorageDataType>(cBitsPerItemMax));
+
+         pInputData = pData->m_aPacked;
+      }
+
+      const StorageDataType * pTargetData;
+      if(bGetTarget) {
+         pTargetData = reinterpret_cast<const StorageDataType *>(pData->m_aTargets);
+      }
+
+      FloatFast * pGradientAndHessian;
+      if(bKeepGradHess) {
+         pGradientAndHessian = reinterpret_cast<FloatFast *>(pData->m_aGradientsAndHessians);
+      }
+
+      const FloatFast * pWeight;
+      if(bWeight) {
+         pWeight = reinterpret_cast<const FloatFast *>(pData->m_aWeights);
+      }
+
+      FloatFast sumLogLoss;
+      if(bCalcMetric) {
+         sumLogLoss = 0;
+      }
+      do {
+         StorageDataType iTensorBinCombined;
+         if(!bCompilerZeroDimensional) {
+            // we store the already multiplied dimensional value in *pInputData
+            iTensorBinCombined = *pInputData;
+            ++pInputData;
+         }
+         while(true) {
+            if(!bCompilerZeroDimensional) {
+               const size_t iTensorBin = static_cast<size_t>(iTensorBinCombined >> cShift) & maskBits;
+               aBinScores = &aUpdateTensorScores[iTensorBin * cScores];
+            }
+
+            FloatFast weight;
+            if(bWeight) {
+               weight = *pWeight;
+               ++pWeight;
+            }
+
+            const FloatScore * pBinScore = aBinScores;
+            size_t iTask = 0;
+            do {
+               FloatFast sumExp;
+               if(bGetExp) {
+                  sumExp = 0;
+               }
+               size_t iScore1 = 0;
+               do {
+                  const FloatScore sampleScore = pSampleScore[iScore1] + pBinScore[iScore1];
+                  pSampleScore[iScore1] = sampleScore;
+
+                  if(bGetExp) {
+                     const FloatFast oneExp = static_cast<FloatFast>(ExpForMulticlass<false>(sampleScore));
+                     sumExp += oneExp;
+                     aExps[iScore1] = oneExp;
+                  }
+
+                  ++iScore1;
+               } while(cClasses != iScore1);
+
+               size_t targetData;
+               if(bGetTarget) {
+                  targetData = static_cast<size_t>(*pTargetData);
+                  ++pTargetData;
+               }
+
+               pSampleScore += cClasses;
+               pBinScore += cClasses;
+
+               if(bKeepGradHess) {
+                  const FloatFast sumExpInverted = FloatFast { 1 } / sumExp;
+
+                  size_t iScore2 = 0;
+                  do {
+                     FloatFast gradient;
+                     FloatFast hessian;
+                     EbmStats::InverseLinkFunctionThenCalculateGradientAndHessianMulticlassForNonTarget(
+                        sumExpInverted,
+                        aExps[iScore2],
+                        gradient,
+                        hessian
+                     );
+                     if(bWeight) {
+                        // This is only used during the initialization of interaction detection. For boosting
+                        // we currently multiply by the weight during bin summation instead since we use the weight
+                        // there to include the inner bagging counts of occurences.
+                        gradient *= weight;
+                        hessian *= weight;
+                     }
+                     pGradientAndHessian[iScore2 << 1] = gradient;
+                     pGradientAndHessian[(iScore2 << 1) + 1] = hessian;
+                     ++iScore2;
+                  } while(cClasses != iScore2);
+
+                  pGradientAndHessian[targetData << 1] = EbmStats::MulticlassFixTargetGradient(
+                     pGradientAndHessian[targetData << 1], bWeight ? weight : FloatFast { 1 });
+
+                  pGradientAndHessian += cClasses << 1;
+               }
+
+               if(bCalcMetric) {
+                  const FloatFast itemExp = aExps[targetData];
+
+                  FloatFast sampleLogLoss = EbmStats::ComputeSingleSampleLogLossMulticlass(sumExp, itemExp);
+
+                  if(bWeight) {
+                     sampleLogLoss *= weight;
+                  }
+                  sumLogLoss += sampleLogLoss;
+               }
+
+               ++iTask;
+            } while(cTasks != iTask);
+
+            if(bCompilerZeroDimensional) {
+               if(pSampleScoresEnd == pSampleScore) {
+                  break;
+               }
+            } else {
+               cShift -= cBitsPerItemMax;
+               if(cShift < 0) {
+                  break;
+               }
+            }
+         }
+         if(bCompilerZeroDimensional) {
+            break;
+         }
+         cShift = cShiftReset;
+      } while(pSampleScoresEnd != pSampleScore);
+
+      if(bCalcMetric) {
+         pData->m_metricOut = static_cast<double>(sumLogLoss);
+      }
+   }
 };
@@ -4,12 +4,229 @@
 
 // !! To add a new objective in C++ follow the steps at the top of the "objective_registrations.hpp" file !!
 
-// TFloat could be double, float, or some SIMD intrinsic type
-template <typename TFloat>
-struct LogLossBinaryMultitaskObjective : public BinaryMultitaskObjective {
+// Do not use this file as a reference for other objectives. LogLoss is special.
+
+template<typename TFloat>
+struct LogLossBinaryMultitaskObjective final : public BinaryMultitaskObjective {
    // this one would more popularily be called LogLossMultilabelObjective.  We're currently calling this
-   // LogLossBinaryMultitaskObjective since it fits better into our ontology of Multitask* types having 
+   // LogLossBinaryMultitaskObjective since it fits better into our ontology of Multitask* types having
    // multiple targets, but consider chaning this to multilabel since it would be more widely recognized that way
 
-   // this one needs to be special cased!
+   // Each task is an independent binary log loss with one score, so the scores, targets, gradients and hessians
+   // of the tasks are interleaved per sample.  Every task's update is applied in the same pass over the
+   // bit packed term data.
+
+   OBJECTIVE_CONSTANTS_BOILERPLATE(LogLossBinaryMultitaskObjective, MINIMIZE_METRIC, Link_logit)
+
+   size_t m_cTasks;
+
+   inline LogLossBinaryMultitaskObjective(const Config & config) {
+      if(1 == config.cTasks || 1 != config.cOutputs) {
+         // we share the tag "log_loss" with the single task and multiclass objectives
+         throw SkipRegistrationException();
+      }
+      m_cTasks = config.cTasks;
+   }
+
+   inline double LinkParam() const noexcept {
+      return std::numeric_limits<double>::quiet_NaN();
+   }
+
+   inline double LearningRateAdjustmentDifferentialPrivacy() const noexcept {
+      return 1.0; // typically leave this at 1.0 (unmodified)
+   }
+
+   inline double LearningRateAdjustmentGradientBoosting() const noexcept {
+      return 1.0; // typically leave this at 1.0 (unmodified)
+   }
+
+   inline double LearningRateAdjustmentHessianBoosting() const noexcept {
+      return 1.0; // typically leave this at 1.0 (unmodified)
+   }
+
+   inline double GainAdjustmentGradientBoosting() const noexcept {
+      return 1.0; // typically leave this at 1.0 (unmodified)
+   }
+
+   inline double GainAdjustmentHessianBoosting() const noexcept {
+      return 1.0; // typically leave this at 1.0 (unmodified)
+   }
+
+   inline double GradientConstant() const noexcept {
+      return 1.0;
+   }
+
+   inline double HessianConstant() const noexcept {
+      return 1.0;
+   }
+
+   inline double FinishMetric(const double metricSum) const noexcept {
+      // report the average log loss of the tasks so that it is comparable to the single task metric
+      return metricSum / static_cast<double>(m_cTasks);
+   }
+
+   GPU_DEVICE inline TFloat CalcMetric(const TFloat score, const TFloat target) const noexcept {
+      // This function is here to signal the LogLossBinaryMultitaskObjective class abilities, but it will not be called
+      UNUSED(score);
+      UNUSED(target);
+      return 0.0;
+   }
+
+   GPU_DEVICE inline TFloat CalcGradient(const TFloat score, const TFloat target) const noexcept {
+      // This function is here to signal the LogLossBinaryMultitaskObjective class abilities, but it will not be called
+      UNUSED(score);
+      UNUSED(target);
+      return 0.0;
+   }
+
+   GPU_DEVICE inline GradientHessian<TFloat> CalcGradientHessian(const TFloat score, const TFloat target) const noexcept {
+      // This function is here to signal the LogLossBinaryMultitaskObjective class abilities, but it will not be called
+      UNUSED(score);
+      UNUSED(target);
+      return GradientHessian<TFloat>(0.0, 0.0);
+   }
+
+   template<size_t cCompilerScores, ptrdiff_t cCompilerPack, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight>
+   GPU_DEVICE void InjectedApplyUpdate(ApplyUpdateBridge * const pData) const {
+      static constexpr bool bCompilerZeroDimensional = k_cItemsPerBitPackNone == cCompilerPack;
+      static constexpr bool bGetTarget = bCalcMetric || bKeepGradHess;
+
+      // there is one score per task
+      const size_t cScores = GET_COUNT_SCORES(cCompilerScores, pData->m_cScores);
+      EBM_ASSERT(cScores == m_cTasks);
+
+      const FloatScore * const aUpdateTensorScores = reinterpret_cast<const FloatScore *>(pData->m_aUpdateTensorScores);
+
+      const size_t cSamples = pData->m_cSamples;
+
+      FloatScore * pSampleScore = reinterpret_cast<FloatScore *>(pData->m_aSampleScores);
+      const FloatScore * const pSampleScoresEnd = pSampleScore + cSamples * cScores;
+
+      size_t cBitsPerItemMax;
+      ptrdiff_t cShift;
+      ptrdiff_t cShiftReset;
+      size_t maskBits;
+      const StorageDataType * pInputData;
+
+      const FloatScore * aBinScores;
+
+      if(bCompilerZeroDimensional) {
+         aBinScores = aUpdateTensorScores;
+      } else {
+         const ptrdiff_t cPack = GET_ITEMS_PER_BIT_PACK(cCompilerPack, pData->m_cPack);
+
+         const size_t cItemsPerBitPack = static_cast<size_t>(cPack);
+
+         cBitsPerItemMax = GetCountBits<StorageDataType>(cItemsPerBitPack);
+
+         cShift = static_cast<ptrdiff_t>((cSamples - 1) % cItemsPerBitPack * cBitsPerItemMax);
+         cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - 1) * cBitsPerItemMax);
+
+         maskBits = static_cast<size_t>(MakeLowMask<StorageDataType>(cBitsPerItemMax));
+
+         pInputData = pData->m_aPacked;
+      }
+
+      const StorageDataType * pTargetData;
+      if(bGetTarget) {
+         pTargetData = reinterpret_cast<const StorageDataType *>(pData->m_aTargets);
+      }
+
+      FloatFast * pGradientAndHessian;
+      if(bKeepGradHess) {
+         pGradientAndHessian = reinterpret_cast<FloatFast *>(pData->m_aGradientsAndHessians);
+      }
+
+      const FloatFast * pWeight;
+      if(bWeight) {
+         pWeight = reinterpret_cast<const FloatFast *>(pData->m_aWeights);
+      }
+
+      FloatFast sumLogLoss;
+      if(bCalcMetric) {
+         sumLogLoss = 0;
+      }
+      do {
+         StorageDataType iTensorBinCombined;
+         if(!bCompilerZeroDimensional) {
+            // we store the already multiplied dimensional value in *pInputData
+            iTensorBinCombined = *pInputData;
+            ++pInputData;
+         }
+         while(true) {
+            if(!bCompilerZeroDimensional) {
+               const size_t iTensorBin = static_cast<size_t>(iTensorBinCombined >> cShift) & maskBits;
+               aBinScores = &aUpdateTensorScores[iTensorBin * cScores];
+            }
+
+            FloatFast weight;
+            if(bWeight) {
+               weight = *pWeight;
+               ++pWeight;
+            }
+
+            size_t iScore = 0;
+            do {
+               size_t targetData;
+               if(bGetTarget) {
+                  targetData = static_cast<size_t>(pTargetData[iScore]);
+               }
+
+               const FloatScore sampleScore = pSampleScore[iScore] + aBinScores[iScore];
+               pSampleScore[iScore] = sampleScore;
+
+               if(bKeepGradHess) {
+                  FloatFast gradient = EbmStats::InverseLinkFunctionThenCalculateGradientBinaryClassification(sampleScore, targetData);
+                  FloatFast hessian = EbmStats::CalculateHessianFromGradientBinaryClassification(gradient);
+                  if(bWeight) {
+                     // This is only used during the initialization of interaction detection. For boosting
+                     // we currently multiply by the weight during bin summation instead since we use the weight
+                     // there to include the inner bagging counts of occurences.
+                     gradient *= weight;
+                     hessian *= weight;
+                  }
+                  pGradientAndHessian[iScore << 1] = gradient;
+                  pGradientAndHessian[(iScore << 1) + 1] = hessian;
+               }
+
+               if(bCalcMetric) {
+                  FloatFast sampleLogLoss = EbmStats::ComputeSingleSampleLogLossBinaryClassification(sampleScore, targetData);
+                  if(bWeight) {
+                     sampleLogLoss *= weight;
+                  }
+                  sumLogLoss += sampleLogLoss;
+               }
+
+               ++iScore;
+            } while(cScores != iScore);
+
+            pSampleScore += cScores;
+            if(bGetTarget) {
+               pTargetData += cScores;
+            }
+            if(bKeepGradHess) {
+               pGradientAndHessian += cScores << 1;
+            }
+
+            if(bCompilerZeroDimensional) {
+               if(pSampleScoresEnd == pSampleScore) {
+                  break;
+               }
+            } else {
+               cShift -= cBitsPerItemMax;
+               if(cShift < 0) {
+                  break;
+               }
+            }
+         }
+         if(bCompilerZeroDimensional) {
+            break;
+         }
+         cShift = cShiftReset;
+      } while(pSampleScoresEnd != pSampleScore);
+
+      if(bCalcMetric) {
+         pData->m_metricOut = static_cast<double>(sumLogLoss);
+      }
+   }
 };
@@ -53,37 +53,50 @@ struct LogLossBinaryObjective final : public BinaryObjective {
       return metricSum;
    }
 
+   // The scalar zones use the hand written InjectedApplyUpdate below, but SIMD zones go through the generic
+   // ChildApplyUpdate which calls these.  The vector approximate exp/log match the scalar ones lane for lane, and 
+   // the remaining operations are exact (negation, abs) or correctly rounded, so every zone gets identical results.
+
    GPU_DEVICE inline TFloat CalcMetric(const TFloat score, const TFloat target) const noexcept {
-      // This function is here to signal the LogLossBinaryObjective class abilities, but it will not be called
-      UNUSED(score);
-      UNUSED(target);
+      // target is either 0.0 or 1.0
+      const TFloat exponent = IfLess(target, 0.5, score, -score);
+      return LogForLogLoss<false>(1.0 + ExpForBinaryClassification<false>(exponent));
    }
 
    GPU_DEVICE inline TFloat CalcGradient(const TFloat score, const TFloat target) const noexcept {
-      // This function is here to signal the LogLossBinaryObjective class abilities, but it will not be called
-      UNUSED(score);
-      UNUSED(target);
-      return 0.0;
+      // target is either 0.0 or 1.0
+      const TFloat numerator = IfLess(target, 0.5, 1.0, -1.0);
+      const TFloat exponent = IfLess(target, 0.5, -score, score);
+      const TFloat denominator = 1.0 + ExpForBinaryClassification<false>(exponent);
+      return numerator / denominator;
    }
 
    GPU_DEVICE inline GradientHessian<TFloat> CalcGradientHessian(const TFloat score, const TFloat target) const noexcept {
-      // This function is here to signal the LogLossBinaryObjective class abilities, but it will not be called
-      UNUSED(score);
-      UNUSED(target);
-      return GradientHessian<TFloat>(0.0, 0.0);
+      const TFloat gradient = CalcGradient(score, target);
+      const TFloat absGradient = IfLess(gradient, 0.0, -gradient, gradient);
+      const TFloat hessian = absGradient * (1.0 - absGradient);
+      return MakeGradientHessian(gradient, hessian);
+   }
+
+   template<size_t cCompilerScores, ptrdiff_t cCompilerPack, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight, 
+      typename T = void, typename std::enable_if<1 != TFloat::cPack, T>::type * = nullptr>
+   GPU_DEVICE void InjectedApplyUpdate(ApplyUpdateBridge * const pData) const {
+      Objective::ChildApplyUpdate<typename std::remove_pointer<decltype(this)>::type, TFloat,
+         cCompilerScores, cCompilerPack, bHessian, bKeepGradHess, bCalcMetric, bWeight>(pData);
    }
 
-   template<size_t cCompilerScores, ptrdiff_t cCompilerPack, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight>
+   template<size_t cCompilerScores, ptrdiff_t cCompilerPack, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight, 
+      typename T = void, typename std::enable_if<1 == TFloat::cPack, T>::type * = nullptr>
    GPU_DEVICE void InjectedApplyUpdate(ApplyUpdateBridge * const pData) const {
       static constexpr bool bCompilerZeroDimensional = k_cItemsPerBitPackNone == cCompilerPack;
       static constexpr bool bGetTarget = bCalcMetric || bKeepGradHess;
 
-      const FloatFast * const aUpdateTensorScores = reinterpret_cast<const FloatFast *>(pData->m_aUpdateTensorScores);
+      const FloatScore * const aUpdateTensorScores = reinterpret_cast<const FloatScore *>(pData->m_aUpdateTensorScores);
 
       const size_t cSamples = pData->m_cSamples;
 
-      FloatFast * pSampleScore = reinterpret_cast<FloatFast *>(pData->m_aSampleScores);
-      const FloatFast * const pSampleScoresEnd = pSampleScore + cSamples;
+      FloatScore * pSampleScore = reinterpret_cast<FloatScore *>(pData->m_aSampleScores);
+      const FloatScore * const pSampleScoresEnd = pSampleScore + cSamples;
 
       size_t cBitsPerItemMax;
       ptrdiff_t cShift;
@@ -91,7 +104,7 @@ struct LogLossBinaryObjective final : public BinaryObjective {
       size_t maskBits;
       const StorageDataType * pInputData;
 
-      FloatFast updateScore;
+      FloatScore updateScore;
 
       if(bCompilerZeroDimensional) {
          updateScore = aUpdateTensorScores[0];
@@ -148,7 +161,7 @@ struct LogLossBinaryObjective final : public BinaryObjective {
                ++pTargetData;
             }
 
-            const FloatFast sampleScore = *pSampleScore + updateScore;
+            const FloatScore sampleScore = *pSampleScore + updateScore;
             *pSampleScore = sampleScore;
             ++pSampleScore;
 
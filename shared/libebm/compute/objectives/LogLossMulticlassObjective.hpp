@@ -83,10 +83,14 @@ struct LogLossMulticlassObjective final : public MulticlassObjective {
 
    template<size_t cCompilerScores, ptrdiff_t cCompilerPack, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight>
    GPU_DEVICE void InjectedApplyUpdate(ApplyUpdateBridge * const pData) const {
+      // the SIMD zones interleave their bit packs across TFloat::cPack lanes, so we unpack the bins of up to
+      // TFloat::cPack samples at a time and then go through those samples in order
+
       static constexpr bool bDynamic = k_dynamicScores == cCompilerScores;
       static constexpr bool bCompilerZeroDimensional = k_cItemsPerBitPackNone == cCompilerPack;
       static constexpr bool bGetExp = bCalcMetric || bKeepGradHess;
       static constexpr bool bGetTarget = bCalcMetric || bKeepGradHess;
+      static constexpr size_t cSIMDPack = static_cast<size_t>(TFloat::cPack);
 
       FloatFast aLocalExpVector[bDynamic ? size_t { 1 } : cCompilerScores];
       FloatFast * aExps;
@@ -100,37 +104,22 @@ struct LogLossMulticlassObjective final : public MulticlassObjective {
 
       const size_t cScores = GET_COUNT_SCORES(cCompilerScores, pData->m_cScores);
 
-      const FloatFast * const aUpdateTensorScores = reinterpret_cast<const FloatFast *>(pData->m_aUpdateTensorScores);
+      const FloatScore * const aUpdateTensorScores = reinterpret_cast<const FloatScore *>(pData->m_aUpdateTensorScores);
 
       const size_t cSamples = pData->m_cSamples;
+      EBM_ASSERT(1 <= cSamples);
 
-      FloatFast * pSampleScore = reinterpret_cast<FloatFast *>(pData->m_aSampleScores);
-      const FloatFast * const pSampleScoresEnd = pSampleScore + cSamples * cScores;
-
-      size_t cBitsPerItemMax;
-      ptrdiff_t cShift;
-      ptrdiff_t cShiftReset;
-      size_t maskBits;
-      const StorageDataType * pInputData;
+      FloatScore * pSampleScore = reinterpret_cast<FloatScore *>(pData->m_aSampleScores);
 
-      FloatFast updateScore;
-      const FloatFast * aBinScores;
+      FloatScore updateScore;
+      const FloatScore * aBinScores;
 
+      SimdBitPackReader<TFloat> reader;
       if(bCompilerZeroDimensional) {
          aBinScores = aUpdateTensorScores;
       } else {
          const ptrdiff_t cPack = GET_ITEMS_PER_BIT_PACK(cCompilerPack, pData->m_cPack);
-
-         const size_t cItemsPerBitPack = static_cast<size_t>(cPack);
-
-         cBitsPerItemMax = GetCountBits<StorageDataType>(cItemsPerBitPack);
-
-         cShift = static_cast<ptrdiff_t>((cSamples - 1) % cItemsPerBitPack * cBitsPerItemMax);
-         cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - 1) * cBitsPerItemMax);
-
-         maskBits = static_cast<size_t>(MakeLowMask<StorageDataType>(cBitsPerItemMax));
-
-         pInputData = pData->m_aPacked;
+         reader.Init(pData->m_aPacked, cSamples, static_cast<size_t>(cPack));
       }
 
       const StorageDataType * pTargetData;
@@ -148,21 +137,25 @@ struct LogLossMulticlassObjective final : public MulticlassObjective {
          pWeight = reinterpret_cast<const FloatFast *>(pData->m_aWeights);
       }
 
+      size_t aiTensorBins[cSIMDPack];
+
       FloatFast sumLogLoss;
       if(bCalcMetric) {
          sumLogLoss = 0;
       }
+      size_t cSamplesRemaining = cSamples;
       do {
-         StorageDataType iTensorBinCombined;
+         size_t cLanes = cSIMDPack < cSamplesRemaining ? cSIMDPack : cSamplesRemaining;
          if(!bCompilerZeroDimensional) {
-            // we store the already multiplied dimensional value in *pInputData
-            iTensorBinCombined = *pInputData;
-            ++pInputData;
+            cLanes = reader.CountLanes(cLanes);
+            reader.NextBins(aiTensorBins, cLanes);
          }
-         while(true) {
+         cSamplesRemaining -= cLanes;
+
+         size_t iLane = 0;
+         do {
             if(!bCompilerZeroDimensional) {
-               const size_t iTensorBin = static_cast<size_t>(iTensorBinCombined >> cShift) & maskBits;
-               aBinScores = &aUpdateTensorScores[iTensorBin * cScores];
+               aBinScores = &aUpdateTensorScores[aiTensorBins[iLane] * cScores];
             }
 
             FloatFast sumExp;
@@ -173,11 +166,11 @@ struct LogLossMulticlassObjective final : public MulticlassObjective {
             do {
                updateScore = aBinScores[iScore1];
 
-               const FloatFast sampleScore = pSampleScore[iScore1] + updateScore;
+               const FloatScore sampleScore = pSampleScore[iScore1] + updateScore;
                pSampleScore[iScore1] = sampleScore;
 
                if(bGetExp) {
-                  const FloatFast oneExp = ExpForMulticlass<false>(sampleScore);
+                  const FloatFast oneExp = static_cast<FloatFast>(ExpForMulticlass<false>(sampleScore));
                   sumExp += oneExp;
                   aExps[iScore1] = oneExp;
                }
@@ -243,22 +236,9 @@ struct LogLossMulticlassObjective final : public MulticlassObjective {
                sumLogLoss += sampleLogLoss;
             }
 
-            if(bCompilerZeroDimensional) {
-               if(pSampleScoresEnd == pSampleScore) {
-                  break;
-               }
-            } else {
-               cShift -= cBitsPerItemMax;
-               if(cShift < 0) {
-                  break;
-               }
-            }
-         }
-         if(bCompilerZeroDimensional) {
-            break;
-         }
-         cShift = cShiftReset;
-      } while(pSampleScoresEnd != pSampleScore);
+            ++iLane;
+         } while(cLanes != iLane);
+      } while(size_t { 0 } != cSamplesRemaining);
 
       if(bCalcMetric) {
          pData->m_metricOut = static_cast<double>(sumLogLoss);
@@ -4,8 +4,221 @@
 
 // !! To add a new objective in C++ follow the steps at the top of the "objective_registrations.hpp" file !!
 
-// TFloat could be double, float, or some SIMD intrinsic type
-template <typename TFloat>
-struct RmseRegressionMultitaskObjective : public RegressionMultitaskObjective {
-   // this one needs to be special cased!
+// Do not use this file as a reference for other objectives. RMSE is special.
+
+template<typename TFloat>
+struct RmseRegressionMultitaskObjective final : public RegressionMultitaskObjective {
+   // RmseRegressionObjective only keeps the residuals of its single target.  With multiple tasks we keep the scores
+   // and targets like the other objectives and recompute each task's residual as the scores are updated, which lets
+   // every task share a single pass over the bit packed term data.  The constants match RmseRegressionObjective.
+
+   OBJECTIVE_CONSTANTS_BOILERPLATE(RmseRegressionMultitaskObjective, MINIMIZE_METRIC, Link_identity)
+
+   size_t m_cTasks;
+
+   inline RmseRegressionMultitaskObjective(const Config & config) {
+      if(1 == config.cTasks) {
+         // we share the tag "rmse" with the single task objective
+         throw SkipRegistrationException();
+      }
+      if(1 != config.cOutputs) {
+         throw ParamMismatchWithConfigException();
+      }
+      m_cTasks = config.cTasks;
+   }
+
+   inline bool CheckRegressionTarget(const double target) const noexcept {
+      return std::isnan(target) || std::isinf(target);
+   }
+
+   inline double LinkParam() const noexcept {
+      return std::numeric_limits<double>::quiet_NaN();
+   }
+
+   inline double LearningRateAdjustmentDifferentialPrivacy() const noexcept {
+      // WARNING: do not change this rate without accounting for it in the privacy budget!
+      return 0.5;
+   }
+
+   inline double LearningRateAdjustmentGradientBoosting() const noexcept {
+      return 0.5;
+   }
+
+   inline double LearningRateAdjustmentHessianBoosting() const noexcept {
+      return 1.0;
+   }
+
+   inline double GainAdjustmentGradientBoosting() const noexcept {
+      return 0.5;
+   }
+
+   inline double GainAdjustmentHessianBoosting() const noexcept {
+      return 1.0;
+   }
+
+   inline double GradientConstant() const noexcept {
+      return 2.0;
+   }
+
+   inline double HessianConstant() const noexcept {
+      return 2.0;
+   }
+
+   inline double FinishMetric(const double metricSum) const noexcept {
+      // like RmseRegressionObjective this is the mse, averaged over the tasks
+      return metricSum / static_cast<double>(m_cTasks);
+   }
+
+   GPU_DEVICE inline TFloat CalcMetric(const TFloat score, const TFloat target) const noexcept {
+      // This function is here to signal the RmseRegressionMultitaskObjective class abilities, but it will not be called
+      UNUSED(score);
+      UNUSED(target);
+      return 0.0;
+   }
+
+   GPU_DEVICE inline TFloat CalcGradient(const TFloat score, const TFloat target) const noexcept {
+      // This function is here to signal the RmseRegressionMultitaskObjective class abilities, but it will not be called
+      UNUSED(score);
+      UNUSED(target);
+      return 0.0;
+   }
+
+   template<size_t cCompilerScores, ptrdiff_t cCompilerPack, bool bHessian, bool bKeepGradHess, bool bCalcMetric, bool bWeight>
+   GPU_DEVICE void InjectedApplyUpdate(ApplyUpdateBridge * const pData) const {
+      static_assert(!bHessian, "RMSE has a constant hessian, so we only keep the gradients");
+
+      static constexpr bool bCompilerZeroDimensional = k_cItemsPerBitPackNone == cCompilerPack;
+      static constexpr bool bGetTarget = bCalcMetric || bKeepGradHess;
+
+      // there is one score per task
+      const size_t cScores = GET_COUNT_SCORES(cCompilerScores, pData->m_cScores);
+      EBM_ASSERT(cScores == m_cTasks);
+
+      const FloatScore * const aUpdateTensorScores = reinterpret_cast<const FloatScore *>(pData->m_aUpdateTensorScores);
+
+      const size_t cSamples = pData->m_cSamples;
+
+      FloatScore * pSampleScore = reinterpret_cast<FloatScore *>(pData->m_aSampleScores);
+      const FloatScore * const pSampleScoresEnd = pSampleScore + cSamples * cScores;
+
+      size_t cBitsPerItemMax;
+      ptrdiff_t cShift;
+      ptrdiff_t cShiftReset;
+      size_t maskBits;
+      const StorageDataType * pInputData;
+
+      const FloatScore * aBinScores;
+
+      if(bCompilerZeroDimensional) {
+         aBinScores = aUpdateTensorScores;
+      } else {
+         const ptrdiff_t cPack = GET_ITEMS_PER_BIT_PACK(cCompilerPack, pData->m_cPack);
+
+         const size_t cItemsPerBitPack = static_cast<size_t>(cPack);
+
+         cBitsPerItemMax = GetCountBits<StorageDataType>(cItemsPerBitPack);
+
+         cShift = static_cast<ptrdiff_t>((cSamples - 1) % cItemsPerBitPack * cBitsPerItemMax);
+         cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - 1) * cBitsPerItemMax);
+
+         maskBits = static_cast<size_t>(MakeLowMask<StorageDataType>(cBitsPerItemMax));
+
+         pInputData = pData->m_aPacked;
+      }
+
+      const FloatFast * pTargetData;
+      if(bGetTarget) {
+         pTargetData = reinterpret_cast<const FloatFast *>(pData->m_aTargets);
+      }
+
+      FloatFast * pGradient;
+      if(bKeepGradHess) {
+         pGradient = reinterpret_cast<FloatFast *>(pData->m_aGradientsAndHessians); // no hessians for regression
+      }
+
+      const FloatFast * pWeight;
+      if(bWeight) {
+         pWeight = reinterpret_cast<const FloatFast *>(pData->m_aWeights);
+      }
+
+      FloatFast sumSquareError;
+      if(bCalcMetric) {
+         sumSquareError = 0;
+      }
+      do {
+         StorageDataType iTensorBinCombined;
+         if(!bCompilerZeroDimensional) {
+            // we store the already multiplied dimensional value in *pInputData
+            iTensorBinCombined = *pInputData;
+            ++pInputData;
+         }
+         while(true) {
+            if(!bCompilerZeroDimensional) {
+               const size_t iTensorBin = static_cast<size_t>(iTensorBinCombined >> cShift) & maskBits;
+               aBinScores = &aUpdateTensorScores[iTensorBin * cScores];
+            }
+
+            FloatFast weight;
+            if(bWeight) {
+               weight = *pWeight;
+               ++pWeight;
+            }
+
+            size_t iScore = 0;
+            do {
+               const FloatScore sampleScore = pSampleScore[iScore] + aBinScores[iScore];
+               pSampleScore[iScore] = sampleScore;
+
+               if(bGetTarget) {
+                  // for RMSE the gradient is the residual
+                  const FloatFast gradient = static_cast<FloatFast>(sampleScore - static_cast<FloatScore>(pTargetData[iScore]));
+
+                  if(bKeepGradHess) {
+                     // This is only used during the initialization of interaction detection. For boosting
+                     // we currently multiply by the weight during bin summation instead since we use the weight
+                     // there to include the inner bagging counts of occurences.
+                     pGradient[iScore] = bWeight ? gradient * weight : gradient;
+                  }
+
+                  if(bCalcMetric) {
+                     FloatFast sampleSquaredError = EbmStats::ComputeSingleSampleSquaredErrorRegressionFromGradient(gradient);
+                     if(bWeight) {
+                        sampleSquaredError *= weight;
+                     }
+                     sumSquareError += sampleSquaredError;
+                  }
+               }
+
+               ++iScore;
+            } while(cScores != iScore);
+
+            pSampleScore += cScores;
+            if(bGetTarget) {
+               pTargetData += cScores;
+            }
+            if(bKeepGradHess) {
+               pGradient += cScores;
+            }
+
+            if(bCompilerZeroDimensional) {
+               if(pSampleScoresEnd == pSampleScore) {
+                  break;
+               }
+            } else {
+               cShift -= cBitsPerItemMax;
+               if(cShift < 0) {
+                  break;
+               }
+            }
+         }
+         if(bCompilerZeroDimensional) {
+            break;
+         }
+         cShift = cShiftReset;
+      } while(pSampleScoresEnd != pSampleScore);
+
+      if(bCalcMetric) {
+         pData->m_metricOut = static_cast<double>(sumSquareError);
+      }
+   }
 };
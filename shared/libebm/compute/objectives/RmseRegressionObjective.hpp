@@ -113,7 +113,7 @@ public:
 
       static constexpr bool bCompilerZeroDimensional = k_cItemsPerBitPackNone == cCompilerPack;
 
-      const FloatFast * const aUpdateTensorScores = reinterpret_cast<const FloatFast *>(pData->m_aUpdateTensorScores);
+      const FloatScore * const aUpdateTensorScores = reinterpret_cast<const FloatScore *>(pData->m_aUpdateTensorScores);
 
       const size_t cSamples = pData->m_cSamples;
 
@@ -126,7 +126,7 @@ public:
       size_t maskBits;
       const StorageDataType * pInputData;
 
-      FloatFast updateScore;
+      FloatScore updateScore;
 
       if(bCompilerZeroDimensional) {
          updateScore = aUpdateTensorScores[0];
@@ -173,7 +173,8 @@ public:
             // do it but it would require a division. A better way would be to have two FloatFast arrays: a 
             // non-weight adjusted one and a weight adjusted one for when inner bags are used
             // NOTE: For interactions we can and do put the weight into the gradient because we never update it
-            const FloatFast gradient = EbmStats::ComputeGradientRegressionRmseFromOriginalGradient(*pGradient) + updateScore;
+            const FloatFast gradient = static_cast<FloatFast>(
+               static_cast<FloatScore>(EbmStats::ComputeGradientRegressionRmseFromOriginalGradient(*pGradient)) + updateScore);
             *pGradient = gradient;
             ++pGradient;
 
@@ -33,18 +33,26 @@
 #include "PseudoHuberRegressionObjective.hpp"
 #include "LogLossBinaryObjective.hpp"
 #include "LogLossMulticlassObjective.hpp"
+#include "RmseRegressionMultitaskObjective.hpp"
+#include "LogLossBinaryMultitaskObjective.hpp"
+#include "CrossEntropyMulticlassMultitaskObjective.hpp"
 
 // Add new *Objective type registrations to this list:
 static const std::vector<std::shared_ptr<const Registration>> RegisterObjectives() {
    // IMPORTANT: the parameter types listed here must match the parameters types in the Objective class constructor
    return {
       RegisterObjective<ExampleRegressionObjective>("example", FloatParam("param0", 0.0), FloatParam("param1", 1.0)),
+      // the multitask objectives skip registration when there is only one target, so they need to be ahead of
+      // the single task objectives that share their names
+      RegisterObjective<RmseRegressionMultitaskObjective>("rmse"),
       RegisterObjective<RmseRegressionObjective>("rmse"),
       RegisterObjective<RmseLogLinkRegressionObjective>("rmse_log"),
       RegisterObjective<PoissonDevianceRegressionObjective>("poisson_deviance"),
       RegisterObjective<TweedieDevianceRegressionObjective>("tweedie_deviance", FloatParam("variance_power", 1.5)),
       RegisterObjective<GammaDevianceRegressionObjective>("gamma_deviance"),
       RegisterObjective<PseudoHuberRegressionObjective>("pseudo_huber", FloatParam("delta", 1.0)),
+      RegisterObjective<LogLossBinaryMultitaskObjective>("log_loss"),
+      RegisterObjective<CrossEntropyMulticlassMultitaskObjective>("log_loss"),
       RegisterObjective<LogLossBinaryObjective>("log_loss"),
       RegisterObjective<LogLossMulticlassObjective>("log_loss"),
    };
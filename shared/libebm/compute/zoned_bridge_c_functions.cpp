@@ -24,6 +24,7 @@ namespace DEFINED_ZONE_NAME {
 #endif // DEFINED_ZONE_NAME
 
 struct Objective;
+struct Metric;
 
 INTERNAL_IMPORT_EXPORT_BODY ErrorEbm MAKE_ZONED_C_FUNCTION_NAME(ApplyUpdate) (
    const ObjectiveWrapper * const pObjectiveWrapper,
@@ -35,6 +36,16 @@ INTERNAL_IMPORT_EXPORT_BODY ErrorEbm MAKE_ZONED_C_FUNCTION_NAME(ApplyUpdate) (
    return (*pApplyUpdateCpp)(pObjective, pData);
 }
 
+INTERNAL_IMPORT_EXPORT_BODY ErrorEbm MAKE_ZONED_C_FUNCTION_NAME(CalcMetric) (
+   const MetricWrapper * const pMetricWrapper,
+   MetricBridge * const pData
+) {
+   const Metric * const pMetric = static_cast<const Metric *>(pMetricWrapper->m_pMetric);
+   const CALC_METRIC_CPP pCalcMetricCpp =
+      (static_cast<const MetricFunctionPointersCpp *>(pMetricWrapper->m_pFunctionPointersCpp))->m_pCalcMetricCpp;
+   return (*pCalcMetricCpp)(pMetric, pData);
+}
+
 #ifdef ZONE_cpu
 INTERNAL_IMPORT_EXPORT_BODY double MAKE_ZONED_C_FUNCTION_NAME(FinishMetric) (
    const ObjectiveWrapper * const pObjectiveWrapper,
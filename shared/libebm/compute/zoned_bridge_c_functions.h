@@ -18,6 +18,11 @@ INTERNAL_IMPORT_EXPORT_INCLUDE ErrorEbm MAKE_ZONED_C_FUNCTION_NAME(ApplyUpdate)(
    ApplyUpdateBridge * const pData
 );
 
+INTERNAL_IMPORT_EXPORT_INCLUDE ErrorEbm MAKE_ZONED_C_FUNCTION_NAME(CalcMetric)(
+   const MetricWrapper * const pMetricWrapper,
+   MetricBridge * const pData
+);
+
 #ifdef ZONE_cpu
 INTERNAL_IMPORT_EXPORT_INCLUDE double MAKE_ZONED_C_FUNCTION_NAME(FinishMetric) (
    const ObjectiveWrapper * const pObjectiveWrapper,
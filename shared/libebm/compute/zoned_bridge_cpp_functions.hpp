@@ -9,6 +9,7 @@
 #include "zones.h"
 
 struct ApplyUpdateBridge;
+struct MetricBridge;
 
 namespace DEFINED_ZONE_NAME {
 #ifndef DEFINED_ZONE_NAME
@@ -16,6 +17,7 @@ namespace DEFINED_ZONE_NAME {
 #endif // DEFINED_ZONE_NAME
 
 struct Objective;
+struct Metric;
 
 // these are going to be extern "C++", which we require to call our static member functions per:
 // https://www.drdobbs.com/c-theory-and-practice/184403437
@@ -33,6 +35,13 @@ struct FunctionPointersCpp {
    CHECK_TARGETS_CPP m_pCheckTargetsCpp;
 };
 
+typedef ErrorEbm (* CALC_METRIC_CPP)(const Metric * const pMetric, MetricBridge * const pData);
+
+struct MetricFunctionPointersCpp {
+   // kept separate from FunctionPointersCpp for the same reason that MetricWrapper is separate from ObjectiveWrapper
+   CALC_METRIC_CPP m_pCalcMetricCpp;
+};
+
 } // DEFINED_ZONE_NAME
 
 #endif // ZONED_BRIDGE_CPP_FUNCTIONS_HPP
@@ -6,11 +6,20 @@
 #define COMPUTE_ACCESSORS_HPP
 
 #include <stddef.h> // size_t, ptrdiff_t
+#include <stdlib.h> // getenv, malloc, free
+
+#if defined(BRIDGE_AVX2_64) || defined(BRIDGE_AVX512F_64)
+#ifdef _MSC_VER
+#include <intrin.h> // __cpuid, __cpuidex, _xgetbv
+#else // _MSC_VER
+#include <cpuid.h> // __get_cpuid_max, __cpuid_count
+#endif // _MSC_VER
+#endif // BRIDGE_AVX2_64 || BRIDGE_AVX512F_64
 
 #include "libebm.h" // ErrorEbm
 #include "logging.h" // EBM_ASSERT
 #include "common_c.h"
-#include "bridge_c.h" // CreateObjective_*
+#include "bridge_c.h" // CreateObjective_*, CreateMetric_*
 #include "zones.h"
 
 #include "common_cpp.hpp" // INLINE_RELEASE_UNTEMPLATED
@@ -20,15 +29,137 @@ namespace DEFINED_ZONE_NAME {
 #error DEFINED_ZONE_NAME must be defined
 #endif // DEFINED_ZONE_NAME
 
+// the compute zones that we can dispatch to, ordered from narrowest to widest
+static constexpr int k_zoneCpu = 0;
+static constexpr int k_zoneAvx2 = 1;
+static constexpr int k_zoneAvx512f = 2;
+
+INLINE_RELEASE_UNTEMPLATED static int DetectWidestZone() noexcept {
+#if defined(BRIDGE_AVX2_64) || defined(BRIDGE_AVX512F_64)
+   unsigned int ecx1;
+   unsigned int ebx7;
+   unsigned long long xcr0;
+#ifdef _MSC_VER
+   int aRegisters[4];
+   __cpuid(aRegisters, 0);
+   if(aRegisters[0] < 7) {
+      return k_zoneCpu;
+   }
+   __cpuid(aRegisters, 1);
+   ecx1 = static_cast<unsigned int>(aRegisters[2]);
+   __cpuidex(aRegisters, 7, 0);
+   ebx7 = static_cast<unsigned int>(aRegisters[1]);
+#else // _MSC_VER
+   if(__get_cpuid_max(0, nullptr) < 7) {
+      return k_zoneCpu;
+   }
+   unsigned int eax;
+   unsigned int ebx;
+   unsigned int ecx;
+   unsigned int edx;
+   __cpuid_count(1, 0, eax, ebx, ecx, edx);
+   ecx1 = ecx;
+   __cpuid_count(7, 0, eax, ebx, ecx, edx);
+   ebx7 = ebx;
+#endif // _MSC_VER
+
+   // the CPU supporting AVX is not enough.  The OS also needs to save the wider registers on context switches, 
+   // which it signals through OSXSAVE and the XCR0 register
+   static constexpr unsigned int k_osxsaveAndAvx = (1u << 27) | (1u << 28);
+   if(k_osxsaveAndAvx != (ecx1 & k_osxsaveAndAvx)) {
+      return k_zoneCpu;
+   }
+#ifdef _MSC_VER
+   xcr0 = static_cast<unsigned long long>(_xgetbv(0));
+#else // _MSC_VER
+   unsigned int xcr0Low;
+   unsigned int xcr0High;
+   __asm__ __volatile__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+   xcr0 = static_cast<unsigned long long>(xcr0High) << 32 | static_cast<unsigned long long>(xcr0Low);
+#endif // _MSC_VER
+
+   // XMM and YMM state
+   static constexpr unsigned long long k_xcr0Avx = 0x06;
+   if(k_xcr0Avx != (xcr0 & k_xcr0Avx)) {
+      return k_zoneCpu;
+   }
+
+   int zone = k_zoneCpu;
+#ifdef BRIDGE_AVX2_64
+   if(0 != (ebx7 & (1u << 5))) {
+      zone = k_zoneAvx2;
+   }
+#endif // BRIDGE_AVX2_64
+#ifdef BRIDGE_AVX512F_64
+   // XMM, YMM, opmask, upper ZMM of the first 16 registers, and ZMM16-31 state
+   static constexpr unsigned long long k_xcr0Avx512 = 0xE6;
+   if(0 != (ebx7 & (1u << 16)) && k_xcr0Avx512 == (xcr0 & k_xcr0Avx512)) {
+      zone = k_zoneAvx512f;
+   }
+#endif // BRIDGE_AVX512F_64
+   return zone;
+#else // BRIDGE_AVX2_64 || BRIDGE_AVX512F_64
+   return k_zoneCpu;
+#endif // BRIDGE_AVX2_64 || BRIDGE_AVX512F_64
+}
+
+INLINE_RELEASE_UNTEMPLATED static int GetComputeZone() noexcept {
+   const int zoneWidest = DetectWidestZone();
+
+   // The LIBEBM_ZONE environment variable can force a specific zone, which is useful for benchmarking and
+   // for checking that the zones agree.  We never go wider than what the CPU supports.
+   WARNING_PUSH
+   WARNING_DISABLE_DEPRECATED_FUNCTION // getenv is fine since we do not hold onto the pointer
+   const char * sZone = getenv("LIBEBM_ZONE");
+   WARNING_POP
+   if(nullptr == sZone) {
+      return zoneWidest;
+   }
+   sZone = SkipWhitespace(sZone);
+   if('\0' == *sZone) {
+      return zoneWidest;
+   }
+
+   int zone;
+   const char * sZoneEnd;
+   if(nullptr != (sZoneEnd = IsStringEqualsCaseInsensitive(sZone, "cpu"))) {
+      zone = k_zoneCpu;
+   } else if(nullptr != (sZoneEnd = IsStringEqualsCaseInsensitive(sZone, "avx2"))) {
+      zone = k_zoneAvx2;
+   } else if(nullptr != (sZoneEnd = IsStringEqualsCaseInsensitive(sZone, "avx512f"))) {
+      zone = k_zoneAvx512f;
+   } else {
+      LOG_N(Trace_Warning, "WARNING GetComputeZone unrecognized LIBEBM_ZONE value %s", sZone);
+      return zoneWidest;
+   }
+   if('\0' != *SkipWhitespace(sZoneEnd)) {
+      LOG_N(Trace_Warning, "WARNING GetComputeZone unrecognized LIBEBM_ZONE value %s", sZone);
+      return zoneWidest;
+   }
+
+   if(zoneWidest < zone) {
+      LOG_N(Trace_Warning, "WARNING GetComputeZone LIBEBM_ZONE value %s is not supported on this machine", sZone);
+      return zoneWidest;
+   }
+   return zone;
+}
+
 INLINE_RELEASE_UNTEMPLATED static ErrorEbm GetObjective(
    const Config * const pConfig,
    const char * sObjective,
-   ObjectiveWrapper * const pObjectiveWrapperOut
+   ObjectiveWrapper * const pCpuObjectiveWrapperOut,
+   ObjectiveWrapper * const pSIMDObjectiveWrapperOut
 ) noexcept {
+   // The cpu objective is always created and handles everything except ApplyUpdate for the SIMD zones.  If 
+   // pSIMDObjectiveWrapperOut is not nullptr, we also try to create the objective in the widest SIMD zone that the 
+   // machine supports.  If there is no such zone then pSIMDObjectiveWrapperOut->m_pObjective is left as nullptr.
+
    EBM_ASSERT(nullptr != pConfig);
-   EBM_ASSERT(nullptr != pObjectiveWrapperOut);
-   EBM_ASSERT(nullptr == pObjectiveWrapperOut->m_pObjective);
-   EBM_ASSERT(nullptr == pObjectiveWrapperOut->m_pFunctionPointersCpp);
+   EBM_ASSERT(nullptr != pCpuObjectiveWrapperOut);
+   EBM_ASSERT(nullptr == pCpuObjectiveWrapperOut->m_pObjective);
+   EBM_ASSERT(nullptr == pCpuObjectiveWrapperOut->m_pFunctionPointersCpp);
+   EBM_ASSERT(nullptr == pSIMDObjectiveWrapperOut || nullptr == pSIMDObjectiveWrapperOut->m_pObjective);
+   EBM_ASSERT(nullptr == pSIMDObjectiveWrapperOut || nullptr == pSIMDObjectiveWrapperOut->m_pFunctionPointersCpp);
 
    if(nullptr == sObjective) {
       return Error_ObjectiveUnknown;
@@ -42,25 +173,90 @@ INLINE_RELEASE_UNTEMPLATED static ErrorEbm GetObjective(
 
    ErrorEbm error;
 
-   error = CreateObjective_Cpu_64(pConfig, sObjective, sObjectiveEnd, pObjectiveWrapperOut);
+   error = CreateObjective_Cpu_64(pConfig, sObjective, sObjectiveEnd, pCpuObjectiveWrapperOut);
+   if(Error_None != error) {
+      return error;
+   }
+
+   if(nullptr != pSIMDObjectiveWrapperOut) {
+      const int zone = GetComputeZone();
+#ifdef BRIDGE_AVX512F_64
+      if(k_zoneAvx512f == zone) {
+         LOG_0(Trace_Info, "INFO GetObjective using the avx512f zone");
+         error = CreateObjective_Avx512f_64(pConfig, sObjective, sObjectiveEnd, pSIMDObjectiveWrapperOut);
+         return error;
+      }
+#endif // BRIDGE_AVX512F_64
+#ifdef BRIDGE_AVX2_64
+      if(k_zoneAvx2 == zone) {
+         LOG_0(Trace_Info, "INFO GetObjective using the avx2 zone");
+         error = CreateObjective_Avx2_64(pConfig, sObjective, sObjectiveEnd, pSIMDObjectiveWrapperOut);
+         return error;
+      }
+#endif // BRIDGE_AVX2_64
+      UNUSED(zone);
+      LOG_0(Trace_Info, "INFO GetObjective using the cpu zone");
+   }
 
    return error;
 }
 
+INLINE_RELEASE_UNTEMPLATED static ErrorEbm CreateMetricInZone(
+   const int zone,
+   const Config * const pConfig,
+   const char * const sMetric,
+   const char * const sMetricEnd,
+   MetricWrapper * const pMetricWrapperOut
+) noexcept {
+   // metrics only run on the validation set once per boosting step, so unlike objectives we only need one copy 
+   // of each metric and we create it in the widest zone available
+#ifdef BRIDGE_AVX512F_64
+   if(k_zoneAvx512f == zone) {
+      return CreateMetric_Avx512f_64(pConfig, sMetric, sMetricEnd, pMetricWrapperOut);
+   }
+#endif // BRIDGE_AVX512F_64
+#ifdef BRIDGE_AVX2_64
+   if(k_zoneAvx2 == zone) {
+      return CreateMetric_Avx2_64(pConfig, sMetric, sMetricEnd, pMetricWrapperOut);
+   }
+#endif // BRIDGE_AVX2_64
+   UNUSED(zone);
+   return CreateMetric_Cpu_64(pConfig, sMetric, sMetricEnd, pMetricWrapperOut);
+}
+
+INLINE_RELEASE_UNTEMPLATED static void FreeMetrics(const size_t cMetrics, MetricWrapper * const aMetrics) noexcept {
+   if(nullptr != aMetrics) {
+      for(size_t iMetric = 0; iMetric < cMetrics; ++iMetric) {
+         FreeMetricWrapperInternals(&aMetrics[iMetric]);
+      }
+      free(aMetrics);
+   }
+}
+
 INLINE_RELEASE_UNTEMPLATED static ErrorEbm GetMetrics(
    const Config * const pConfig,
-   const char * sMetric
-//   MetricWrapper * const aMetricWrapperOut
+   const char * const sMetrics,
+   size_t * const pcMetricsOut,
+   MetricWrapper ** const paMetricsOut
 ) noexcept {
+   // sMetrics is a comma separated list of metrics.  On success *paMetricsOut is an array of *pcMetricsOut 
+   // metrics which the caller frees with FreeMetrics.  No metrics is legal and returns a nullptr array.
+
    EBM_ASSERT(nullptr != pConfig);
-   //EBM_ASSERT(nullptr != pMetricWrapperOut);
-   //aMetricWrapperOut->m_pMetric = nullptr;
-   //aMetricWrapperOut->m_pFunctionPointersCpp = nullptr;
+   EBM_ASSERT(nullptr != pcMetricsOut);
+   EBM_ASSERT(nullptr != paMetricsOut);
 
-   if(nullptr == sMetric) {
+   *pcMetricsOut = 0;
+   *paMetricsOut = nullptr;
+
+   if(nullptr == sMetrics) {
       // it's legal to have no metrics
       return Error_None;
    }
+
+   // we allow empty registrations like ",,,something_legal,,,  something_else  , " since the intent is clear
+   size_t cMetrics = 0;
+   const char * sMetric = sMetrics;
    while(true) {
       sMetric = SkipWhitespace(sMetric);
       const char * sMetricEnd = strchr(sMetric, k_registrationSeparator);
@@ -69,25 +265,60 @@ INLINE_RELEASE_UNTEMPLATED static ErrorEbm GetMetrics(
          sMetricEnd = sMetric + strlen(sMetric);
       }
       if(sMetricEnd != sMetric) {
-         // we allow empty registrations like ",,,something_legal,,,  something_else  , " since the intent is clear
-         ErrorEbm error;
+         ++cMetrics;
+      }
+      if('\0' == *sMetricEnd) {
+         break;
+      }
+      EBM_ASSERT(k_registrationSeparator == *sMetricEnd);
+      sMetric = sMetricEnd + 1;
+   }
+   if(size_t { 0 } == cMetrics) {
+      return Error_None;
+   }
 
-         error = CreateMetric_Cpu_64(pConfig, sMetric, sMetricEnd);
+   if(IsMultiplyError(sizeof(MetricWrapper), cMetrics)) {
+      LOG_0(Trace_Warning, "WARNING GetMetrics IsMultiplyError(sizeof(MetricWrapper), cMetrics)");
+      return Error_OutOfMemory;
+   }
+   MetricWrapper * const aMetrics = static_cast<MetricWrapper *>(malloc(sizeof(MetricWrapper) * cMetrics));
+   if(nullptr == aMetrics) {
+      LOG_0(Trace_Warning, "WARNING GetMetrics nullptr == aMetrics");
+      return Error_OutOfMemory;
+   }
+   for(size_t iMetric = 0; iMetric < cMetrics; ++iMetric) {
+      InitializeMetricWrapperUnfailing(&aMetrics[iMetric]);
+   }
+
+   const int zone = GetComputeZone();
+
+   size_t iMetric = 0;
+   sMetric = sMetrics;
+   while(true) {
+      sMetric = SkipWhitespace(sMetric);
+      const char * sMetricEnd = strchr(sMetric, k_registrationSeparator);
+      if(nullptr == sMetricEnd) {
+         sMetricEnd = sMetric + strlen(sMetric);
+      }
+      if(sMetricEnd != sMetric) {
+         EBM_ASSERT(iMetric < cMetrics);
+         const ErrorEbm error = CreateMetricInZone(zone, pConfig, sMetric, sMetricEnd, &aMetrics[iMetric]);
          if(Error_None != error) {
+            FreeMetrics(cMetrics, aMetrics);
             return error;
          }
-
-         // TODO: for now let's return after we find the first metric, but in the future we'll want to return
-         //       some kind of list of them
-         return error;
+         ++iMetric;
       }
       if('\0' == *sMetricEnd) {
-         return Error_None;
+         break;
       }
-      EBM_ASSERT(k_registrationSeparator == *sMetricEnd);
-
       sMetric = sMetricEnd + 1;
    }
+   EBM_ASSERT(cMetrics == iMetric);
+
+   *pcMetricsOut = cMetrics;
+   *paMetricsOut = aMetrics;
+   return Error_None;
 }
 
 } // DEFINED_ZONE_NAME
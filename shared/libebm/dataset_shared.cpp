@@ -7,6 +7,19 @@
 #include <stdlib.h> // free
 #include <stddef.h> // size_t, ptrdiff_t
 #include <string.h> // memcpy
+#include <stdio.h> // fopen, fwrite
+
+#ifdef _WIN32
+// we don't want windows.h in our precompiled header since then it would be needed in linux builds
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h> // CreateFileMappingA, MapViewOfFile
+#else // _WIN32
+#include <fcntl.h> // open
+#include <unistd.h> // close
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#endif // _WIN32
 
 #include "logging.h" // EBM_ASSERT
 #include "common_c.h"
@@ -153,7 +166,6 @@ static_assert(std::is_trivial<FeatureDataSetShared>::value,
    "These structs are shared between processes, so they definetly need to be standard layout and trivial");
 
 struct SparseFeatureDataSetShared {
-   // TODO: implement sparse features
    SharedStorageDataType m_defaultVal;
    SharedStorageDataType m_cNonDefaults;
 
@@ -513,6 +525,9 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CheckDataSet(IntEbm countBytesAlloc
                return Error_IllegalParamVal;
             }
 
+            // the consumers walk the non-default entries alongside the bag in sample order, so we require
+            // strictly increasing sample indexes which also guarantees that no sample is listed twice
+            SharedStorageDataType iSampleMin = 0;
             const SparseFeatureDataSetSharedEntry * pNonDefault = ArrayToPointer(pSparseFeatureDataSetShared->m_nonDefaults);
             const SparseFeatureDataSetSharedEntry * const pNonDefaultEnd = &pNonDefault[cNonDefaults];
             while(pNonDefaultEnd != pNonDefault) {
@@ -520,11 +535,20 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION CheckDataSet(IntEbm countBytesAlloc
                   LOG_0(Trace_Error, "ERROR CheckDataSet countSamples <= pNonDefault->m_iSample");
                   return Error_IllegalParamVal;
                }
+               if(pNonDefault->m_iSample < iSampleMin) {
+                  LOG_0(Trace_Error, "ERROR CheckDataSet pNonDefault->m_iSample < iSampleMin");
+                  return Error_IllegalParamVal;
+               }
+               iSampleMin = pNonDefault->m_iSample + SharedStorageDataType { 1 };
 
                if(countBins <= pNonDefault->m_nonDefaultVal) {
                   LOG_0(Trace_Error, "ERROR CheckDataSet countBins <= pNonDefault->m_nonDefaultVal");
                   return Error_IllegalParamVal;
                }
+               if(defaultVal == pNonDefault->m_nonDefaultVal) {
+                  LOG_0(Trace_Error, "ERROR CheckDataSet defaultVal == pNonDefault->m_nonDefaultVal");
+                  return Error_IllegalParamVal;
+               }
                ++pNonDefault;
             }
          } else {
@@ -976,19 +1000,69 @@ static IntEbm AppendHeader(
 }
 WARNING_POP
 
-static bool DecideIfSparse(const size_t cSamples, const IntEbm * binIndexes) {
+static bool DecideIfSparse(
+   const size_t cSamples,
+   const IntEbm * const binIndexes,
+   const size_t cBytesDense,
+   IntEbm * const pIndexDefaultOut,
+   size_t * const pcNonDefaultsOut
+) {
    // For sparsity in the data set shared memory the only thing that matters is compactness since we don't use
-   // this memory in any high performance loops
-
-   UNUSED(cSamples);
-   UNUSED(binIndexes);
+   // this memory in any high performance loops.  A sparse entry is far larger than a bit packed item, so sparse
+   // storage can only be smaller when a single bin holds the majority of the samples, which means the
+   // Boyer-Moore majority vote finds the only candidate for the default without needing a histogram of the bins.
+
+   EBM_ASSERT(1 <= cSamples);
+   EBM_ASSERT(nullptr != binIndexes);
+   EBM_ASSERT(nullptr != pIndexDefaultOut);
+   EBM_ASSERT(nullptr != pcNonDefaultsOut);
+
+   const size_t cBytesSparseHeader = offsetof(SparseFeatureDataSetShared, m_nonDefaults);
+   const size_t cBytesSparseEntry = sizeof(SparseFeatureDataSetSharedEntry);
+   if(cBytesDense <= cBytesSparseHeader) {
+      return false;
+   }
+   // sparse is only chosen if it is strictly smaller than dense
+   const size_t cNonDefaultsMax = (cBytesDense - cBytesSparseHeader - size_t { 1 }) / cBytesSparseEntry;
+
+   const IntEbm * pBinIndex = binIndexes;
+   const IntEbm * const pBinIndexesEnd = binIndexes + cSamples;
+
+   IntEbm indexCandidate = *pBinIndex;
+   size_t cVotes = 0;
+   do {
+      const IntEbm indexBin = *pBinIndex;
+      if(size_t { 0 } == cVotes) {
+         indexCandidate = indexBin;
+         cVotes = 1;
+      } else if(indexCandidate == indexBin) {
+         ++cVotes;
+      } else {
+         --cVotes;
+      }
+      ++pBinIndex;
+   } while(pBinIndexesEnd != pBinIndex);
+
+   size_t cNonDefaults = 0;
+   pBinIndex = binIndexes;
+   do {
+      if(indexCandidate != *pBinIndex) {
+         ++cNonDefaults;
+         if(cNonDefaultsMax < cNonDefaults) {
+            return false;
+         }
+      }
+      ++pBinIndex;
+   } while(pBinIndexesEnd != pBinIndex);
 
-   // TODO: evalute the data to decide if the feature should be sparse or not
-   return false;
+   *pIndexDefaultOut = indexCandidate;
+   *pcNonDefaultsOut = cNonDefaults;
+   return true;
 }
 
 WARNING_PUSH
 WARNING_REDUNDANT_CODE
+WARNING_DISABLE_UNINITIALIZED_LOCAL_VARIABLE
 static IntEbm AppendFeature(
    const IntEbm countBins,
    const BoolEbm isMissing,
@@ -1056,15 +1130,50 @@ static IntEbm AppendFeature(
       }
       const size_t cSamples = static_cast<size_t>(countSamples);
 
-      bool bSparse = false;
       if(size_t { 0 } != cSamples) {
          if(nullptr == binIndexes) {
             LOG_0(Trace_Error, "ERROR AppendFeature nullptr == binIndexes");
             goto return_bad;
          }
+      }
+
+      // if there is only 1 bin we always know what it will be and we do not need to store anything
+      const bool bStoreData = size_t { 0 } != cSamples && SharedStorageDataType { 1 } < cBins;
+
+      bool bSparse = false;
+      size_t cItemsPerBitPack;
+      size_t cBitsPerItemMax;
+      size_t cBytesData = 0;
+      IntEbm indexDefault;
+      size_t cNonDefaults;
+      if(bStoreData) {
+         const size_t cBitsRequiredMin = CountBitsRequired(cBins - SharedStorageDataType { 1 });
+         EBM_ASSERT(1 <= cBitsRequiredMin);
+         EBM_ASSERT(cBitsRequiredMin <= k_cBitsForSharedStorageType);
+
+         cItemsPerBitPack = GetCountItemsBitPacked<SharedStorageDataType>(cBitsRequiredMin);
+         EBM_ASSERT(1 <= cItemsPerBitPack);
+         EBM_ASSERT(cItemsPerBitPack <= k_cBitsForSharedStorageType);
+
+         cBitsPerItemMax = GetCountBits<SharedStorageDataType>(cItemsPerBitPack);
+         EBM_ASSERT(1 <= cBitsPerItemMax);
+         EBM_ASSERT(cBitsPerItemMax <= k_cBitsForSharedStorageType);
+
+         EBM_ASSERT(1 <= cSamples);
+         const size_t cDataUnits = (cSamples - size_t { 1 }) / cItemsPerBitPack + size_t { 1 };
+
+         if(IsMultiplyError(sizeof(SharedStorageDataType), cDataUnits)) {
+            LOG_0(Trace_Error, "ERROR AppendFeature IsMultiplyError(sizeof(SharedStorageDataType), cDataUnits)");
+            goto return_bad;
+         }
+         cBytesData = sizeof(SharedStorageDataType) * cDataUnits;
 
-         // TODO: handle sparse data someday
-         bSparse = DecideIfSparse(cSamples, binIndexes);
+         bSparse = DecideIfSparse(cSamples, binIndexes, cBytesData, &indexDefault, &cNonDefaults);
+         if(bSparse) {
+            // DecideIfSparse only returns true if the sparse representation is smaller, so this cannot overflow
+            cBytesData = offsetof(SparseFeatureDataSetShared, m_nonDefaults) + 
+               sizeof(SparseFeatureDataSetSharedEntry) * cNonDefaults;
+         }
       }
 
       size_t iOffset = 0;
@@ -1116,34 +1225,12 @@ static IntEbm AppendFeature(
          pFeatureDataSetShared->m_cBins = cBins;
       }
 
-      // if there is only 1 bin we always know what it will be and we do not need to store anything
-      if(size_t { 0 } != cSamples && SharedStorageDataType { 1 } < cBins) {
-         const size_t cBitsRequiredMin = CountBitsRequired(cBins - SharedStorageDataType { 1 });
-         EBM_ASSERT(1 <= cBitsRequiredMin);
-         EBM_ASSERT(cBitsRequiredMin <= k_cBitsForSharedStorageType);
-
-         const size_t cItemsPerBitPack = GetCountItemsBitPacked<SharedStorageDataType>(cBitsRequiredMin);
-         EBM_ASSERT(1 <= cItemsPerBitPack);
-         EBM_ASSERT(cItemsPerBitPack <= k_cBitsForSharedStorageType);
-
-         const size_t cBitsPerItemMax = GetCountBits<SharedStorageDataType>(cItemsPerBitPack);
-         EBM_ASSERT(1 <= cBitsPerItemMax);
-         EBM_ASSERT(cBitsPerItemMax <= k_cBitsForSharedStorageType);
-
-         EBM_ASSERT(1 <= cSamples);
-         const size_t cDataUnits = (cSamples - size_t { 1 }) / cItemsPerBitPack + size_t { 1 };
-
-         if(IsMultiplyError(sizeof(SharedStorageDataType), cDataUnits)) {
-            LOG_0(Trace_Error, "ERROR AppendFeature IsMultiplyError(sizeof(SharedStorageDataType), cDataUnits)");
-            goto return_bad;
-         }
-         const size_t cBytesAllSamples = sizeof(SharedStorageDataType) * cDataUnits;
-
-         if(IsAddError(iByteCur, cBytesAllSamples)) {
-            LOG_0(Trace_Error, "ERROR AppendFeature IsAddError(iByteCur, cBytesAllSamples)");
+      if(bStoreData) {
+         if(IsAddError(iByteCur, cBytesData)) {
+            LOG_0(Trace_Error, "ERROR AppendFeature IsAddError(iByteCur, cBytesData)");
             goto return_bad;
          }
-         const size_t iByteNext = iByteCur + cBytesAllSamples;
+         const size_t iByteNext = iByteCur + cBytesData;
 
          if(nullptr != pFillMem) {
             if(cBytesAllocated < iByteNext) {
@@ -1157,13 +1244,19 @@ static IntEbm AppendFeature(
             }
             const IntEbm * pBinIndex = binIndexes;
             const IntEbm * const pBinIndexsEnd = binIndexes + cSamples;
-            SharedStorageDataType * pFillData = reinterpret_cast<SharedStorageDataType *>(pFillMem + iByteCur);
-
-            ptrdiff_t cShift = static_cast<ptrdiff_t>((cSamples - size_t { 1 }) % cItemsPerBitPack * cBitsPerItemMax);
-            const ptrdiff_t cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - size_t { 1 }) * cBitsPerItemMax);
             const IntEbm indexBinIllegal = countBins - (EBM_FALSE != isUnknown ? IntEbm { 0 } : IntEbm { 1 });
-            do {
-               SharedStorageDataType bits = 0;
+
+            if(bSparse) {
+               SparseFeatureDataSetShared * const pSparseFeatureDataSetShared =
+                  reinterpret_cast<SparseFeatureDataSetShared *>(pFillMem + iByteCur);
+
+               // the default was one of the bin indexes, so it gets checked below along with all the others
+               pSparseFeatureDataSetShared->m_defaultVal = static_cast<SharedStorageDataType>(
+                  EBM_FALSE != isMissing ? indexDefault : indexDefault - IntEbm { 1 });
+               pSparseFeatureDataSetShared->m_cNonDefaults = static_cast<SharedStorageDataType>(cNonDefaults);
+
+               SparseFeatureDataSetSharedEntry * pNonDefault = 
+                  ArrayToPointer(pSparseFeatureDataSetShared->m_nonDefaults);
                do {
                   IntEbm indexBin = *pBinIndex;
                   if(indexBinIllegal <= indexBin) {
@@ -1180,23 +1273,62 @@ static IntEbm AppendFeature(
                         LOG_0(Trace_Error, "ERROR AppendFeature indexBin <= IntEbm { 0 }");
                         goto return_bad;
                      }
-                     --indexBin;
+                  }
+                  if(indexDefault != indexBin) {
+                     if(EBM_FALSE == isMissing) {
+                        --indexBin;
+                     }
+                     // since countBins can be converted to these, so now can indexBin
+                     EBM_ASSERT(!IsConvertError<SharedStorageDataType>(indexBin));
+
+                     pNonDefault->m_iSample = static_cast<SharedStorageDataType>(pBinIndex - binIndexes);
+                     pNonDefault->m_nonDefaultVal = static_cast<SharedStorageDataType>(indexBin);
+                     ++pNonDefault;
                   }
                   ++pBinIndex;
+               } while(pBinIndexsEnd != pBinIndex);
+               EBM_ASSERT(reinterpret_cast<unsigned char *>(pNonDefault) == pFillMem + iByteNext);
+            } else {
+               SharedStorageDataType * pFillData = reinterpret_cast<SharedStorageDataType *>(pFillMem + iByteCur);
 
-                  // since countBins can be converted to these, so now can indexBin
-                  EBM_ASSERT(!IsConvertError<SharedStorageDataType>(indexBin));
-
-                  EBM_ASSERT(0 <= cShift);
-                  EBM_ASSERT(static_cast<size_t>(cShift) < k_cBitsForSharedStorageType);
-                  bits |= static_cast<SharedStorageDataType>(indexBin) << cShift;
-                  cShift -= cBitsPerItemMax;
-               } while(ptrdiff_t { 0 } <= cShift);
-               cShift = cShiftReset;
-               *pFillData = bits;
-               ++pFillData;
-            } while(pBinIndexsEnd != pBinIndex);
-            EBM_ASSERT(reinterpret_cast<unsigned char *>(pFillData) == pFillMem + iByteNext);
+               ptrdiff_t cShift = static_cast<ptrdiff_t>((cSamples - size_t { 1 }) % cItemsPerBitPack * cBitsPerItemMax);
+               const ptrdiff_t cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - size_t { 1 }) * cBitsPerItemMax);
+               do {
+                  SharedStorageDataType bits = 0;
+                  do {
+                     IntEbm indexBin = *pBinIndex;
+                     if(indexBinIllegal <= indexBin) {
+                        LOG_0(Trace_Error, "ERROR AppendFeature indexBinIllegal <= indexBin");
+                        goto return_bad;
+                     }
+                     if(EBM_FALSE != isMissing) {
+                        if(indexBin < IntEbm { 0 }) {
+                           LOG_0(Trace_Error, "ERROR AppendFeature indexBin can't be negative");
+                           goto return_bad;
+                        }
+                     } else {
+                        if(indexBin <= IntEbm { 0 }) {
+                           LOG_0(Trace_Error, "ERROR AppendFeature indexBin <= IntEbm { 0 }");
+                           goto return_bad;
+                        }
+                        --indexBin;
+                     }
+                     ++pBinIndex;
+
+                     // since countBins can be converted to these, so now can indexBin
+                     EBM_ASSERT(!IsConvertError<SharedStorageDataType>(indexBin));
+
+                     EBM_ASSERT(0 <= cShift);
+                     EBM_ASSERT(static_cast<size_t>(cShift) < k_cBitsForSharedStorageType);
+                     bits |= static_cast<SharedStorageDataType>(indexBin) << cShift;
+                     cShift -= cBitsPerItemMax;
+                  } while(ptrdiff_t { 0 } <= cShift);
+                  cShift = cShiftReset;
+                  *pFillData = bits;
+                  ++pFillData;
+               } while(pBinIndexsEnd != pBinIndex);
+               EBM_ASSERT(reinterpret_cast<unsigned char *>(pFillData) == pFillMem + iByteNext);
+            }
          }
          iByteCur = iByteNext;
       }
@@ -1360,8 +1492,15 @@ static IntEbm AppendWeight(
                goto return_bad;
             }
 
-            static_assert(sizeof(FloatFast) == sizeof(*aWeights), "float mismatch");
-            memcpy(pFillMem + iByteCur, aWeights, cBytesAllSamples);
+            // FloatFast can be narrower than the double weights passed in, so convert instead of copying bytes
+            FloatFast * pFillWeight = reinterpret_cast<FloatFast *>(pFillMem + iByteCur);
+            const double * pWeight = aWeights;
+            const double * const pWeightsEnd = aWeights + cSamples;
+            do {
+               *pFillWeight = static_cast<FloatFast>(*pWeight);
+               ++pFillWeight;
+               ++pWeight;
+            } while(pWeightsEnd != pWeight);
          }
          iByteCur = iByteNext;
       }
@@ -1574,8 +1713,15 @@ static IntEbm AppendTarget(
                } while(pTargetsEnd != pTarget);
                EBM_ASSERT(reinterpret_cast<unsigned char *>(pFillData) == pFillMem + iByteNext);
             } else {
-               static_assert(sizeof(FloatFast) == sizeof(double), "float mismatch");
-               memcpy(pFillMem + iByteCur, aTargets, cBytesAllSamples);
+               // FloatFast can be narrower than the double targets passed in, so convert instead of copying bytes
+               FloatFast * pFillTarget = reinterpret_cast<FloatFast *>(pFillMem + iByteCur);
+               const double * pTarget = static_cast<const double *>(aTargets);
+               const double * const pTargetsEnd = pTarget + cSamples;
+               do {
+                  *pFillTarget = static_cast<FloatFast>(*pTarget);
+                  ++pFillTarget;
+                  ++pTarget;
+               } while(pTargetsEnd != pTarget);
             }
          }
          iByteCur = iByteNext;
@@ -2071,6 +2217,77 @@ extern const void * GetDataSetSharedFeature(
    return pRet;
 }
 
+extern SharedStorageDataType * ExpandSparseFeature(
+   const size_t cSamples,
+   const size_t cBins,
+   const SharedStorageDataType defaultVal,
+   const size_t cNonDefaults,
+   const SparseFeatureDataSetSharedEntry * const aNonDefaults
+) {
+   EBM_ASSERT(1 <= cSamples);
+   EBM_ASSERT(2 <= cBins);
+   EBM_ASSERT(static_cast<size_t>(defaultVal) < cBins);
+   EBM_ASSERT(0 == cNonDefaults || nullptr != aNonDefaults);
+
+   const size_t cBitsRequiredMin = CountBitsRequired(cBins - size_t { 1 });
+   EBM_ASSERT(1 <= cBitsRequiredMin);
+   EBM_ASSERT(cBitsRequiredMin <= k_cBitsForSharedStorageType);
+
+   const size_t cItemsPerBitPack = GetCountItemsBitPacked<SharedStorageDataType>(cBitsRequiredMin);
+   EBM_ASSERT(1 <= cItemsPerBitPack);
+   EBM_ASSERT(cItemsPerBitPack <= k_cBitsForSharedStorageType);
+
+   const size_t cBitsPerItemMax = GetCountBits<SharedStorageDataType>(cItemsPerBitPack);
+   EBM_ASSERT(1 <= cBitsPerItemMax);
+   EBM_ASSERT(cBitsPerItemMax <= k_cBitsForSharedStorageType);
+
+   const size_t cDataUnits = (cSamples - size_t { 1 }) / cItemsPerBitPack + size_t { 1 };
+
+   // the shared dataset was allocated with at least this much memory for the dense layout or we would not
+   // have chosen the sparse layout, but we're on a different machine potentially so check anyways
+   if(IsMultiplyError(sizeof(SharedStorageDataType), cDataUnits)) {
+      LOG_0(Trace_Warning, "WARNING ExpandSparseFeature IsMultiplyError(sizeof(SharedStorageDataType), cDataUnits)");
+      return nullptr;
+   }
+   SharedStorageDataType * const aDense =
+      static_cast<SharedStorageDataType *>(malloc(sizeof(SharedStorageDataType) * cDataUnits));
+   if(nullptr == aDense) {
+      LOG_0(Trace_Warning, "WARNING ExpandSparseFeature nullptr == aDense");
+      return nullptr;
+   }
+
+   const SparseFeatureDataSetSharedEntry * pNonDefault = aNonDefaults;
+   const SparseFeatureDataSetSharedEntry * const pNonDefaultEnd = &aNonDefaults[cNonDefaults];
+
+   SharedStorageDataType iSample = 0;
+   SharedStorageDataType * pDense = aDense;
+   ptrdiff_t cShift = static_cast<ptrdiff_t>((cSamples - size_t { 1 }) % cItemsPerBitPack * cBitsPerItemMax);
+   const ptrdiff_t cShiftReset = static_cast<ptrdiff_t>((cItemsPerBitPack - size_t { 1 }) * cBitsPerItemMax);
+   do {
+      SharedStorageDataType bits = 0;
+      do {
+         SharedStorageDataType val = defaultVal;
+         if(pNonDefaultEnd != pNonDefault && iSample == pNonDefault->m_iSample) {
+            val = pNonDefault->m_nonDefaultVal;
+            ++pNonDefault;
+         }
+         ++iSample;
+
+         EBM_ASSERT(0 <= cShift);
+         EBM_ASSERT(static_cast<size_t>(cShift) < k_cBitsForSharedStorageType);
+         bits |= val << cShift;
+         cShift -= cBitsPerItemMax;
+      } while(ptrdiff_t { 0 } <= cShift);
+      cShift = cShiftReset;
+      *pDense = bits;
+      ++pDense;
+   } while(&aDense[cDataUnits] != pDense);
+   EBM_ASSERT(pNonDefaultEnd == pNonDefault); // CheckDataSet verified the sample indexes are increasing
+   EBM_ASSERT(static_cast<size_t>(iSample) == cSamples);
+
+   return aDense;
+}
+
 EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION ExtractBinCounts(
    const void * dataSet,
    IntEbm countFeaturesVerify,
@@ -2311,4 +2528,204 @@ EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION ExtractTargetClasses(
    return Error_None;
 }
 
+EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION WriteDataSetShared(
+   IntEbm countBytesAllocated,
+   const void * dataSet,
+   const char * filename
+) {
+   LOG_N(
+      Trace_Info,
+      "Entered WriteDataSetShared: "
+      "countBytesAllocated=%" IntEbmPrintf ", "
+      "dataSet=%p, "
+      "filename=%p"
+      ,
+      countBytesAllocated,
+      static_cast<const void *>(dataSet),
+      static_cast<const void *>(filename)
+   );
+
+   if(nullptr == filename) {
+      LOG_0(Trace_Error, "ERROR WriteDataSetShared nullptr == filename");
+      return Error_IllegalParamVal;
+   }
+
+   if(countBytesAllocated <= IntEbm { 0 }) {
+      // CheckDataSet skips the length check for 0, but we need the exact length to know what to write
+      LOG_0(Trace_Error, "ERROR WriteDataSetShared countBytesAllocated <= IntEbm { 0 }");
+      return Error_IllegalParamVal;
+   }
+
+   // only completely filled datasets pass CheckDataSet, and those are never modified again
+   ErrorEbm error = CheckDataSet(countBytesAllocated, dataSet);
+   if(Error_None != error) {
+      // already logged
+      return error;
+   }
+   const size_t cBytes = static_cast<size_t>(countBytesAllocated);
+
+   FILE * const pFile = fopen(filename, "wb");
+   if(nullptr == pFile) {
+      LOG_0(Trace_Warning, "WARNING WriteDataSetShared nullptr == pFile");
+      return Error_FileIo;
+   }
+   const size_t cBytesWritten = fwrite(dataSet, size_t { 1 }, cBytes, pFile);
+   // fclose flushes the buffered bytes, so check it too
+   const int closeRet = fclose(pFile);
+   if(cBytes != cBytesWritten || 0 != closeRet) {
+      LOG_0(Trace_Warning, "WARNING WriteDataSetShared cBytes != cBytesWritten || 0 != closeRet");
+      return Error_FileIo;
+   }
+
+   LOG_0(Trace_Info, "Exited WriteDataSetShared");
+
+   return Error_None;
+}
+
+EBM_API_BODY ErrorEbm EBM_CALLING_CONVENTION OpenDataSetShared(
+   const char * filename,
+   IntEbm * countBytesOut,
+   const void ** dataSetOut
+) {
+   LOG_N(
+      Trace_Info,
+      "Entered OpenDataSetShared: "
+      "filename=%p, "
+      "countBytesOut=%p, "
+      "dataSetOut=%p"
+      ,
+      static_cast<const void *>(filename),
+      static_cast<void *>(countBytesOut),
+      static_cast<void *>(dataSetOut)
+   );
+
+   if(nullptr == dataSetOut) {
+      LOG_0(Trace_Error, "ERROR OpenDataSetShared nullptr == dataSetOut");
+      return Error_IllegalParamVal;
+   }
+   *dataSetOut = nullptr;
+
+   if(nullptr == countBytesOut) {
+      LOG_0(Trace_Error, "ERROR OpenDataSetShared nullptr == countBytesOut");
+      return Error_IllegalParamVal;
+   }
+   *countBytesOut = 0;
+
+   if(nullptr == filename) {
+      LOG_0(Trace_Error, "ERROR OpenDataSetShared nullptr == filename");
+      return Error_IllegalParamVal;
+   }
+
+   // The mapping is read only and backed by the file, so every process that opens the same file shares the
+   // same physical pages and nothing is copied into our address space until it is touched
+   size_t cBytes;
+   void * pMapped;
+#ifdef _WIN32
+   const HANDLE hFile = CreateFileA(
+      filename,
+      GENERIC_READ,
+      FILE_SHARE_READ,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr
+   );
+   if(INVALID_HANDLE_VALUE == hFile) {
+      LOG_0(Trace_Warning, "WARNING OpenDataSetShared INVALID_HANDLE_VALUE == hFile");
+      return Error_FileIo;
+   }
+   LARGE_INTEGER fileSize;
+   if(!GetFileSizeEx(hFile, &fileSize)) {
+      CloseHandle(hFile);
+      LOG_0(Trace_Warning, "WARNING OpenDataSetShared GetFileSizeEx failed");
+      return Error_FileIo;
+   }
+   if(fileSize.QuadPart <= 0 || IsConvertError<size_t>(fileSize.QuadPart)) {
+      CloseHandle(hFile);
+      LOG_0(Trace_Error, "ERROR OpenDataSetShared fileSize.QuadPart <= 0 || IsConvertError<size_t>(fileSize.QuadPart)");
+      return Error_IllegalParamVal;
+   }
+   cBytes = static_cast<size_t>(fileSize.QuadPart);
+
+   const HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+   CloseHandle(hFile); // the mapping keeps the file open
+   if(nullptr == hMapping) {
+      LOG_0(Trace_Warning, "WARNING OpenDataSetShared nullptr == hMapping");
+      return Error_FileIo;
+   }
+   pMapped = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+   CloseHandle(hMapping); // the view keeps the mapping alive
+   if(nullptr == pMapped) {
+      LOG_0(Trace_Warning, "WARNING OpenDataSetShared nullptr == pMapped");
+      return Error_FileIo;
+   }
+#else // _WIN32
+   const int fd = open(filename, O_RDONLY);
+   if(fd < 0) {
+      LOG_0(Trace_Warning, "WARNING OpenDataSetShared fd < 0");
+      return Error_FileIo;
+   }
+   struct stat fileStat;
+   if(0 != fstat(fd, &fileStat)) {
+      close(fd);
+      LOG_0(Trace_Warning, "WARNING OpenDataSetShared 0 != fstat(fd, &fileStat)");
+      return Error_FileIo;
+   }
+   if(fileStat.st_size <= 0 || IsConvertError<size_t>(fileStat.st_size)) {
+      close(fd);
+      LOG_0(Trace_Error, "ERROR OpenDataSetShared fileStat.st_size <= 0 || IsConvertError<size_t>(fileStat.st_size)");
+      return Error_IllegalParamVal;
+   }
+   cBytes = static_cast<size_t>(fileStat.st_size);
+
+   pMapped = mmap(nullptr, cBytes, PROT_READ, MAP_SHARED, fd, 0);
+   close(fd); // the mapping keeps the file open
+   if(MAP_FAILED == pMapped) {
+      LOG_0(Trace_Warning, "WARNING OpenDataSetShared MAP_FAILED == pMapped");
+      return Error_FileIo;
+   }
+#endif // _WIN32
+
+   EBM_ASSERT(!IsConvertError<IntEbm>(cBytes)); // the file size came from a signed 64 bit integer
+   const IntEbm countBytes = static_cast<IntEbm>(cBytes);
+
+   // the file could have been truncated or corrupted since we wrote it
+   const ErrorEbm error = CheckDataSet(countBytes, pMapped);
+   if(Error_None != error) {
+      CloseDataSetShared(countBytes, pMapped);
+      return error;
+   }
+
+   *countBytesOut = countBytes;
+   *dataSetOut = pMapped;
+
+   LOG_0(Trace_Info, "Exited OpenDataSetShared");
+
+   return Error_None;
+}
+
+EBM_API_BODY void EBM_CALLING_CONVENTION CloseDataSetShared(IntEbm countBytes, const void * dataSet) {
+   LOG_N(
+      Trace_Info,
+      "Entered CloseDataSetShared: "
+      "countBytes=%" IntEbmPrintf ", "
+      "dataSet=%p"
+      ,
+      countBytes,
+      static_cast<const void *>(dataSet)
+   );
+
+   if(nullptr != dataSet) {
+#ifdef _WIN32
+      UNUSED(countBytes);
+      UnmapViewOfFile(dataSet);
+#else // _WIN32
+      EBM_ASSERT(!IsConvertError<size_t>(countBytes));
+      munmap(const_cast<void *>(dataSet), static_cast<size_t>(countBytes));
+#endif // _WIN32
+   }
+
+   LOG_0(Trace_Info, "Exited CloseDataSetShared");
+}
+
 } // DEFINED_ZONE_NAME
@@ -49,6 +49,15 @@ extern const void * GetDataSetSharedFeature(
    size_t * const pcNonDefaultsSparseOut
 );
 
+// ExpandSparseFeature returns a malloc'd copy of a sparse feature in the dense bit packed layout of the shared dataset
+extern SharedStorageDataType * ExpandSparseFeature(
+   const size_t cSamples,
+   const size_t cBins,
+   const SharedStorageDataType defaultVal,
+   const size_t cNonDefaults,
+   const SparseFeatureDataSetSharedEntry * const aNonDefaults
+);
+
 extern const FloatFast * GetDataSetSharedWeight(
    const unsigned char * const pDataSetShared,
    const size_t iWeight
@@ -100,6 +100,10 @@ typedef int32_t BoostFlags;
 // printf hexidecimals must be unsigned, so convert first to unsigned before calling printf
 typedef uint32_t UBoostFlags;
 #define UBoostFlagsPrintf PRIx32
+typedef int32_t CreateBoosterFlags;
+// printf hexidecimals must be unsigned, so convert first to unsigned before calling printf
+typedef uint32_t UCreateBoosterFlags;
+#define UCreateBoosterFlagsPrintf PRIx32
 typedef int32_t InteractionFlags;
 // printf hexidecimals must be unsigned, so convert first to unsigned before calling printf
 typedef uint32_t UInteractionFlags;
@@ -117,9 +121,14 @@ typedef struct _InteractionHandle {
    uint32_t handleVerification; // should be 21773 if ok. Do not use size_t since that requires an additional header.
 } * InteractionHandle;
 
+typedef struct _CompiledModelHandle {
+   uint32_t handleVerification; // should be 27431 if ok. Do not use size_t since that requires an additional header.
+} * CompiledModelHandle;
+
 #define BOOL_CAST(val)                             (STATIC_CAST(BoolEbm, (val)))
 #define ERROR_CAST(val)                            (STATIC_CAST(ErrorEbm, (val)))
 #define BOOST_FLAGS_CAST(val)                      (STATIC_CAST(BoostFlags, (val)))
+#define CREATE_BOOSTER_FLAGS_CAST(val)             (STATIC_CAST(CreateBoosterFlags, (val)))
 #define INTERACTION_FLAGS_CAST(val)                (STATIC_CAST(InteractionFlags, (val)))
 #define TRACE_CAST(val)                            (STATIC_CAST(TraceEbm, (val)))
 #define LINK_CAST(val)                             (STATIC_CAST(LinkEbm, (val)))
@@ -161,6 +170,8 @@ typedef struct _InteractionHandle {
 // bad input values that are from the end user. These should have been filtered out by our higher level caller
 #define Error_UserParamVal                         (ERROR_CAST(-4))
 #define Error_ThreadStartFailed                    (ERROR_CAST(-5))
+// the operating system could not read, write, or map a file
+#define Error_FileIo                               (ERROR_CAST(-6))
 
 #define Error_ObjectiveConstructorException        (ERROR_CAST(-10))
 #define Error_ObjectiveParamUnknown                (ERROR_CAST(-11))
@@ -175,12 +186,28 @@ typedef struct _InteractionHandle {
 #define Error_ObjectiveParamNonPrivate             (ERROR_CAST(-20))
 #define Error_ObjectiveIllegalTarget               (ERROR_CAST(-21))
 
+#define Error_MetricConstructorException           (ERROR_CAST(-22))
+#define Error_MetricParamUnknown                   (ERROR_CAST(-23))
+#define Error_MetricParamValMalformed              (ERROR_CAST(-24))
+#define Error_MetricParamValOutOfRange             (ERROR_CAST(-25))
+#define Error_MetricParamMismatchWithConfig        (ERROR_CAST(-26))
+#define Error_MetricUnknown                        (ERROR_CAST(-27))
+#define Error_MetricIllegalRegistrationName        (ERROR_CAST(-28))
+#define Error_MetricIllegalParamName               (ERROR_CAST(-29))
+#define Error_MetricDuplicateParamName             (ERROR_CAST(-30))
+
 #define BoostFlags_Default                         (BOOST_FLAGS_CAST(0x00000000))
 #define BoostFlags_DisableNewtonGain               (BOOST_FLAGS_CAST(0x00000001))
 #define BoostFlags_DisableNewtonUpdate             (BOOST_FLAGS_CAST(0x00000002))
 #define BoostFlags_GradientSums                    (BOOST_FLAGS_CAST(0x00000004))
 #define BoostFlags_RandomSplits                    (BOOST_FLAGS_CAST(0x00000008))
 
+// CreateBoosterFlags_DifferentialPrivacy equals EBM_TRUE so that callers which pass a BoolEbm keep working
+#define CreateBoosterFlags_Default                 (CREATE_BOOSTER_FLAGS_CAST(0x00000000))
+#define CreateBoosterFlags_DifferentialPrivacy     (CREATE_BOOSTER_FLAGS_CAST(0x00000001))
+// each inner bag subsamples the training set without replacement, and keeps a single bit per sample
+#define CreateBoosterFlags_InnerBagsSubsample      (CREATE_BOOSTER_FLAGS_CAST(0x00000002))
+
 #define InteractionFlags_Default                   (INTERACTION_FLAGS_CAST(0x00000000))
 #define InteractionFlags_Pure                      (INTERACTION_FLAGS_CAST(0x00000001))
 #define InteractionFlags_EnableNewton              (INTERACTION_FLAGS_CAST(0x00000002))
@@ -292,6 +319,39 @@ EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION Discretize(
    IntEbm * binIndexesOut
 );
 
+// A compiled model holds the cuts and term score tensors of a finished EBM so that PredictScores can bin, look up
+// and sum every term in one pass.  Binnings with a negative binningCountCuts take their column as already
+// holding bin indexes (eg: categoricals), with anything that is not a valid index going to the last bin.
+// cuts and termScores are concatenated in binning and term order.  termScores tensors are C ordered with
+// the countScores scores as the last dimension.
+EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION CreateCompiledModel(
+   IntEbm countColumns,
+   IntEbm countBinnings,
+   const IntEbm * binningColumns,
+   const IntEbm * binningCountBins,
+   const IntEbm * binningCountCuts,
+   const double * cuts,
+   IntEbm countScores,
+   const double * intercept,
+   IntEbm countTerms,
+   const IntEbm * dimensionCounts,
+   const IntEbm * binningIndexes,
+   const double * termScores,
+   CompiledModelHandle * compiledModelHandleOut
+);
+EBM_API_INCLUDE void EBM_CALLING_CONVENTION FreeCompiledModel(
+   CompiledModelHandle compiledModelHandle
+);
+// featureVals is [countSamples][countColumns] if C ordered, or [countColumns][countSamples] if Fortran ordered.
+// scoresOut is [countSamples][countScores]
+EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION PredictScores(
+   CompiledModelHandle compiledModelHandle,
+   IntEbm countSamples,
+   const double * featureVals,
+   BoolEbm isFortranOrdered,
+   double * scoresOut
+);
+
 EBM_API_INCLUDE IntEbm EBM_CALLING_CONVENTION MeasureDataSetHeader(
    IntEbm countFeatures,
    IntEbm countWeights,
@@ -358,6 +418,22 @@ EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION FillRegressionTarget(
 
 EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION CheckDataSet(IntEbm countBytesAllocated, const void * dataSet);
 
+// WriteDataSetShared writes a completely filled dataSet to a file.  OpenDataSetShared maps that file read-only 
+// and returns a dataSet that can be passed to CreateBooster and CreateInteractionDetector, which neither copy nor 
+// modify it, and which do not reference it after they return.  Processes that open the same file share a single 
+// copy of the data.  Release it with CloseDataSetShared, passing the countBytesOut from OpenDataSetShared.
+EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION WriteDataSetShared(
+   IntEbm countBytesAllocated,
+   const void * dataSet,
+   const char * filename
+);
+EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION OpenDataSetShared(
+   const char * filename,
+   IntEbm * countBytesOut,
+   const void ** dataSetOut
+);
+EBM_API_INCLUDE void EBM_CALLING_CONVENTION CloseDataSetShared(IntEbm countBytes, const void * dataSet);
+
 EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION ExtractDataSetHeader(
    const void * dataSet,
    IntEbm * countSamplesOut,
@@ -410,6 +486,9 @@ EBM_API_INCLUDE const char * EBM_CALLING_CONVENTION GetOutputTypeStr(
    const char * link
 );
 
+// The dataSet can hold multiple targets if they are all regression or all have the same number of classes.  The
+// targets are then boosted jointly with the multitask version of the objective, and each cell of the term scores
+// and each sample of initScores holds the scores of every target side by side in target order.
 EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION CreateBooster(
    void * rng,
    const void * dataSet,
@@ -420,11 +499,42 @@ EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION CreateBooster(
    const IntEbm * dimensionCounts,
    const IntEbm * featureIndexes,
    IntEbm countInnerBags,
-   BoolEbm isDifferentiallyPrivate,
+   CreateBoosterFlags flags,
    const char * objective,
+   // optional comma separated list of validation metrics.  The first one replaces the objective's metric for 
+   // early stopping and picking the best model, and GetValidationMetrics returns the values of all of them
+   const char * metric,
+   // the inner bags are boosted in parallel on this many threads, or without inner bags the histograms are summed
+   // in parallel.  0 uses the LIBEBM_THREADS environment variable, or 1 thread if it is not set.  With one thread
+   // the inner bags draw from rng in order, while more threads give each inner bag its own generator, so random 
+   // splits and ties can differ between 1 and more threads but not between 2 or more
+   IntEbm countThreads,
    const double * experimentalParams,
    BoosterHandle * boosterHandleOut
 );
+// CreateBoosterBags creates countBags boosters over the same dataSet, one per outer bag.  bags holds countBags
+// consecutive bags of every sample, and initScores (if not nullptr) holds countBags consecutive sets of scores
+// for every sample, including the samples that a bag leaves out.  The term data of the training samples is packed
+// once and shared by all the boosters, which each keep their own scores and gradients.  Each of the handles
+// written to boosterHandlesOut is freed separately with FreeBooster.  The countThreads are split between the
+// boosters so that BoostRoundsBags can boost them in parallel.
+EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION CreateBoosterBags(
+   void * rng,
+   const void * dataSet,
+   IntEbm countBags,
+   const BagEbm * bags,
+   const double * initScores,
+   IntEbm countTerms,
+   const IntEbm * dimensionCounts,
+   const IntEbm * featureIndexes,
+   IntEbm countInnerBags,
+   CreateBoosterFlags flags,
+   const char * objective,
+   const char * metric,
+   IntEbm countThreads,
+   const double * experimentalParams,
+   BoosterHandle * boosterHandlesOut
+);
 EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION CreateBoosterView(
    BoosterHandle boosterHandle,
    BoosterHandle * boosterHandleViewOut
@@ -462,6 +572,65 @@ EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION ApplyTermUpdate(
    BoosterHandle boosterHandle,
    double * avgValidationMetricOut
 );
+// ApplyTermUpdate calculates the validation metric on the first call after this, then only on every countUpdates-th 
+// call, and reports the last calculated metric in between.  The validation scores are still updated on every call.  
+// BoostRounds also calculates the metric at the end of each round.  The default of 1 calculates it on every call.
+EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION SetValidationMetricInterval(
+   BoosterHandle boosterHandle,
+   IntEbm countUpdates
+);
+// SetNextTerm tells the booster which term the next GenerateTermUpdate will boost.  ApplyTermUpdate then sums 
+// that term's histogram in the same pass that refreshes the gradients, and GenerateTermUpdate uses it instead of 
+// reading the gradients again.  This only happens when there is at most 1 inner bag and the histogram is not 
+// split across threads.  Any other term is boosted normally.  A negative indexTerm turns this off.
+EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION SetNextTerm(
+   BoosterHandle boosterHandle,
+   IntEbm indexTerm
+);
+// BoostRounds runs whole rounds of GenerateTermUpdate/ApplyTermUpdate over every term, cyclically or greedily.
+// leavesMax is indexed by dimension and shared by all terms, so it needs an item for each dimension of the largest term
+EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION BoostRounds(
+   void * rng,
+   BoosterHandle boosterHandle,
+   BoostFlags flags,
+   double learningRate,
+   IntEbm minSamplesLeaf,
+   const IntEbm * leavesMax,
+   double greediness,
+   IntEbm smoothingRounds,
+   IntEbm maxRounds,
+   IntEbm earlyStoppingRounds,
+   double earlyStoppingTolerance,
+   IntEbm * countRoundsOut,
+   double * bestMetricOut
+);
+// BoostRoundsBags calls BoostRounds on each of the boosters in parallel, using the countThreads that the first
+// booster was created with.  rngs is either nullptr or countBoosters 
+// consecutive random states of MeasureRNG bytes each.  countRoundsOut and bestMetricOut, if not nullptr, receive 
+// one item per booster
+EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION BoostRoundsBags(
+   IntEbm countBoosters,
+   void * rngs,
+   BoosterHandle * boosterHandles,
+   BoostFlags flags,
+   double learningRate,
+   IntEbm minSamplesLeaf,
+   const IntEbm * leavesMax,
+   double greediness,
+   IntEbm smoothingRounds,
+   IntEbm maxRounds,
+   IntEbm earlyStoppingRounds,
+   double earlyStoppingTolerance,
+   IntEbm * countRoundsOut,
+   double * bestMetricOut
+);
+// the metrics passed to CreateBooster as calculated by the last ApplyTermUpdate.  Unlike avgValidationMetricOut
+// these are not negated for metrics that are maximized, like AUC
+EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION GetValidationMetrics(
+   BoosterHandle boosterHandle,
+   IntEbm countMetrics,
+   double * metricsOut
+);
 EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION GetBestTermScores(
    BoosterHandle boosterHandle, 
    IntEbm indexTerm,
@@ -495,6 +664,17 @@ EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION CalcInteractionStrength(
    IntEbm minSamplesLeaf,
    double * avgInteractionStrengthOut
 );
+// pairFeatureIndexes holds 2 feature indexes per pair.  Pairs that share a feature are binned together in one
+// pass over the data, and the passes are spread over the threads requested through LIBEBM_THREADS.
+EBM_API_INCLUDE ErrorEbm EBM_CALLING_CONVENTION CalcInteractionStrengths(
+   InteractionHandle interactionHandle,
+   IntEbm countPairs,
+   const IntEbm * pairFeatureIndexes,
+   InteractionFlags flags,
+   IntEbm maxCardinality,
+   IntEbm minSamplesLeaf,
+   double * avgInteractionStrengthsOut
+);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -476,6 +476,29 @@ extern ErrorEbm Unbag(
    return Error_None;
 }
 
+extern BagEbm * MakeBagForAllInitScores(const size_t cSamples, const BagEbm * const aBag) {
+   // CreateBoosterBags takes init scores for every sample, but the validation set expects them only for the
+   // samples with non-zero bag values.  The validation set steps over the training samples and their init scores,
+   // so marking the left out samples as training samples lines the init scores up with the samples again
+   EBM_ASSERT(1 <= cSamples);
+   EBM_ASSERT(nullptr != aBag);
+
+   if(IsMultiplyError(sizeof(BagEbm), cSamples)) {
+      LOG_0(Trace_Warning, "WARNING MakeBagForAllInitScores IsMultiplyError(sizeof(BagEbm), cSamples)");
+      return nullptr;
+   }
+   BagEbm * const aRet = static_cast<BagEbm *>(malloc(sizeof(BagEbm) * cSamples));
+   if(UNLIKELY(nullptr == aRet)) {
+      LOG_0(Trace_Warning, "WARNING MakeBagForAllInitScores nullptr == aRet");
+      return nullptr;
+   }
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      const BagEbm replication = aBag[iSample];
+      aRet[iSample] = BagEbm { 0 } == replication ? BagEbm { 1 } : replication;
+   }
+   return aRet;
+}
+
 INLINE_RELEASE_UNTEMPLATED static bool CheckWeightsEqual(
    const BagEbm direction,
    const BagEbm * const aBag,
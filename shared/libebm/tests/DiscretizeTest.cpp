@@ -122,3 +122,282 @@ TEST_CASE("Discretize, increasing lengths") {
    }
 }
 
+
+static std::vector<double> PredictScoresExpected(
+   TestCaseHidden & testCaseHidden,
+   const size_t cSamples,
+   const std::vector<double> & colCont,
+   const std::vector<double> & colCat,
+   const std::vector<double> & cuts,
+   const std::vector<double> & scoresCont,
+   const std::vector<double> & scoresCat,
+   const std::vector<double> & scoresPair,
+   const double intercept
+) {
+   std::vector<IntEbm> binsCont(cSamples);
+   const ErrorEbm error = Discretize(
+      static_cast<IntEbm>(cSamples),
+      &colCont[0],
+      static_cast<IntEbm>(cuts.size()),
+      &cuts[0],
+      &binsCont[0]
+   );
+   CHECK(Error_None == error);
+
+   std::vector<double> expected(cSamples);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      const double cat = colCat[iSample];
+      // categories 1 to 3 are known, 0 is missing, and 4 is the unknown bin
+      const size_t iCat = std::isnan(cat) ? size_t { 0 } : 
+         (0.0 <= cat && cat < 5.0 && static_cast<double>(static_cast<size_t>(cat)) == cat ? static_cast<size_t>(cat) : size_t { 4 });
+      const size_t iCont = static_cast<size_t>(binsCont[iSample]);
+      expected[iSample] = intercept + scoresCont[iCont] + scoresCat[iCat] + scoresPair[iCont * 5 + iCat];
+   }
+   return expected;
+}
+
+static std::vector<double> PredictScoresWithThreads(
+   TestCaseHidden & testCaseHidden,
+   const char * const sThreads,
+   const size_t cSamples,
+   const std::vector<double> & X,
+   const bool bFortranOrdered,
+   const std::vector<double> & cuts,
+   const std::vector<double> & termScores,
+   const double intercept
+) {
+   // the thread pool is sized when the compiled model is created
+   SetThreadCount(sThreads);
+
+   // column 0 is unused so that the binnings need to follow binningColumns
+   const IntEbm binningColumns[] { 1, 2 };
+   const IntEbm binningCountBins[] { static_cast<IntEbm>(cuts.size() + 3), 5 };
+   const IntEbm binningCountCuts[] { static_cast<IntEbm>(cuts.size()), -1 };
+   const IntEbm dimensionCounts[] { 1, 1, 2 };
+   const IntEbm binningIndexes[] { 0, 1, 0, 1 };
+
+   CompiledModelHandle handle = nullptr;
+   ErrorEbm error = CreateCompiledModel(
+      3,
+      2,
+      binningColumns,
+      binningCountBins,
+      binningCountCuts,
+      &cuts[0],
+      1,
+      &intercept,
+      3,
+      dimensionCounts,
+      binningIndexes,
+      &termScores[0],
+      &handle
+   );
+   CHECK(Error_None == error);
+
+   std::vector<double> scores(cSamples, 0.0);
+   error = PredictScores(
+      handle,
+      static_cast<IntEbm>(cSamples),
+      &X[0],
+      bFortranOrdered ? EBM_TRUE : EBM_FALSE,
+      &scores[0]
+   );
+   CHECK(Error_None == error);
+
+   FreeCompiledModel(handle);
+   SetThreadCount(nullptr);
+   return scores;
+}
+
+TEST_CASE("PredictScores, C and Fortran ordered match Discretize sums") {
+   // not a multiple of the 64 sample stripes so that the last stripe is partial
+   static constexpr size_t cSamples = 1000;
+   const std::vector<double> cuts { -1.0, 0.0, 1.5, 2.0 };
+   const size_t cContBins = cuts.size() + 3;
+
+   std::vector<double> colCont(cSamples);
+   std::vector<double> colCat(cSamples);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      colCont[iSample] = 0 == iSample % 37 ? std::numeric_limits<double>::quiet_NaN() : 
+         static_cast<double>(iSample % 11) * 0.5 - 2.0;
+      colCat[iSample] = 0 == iSample % 41 ? std::numeric_limits<double>::quiet_NaN() : 
+         (0 == iSample % 13 ? 2.5 : static_cast<double>(iSample % 7));
+   }
+
+   std::vector<double> scoresCont(cContBins);
+   for(size_t i = 0; i < cContBins; ++i) {
+      scoresCont[i] = static_cast<double>(i) * 0.25 - 1.0;
+   }
+   std::vector<double> scoresCat(5);
+   for(size_t i = 0; i < 5; ++i) {
+      scoresCat[i] = static_cast<double>(i) * -0.125 + 0.5;
+   }
+   std::vector<double> scoresPair(cContBins * 5);
+   for(size_t i = 0; i < scoresPair.size(); ++i) {
+      scoresPair[i] = static_cast<double>(i % 9) * 0.0625;
+   }
+   std::vector<double> termScores;
+   termScores.insert(termScores.end(), scoresCont.begin(), scoresCont.end());
+   termScores.insert(termScores.end(), scoresCat.begin(), scoresCat.end());
+   termScores.insert(termScores.end(), scoresPair.begin(), scoresPair.end());
+
+   const double intercept = 0.75;
+
+   std::vector<double> XC(cSamples * 3);
+   std::vector<double> XF(cSamples * 3);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      XC[iSample * 3 + 0] = 99.0;
+      XC[iSample * 3 + 1] = colCont[iSample];
+      XC[iSample * 3 + 2] = colCat[iSample];
+      XF[0 * cSamples + iSample] = 99.0;
+      XF[1 * cSamples + iSample] = colCont[iSample];
+      XF[2 * cSamples + iSample] = colCat[iSample];
+   }
+
+   const std::vector<double> expected = 
+      PredictScoresExpected(testCaseHidden, cSamples, colCont, colCat, cuts, scoresCont, scoresCat, scoresPair, intercept);
+
+   const std::vector<double> c1 = PredictScoresWithThreads(testCaseHidden, nullptr, cSamples, XC, false, cuts, termScores, intercept);
+   const std::vector<double> f1 = PredictScoresWithThreads(testCaseHidden, nullptr, cSamples, XF, true, cuts, termScores, intercept);
+   const std::vector<double> c3 = PredictScoresWithThreads(testCaseHidden, "3", cSamples, XC, false, cuts, termScores, intercept);
+   const std::vector<double> f3 = PredictScoresWithThreads(testCaseHidden, "3", cSamples, XF, true, cuts, termScores, intercept);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      CHECK_APPROX(expected[iSample], c1[iSample]);
+      CHECK(c1[iSample] == f1[iSample]);
+      CHECK(c1[iSample] == c3[iSample]);
+      CHECK(c1[iSample] == f3[iSample]);
+   }
+}
+
+TEST_CASE("PredictScores, multiclass intercept only and zero samples") {
+   const double intercept[] { 1.0, -2.0, 3.0 };
+   CompiledModelHandle handle = nullptr;
+   ErrorEbm error = CreateCompiledModel(
+      0,
+      0,
+      nullptr,
+      nullptr,
+      nullptr,
+      nullptr,
+      3,
+      intercept,
+      0,
+      nullptr,
+      nullptr,
+      nullptr,
+      &handle
+   );
+   CHECK(Error_None == error);
+
+   error = PredictScores(handle, 0, nullptr, EBM_FALSE, nullptr);
+   CHECK(Error_None == error);
+
+   double scores[6];
+   error = PredictScores(handle, 2, nullptr, EBM_FALSE, scores);
+   CHECK(Error_None == error);
+   CHECK(1.0 == scores[0]);
+   CHECK(-2.0 == scores[1]);
+   CHECK(3.0 == scores[2]);
+   CHECK(1.0 == scores[3]);
+   CHECK(-2.0 == scores[4]);
+   CHECK(3.0 == scores[5]);
+
+   FreeCompiledModel(handle);
+}
+
+TEST_CASE("CreateCompiledModel, illegal inputs") {
+   CompiledModelHandle handle = nullptr;
+
+   // cuts must be increasing
+   const IntEbm binningColumns[] { 0 };
+   const IntEbm binningCountBins[] { 4 };
+   const IntEbm binningCountCuts[] { 2 };
+   const double cutsBad[] { 1.0, 1.0 };
+   ErrorEbm error = CreateCompiledModel(
+      1, 1, binningColumns, binningCountBins, binningCountCuts, cutsBad, 1, nullptr, 0, nullptr, nullptr, nullptr, &handle);
+   CHECK(Error_IllegalParamVal == error);
+   CHECK(nullptr == handle);
+
+   // too few bins to hold the missing bin plus one bin per cut
+   const IntEbm binningCountBinsSmall[] { 3 };
+   const double cuts[] { 1.0, 2.0 };
+   error = CreateCompiledModel(
+      1, 1, binningColumns, binningCountBinsSmall, binningCountCuts, cuts, 1, nullptr, 0, nullptr, nullptr, nullptr, &handle);
+   CHECK(Error_IllegalParamVal == error);
+   CHECK(nullptr == handle);
+
+   // binning column outside of the data
+   const IntEbm binningColumnsBad[] { 1 };
+   error = CreateCompiledModel(
+      1, 1, binningColumnsBad, binningCountBins, binningCountCuts, cuts, 1, nullptr, 0, nullptr, nullptr, nullptr, &handle);
+   CHECK(Error_IllegalParamVal == error);
+   CHECK(nullptr == handle);
+}
+
+TEST_CASE("Discretize, one sample") {
+   const double cuts[] { -1.0, 0.0, 1.0 };
+
+   IntEbm iBin = -1;
+   ErrorEbm error = Discretize(1, &cuts[1], 3, cuts, &iBin);
+   CHECK(Error_None == error);
+   CHECK(IntEbm { 3 } == iBin);
+
+   const double missing = std::numeric_limits<double>::quiet_NaN();
+   error = Discretize(1, &missing, 3, cuts, &iBin);
+   CHECK(Error_None == error);
+   CHECK(IntEbm { 0 } == iBin);
+
+   const double low = -std::numeric_limits<double>::infinity();
+   error = Discretize(1, &low, 0, nullptr, &iBin);
+   CHECK(Error_None == error);
+   CHECK(IntEbm { 1 } == iBin);
+
+   // illegal inputs still get caught by the full checks
+   error = Discretize(1, &low, -1, cuts, &iBin);
+   CHECK(Error_IllegalParamVal == error);
+   error = Discretize(1, &low, 3, nullptr, &iBin);
+   CHECK(Error_IllegalParamVal == error);
+}
+
+TEST_CASE("Discretize, SIMD zones match cpu zone") {
+   // not a multiple of any pack size so that the scalar tail in the SIMD zones gets used
+   static constexpr size_t cSamples = 203;
+   static constexpr size_t cCutsMax = 20;
+
+   double cuts[cCutsMax];
+   for(size_t iCut = 0; iCut < cCutsMax; ++iCut) {
+      cuts[iCut] = static_cast<double>(iCut) * 0.5 - 3.0;
+   }
+
+   double featureVals[cSamples];
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      if(0 == iSample % 17) {
+         featureVals[iSample] = std::numeric_limits<double>::quiet_NaN();
+      } else if(0 == iSample % 19) {
+         featureVals[iSample] = std::numeric_limits<double>::infinity();
+      } else if(0 == iSample % 23) {
+         featureVals[iSample] = -std::numeric_limits<double>::infinity();
+      } else {
+         // landing exactly on cuts checks the lower bound inclusive semantics
+         featureVals[iSample] = static_cast<double>(iSample % 27) * 0.25 - 4.0;
+      }
+   }
+
+   for(size_t cCuts = 1; cCuts <= cCutsMax; ++cCuts) {
+      IntEbm aiBinsCpu[cSamples];
+      SetComputeZone("cpu");
+      ErrorEbm error = Discretize(static_cast<IntEbm>(cSamples), featureVals, static_cast<IntEbm>(cCuts), cuts, aiBinsCpu);
+      CHECK(Error_None == error);
+
+      for(const char * const sZone : { "avx2", "avx512f" }) {
+         IntEbm aiBins[cSamples];
+         SetComputeZone(sZone);
+         error = Discretize(static_cast<IntEbm>(cSamples), featureVals, static_cast<IntEbm>(cCuts), cuts, aiBins);
+         CHECK(Error_None == error);
+         for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+            CHECK(aiBinsCpu[iSample] == aiBins[iSample]);
+         }
+      }
+   }
+   SetComputeZone(nullptr);
+}
@@ -1023,12 +1023,19 @@ TEST_CASE("Term with zero features, boosting, multiclass") {
          }
       }
    }
+#ifdef FLOAT_FAST_32
+   // the float32 gradients round to zero once the target's probability is within float epsilon of 1, which stops
+   // the boosting at a smaller logit
+   static constexpr double k_termScoreFinal = -18.926387;
+#else // FLOAT_FAST_32
+   static constexpr double k_termScoreFinal = -20.875723973004794;
+#endif // FLOAT_FAST_32
    CHECK_APPROX_TOLERANCE(validationMetric, 1.7171897252232722e-09, double { 1e+1 });
    double zeroLogit1 = test.GetCurrentTermScore(0, {}, 0);
    termScore = test.GetCurrentTermScore(0, {}, 1) - zeroLogit1;
-   CHECK_APPROX_TOLERANCE(termScore, -20.875723973004794, double { 1e-3 });
+   CHECK_APPROX_TOLERANCE(termScore, k_termScoreFinal, double { 1e-3 });
    termScore = test.GetCurrentTermScore(0, {}, 2) - zeroLogit1;
-   CHECK_APPROX_TOLERANCE(termScore, -20.875723973004794, double { 1e-3 });
+   CHECK_APPROX_TOLERANCE(termScore, k_termScoreFinal, double { 1e-3 });
 }
 
 TEST_CASE("Term with one feature with one or two states is the exact same as zero terms, boosting, regression") {
@@ -1650,6 +1657,47 @@ TEST_CASE("pair and main gain identical, boosting, regression") {
    CHECK_APPROX(gainAvg1, gainAvg2);
 }
 
+TEST_CASE("pair with empty bins matches pair without them, boosting, regression") {
+   // bins that have no samples cannot change which samples are on either side of a cut, so
+   // spreading the same samples over more bins should give the same pair gains and scores
+
+   std::vector<TestSample> samples1;
+   std::vector<TestSample> samples2;
+   for(IntEbm i = 0; i < 27; ++i) {
+      const IntEbm i0 = i % 3;
+      const IntEbm i1 = i / 3 % 3;
+      const double target = 1.0 + 0.5 * i0 - 0.75 * i1 * i1 + 0.125 * (i % 5);
+      const double weight = 1.0 + 0.25 * (i % 4);
+      samples1.push_back(TestSample({ i0, i1 }, target, weight));
+      samples2.push_back(TestSample({ i0 * 2, i1 * 2 }, target, weight));
+   }
+
+   TestApi test1 = TestApi(OutputType_Regression);
+   test1.AddFeatures({ FeatureTest(3), FeatureTest(3) });
+   test1.AddTerms({ { 0, 1 } });
+   test1.AddTrainingSamples(samples1);
+   test1.AddValidationSamples({});
+   test1.InitializeBoosting(0);
+
+   TestApi test2 = TestApi(OutputType_Regression);
+   test2.AddFeatures({ FeatureTest(5), FeatureTest(5) });
+   test2.AddTerms({ { 0, 1 } });
+   test2.AddTrainingSamples(samples2);
+   test2.AddValidationSamples({});
+   test2.InitializeBoosting(0);
+
+   for(int iEpoch = 0; iEpoch < 10; ++iEpoch) {
+      const double gainAvg1 = test1.Boost(0, BoostFlags_Default, k_learningRateDefault, 2).gainAvg;
+      const double gainAvg2 = test2.Boost(0, BoostFlags_Default, k_learningRateDefault, 2).gainAvg;
+      CHECK_APPROX(gainAvg1, gainAvg2);
+   }
+   for(size_t i0 = 0; i0 < 3; ++i0) {
+      for(size_t i1 = 0; i1 < 3; ++i1) {
+         CHECK_APPROX(test1.GetCurrentTermScore(0, { i0, i1 }, 0), test2.GetCurrentTermScore(0, { i0 * 2, i1 * 2 }, 0));
+      }
+   }
+}
+
 TEST_CASE("tweedie, boosting") {
    TestApi test = TestApi(OutputType_Regression, EBM_FALSE, "tweedie_deviance:variance_power=1.3");
    test.AddFeatures({ FeatureTest(2, true, false) });
@@ -1671,3 +1719,1316 @@ TEST_CASE("tweedie, boosting") {
    termScore = test.GetCurrentTermScore(0, {0}, 0);
    CHECK_APPROX(termScore, 2.3025076860047466);
 }
+
+static std::vector<double> BoostInZone(
+   const char * const sZone,
+   const OutputType outputType,
+   const char * const sObjective,
+   const IntEbm cBins = 3,
+   const IntEbm cSamples = 11
+) {
+   SetComputeZone(sZone);
+
+   // 11 samples is not a multiple of any SIMD pack size, so the tail handling gets exercised
+   TestApi test = TestApi(outputType, EBM_FALSE, sObjective);
+   test.AddFeatures({ FeatureTest(cBins) });
+   test.AddTerms({ { 0 } });
+   std::vector<TestSample> samples;
+   for(IntEbm i = 0; i < cSamples; ++i) {
+      samples.push_back(TestSample({ (i * 7) % cBins }, OutputType_Regression == outputType ? 1.5 + 0.25 * (i % 13) : (i % outputType), 1.0 + 0.125 * (i % 17)));
+   }
+   test.AddTrainingSamples(samples);
+   test.AddValidationSamples(samples);
+   test.InitializeBoosting();
+
+   std::vector<double> results;
+   for(int iEpoch = 0; iEpoch < 20; ++iEpoch) {
+      results.push_back(test.Boost(0).validationMetric);
+   }
+   for(IntEbm iBin = 0; iBin < cBins; ++iBin) {
+      results.push_back(test.GetCurrentTermScore(0, { static_cast<size_t>(iBin) }, 0));
+   }
+
+   SetComputeZone(nullptr);
+   return results;
+}
+
+static void CheckSimdZonesMatchCpu(
+   TestCaseHidden & testCaseHidden,
+   const OutputType outputType,
+   const char * const sObjective,
+   const IntEbm cBins = 3,
+   const IntEbm cSamples = 11
+) {
+   // hosts without AVX512F fall back to a lower zone, which still needs to match
+   const std::vector<double> cpu = BoostInZone("cpu", outputType, sObjective, cBins, cSamples);
+   for(const char * const sZone : { "avx2", "avx512f" }) {
+      const std::vector<double> simd = BoostInZone(sZone, outputType, sObjective, cBins, cSamples);
+      CHECK(cpu.size() == simd.size());
+      for(size_t i = 0; i < cpu.size(); ++i) {
+         CHECK_APPROX(cpu[i], simd[i]);
+      }
+   }
+}
+
+TEST_CASE("SIMD zone matches cpu zone, boosting, binary") {
+   CheckSimdZonesMatchCpu(testCaseHidden, OutputType_BinaryClassification, nullptr);
+}
+
+TEST_CASE("SIMD zone matches cpu zone, boosting, bit packs split across SIMD packs") {
+   // 40 bins takes 6 bits, so 10 items fit in each bit pack and the SIMD lanes straddle bit pack boundaries
+   CheckSimdZonesMatchCpu(testCaseHidden, OutputType_BinaryClassification, nullptr, 40, 203);
+}
+
+TEST_CASE("SIMD zone matches cpu zone, boosting, multiclass bit packs split across SIMD packs") {
+   // the multiclass objective unpacks the bit packs itself in the SIMD zones
+   CheckSimdZonesMatchCpu(testCaseHidden, 5, nullptr, 40, 203);
+}
+
+TEST_CASE("SIMD zone matches cpu zone, boosting, poisson") {
+   CheckSimdZonesMatchCpu(testCaseHidden, OutputType_Regression, "poisson_deviance");
+}
+
+TEST_CASE("SIMD zone matches cpu zone, boosting, gamma") {
+   // the log link calls Exp, and the deviance calls Log
+   CheckSimdZonesMatchCpu(testCaseHidden, OutputType_Regression, "gamma_deviance");
+}
+
+static std::vector<double> BoostWithThreads(
+   const char * const sThreads, 
+   const OutputType cClasses,
+   const IntEbm cSamples, 
+   const IntEbm cInnerBags, 
+   const CreateBoosterFlags flagsCreate = CreateBoosterFlags_Default,
+   const BoostFlags flags = BoostFlags_Default,
+   const IntEbm countThreads = 0
+) {
+   // the thread pool is sized when the booster is created, so set this before InitializeBoosting.  A non-zero
+   // countThreads overrides LIBEBM_THREADS
+   SetThreadCount(sThreads);
+
+   TestApi test = TestApi(cClasses);
+   test.AddFeatures({ FeatureTest(6), FeatureTest(4) });
+   test.AddTerms({ { 0 }, { 0, 1 } });
+   std::vector<TestSample> samples;
+   for(IntEbm i = 0; i < cSamples; ++i) {
+      samples.push_back(TestSample({ i % 6, (i / 7) % 4 }, static_cast<double>((i * 5 + i / 6) % cClasses), 
+         1.0 + 0.0625 * static_cast<double>(i % 29)));
+   }
+   test.AddTrainingSamples(samples);
+   // the metric is calculated on every update, so keep the validation set small for the larger training sets
+   test.AddValidationSamples(std::vector<TestSample>(samples.begin(), samples.begin() + std::min(cSamples, IntEbm { 97 })));
+   test.InitializeBoosting(cInnerBags, nullptr, flagsCreate, countThreads);
+
+   SetThreadCount(nullptr);
+
+   std::vector<double> results;
+   for(int iEpoch = 0; iEpoch < 5; ++iEpoch) {
+      for(size_t iTerm = 0; iTerm < 2; ++iTerm) {
+         const BoostRet ret = test.Boost(static_cast<IntEbm>(iTerm), flags);
+         results.push_back(ret.gainAvg);
+         results.push_back(ret.validationMetric);
+      }
+   }
+   for(size_t iBin = 0; iBin < 6; ++iBin) {
+      for(size_t iScore = 0; iScore < GetCountScores(cClasses); ++iScore) {
+         results.push_back(test.GetCurrentTermScore(0, { iBin }, iScore));
+      }
+   }
+   return results;
+}
+
+static void CheckThreadsMatch(
+   TestCaseHidden & testCaseHidden,
+   const std::vector<double> & threads1, 
+   const std::vector<double> & threads2
+) {
+   CHECK(threads1.size() == threads2.size());
+   for(size_t i = 0; i < threads1.size(); ++i) {
+      CHECK_APPROX(threads1[i], threads2[i]);
+   }
+}
+
+TEST_CASE("parallel inner bags match across thread counts, boosting, binary") {
+   const std::vector<double> threads2 = BoostWithThreads("2", OutputType_BinaryClassification, 29, 5);
+   const std::vector<double> threads3 = BoostWithThreads("3", OutputType_BinaryClassification, 29, 5);
+   const std::vector<double> threads3Again = BoostWithThreads("3", OutputType_BinaryClassification, 29, 5);
+   CheckThreadsMatch(testCaseHidden, threads2, threads3);
+   // the merge happens in a fixed order, so the same thread count gives identical results
+   CHECK(threads3 == threads3Again);
+}
+
+TEST_CASE("parallel inner bags match a single thread, boosting, binary") {
+   CheckThreadsMatch(
+      testCaseHidden,
+      BoostWithThreads("1", OutputType_BinaryClassification, 29, 5),
+      BoostWithThreads("3", OutputType_BinaryClassification, 29, 5)
+   );
+}
+
+TEST_CASE("parallel inner bags with random splits match across thread counts, boosting, binary") {
+   // a single thread keeps drawing from the caller's generator in bag order, so only 2 or more threads give
+   // each inner bag its own generator and make the random splits independent of the thread count
+   CheckThreadsMatch(
+      testCaseHidden,
+      BoostWithThreads("2", OutputType_BinaryClassification, 29, 5, CreateBoosterFlags_Default, BoostFlags_RandomSplits),
+      BoostWithThreads("3", OutputType_BinaryClassification, 29, 5, CreateBoosterFlags_Default, BoostFlags_RandomSplits)
+   );
+}
+
+TEST_CASE("countThreads overrides LIBEBM_THREADS, boosting, binary") {
+   const std::vector<double> environment = BoostWithThreads("3", OutputType_BinaryClassification, 29, 5);
+   const std::vector<double> argument = BoostWithThreads("1", OutputType_BinaryClassification, 29, 5, 
+      CreateBoosterFlags_Default, BoostFlags_Default, 3);
+   CHECK(environment == argument);
+}
+
+TEST_CASE("sharded histograms match single thread, boosting, binary") {
+   // enough samples that each histogram gets split into multiple shards, and 31 is not a multiple of the bit packing
+   CheckThreadsMatch(
+      testCaseHidden,
+      BoostWithThreads("1", OutputType_BinaryClassification, 50031, 0),
+      BoostWithThreads("3", OutputType_BinaryClassification, 50031, 0)
+   );
+}
+
+static void InitializeBoostRoundsTest(TestApi & test) {
+   test.AddFeatures({ FeatureTest(5), FeatureTest(3) });
+   test.AddTerms({ { 0 }, { 1 }, { 0, 1 } });
+   std::vector<TestSample> samples;
+   for(IntEbm i = 0; i < 37; ++i) {
+      samples.push_back(TestSample({ i % 5, (i / 5) % 3 }, 0.5 * (i % 5) - 0.25 * (i % 7)));
+   }
+   test.AddTrainingSamples(samples);
+   test.AddValidationSamples(samples);
+   test.InitializeBoosting();
+}
+
+TEST_CASE("BoostRounds cyclic matches GenerateTermUpdate loop, boosting, regression") {
+   TestApi test1 = TestApi(OutputType_Regression);
+   InitializeBoostRoundsTest(test1);
+   double metricMin = std::numeric_limits<double>::infinity();
+   for(int iRound = 0; iRound < 4; ++iRound) {
+      for(size_t iTerm = 0; iTerm < test1.GetCountTerms(); ++iTerm) {
+         const double metric = test1.Boost(static_cast<IntEbm>(iTerm)).validationMetric;
+         metricMin = metric < metricMin ? metric : metricMin;
+      }
+   }
+
+   TestApi test2 = TestApi(OutputType_Regression);
+   InitializeBoostRoundsTest(test2);
+   IntEbm cRounds = -1;
+   double bestMetric = 0.0;
+   const ErrorEbm error = BoostRounds(
+      test2.GetRng(),
+      test2.GetBoosterHandle(),
+      BoostFlags_Default,
+      k_learningRateDefault,
+      k_minSamplesLeafDefault,
+      &k_leavesMaxDefault[0],
+      0.0,
+      0,
+      4,
+      0,
+      0.0,
+      &cRounds,
+      &bestMetric
+   );
+   CHECK(Error_None == error);
+   CHECK(4 == cRounds);
+   CHECK(metricMin == bestMetric);
+   for(size_t iBin = 0; iBin < 5; ++iBin) {
+      CHECK(test1.GetCurrentTermScore(0, { iBin }, 0) == test2.GetCurrentTermScore(0, { iBin }, 0));
+   }
+   for(size_t iBin = 0; iBin < 3; ++iBin) {
+      CHECK(test1.GetCurrentTermScore(1, { iBin }, 0) == test2.GetCurrentTermScore(1, { iBin }, 0));
+   }
+}
+
+TEST_CASE("BoostRounds greedy and early stopping, boosting, regression") {
+   TestApi test = TestApi(OutputType_Regression);
+   InitializeBoostRoundsTest(test);
+   IntEbm cRounds = -1;
+   double bestMetric = 0.0;
+   ErrorEbm error = BoostRounds(
+      test.GetRng(),
+      test.GetBoosterHandle(),
+      BoostFlags_Default,
+      k_learningRateDefault,
+      k_minSamplesLeafDefault,
+      &k_leavesMaxDefault[0],
+      1.0,
+      1,
+      6,
+      0,
+      0.0,
+      &cRounds,
+      &bestMetric
+   );
+   CHECK(Error_None == error);
+   CHECK(6 == cRounds);
+   CHECK(std::isfinite(bestMetric));
+
+   // an enormous tolerance means no round is ever an improvement, so we stop after the first one
+   error = BoostRounds(
+      test.GetRng(),
+      test.GetBoosterHandle(),
+      BoostFlags_Default,
+      k_learningRateDefault,
+      k_minSamplesLeafDefault,
+      &k_leavesMaxDefault[0],
+      0.0,
+      0,
+      100,
+      1,
+      1e300,
+      &cRounds,
+      &bestMetric
+   );
+   CHECK(Error_None == error);
+   CHECK(1 == cRounds);
+}
+
+static std::vector<TestSample> MakeMostlyDefaultSamples(const bool bClassification, const bool bWeights) {
+   // Feature 0 declares 2 bins which packs 64 samples per word and stays dense, while feature 1 holds the same
+   // values but declares 3 bins which packs only 32 samples per word and tips DecideIfSparse into the sparse layout
+   std::vector<TestSample> samples;
+   for(size_t iSample = 0; iSample < 1000; ++iSample) {
+      const IntEbm iBin = 0 == iSample % 100 ? IntEbm { 0 } : IntEbm { 1 };
+      double target;
+      if(bClassification) {
+         target = 0 == iBin || 0 == iSample % 3 ? 1.0 : 0.0;
+      } else {
+         target = 0 == iBin ? 5.0 : 0.1 * static_cast<double>(iSample % 7);
+      }
+      if(bWeights) {
+         samples.push_back(TestSample({ iBin, iBin }, target, 0.5 + static_cast<double>(iSample % 5)));
+      } else {
+         samples.push_back(TestSample({ iBin, iBin }, target));
+      }
+   }
+   return samples;
+}
+
+TEST_CASE("sparse feature, boosting matches dense feature, regression") {
+   TestApi testDense = TestApi(OutputType_Regression);
+   testDense.AddFeatures({ FeatureTest(2), FeatureTest(3) });
+   testDense.AddTerms({ { 0 } });
+   testDense.AddTrainingSamples(MakeMostlyDefaultSamples(false, false));
+   testDense.AddValidationSamples({ TestSample({ 0, 0 }, 5.0), TestSample({ 1, 1 }, 0.3) });
+   testDense.InitializeBoosting(0);
+
+   TestApi testSparse = TestApi(OutputType_Regression);
+   testSparse.AddFeatures({ FeatureTest(2), FeatureTest(3) });
+   testSparse.AddTerms({ { 1 } });
+   testSparse.AddTrainingSamples(MakeMostlyDefaultSamples(false, false));
+   testSparse.AddValidationSamples({ TestSample({ 0, 0 }, 5.0), TestSample({ 1, 1 }, 0.3) });
+   testSparse.InitializeBoosting(0);
+
+   for(int iEpoch = 0; iEpoch < 50; ++iEpoch) {
+      const double validationMetricDense = testDense.Boost(0).validationMetric;
+      const double validationMetricSparse = testSparse.Boost(0).validationMetric;
+      CHECK_APPROX(validationMetricDense, validationMetricSparse);
+   }
+   CHECK_APPROX(testDense.GetCurrentTermScore(0, { 0 }, 0), testSparse.GetCurrentTermScore(0, { 0 }, 0));
+   CHECK_APPROX(testDense.GetCurrentTermScore(0, { 1 }, 0), testSparse.GetCurrentTermScore(0, { 1 }, 0));
+   CHECK(testSparse.GetCurrentTermScore(0, { 1 }, 0) < testSparse.GetCurrentTermScore(0, { 0 }, 0));
+}
+
+TEST_CASE("sparse feature, boosting matches dense feature, weights and inner bags, binary") {
+   TestApi testDense = TestApi(OutputType_BinaryClassification);
+   testDense.AddFeatures({ FeatureTest(2), FeatureTest(3) });
+   testDense.AddTerms({ { 0 } });
+   testDense.AddTrainingSamples(MakeMostlyDefaultSamples(true, true));
+   testDense.AddValidationSamples({ TestSample({ 0, 0 }, 1.0), TestSample({ 1, 1 }, 0.0) });
+   testDense.InitializeBoosting(3);
+
+   TestApi testSparse = TestApi(OutputType_BinaryClassification);
+   testSparse.AddFeatures({ FeatureTest(2), FeatureTest(3) });
+   testSparse.AddTerms({ { 1 } });
+   testSparse.AddTrainingSamples(MakeMostlyDefaultSamples(true, true));
+   testSparse.AddValidationSamples({ TestSample({ 0, 0 }, 1.0), TestSample({ 1, 1 }, 0.0) });
+   testSparse.InitializeBoosting(3);
+
+   for(int iEpoch = 0; iEpoch < 50; ++iEpoch) {
+      const double validationMetricDense = testDense.Boost(0).validationMetric;
+      const double validationMetricSparse = testSparse.Boost(0).validationMetric;
+      CHECK_APPROX(validationMetricDense, validationMetricSparse);
+   }
+   CHECK_APPROX(testDense.GetCurrentTermScore(0, { 0 }, 0), testSparse.GetCurrentTermScore(0, { 0 }, 0));
+   CHECK_APPROX(testDense.GetCurrentTermScore(0, { 1 }, 0), testSparse.GetCurrentTermScore(0, { 1 }, 0));
+}
+
+static std::vector<TestSample> MakeMetricSamples(const OutputType outputType) {
+   std::vector<TestSample> samples;
+   for(IntEbm i = 0; i < 23; ++i) {
+      const double target = OutputType_Regression == outputType ? 0.5 * (i % 4) - 0.25 * (i % 5) :
+         static_cast<double>(i % (OutputType_BinaryClassification == outputType ? 2 : 3));
+      samples.push_back(TestSample({ i % 4 }, target, 1.0 + 0.125 * (i % 3)));
+   }
+   return samples;
+}
+
+TEST_CASE("log_loss metric matches objective metric, boosting, binary") {
+   TestApi test1 = TestApi(OutputType_BinaryClassification);
+   test1.AddFeatures({ FeatureTest(4) });
+   test1.AddTerms({ { 0 } });
+   test1.AddTrainingSamples(MakeMetricSamples(OutputType_BinaryClassification));
+   test1.AddValidationSamples(MakeMetricSamples(OutputType_BinaryClassification));
+   test1.InitializeBoosting();
+
+   TestApi test2 = TestApi(OutputType_BinaryClassification);
+   test2.AddFeatures({ FeatureTest(4) });
+   test2.AddTerms({ { 0 } });
+   test2.AddTrainingSamples(MakeMetricSamples(OutputType_BinaryClassification));
+   test2.AddValidationSamples(MakeMetricSamples(OutputType_BinaryClassification));
+   test2.InitializeBoosting(k_countInnerBagsDefault, "log_loss");
+
+   for(int iEpoch = 0; iEpoch < 10; ++iEpoch) {
+      const double validationMetric1 = test1.Boost(0).validationMetric;
+      const double validationMetric2 = test2.Boost(0).validationMetric;
+      CHECK_APPROX(validationMetric1, validationMetric2);
+
+      double metric = 0.0;
+      const ErrorEbm error = GetValidationMetrics(test2.GetBoosterHandle(), 1, &metric);
+      CHECK(Error_None == error);
+      CHECK(validationMetric2 == metric);
+   }
+   CHECK(test1.GetCurrentTermScore(0, { 1 }, 0) == test2.GetCurrentTermScore(0, { 1 }, 0));
+}
+
+TEST_CASE("log_loss metric matches objective metric, boosting, multiclass") {
+   TestApi test1 = TestApi(3);
+   test1.AddFeatures({ FeatureTest(4) });
+   test1.AddTerms({ { 0 } });
+   test1.AddTrainingSamples(MakeMetricSamples(3));
+   test1.AddValidationSamples(MakeMetricSamples(3));
+   test1.InitializeBoosting();
+
+   TestApi test2 = TestApi(3);
+   test2.AddFeatures({ FeatureTest(4) });
+   test2.AddTerms({ { 0 } });
+   test2.AddTrainingSamples(MakeMetricSamples(3));
+   test2.AddValidationSamples(MakeMetricSamples(3));
+   test2.InitializeBoosting(k_countInnerBagsDefault, "log_loss");
+
+   for(int iEpoch = 0; iEpoch < 10; ++iEpoch) {
+      const double validationMetric1 = test1.Boost(0).validationMetric;
+      const double validationMetric2 = test2.Boost(0).validationMetric;
+      CHECK_APPROX(validationMetric1, validationMetric2);
+   }
+}
+
+TEST_CASE("rmse and mae metrics, boosting, regression") {
+   TestApi test1 = TestApi(OutputType_Regression);
+   test1.AddFeatures({ FeatureTest(4) });
+   test1.AddTerms({ { 0 } });
+   test1.AddTrainingSamples(MakeMetricSamples(OutputType_Regression));
+   test1.AddValidationSamples(MakeMetricSamples(OutputType_Regression));
+   test1.InitializeBoosting();
+
+   TestApi test2 = TestApi(OutputType_Regression);
+   test2.AddFeatures({ FeatureTest(4) });
+   test2.AddTerms({ { 0 } });
+   test2.AddTrainingSamples(MakeMetricSamples(OutputType_Regression));
+   test2.AddValidationSamples(MakeMetricSamples(OutputType_Regression));
+   test2.InitializeBoosting(k_countInnerBagsDefault, " rmse , , mae");
+
+   for(int iEpoch = 0; iEpoch < 10; ++iEpoch) {
+      // the objective's metric is the MSE
+      const double validationMetric1 = test1.Boost(0).validationMetric;
+      const double validationMetric2 = test2.Boost(0).validationMetric;
+      CHECK_APPROX(std::sqrt(validationMetric1), validationMetric2);
+   }
+
+   double metrics[2];
+   const ErrorEbm error = GetValidationMetrics(test2.GetBoosterHandle(), 2, metrics);
+   CHECK(Error_None == error);
+
+   double sumAbsError = 0.0;
+   double sumWeight = 0.0;
+   for(const TestSample & sample : MakeMetricSamples(OutputType_Regression)) {
+      const double prediction = test2.GetCurrentTermScore(0, { static_cast<size_t>(sample.m_sampleBinIndexes[0]) }, 0);
+      sumAbsError += sample.m_weight * std::abs(prediction - sample.m_target);
+      sumWeight += sample.m_weight;
+   }
+   CHECK_APPROX(sumAbsError / sumWeight, metrics[1]);
+}
+
+TEST_CASE("auc metric, boosting, binary") {
+   TestApi test = TestApi(OutputType_BinaryClassification);
+   test.AddFeatures({ FeatureTest(3) });
+   test.AddTerms({ { 0 } });
+   test.AddTrainingSamples({ TestSample({ 0 }, 0), TestSample({ 1 }, 1), TestSample({ 2 }, 0), TestSample({ 2 }, 1) });
+   // bin 2 gets a tied score for both classes which gives half credit
+   test.AddValidationSamples({ 
+      TestSample({ 0 }, 0), 
+      TestSample({ 1 }, 1), 
+      TestSample({ 1 }, 1), 
+      TestSample({ 2 }, 0), 
+      TestSample({ 2 }, 1)
+   });
+   test.InitializeBoosting(0, "auc,log_loss");
+
+   double validationMetric = 0.0;
+   for(int iEpoch = 0; iEpoch < 10; ++iEpoch) {
+      validationMetric = test.Boost(0).validationMetric;
+   }
+   // 2 negatives and 3 positives.  The bin 1 positives beat both negatives, and the bin 2 positive beats 
+   // the bin 0 negative and ties with the bin 2 negative
+   static constexpr double k_auc = (2.0 + 2.0 + 1.5) / 6.0;
+   // AUC is maximized, so it comes back negated for early stopping
+   CHECK_APPROX(-k_auc, validationMetric);
+
+   double metrics[2];
+   const ErrorEbm error = GetValidationMetrics(test.GetBoosterHandle(), 2, metrics);
+   CHECK(Error_None == error);
+   CHECK_APPROX(k_auc, metrics[0]);
+   CHECK(0.0 < metrics[1]);
+}
+
+TEST_CASE("auc metric, infinite score among equal scores, boosting, binary") {
+   TestApi test = TestApi(OutputType_BinaryClassification);
+   test.AddFeatures({ FeatureTest(2) });
+   test.AddTerms({ { 0 } });
+   test.AddTrainingSamples({ TestSample({ 0 }, 0, 1.0, { 0.0, 0.0 }), TestSample({ 1 }, 1, 1.0, { 0.0, 0.0 }) });
+   // the finite scores are all equal, so the bucket range is empty and the +infinity score has to be clamped.  The 
+   // test harness rejects infinite logits, but the difference between the two largest finite logits overflows
+   static constexpr double k_max = std::numeric_limits<double>::max();
+   test.AddValidationSamples({
+      TestSample({ 0 }, 0, 1.0, { 0.0, 0.0 }),
+      TestSample({ 0 }, 0, 1.0, { 0.0, 0.0 }),
+      TestSample({ 0 }, 1, 1.0, { 0.0, 0.0 }),
+      TestSample({ 0 }, 1, 1.0, { -k_max, k_max })
+   });
+   test.InitializeBoosting(0, "auc");
+
+   for(int iEpoch = 0; iEpoch < 3; ++iEpoch) {
+      test.Boost(0);
+   }
+
+   double metric;
+   const ErrorEbm error = GetValidationMetrics(test.GetBoosterHandle(), 1, &metric);
+   CHECK(Error_None == error);
+   // the infinite positive beats both negatives and the finite positive ties with them
+   CHECK_APPROX((2.0 + 1.0) / 4.0, metric);
+}
+
+TEST_CASE("best model snapshots only the terms updated since the last improvement, boosting, regression") {
+   TestApi test = TestApi(OutputType_Regression);
+   test.AddFeatures({ FeatureTest(4), FeatureTest(3) });
+   test.AddTerms({ { 0 }, { 1 }, { 0, 1 } });
+   std::vector<TestSample> trainingSamples;
+   std::vector<TestSample> validationSamples;
+   for(IntEbm i = 0; i < 31; ++i) {
+      trainingSamples.push_back(TestSample({ i % 4, (i / 4) % 3 }, 0.5 * (i % 4) - 0.75 * (i % 3)));
+      validationSamples.push_back(TestSample({ i % 4, (i / 3) % 3 }, 0.25 * (i % 5) - 0.5 * (i % 3)));
+   }
+   test.AddTrainingSamples(trainingSamples);
+   test.AddValidationSamples(validationSamples);
+   test.InitializeBoosting();
+
+   static constexpr size_t k_cTensorBins[] = { 4, 3, 12 };
+   std::vector<std::vector<double>> expectedBest = { std::vector<double>(4), std::vector<double>(3), std::vector<double>(12) };
+   double bestMetric = std::numeric_limits<double>::infinity();
+   size_t cImprovements = 0;
+   size_t cRegressions = 0;
+   for(int iRound = 0; iRound < 20; ++iRound) {
+      for(size_t iTerm = 0; iTerm < test.GetCountTerms(); ++iTerm) {
+         // a large learning rate overshoots so that some steps do not improve the validation metric
+         const double metric = test.Boost(static_cast<IntEbm>(iTerm), BoostFlags_Default, 0.75).validationMetric;
+         if(metric < bestMetric) {
+            bestMetric = metric;
+            ++cImprovements;
+            for(size_t iTermCopy = 0; iTermCopy < test.GetCountTerms(); ++iTermCopy) {
+               test.GetCurrentTermScoresRaw(iTermCopy, &expectedBest[iTermCopy][0]);
+            }
+         } else {
+            ++cRegressions;
+         }
+      }
+   }
+   CHECK(0 != cImprovements);
+   CHECK(0 != cRegressions);
+
+   for(size_t iTerm = 0; iTerm < test.GetCountTerms(); ++iTerm) {
+      std::vector<double> best(k_cTensorBins[iTerm]);
+      test.GetBestTermScoresRaw(iTerm, &best[0]);
+      for(size_t iBin = 0; iBin < k_cTensorBins[iTerm]; ++iBin) {
+         CHECK(expectedBest[iTerm][iBin] == best[iBin]);
+      }
+   }
+}
+
+TEST_CASE("validation metric interval, boosting, multiclass") {
+   TestApi test1 = TestApi(3);
+   test1.AddFeatures({ FeatureTest(4) });
+   test1.AddTerms({ { 0 } });
+   test1.AddTrainingSamples(MakeMetricSamples(3));
+   test1.AddValidationSamples(MakeMetricSamples(3));
+   test1.InitializeBoosting();
+
+   TestApi test2 = TestApi(3);
+   test2.AddFeatures({ FeatureTest(4) });
+   test2.AddTerms({ { 0 } });
+   test2.AddTrainingSamples(MakeMetricSamples(3));
+   test2.AddValidationSamples(MakeMetricSamples(3));
+   test2.InitializeBoosting();
+   const ErrorEbm error = SetValidationMetricInterval(test2.GetBoosterHandle(), 3);
+   CHECK(Error_None == error);
+
+   double lastMetric = std::numeric_limits<double>::infinity();
+   for(int iEpoch = 1; iEpoch <= 12; ++iEpoch) {
+      const double validationMetric1 = test1.Boost(0).validationMetric;
+      const double validationMetric2 = test2.Boost(0).validationMetric;
+      // the first update after SetValidationMetricInterval calculates the metric, then every third one does
+      if(1 == iEpoch % 3) {
+         CHECK(validationMetric1 == validationMetric2);
+         lastMetric = validationMetric1;
+      } else {
+         CHECK(lastMetric == validationMetric2);
+      }
+      CHECK(std::isfinite(validationMetric2));
+   }
+   // skipping the metric still updates the validation scores, so the metric is current after each skip
+   for(size_t iBin = 0; iBin < 4; ++iBin) {
+      for(size_t iScore = 0; iScore < 3; ++iScore) {
+         CHECK(test1.GetCurrentTermScore(0, { iBin }, iScore) == test2.GetCurrentTermScore(0, { iBin }, iScore));
+      }
+   }
+}
+
+TEST_CASE("validation metric interval, BoostRounds calculates the metric at round boundaries, boosting, regression") {
+   TestApi test1 = TestApi(OutputType_Regression);
+   InitializeBoostRoundsTest(test1);
+   double metricMin = std::numeric_limits<double>::infinity();
+   for(int iRound = 0; iRound < 3; ++iRound) {
+      double metric = 0.0;
+      for(size_t iTerm = 0; iTerm < test1.GetCountTerms(); ++iTerm) {
+         metric = test1.Boost(static_cast<IntEbm>(iTerm)).validationMetric;
+      }
+      metricMin = metric < metricMin ? metric : metricMin;
+   }
+
+   TestApi test2 = TestApi(OutputType_Regression);
+   InitializeBoostRoundsTest(test2);
+   ErrorEbm error = SetValidationMetricInterval(test2.GetBoosterHandle(), 1000);
+   CHECK(Error_None == error);
+   IntEbm cRounds = -1;
+   double bestMetric = 0.0;
+   error = BoostRounds(
+      test2.GetRng(),
+      test2.GetBoosterHandle(),
+      BoostFlags_Default,
+      k_learningRateDefault,
+      k_minSamplesLeafDefault,
+      &k_leavesMaxDefault[0],
+      0.0,
+      0,
+      3,
+      0,
+      0.0,
+      &cRounds,
+      &bestMetric
+   );
+   CHECK(Error_None == error);
+   CHECK(3 == cRounds);
+   CHECK(metricMin == bestMetric);
+}
+
+static std::vector<double> BoostTargets(
+   TestCaseHidden & testCaseHidden,
+   const IntEbm countClasses,
+   const std::vector<std::vector<double>> & targets
+) {
+   // countClasses of 0 means regression.  Every target shares the one feature and the one term
+   static constexpr IntEbm k_cSamples = 6;
+   static constexpr IntEbm k_cBins = 3;
+   static const IntEbm binIndexes[k_cSamples] { 0, 1, 2, 0, 1, 2 };
+   static constexpr IntEbm k_dimensionCounts[1] { 1 };
+   static constexpr IntEbm k_featureIndexes[1] { 0 };
+
+   const IntEbm cTargets = static_cast<IntEbm>(targets.size());
+
+   IntEbm sum = 0;
+   IntEbm part;
+   ErrorEbm error;
+
+   part = MeasureDataSetHeader(1, 0, cTargets);
+   CHECK(0 <= part);
+   sum += part;
+
+   part = MeasureFeature(k_cBins, EBM_TRUE, EBM_TRUE, EBM_FALSE, k_cSamples, &binIndexes[0]);
+   CHECK(0 <= part);
+   sum += part;
+
+   std::vector<std::vector<IntEbm>> classTargets;
+   for(const std::vector<double> & target : targets) {
+      CHECK(k_cSamples == static_cast<IntEbm>(target.size()));
+      if(IntEbm { 0 } == countClasses) {
+         part = MeasureRegressionTarget(k_cSamples, &target[0]);
+      } else {
+         classTargets.push_back(std::vector<IntEbm>(target.begin(), target.end()));
+         part = MeasureClassificationTarget(countClasses, k_cSamples, &classTargets.back()[0]);
+      }
+      CHECK(0 <= part);
+      sum += part;
+   }
+
+   std::vector<char> buffer(static_cast<size_t>(sum));
+
+   error = FillDataSetHeader(1, 0, cTargets, sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = FillFeature(k_cBins, EBM_TRUE, EBM_TRUE, EBM_FALSE, k_cSamples, &binIndexes[0], sum, &buffer[0]);
+   CHECK(Error_None == error);
+   for(size_t iTarget = 0; iTarget < targets.size(); ++iTarget) {
+      if(IntEbm { 0 } == countClasses) {
+         error = FillRegressionTarget(k_cSamples, &targets[iTarget][0], sum, &buffer[0]);
+      } else {
+         error = FillClassificationTarget(countClasses, k_cSamples, &classTargets[iTarget][0], sum, &buffer[0]);
+      }
+      CHECK(Error_None == error);
+   }
+
+   BoosterHandle boosterHandle;
+   error = CreateBooster(
+      nullptr,
+      &buffer[0],
+      nullptr,
+      nullptr,
+      1,
+      &k_dimensionCounts[0],
+      &k_featureIndexes[0],
+      0,
+      EBM_FALSE,
+      IntEbm { 0 } == countClasses ? "rmse" : "log_loss",
+      nullptr,
+      0,
+      nullptr,
+      &boosterHandle
+   );
+   CHECK(Error_None == error);
+
+   for(int iEpoch = 0; iEpoch < 10; ++iEpoch) {
+      double avgGain;
+      error = GenerateTermUpdate(
+         nullptr,
+         boosterHandle,
+         0,
+         BoostFlags_Default,
+         k_learningRateDefault,
+         k_minSamplesLeafDefault,
+         &k_leavesMaxDefault[0],
+         &avgGain
+      );
+      CHECK(Error_None == error);
+      double avgValidationMetric;
+      error = ApplyTermUpdate(boosterHandle, &avgValidationMetric);
+      CHECK(Error_None == error);
+   }
+
+   const size_t cTaskScores = IntEbm { 2 } < countClasses ? static_cast<size_t>(countClasses) : size_t { 1 };
+   std::vector<double> termScores(static_cast<size_t>(k_cBins) * cTaskScores * targets.size());
+   error = GetCurrentTermScores(boosterHandle, 0, &termScores[0]);
+   CHECK(Error_None == error);
+
+   FreeBooster(boosterHandle);
+   return termScores;
+}
+
+static void CheckMultitaskMatchesSingleTask(
+   TestCaseHidden & testCaseHidden,
+   const IntEbm countClasses,
+   const std::vector<std::vector<double>> & targets
+) {
+   // the tasks do not interact except through the shared splits, and every split is worth making here
+   const std::vector<double> multitaskScores = BoostTargets(testCaseHidden, countClasses, targets);
+   const size_t cTasks = targets.size();
+   for(size_t iTask = 0; iTask < cTasks; ++iTask) {
+      const std::vector<double> singleScores = BoostTargets(testCaseHidden, countClasses, { targets[iTask] });
+      const size_t cTaskScores = singleScores.size() / 3;
+      for(size_t iBin = 0; iBin < 3; ++iBin) {
+         for(size_t iScore = 0; iScore < cTaskScores; ++iScore) {
+            const double multitaskScore = multitaskScores[(iBin * cTasks + iTask) * cTaskScores + iScore];
+            CHECK_APPROX(multitaskScore, singleScores[iBin * cTaskScores + iScore]);
+         }
+      }
+   }
+}
+
+TEST_CASE("multitask matches separate boosters, boosting, binary") {
+   CheckMultitaskMatchesSingleTask(testCaseHidden, 2, { { 0, 1, 1, 0, 0, 1 }, { 1, 0, 1, 1, 0, 0 } });
+}
+
+TEST_CASE("multitask matches separate boosters, boosting, multiclass") {
+   CheckMultitaskMatchesSingleTask(testCaseHidden, 3, { { 0, 1, 2, 0, 2, 2 }, { 2, 0, 1, 1, 0, 0 } });
+}
+
+TEST_CASE("multitask matches separate boosters, boosting, regression") {
+   CheckMultitaskMatchesSingleTask(testCaseHidden, 0, { { 1.5, 2.5, 7.0, 0.5, 3.0, 8.5 }, { -4.0, 2.0, 1.0, -3.0, 1.0, 0.5 } });
+}
+
+TEST_CASE("multitask rejects mixed target types, boosting") {
+   static constexpr IntEbm k_cSamples = 2;
+   static const IntEbm classes[k_cSamples] { 0, 1 };
+   static const double values[k_cSamples] { 1.0, 2.0 };
+
+   IntEbm sum = 0;
+   sum += MeasureDataSetHeader(0, 0, 2);
+   sum += MeasureClassificationTarget(2, k_cSamples, &classes[0]);
+   sum += MeasureRegressionTarget(k_cSamples, &values[0]);
+
+   std::vector<char> buffer(static_cast<size_t>(sum));
+   ErrorEbm error;
+   error = FillDataSetHeader(0, 0, 2, sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = FillClassificationTarget(2, k_cSamples, &classes[0], sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = FillRegressionTarget(k_cSamples, &values[0], sum, &buffer[0]);
+   CHECK(Error_None == error);
+
+   BoosterHandle boosterHandle = nullptr;
+   error = CreateBooster(
+      nullptr,
+      &buffer[0],
+      nullptr,
+      nullptr,
+      0,
+      nullptr,
+      nullptr,
+      0,
+      EBM_FALSE,
+      "log_loss",
+      nullptr,
+      0,
+      nullptr,
+      &boosterHandle
+   );
+   CHECK(Error_IllegalParamVal == error);
+   CHECK(nullptr == boosterHandle);
+}
+
+TEST_CASE("negative countThreads, boosting") {
+   static constexpr IntEbm k_cSamples = 2;
+   static const double values[k_cSamples] { 1.0, 2.0 };
+
+   IntEbm sum = 0;
+   sum += MeasureDataSetHeader(0, 0, 1);
+   sum += MeasureRegressionTarget(k_cSamples, &values[0]);
+
+   std::vector<char> buffer(static_cast<size_t>(sum));
+   ErrorEbm error;
+   error = FillDataSetHeader(0, 0, 1, sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = FillRegressionTarget(k_cSamples, &values[0], sum, &buffer[0]);
+   CHECK(Error_None == error);
+
+   BoosterHandle boosterHandle = nullptr;
+   error = CreateBooster(
+      nullptr,
+      &buffer[0],
+      nullptr,
+      nullptr,
+      0,
+      nullptr,
+      nullptr,
+      0,
+      CreateBoosterFlags_Default,
+      "rmse",
+      nullptr,
+      -1,
+      nullptr,
+      &boosterHandle
+   );
+   CHECK(Error_IllegalParamVal == error);
+   CHECK(nullptr == boosterHandle);
+}
+
+static void InitializeFusedBinsTestApi(TestApi & test, const OutputType cClasses) {
+   // enough samples to need several fused chunks plus a partial chunk at the start
+   static constexpr size_t k_cSamples = 20011;
+
+   test.AddFeatures({ FeatureTest(5), FeatureTest(11), FeatureTest(3) });
+   test.AddTerms({ { 0 }, { 1 }, { 0, 2 }, { 1, 2 } });
+
+   std::vector<TestSample> samples;
+   for(size_t iSample = 0; iSample < k_cSamples; ++iSample) {
+      const IntEbm bin0 = static_cast<IntEbm>(iSample * 7 % 5);
+      const IntEbm bin1 = static_cast<IntEbm>(iSample * 13 % 11);
+      const IntEbm bin2 = static_cast<IntEbm>(iSample % 3);
+      const double target = OutputType_Regression == cClasses ? 
+         static_cast<double>(bin0 + bin1) - static_cast<double>(bin2) * 0.5 :
+         static_cast<double>((iSample * 31 + static_cast<size_t>(bin1)) % static_cast<size_t>(cClasses));
+      samples.push_back(TestSample({ bin0, bin1, bin2 }, target));
+   }
+   test.AddTrainingSamples(samples);
+   test.AddValidationSamples({ TestSample({ 1, 2, 0 }, 1), TestSample({ 4, 10, 2 }, 0) });
+   test.InitializeBoosting();
+}
+
+TEST_CASE("SetNextTerm fuses the next histogram without changing the model, boosting") {
+   for(const OutputType cClasses : { OutputType_Regression, OutputType { 2 }, OutputType { 3 } }) {
+      TestApi test1 = TestApi(cClasses);
+      InitializeFusedBinsTestApi(test1, cClasses);
+      TestApi test2 = TestApi(cClasses);
+      InitializeFusedBinsTestApi(test2, cClasses);
+
+      const IntEbm cTerms = static_cast<IntEbm>(test1.GetCountTerms());
+      for(int iRound = 0; iRound < 4; ++iRound) {
+         for(IntEbm iTerm = 0; iTerm < cTerms; ++iTerm) {
+            const BoostRet boostRet1 = test1.Boost(iTerm);
+
+            const ErrorEbm error = SetNextTerm(test2.GetBoosterHandle(), (iTerm + 1) % cTerms);
+            CHECK(Error_None == error);
+            const BoostRet boostRet2 = test2.Boost(iTerm);
+
+            CHECK(boostRet1.gainAvg == boostRet2.gainAvg);
+            CHECK(boostRet1.validationMetric == boostRet2.validationMetric);
+         }
+      }
+
+      for(size_t iTerm = 0; iTerm < test1.GetCountTerms(); ++iTerm) {
+         std::vector<double> termScores1(size_t { 1024 }, 0.0);
+         std::vector<double> termScores2(size_t { 1024 }, 0.0);
+         test1.GetCurrentTermScoresRaw(iTerm, &termScores1[0]);
+         test2.GetCurrentTermScoresRaw(iTerm, &termScores2[0]);
+         CHECK(termScores1 == termScores2);
+      }
+   }
+}
+
+TEST_CASE("SetNextTerm histogram is not used after another view changes the gradients, boosting, regression") {
+   TestApi test1 = TestApi(OutputType_Regression);
+   InitializeFusedBinsTestApi(test1, OutputType_Regression);
+   TestApi test2 = TestApi(OutputType_Regression);
+   InitializeFusedBinsTestApi(test2, OutputType_Regression);
+
+   BoosterHandle boosterHandleView = nullptr;
+   ErrorEbm error = CreateBoosterView(test2.GetBoosterHandle(), &boosterHandleView);
+   CHECK(Error_None == error);
+
+   double gainAvg;
+   double validationMetric;
+   for(int iRound = 0; iRound < 4; ++iRound) {
+      // the view fuses the histogram of term 0, then the other view changes the gradients before it is used
+      error = SetNextTerm(boosterHandleView, 0);
+      CHECK(Error_None == error);
+      for(int iView = 0; iView < 2; ++iView) {
+         error = GenerateTermUpdate(nullptr, boosterHandleView, 0, BoostFlags_Default, k_learningRateDefault, 
+            k_minSamplesLeafDefault, &k_leavesMaxDefault[0], &gainAvg);
+         CHECK(Error_None == error);
+         error = ApplyTermUpdate(boosterHandleView, &validationMetric);
+         CHECK(Error_None == error);
+         CHECK(test1.Boost(0).validationMetric == validationMetric);
+
+         CHECK(test1.Boost(0).validationMetric == test2.Boost(0).validationMetric);
+      }
+   }
+
+   for(size_t iTerm = 0; iTerm < test1.GetCountTerms(); ++iTerm) {
+      std::vector<double> termScores1(size_t { 1024 }, 0.0);
+      std::vector<double> termScores2(size_t { 1024 }, 0.0);
+      test1.GetCurrentTermScoresRaw(iTerm, &termScores1[0]);
+      test2.GetCurrentTermScoresRaw(iTerm, &termScores2[0]);
+      CHECK(termScores1 == termScores2);
+   }
+
+   FreeBooster(boosterHandleView);
+}
+
+TEST_CASE("inner bag histograms summed in one pass match across thread counts, boosting, multiclass") {
+   // a single thread sums all twenty inner bags in one pass, while each of the four threads sums its own five
+   CheckThreadsMatch(testCaseHidden, BoostWithThreads("1", 3, 3001, 20), BoostWithThreads("4", 3, 3001, 20));
+}
+
+static std::vector<double> BoostInnerBags(const bool bLargeTerm) {
+   static constexpr IntEbm k_cInnerBags = 64;
+
+   TestApi test = TestApi(3);
+   test.AddFeatures({ FeatureTest(6), FeatureTest(4), FeatureTest(256), FeatureTest(256) });
+   // the third term is never boosted.  Its 65536 bins per inner bag are too many to hold the histograms of all
+   // the inner bags at once, which makes every term sum each inner bag with its own pass over the samples
+   test.AddTerms({ { 0 }, { 0, 1 }, bLargeTerm ? std::vector<size_t> { 2, 3 } : std::vector<size_t> { 2 } });
+   std::vector<TestSample> samples;
+   for(IntEbm i = 0; i < 3001; ++i) {
+      samples.push_back(TestSample({ i % 6, (i / 7) % 4, i % 256, (i / 3) % 256 }, 
+         static_cast<double>((i * 5 + i / 6) % 3), 1.0 + 0.0625 * static_cast<double>(i % 29)));
+   }
+   test.AddTrainingSamples(samples);
+   test.AddValidationSamples(std::vector<TestSample>(samples.begin(), samples.begin() + 97));
+   test.InitializeBoosting(k_cInnerBags);
+
+   std::vector<double> results;
+   for(int iEpoch = 0; iEpoch < 5; ++iEpoch) {
+      for(size_t iTerm = 0; iTerm < 2; ++iTerm) {
+         const BoostRet ret = test.Boost(static_cast<IntEbm>(iTerm));
+         results.push_back(ret.gainAvg);
+         results.push_back(ret.validationMetric);
+      }
+   }
+   for(size_t iBin0 = 0; iBin0 < 6; ++iBin0) {
+      for(size_t iScore = 0; iScore < 3; ++iScore) {
+         results.push_back(test.GetCurrentTermScore(0, { iBin0 }, iScore));
+         for(size_t iBin1 = 0; iBin1 < 4; ++iBin1) {
+            results.push_back(test.GetCurrentTermScore(1, { iBin0, iBin1 }, iScore));
+         }
+      }
+   }
+   return results;
+}
+
+TEST_CASE("inner bag histograms summed in one pass exactly match summing each inner bag, boosting, multiclass") {
+   // both paths add the samples of each inner bag in the same order, so the models are identical
+   const std::vector<double> onePass = BoostInnerBags(false);
+   const std::vector<double> eachInnerBag = BoostInnerBags(true);
+   CHECK(onePass == eachInnerBag);
+}
+
+TEST_CASE("subsampled inner bags match across thread counts, boosting, binary") {
+   // enough samples that the histograms are summed in shards, which start part way into the sample bits
+   const std::vector<double> threads1 = 
+      BoostWithThreads("1", OutputType_BinaryClassification, 40001, 3, CreateBoosterFlags_InnerBagsSubsample);
+   const std::vector<double> threads3 = 
+      BoostWithThreads("3", OutputType_BinaryClassification, 40001, 3, CreateBoosterFlags_InnerBagsSubsample);
+   CheckThreadsMatch(testCaseHidden, threads1, threads3);
+   CHECK(0 < threads1[0]);
+}
+
+static double GradientSumOfInnerBags(
+   TestCaseHidden & testCaseHidden,
+   const IntEbm cSamples, 
+   const double weight, 
+   const IntEbm cInnerBags, 
+   const CreateBoosterFlags flagsCreate
+) {
+   // an intercept only regression with every target at 1 starts with the same gradient on every sample, so
+   // the gradient sums of the update are proportional to the weight total of the inner bags
+   TestApi test = TestApi(OutputType_Regression);
+   test.AddFeatures({});
+   test.AddTerms({ {} });
+   test.AddTrainingSamples(std::vector<TestSample>(static_cast<size_t>(cSamples), TestSample({}, 1.0, weight)));
+   test.AddValidationSamples({ TestSample({}, 1.0) });
+   test.InitializeBoosting(cInnerBags, nullptr, flagsCreate);
+
+   double gainAvg;
+   ErrorEbm error = GenerateTermUpdate(nullptr, test.GetBoosterHandle(), 0, BoostFlags_GradientSums, 
+      k_learningRateDefault, k_minSamplesLeafDefault, &k_leavesMaxDefault[0], &gainAvg);
+   CHECK(Error_None == error);
+   double updateScore = 0.0;
+   error = GetTermUpdate(test.GetBoosterHandle(), &updateScore);
+   CHECK(Error_None == error);
+   return updateScore;
+}
+
+TEST_CASE("subsampled inner bags select the expected samples once each, boosting, regression") {
+   static constexpr IntEbm k_cSamples = 1001;
+   // each subsample picks floor(n * (1 - 1/e)) samples without replacement, which is the expected number of
+   // distinct samples in a bootstrap sample
+   const double cSelected = std::floor(static_cast<double>(k_cSamples) * (1.0 - std::exp(-1.0)));
+   for(const double weight : { 1.0, 0.25 }) {
+      const double all = GradientSumOfInnerBags(testCaseHidden, k_cSamples, weight, 0, CreateBoosterFlags_Default);
+      // with replacement the occurrences of a bag add up to n, so this also fails if any sample is counted twice
+      const double subsampled = GradientSumOfInnerBags(testCaseHidden, k_cSamples, weight, 3, CreateBoosterFlags_InnerBagsSubsample);
+      CHECK(0.0 != all);
+      CHECK_APPROX(cSelected / static_cast<double>(k_cSamples), subsampled / all);
+   }
+}
+
+static std::vector<double> BoostOuterBags(
+   TestCaseHidden & testCaseHidden,
+   const bool bShared,
+   const char * const sObjective,
+   const IntEbm cInnerBags,
+   const bool bReplication
+) {
+   static constexpr IntEbm k_cSamples = 36;
+   static constexpr IntEbm k_cBags = 3;
+   static constexpr IntEbm k_cBins0 = 4;
+   static constexpr IntEbm k_cBins1 = 3;
+   static constexpr IntEbm k_cTerms = 3;
+   static constexpr IntEbm k_dimensionCounts[k_cTerms] { 1, 1, 2 };
+   static constexpr IntEbm k_featureIndexes[4] { 0, 1, 0, 1 };
+   static constexpr size_t k_cTensorBins[k_cTerms] { 4, 3, 12 };
+
+   const bool bClassification = 0 == strcmp(sObjective, "log_loss");
+
+   std::vector<IntEbm> binIndexes0;
+   std::vector<IntEbm> binIndexes1;
+   std::vector<IntEbm> classes;
+   std::vector<double> values;
+   std::vector<double> initScores;
+   std::vector<BagEbm> bags;
+   for(IntEbm i = 0; i < k_cSamples; ++i) {
+      binIndexes0.push_back(i % k_cBins0);
+      // every bag has training samples in all 12 cells of the pair.  An empty cell takes its score from whichever
+      // cuts win, and cuts that tie exactly can be won either way by float32 rounding
+      binIndexes1.push_back(i / 3 % k_cBins1);
+      classes.push_back((i * 7) % 5 < 2 ? 1 : 0);
+      values.push_back(static_cast<double>(i % k_cBins0) * 1.5 - static_cast<double>(i % 5));
+      initScores.push_back(0.05 * static_cast<double>(i * 3 % 13));
+   }
+   for(IntEbm iBag = 0; iBag < k_cBags; ++iBag) {
+      for(IntEbm i = 0; i < k_cSamples; ++i) {
+         // every bag holds out a different set of validation samples and leaves a few samples out entirely
+         static const BagEbm k_bagValues[6] { 1, -1, 2, 0, 1, 1 };
+         const BagEbm replication = k_bagValues[(i + iBag * 2) % 6];
+         bags.push_back(bReplication || replication <= BagEbm { 1 } ? replication : BagEbm { 1 });
+      }
+   }
+
+   IntEbm sum = 0;
+   sum += MeasureDataSetHeader(2, 0, 1);
+   sum += MeasureFeature(k_cBins0, EBM_TRUE, EBM_TRUE, EBM_FALSE, k_cSamples, &binIndexes0[0]);
+   sum += MeasureFeature(k_cBins1, EBM_TRUE, EBM_TRUE, EBM_FALSE, k_cSamples, &binIndexes1[0]);
+   sum += bClassification ? MeasureClassificationTarget(2, k_cSamples, &classes[0]) :
+      MeasureRegressionTarget(k_cSamples, &values[0]);
+
+   std::vector<char> buffer(static_cast<size_t>(sum));
+   ErrorEbm error;
+   error = FillDataSetHeader(2, 0, 1, sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = FillFeature(k_cBins0, EBM_TRUE, EBM_TRUE, EBM_FALSE, k_cSamples, &binIndexes0[0], sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = FillFeature(k_cBins1, EBM_TRUE, EBM_TRUE, EBM_FALSE, k_cSamples, &binIndexes1[0], sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = bClassification ? FillClassificationTarget(2, k_cSamples, &classes[0], sum, &buffer[0]) :
+      FillRegressionTarget(k_cSamples, &values[0], sum, &buffer[0]);
+   CHECK(Error_None == error);
+
+   // both ways draw the inner bags of each outer bag in turn from the same random state
+   std::vector<unsigned char> rng(static_cast<size_t>(MeasureRNG()));
+   InitRNG(42, &rng[0]);
+
+   BoosterHandle boosterHandles[k_cBags];
+   if(bShared) {
+      // CreateBoosterBags takes the init scores of every sample for each bag
+      std::vector<double> bagsInitScores;
+      for(IntEbm iBag = 0; iBag < k_cBags; ++iBag) {
+         bagsInitScores.insert(bagsInitScores.end(), initScores.begin(), initScores.end());
+      }
+      error = CreateBoosterBags(
+         &rng[0],
+         &buffer[0],
+         k_cBags,
+         &bags[0],
+         &bagsInitScores[0],
+         k_cTerms,
+         &k_dimensionCounts[0],
+         &k_featureIndexes[0],
+         cInnerBags,
+         CreateBoosterFlags_Default,
+         sObjective,
+         nullptr,
+         0,
+         nullptr,
+         &boosterHandles[0]
+      );
+      CHECK(Error_None == error);
+   } else {
+      for(IntEbm iBag = 0; iBag < k_cBags; ++iBag) {
+         const BagEbm * const aBag = &bags[static_cast<size_t>(iBag * k_cSamples)];
+         // CreateBooster only takes the init scores of the samples in the bag
+         std::vector<double> bagInitScores;
+         for(IntEbm i = 0; i < k_cSamples; ++i) {
+            if(BagEbm { 0 } != aBag[i]) {
+               bagInitScores.push_back(initScores[static_cast<size_t>(i)]);
+            }
+         }
+         error = CreateBooster(
+            &rng[0],
+            &buffer[0],
+            aBag,
+            &bagInitScores[0],
+            k_cTerms,
+            &k_dimensionCounts[0],
+            &k_featureIndexes[0],
+            cInnerBags,
+            CreateBoosterFlags_Default,
+            sObjective,
+            nullptr,
+            0,
+            nullptr,
+            &boosterHandles[iBag]
+         );
+         CHECK(Error_None == error);
+      }
+   }
+
+   IntEbm cRounds[k_cBags];
+   double bestMetrics[k_cBags];
+   if(bShared) {
+      error = BoostRoundsBags(
+         k_cBags,
+         nullptr,
+         &boosterHandles[0],
+         BoostFlags_Default,
+         k_learningRateDefault,
+         k_minSamplesLeafDefault,
+         &k_leavesMaxDefault[0],
+         0.0,
+         0,
+         5,
+         0,
+         0.0,
+         &cRounds[0],
+         &bestMetrics[0]
+      );
+      CHECK(Error_None == error);
+   } else {
+      for(IntEbm iBag = 0; iBag < k_cBags; ++iBag) {
+         error = BoostRounds(
+            nullptr,
+            boosterHandles[iBag],
+            BoostFlags_Default,
+            k_learningRateDefault,
+            k_minSamplesLeafDefault,
+            &k_leavesMaxDefault[0],
+            0.0,
+            0,
+            5,
+            0,
+            0.0,
+            &cRounds[iBag],
+            &bestMetrics[iBag]
+         );
+         CHECK(Error_None == error);
+      }
+   }
+
+   std::vector<double> results;
+   for(IntEbm iBag = 0; iBag < k_cBags; ++iBag) {
+      CHECK(5 == cRounds[iBag]);
+      results.push_back(bestMetrics[iBag]);
+      for(IntEbm iTerm = 0; iTerm < k_cTerms; ++iTerm) {
+         std::vector<double> termScores(k_cTensorBins[iTerm]);
+         error = GetCurrentTermScores(boosterHandles[iBag], iTerm, &termScores[0]);
+         CHECK(Error_None == error);
+         results.insert(results.end(), termScores.begin(), termScores.end());
+      }
+      FreeBooster(boosterHandles[iBag]);
+   }
+   return results;
+}
+
+static void CheckOuterBagsMatchSeparateBoosters(
+   TestCaseHidden & testCaseHidden,
+   const char * const sObjective,
+   const IntEbm cInnerBags,
+   const bool bReplication = true
+) {
+   const std::vector<double> separate = BoostOuterBags(testCaseHidden, false, sObjective, cInnerBags, bReplication);
+
+   // the boosters get their own share of the threads, so run them in parallel with more than one thread each
+   SetThreadCount("4");
+   const std::vector<double> shared = BoostOuterBags(testCaseHidden, true, sObjective, cInnerBags, bReplication);
+   SetThreadCount(nullptr);
+
+   CHECK(separate.size() == shared.size());
+   if(bReplication || IntEbm { 0 } != cInnerBags) {
+      for(size_t i = 0; i < separate.size(); ++i) {
+         CHECK_APPROX(separate[i], shared[i]);
+      }
+   } else {
+      // a bag that selects each sample at most once is kept as sample bits, which add the same gradients in the
+      // same order as a training set that holds only the selected samples
+      CHECK(separate == shared);
+   }
+}
+
+TEST_CASE("CreateBoosterBags matches separate boosters, boosting, regression") {
+   CheckOuterBagsMatchSeparateBoosters(testCaseHidden, "rmse", 0);
+}
+
+TEST_CASE("CreateBoosterBags matches separate boosters, boosting, binary") {
+   CheckOuterBagsMatchSeparateBoosters(testCaseHidden, "log_loss", 0);
+}
+
+TEST_CASE("CreateBoosterBags matches separate boosters without replication, boosting, binary") {
+   CheckOuterBagsMatchSeparateBoosters(testCaseHidden, "log_loss", 0, false);
+}
+
+TEST_CASE("CreateBoosterBags matches separate boosters with inner bags, boosting, binary") {
+   CheckOuterBagsMatchSeparateBoosters(testCaseHidden, "log_loss", 2);
+}
+
+TEST_CASE("sparse feature, boosting matches dense feature, inner bags, multiclass") {
+   std::vector<TestSample> samples;
+   for(size_t iSample = 0; iSample < 1000; ++iSample) {
+      const IntEbm iBin = 0 == iSample % 100 ? IntEbm { 0 } : IntEbm { 1 };
+      const double target = 0 == iBin ? 2.0 : static_cast<double>(iSample % 3);
+      samples.push_back(TestSample({ iBin, iBin }, target));
+   }
+
+   TestApi testDense = TestApi(3);
+   testDense.AddFeatures({ FeatureTest(2), FeatureTest(3) });
+   testDense.AddTerms({ { 0 } });
+   testDense.AddTrainingSamples(samples);
+   testDense.AddValidationSamples({ TestSample({ 0, 0 }, 2.0), TestSample({ 1, 1 }, 0.0) });
+   testDense.InitializeBoosting(2);
+
+   TestApi testSparse = TestApi(3);
+   testSparse.AddFeatures({ FeatureTest(2), FeatureTest(3) });
+   testSparse.AddTerms({ { 1 } });
+   testSparse.AddTrainingSamples(samples);
+   testSparse.AddValidationSamples({ TestSample({ 0, 0 }, 2.0), TestSample({ 1, 1 }, 0.0) });
+   testSparse.InitializeBoosting(2);
+
+   for(int iEpoch = 0; iEpoch < 50; ++iEpoch) {
+      const double validationMetricDense = testDense.Boost(0).validationMetric;
+      const double validationMetricSparse = testSparse.Boost(0).validationMetric;
+      CHECK_APPROX(validationMetricDense, validationMetricSparse);
+   }
+   for(size_t iClass = 0; iClass < 3; ++iClass) {
+      CHECK_APPROX(testDense.GetCurrentTermScore(0, { 0 }, iClass), testSparse.GetCurrentTermScore(0, { 0 }, iClass));
+      CHECK_APPROX(testDense.GetCurrentTermScore(0, { 1 }, iClass), testSparse.GetCurrentTermScore(0, { 1 }, iClass));
+   }
+}
+
+TEST_CASE("sparse feature, booster view sees gradients changed by another view, regression") {
+   std::vector<TestSample> samples;
+   for(size_t iSample = 0; iSample < 1000; ++iSample) {
+      const IntEbm iBin = 0 == iSample % 100 ? IntEbm { 0 } : IntEbm { 1 };
+      samples.push_back(TestSample({ iBin }, 0 == iBin ? 10.0 : static_cast<double>(iSample % 3)));
+   }
+
+   TestApi testViews = TestApi(OutputType_Regression);
+   testViews.AddFeatures({ FeatureTest(3) });
+   testViews.AddTerms({ { 0 } });
+   testViews.AddTrainingSamples(samples);
+   testViews.AddValidationSamples({ TestSample({ 0 }, 10.0), TestSample({ 1 }, 1.0) });
+   testViews.InitializeBoosting();
+
+   TestApi testReference = TestApi(OutputType_Regression);
+   testReference.AddFeatures({ FeatureTest(3) });
+   testReference.AddTerms({ { 0 } });
+   testReference.AddTrainingSamples(samples);
+   testReference.AddValidationSamples({ TestSample({ 0 }, 10.0), TestSample({ 1 }, 1.0) });
+   testReference.InitializeBoosting();
+
+   BoosterHandle boosterHandleView = nullptr;
+   ErrorEbm error = CreateBoosterView(testViews.GetBoosterHandle(), &boosterHandleView);
+   CHECK(Error_None == error);
+
+   double gainAvg;
+   double validationMetric;
+   for(int iEpoch = 0; iEpoch < 10; ++iEpoch) {
+      // the view sums the sparse totals, then the other view changes the gradients that they were summed from
+      error = GenerateTermUpdate(nullptr, boosterHandleView, 0, BoostFlags_Default, k_learningRateDefault, 
+         k_minSamplesLeafDefault, &k_leavesMaxDefault[0], &gainAvg);
+      CHECK(Error_None == error);
+      testViews.Boost(0);
+      testReference.Boost(0);
+
+      error = GenerateTermUpdate(nullptr, boosterHandleView, 0, BoostFlags_Default, k_learningRateDefault, 
+         k_minSamplesLeafDefault, &k_leavesMaxDefault[0], &gainAvg);
+      CHECK(Error_None == error);
+      error = ApplyTermUpdate(boosterHandleView, &validationMetric);
+      CHECK(Error_None == error);
+      const double validationMetricReference = testReference.Boost(0).validationMetric;
+      CHECK_APPROX(validationMetricReference, validationMetric);
+   }
+   CHECK_APPROX(testReference.GetCurrentTermScore(0, { 0 }, 0), testViews.GetCurrentTermScore(0, { 0 }, 0));
+   CHECK_APPROX(testReference.GetCurrentTermScore(0, { 1 }, 0), testViews.GetCurrentTermScore(0, { 1 }, 0));
+
+   FreeBooster(boosterHandleView);
+}
@@ -569,3 +569,168 @@ TEST_CASE("dataset_shared, two features, 3 samples, weights, classification") {
 
    CHECK(99 == buffer[static_cast<size_t>(sum)]);
 }
+
+TEST_CASE("dataset_shared, mostly default feature is stored sparse, regression") {
+   static constexpr size_t k_cSamples = 1000;
+   std::vector<IntEbm> binIndexesSparse(k_cSamples, 1);
+   std::vector<IntEbm> binIndexesDense(k_cSamples, 1);
+   std::vector<double> targets(k_cSamples, 0.5);
+   for(size_t iSample = 0; iSample < k_cSamples; ++iSample) {
+      if(0 == iSample % 100) {
+         binIndexesSparse[iSample] = 2;
+      }
+      if(0 == iSample % 2) {
+         binIndexesDense[iSample] = 2;
+      }
+   }
+
+   const IntEbm partSparse = MeasureFeature(3, EBM_TRUE, EBM_TRUE, EBM_FALSE, static_cast<IntEbm>(k_cSamples), &binIndexesSparse[0]);
+   CHECK(0 < partSparse);
+   const IntEbm partDense = MeasureFeature(3, EBM_TRUE, EBM_TRUE, EBM_FALSE, static_cast<IntEbm>(k_cSamples), &binIndexesDense[0]);
+   CHECK(0 < partDense);
+   // 10 non-default samples are far smaller than 1000 samples bit packed at 2 bits each
+   CHECK(partSparse < partDense);
+
+   IntEbm sum = 0;
+   IntEbm part;
+   ErrorEbm error;
+
+   part = MeasureDataSetHeader(2, 0, 1);
+   CHECK(0 <= part);
+   sum += part;
+   sum += partSparse;
+   sum += partDense;
+   part = MeasureRegressionTarget(static_cast<IntEbm>(k_cSamples), &targets[0]);
+   CHECK(0 <= part);
+   sum += part;
+
+   std::vector<char> buffer(static_cast<size_t>(sum) + 1, 77);
+   buffer[static_cast<size_t>(sum)] = 99;
+
+   error = FillDataSetHeader(2, 0, 1, sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = FillFeature(3, EBM_TRUE, EBM_TRUE, EBM_FALSE, static_cast<IntEbm>(k_cSamples), &binIndexesSparse[0], sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = FillFeature(3, EBM_TRUE, EBM_TRUE, EBM_FALSE, static_cast<IntEbm>(k_cSamples), &binIndexesDense[0], sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = FillRegressionTarget(static_cast<IntEbm>(k_cSamples), &targets[0], sum, &buffer[0]);
+   CHECK(Error_None == error);
+
+   CHECK(99 == buffer[static_cast<size_t>(sum)]);
+
+   IntEbm binCounts[2];
+   error = ExtractBinCounts(&buffer[0], 2, binCounts);
+   CHECK(Error_None == error);
+   CHECK(3 == binCounts[0]);
+   CHECK(3 == binCounts[1]);
+}
+
+TEST_CASE("dataset_shared, sparse feature with illegal bin index, regression") {
+   static constexpr size_t k_cSamples = 1000;
+   std::vector<IntEbm> binIndexes(k_cSamples, 1);
+   binIndexes[500] = 3; // countBins is 3, so 3 is illegal
+   IntEbm part = MeasureDataSetHeader(1, 0, 0);
+   CHECK(0 <= part);
+   IntEbm sum = part;
+   part = MeasureFeature(3, EBM_TRUE, EBM_TRUE, EBM_FALSE, static_cast<IntEbm>(k_cSamples), &binIndexes[0]);
+   CHECK(0 <= part);
+   sum += part;
+
+   std::vector<char> buffer(static_cast<size_t>(sum), 77);
+   ErrorEbm error = FillDataSetHeader(1, 0, 0, sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = FillFeature(3, EBM_TRUE, EBM_TRUE, EBM_FALSE, static_cast<IntEbm>(k_cSamples), &binIndexes[0], sum, &buffer[0]);
+   CHECK(Error_IllegalParamVal == error);
+}
+
+TEST_CASE("dataset_shared, write then open the file mapped, classification") {
+   static constexpr IntEbm k_cSamples = 5;
+   IntEbm binIndexes[k_cSamples] { 0, 1, 2, 1, 0 };
+   IntEbm targets[k_cSamples] { 0, 1, 1, 0, 1 };
+   static const char k_filename[] = "libebm_test_dataset_shared.bin";
+
+   IntEbm sum = 0;
+   IntEbm part;
+   ErrorEbm error;
+
+   part = MeasureDataSetHeader(1, 0, 1);
+   CHECK(0 <= part);
+   sum += part;
+
+   part = MeasureFeature(3, EBM_TRUE, EBM_TRUE, EBM_FALSE, k_cSamples, &binIndexes[0]);
+   CHECK(0 <= part);
+   sum += part;
+
+   part = MeasureClassificationTarget(2, k_cSamples, &targets[0]);
+   CHECK(0 <= part);
+   sum += part;
+
+   std::vector<char> buffer(static_cast<size_t>(sum), 77);
+
+   error = WriteDataSetShared(sum, &buffer[0], k_filename);
+   // the dataset has not been filled, so it cannot be written
+   CHECK(Error_None != error);
+
+   error = FillDataSetHeader(1, 0, 1, sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = FillFeature(3, EBM_TRUE, EBM_TRUE, EBM_FALSE, k_cSamples, &binIndexes[0], sum, &buffer[0]);
+   CHECK(Error_None == error);
+   error = FillClassificationTarget(2, k_cSamples, &targets[0], sum, &buffer[0]);
+   CHECK(Error_None == error);
+
+   error = WriteDataSetShared(sum, &buffer[0], k_filename);
+   CHECK(Error_None == error);
+
+   IntEbm countBytes = -1;
+   const void * dataSet = nullptr;
+   error = OpenDataSetShared(k_filename, &countBytes, &dataSet);
+   CHECK(Error_None == error);
+   CHECK(sum == countBytes);
+   CHECK(nullptr != dataSet);
+   if(nullptr != dataSet) {
+      CHECK(0 == memcmp(dataSet, &buffer[0], static_cast<size_t>(sum)));
+
+      IntEbm binCounts[1];
+      error = ExtractBinCounts(dataSet, 1, binCounts);
+      CHECK(Error_None == error);
+      CHECK(3 == binCounts[0]);
+
+      // boosters are created from the read-only mapping without copying it
+      IntEbm dimensionCounts[1] { 1 };
+      IntEbm featureIndexes[1] { 0 };
+      BoosterHandle boosterHandle = nullptr;
+      error = CreateBooster(
+         nullptr,
+         dataSet,
+         nullptr,
+         nullptr,
+         1,
+         dimensionCounts,
+         featureIndexes,
+         0,
+         CreateBoosterFlags_Default,
+         "log_loss",
+         nullptr,
+         0,
+         nullptr,
+         &boosterHandle
+      );
+      CHECK(Error_None == error);
+      CHECK(nullptr != boosterHandle);
+      FreeBooster(boosterHandle);
+
+      InteractionHandle interactionHandle = nullptr;
+      error = CreateInteractionDetector(dataSet, nullptr, nullptr, EBM_FALSE, "log_loss", nullptr, &interactionHandle);
+      CHECK(Error_None == error);
+      CHECK(nullptr != interactionHandle);
+      FreeInteractionDetector(interactionHandle);
+
+      CloseDataSetShared(countBytes, dataSet);
+   }
+
+   remove(k_filename);
+
+   error = OpenDataSetShared(k_filename, &countBytes, &dataSet);
+   CHECK(Error_FileIo == error);
+   CHECK(nullptr == dataSet);
+}
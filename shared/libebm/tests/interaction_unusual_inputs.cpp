@@ -450,3 +450,190 @@ TEST_CASE("tweedie, interaction") {
    CHECK_APPROX(metricReturn, 1.25);
 }
 
+
+TEST_CASE("sparse feature, interaction matches dense feature, regression") {
+   // feature 1 holds the same values as feature 0 but declares an extra unused bin, which makes the shared
+   // dataset store it sparsely while feature 0 stays dense
+   std::vector<TestSample> samples;
+   for(size_t iSample = 0; iSample < 1000; ++iSample) {
+      const IntEbm iBin = 0 == iSample % 100 ? IntEbm { 0 } : IntEbm { 1 };
+      const IntEbm iBinOther = static_cast<IntEbm>(iSample % 3) + IntEbm { 1 };
+      const double target = (0 == iBin ? 3.0 : 0.0) * static_cast<double>(iBinOther) + 0.01 * static_cast<double>(iSample % 7);
+      samples.push_back(TestSample({ iBin, iBin, iBinOther }, target));
+   }
+
+   TestApi test = TestApi(OutputType_Regression);
+   test.AddFeatures({ FeatureTest(2), FeatureTest(3), FeatureTest(4) });
+   test.AddInteractionSamples(samples);
+   test.InitializeInteraction();
+
+   const double metricDense = test.TestCalcInteractionStrength({ 0, 2 });
+   const double metricSparse = test.TestCalcInteractionStrength({ 1, 2 });
+   CHECK(0 < metricDense);
+   CHECK_APPROX(metricDense, metricSparse);
+}
+
+TEST_CASE("purified triple interaction strength with pair inputs should be zero, interaction, regression") {
+   // the target is built from main effects and a pair between features 0 and 1, so there is nothing left
+   // for a pure triple interaction.  Use uneven weights to stress the purification.
+   std::vector<TestSample> samples;
+   for(IntEbm i0 = 0; i0 < 2; ++i0) {
+      for(IntEbm i1 = 0; i1 < 2; ++i1) {
+         for(IntEbm i2 = 0; i2 < 2; ++i2) {
+            const double target = (0 == i0 ? 3.0 : 5.0) + (0 == i1 ? 11.0 : 7.0) + (0 == i2 ? -2.0 : 1.5) +
+               (i0 == i1 ? 4.0 : -6.0);
+            const double weight = 1.0 + static_cast<double>(i0 * 4 + i1 * 2 + i2) * 1.375;
+            samples.push_back(TestSample({ i0, i1, i2 }, target, weight));
+         }
+      }
+   }
+
+   TestApi test = TestApi(OutputType_Regression);
+   test.AddFeatures({ FeatureTest(2), FeatureTest(2), FeatureTest(2) });
+   test.AddInteractionSamples(samples);
+   test.InitializeInteraction();
+   const double metricReturn = test.TestCalcInteractionStrength({ 0, 1, 2 }, InteractionFlags_Pure);
+
+   CHECK(0 <= metricReturn && metricReturn < 0.0000001);
+}
+
+TEST_CASE("triple interaction strength of parity target, interaction, regression") {
+   // a parity target has no main effects or pairs, so the pure and impure strengths match
+   std::vector<TestSample> samples;
+   for(IntEbm i0 = 0; i0 < 2; ++i0) {
+      for(IntEbm i1 = 0; i1 < 2; ++i1) {
+         for(IntEbm i2 = 0; i2 < 2; ++i2) {
+            samples.push_back(TestSample({ i0, i1, i2 }, 0 == ((i0 + i1 + i2) & 1) ? 1.0 : -1.0));
+         }
+      }
+   }
+
+   TestApi test = TestApi(OutputType_Regression);
+   test.AddFeatures({ FeatureTest(2), FeatureTest(2), FeatureTest(2) });
+   test.AddInteractionSamples(samples);
+   test.InitializeInteraction();
+   const double metricImpure = test.TestCalcInteractionStrength({ 0, 1, 2 });
+   const double metricPure = test.TestCalcInteractionStrength({ 0, 1, 2 }, InteractionFlags_Pure);
+   const double metricPair = test.TestCalcInteractionStrength({ 0, 1 });
+
+   CHECK(0 < metricImpure);
+   CHECK_APPROX(metricImpure, metricPure);
+   CHECK(0 <= metricPair && metricPair < 0.0000001);
+}
+
+TEST_CASE("triple interaction strength with many bins is capped, interaction, binary") {
+   // 99^3 cut combinations is more than the sweep budget, so only a subset of the cuts are considered
+   std::vector<TestSample> samples;
+   for(size_t iSample = 0; iSample < 1000; ++iSample) {
+      const IntEbm i0 = static_cast<IntEbm>(iSample % 100);
+      const IntEbm i1 = static_cast<IntEbm>((iSample * 7) % 100);
+      const IntEbm i2 = static_cast<IntEbm>((iSample * 13) % 100);
+      const double target = (50 <= i0) == ((50 <= i1) == (50 <= i2)) ? 1 : 0;
+      samples.push_back(TestSample({ i0, i1, i2 }, target));
+   }
+
+   TestApi test = TestApi(OutputType_BinaryClassification);
+   test.AddFeatures({ FeatureTest(100), FeatureTest(100), FeatureTest(100) });
+   test.AddInteractionSamples(samples);
+   test.InitializeInteraction();
+   const double metricReturn = test.TestCalcInteractionStrength({ 0, 1, 2 });
+
+   CHECK(0 < metricReturn);
+}
+
+static std::vector<double> StrengthsBatchedAndSingle(const OutputType outputType, const InteractionFlags flags) {
+   // the thread pool is sized when the interaction detector is created, so set this before InitializeInteraction
+   SetThreadCount("4");
+
+   TestApi test = TestApi(outputType);
+   // feature 3 has a single bin, so any pair with it has zero strength
+   test.AddFeatures({ FeatureTest(4), FeatureTest(3), FeatureTest(5), FeatureTest(2, true, false), FeatureTest(2), FeatureTest(6) });
+   std::vector<TestSample> samples;
+   for(IntEbm i = 0; i < 500; ++i) {
+      const IntEbm target = OutputType_Regression == outputType ? (i * 13) % 17 : ((i % 4) * (i % 3) + i % 5) % 3 < 1 ? 1 : 0;
+      samples.push_back(TestSample({ i % 4, (i / 4) % 3, (i * 7) % 5, 0, (i / 3) % 2, (i * 11) % 6 }, 
+         static_cast<double>(target), 1.0 + 0.125 * static_cast<double>(i % 7)));
+   }
+   test.AddInteractionSamples(samples);
+   test.InitializeInteraction();
+
+   SetThreadCount(nullptr);
+
+   std::vector<IntEbm> pairFeatures;
+   for(IntEbm i0 = 0; i0 < 6; ++i0) {
+      for(IntEbm i1 = i0 + 1; i1 < 6; ++i1) {
+         pairFeatures.push_back(i0);
+         pairFeatures.push_back(i1);
+      }
+   }
+   // reversed order and repeated pairs are allowed
+   pairFeatures.push_back(5);
+   pairFeatures.push_back(2);
+   pairFeatures.push_back(0);
+   pairFeatures.push_back(1);
+
+   // the batched strengths followed by the same strengths calculated one pair at a time
+   std::vector<double> results = test.TestCalcInteractionStrengths(pairFeatures, flags);
+   for(size_t iPair = 0; iPair < pairFeatures.size() / 2; ++iPair) {
+      results.push_back(test.TestCalcInteractionStrength({ pairFeatures[iPair * 2], pairFeatures[iPair * 2 + 1] }, flags));
+   }
+   return results;
+}
+
+TEST_CASE("batched pair strengths match single pair strengths, interaction, regression") {
+   const std::vector<double> results = StrengthsBatchedAndSingle(OutputType_Regression, InteractionFlags_Default);
+   const size_t cPairs = results.size() / 2;
+   CHECK(17 == cPairs);
+   for(size_t iPair = 0; iPair < cPairs; ++iPair) {
+      CHECK_APPROX(results[cPairs + iPair], results[iPair]);
+   }
+   // the third pair is 0-3, which has a feature with only one bin
+   CHECK(0.0 == results[2]);
+   CHECK(0 < results[0]);
+}
+
+TEST_CASE("batched pair strengths match single pair strengths, interaction, binary") {
+   const std::vector<double> results = StrengthsBatchedAndSingle(OutputType_BinaryClassification, InteractionFlags_Pure);
+   const size_t cPairs = results.size() / 2;
+   CHECK(17 == cPairs);
+   for(size_t iPair = 0; iPair < cPairs; ++iPair) {
+      CHECK_APPROX(results[cPairs + iPair], results[iPair]);
+   }
+   CHECK(0.0 == results[2]);
+}
+
+static std::vector<double> StrengthsInZone(const char * const sZone) {
+   SetComputeZone(sZone);
+
+   // 203 samples leaves dregs before the bit packs that are interleaved across the SIMD lanes, and each
+   // feature packs a different number of items per bit pack so their dregs differ
+   TestApi test = TestApi(OutputType_BinaryClassification);
+   test.AddFeatures({ FeatureTest(40), FeatureTest(3), FeatureTest(7) });
+   std::vector<TestSample> samples;
+   for(IntEbm i = 0; i < 203; ++i) {
+      samples.push_back(TestSample({ (i * 7) % 40, i % 3, (i * 5) % 7 }, ((i * 7) % 40 < 20) == (i % 3 < 1) ? 1 : 0, 
+         1.0 + 0.125 * static_cast<double>(i % 17)));
+   }
+   test.AddInteractionSamples(samples);
+   test.InitializeInteraction();
+
+   std::vector<double> results = test.TestCalcInteractionStrengths({ 0, 1, 0, 2 });
+   results.push_back(test.TestCalcInteractionStrength({ 1, 2 }));
+   results.push_back(test.TestCalcInteractionStrength({ 0, 1, 2 }));
+
+   SetComputeZone(nullptr);
+   return results;
+}
+
+TEST_CASE("SIMD zone matches cpu zone, interaction") {
+   // hosts without AVX512F fall back to a lower zone, which still needs to match
+   const std::vector<double> cpu = StrengthsInZone("cpu");
+   for(const char * const sZone : { "avx2", "avx512f" }) {
+      const std::vector<double> simd = StrengthsInZone(sZone);
+      CHECK(cpu.size() == simd.size());
+      for(size_t i = 0; i < cpu.size(); ++i) {
+         CHECK_APPROX(cpu[i], simd[i]);
+      }
+   }
+   CHECK(0 < cpu[0]);
+}
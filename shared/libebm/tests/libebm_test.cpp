@@ -38,6 +38,7 @@
 #include <cstddef>
 #include <assert.h>
 #include <string.h>
+#include <stdlib.h> // setenv, unsetenv, _putenv_s
 
 #include "libebm.h"
 #include "libebm_test.hpp"
@@ -548,7 +549,12 @@ void TestApi::AddValidationSamples(const std::vector<TestSample> samples) {
    m_stage = Stage::ValidationAdded;
 }
 
-void TestApi::InitializeBoosting(const IntEbm countInnerBags) {
+void TestApi::InitializeBoosting(
+   const IntEbm countInnerBags, 
+   const char * const sMetric, 
+   const CreateBoosterFlags flags,
+   const IntEbm countThreads
+) {
    ErrorEbm error;
 
    if(Stage::ValidationAdded != m_stage) {
@@ -648,8 +654,10 @@ void TestApi::InitializeBoosting(const IntEbm countInnerBags) {
       0 == m_dimensionCounts.size() ? nullptr : &m_dimensionCounts[0],
       0 == m_featureIndexes.size() ? nullptr : &m_featureIndexes[0],
       countInnerBags,
-      m_bDifferentiallyPrivate,
+      flags | (EBM_FALSE != m_bDifferentiallyPrivate ? CreateBoosterFlags_DifferentialPrivacy : CreateBoosterFlags_Default),
       sObjective,
+      sMetric,
+      countThreads,
       nullptr,
       &m_boosterHandle
    );
@@ -1087,6 +1095,70 @@ double TestApi::TestCalcInteractionStrength(
    return avgInteractionStrength;
 }
 
+std::vector<double> TestApi::TestCalcInteractionStrengths(
+   const std::vector<IntEbm> pairFeatures,
+   const InteractionFlags flags,
+   const IntEbm minSamplesLeaf
+) const {
+   ErrorEbm error;
+
+   if(Stage::InitializedInteraction != m_stage) {
+      exit(1);
+   }
+   if(0 != pairFeatures.size() % 2) {
+      exit(1);
+   }
+   for(const IntEbm oneFeatureIndex : pairFeatures) {
+      if(oneFeatureIndex < IntEbm { 0 }) {
+         exit(1);
+      }
+      if(m_featureBinCounts.size() <= static_cast<size_t>(oneFeatureIndex)) {
+         exit(1);
+      }
+   }
+
+   std::vector<double> avgInteractionStrengths(pairFeatures.size() / 2, double { -1 });
+   error = CalcInteractionStrengths(
+      m_interactionHandle,
+      avgInteractionStrengths.size(),
+      0 == pairFeatures.size() ? nullptr : &pairFeatures[0],
+      flags,
+      0,
+      minSamplesLeaf,
+      0 == avgInteractionStrengths.size() ? nullptr : &avgInteractionStrengths[0]
+   );
+   if(Error_None != error) {
+      exit(1);
+   }
+   return avgInteractionStrengths;
+}
+
+extern void SetComputeZone(const char * const sZone) {
+#ifdef _MSC_VER
+   // an empty value removes the variable on Windows
+   _putenv_s("LIBEBM_ZONE", nullptr == sZone ? "" : sZone);
+#else // _MSC_VER
+   if(nullptr == sZone) {
+      unsetenv("LIBEBM_ZONE");
+   } else {
+      setenv("LIBEBM_ZONE", sZone, 1);
+   }
+#endif // _MSC_VER
+}
+
+extern void SetThreadCount(const char * const sThreads) {
+#ifdef _MSC_VER
+   // an empty value removes the variable on Windows
+   _putenv_s("LIBEBM_THREADS", nullptr == sThreads ? "" : sThreads);
+#else // _MSC_VER
+   if(nullptr == sThreads) {
+      unsetenv("LIBEBM_THREADS");
+   } else {
+      setenv("LIBEBM_THREADS", sThreads, 1);
+   }
+#endif // _MSC_VER
+}
+
 extern void DisplayCuts(
    IntEbm countSamples,
    double * featureVals,
@@ -112,12 +112,20 @@ bool IsApproxEqual(const double val, const double expected, const double percent
       } \
    } while( (void)0, 0)
 
+#ifdef FLOAT_FAST_32
+// the gradients, hessians and histograms are float32 in this build, so anything summed over the samples only keeps
+// about 7 digits, and the gains lose more of them since they subtract nearly equal sums
+static constexpr double k_toleranceApprox = 1e-3;
+#else // FLOAT_FAST_32
+static constexpr double k_toleranceApprox = 1e-6;
+#endif // FLOAT_FAST_32
+
 // this will ONLY work if used inside the root TEST_CASE function.  The testCaseHidden variable comes from TEST_CASE and should be visible inside the 
 // function where CHECK_APPROX(expression) is called
 #define CHECK_APPROX(val, expected) \
    do { \
       const double valHidden = (val); \
-      const bool bApproxEqualHidden = IsApproxEqual(valHidden, static_cast<double>(expected), double { 1e-6 }); \
+      const bool bApproxEqualHidden = IsApproxEqual(valHidden, static_cast<double>(expected), k_toleranceApprox); \
       if(!bApproxEqualHidden) { \
          FAILED(valHidden, &testCaseHidden, std::string(" FAILED on \"" #val "(") + std::to_string(valHidden) + ") approx " #expected "\""); \
       } \
@@ -374,6 +382,10 @@ public:
       return m_boosterHandle;
    }
 
+   inline void * GetRng() {
+      return &m_rng[0];
+   }
+
    inline InteractionHandle GetInteractionHandle() {
       return m_interactionHandle;
    }
@@ -382,7 +394,12 @@ public:
    void AddTerms(const std::vector<std::vector<size_t>> termFeatures);
    void AddTrainingSamples(const std::vector<TestSample> samples);
    void AddValidationSamples(const std::vector<TestSample> samples);
-   void InitializeBoosting(const IntEbm countInnerBags = k_countInnerBagsDefault);
+   void InitializeBoosting(
+      const IntEbm countInnerBags = k_countInnerBagsDefault, 
+      const char * const sMetric = nullptr, 
+      const CreateBoosterFlags flags = CreateBoosterFlags_Default,
+      const IntEbm countThreads = 0
+   );
    
    BoostRet Boost(
       const IntEbm indexTerm,
@@ -417,8 +434,20 @@ public:
       const InteractionFlags flags = InteractionFlags_Default,
       const IntEbm minSamplesLeaf = k_minSamplesLeafDefault
    ) const;
+
+   std::vector<double> TestCalcInteractionStrengths(
+      const std::vector<IntEbm> pairFeatures,
+      const InteractionFlags flags = InteractionFlags_Default,
+      const IntEbm minSamplesLeaf = k_minSamplesLeafDefault
+   ) const;
 };
 
+// sets LIBEBM_ZONE, or removes it if sZone is nullptr.  Unsupported zones fall back to the widest supported one
+void SetComputeZone(const char * const sZone);
+
+// sets LIBEBM_THREADS, or removes it if sThreads is nullptr.  Thread pools are sized when their handle is created
+void SetThreadCount(const char * const sThreads);
+
 void DisplayCuts(
    IntEbm countSamples,
    double * featureVals,
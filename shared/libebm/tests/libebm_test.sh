@@ -281,6 +281,7 @@ existing_release_arm=0
 
 use_valgrind=1
 use_asan=1
+is_float32=0
 
 for arg in "$@"; do
    if [ "$arg" = "-no_debug_64" ]; then
@@ -327,6 +328,9 @@ for arg in "$@"; do
    if [ "$arg" = "-no_asan" ]; then
       use_asan=0
    fi
+   if [ "$arg" = "-float32" ]; then
+      is_float32=1
+   fi
 done
 
 # this isn't needed in the test script, but we include them to make this script more similar to build.sh
@@ -370,6 +374,11 @@ both_args="$both_args -fvisibility=hidden"
 both_args="$both_args -fno-math-errno -fno-trapping-math"
 both_args="$both_args -I$src_path_sanitized/../inc"
 both_args="$both_args -I$src_path_sanitized"
+build_args=""
+if [ $is_float32 -ne 0 ]; then 
+   both_args="$both_args -DFLOAT_FAST_32"
+   build_args="$build_args -float32"
+fi
 
 c_args="-std=c99"
 
@@ -405,7 +414,7 @@ if [ "$os_type" = "Linux" ]; then
       ########################## Linux debug|x64
 
       if [ $existing_debug_64 -eq 0 ]; then 
-         /bin/sh "$root_path_unsanitized/build.sh" -no_release_64 -analysis
+         /bin/sh "$root_path_unsanitized/build.sh" -no_release_64 -analysis $build_args
          ret_code=$?
          if [ $ret_code -ne 0 ]; then 
             # build.sh should write out any messages
@@ -457,7 +466,7 @@ if [ "$os_type" = "Linux" ]; then
       ########################## Linux release|x64
 
       if [ $existing_release_64 -eq 0 ]; then 
-         /bin/sh "$root_path_unsanitized/build.sh" -no_debug_64 -analysis
+         /bin/sh "$root_path_unsanitized/build.sh" -no_debug_64 -analysis $build_args
          ret_code=$?
          if [ $ret_code -ne 0 ]; then 
             # build.sh should write out any messages
@@ -509,7 +518,7 @@ if [ "$os_type" = "Linux" ]; then
       ########################## Linux debug|x86
 
       if [ $existing_debug_32 -eq 0 ]; then 
-         /bin/sh "$root_path_unsanitized/build.sh" -no_release_64 -no_debug_64 -debug_32 -analysis
+         /bin/sh "$root_path_unsanitized/build.sh" -no_release_64 -no_debug_64 -debug_32 -analysis $build_args
          ret_code=$?
          if [ $ret_code -ne 0 ]; then 
             # build.sh should write out any messages
@@ -554,7 +563,7 @@ if [ "$os_type" = "Linux" ]; then
       ########################## Linux release|x86
 
       if [ $existing_release_32 -eq 0 ]; then 
-         /bin/sh "$root_path_unsanitized/build.sh" -no_release_64 -no_debug_64 -release_32 -analysis
+         /bin/sh "$root_path_unsanitized/build.sh" -no_release_64 -no_debug_64 -release_32 -analysis $build_args
          ret_code=$?
          if [ $ret_code -ne 0 ]; then 
             # build.sh should write out any messages
@@ -621,7 +630,7 @@ elif [ "$os_type" = "Darwin" ]; then
 
       if [ $existing_debug_64 -eq 0 ]; then 
          # TODO: add options to build.sh to only build debug x64 (not arm!)
-         /bin/sh "$root_path_unsanitized/build.sh" -no_release_64 -analysis
+         /bin/sh "$root_path_unsanitized/build.sh" -no_release_64 -analysis $build_args
          ret_code=$?
          if [ $ret_code -ne 0 ]; then 
             # build.sh should write out any messages
@@ -667,7 +676,7 @@ elif [ "$os_type" = "Darwin" ]; then
 
       if [ $existing_release_64 -eq 0 ]; then 
          # TODO: add options to build.sh to only build release x64 (not arm!)
-         /bin/sh "$root_path_unsanitized/build.sh" -no_debug_64 -analysis
+         /bin/sh "$root_path_unsanitized/build.sh" -no_debug_64 -analysis $build_args
          ret_code=$?
          if [ $ret_code -ne 0 ]; then 
             # build.sh should write out any messages
@@ -713,7 +722,7 @@ elif [ "$os_type" = "Darwin" ]; then
 
       if [ $existing_debug_arm -eq 0 ]; then 
          # TODO: add options to build.sh to only build release arm
-         /bin/sh "$root_path_unsanitized/build.sh" -analysis
+         /bin/sh "$root_path_unsanitized/build.sh" -analysis $build_args
          ret_code=$?
          if [ $ret_code -ne 0 ]; then 
             # build.sh should write out any messages
@@ -759,7 +768,7 @@ elif [ "$os_type" = "Darwin" ]; then
 
       if [ $existing_release_arm -eq 0 ]; then 
          # TODO: add options to build.sh to only build release arm
-         /bin/sh "$root_path_unsanitized/build.sh" -analysis
+         /bin/sh "$root_path_unsanitized/build.sh" -analysis $build_args
          ret_code=$?
          if [ $ret_code -ne 0 ]; then 
             # build.sh should write out any messages